@@ -0,0 +1,132 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+// Batched bounding box visibility kernel shared by AdvancedMath.cpp and AdvancedMathAVX.cpp.
+// The kernel is instantiated in every translation unit with the instruction set that the unit
+// is compiled for, so everything except the plain PlaneArrays structure has internal linkage:
+// otherwise the linker could pick the AVX version of a function for the code that runs on CPUs
+// without AVX support.
+
+#include <cstddef>
+
+#include "../../Primitives/interface/BasicTypes.h"
+
+namespace Diligent
+{
+
+// Frustum plane together with the box coordinate arrays that define the farthest and
+// the nearest box corners along the plane normal (see GetBoxVisibilityAgainstPlane())
+struct PlaneArrays
+{
+    float Nx;
+    float Ny;
+    float Nz;
+    float D;
+
+    const float* FarX;
+    const float* FarY;
+    const float* FarZ;
+    const float* NearX;
+    const float* NearY;
+    const float* NearZ;
+};
+
+// Tests boxes [FirstBox, FirstBox + NumBoxes) in batches of SIMDOps::Width and sets the bits of the boxes
+// that are invisible and fully inside all planes in pInvisibleBits and pInsideBits. The bit of box
+// FirstBox + i is bit (i % 32) of element i / 32; the arrays must be zero-initialized.
+// Returns the number of processed boxes, which is a multiple of the batch size.
+//
+// Note that the distances must be computed exactly as in GetBoxVisibilityAgainstPlane()
+// (i.e. dot(Corner, Normal) + Distance) so that the results are bitwise identical.
+typedef size_t (*BoxBatchKernelType)(const PlaneArrays* Planes,
+                                     Uint32             NumPlanes,
+                                     size_t             FirstBox,
+                                     size_t             NumBoxes,
+                                     Uint32*            pInvisibleBits,
+                                     Uint32*            pInsideBits);
+
+namespace
+{
+
+template <typename SIMDOps>
+size_t TestBoxBatches(const PlaneArrays* Planes,
+                      Uint32             NumPlanes,
+                      size_t             FirstBox,
+                      size_t             NumBoxes,
+                      Uint32*            pInvisibleBits,
+                      Uint32*            pInsideBits)
+{
+    using FloatVec = typename SIMDOps::FloatVec;
+
+    static_assert(32 % SIMDOps::Width == 0, "Batches must not straddle the 32-bit word boundary");
+
+    FloatVec Nx[6], Ny[6], Nz[6], D[6];
+    for (Uint32 p = 0; p < NumPlanes; ++p)
+    {
+        Nx[p] = SIMDOps::Broadcast(Planes[p].Nx);
+        Ny[p] = SIMDOps::Broadcast(Planes[p].Ny);
+        Nz[p] = SIMDOps::Broadcast(Planes[p].Nz);
+        D[p]  = SIMDOps::Broadcast(Planes[p].D);
+    }
+
+    const auto Zero = SIMDOps::Broadcast(0.f);
+
+    size_t i = 0;
+    for (; i + SIMDOps::Width <= NumBoxes; i += SIMDOps::Width)
+    {
+        const auto Box = FirstBox + i;
+
+        auto Invisible = SIMDOps::MaskNone();
+        auto Inside    = SIMDOps::MaskAll();
+        for (Uint32 p = 0; p < NumPlanes; ++p)
+        {
+            const auto& Plane = Planes[p];
+
+            const auto DFar = SIMDOps::Add(SIMDOps::Add(SIMDOps::Add(SIMDOps::Mul(SIMDOps::Load(Plane.FarX + Box), Nx[p]),
+                                                                     SIMDOps::Mul(SIMDOps::Load(Plane.FarY + Box), Ny[p])),
+                                                        SIMDOps::Mul(SIMDOps::Load(Plane.FarZ + Box), Nz[p])),
+                                           D[p]);
+            Invisible       = SIMDOps::Or(Invisible, SIMDOps::Less(DFar, Zero));
+
+            const auto DNear = SIMDOps::Add(SIMDOps::Add(SIMDOps::Add(SIMDOps::Mul(SIMDOps::Load(Plane.NearX + Box), Nx[p]),
+                                                                      SIMDOps::Mul(SIMDOps::Load(Plane.NearY + Box), Ny[p])),
+                                                         SIMDOps::Mul(SIMDOps::Load(Plane.NearZ + Box), Nz[p])),
+                                            D[p]);
+            Inside           = SIMDOps::And(Inside, SIMDOps::Greater(DNear, Zero));
+        }
+        pInvisibleBits[i / 32] |= SIMDOps::MoveMask(Invisible) << (i % 32);
+        pInsideBits[i / 32] |= SIMDOps::MoveMask(Inside) << (i % 32);
+    }
+
+    return i;
+}
+
+} // namespace
+
+} // namespace Diligent
@@ -348,6 +348,51 @@ inline BoxVisibility GetBoxVisibility(const ViewFrustumExt& ViewFrustumExt,
     return BoxVisibility::Intersecting;
 }
 
+/// Structure-of-arrays representation of bounding boxes used by the batched
+/// visibility tests. The I-th box is defined by MinX[I], MinY[I], ..., MaxZ[I].
+struct BoundBoxArrays
+{
+    const float* MinX = nullptr;
+    const float* MinY = nullptr;
+    const float* MinZ = nullptr;
+    const float* MaxX = nullptr;
+    const float* MaxY = nullptr;
+    const float* MaxZ = nullptr;
+};
+
+/// Tests the visibility of NumBoxes bounding boxes and writes the results to pVisibility.
+
+/// The results are identical to calling GetBoxVisibility() for every box, but the boxes
+/// are processed in batches using SIMD instructions where available. On x86, the AVX
+/// version is used if the CPU and the OS support it, and the SSE2 version otherwise.
+/// ARM targets with NEON use the NEON version, and other targets use the scalar version.
+void GetBoxesVisibility(const ViewFrustum&    ViewFrustum,
+                        const BoundBoxArrays& Boxes,
+                        size_t                NumBoxes,
+                        BoxVisibility*        pVisibility,
+                        FRUSTUM_PLANE_FLAGS   PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM);
+
+void GetBoxesVisibility(const ViewFrustumExt& ViewFrustumExt,
+                        const BoundBoxArrays& Boxes,
+                        size_t                NumBoxes,
+                        BoxVisibility*        pVisibility,
+                        FRUSTUM_PLANE_FLAGS   PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM);
+
+/// Tests the visibility of NumBoxes bounding boxes and writes the visibility bit mask to
+/// pVisibilityMask: bit (I % 32) of pVisibilityMask[I / 32] is set if the I-th box is not
+/// BoxVisibility::Invisible. The array must contain at least (NumBoxes + 31) / 32 elements.
+void GetBoxesVisibilityMask(const ViewFrustum&    ViewFrustum,
+                            const BoundBoxArrays& Boxes,
+                            size_t                NumBoxes,
+                            Uint32*               pVisibilityMask,
+                            FRUSTUM_PLANE_FLAGS   PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM);
+
+void GetBoxesVisibilityMask(const ViewFrustumExt& ViewFrustumExt,
+                            const BoundBoxArrays& Boxes,
+                            size_t                NumBoxes,
+                            Uint32*               pVisibilityMask,
+                            FRUSTUM_PLANE_FLAGS   PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM);
+
 inline float GetPointToBoxDistance(const BoundBox& BndBox, const float3& Pos)
 {
     VERIFY_EXPR(BndBox.Max.x >= BndBox.Min.x &&
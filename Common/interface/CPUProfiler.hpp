@@ -0,0 +1,183 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::CPUProfiler class and CPU profiling macros
+
+#include <string>
+#include <vector>
+#include <atomic>
+
+#include "../../Primitives/interface/BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Single profiled scope recorded by CPUProfiler.
+struct CPUProfileEvent
+{
+    /// Scope name. Must have static storage duration (e.g. string literal).
+    const Char* Name = nullptr;
+
+    /// Scope start time in nanoseconds, relative to the profiler epoch.
+    Uint64 StartTime = 0;
+
+    /// Scope duration in nanoseconds.
+    Uint64 Duration = 0;
+
+    /// Nesting depth of the scope on its thread, starting from zero.
+    Uint32 Depth = 0;
+};
+
+/// Events recorded by a single thread.
+struct CPUProfileThreadEvents
+{
+    /// Sequential thread index assigned by the profiler.
+    Uint32 ThreadId = 0;
+
+    /// Thread name set by CPUProfiler::SetThreadName(), may be empty.
+    std::string ThreadName;
+
+    /// Recorded events in the order of scope completion.
+    std::vector<CPUProfileEvent> Events;
+};
+
+/// Low-overhead hierarchical CPU scope profiler.
+
+/// Every thread records completed scopes into its own fixed-size ring buffer,
+/// so recording never takes locks or allocates memory (except for the first
+/// event on a thread). When the buffer is full, the oldest events are overwritten.
+/// Events are typically recorded through DILIGENT_PROFILE_SCOPE and DILIGENT_PROFILE_FUNCTION
+/// macros that compile to nothing unless the engine is built with DILIGENT_CPU_PROFILER=1
+/// (see DILIGENT_ENABLE_CPU_PROFILER CMake option).
+///
+/// \remarks Events that are being overwritten while the data is collected are discarded.
+///          For consistent results, collect the events between frames.
+struct CPUProfiler
+{
+    /// Maximum number of events kept per thread, must be a power of two.
+    static constexpr Uint32 ThreadBufferSize = 1u << 14u;
+
+    /// Enables or disables event recording at run time. Recording is enabled by default.
+    static void SetEnabled(bool Enabled)
+    {
+        m_Enabled.store(Enabled, std::memory_order_relaxed);
+    }
+
+    static bool IsEnabled()
+    {
+        return m_Enabled.load(std::memory_order_relaxed);
+    }
+
+    /// Returns the current time in nanoseconds, relative to the profiler epoch.
+    static Uint64 GetTimestamp();
+
+    /// Sets the name of the calling thread shown in the exported trace.
+    static void SetThreadName(const Char* Name);
+
+    /// Marks the beginning of a scope on the calling thread and returns its start time.
+    static Uint64 BeginScope();
+
+    /// Records the scope started by the matching BeginScope() call on the calling thread.
+    static void EndScope(const Char* Name, Uint64 StartTime);
+
+    /// Discards all events recorded so far and releases the buffers of the threads that have exited.
+    static void Reset();
+
+    /// Returns copies of the events recorded by every thread.
+    static std::vector<CPUProfileThreadEvents> CollectEvents();
+
+    /// Writes the recorded events to the string in Chrome trace event JSON format
+    /// that can be loaded by chrome://tracing or https://ui.perfetto.dev.
+    static void ExportChromeTrace(std::string& Json);
+
+    /// Saves the recorded events to the file in Chrome trace event JSON format.
+    static bool SaveChromeTrace(const Char* FilePath);
+
+private:
+    static std::atomic<bool> m_Enabled;
+};
+
+
+/// RAII helper that records the lifetime of a C++ scope with CPUProfiler.
+class CPUProfileScope
+{
+public:
+    /// \param [in] Name - Scope name. Must have static storage duration (e.g. string literal).
+    explicit CPUProfileScope(const Char* Name) :
+        m_Name{CPUProfiler::IsEnabled() ? Name : nullptr}
+    {
+        if (m_Name != nullptr)
+            m_StartTime = CPUProfiler::BeginScope();
+    }
+
+    ~CPUProfileScope()
+    {
+        if (m_Name != nullptr)
+            CPUProfiler::EndScope(m_Name, m_StartTime);
+    }
+
+    // clang-format off
+    CPUProfileScope           (const CPUProfileScope&) = delete;
+    CPUProfileScope           (CPUProfileScope&&)      = delete;
+    CPUProfileScope& operator=(const CPUProfileScope&) = delete;
+    CPUProfileScope& operator=(CPUProfileScope&&)      = delete;
+    // clang-format on
+
+private:
+    const Char* const m_Name;
+    Uint64            m_StartTime = 0;
+};
+
+} // namespace Diligent
+
+
+#ifndef DILIGENT_CPU_PROFILER
+#    define DILIGENT_CPU_PROFILER 0
+#endif
+
+#if DILIGENT_CPU_PROFILER
+#    define DILIGENT_PROFILE_SCOPE_CONCAT0(X, Y) X##Y
+#    define DILIGENT_PROFILE_SCOPE_CONCAT(X, Y)  DILIGENT_PROFILE_SCOPE_CONCAT0(X, Y)
+
+/// Records the enclosing C++ scope with the given name.
+#    define DILIGENT_PROFILE_SCOPE(Name) Diligent::CPUProfileScope DILIGENT_PROFILE_SCOPE_CONCAT(_CPUProfileScope, __LINE__)(Name)
+
+/// Records the enclosing function.
+#    define DILIGENT_PROFILE_FUNCTION() DILIGENT_PROFILE_SCOPE(__FUNCTION__)
+#else
+#    define DILIGENT_PROFILE_SCOPE(Name) \
+        do                               \
+        {                                \
+        } while (false)
+#    define DILIGENT_PROFILE_FUNCTION() \
+        do                              \
+        {                               \
+        } while (false)
+#endif
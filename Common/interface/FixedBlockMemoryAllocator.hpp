@@ -56,7 +56,19 @@ inline void FillWithDebugPattern(void* ptr, Uint8 Pattern, size_t NumBytes)
 class FixedBlockMemoryAllocator final : public IMemoryAllocator
 {
 public:
-    FixedBlockMemoryAllocator(IMemoryAllocator& RawMemoryAllocator, size_t BlockSize, Uint32 NumBlocksInPage);
+    /// \param [in] RawMemoryAllocator - Raw memory allocator that is used to allocate memory pages.
+    /// \param [in] BlockSize          - Size of one block.
+    /// \param [in] NumBlocksInPage    - Number of blocks in one memory page.
+    /// \param [in] EnableThreadCache  - Whether to enable per-thread block caches.
+    ///
+    /// \remarks   When thread cache is enabled, every thread keeps a small list of free blocks,
+    ///            and the majority of allocations and deallocations do not need to take the mutex.
+    ///            Memory pages are aligned by their size and start with a header, so that the page
+    ///            that owns a block is found by address arithmetic rather than by a hash map lookup.
+    ///            The page size is the smallest power of two that holds NumBlocksInPage blocks, and the
+    ///            header takes the space of the first block(s), so a page may hold slightly fewer or more
+    ///            blocks than requested. Pages are allocated in chunks when the first block is requested.
+    FixedBlockMemoryAllocator(IMemoryAllocator& RawMemoryAllocator, size_t BlockSize, Uint32 NumBlocksInPage, bool EnableThreadCache = false);
     ~FixedBlockMemoryAllocator();
 
     /// Allocates block of memory
@@ -75,6 +87,34 @@ private:
 
     void CreateNewPage();
 
+    // The methods below must be called with m_Mutex locked
+    void* AllocateFromPages();
+    void  FreeToPages(void* Ptr);
+
+    // Maximum number of threads that may use thread caches simultaneously.
+    // Other threads take the slow path that locks the mutex.
+    static constexpr Uint32 MaxThreadCaches = 64;
+
+    // Number of aligned pages allocated from the raw allocator at once when thread cache is enabled.
+    static constexpr Uint32 NumPagesInChunk = 4;
+
+    // Size of the page header that keeps the page index when thread cache is enabled.
+    static constexpr size_t PageHeaderSize = 16;
+
+    // Thread caches are aligned by the cache line size to avoid false sharing between threads
+    struct alignas(64) ThreadCache
+    {
+        void*  pHead     = nullptr; // Head of the free block list
+        Uint32 NumBlocks = 0;       // Number of blocks in the list
+    };
+
+    // Returns the index of the calling thread's cache. The index is
+    // unique among all running threads and is reused when a thread exits.
+    static Uint32 GetThreadCacheSlot();
+
+    void RefillThreadCache(ThreadCache& Cache);
+    void FlushThreadCache(ThreadCache& Cache, Uint32 NumBlocksToFlush);
+
     // Memory page class is based on the fixed-size memory pool described in "Fast Efficient Fixed-Size Memory Pool"
     // by Ben Kenwright
     class MemoryPage
@@ -85,16 +125,20 @@ private:
         static constexpr Uint8 DeallocatedBlockMemPattern = 0xDE;
         static constexpr Uint8 InitializedBlockMemPattern = 0xCF;
 
-        MemoryPage(FixedBlockMemoryAllocator& OwnerAllocator) :
+        // If pPageMemory is null, the page allocates and owns its memory.
+        // Otherwise, the memory is owned by the allocator.
+        MemoryPage(FixedBlockMemoryAllocator& OwnerAllocator, void* pPageMemory = nullptr) :
             // clang-format off
             m_NumFreeBlocks       {OwnerAllocator.m_NumBlocksInPage},
             m_NumInitializedBlocks{0},
-            m_pOwnerAllocator     {&OwnerAllocator}
+            m_pOwnerAllocator     {&OwnerAllocator},
+            m_OwnsMemory          {pPageMemory == nullptr}
         // clang-format on
         {
             auto PageSize = OwnerAllocator.m_BlockSize * OwnerAllocator.m_NumBlocksInPage;
-            m_pPageStart  = reinterpret_cast<Uint8*>(
-                OwnerAllocator.m_RawMemoryAllocator.Allocate(PageSize, "FixedBlockMemoryAllocator page", __FILE__, __LINE__));
+            m_pPageStart  = pPageMemory != nullptr ?
+                pPageMemory :
+                OwnerAllocator.m_RawMemoryAllocator.Allocate(PageSize, "FixedBlockMemoryAllocator page", __FILE__, __LINE__);
             m_pNextFreeBlock = m_pPageStart;
             FillWithDebugPattern(m_pPageStart, NewPageMemPattern, PageSize);
         }
@@ -105,7 +149,8 @@ private:
             m_NumInitializedBlocks{Page.m_NumInitializedBlocks},
             m_pPageStart          {Page.m_pPageStart          },
             m_pNextFreeBlock      {Page.m_pNextFreeBlock      },
-            m_pOwnerAllocator     {Page.m_pOwnerAllocator     }
+            m_pOwnerAllocator     {Page.m_pOwnerAllocator     },
+            m_OwnsMemory          {Page.m_OwnsMemory          }
         // clang-format on
         {
             Page.m_NumFreeBlocks        = 0;
@@ -113,11 +158,12 @@ private:
             Page.m_pPageStart           = nullptr;
             Page.m_pNextFreeBlock       = nullptr;
             Page.m_pOwnerAllocator      = nullptr;
+            Page.m_OwnsMemory           = false;
         }
 
         ~MemoryPage()
         {
-            if (m_pOwnerAllocator)
+            if (m_pOwnerAllocator && m_OwnsMemory)
                 m_pOwnerAllocator->m_RawMemoryAllocator.Free(m_pPageStart);
         }
 
@@ -218,6 +264,7 @@ private:
         void*                      m_pPageStart           = nullptr; // Beginning of memory pool
         void*                      m_pNextFreeBlock       = nullptr; // Num of next free block
         FixedBlockMemoryAllocator* m_pOwnerAllocator      = nullptr;
+        bool                       m_OwnsMemory           = false;
     };
 
     std::vector<MemoryPage, STDAllocatorRawMem<MemoryPage>>                                          m_PagePool;
@@ -230,7 +277,20 @@ private:
 
     IMemoryAllocator& m_RawMemoryAllocator;
     const size_t      m_BlockSize;
+    const size_t      m_PageAlignment; // Non-zero only when thread cache is enabled
     const Uint32      m_NumBlocksInPage;
+    const Uint32      m_ThreadCacheBatchSize;
+
+    // Raw memory that holds MaxThreadCaches aligned thread caches when thread cache is enabled.
+    // The caches are not kept in a vector as its allocator does not respect the alignment.
+    void*        m_pThreadCacheMemory = nullptr;
+    ThreadCache* m_ThreadCaches       = nullptr;
+
+    // Raw memory chunks that hold aligned pages when thread cache is enabled
+    std::vector<void*, STDAllocatorRawMem<void*>> m_PageChunks;
+
+    Uint8* m_pNextChunkPage    = nullptr;
+    Uint32 m_NumChunkPagesLeft = 0;
 };
 
 IMemoryAllocator& GetRawAllocator();
@@ -297,7 +357,7 @@ private:
     static IMemoryAllocator* m_pRawAllocator;
 
     ObjectPool() :
-        m_FixedBlockAlloctor(m_pRawAllocator ? *m_pRawAllocator : GetRawAllocator(), sizeof(ObjectType), m_NumAllocationsInPage)
+        m_FixedBlockAlloctor(m_pRawAllocator ? *m_pRawAllocator : GetRawAllocator(), sizeof(ObjectType), m_NumAllocationsInPage, true)
     {}
 #ifdef DILIGENT_DEBUG
     static bool m_bPoolInitialized;
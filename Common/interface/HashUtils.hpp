@@ -93,6 +93,45 @@ struct CStringCompare<Char>
     }
 };
 
+/// Computes two independent 64-bit hashes of the same data: FNV-1a hash that is intended
+/// to be used as a cache key, and SDBM hash that is intended to verify that the cache entry
+/// was produced from the same input. Unlike std::hash, the results do not depend on the
+/// standard library implementation, which is essential for persistent keys.
+class ContentHasher
+{
+public:
+    void Update(const void* pData, size_t Size)
+    {
+        const auto* pBytes = reinterpret_cast<const Uint8*>(pData);
+        for (size_t i = 0; i < Size; ++i)
+        {
+            m_FNV1a = (m_FNV1a ^ pBytes[i]) * Uint64{0x100000001b3};
+            m_SDBM  = pBytes[i] + (m_SDBM << 6) + (m_SDBM << 16) - m_SDBM;
+        }
+    }
+
+    // Null-terminated strings are hashed including the terminator, so
+    // that {"ab", "c"} and {"a", "bc"} produce different hashes
+    void Update(const char* Str)
+    {
+        if (Str == nullptr)
+            Str = "";
+        Update(Str, strlen(Str) + 1);
+    }
+
+    void Update(Uint32 Value)
+    {
+        Update(&Value, sizeof(Value));
+    }
+
+    Uint64 GetKey() const { return m_FNV1a; }
+    Uint64 GetVerificationHash() const { return m_SDBM; }
+
+private:
+    Uint64 m_FNV1a = Uint64{0xcbf29ce484222325};
+    Uint64 m_SDBM  = 0;
+};
+
 /// This helper structure is intended to facilitate using strings as a
 /// hash table key. It provides constructors that can make a copy of the
 /// source string or just keep pointer to it, which enables searching in
@@ -0,0 +1,153 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+#pragma once
+
+/// \file
+/// Parallel radix sort of elements with 64-bit keys
+
+#include <vector>
+#include <future>
+#include <functional>
+#include <algorithm>
+#include <cstring>
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "ThreadPool.hpp"
+
+namespace Diligent
+{
+
+/// Sorts elements by their 64-bit ElementType::Key member using stable LSD radix sort with 8-bit digits.
+
+/// \param [in] pData       - Elements to sort.
+/// \param [in] pScratch    - Scratch buffer that must be large enough to hold Count elements.
+/// \param [in] Count       - Number of elements.
+/// \param [in] pThreadPool - Optional thread pool. If not null, every pass is split into chunks
+///                           that are histogrammed and scattered by the pool threads in parallel.
+///
+/// \return     Pointer to the sorted elements that is either pData or pScratch.
+///
+/// \remarks    Passes where all keys have the same digit are skipped, so sorting keys that only
+///             use a few low bits costs only a few passes.
+///             Elements with equal keys keep their relative order.
+template <typename ElementType>
+ElementType* RadixSort64(ElementType* pData, ElementType* pScratch, size_t Count, ThreadPool* pThreadPool = nullptr)
+{
+    static constexpr Uint32 DigitBits = 8;
+    static constexpr Uint32 NumDigits = 1u << DigitBits;
+    static constexpr Uint32 NumPasses = 64 / DigitBits;
+    // Do not split small arrays as the cost of scheduling the tasks outweighs the gain
+    static constexpr size_t MinChunkSize = 4096;
+
+    if (Count < 2)
+        return pData;
+
+    size_t NumChunks = 1;
+    if (pThreadPool != nullptr && pThreadPool->GetNumThreads() > 1)
+        NumChunks = std::max(std::min(pThreadPool->GetNumThreads(), Count / MinChunkSize), size_t{1});
+    const auto ChunkSize = (Count + NumChunks - 1) / NumChunks;
+
+    // Histograms are stored per chunk to let every chunk scatter its elements independently
+    std::vector<size_t> Histograms(NumChunks * NumDigits);
+
+    auto RunChunks = [&](const std::function<void(size_t)>& ChunkTask) //
+    {
+        if (NumChunks == 1)
+        {
+            ChunkTask(0);
+            return;
+        }
+
+        std::vector<std::future<void>> Futures;
+        Futures.reserve(NumChunks - 1);
+        for (size_t c = 1; c < NumChunks; ++c)
+            Futures.emplace_back(pThreadPool->Enqueue([&ChunkTask, c]() { ChunkTask(c); }));
+        // Process the first chunk on the calling thread
+        ChunkTask(0);
+        for (auto& Future : Futures)
+            Future.get();
+    };
+
+    auto* pSrc = pData;
+    auto* pDst = pScratch;
+    for (Uint32 Pass = 0; Pass < NumPasses; ++Pass)
+    {
+        const auto Shift = Pass * DigitBits;
+
+        RunChunks([&](size_t Chunk) //
+                  {
+                      auto* Histogram = &Histograms[Chunk * NumDigits];
+                      std::memset(Histogram, 0, sizeof(size_t) * NumDigits);
+
+                      const auto Start = Chunk * ChunkSize;
+                      const auto End   = std::min(Start + ChunkSize, Count);
+                      for (size_t i = Start; i < End; ++i)
+                          ++Histogram[(pSrc[i].Key >> Shift) & (NumDigits - 1)];
+                  });
+
+        // Skip the pass if all keys have the same digit
+        const auto FirstDigit = (pSrc[0].Key >> Shift) & (NumDigits - 1);
+
+        size_t FirstDigitCount = 0;
+        for (size_t Chunk = 0; Chunk < NumChunks; ++Chunk)
+            FirstDigitCount += Histograms[Chunk * NumDigits + FirstDigit];
+        if (FirstDigitCount == Count)
+            continue;
+
+        // Convert the histograms into scatter offsets. Elements of the same digit
+        // from lower chunks go first to keep the sort stable.
+        size_t Offset = 0;
+        for (Uint32 Digit = 0; Digit < NumDigits; ++Digit)
+        {
+            for (size_t Chunk = 0; Chunk < NumChunks; ++Chunk)
+            {
+                auto& ChunkOffset = Histograms[Chunk * NumDigits + Digit];
+
+                const auto DigitCount = ChunkOffset;
+                ChunkOffset           = Offset;
+                Offset += DigitCount;
+            }
+        }
+        VERIFY_EXPR(Offset == Count);
+
+        RunChunks([&](size_t Chunk) //
+                  {
+                      auto* Offsets = &Histograms[Chunk * NumDigits];
+
+                      const auto Start = Chunk * ChunkSize;
+                      const auto End   = std::min(Start + ChunkSize, Count);
+                      for (size_t i = Start; i < End; ++i)
+                          pDst[Offsets[(pSrc[i].Key >> Shift) & (NumDigits - 1)]++] = pSrc[i];
+                  });
+
+        std::swap(pSrc, pDst);
+    }
+
+    return pSrc;
+}
+
+} // namespace Diligent
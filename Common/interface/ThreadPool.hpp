@@ -0,0 +1,156 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::ThreadPool class
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+/// Simple pool of worker threads that execute tasks in FIFO order.
+
+/// Tasks are enqueued with Enqueue() that returns std::future for the task result.
+/// The destructor waits until all enqueued tasks are complete.
+class ThreadPool
+{
+public:
+    /// \param [in] NumThreads - Number of worker threads. If zero, no threads are created
+    ///                          and tasks are executed by Enqueue() on the calling thread.
+    explicit ThreadPool(size_t NumThreads)
+    {
+        m_Workers.reserve(NumThreads);
+        for (size_t i = 0; i < NumThreads; ++i)
+            m_Workers.emplace_back(&ThreadPool::WorkerThreadProc, this);
+    }
+
+    // clang-format off
+    ThreadPool           (const ThreadPool&) = delete;
+    ThreadPool           (ThreadPool&&)      = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool& operator=(ThreadPool&&)      = delete;
+    // clang-format on
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> Lock{m_QueueMtx};
+            m_Stop = true;
+        }
+        m_NextTaskCond.notify_all();
+        for (auto& Worker : m_Workers)
+            Worker.join();
+        VERIFY(m_Tasks.empty(), "All tasks must have been executed by the worker threads");
+    }
+
+    /// Enqueues the task for execution and returns the future for its result.
+    /// If the task throws an exception, it is stored in the future.
+    template <typename TaskType>
+    std::future<typename std::result_of<TaskType()>::type> Enqueue(TaskType&& Task)
+    {
+        using ResultType = typename std::result_of<TaskType()>::type;
+
+        // std::function requires copyable callable, while std::packaged_task is move-only
+        auto pTask  = std::make_shared<std::packaged_task<ResultType()>>(std::forward<TaskType>(Task));
+        auto Future = pTask->get_future();
+        if (m_Workers.empty())
+        {
+            (*pTask)();
+            return Future;
+        }
+
+        {
+            std::lock_guard<std::mutex> Lock{m_QueueMtx};
+            VERIFY(!m_Stop, "Enqueueing tasks after the pool has been stopped is not allowed");
+            m_Tasks.emplace_back([pTask]() { (*pTask)(); });
+        }
+        m_NextTaskCond.notify_one();
+        return Future;
+    }
+
+    /// Blocks until all tasks enqueued so far are complete.
+    void WaitForAllTasks()
+    {
+        std::unique_lock<std::mutex> Lock{m_QueueMtx};
+        m_IdleCond.wait(Lock, [this] { return m_Tasks.empty() && m_NumRunningTasks == 0; });
+    }
+
+    size_t GetNumThreads() const { return m_Workers.size(); }
+
+private:
+    void WorkerThreadProc()
+    {
+        for (;;)
+        {
+            std::function<void()> Task;
+            {
+                std::unique_lock<std::mutex> Lock{m_QueueMtx};
+                m_NextTaskCond.wait(Lock, [this] { return m_Stop || !m_Tasks.empty(); });
+                // Finish all remaining tasks before exiting
+                if (m_Tasks.empty())
+                    return;
+
+                Task = std::move(m_Tasks.front());
+                m_Tasks.pop_front();
+                ++m_NumRunningTasks;
+            }
+
+            Task();
+
+            {
+                std::lock_guard<std::mutex> Lock{m_QueueMtx};
+                --m_NumRunningTasks;
+                if (!m_Tasks.empty() || m_NumRunningTasks != 0)
+                    continue;
+            }
+            m_IdleCond.notify_all();
+        }
+    }
+
+    std::vector<std::thread> m_Workers;
+
+    std::mutex                        m_QueueMtx;
+    std::condition_variable           m_NextTaskCond;
+    std::condition_variable           m_IdleCond;
+    std::deque<std::function<void()>> m_Tasks;
+    size_t                            m_NumRunningTasks = 0;
+    bool                              m_Stop            = false;
+};
+
+} // namespace Diligent
@@ -0,0 +1,412 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "AdvancedMath.hpp"
+
+#include <cstring>
+#include <algorithm>
+
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+#    define BOX_VISIBILITY_X86 1
+#    if defined(_MSC_VER)
+#        include <intrin.h>
+#        include <immintrin.h>
+#    else
+#        include <cpuid.h>
+#    endif
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define BOX_VISIBILITY_SSE2 1
+#elif defined(__ARM_NEON)
+#    include <arm_neon.h>
+#    define BOX_VISIBILITY_NEON 1
+#endif
+
+#include "BoxVisibilityBatch.hpp"
+
+namespace Diligent
+{
+
+#if BOX_VISIBILITY_X86
+// Defined in AdvancedMathAVX.cpp
+size_t TestBoxBatchesAVX(const PlaneArrays* Planes,
+                         Uint32             NumPlanes,
+                         size_t             FirstBox,
+                         size_t             NumBoxes,
+                         Uint32*            pInvisibleBits,
+                         Uint32*            pInsideBits);
+#endif
+
+namespace
+{
+
+Uint32 PreparePlanes(const ViewFrustum&    Frustum,
+                     const BoundBoxArrays& Boxes,
+                     FRUSTUM_PLANE_FLAGS   PlaneFlags,
+                     PlaneArrays           Planes[6])
+{
+    const Plane3D* pPlanes = reinterpret_cast<const Plane3D*>(&Frustum);
+
+    Uint32 NumPlanes = 0;
+    for (int iPlane = 0; iPlane < 6; ++iPlane)
+    {
+        if ((PlaneFlags & (1 << iPlane)) == 0)
+            continue;
+
+        const auto& Normal = pPlanes[iPlane].Normal;
+
+        auto& Plane = Planes[NumPlanes++];
+        Plane.Nx    = Normal.x;
+        Plane.Ny    = Normal.y;
+        Plane.Nz    = Normal.z;
+        Plane.D     = pPlanes[iPlane].Distance;
+
+        Plane.FarX  = Normal.x > 0 ? Boxes.MaxX : Boxes.MinX;
+        Plane.FarY  = Normal.y > 0 ? Boxes.MaxY : Boxes.MinY;
+        Plane.FarZ  = Normal.z > 0 ? Boxes.MaxZ : Boxes.MinZ;
+        Plane.NearX = Normal.x > 0 ? Boxes.MinX : Boxes.MaxX;
+        Plane.NearY = Normal.y > 0 ? Boxes.MinY : Boxes.MaxY;
+        Plane.NearZ = Normal.z > 0 ? Boxes.MinZ : Boxes.MaxZ;
+    }
+    return NumPlanes;
+}
+
+#if BOX_VISIBILITY_SSE2
+
+struct SSE2Ops
+{
+    using FloatVec = __m128;
+    using MaskVec  = __m128;
+
+    static constexpr Uint32 Width = 4;
+
+    static FloatVec Broadcast(float f) { return _mm_set1_ps(f); }
+    static FloatVec Load(const float* p) { return _mm_loadu_ps(p); }
+    static FloatVec Add(FloatVec a, FloatVec b) { return _mm_add_ps(a, b); }
+    static FloatVec Mul(FloatVec a, FloatVec b) { return _mm_mul_ps(a, b); }
+    static MaskVec  Less(FloatVec a, FloatVec b) { return _mm_cmplt_ps(a, b); }
+    static MaskVec  Greater(FloatVec a, FloatVec b) { return _mm_cmpgt_ps(a, b); }
+    static MaskVec  Or(MaskVec a, MaskVec b) { return _mm_or_ps(a, b); }
+    static MaskVec  And(MaskVec a, MaskVec b) { return _mm_and_ps(a, b); }
+    static MaskVec  MaskNone() { return _mm_setzero_ps(); }
+    static MaskVec  MaskAll() { return _mm_castsi128_ps(_mm_set1_epi32(-1)); }
+    static Uint32   MoveMask(MaskVec m) { return static_cast<Uint32>(_mm_movemask_ps(m)); }
+};
+
+#endif
+
+#if BOX_VISIBILITY_NEON
+
+struct NEONOps
+{
+    using FloatVec = float32x4_t;
+    using MaskVec  = uint32x4_t;
+
+    static constexpr Uint32 Width = 4;
+
+    static FloatVec Broadcast(float f) { return vdupq_n_f32(f); }
+    static FloatVec Load(const float* p) { return vld1q_f32(p); }
+    static FloatVec Add(FloatVec a, FloatVec b) { return vaddq_f32(a, b); }
+    static FloatVec Mul(FloatVec a, FloatVec b) { return vmulq_f32(a, b); }
+    static MaskVec  Less(FloatVec a, FloatVec b) { return vcltq_f32(a, b); }
+    static MaskVec  Greater(FloatVec a, FloatVec b) { return vcgtq_f32(a, b); }
+    static MaskVec  Or(MaskVec a, MaskVec b) { return vorrq_u32(a, b); }
+    static MaskVec  And(MaskVec a, MaskVec b) { return vandq_u32(a, b); }
+    static MaskVec  MaskNone() { return vdupq_n_u32(0); }
+    static MaskVec  MaskAll() { return vdupq_n_u32(~0u); }
+
+    // NEON has no movemask instruction: keep one bit of every lane and add the lanes
+    static Uint32 MoveMask(MaskVec m)
+    {
+        static const Uint32 LaneBits[4] = {1, 2, 4, 8};
+
+        const auto Bits = vandq_u32(m, vld1q_u32(LaneBits));
+        const auto Sum  = vpadd_u32(vget_low_u32(Bits), vget_high_u32(Bits));
+        return vget_lane_u32(vpadd_u32(Sum, Sum), 0);
+    }
+};
+
+#endif
+
+#if BOX_VISIBILITY_X86 && !defined(__AVX__)
+
+// Checks that the CPU supports AVX and that the OS saves the AVX registers on context switches
+bool IsAVXSupported()
+{
+    Uint32 CPUInfo[4] = {}; // EAX, EBX, ECX, EDX
+#    if defined(_MSC_VER)
+    __cpuid(reinterpret_cast<int*>(CPUInfo), 1);
+#    else
+    if (!__get_cpuid(1, &CPUInfo[0], &CPUInfo[1], &CPUInfo[2], &CPUInfo[3]))
+        return false;
+#    endif
+
+    constexpr Uint32 OSXSAVEBit = 1u << 27;
+    constexpr Uint32 AVXBit     = 1u << 28;
+    if ((CPUInfo[2] & (OSXSAVEBit | AVXBit)) != (OSXSAVEBit | AVXBit))
+        return false;
+
+        // Bits 1 and 2 of XCR0 indicate that the OS saves the SSE and AVX registers
+#    if defined(_MSC_VER)
+    const auto XCR0 = static_cast<Uint32>(_xgetbv(0));
+#    else
+    Uint32 XCR0 = 0, XCR0Hi = 0;
+    __asm__ __volatile__("xgetbv"
+                         : "=a"(XCR0), "=d"(XCR0Hi)
+                         : "c"(0));
+#    endif
+    return (XCR0 & 0x6u) == 0x6u;
+}
+
+#endif
+
+// Returns the fastest batch kernel supported by the CPU, or null if there is none
+BoxBatchKernelType SelectBoxBatchKernel()
+{
+#if defined(__AVX__)
+    return TestBoxBatchesAVX;
+#else
+#    if BOX_VISIBILITY_X86
+    if (IsAVXSupported())
+        return TestBoxBatchesAVX;
+#    endif
+
+#    if BOX_VISIBILITY_SSE2
+    return TestBoxBatches<SSE2Ops>;
+#    elif BOX_VISIBILITY_NEON
+    return TestBoxBatches<NEONOps>;
+#    else
+    return nullptr;
+#    endif
+#endif
+}
+
+BoxBatchKernelType GetBoxBatchKernel()
+{
+    static const BoxBatchKernelType Kernel = SelectBoxBatchKernel();
+    return Kernel;
+}
+
+// Scalar fallback that is also used to process the boxes that do not fill the whole batch.
+// Boxes [FirstBox + Start, FirstBox + NumBoxes) are tested, see BoxBatchKernelType.
+void TestBoxesScalar(const PlaneArrays* Planes,
+                     Uint32             NumPlanes,
+                     size_t             FirstBox,
+                     size_t             Start,
+                     size_t             NumBoxes,
+                     Uint32*            pInvisibleBits,
+                     Uint32*            pInsideBits)
+{
+    for (size_t i = Start; i < NumBoxes; ++i)
+    {
+        const auto Box = FirstBox + i;
+
+        bool Invisible = false;
+        bool Inside    = true;
+        for (Uint32 p = 0; p < NumPlanes && !Invisible; ++p)
+        {
+            const auto& Plane = Planes[p];
+
+            const float DFar = Plane.FarX[Box] * Plane.Nx + Plane.FarY[Box] * Plane.Ny + Plane.FarZ[Box] * Plane.Nz + Plane.D;
+            if (DFar < 0)
+                Invisible = true;
+
+            const float DNear = Plane.NearX[Box] * Plane.Nx + Plane.NearY[Box] * Plane.Ny + Plane.NearZ[Box] * Plane.Nz + Plane.D;
+            if (!(DNear > 0))
+                Inside = false;
+        }
+
+        if (Invisible)
+            pInvisibleBits[i / 32] |= 1u << (i % 32);
+        if (Inside)
+            pInsideBits[i / 32] |= 1u << (i % 32);
+    }
+}
+
+// Tests the boxes and calls the handler for every group of 32 boxes starting at a multiple of 32
+// (the last group may be smaller) with the bit masks of the boxes that are invisible and fully
+// inside all planes.
+template <typename HandlerType>
+void TestBoxes(const ViewFrustum&    Frustum,
+               const BoundBoxArrays& Boxes,
+               size_t                NumBoxes,
+               FRUSTUM_PLANE_FLAGS   PlaneFlags,
+               const HandlerType&    Handler)
+{
+    VERIFY(NumBoxes == 0 || (Boxes.MinX != nullptr && Boxes.MinY != nullptr && Boxes.MinZ != nullptr && Boxes.MaxX != nullptr && Boxes.MaxY != nullptr && Boxes.MaxZ != nullptr),
+           "Bounding box arrays must not be null");
+
+    PlaneArrays Planes[6];
+    const auto  NumPlanes = PreparePlanes(Frustum, Boxes, PlaneFlags, Planes);
+
+    const auto BatchKernel = GetBoxBatchKernel();
+
+    // The boxes are processed in chunks so that the bit masks stay on the stack
+    constexpr size_t ChunkSize = 256;
+    for (size_t FirstBox = 0; FirstBox < NumBoxes; FirstBox += ChunkSize)
+    {
+        const auto NumChunkBoxes = std::min(ChunkSize, NumBoxes - FirstBox);
+
+        Uint32 InvisibleBits[ChunkSize / 32] = {};
+        Uint32 InsideBits[ChunkSize / 32]    = {};
+
+        const auto NumProcessed = BatchKernel != nullptr ?
+            BatchKernel(Planes, NumPlanes, FirstBox, NumChunkBoxes, InvisibleBits, InsideBits) :
+            0;
+        TestBoxesScalar(Planes, NumPlanes, FirstBox, NumProcessed, NumChunkBoxes, InvisibleBits, InsideBits);
+
+        for (size_t i = 0; i < NumChunkBoxes; i += 32)
+        {
+            const auto Count = static_cast<Uint32>(std::min(size_t{32}, NumChunkBoxes - i));
+            Handler(FirstBox + i, Count, InvisibleBits[i / 32], InsideBits[i / 32]);
+        }
+    }
+}
+
+inline Uint32 GetLowBitsMask(Uint32 Count)
+{
+    return Count < 32 ? (1u << Count) - 1u : ~0u;
+}
+
+inline BoundBox GetBox(const BoundBoxArrays& Boxes, size_t i)
+{
+    return BoundBox{
+        float3{Boxes.MinX[i], Boxes.MinY[i], Boxes.MinZ[i]},
+        float3{Boxes.MaxX[i], Boxes.MaxY[i], Boxes.MaxZ[i]} //
+    };
+}
+
+} // namespace
+
+static_assert(static_cast<int>(BoxVisibility::Invisible) == 0 &&
+                  static_cast<int>(BoxVisibility::Intersecting) == 1 &&
+                  static_cast<int>(BoxVisibility::FullyVisible) == 2,
+              "GetBoxesVisibility() relies on the values of BoxVisibility enum");
+
+void GetBoxesVisibility(const ViewFrustum&    Frustum,
+                        const BoundBoxArrays& Boxes,
+                        size_t                NumBoxes,
+                        BoxVisibility*        pVisibility,
+                        FRUSTUM_PLANE_FLAGS   PlaneFlags)
+{
+    VERIFY(NumBoxes == 0 || pVisibility != nullptr, "Visibility array must not be null");
+
+    TestBoxes(Frustum, Boxes, NumBoxes, PlaneFlags,
+              [pVisibility](size_t FirstBox, Uint32 Count, Uint32 InvisibleBits, Uint32 InsideBits) //
+              {
+                  // Invisible -> 0, Intersecting -> 1, FullyVisible -> 2
+                  for (Uint32 i = 0; i < Count; ++i)
+                  {
+                      const auto Visible        = (~InvisibleBits >> i) & 1u;
+                      const auto Inside         = (InsideBits >> i) & 1u;
+                      pVisibility[FirstBox + i] = static_cast<BoxVisibility>(Visible << Inside);
+                  }
+              });
+}
+
+void GetBoxesVisibility(const ViewFrustumExt& FrustumExt,
+                        const BoundBoxArrays& Boxes,
+                        size_t                NumBoxes,
+                        BoxVisibility*        pVisibility,
+                        FRUSTUM_PLANE_FLAGS   PlaneFlags)
+{
+    GetBoxesVisibility(static_cast<const ViewFrustum&>(FrustumExt), Boxes, NumBoxes, pVisibility, PlaneFlags);
+
+    if ((PlaneFlags & FRUSTUM_PLANE_FLAG_FULL_FRUSTUM) == FRUSTUM_PLANE_FLAG_FULL_FRUSTUM)
+    {
+        // Intersecting boxes may still be culled by the frustum corners test,
+        // which is rarely needed and is performed by the scalar function
+        for (size_t i = 0; i < NumBoxes; ++i)
+        {
+            if (pVisibility[i] == BoxVisibility::Intersecting)
+                pVisibility[i] = GetBoxVisibility(FrustumExt, GetBox(Boxes, i), PlaneFlags);
+        }
+    }
+}
+
+void GetBoxesVisibilityMask(const ViewFrustum&    Frustum,
+                            const BoundBoxArrays& Boxes,
+                            size_t                NumBoxes,
+                            Uint32*               pVisibilityMask,
+                            FRUSTUM_PLANE_FLAGS   PlaneFlags)
+{
+    VERIFY(NumBoxes == 0 || pVisibilityMask != nullptr, "Visibility mask must not be null");
+    if (NumBoxes == 0)
+        return;
+
+    memset(pVisibilityMask, 0, (NumBoxes + 31) / 32 * sizeof(Uint32));
+
+    TestBoxes(Frustum, Boxes, NumBoxes, PlaneFlags,
+              [pVisibilityMask](size_t FirstBox, Uint32 Count, Uint32 InvisibleBits, Uint32 /*InsideBits*/) //
+              {
+                  const auto VisibleBits = ~InvisibleBits & GetLowBitsMask(Count);
+                  pVisibilityMask[FirstBox / 32] |= VisibleBits;
+              });
+}
+
+void GetBoxesVisibilityMask(const ViewFrustumExt& FrustumExt,
+                            const BoundBoxArrays& Boxes,
+                            size_t                NumBoxes,
+                            Uint32*               pVisibilityMask,
+                            FRUSTUM_PLANE_FLAGS   PlaneFlags)
+{
+    if ((PlaneFlags & FRUSTUM_PLANE_FLAG_FULL_FRUSTUM) != FRUSTUM_PLANE_FLAG_FULL_FRUSTUM)
+    {
+        GetBoxesVisibilityMask(static_cast<const ViewFrustum&>(FrustumExt), Boxes, NumBoxes, pVisibilityMask, PlaneFlags);
+        return;
+    }
+
+    VERIFY(NumBoxes == 0 || pVisibilityMask != nullptr, "Visibility mask must not be null");
+    if (NumBoxes == 0)
+        return;
+
+    memset(pVisibilityMask, 0, (NumBoxes + 31) / 32 * sizeof(Uint32));
+
+    TestBoxes(FrustumExt, Boxes, NumBoxes, PlaneFlags,
+              [&](size_t FirstBox, Uint32 Count, Uint32 InvisibleBits, Uint32 InsideBits) //
+              {
+                  auto VisibleBits = ~InvisibleBits & GetLowBitsMask(Count);
+
+                  // Run the frustum corners test for the intersecting boxes
+                  const auto IntersectingBits = VisibleBits & ~InsideBits;
+                  for (Uint32 i = 0; i < Count; ++i)
+                  {
+                      if ((IntersectingBits & (1u << i)) != 0 &&
+                          GetBoxVisibility(FrustumExt, GetBox(Boxes, FirstBox + i), PlaneFlags) == BoxVisibility::Invisible)
+                          VisibleBits &= ~(1u << i);
+                  }
+
+                  pVisibilityMask[FirstBox / 32] |= VisibleBits;
+              });
+}
+
+} // namespace Diligent
@@ -0,0 +1,94 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+// AVX version of the batched bounding box visibility kernel. The file is compiled for every target;
+// on x86 the AVX code is enabled for this file only, and AdvancedMath.cpp only calls it if the CPU
+// and the OS support AVX. Do not include any headers that define inline functions after the target
+// is switched, see BoxVisibilityBatch.hpp.
+
+#include <cstddef>
+
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+
+#    include <immintrin.h>
+
+#    if defined(__clang__)
+#        pragma clang attribute push(__attribute__((target("avx"))), apply_to = function)
+#    elif defined(__GNUC__)
+#        pragma GCC push_options
+#        pragma GCC target("avx")
+#    endif
+
+#    include "BoxVisibilityBatch.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+struct AVXOps
+{
+    using FloatVec = __m256;
+    using MaskVec  = __m256;
+
+    static constexpr Uint32 Width = 8;
+
+    static FloatVec Broadcast(float f) { return _mm256_set1_ps(f); }
+    static FloatVec Load(const float* p) { return _mm256_loadu_ps(p); }
+    static FloatVec Add(FloatVec a, FloatVec b) { return _mm256_add_ps(a, b); }
+    static FloatVec Mul(FloatVec a, FloatVec b) { return _mm256_mul_ps(a, b); }
+    static MaskVec  Less(FloatVec a, FloatVec b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static MaskVec  Greater(FloatVec a, FloatVec b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static MaskVec  Or(MaskVec a, MaskVec b) { return _mm256_or_ps(a, b); }
+    static MaskVec  And(MaskVec a, MaskVec b) { return _mm256_and_ps(a, b); }
+    static MaskVec  MaskNone() { return _mm256_setzero_ps(); }
+    static MaskVec  MaskAll() { return _mm256_castsi256_ps(_mm256_set1_epi32(-1)); }
+    static Uint32   MoveMask(MaskVec m) { return static_cast<Uint32>(_mm256_movemask_ps(m)); }
+};
+
+} // namespace
+
+size_t TestBoxBatchesAVX(const PlaneArrays* Planes,
+                         Uint32             NumPlanes,
+                         size_t             FirstBox,
+                         size_t             NumBoxes,
+                         Uint32*            pInvisibleBits,
+                         Uint32*            pInsideBits)
+{
+    return TestBoxBatches<AVXOps>(Planes, NumPlanes, FirstBox, NumBoxes, pInvisibleBits, pInsideBits);
+}
+
+} // namespace Diligent
+
+#    if defined(__clang__)
+#        pragma clang attribute pop
+#    elif defined(__GNUC__)
+#        pragma GCC pop_options
+#    endif
+
+#endif
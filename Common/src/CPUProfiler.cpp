@@ -0,0 +1,324 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "CPUProfiler.hpp"
+
+#include <chrono>
+#include <mutex>
+#include <memory>
+#include <algorithm>
+#include <cstdio>
+
+#include "FileWrapper.hpp"
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+std::atomic<bool> CPUProfiler::m_Enabled{true};
+
+namespace
+{
+
+static_assert((CPUProfiler::ThreadBufferSize & (CPUProfiler::ThreadBufferSize - 1)) == 0, "Thread buffer size must be a power of two");
+
+// Events are written by the owning thread only. The write index is published with release
+// semantics so that the events below it are visible to the thread that collects them.
+struct ThreadBuffer
+{
+    explicit ThreadBuffer(Uint32 Id) :
+        ThreadId{Id},
+        Events{new CPUProfileEvent[CPUProfiler::ThreadBufferSize]}
+    {}
+
+    const Uint32                             ThreadId;
+    const std::unique_ptr<CPUProfileEvent[]> Events;
+
+    std::atomic<Uint64> WriteIdx{0};
+    // Index of the first event recorded after the last reset. Written by the collecting thread only.
+    std::atomic<Uint64> ResetIdx{0};
+    std::atomic<bool>   Alive{true};
+
+    // Current scope nesting depth, accessed by the owning thread only
+    Uint32 Depth = 0;
+
+    std::mutex  NameMtx;
+    std::string Name;
+};
+
+class ThreadBufferRegistry
+{
+public:
+    static ThreadBufferRegistry& Get()
+    {
+        static ThreadBufferRegistry Registry;
+        return Registry;
+    }
+
+    std::shared_ptr<ThreadBuffer> Register()
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        m_Buffers.emplace_back(std::make_shared<ThreadBuffer>(m_NextThreadId++));
+        return m_Buffers.back();
+    }
+
+    template <typename HandlerType>
+    void ProcessBuffers(HandlerType Handler)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        for (auto& pBuffer : m_Buffers)
+            Handler(*pBuffer);
+    }
+
+    void RemoveExitedThreads()
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        m_Buffers.erase(std::remove_if(m_Buffers.begin(), m_Buffers.end(),
+                                       [](const std::shared_ptr<ThreadBuffer>& pBuffer) {
+                                           return !pBuffer->Alive.load();
+                                       }),
+                        m_Buffers.end());
+    }
+
+private:
+    std::mutex                                 m_Mtx;
+    std::vector<std::shared_ptr<ThreadBuffer>> m_Buffers;
+    Uint32                                     m_NextThreadId = 0;
+};
+
+// The registry keeps the buffer alive after the thread exits so that its events can still be exported.
+struct ThreadBufferHolder
+{
+    ~ThreadBufferHolder()
+    {
+        if (pBuffer)
+            pBuffer->Alive.store(false);
+    }
+
+    std::shared_ptr<ThreadBuffer> pBuffer;
+};
+
+ThreadBuffer& GetThreadBuffer()
+{
+    static thread_local ThreadBufferHolder Holder;
+    if (!Holder.pBuffer)
+        Holder.pBuffer = ThreadBufferRegistry::Get().Register();
+    return *Holder.pBuffer;
+}
+
+const std::chrono::steady_clock::time_point& GetEpoch()
+{
+    static const auto Epoch = std::chrono::steady_clock::now();
+    return Epoch;
+}
+
+void CollectThreadEvents(ThreadBuffer& Buffer, CPUProfileThreadEvents& ThreadEvents)
+{
+    constexpr Uint64 BufferSize = CPUProfiler::ThreadBufferSize;
+    constexpr Uint64 BufferMask = BufferSize - 1;
+
+    const auto EndIdx   = Buffer.WriteIdx.load(std::memory_order_acquire);
+    const auto StartIdx = std::max(Buffer.ResetIdx.load(std::memory_order_relaxed), EndIdx > BufferSize ? EndIdx - BufferSize : Uint64{0});
+
+    auto& Events = ThreadEvents.Events;
+    Events.reserve(static_cast<size_t>(EndIdx - StartIdx));
+    for (auto Idx = StartIdx; Idx < EndIdx; ++Idx)
+        Events.emplace_back(Buffer.Events[static_cast<size_t>(Idx & BufferMask)]);
+
+    // The owning thread may have kept recording while the events were copied.
+    // Discard the events whose slots may have been overwritten, including the one being written now.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const auto LastIdx       = Buffer.WriteIdx.load(std::memory_order_relaxed);
+    const auto FirstValidIdx = LastIdx + 1 > BufferSize ? LastIdx + 1 - BufferSize : Uint64{0};
+    if (FirstValidIdx > StartIdx)
+    {
+        const auto NumStale = static_cast<size_t>(std::min(FirstValidIdx - StartIdx, EndIdx - StartIdx));
+        Events.erase(Events.begin(), Events.begin() + NumStale);
+    }
+
+    ThreadEvents.ThreadId = Buffer.ThreadId;
+    {
+        std::lock_guard<std::mutex> Lock{Buffer.NameMtx};
+        ThreadEvents.ThreadName = Buffer.Name;
+    }
+}
+
+void AppendJsonString(std::string& Json, const Char* Str)
+{
+    Json.push_back('"');
+    for (; Str != nullptr && *Str != '\0'; ++Str)
+    {
+        const auto c = *Str;
+        if (c == '"' || c == '\\')
+        {
+            Json.push_back('\\');
+            Json.push_back(c);
+        }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            char Escaped[8];
+            snprintf(Escaped, sizeof(Escaped), "\\u%04x", static_cast<unsigned int>(c));
+            Json.append(Escaped);
+        }
+        else
+        {
+            Json.push_back(c);
+        }
+    }
+    Json.push_back('"');
+}
+
+// Trace event timestamps are in microseconds
+void AppendMicroseconds(std::string& Json, Uint64 Nanoseconds)
+{
+    char Str[32];
+    snprintf(Str, sizeof(Str), "%llu.%03u", static_cast<unsigned long long>(Nanoseconds / 1000), static_cast<unsigned int>(Nanoseconds % 1000));
+    Json.append(Str);
+}
+
+} // namespace
+
+Uint64 CPUProfiler::GetTimestamp()
+{
+    // The epoch must be initialized before the current time is queried
+    const auto& Epoch = GetEpoch();
+    const auto  Now   = std::chrono::steady_clock::now();
+    return static_cast<Uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(Now - Epoch).count());
+}
+
+void CPUProfiler::SetThreadName(const Char* Name)
+{
+    auto& Buffer = GetThreadBuffer();
+
+    std::lock_guard<std::mutex> Lock{Buffer.NameMtx};
+    Buffer.Name = Name != nullptr ? Name : "";
+}
+
+Uint64 CPUProfiler::BeginScope()
+{
+    ++GetThreadBuffer().Depth;
+    return GetTimestamp();
+}
+
+void CPUProfiler::EndScope(const Char* Name, Uint64 StartTime)
+{
+    const auto EndTime = GetTimestamp();
+
+    auto& Buffer = GetThreadBuffer();
+    VERIFY(Buffer.Depth > 0, "Unbalanced EndScope() call");
+    --Buffer.Depth;
+
+    const auto Idx = Buffer.WriteIdx.load(std::memory_order_relaxed);
+    auto&      Evt = Buffer.Events[static_cast<size_t>(Idx & (ThreadBufferSize - 1))];
+    Evt.Name       = Name;
+    Evt.StartTime  = StartTime;
+    Evt.Duration   = EndTime - StartTime;
+    Evt.Depth      = Buffer.Depth;
+    Buffer.WriteIdx.store(Idx + 1, std::memory_order_release);
+}
+
+void CPUProfiler::Reset()
+{
+    auto& Registry = ThreadBufferRegistry::Get();
+    Registry.RemoveExitedThreads();
+    Registry.ProcessBuffers([](ThreadBuffer& Buffer) {
+        Buffer.ResetIdx.store(Buffer.WriteIdx.load(std::memory_order_acquire), std::memory_order_relaxed);
+    });
+}
+
+std::vector<CPUProfileThreadEvents> CPUProfiler::CollectEvents()
+{
+    std::vector<CPUProfileThreadEvents> ThreadEvents;
+    ThreadBufferRegistry::Get().ProcessBuffers([&ThreadEvents](ThreadBuffer& Buffer) {
+        ThreadEvents.emplace_back();
+        CollectThreadEvents(Buffer, ThreadEvents.back());
+    });
+    return ThreadEvents;
+}
+
+void CPUProfiler::ExportChromeTrace(std::string& Json)
+{
+    const auto ThreadEvents = CollectEvents();
+
+    Json.clear();
+    Json.append("{\"traceEvents\":[");
+    bool IsFirst = true;
+    for (const auto& Thread : ThreadEvents)
+    {
+        const auto Tid = std::to_string(Thread.ThreadId);
+        if (!Thread.ThreadName.empty())
+        {
+            Json.append(IsFirst ? "\n" : ",\n");
+            IsFirst = false;
+            Json.append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":");
+            Json.append(Tid);
+            Json.append(",\"args\":{\"name\":");
+            AppendJsonString(Json, Thread.ThreadName.c_str());
+            Json.append("}}");
+        }
+
+        for (const auto& Evt : Thread.Events)
+        {
+            Json.append(IsFirst ? "\n" : ",\n");
+            IsFirst = false;
+            Json.append("{\"name\":");
+            AppendJsonString(Json, Evt.Name);
+            Json.append(",\"cat\":\"Diligent\",\"ph\":\"X\",\"ts\":");
+            AppendMicroseconds(Json, Evt.StartTime);
+            Json.append(",\"dur\":");
+            AppendMicroseconds(Json, Evt.Duration);
+            Json.append(",\"pid\":0,\"tid\":");
+            Json.append(Tid);
+            Json.append("}");
+        }
+    }
+    Json.append("\n],\"displayTimeUnit\":\"ns\"}\n");
+}
+
+bool CPUProfiler::SaveChromeTrace(const Char* FilePath)
+{
+    std::string Json;
+    ExportChromeTrace(Json);
+
+    FileWrapper File{FilePath, EFileAccessMode::Overwrite};
+    if (!File)
+    {
+        LOG_ERROR_MESSAGE("Failed to open file '", FilePath, "' to save the CPU profiler trace");
+        return false;
+    }
+
+    if (!File->Write(Json.data(), Json.size()))
+    {
+        LOG_ERROR_MESSAGE("Failed to write the CPU profiler trace to file '", FilePath, "'");
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace Diligent
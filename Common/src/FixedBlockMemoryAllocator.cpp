@@ -27,6 +27,7 @@
 
 #include "pch.h"
 #include <algorithm>
+#include <new>
 #include "FixedBlockMemoryAllocator.hpp"
 #include "Align.hpp"
 
@@ -38,24 +39,77 @@ static size_t AdjustBlockSize(size_t BlockSize)
     return Align(std::max(BlockSize, size_t{1}), sizeof(void*));
 }
 
+static size_t GetPageAlignment(size_t BlockSize, Uint32 NumBlocksInPage, bool EnableThreadCache, size_t PageHeaderSize)
+{
+    if (!EnableThreadCache)
+        return 0;
+
+    // Page alignment is the smallest power of two that is large enough to hold all blocks. The header
+    // takes the space of the first block(s) rather than doubling the page when the blocks fill it exactly.
+    const auto MinPageSize   = BlockSize * std::max(NumBlocksInPage, Uint32{1});
+    size_t     PageAlignment = 1;
+    while (PageAlignment < MinPageSize || PageAlignment < PageHeaderSize + BlockSize)
+        PageAlignment *= 2;
+    return PageAlignment;
+}
+
+static Uint32 GetNumBlocksInPage(size_t BlockSize, Uint32 NumBlocksInPage, size_t PageAlignment, size_t PageHeaderSize)
+{
+    // When pages are aligned, use all space available in the page
+    return PageAlignment != 0 ?
+        static_cast<Uint32>((PageAlignment - PageHeaderSize) / BlockSize) :
+        NumBlocksInPage;
+}
+
 FixedBlockMemoryAllocator::FixedBlockMemoryAllocator(IMemoryAllocator& RawMemoryAllocator,
                                                      size_t            BlockSize,
-                                                     Uint32            NumBlocksInPage) :
+                                                     Uint32            NumBlocksInPage,
+                                                     bool              EnableThreadCache) :
     // clang-format off
-    m_PagePool          (STD_ALLOCATOR_RAW_MEM(MemoryPage, RawMemoryAllocator, "Allocator for vector<MemoryPage>")),
-    m_AvailablePages    (STD_ALLOCATOR_RAW_MEM(size_t, RawMemoryAllocator, "Allocator for unordered_set<size_t>") ),
-    m_AddrToPageId      (STD_ALLOCATOR_RAW_MEM(AddrToPageIdMapElem, RawMemoryAllocator, "Allocator for unordered_map<void*, size_t>")),
-    m_RawMemoryAllocator{RawMemoryAllocator        },
-    m_BlockSize         {AdjustBlockSize(BlockSize)},
-    m_NumBlocksInPage   {NumBlocksInPage           }
+    m_PagePool            (STD_ALLOCATOR_RAW_MEM(MemoryPage, RawMemoryAllocator, "Allocator for vector<MemoryPage>")),
+    m_AvailablePages      (STD_ALLOCATOR_RAW_MEM(size_t, RawMemoryAllocator, "Allocator for unordered_set<size_t>") ),
+    m_AddrToPageId        (STD_ALLOCATOR_RAW_MEM(AddrToPageIdMapElem, RawMemoryAllocator, "Allocator for unordered_map<void*, size_t>")),
+    m_RawMemoryAllocator  {RawMemoryAllocator        },
+    m_BlockSize           {AdjustBlockSize(BlockSize)},
+    m_PageAlignment       {GetPageAlignment(m_BlockSize, NumBlocksInPage, EnableThreadCache, PageHeaderSize)},
+    m_NumBlocksInPage     {GetNumBlocksInPage(m_BlockSize, NumBlocksInPage, m_PageAlignment, PageHeaderSize)},
+    m_ThreadCacheBatchSize{std::max(std::min(m_NumBlocksInPage / 2, Uint32{32}), Uint32{1})},
+    m_PageChunks          (STD_ALLOCATOR_RAW_MEM(void*, RawMemoryAllocator, "Allocator for vector<void*>"))
 // clang-format on
 {
-    // Allocate one page
-    CreateNewPage();
+    static_assert(sizeof(ThreadCache) == 64 && alignof(ThreadCache) == 64, "Thread cache is expected to occupy one cache line");
+    static_assert(PageHeaderSize >= sizeof(size_t) && PageHeaderSize % sizeof(void*) == 0, "Page header is too small or not properly aligned");
+
+    if (EnableThreadCache)
+    {
+        // Allocate extra space to be able to align the caches by the cache line size
+        m_pThreadCacheMemory = m_RawMemoryAllocator.Allocate(sizeof(ThreadCache) * MaxThreadCaches + alignof(ThreadCache) - 1, "FixedBlockMemoryAllocator thread caches", __FILE__, __LINE__);
+        m_ThreadCaches       = reinterpret_cast<ThreadCache*>(Align(reinterpret_cast<size_t>(m_pThreadCacheMemory), alignof(ThreadCache)));
+        for (Uint32 i = 0; i < MaxThreadCaches; ++i)
+            new (m_ThreadCaches + i) ThreadCache{};
+
+        // Aligned pages are allocated in chunks, so the first chunk is only allocated when the first block is requested
+    }
+    else
+    {
+        // Allocate one page
+        CreateNewPage();
+    }
 }
 
 FixedBlockMemoryAllocator::~FixedBlockMemoryAllocator()
 {
+    if (m_ThreadCaches != nullptr)
+    {
+        // Return all cached blocks to their pages
+        for (Uint32 i = 0; i < MaxThreadCaches; ++i)
+        {
+            FlushThreadCache(m_ThreadCaches[i], m_ThreadCaches[i].NumBlocks);
+            m_ThreadCaches[i].~ThreadCache();
+        }
+        m_RawMemoryAllocator.Free(m_pThreadCacheMemory);
+    }
+
 #ifdef DILIGENT_DEBUG
     for (size_t p = 0; p < m_PagePool.size(); ++p)
     {
@@ -63,22 +117,48 @@ FixedBlockMemoryAllocator::~FixedBlockMemoryAllocator()
         VERIFY(m_AvailablePages.find(p) != m_AvailablePages.end(), "Memory page is not in the available page pool");
     }
 #endif
+
+    // Aligned pages do not own their memory
+    for (auto* pChunk : m_PageChunks)
+        m_RawMemoryAllocator.Free(pChunk);
 }
 
 void FixedBlockMemoryAllocator::CreateNewPage()
 {
-    m_PagePool.emplace_back(*this);
+    if (m_PageAlignment != 0)
+    {
+        if (m_NumChunkPagesLeft == 0)
+        {
+            // Allocate one extra page to be able to align the pages
+            const auto ChunkSize = m_PageAlignment * (NumPagesInChunk + 1);
+            auto*      pChunk    = reinterpret_cast<Uint8*>(m_RawMemoryAllocator.Allocate(ChunkSize, "FixedBlockMemoryAllocator page chunk", __FILE__, __LINE__));
+            m_PageChunks.push_back(pChunk);
+
+            const auto ChunkStart = reinterpret_cast<size_t>(pChunk);
+            const auto FirstPage  = Align(ChunkStart, m_PageAlignment);
+            m_pNextChunkPage      = pChunk + (FirstPage - ChunkStart);
+            m_NumChunkPagesLeft   = static_cast<Uint32>((ChunkStart + ChunkSize - FirstPage) / m_PageAlignment);
+            VERIFY_EXPR(m_NumChunkPagesLeft >= NumPagesInChunk);
+        }
+
+        auto* pPageMemory = m_pNextChunkPage;
+        m_pNextChunkPage += m_PageAlignment;
+        --m_NumChunkPagesLeft;
+
+        // Page header keeps the page index
+        *reinterpret_cast<size_t*>(pPageMemory) = m_PagePool.size();
+        m_PagePool.emplace_back(*this, pPageMemory + PageHeaderSize);
+    }
+    else
+    {
+        m_PagePool.emplace_back(*this);
+        m_AddrToPageId.reserve(m_PagePool.size() * m_NumBlocksInPage);
+    }
     m_AvailablePages.insert(m_PagePool.size() - 1);
-    m_AddrToPageId.reserve(m_PagePool.size() * m_NumBlocksInPage);
 }
 
-void* FixedBlockMemoryAllocator::Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber)
+void* FixedBlockMemoryAllocator::AllocateFromPages()
 {
-    Size = AdjustBlockSize(Size);
-    VERIFY(m_BlockSize == Size, "Requested size (", Size, ") does not match the block size (", m_BlockSize, ")");
-
-    std::lock_guard<std::mutex> LockGuard(m_Mutex);
-
     if (m_AvailablePages.empty())
     {
         CreateNewPage();
@@ -87,7 +167,8 @@ void* FixedBlockMemoryAllocator::Allocate(size_t Size, const Char* dbgDescriptio
     auto  PageId = *m_AvailablePages.begin();
     auto& Page   = m_PagePool[PageId];
     auto* Ptr    = Page.Allocate();
-    m_AddrToPageId.insert(std::make_pair(Ptr, PageId));
+    if (m_PageAlignment == 0)
+        m_AddrToPageId.insert(std::make_pair(Ptr, PageId));
     if (!Page.HasSpace())
     {
         m_AvailablePages.erase(m_AvailablePages.begin());
@@ -96,30 +177,173 @@ void* FixedBlockMemoryAllocator::Allocate(size_t Size, const Char* dbgDescriptio
     return Ptr;
 }
 
-void FixedBlockMemoryAllocator::Free(void* Ptr)
+void FixedBlockMemoryAllocator::FreeToPages(void* Ptr)
 {
-    std::lock_guard<std::mutex> LockGuard(m_Mutex);
-    auto                        PageIdIt = m_AddrToPageId.find(Ptr);
-    if (PageIdIt != m_AddrToPageId.end())
+    size_t PageId = 0;
+    if (m_PageAlignment != 0)
+    {
+        // Read the page index from the header of the aligned page
+        const auto PageStart = reinterpret_cast<size_t>(Ptr) & ~(m_PageAlignment - 1);
+        PageId               = *reinterpret_cast<const size_t*>(PageStart);
+    }
+    else
     {
-        auto PageId = PageIdIt->second;
-        VERIFY_EXPR(PageId >= 0 && PageId < m_PagePool.size());
-        m_PagePool[PageId].DeAllocate(Ptr);
-        m_AvailablePages.insert(PageId);
+        auto PageIdIt = m_AddrToPageId.find(Ptr);
+        if (PageIdIt == m_AddrToPageId.end())
+        {
+            UNEXPECTED("Address not found in the allocations list - double freeing memory?");
+            return;
+        }
+        PageId = PageIdIt->second;
         m_AddrToPageId.erase(PageIdIt);
-        if (m_AvailablePages.size() > 1 && !m_PagePool[PageId].HasAllocations())
+    }
+
+    VERIFY_EXPR(PageId < m_PagePool.size());
+    m_PagePool[PageId].DeAllocate(Ptr);
+    m_AvailablePages.insert(PageId);
+    if (m_AvailablePages.size() > 1 && !m_PagePool[PageId].HasAllocations())
+    {
+        // In current implementation pages are never released!
+        // Note that if we delete a page, all indices past it will be invalid
+
+        //m_PagePool.erase(m_PagePool.begin() + PageId);
+        //m_AvailablePages.erase(PageId);
+    }
+}
+
+void FixedBlockMemoryAllocator::RefillThreadCache(ThreadCache& Cache)
+{
+    std::lock_guard<std::mutex> LockGuard(m_Mutex);
+    for (Uint32 i = 0; i < m_ThreadCacheBatchSize; ++i)
+    {
+        auto* Ptr                      = AllocateFromPages();
+        *reinterpret_cast<void**>(Ptr) = Cache.pHead;
+        Cache.pHead                    = Ptr;
+        ++Cache.NumBlocks;
+    }
+}
+
+void FixedBlockMemoryAllocator::FlushThreadCache(ThreadCache& Cache, Uint32 NumBlocksToFlush)
+{
+    VERIFY_EXPR(NumBlocksToFlush <= Cache.NumBlocks);
+    std::lock_guard<std::mutex> LockGuard(m_Mutex);
+    for (Uint32 i = 0; i < NumBlocksToFlush; ++i)
+    {
+        auto* Ptr   = Cache.pHead;
+        Cache.pHead = *reinterpret_cast<void**>(Ptr);
+        --Cache.NumBlocks;
+        FreeToPages(Ptr);
+    }
+}
+
+namespace
+{
+
+class ThreadCacheSlotRegistry
+{
+public:
+    Uint32 Acquire()
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        if (!m_FreeSlots.empty())
+        {
+            auto Slot = m_FreeSlots.back();
+            m_FreeSlots.pop_back();
+            return Slot;
+        }
+        return m_NextSlot++;
+    }
+
+    void Release(Uint32 Slot)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        m_FreeSlots.push_back(Slot);
+    }
+
+    static ThreadCacheSlotRegistry& Get()
+    {
+        static ThreadCacheSlotRegistry Registry;
+        return Registry;
+    }
+
+private:
+    std::mutex          m_Mtx;
+    std::vector<Uint32> m_FreeSlots;
+    Uint32              m_NextSlot = 0;
+};
+
+// Slots are returned to the registry when threads exit, so that the caches
+// (and the blocks they hold) are taken over by the threads started later.
+struct ThreadCacheSlot
+{
+    ThreadCacheSlot() :
+        Id{ThreadCacheSlotRegistry::Get().Acquire()}
+    {}
+
+    ~ThreadCacheSlot()
+    {
+        ThreadCacheSlotRegistry::Get().Release(Id);
+    }
+
+    const Uint32 Id;
+};
+
+} // namespace
+
+Uint32 FixedBlockMemoryAllocator::GetThreadCacheSlot()
+{
+    static thread_local ThreadCacheSlot Slot;
+    return Slot.Id;
+}
+
+void* FixedBlockMemoryAllocator::Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber)
+{
+    Size = AdjustBlockSize(Size);
+    VERIFY(m_BlockSize == Size, "Requested size (", Size, ") does not match the block size (", m_BlockSize, ")");
+
+    if (m_ThreadCaches != nullptr)
+    {
+        const auto Slot = GetThreadCacheSlot();
+        if (Slot < MaxThreadCaches)
         {
-            // In current implementation pages are never released!
-            // Note that if we delete a page, all indices past it will be invalid
+            // Cache slot is exclusively owned by this thread, so no synchronization is required
+            auto& Cache = m_ThreadCaches[Slot];
+            if (Cache.NumBlocks == 0)
+                RefillThreadCache(Cache);
 
-            //m_PagePool.erase(m_PagePool.begin() + PageId);
-            //m_AvailablePages.erase(PageId);
+            auto* Ptr   = Cache.pHead;
+            Cache.pHead = *reinterpret_cast<void**>(Ptr);
+            --Cache.NumBlocks;
+            FillWithDebugPattern(Ptr, MemoryPage::AllocatedBlockMemPattern, m_BlockSize);
+            return Ptr;
         }
     }
-    else
+
+    std::lock_guard<std::mutex> LockGuard(m_Mutex);
+    return AllocateFromPages();
+}
+
+void FixedBlockMemoryAllocator::Free(void* Ptr)
+{
+    if (m_ThreadCaches != nullptr)
     {
-        UNEXPECTED("Address not found in the allocations list - double freeing memory?");
+        const auto Slot = GetThreadCacheSlot();
+        if (Slot < MaxThreadCaches)
+        {
+            auto& Cache = m_ThreadCaches[Slot];
+            FillWithDebugPattern(Ptr, MemoryPage::DeallocatedBlockMemPattern, m_BlockSize);
+            *reinterpret_cast<void**>(Ptr) = Cache.pHead;
+            Cache.pHead                    = Ptr;
+            ++Cache.NumBlocks;
+            // Return half of the blocks to the pages when the cache grows too large
+            if (Cache.NumBlocks > m_ThreadCacheBatchSize * 2)
+                FlushThreadCache(Cache, m_ThreadCacheBatchSize);
+            return;
+        }
     }
+
+    std::lock_guard<std::mutex> LockGuard(m_Mutex);
+    FreeToPages(Ptr);
 }
 
 } // namespace Diligent
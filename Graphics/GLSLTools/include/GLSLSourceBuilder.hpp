@@ -34,15 +34,18 @@
 namespace Diligent
 {
 
+class HLSL2GLSLConversionCache;
+
 enum TargetGLSLCompiler
 {
     glslang,
     driver
 };
 
-String BuildGLSLSourceString(const ShaderCreateInfo& CreationAttribs,
-                             const DeviceCaps&       deviceCaps,
-                             TargetGLSLCompiler      TargetCompiler,
-                             const char*             ExtraDefinitions = nullptr);
+String BuildGLSLSourceString(const ShaderCreateInfo&   CreationAttribs,
+                             const DeviceCaps&         deviceCaps,
+                             TargetGLSLCompiler        TargetCompiler,
+                             const char*               ExtraDefinitions = nullptr,
+                             HLSL2GLSLConversionCache* pConversionCache = nullptr);
 
 } // namespace Diligent
\ No newline at end of file
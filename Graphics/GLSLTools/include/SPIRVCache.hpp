@@ -0,0 +1,119 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::SPIRVCache class
+
+#include <vector>
+#include <atomic>
+#include <utility>
+
+#include "BasicTypes.h"
+#include "Shader.h"
+#include "DataBlob.h"
+
+namespace Diligent
+{
+
+/// Persistent content-addressed cache of SPIR-V byte code.
+
+/// Every cache entry is stored in a separate file in the cache directory. The file name is derived
+/// from the hash of everything that affects compilation: shader source, macros, entry point, shader
+/// type and the cache format version. For HLSL shaders, the entry also records the names and content
+/// hashes of all included files, and the entry is only used if all includes are unchanged.
+/// A cache hit completely bypasses glslang and SPIR-V optimizer.
+///
+/// \remarks The cache is thread-safe.
+class SPIRVCache
+{
+public:
+    /// \param [in] CacheDirectory - Directory where SPIR-V files are stored. The directory
+    ///                              is created if it does not exist.
+    explicit SPIRVCache(const Char* CacheDirectory);
+
+    // clang-format off
+    SPIRVCache           (const SPIRVCache&) = delete;
+    SPIRVCache           (SPIRVCache&&)      = delete;
+    SPIRVCache& operator=(const SPIRVCache&) = delete;
+    SPIRVCache& operator=(SPIRVCache&&)      = delete;
+    // clang-format on
+
+    /// Looks up the cache and calls Diligent::HLSLtoSPIRV if the shader is not found.
+    std::vector<unsigned int> HLSLtoSPIRV(const ShaderCreateInfo& Attribs, IDataBlob** ppCompilerOutput);
+
+    /// Looks up the cache and calls Diligent::GLSLtoSPIRV if the shader is not found.
+    std::vector<unsigned int> GLSLtoSPIRV(SHADER_TYPE ShaderType, const char* ShaderSource, int SourceCodeLen, IDataBlob** ppCompilerOutput);
+
+    struct Statistics
+    {
+        /// Number of shaders loaded from the cache
+        Uint32 NumHits = 0;
+
+        /// Number of shaders that were not found in the cache and were compiled
+        Uint32 NumMisses = 0;
+
+        /// Number of cache entries that could not be written
+        Uint32 NumWriteFailures = 0;
+    };
+    Statistics GetStatistics() const;
+
+    const String& GetDirectory() const { return m_Directory; }
+
+    /// Cache format version. Must be incremented every time the compiler
+    /// settings, HLSL definitions or the file format change.
+    static constexpr Uint32 Version = 1;
+
+    /// Included file name and the hash of its content
+    using IncludeHash = std::pair<String, Uint64>;
+
+    /// Returns the path of the file that stores the entry with the given key.
+    String GetEntryPath(Uint64 Key) const;
+
+    /// Reads the entry from the disk. Returns false if the entry does not exist, is corrupted,
+    /// was created for a different input, or if any of the included files has changed.
+    bool ReadEntry(Uint64                           Key,
+                   Uint64                           VerificationHash,
+                   IShaderSourceInputStreamFactory* pIncludeFactory,
+                   std::vector<unsigned int>&       SPIRV) const;
+
+    /// Writes the entry to the disk. Other threads and processes never observe a partially written entry.
+    bool WriteEntry(Uint64                           Key,
+                    Uint64                           VerificationHash,
+                    const std::vector<IncludeHash>&  Includes,
+                    const std::vector<unsigned int>& SPIRV) const;
+
+private:
+    String m_Directory;
+
+    std::atomic<Uint32> m_NumHits{0};
+    std::atomic<Uint32> m_NumMisses{0};
+    std::atomic<Uint32> m_NumWriteFailures{0};
+};
+
+} // namespace Diligent
@@ -135,6 +135,12 @@ public:
         SepSmplrOrImgInd = SepImageInd;
     }
 
+    // Runtime arrays (e.g. Texture2D g_Textures[]) have zero array size
+    bool IsRuntimeArray() const
+    {
+        return ArraySize == 0;
+    }
+
     String GetPrintName(Uint32 ArrayInd) const
     {
         VERIFY_EXPR(ArrayInd < ArraySize);
@@ -37,10 +37,11 @@
 namespace Diligent
 {
 
-String BuildGLSLSourceString(const ShaderCreateInfo& CreationAttribs,
-                             const DeviceCaps&       deviceCaps,
-                             TargetGLSLCompiler      TargetCompiler,
-                             const char*             ExtraDefinitions)
+String BuildGLSLSourceString(const ShaderCreateInfo&   CreationAttribs,
+                             const DeviceCaps&         deviceCaps,
+                             TargetGLSLCompiler        TargetCompiler,
+                             const char*               ExtraDefinitions,
+                             HLSL2GLSLConversionCache* pConversionCache)
 {
     String GLSLSource;
 
@@ -321,6 +322,7 @@ String BuildGLSLSourceString(const ShaderCreateInfo& CreationAttribs,
         Attribs.IncludeDefinitions   = true;
         Attribs.InputFileName        = CreationAttribs.FilePath;
         Attribs.SamplerSuffix        = CreationAttribs.CombinedSamplerSuffix;
+        Attribs.pCache               = pConversionCache;
         // Separate shader objects extension also allows input/output layout qualifiers for
         // all shader stages.
         // https://www.khronos.org/registry/OpenGL/extensions/ARB/ARB_separate_shader_objects.txt
@@ -0,0 +1,421 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <cstring>
+#include <cstdio>
+#include <sstream>
+#include <thread>
+#include <chrono>
+
+#include "SPIRVCache.hpp"
+#include "SPIRVUtils.hpp"
+#include "DebugUtilities.hpp"
+#include "DataBlobImpl.hpp"
+#include "MemoryFileStream.hpp"
+#include "FileWrapper.hpp"
+#include "ObjectBase.hpp"
+#include "RefCntAutoPtr.hpp"
+#include "HashUtils.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+Uint64 ComputeContentHash(const void* pData, size_t Size)
+{
+    ContentHasher Hasher;
+    Hasher.Update(pData, Size);
+    return Hasher.GetKey();
+}
+
+// Shader source stream factory that forwards requests to another factory and
+// records the names and content hashes of all files it opens.
+class RecordingStreamFactory final : public ObjectBase<IShaderSourceInputStreamFactory>
+{
+public:
+    RecordingStreamFactory(IReferenceCounters* pRefCounters, IShaderSourceInputStreamFactory* pFactory) :
+        ObjectBase<IShaderSourceInputStreamFactory>{pRefCounters},
+        m_pFactory{pFactory}
+    {}
+
+    virtual void DILIGENT_CALL_TYPE CreateInputStream(const Char* Name, IFileStream** ppStream) override final
+    {
+        *ppStream = nullptr;
+
+        RefCntAutoPtr<IFileStream> pSourceStream;
+        m_pFactory->CreateInputStream(Name, &pSourceStream);
+        if (pSourceStream == nullptr)
+            return;
+
+        RefCntAutoPtr<IDataBlob> pFileData(MakeNewRCObj<DataBlobImpl>()(0));
+        pSourceStream->ReadBlob(pFileData);
+        m_Includes.emplace_back(Name, ComputeContentHash(pFileData->GetDataPtr(), pFileData->GetSize()));
+
+        RefCntAutoPtr<IFileStream> pMemStream(MakeNewRCObj<MemoryFileStream>()(pFileData));
+        *ppStream = pMemStream.Detach();
+    }
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_IShaderSourceInputStreamFactory, ObjectBase<IShaderSourceInputStreamFactory>);
+
+    const std::vector<std::pair<String, Uint64>>& GetIncludes() const { return m_Includes; }
+
+private:
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> m_pFactory;
+    std::vector<std::pair<String, Uint64>>         m_Includes;
+};
+
+struct SPIRVCacheEntryHeader
+{
+    static constexpr Uint32 ExpectedMagic = 0x56505344; // 'DSPV'
+
+    Uint32 Magic            = ExpectedMagic;
+    Uint32 Version          = SPIRVCache::Version;
+    Uint64 Key              = 0;
+    Uint64 VerificationHash = 0;
+    Uint64 SPIRVHash        = 0;
+    Uint32 NumIncludes      = 0;
+    Uint32 SPIRVSize        = 0; // Size of SPIR-V byte code, in words
+};
+
+// Every include record contains the name length and the content hash followed by the name
+constexpr size_t MinIncludeRecordSize = sizeof(Uint32) + sizeof(Uint64);
+
+// Returns the path of a temporary file that is unique among all threads
+// and processes that may be writing the same entry
+String GetTempEntryPath(const String& Path)
+{
+    static std::atomic<Uint32> TempFileCounter{0};
+
+    std::stringstream ss;
+    ss << Path << '.' << std::hash<std::thread::id>{}(std::this_thread::get_id())
+       << '.' << std::chrono::high_resolution_clock::now().time_since_epoch().count()
+       << '.' << TempFileCounter.fetch_add(1) << ".tmp";
+    return ss.str();
+}
+
+} // namespace
+
+SPIRVCache::SPIRVCache(const Char* CacheDirectory) :
+    m_Directory{CacheDirectory != nullptr ? CacheDirectory : ""}
+{
+    if (m_Directory.empty())
+        m_Directory = ".";
+
+    const auto SlashSym = FileSystem::GetSlashSymbol();
+    FileSystem::CorrectSlashes(m_Directory, SlashSym);
+    if (m_Directory.back() == SlashSym)
+        m_Directory.pop_back();
+
+    if (!FileSystem::PathExists(m_Directory.c_str()))
+    {
+        if (!FileSystem::CreateDirectory(m_Directory.c_str()))
+            LOG_WARNING_MESSAGE("Failed to create SPIR-V cache directory '", m_Directory, "'. New shaders will not be cached.");
+    }
+}
+
+String SPIRVCache::GetEntryPath(Uint64 Key) const
+{
+    char FileName[32];
+    snprintf(FileName, sizeof(FileName), "%016llx.spv", static_cast<unsigned long long>(Key));
+
+    String Path = m_Directory;
+    Path.push_back(FileSystem::GetSlashSymbol());
+    Path.append(FileName);
+    return Path;
+}
+
+bool SPIRVCache::ReadEntry(Uint64                           Key,
+                           Uint64                           VerificationHash,
+                           IShaderSourceInputStreamFactory* pIncludeFactory,
+                           std::vector<unsigned int>&       SPIRV) const
+{
+    const auto Path = GetEntryPath(Key);
+    if (!FileSystem::FileExists(Path.c_str()))
+        return false;
+
+    FileWrapper File{Path.c_str(), EFileAccessMode::Read};
+    if (!File)
+        return false;
+
+    const size_t FileSize = File->GetSize();
+    if (FileSize < sizeof(SPIRVCacheEntryHeader))
+        return false;
+
+    SPIRVCacheEntryHeader Header;
+    if (!File->Read(&Header, sizeof(Header)))
+        return false;
+
+    // clang-format off
+    if (Header.Magic            != SPIRVCacheEntryHeader::ExpectedMagic ||
+        Header.Version          != Version                              ||
+        Header.Key              != Key                                  ||
+        Header.VerificationHash != VerificationHash                     ||
+        Header.SPIRVSize        == 0)
+    {
+        return false;
+    }
+    // clang-format on
+
+    // Sizes stored in the file are validated against the file size before anything is allocated
+    auto       RemainingSize = FileSize - sizeof(Header);
+    const auto SPIRVDataSize = size_t{Header.SPIRVSize} * sizeof(SPIRV[0]);
+    if (SPIRVDataSize > RemainingSize || Header.NumIncludes > (RemainingSize - SPIRVDataSize) / MinIncludeRecordSize)
+    {
+        LOG_WARNING_MESSAGE("SPIR-V cache entry '", Path, "' is corrupted and will be overwritten.");
+        return false;
+    }
+    RemainingSize -= SPIRVDataSize;
+
+    // Make sure that none of the included files has changed
+    for (Uint32 i = 0; i < Header.NumIncludes; ++i)
+    {
+        Uint32 NameLen = 0;
+        if (!File->Read(&NameLen, sizeof(NameLen)))
+            return false;
+
+        if (RemainingSize < MinIncludeRecordSize || NameLen > RemainingSize - MinIncludeRecordSize)
+        {
+            LOG_WARNING_MESSAGE("SPIR-V cache entry '", Path, "' is corrupted and will be overwritten.");
+            return false;
+        }
+        RemainingSize -= MinIncludeRecordSize + NameLen;
+
+        String Name(NameLen, '\0');
+        Uint64 ContentHash = 0;
+        if (!File->Read(&Name[0], NameLen) || !File->Read(&ContentHash, sizeof(ContentHash)))
+            return false;
+
+        if (pIncludeFactory == nullptr)
+            return false;
+
+        RefCntAutoPtr<IFileStream> pIncludeStream;
+        pIncludeFactory->CreateInputStream(Name.c_str(), &pIncludeStream);
+        if (pIncludeStream == nullptr)
+            return false;
+
+        RefCntAutoPtr<IDataBlob> pIncludeData(MakeNewRCObj<DataBlobImpl>()(0));
+        pIncludeStream->ReadBlob(pIncludeData);
+        if (ComputeContentHash(pIncludeData->GetDataPtr(), pIncludeData->GetSize()) != ContentHash)
+            return false;
+    }
+
+    if (RemainingSize != 0)
+    {
+        LOG_WARNING_MESSAGE("SPIR-V cache entry '", Path, "' is corrupted and will be overwritten.");
+        return false;
+    }
+
+    SPIRV.resize(Header.SPIRVSize);
+    if (!File->Read(SPIRV.data(), SPIRV.size() * sizeof(SPIRV[0])))
+        return false;
+
+    // The entry may be corrupted if it was being written by another process
+    if (ComputeContentHash(SPIRV.data(), SPIRV.size() * sizeof(SPIRV[0])) != Header.SPIRVHash)
+    {
+        LOG_WARNING_MESSAGE("SPIR-V cache entry '", Path, "' is corrupted and will be overwritten.");
+        SPIRV.clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool SPIRVCache::WriteEntry(Uint64                           Key,
+                            Uint64                           VerificationHash,
+                            const std::vector<IncludeHash>&  Includes,
+                            const std::vector<unsigned int>& SPIRV) const
+{
+    const auto Path     = GetEntryPath(Key);
+    const auto TempPath = GetTempEntryPath(Path);
+
+    auto WriteData = [&](CFile* pFile) //
+    {
+        SPIRVCacheEntryHeader Header;
+        Header.Key              = Key;
+        Header.VerificationHash = VerificationHash;
+        Header.SPIRVHash        = ComputeContentHash(SPIRV.data(), SPIRV.size() * sizeof(SPIRV[0]));
+        Header.NumIncludes      = static_cast<Uint32>(Includes.size());
+        Header.SPIRVSize        = static_cast<Uint32>(SPIRV.size());
+        if (!pFile->Write(&Header, sizeof(Header)))
+            return false;
+
+        for (const auto& Include : Includes)
+        {
+            const auto NameLen = static_cast<Uint32>(Include.first.length());
+            // clang-format off
+            if (!pFile->Write(&NameLen,               sizeof(NameLen))             ||
+                !pFile->Write(Include.first.c_str(),  NameLen)                     ||
+                !pFile->Write(&Include.second,        sizeof(Include.second)))
+                return false;
+            // clang-format on
+        }
+
+        return pFile->Write(SPIRV.data(), SPIRV.size() * sizeof(SPIRV[0]));
+    };
+
+    {
+        FileWrapper File{TempPath.c_str(), EFileAccessMode::Overwrite};
+        if (!File)
+            return false;
+
+        if (!WriteData(File))
+        {
+            File.Close();
+            FileSystem::DeleteFile(TempPath.c_str());
+            return false;
+        }
+    }
+
+    // The entry is written to a temporary file and then renamed, so that other
+    // threads and processes never read a partially written entry
+    if (!FileSystem::RenameFile(TempPath.c_str(), Path.c_str()))
+    {
+        FileSystem::DeleteFile(TempPath.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+std::vector<unsigned int> SPIRVCache::HLSLtoSPIRV(const ShaderCreateInfo& Attribs, IDataBlob** ppCompilerOutput)
+{
+    RefCntAutoPtr<IDataBlob> pFileData;
+    String                   SourceFromFile;
+
+    const char* SourceCode    = Attribs.Source;
+    size_t      SourceCodeLen = 0;
+    if (SourceCode != nullptr)
+    {
+        SourceCodeLen = strlen(SourceCode);
+    }
+    else
+    {
+        RefCntAutoPtr<IFileStream> pSourceStream;
+        if (Attribs.pShaderSourceStreamFactory != nullptr)
+            Attribs.pShaderSourceStreamFactory->CreateInputStream(Attribs.FilePath, &pSourceStream);
+        if (pSourceStream == nullptr)
+        {
+            // Let the compiler report the error
+            return Diligent::HLSLtoSPIRV(Attribs, ppCompilerOutput);
+        }
+
+        pFileData = MakeNewRCObj<DataBlobImpl>()(0);
+        pSourceStream->ReadBlob(pFileData);
+        // Compiler expects null-terminated string
+        SourceFromFile.assign(reinterpret_cast<const char*>(pFileData->GetDataPtr()), pFileData->GetSize());
+        SourceCode    = SourceFromFile.c_str();
+        SourceCodeLen = SourceFromFile.length();
+    }
+
+    ContentHasher Hasher;
+    Hasher.Update(Uint32{Version});
+    Hasher.Update("HLSL");
+    Hasher.Update(static_cast<Uint32>(Attribs.Desc.ShaderType));
+    Hasher.Update(Attribs.EntryPoint);
+    if (Attribs.Macros != nullptr)
+    {
+        for (const auto* pMacro = Attribs.Macros; pMacro->Name != nullptr && pMacro->Definition != nullptr; ++pMacro)
+        {
+            Hasher.Update(pMacro->Name);
+            Hasher.Update(pMacro->Definition);
+        }
+    }
+    Hasher.Update(SourceCode, SourceCodeLen);
+
+    const auto Key              = Hasher.GetKey();
+    const auto VerificationHash = Hasher.GetVerificationHash();
+
+    std::vector<unsigned int> SPIRV;
+    if (ReadEntry(Key, VerificationHash, Attribs.pShaderSourceStreamFactory, SPIRV))
+    {
+        ++m_NumHits;
+        return SPIRV;
+    }
+    ++m_NumMisses;
+
+    ShaderCreateInfo CompileAttribs = Attribs;
+    CompileAttribs.Source           = SourceCode;
+
+    RefCntAutoPtr<RecordingStreamFactory> pRecordingFactory;
+    if (Attribs.pShaderSourceStreamFactory != nullptr)
+    {
+        pRecordingFactory                         = MakeNewRCObj<RecordingStreamFactory>()(Attribs.pShaderSourceStreamFactory);
+        CompileAttribs.pShaderSourceStreamFactory = pRecordingFactory;
+    }
+
+    SPIRV = Diligent::HLSLtoSPIRV(CompileAttribs, ppCompilerOutput);
+    if (!SPIRV.empty())
+    {
+        const std::vector<IncludeHash> NoIncludes;
+        if (!WriteEntry(Key, VerificationHash, pRecordingFactory ? pRecordingFactory->GetIncludes() : NoIncludes, SPIRV))
+            ++m_NumWriteFailures;
+    }
+
+    return SPIRV;
+}
+
+std::vector<unsigned int> SPIRVCache::GLSLtoSPIRV(SHADER_TYPE ShaderType, const char* ShaderSource, int SourceCodeLen, IDataBlob** ppCompilerOutput)
+{
+    ContentHasher Hasher;
+    Hasher.Update(Uint32{Version});
+    Hasher.Update("GLSL");
+    Hasher.Update(static_cast<Uint32>(ShaderType));
+    Hasher.Update(ShaderSource, static_cast<size_t>(SourceCodeLen));
+
+    const auto Key              = Hasher.GetKey();
+    const auto VerificationHash = Hasher.GetVerificationHash();
+
+    std::vector<unsigned int> SPIRV;
+    if (ReadEntry(Key, VerificationHash, nullptr, SPIRV))
+    {
+        ++m_NumHits;
+        return SPIRV;
+    }
+    ++m_NumMisses;
+
+    SPIRV = Diligent::GLSLtoSPIRV(ShaderType, ShaderSource, SourceCodeLen, ppCompilerOutput);
+    if (!SPIRV.empty())
+    {
+        if (!WriteEntry(Key, VerificationHash, {}, SPIRV))
+            ++m_NumWriteFailures;
+    }
+
+    return SPIRV;
+}
+
+SPIRVCache::Statistics SPIRVCache::GetStatistics() const
+{
+    Statistics Stats;
+    Stats.NumHits          = m_NumHits.load();
+    Stats.NumMisses        = m_NumMisses.load();
+    Stats.NumWriteFailures = m_NumWriteFailures.load();
+    return Stats;
+}
+
+} // namespace Diligent
@@ -0,0 +1,94 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <map>
+
+#include "../../../Primitives/interface/BasicTypes.h"
+#include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+namespace Diligent
+{
+// Index of memory pages sorted by the size of their largest free block. The index allows finding the
+// page with the smallest largest free block that may still accommodate an allocation in O(log n).
+// Preferring the tightest page leaves pages with large free blocks, and in particular empty pages,
+// untouched for as long as possible.
+//
+// The index does not own the pages. Every page keeps the handle of its own entry that must be
+// initialized with NullHandle() and is updated by Update() and Remove().
+template <typename PageType, typename SizeType = Uint64>
+class BestFitPageIndex
+{
+    using MapType = std::multimap<SizeType, PageType*>;
+
+public:
+    using Handle = typename MapType::iterator;
+
+    // Returns the handle of a page that is not in the index
+    Handle NullHandle()
+    {
+        return m_Pages.end();
+    }
+
+    // Inserts the page into the index or moves it to the position that corresponds to its new largest free block size
+    void Update(PageType& Page, SizeType MaxFreeBlockSize, Handle& PageHandle)
+    {
+        if (PageHandle != m_Pages.end())
+        {
+            VERIFY(PageHandle->second == &Page, "The handle does not reference this page");
+            if (PageHandle->first == MaxFreeBlockSize)
+                return;
+            m_Pages.erase(PageHandle);
+        }
+        PageHandle = m_Pages.emplace(MaxFreeBlockSize, &Page);
+    }
+
+    void Remove(Handle& PageHandle)
+    {
+        VERIFY(PageHandle != m_Pages.end(), "The page is not in the index");
+        m_Pages.erase(PageHandle);
+        PageHandle = m_Pages.end();
+    }
+
+    // Returns the page whose largest free block is the smallest one that is at least Size bytes large,
+    // or null if there is no such page
+    PageType* FindBestFit(SizeType Size) const
+    {
+        auto it = m_Pages.lower_bound(Size);
+        return it != m_Pages.end() ? it->second : nullptr;
+    }
+
+    size_t GetNumPages() const
+    {
+        return m_Pages.size();
+    }
+
+private:
+    MapType m_Pages;
+};
+} // namespace Diligent
@@ -33,11 +33,15 @@
 /// \file
 /// Implementation of Diligent::ResourceReleaseQueue class
 
+#include <new>
 #include <mutex>
-#include <deque>
+#include <atomic>
+#include <array>
+#include <thread>
+#include <functional>
+#include <type_traits>
 
 #include "../../../Primitives/interface/MemoryAllocator.h"
-#include "../../../Common/interface/STDAllocator.hpp"
 #include "../../../Platforms/interface/Atomics.hpp"
 #include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
 
@@ -63,6 +67,9 @@ public:
     //  |  AtomicLong          m_RefCounter                |         |______________________________________________|
     //  |__________________________________________________|
     //
+    // A resource with a single reference whose wrapper is small enough is kept in the inline
+    // storage of DynamicStaleResourceWrapper rather than on the heap. When the wrapper is embedded
+    // into a node of the release queue, the resource lives in the pooled node.
 
     template <typename ResourceType, typename = typename std::enable_if<std::is_object<ResourceType>::value>::type>
     static DynamicStaleResourceWrapper Create(ResourceType&& Resource, Atomics::Long NumReferences)
@@ -88,6 +95,11 @@ public:
                 delete this;
             }
 
+            virtual StaleResourceBase* MoveTo(void* pStorage) override final
+            {
+                return new (pStorage) SpecificStaleResource{std::move(m_SpecificResource)};
+            }
+
         private:
             ResourceType m_SpecificResource;
         };
@@ -116,26 +128,54 @@ public:
                 }
             }
 
+            virtual StaleResourceBase* MoveTo(void* pStorage) override final
+            {
+                UNEXPECTED("Shared stale resources are never stored inline");
+                return nullptr;
+            }
+
         private:
             ResourceType        m_SpecificResource;
             Atomics::AtomicLong m_RefCounter;
         };
 
-        return DynamicStaleResourceWrapper{
-            NumReferences == 1 ?
-                static_cast<StaleResourceBase*>(new SpecificStaleResource{std::move(Resource)}) :
-                static_cast<StaleResourceBase*>(new SpecificSharedStaleResource{std::move(Resource), NumReferences})};
+        static constexpr bool StoreInline =
+            sizeof(SpecificStaleResource) <= sizeof(InlineStorageType) &&
+            alignof(SpecificStaleResource) <= alignof(InlineStorageType) &&
+            std::is_nothrow_move_constructible<ResourceType>::value;
+
+        DynamicStaleResourceWrapper Wrapper;
+        if (NumReferences > 1)
+        {
+            Wrapper.m_pStaleResource = new SpecificSharedStaleResource{std::move(Resource), NumReferences};
+        }
+        else if (StoreInline)
+        {
+            Wrapper.m_pStaleResource = new (&Wrapper.m_InlineStorage) SpecificStaleResource{std::move(Resource)};
+            Wrapper.m_IsInline       = true;
+        }
+        else
+        {
+            Wrapper.m_pStaleResource = new SpecificStaleResource{std::move(Resource)};
+        }
+        return Wrapper;
     }
 
-    DynamicStaleResourceWrapper(DynamicStaleResourceWrapper&& rhs) noexcept :
-        m_pStaleResource(std::move(rhs.m_pStaleResource))
+    DynamicStaleResourceWrapper(DynamicStaleResourceWrapper&& rhs) noexcept
     {
-        rhs.m_pStaleResource = nullptr;
+        TakeResource(rhs);
     }
 
-    DynamicStaleResourceWrapper(const DynamicStaleResourceWrapper& rhs) noexcept :
-        m_pStaleResource{rhs.m_pStaleResource}
+    // A resource with a single reference is exclusively owned by its wrapper, so the only valid
+    // use of a copy of such wrapper is to pass it to a release queue and give up the ownership
+    // of the original one. Copying a wrapper that keeps the resource inline therefore transfers
+    // the resource, and the subsequent GiveUpOwnership() call on the original has no effect.
+    DynamicStaleResourceWrapper(const DynamicStaleResourceWrapper& rhs) noexcept
     {
+        if (rhs.m_IsInline)
+            TakeResource(const_cast<DynamicStaleResourceWrapper&>(rhs));
+        else
+            m_pStaleResource = rhs.m_pStaleResource;
     }
 
     // clang-format off
@@ -150,7 +190,12 @@ public:
 
     ~DynamicStaleResourceWrapper()
     {
-        if (m_pStaleResource != nullptr)
+        if (m_pStaleResource == nullptr)
+            return;
+
+        if (m_IsInline)
+            m_pStaleResource->~StaleResourceBase();
+        else
             m_pStaleResource->Release();
     }
 
@@ -160,13 +205,35 @@ private:
     public:
         virtual ~StaleResourceBase() = 0;
         virtual void Release()       = 0;
+
+        // Move-constructs the object in the given storage and returns the pointer to the new object
+        virtual StaleResourceBase* MoveTo(void* pStorage) = 0;
     };
 
-    DynamicStaleResourceWrapper(StaleResourceBase* pStaleResource) :
-        m_pStaleResource(pStaleResource)
-    {}
+    // Large enough for the vtable pointer and a typical resource, e.g. a Vulkan object wrapper
+    using InlineStorageType = std::aligned_storage<sizeof(void*) * 4, alignof(void*)>::type;
+
+    DynamicStaleResourceWrapper() noexcept {}
+
+    void TakeResource(DynamicStaleResourceWrapper& rhs) noexcept
+    {
+        if (rhs.m_IsInline)
+        {
+            m_pStaleResource = rhs.m_pStaleResource->MoveTo(&m_InlineStorage);
+            m_IsInline       = true;
+            rhs.m_pStaleResource->~StaleResourceBase();
+            rhs.m_IsInline = false;
+        }
+        else
+        {
+            m_pStaleResource = rhs.m_pStaleResource;
+        }
+        rhs.m_pStaleResource = nullptr;
+    }
 
-    StaleResourceBase* m_pStaleResource;
+    StaleResourceBase* m_pStaleResource = nullptr;
+    bool               m_IsInline       = false;
+    InlineStorageType  m_InlineStorage;
 };
 
 inline DynamicStaleResourceWrapper::StaleResourceBase::~StaleResourceBase()
@@ -216,22 +283,66 @@ private:
 ///   the command list
 /// * Resources are removed and actually destroyed from the queue when fence is signaled and the queue is Purged
 ///
+/// Resources may be released by any number of threads. Released resources are pushed into lock-free
+/// staging lists. DiscardStaleResources() and Purge() are serialized by a mutex, take the staging lists
+/// with a single atomic exchange and move or destroy whole ranges of resources by relinking the lists.
+///
+///    SafeReleaseResource()          DiscardResource()
+///            |                             |
+///            V                             V
+///    [Staged stale list]           [Staged discard list]      <- lock-free push
+///            |                             |
+///            | DiscardStaleResources()     | DiscardStaleResources(), Purge()
+///            V                             |
+///    [Stale list] ---------------> [Release list] --> Purge()  <- serialized by the queue mutex
+///
+/// Queue nodes are recycled through free lists that are split into several bins indexed
+/// by the releasing thread. Each bin is protected by its own mutex, but releasing threads never
+/// wait for it: if the bin is locked by another thread, a new node is allocated instead. Releasing
+/// threads thus never block on the queue's locks, though the allocator may use its own synchronization.
+///
 /// \tparam ResourceWrapperType -  Type of the resource wrapper used by the release queue.
 template <typename ResourceWrapperType>
 class ResourceReleaseQueue
 {
 public:
-    // clang-format off
     ResourceReleaseQueue(IMemoryAllocator& Allocator) :
-        m_ReleaseQueue  (STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for deque<ReleaseQueueElemType>")),
-        m_StaleResources(STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for deque<ReleaseQueueElemType>"))
+        m_Allocator{Allocator}
     {}
+
+    // clang-format off
+    ResourceReleaseQueue             (const ResourceReleaseQueue&) = delete;
+    ResourceReleaseQueue             (ResourceReleaseQueue&&)      = delete;
+    ResourceReleaseQueue& operator = (const ResourceReleaseQueue&) = delete;
+    ResourceReleaseQueue& operator = (ResourceReleaseQueue&&)      = delete;
     // clang-format on
 
     ~ResourceReleaseQueue()
     {
-        DEV_CHECK_ERR(m_StaleResources.empty(), "Not all stale objects were destroyed");
-        DEV_CHECK_ERR(m_ReleaseQueue.empty(), "Release queue is not empty");
+        DEV_CHECK_ERR(GetStaleResourceCount() == 0, "Not all stale objects were destroyed");
+        DEV_CHECK_ERR(GetPendingReleaseResourceCount() == 0, "Release queue is not empty");
+
+        // Destroy the remaining resources, if any
+        {
+            std::lock_guard<std::mutex> Lock{m_Mtx};
+            DrainStagedLists();
+            AppendList(m_ReleaseList, m_StaleList.pHead, m_StaleList.pTail);
+            m_StaleList = NodeList{};
+            DestroyNodes(m_ReleaseList.pHead);
+            m_ReleaseList = NodeList{};
+        }
+
+        for (auto& Bin : m_FreeNodeBins)
+        {
+            auto* pNode = Bin.pHead;
+            while (pNode != nullptr)
+            {
+                auto* pNext = pNode->pNext;
+                m_Allocator.Free(pNode);
+                pNode = pNext;
+            }
+            Bin.pHead = nullptr;
+        }
     }
 
     /// Creates a resource wrapper for the specific resource type
@@ -257,8 +368,10 @@ public:
     /// \param [in] NextCommandListNumber - Number of the command list that will be submitted to the queue next
     void SafeReleaseResource(ResourceWrapperType&& Wrapper, Uint64 NextCommandListNumber)
     {
-        std::lock_guard<std::mutex> LockGuard(m_StaleObjectsMutex);
-        m_StaleResources.emplace_back(NextCommandListNumber, std::move(Wrapper));
+        // Count the resource before it becomes visible to DiscardStaleResources() and Purge(),
+        // so that the counter never goes below the number of resources in the queue
+        m_NumStaleResources.fetch_add(1, std::memory_order_relaxed);
+        PushNode(m_StagedStale, CreateNode(NextCommandListNumber, std::move(Wrapper)));
     }
 
     /// Moves a copy of the resource wrapper to the stale resources queue
@@ -266,8 +379,10 @@ public:
     /// \param [in] NextCommandListNumber - Number of the command list that will be submitted to the queue next
     void SafeReleaseResource(const ResourceWrapperType& Wrapper, Uint64 NextCommandListNumber)
     {
-        std::lock_guard<std::mutex> LockGuard(m_StaleObjectsMutex);
-        m_StaleResources.emplace_back(NextCommandListNumber, Wrapper);
+        // Count the resource before it becomes visible to DiscardStaleResources() and Purge(),
+        // so that the counter never goes below the number of resources in the queue
+        m_NumStaleResources.fetch_add(1, std::memory_order_relaxed);
+        PushNode(m_StagedStale, CreateNode(NextCommandListNumber, Wrapper));
     }
 
     /// Adds a resource directly to the release queue
@@ -284,8 +399,10 @@ public:
     /// \param [in] FenceValue  - Fence value indicating when the resource was used last time.
     void DiscardResource(ResourceWrapperType&& Wrapper, Uint64 FenceValue)
     {
-        std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
-        m_ReleaseQueue.emplace_back(FenceValue, std::move(Wrapper));
+        // Count the resource before it becomes visible to DiscardStaleResources() and Purge(),
+        // so that the counter never goes below the number of resources in the queue
+        m_NumPendingResources.fetch_add(1, std::memory_order_relaxed);
+        PushNode(m_StagedDiscarded, CreateNode(FenceValue, std::move(Wrapper)));
     }
 
     /// Adds a copy of the resource wrapper directly to the release queue
@@ -293,8 +410,10 @@ public:
     /// \param [in] FenceValue  - Fence value indicating when the resource was used last time.
     void DiscardResource(const ResourceWrapperType& Wrapper, Uint64 FenceValue)
     {
-        std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
-        m_ReleaseQueue.emplace_back(FenceValue, Wrapper);
+        // Count the resource before it becomes visible to DiscardStaleResources() and Purge(),
+        // so that the counter never goes below the number of resources in the queue
+        m_NumPendingResources.fetch_add(1, std::memory_order_relaxed);
+        PushNode(m_StagedDiscarded, CreateNode(FenceValue, Wrapper));
     }
 
     /// Adds multiple resources directly to the release queue
@@ -303,11 +422,10 @@ public:
     template <typename ResourceType, typename IteratorType>
     void DiscardResources(Uint64 FenceValue, IteratorType Iterator)
     {
-        std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
-        ResourceType                Resource;
+        ResourceType Resource;
         while (Iterator(Resource))
         {
-            m_ReleaseQueue.emplace_back(FenceValue, CreateWrapper(std::move(Resource), 1));
+            DiscardResource(CreateWrapper(std::move(Resource), 1), FenceValue);
         }
     }
 
@@ -320,21 +438,33 @@ public:
     ///                                      is greater or equal to the fence value associated with the resource
     void DiscardStaleResources(Uint64 SubmittedCmdBuffNumber, Uint64 FenceValue)
     {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        DrainStagedLists();
+
         // Only discard these stale objects that were released before CmdBuffNumber
         // was executed
-        std::lock_guard<std::mutex> StaleObjectsLock(m_StaleObjectsMutex);
-        std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
-        while (!m_StaleResources.empty())
+        Node*  pLastDiscarded = nullptr;
+        size_t NumDiscarded   = 0;
+        for (auto* pNode = m_StaleList.pHead; pNode != nullptr && pNode->Value <= SubmittedCmdBuffNumber; pNode = pNode->pNext)
         {
-            auto& FirstStaleObj = m_StaleResources.front();
-            if (FirstStaleObj.first <= SubmittedCmdBuffNumber)
-            {
-                m_ReleaseQueue.emplace_back(FenceValue, std::move(FirstStaleObj.second));
-                m_StaleResources.pop_front();
-            }
-            else
-                break;
+            pNode->Value   = FenceValue;
+            pLastDiscarded = pNode;
+            ++NumDiscarded;
         }
+        if (pLastDiscarded == nullptr)
+            return;
+
+        // Move the whole range to the release list
+        auto* pFirstDiscarded = m_StaleList.pHead;
+        m_StaleList.pHead     = pLastDiscarded->pNext;
+        if (m_StaleList.pHead == nullptr)
+            m_StaleList.pTail = nullptr;
+        pLastDiscarded->pNext = nullptr;
+        AppendList(m_ReleaseList, pFirstDiscarded, pLastDiscarded);
+
+        m_NumStaleResources.fetch_sub(NumDiscarded, std::memory_order_relaxed);
+        m_NumPendingResources.fetch_add(NumDiscarded, std::memory_order_relaxed);
     }
 
 
@@ -343,39 +473,201 @@ public:
     /// \param [in] CompletedFenceValue  -  Value of the fence that has been completed by the GPU
     void Purge(Uint64 CompletedFenceValue)
     {
-        std::lock_guard<std::mutex> LockGuard(m_ReleaseQueueMutex);
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        DrainStagedLists();
 
         // Release all objects whose associated fence value is at most CompletedFenceValue
         // See http://diligentgraphics.com/diligent-engine/architecture/d3d12/managing-resource-lifetimes/
-        while (!m_ReleaseQueue.empty())
-        {
-            auto& FirstObj = m_ReleaseQueue.front();
-            if (FirstObj.first <= CompletedFenceValue)
-                m_ReleaseQueue.pop_front();
-            else
-                break;
-        }
+        Node* pLastReleased = nullptr;
+        for (auto* pNode = m_ReleaseList.pHead; pNode != nullptr && pNode->Value <= CompletedFenceValue; pNode = pNode->pNext)
+            pLastReleased = pNode;
+        if (pLastReleased == nullptr)
+            return;
+
+        auto* pFirstReleased = m_ReleaseList.pHead;
+        m_ReleaseList.pHead  = pLastReleased->pNext;
+        if (m_ReleaseList.pHead == nullptr)
+            m_ReleaseList.pTail = nullptr;
+        pLastReleased->pNext = nullptr;
+
+        // Resources are destroyed in the order they were released
+        auto NumReleased = DestroyNodes(pFirstReleased);
+        m_NumPendingResources.fetch_sub(NumReleased, std::memory_order_relaxed);
     }
 
     /// Returns the number of stale resources
     size_t GetStaleResourceCount() const
     {
-        return m_StaleResources.size();
+        return m_NumStaleResources.load(std::memory_order_relaxed);
     }
 
     /// Returns the number of resources pending release
     size_t GetPendingReleaseResourceCount() const
     {
-        return m_ReleaseQueue.size();
+        return m_NumPendingResources.load(std::memory_order_relaxed);
     }
 
 private:
-    std::mutex m_ReleaseQueueMutex;
-    using ReleaseQueueElemType = std::pair<Uint64, ResourceWrapperType>;
-    std::deque<ReleaseQueueElemType, STDAllocatorRawMem<ReleaseQueueElemType>> m_ReleaseQueue;
+    struct Node
+    {
+        Node*  pNext = nullptr;
+        Uint64 Value = 0; // Command list number for stale resources, fence value for resources in the release list
+        Uint32 Bin   = 0; // Free list bin the node is returned to
+
+        typename std::aligned_storage<sizeof(ResourceWrapperType), alignof(ResourceWrapperType)>::type WrapperStorage;
+
+        ResourceWrapperType& GetWrapper()
+        {
+            return reinterpret_cast<ResourceWrapperType&>(WrapperStorage);
+        }
+    };
+
+    struct NodeList
+    {
+        Node* pHead = nullptr;
+        Node* pTail = nullptr;
+    };
+
+    struct FreeNodeBin
+    {
+        std::mutex Mtx;
+        Node*      pHead = nullptr;
+    };
+
+    static constexpr Uint32 NumFreeNodeBins = 8;
+
+    static Uint32 GetThreadFreeNodeBin()
+    {
+        return static_cast<Uint32>(std::hash<std::thread::id>{}(std::this_thread::get_id()) % NumFreeNodeBins);
+    }
+
+    template <typename WrapperArgType>
+    Node* CreateNode(Uint64 Value, WrapperArgType&& Wrapper)
+    {
+        const auto BinIdx = GetThreadFreeNodeBin();
+
+        Node* pNode = nullptr;
+        {
+            auto& Bin = m_FreeNodeBins[BinIdx];
+
+            // Do not wait for the bin if it is locked by another thread
+            std::unique_lock<std::mutex> Lock{Bin.Mtx, std::try_to_lock};
+            if (Lock.owns_lock() && Bin.pHead != nullptr)
+            {
+                pNode     = Bin.pHead;
+                Bin.pHead = pNode->pNext;
+            }
+        }
+        if (pNode == nullptr)
+        {
+            void* pRawMem = m_Allocator.Allocate(sizeof(Node), "Resource release queue node", __FILE__, __LINE__);
+            pNode         = new (pRawMem) Node;
+        }
+
+        pNode->pNext = nullptr;
+        pNode->Value = Value;
+        pNode->Bin   = BinIdx;
+        new (&pNode->WrapperStorage) ResourceWrapperType{std::forward<WrapperArgType>(Wrapper)};
+        return pNode;
+    }
+
+    static void PushNode(std::atomic<Node*>& Stack, Node* pNode)
+    {
+        pNode->pNext = Stack.load(std::memory_order_relaxed);
+        while (!Stack.compare_exchange_weak(pNode->pNext, pNode, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    // Takes all nodes from the lock-free stack and returns them in the order they were pushed
+    static NodeList TakeStagedNodes(std::atomic<Node*>& Stack)
+    {
+        NodeList List;
+
+        auto* pNode = Stack.exchange(nullptr, std::memory_order_acquire);
+        List.pTail  = pNode;
+        while (pNode != nullptr)
+        {
+            auto* pNext  = pNode->pNext;
+            pNode->pNext = List.pHead;
+            List.pHead   = pNode;
+            pNode        = pNext;
+        }
+        return List;
+    }
+
+    static void AppendList(NodeList& List, Node* pHead, Node* pTail)
+    {
+        if (pHead == nullptr)
+            return;
+
+        if (List.pTail != nullptr)
+            List.pTail->pNext = pHead;
+        else
+            List.pHead = pHead;
+        List.pTail = pTail;
+    }
+
+    // Must be called while m_Mtx is locked
+    void DrainStagedLists()
+    {
+        auto Stale = TakeStagedNodes(m_StagedStale);
+        AppendList(m_StaleList, Stale.pHead, Stale.pTail);
+
+        auto Discarded = TakeStagedNodes(m_StagedDiscarded);
+        AppendList(m_ReleaseList, Discarded.pHead, Discarded.pTail);
+    }
+
+    // Destroys the wrappers and returns the nodes to the free lists
+    size_t DestroyNodes(Node* pHead)
+    {
+        std::array<NodeList, NumFreeNodeBins> FreedNodes;
+
+        size_t NumNodes = 0;
+        for (auto* pNode = pHead; pNode != nullptr;)
+        {
+            auto* pNext = pNode->pNext;
+            pNode->GetWrapper().~ResourceWrapperType();
+
+            pNode->pNext = nullptr;
+            AppendList(FreedNodes[pNode->Bin], pNode, pNode);
+            ++NumNodes;
+
+            pNode = pNext;
+        }
+
+        for (Uint32 BinIdx = 0; BinIdx < NumFreeNodeBins; ++BinIdx)
+        {
+            const auto& Freed = FreedNodes[BinIdx];
+            if (Freed.pHead == nullptr)
+                continue;
+
+            auto& Bin = m_FreeNodeBins[BinIdx];
+
+            std::lock_guard<std::mutex> Lock{Bin.Mtx};
+            Freed.pTail->pNext = Bin.pHead;
+            Bin.pHead          = Freed.pHead;
+        }
+
+        return NumNodes;
+    }
+
+    IMemoryAllocator& m_Allocator;
+
+    // Lock-free lists of nodes pushed by SafeReleaseResource() and DiscardResource()
+    std::atomic<Node*> m_StagedStale{nullptr};
+    std::atomic<Node*> m_StagedDiscarded{nullptr};
+
+    // Protects the lists below and serializes DiscardStaleResources() and Purge()
+    std::mutex m_Mtx;
+    NodeList   m_StaleList;
+    NodeList   m_ReleaseList;
+
+    std::array<FreeNodeBin, NumFreeNodeBins> m_FreeNodeBins;
 
-    std::mutex                                                                 m_StaleObjectsMutex;
-    std::deque<ReleaseQueueElemType, STDAllocatorRawMem<ReleaseQueueElemType>> m_StaleResources;
+    std::atomic<size_t> m_NumStaleResources{0};
+    std::atomic<size_t> m_NumPendingResources{0};
 };
 
 } // namespace Diligent
@@ -0,0 +1,686 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+// Two-level segregated fit (TLSF) free block manager. A suitable free block is normally found with a few bit scans
+// and adjacent free blocks are merged through hash table lookups, so allocation and deallocation usually take
+// constant time. This is not a hard bound: when the manager is nearly full, Allocate() may scan some free lists
+// linearly (see FindSuitableBlock()), and hash table lookups are only constant on average.
+// See M. Masmano, I. Ripoll, A. Crespo, J. Real, "TLSF: a New Dynamic Memory Allocator for Real-Time Systems".
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "../../../Primitives/interface/MemoryAllocator.h"
+#include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "../../../Platforms/interface/PlatformMisc.hpp"
+#include "../../../Common/interface/Align.hpp"
+#include "../../../Common/interface/STDAllocator.hpp"
+#include "VariableSizeAllocationsManager.hpp"
+
+namespace Diligent
+{
+// The class is a drop-in replacement for VariableSizeAllocationsManager that has the same interface
+// and uses the same Allocation struct. Like VariableSizeAllocationsManager, it only keeps track of free
+// blocks and does not record allocation sizes.
+//
+// Free blocks are kept in segregated lists. The first-level index (FL) selects the power-of-two size range,
+// the second-level index (SL) subdivides every range into SLIndexCount linear classes. Two bitmaps
+// indicate which lists are not empty, so that a suitable list is found with two bit scans:
+//
+//      FL bitmap:    0 0 1 0 1 1 0 ...
+//                        |   |
+//      SL bitmaps:       |   '--> 0 1 0 0 ... 1
+//                        '------> 1 0 0 1 ... 0
+//                                 |     |
+//                                 |     '--> [Block] <-> [Block]
+//                                 '--------> [Block]
+//
+// To find adjacent free blocks when an allocation is released, free blocks are indexed by their start and end
+// offsets in two open-addressing hash tables. Block descriptors are kept in a vector and recycled, so
+// no memory is allocated by Allocate() or Free() once the internal arrays have grown to their working size.
+class TLSFAllocationsManager
+{
+public:
+    using OffsetType = VariableSizeAllocationsManager::OffsetType;
+    using Allocation = VariableSizeAllocationsManager::Allocation;
+
+    // Every first-level size range is split into 2^SLIndexLog2 classes
+    static constexpr Uint32     SLIndexLog2    = 4;
+    static constexpr Uint32     SLIndexCount   = 1u << SLIndexLog2;
+    static constexpr OffsetType SmallBlockSize = OffsetType{1} << SLIndexLog2;
+    // Sizes below SmallBlockSize are all mapped to the first-level index 0
+    static constexpr Uint32 FLIndexCount = sizeof(OffsetType) * 8 - SLIndexLog2 + 1;
+
+private:
+    static constexpr Uint32 InvalidIndex = ~Uint32{0};
+
+    struct FreeBlockInfo
+    {
+        OffsetType Offset   = 0;
+        OffsetType Size     = 0;
+        Uint32     PrevFree = InvalidIndex;
+        Uint32     NextFree = InvalidIndex;
+    };
+
+    // Open-addressing hash table that maps block offsets to block indices
+    class OffsetHashMap
+    {
+    public:
+        explicit OffsetHashMap(IMemoryAllocator& Allocator) :
+            m_Slots(STD_ALLOCATOR_RAW_MEM(Slot, Allocator, "Allocator for vector<Slot>"))
+        {
+            Rehash(4);
+        }
+
+        // clang-format off
+        OffsetHashMap           (OffsetHashMap&&)      = default;
+        OffsetHashMap& operator=(OffsetHashMap&&)      = default;
+        OffsetHashMap           (const OffsetHashMap&) = delete;
+        OffsetHashMap& operator=(const OffsetHashMap&) = delete;
+        // clang-format on
+
+        void Insert(OffsetType Key, Uint32 Index)
+        {
+            VERIFY_EXPR(Index != InvalidIndex);
+            if ((m_Count + 1) * 2 > m_Slots.size())
+                Rehash(m_Log2Capacity + 1);
+
+            auto Pos = FindSlot(Key);
+            VERIFY(m_Slots[Pos].Index == InvalidIndex, "Key ", Key, " is already in the table");
+            m_Slots[Pos] = Slot{Key, Index};
+            ++m_Count;
+        }
+
+        Uint32 Find(OffsetType Key) const
+        {
+            return m_Slots[FindSlot(Key)].Index;
+        }
+
+        void Erase(OffsetType Key)
+        {
+            const size_t Mask = m_Slots.size() - 1;
+
+            auto Hole = FindSlot(Key);
+            VERIFY(m_Slots[Hole].Index != InvalidIndex, "Key ", Key, " is not found in the table");
+
+            // Backward-shift deletion keeps probe sequences intact without tombstones
+            for (auto Pos = (Hole + 1) & Mask; m_Slots[Pos].Index != InvalidIndex; Pos = (Pos + 1) & Mask)
+            {
+                const auto Home = GetHomeSlot(m_Slots[Pos].Key);
+                // Move the entry to the hole if its home slot is not in the cyclic range (Hole, Pos]
+                const bool CanMove = (Hole <= Pos) ?
+                    (Home <= Hole || Home > Pos) :
+                    (Home <= Hole && Home > Pos);
+                if (CanMove)
+                {
+                    m_Slots[Hole] = m_Slots[Pos];
+                    Hole          = Pos;
+                }
+            }
+            m_Slots[Hole] = Slot{};
+            --m_Count;
+        }
+
+        size_t GetCount() const { return m_Count; }
+
+    private:
+        struct Slot
+        {
+            // clang-format off
+            Slot() {}
+            Slot(OffsetType _Key, Uint32 _Index) :
+                Key  {_Key  },
+                Index{_Index}
+            {}
+            // clang-format on
+
+            OffsetType Key   = 0;
+            Uint32     Index = InvalidIndex;
+        };
+
+        size_t GetHomeSlot(OffsetType Key) const
+        {
+            // Fibonacci hashing
+            return static_cast<size_t>((Uint64{Key} * Uint64{0x9E3779B97F4A7C15}) >> (64 - m_Log2Capacity));
+        }
+
+        size_t FindSlot(OffsetType Key) const
+        {
+            const size_t Mask = m_Slots.size() - 1;
+            auto         Pos  = GetHomeSlot(Key);
+            while (m_Slots[Pos].Index != InvalidIndex && m_Slots[Pos].Key != Key)
+                Pos = (Pos + 1) & Mask;
+            return Pos;
+        }
+
+        void Rehash(Uint32 Log2Capacity)
+        {
+            std::vector<Slot, STDAllocatorRawMem<Slot>> OldSlots(m_Slots.get_allocator());
+            OldSlots.swap(m_Slots);
+            m_Slots.resize(size_t{1} << Log2Capacity);
+            m_Log2Capacity = Log2Capacity;
+            for (const auto& OldSlot : OldSlots)
+            {
+                if (OldSlot.Index != InvalidIndex)
+                    m_Slots[FindSlot(OldSlot.Key)] = OldSlot;
+            }
+        }
+
+        std::vector<Slot, STDAllocatorRawMem<Slot>> m_Slots;
+
+        size_t m_Count        = 0;
+        Uint32 m_Log2Capacity = 0;
+    };
+
+public:
+    TLSFAllocationsManager(OffsetType MaxSize, IMemoryAllocator& Allocator) :
+        // clang-format off
+        m_Blocks       (STD_ALLOCATOR_RAW_MEM(FreeBlockInfo, Allocator, "Allocator for vector<FreeBlockInfo>")),
+        m_BlocksByStart{Allocator},
+        m_BlocksByEnd  {Allocator},
+        m_MaxSize      {MaxSize  },
+        m_FreeSize     {MaxSize  }
+    // clang-format on
+    {
+        VERIFY_EXPR(MaxSize > 0);
+        for (auto& FreeLists : m_FreeLists)
+            FreeLists.fill(Uint32{InvalidIndex});
+
+        // Insert single maximum-size block
+        InsertFreeBlock(CreateBlock(), 0, m_MaxSize);
+
+#ifdef DILIGENT_DEBUG
+        DbgVerifyBlocks();
+#endif
+    }
+
+    ~TLSFAllocationsManager()
+    {
+#ifdef DILIGENT_DEBUG
+        if (m_MaxSize != 0)
+        {
+            VERIFY(m_NumFreeBlocks == 1, "Single free block is expected");
+            VERIFY(m_BlocksByStart.Find(0) != InvalidIndex, "Head chunk offset is expected to be 0");
+            VERIFY(m_FreeSize == m_MaxSize, "Not all allocations have been released");
+        }
+#endif
+    }
+
+    // clang-format off
+    TLSFAllocationsManager(TLSFAllocationsManager&& rhs) noexcept :
+        m_Blocks                 {std::move(rhs.m_Blocks)       },
+        m_BlocksByStart          {std::move(rhs.m_BlocksByStart)},
+        m_BlocksByEnd            {std::move(rhs.m_BlocksByEnd)  },
+        m_FreeLists              {rhs.m_FreeLists               },
+        m_SLBitmaps              {rhs.m_SLBitmaps               },
+        m_FLBitmap               {rhs.m_FLBitmap                },
+        m_FirstUnusedBlock       {rhs.m_FirstUnusedBlock        },
+        m_NumFreeBlocks          {rhs.m_NumFreeBlocks           },
+        m_MaxSize                {rhs.m_MaxSize                 },
+        m_FreeSize               {rhs.m_FreeSize                },
+        m_MaxFreeBlockSize       {rhs.m_MaxFreeBlockSize        },
+        m_IsMaxFreeBlockSizeValid{rhs.m_IsMaxFreeBlockSizeValid }
+    {
+        // clang-format on
+        rhs.ResetMovedFrom();
+    }
+
+    TLSFAllocationsManager& operator=(TLSFAllocationsManager&& rhs) noexcept
+    {
+        if (this == &rhs)
+            return *this;
+
+        m_Blocks                  = std::move(rhs.m_Blocks);
+        m_BlocksByStart           = std::move(rhs.m_BlocksByStart);
+        m_BlocksByEnd             = std::move(rhs.m_BlocksByEnd);
+        m_FreeLists               = rhs.m_FreeLists;
+        m_SLBitmaps               = rhs.m_SLBitmaps;
+        m_FLBitmap                = rhs.m_FLBitmap;
+        m_FirstUnusedBlock        = rhs.m_FirstUnusedBlock;
+        m_NumFreeBlocks           = rhs.m_NumFreeBlocks;
+        m_MaxSize                 = rhs.m_MaxSize;
+        m_FreeSize                = rhs.m_FreeSize;
+        m_MaxFreeBlockSize        = rhs.m_MaxFreeBlockSize;
+        m_IsMaxFreeBlockSizeValid = rhs.m_IsMaxFreeBlockSizeValid;
+
+        rhs.ResetMovedFrom();
+        return *this;
+    }
+
+    // clang-format off
+    TLSFAllocationsManager             (const TLSFAllocationsManager&) = delete;
+    TLSFAllocationsManager& operator = (const TLSFAllocationsManager&) = delete;
+    // clang-format on
+
+    // Offset returned by Allocate() may not be aligned, but the size of the allocation
+    // is sufficient to properly align it
+    Allocation Allocate(OffsetType Size, OffsetType Alignment)
+    {
+        VERIFY_EXPR(Size > 0);
+        VERIFY(IsPowerOfTwo(Alignment), "Alignment (", Alignment, ") must be power of 2");
+        Size = Align(Size, Alignment);
+        if (m_FreeSize < Size)
+            return Allocation::InvalidAllocation();
+
+        const auto BlockIdx = FindSuitableBlock(Size, Alignment);
+        if (BlockIdx == InvalidIndex)
+            return Allocation::InvalidAllocation();
+
+        //     Block.Offset
+        //        |                                  |
+        //        |<-----------Block.Size----------->|
+        //        |<---AdjustedSize--->|<--NewSize-->|
+        //        |                    |
+        //      Offset             NewOffset
+        //
+        const auto Offset       = m_Blocks[BlockIdx].Offset;
+        const auto BlockSize    = m_Blocks[BlockIdx].Size;
+        const auto AdjustedSize = Size + (Align(Offset, Alignment) - Offset);
+        VERIFY_EXPR(AdjustedSize <= BlockSize);
+        const auto NewSize = BlockSize - AdjustedSize;
+
+        RemoveFreeBlock(BlockIdx);
+        if (NewSize > 0)
+            InsertFreeBlock(BlockIdx, Offset + AdjustedSize, NewSize);
+        else
+            RecycleBlock(BlockIdx);
+
+        m_FreeSize -= AdjustedSize;
+
+#ifdef DILIGENT_DEBUG
+        DbgVerifyBlocks();
+#endif
+        return Allocation{Offset, AdjustedSize};
+    }
+
+    void Free(Allocation&& allocation)
+    {
+        Free(allocation.UnalignedOffset, allocation.Size);
+        allocation = Allocation{};
+    }
+
+    void Free(OffsetType Offset, OffsetType Size)
+    {
+        VERIFY_EXPR(Size > 0 && Offset + Size <= m_MaxSize);
+        VERIFY(m_BlocksByStart.Find(Offset) == InvalidIndex, "Block at offset ", Offset, " is already free");
+
+        auto NewOffset = Offset;
+        auto NewSize   = Size;
+        auto BlockIdx  = InvalidIndex;
+
+        //   PrevBlock.Offset           Offset            NextBlock.Offset
+        //     |                          |                    |
+        //     |<-----PrevBlock.Size----->|<------Size-------->|<-----NextBlock.Size----->|
+        //
+        const auto PrevBlockIdx = m_BlocksByEnd.Find(Offset);
+        if (PrevBlockIdx != InvalidIndex)
+        {
+            NewOffset = m_Blocks[PrevBlockIdx].Offset;
+            NewSize += m_Blocks[PrevBlockIdx].Size;
+            RemoveFreeBlock(PrevBlockIdx);
+            BlockIdx = PrevBlockIdx;
+        }
+
+        const auto NextBlockIdx = m_BlocksByStart.Find(Offset + Size);
+        if (NextBlockIdx != InvalidIndex)
+        {
+            NewSize += m_Blocks[NextBlockIdx].Size;
+            RemoveFreeBlock(NextBlockIdx);
+            if (BlockIdx == InvalidIndex)
+                BlockIdx = NextBlockIdx;
+            else
+                RecycleBlock(NextBlockIdx);
+        }
+
+        if (BlockIdx == InvalidIndex)
+            BlockIdx = CreateBlock();
+        InsertFreeBlock(BlockIdx, NewOffset, NewSize);
+
+        m_FreeSize += Size;
+
+#ifdef DILIGENT_DEBUG
+        DbgVerifyBlocks();
+#endif
+    }
+
+    // clang-format off
+    bool IsFull() const{ return m_FreeSize==0; };
+    bool IsEmpty()const{ return m_FreeSize==m_MaxSize; };
+    OffsetType GetMaxSize() const{return m_MaxSize;}
+    OffsetType GetFreeSize()const{return m_FreeSize;}
+    OffsetType GetUsedSize()const{return m_MaxSize - m_FreeSize;}
+    // clang-format on
+
+    size_t GetNumFreeBlocks() const
+    {
+        return m_NumFreeBlocks;
+    }
+
+    // Returns the size of the largest free block. The size is tracked as blocks are inserted and
+    // only needs to be recomputed after the largest block has been removed and no block at least
+    // as large has been inserted since.
+    OffsetType GetMaxFreeBlockSize() const
+    {
+        if (!m_IsMaxFreeBlockSizeValid)
+        {
+            m_MaxFreeBlockSize        = ComputeMaxFreeBlockSize();
+            m_IsMaxFreeBlockSizeValid = true;
+        }
+        return m_MaxFreeBlockSize;
+    }
+
+    // Maps the block size to the free list that contains blocks of this size
+    static void MapSize(OffsetType Size, Uint32& FL, Uint32& SL)
+    {
+        if (Size < SmallBlockSize)
+        {
+            FL = 0;
+            SL = static_cast<Uint32>(Size);
+        }
+        else
+        {
+            const auto MSB = PlatformMisc::GetMSB(Uint64{Size});
+            FL             = MSB - SLIndexLog2 + 1;
+            SL             = static_cast<Uint32>(Size >> (MSB - SLIndexLog2)) - SLIndexCount;
+        }
+        VERIFY_EXPR(FL < FLIndexCount && SL < SLIndexCount);
+    }
+
+private:
+    // Leaves the object that has been moved from in the empty state that the destructor does not verify
+    void ResetMovedFrom()
+    {
+        m_SLBitmaps.fill(0);
+        m_FLBitmap                = 0;
+        m_FirstUnusedBlock        = InvalidIndex;
+        m_NumFreeBlocks           = 0;
+        m_MaxSize                 = 0;
+        m_FreeSize                = 0;
+        m_MaxFreeBlockSize        = 0;
+        m_IsMaxFreeBlockSizeValid = true;
+    }
+
+    // Scans the highest non-empty list
+    OffsetType ComputeMaxFreeBlockSize() const
+    {
+        if (m_FLBitmap == 0)
+            return 0;
+
+        const auto FL = PlatformMisc::GetMSB(m_FLBitmap);
+        const auto SL = PlatformMisc::GetMSB(m_SLBitmaps[FL]);
+
+        OffsetType MaxSize = 0;
+        for (auto BlockIdx = m_FreeLists[FL][SL]; BlockIdx != InvalidIndex; BlockIdx = m_Blocks[BlockIdx].NextFree)
+            MaxSize = std::max(MaxSize, m_Blocks[BlockIdx].Size);
+        return MaxSize;
+    }
+
+    // Returns the index of the free block that can accommodate Size bytes with the given alignment
+    Uint32 FindSuitableBlock(OffsetType Size, OffsetType Alignment) const
+    {
+        auto FitsBlock = [&](Uint32 BlockIdx) {
+            const auto& Block = m_Blocks[BlockIdx];
+            return Size + (Align(Block.Offset, Alignment) - Block.Offset) <= Block.Size;
+        };
+
+        // Every block in the list found for the rounded-up size is at least Size bytes large
+        auto BlockIdx = FindFreeListHead(Size);
+        if (BlockIdx != InvalidIndex && FitsBlock(BlockIdx))
+            return BlockIdx;
+
+        // The block may not fit because of the alignment. Account for the worst-case padding.
+        if (Alignment > 1)
+        {
+            BlockIdx = FindFreeListHead(Size + Alignment - 1);
+            if (BlockIdx != InvalidIndex)
+            {
+                VERIFY_EXPR(FitsBlock(BlockIdx));
+                return BlockIdx;
+            }
+        }
+
+        // Rounding the size up skips the lists that contain blocks both smaller and larger than
+        // Size (+ alignment padding), some of which may still fit. Scanning these lists takes time linear
+        // in the number of the blocks they contain, but it is only done when the manager is nearly full.
+        Uint32 FirstFL = 0, FirstSL = 0, LastFL = 0, LastSL = 0;
+        MapSize(Size, FirstFL, FirstSL);
+        MapSize(std::min(Size + Alignment - 1, m_MaxSize), LastFL, LastSL);
+        for (auto FL = FirstFL; FL <= LastFL; ++FL)
+        {
+            auto SLBitmap = m_SLBitmaps[FL];
+            if (FL == FirstFL)
+                SLBitmap &= ~Uint32{0} << FirstSL;
+            if (FL == LastFL && LastSL + 1 < SLIndexCount)
+                SLBitmap &= (Uint32{1} << (LastSL + 1)) - 1;
+            while (SLBitmap != 0)
+            {
+                const auto SL = PlatformMisc::GetLSB(SLBitmap);
+                SLBitmap &= SLBitmap - 1;
+                for (BlockIdx = m_FreeLists[FL][SL]; BlockIdx != InvalidIndex; BlockIdx = m_Blocks[BlockIdx].NextFree)
+                {
+                    if (FitsBlock(BlockIdx))
+                        return BlockIdx;
+                }
+            }
+        }
+
+        return InvalidIndex;
+    }
+
+    // Returns the first block of the first non-empty list whose blocks are all at least Size bytes large
+    Uint32 FindFreeListHead(OffsetType Size) const
+    {
+        if (Size >= SmallBlockSize)
+        {
+            // Round the size up to the next class boundary
+            const auto Round = (OffsetType{1} << (PlatformMisc::GetMSB(Uint64{Size}) - SLIndexLog2)) - 1;
+            if (Size > m_MaxSize || Size + Round < Size)
+                return InvalidIndex;
+            Size += Round;
+        }
+
+        Uint32 FL = 0, SL = 0;
+        MapSize(Size, FL, SL);
+
+        Uint32 SLBitmap = m_SLBitmaps[FL] & (~Uint32{0} << SL);
+        if (SLBitmap == 0)
+        {
+            if (FL + 1 >= FLIndexCount)
+                return InvalidIndex;
+
+            const auto FLBitmap = m_FLBitmap & (~Uint64{0} << (FL + 1));
+            if (FLBitmap == 0)
+                return InvalidIndex;
+
+            FL       = PlatformMisc::GetLSB(FLBitmap);
+            SLBitmap = m_SLBitmaps[FL];
+            VERIFY_EXPR(SLBitmap != 0);
+        }
+        SL = PlatformMisc::GetLSB(SLBitmap);
+
+        VERIFY_EXPR(m_FreeLists[FL][SL] != InvalidIndex);
+        return m_FreeLists[FL][SL];
+    }
+
+    Uint32 CreateBlock()
+    {
+        if (m_FirstUnusedBlock != InvalidIndex)
+        {
+            auto BlockIdx      = m_FirstUnusedBlock;
+            m_FirstUnusedBlock = m_Blocks[BlockIdx].NextFree;
+            return BlockIdx;
+        }
+
+        m_Blocks.emplace_back();
+        return static_cast<Uint32>(m_Blocks.size() - 1);
+    }
+
+    void RecycleBlock(Uint32 BlockIdx)
+    {
+        m_Blocks[BlockIdx]          = FreeBlockInfo{};
+        m_Blocks[BlockIdx].NextFree = m_FirstUnusedBlock;
+        m_FirstUnusedBlock          = BlockIdx;
+    }
+
+    void InsertFreeBlock(Uint32 BlockIdx, OffsetType Offset, OffsetType Size)
+    {
+        VERIFY_EXPR(Size > 0);
+
+        Uint32 FL = 0, SL = 0;
+        MapSize(Size, FL, SL);
+
+        auto& Block    = m_Blocks[BlockIdx];
+        Block.Offset   = Offset;
+        Block.Size     = Size;
+        Block.PrevFree = InvalidIndex;
+        Block.NextFree = m_FreeLists[FL][SL];
+        if (Block.NextFree != InvalidIndex)
+            m_Blocks[Block.NextFree].PrevFree = BlockIdx;
+        m_FreeLists[FL][SL] = BlockIdx;
+
+        m_SLBitmaps[FL] |= Uint32{1} << SL;
+        m_FLBitmap |= Uint64{1} << FL;
+
+        m_BlocksByStart.Insert(Offset, BlockIdx);
+        m_BlocksByEnd.Insert(Offset + Size, BlockIdx);
+        ++m_NumFreeBlocks;
+
+        // If the cached size is not valid, it is an upper bound of the actual size
+        if (Size >= m_MaxFreeBlockSize)
+        {
+            m_MaxFreeBlockSize        = Size;
+            m_IsMaxFreeBlockSizeValid = true;
+        }
+    }
+
+    void RemoveFreeBlock(Uint32 BlockIdx)
+    {
+        const auto& Block = m_Blocks[BlockIdx];
+
+        Uint32 FL = 0, SL = 0;
+        MapSize(Block.Size, FL, SL);
+
+        if (Block.PrevFree != InvalidIndex)
+            m_Blocks[Block.PrevFree].NextFree = Block.NextFree;
+        else
+        {
+            VERIFY_EXPR(m_FreeLists[FL][SL] == BlockIdx);
+            m_FreeLists[FL][SL] = Block.NextFree;
+            if (Block.NextFree == InvalidIndex)
+            {
+                m_SLBitmaps[FL] &= ~(Uint32{1} << SL);
+                if (m_SLBitmaps[FL] == 0)
+                    m_FLBitmap &= ~(Uint64{1} << FL);
+            }
+        }
+        if (Block.NextFree != InvalidIndex)
+            m_Blocks[Block.NextFree].PrevFree = Block.PrevFree;
+
+        m_BlocksByStart.Erase(Block.Offset);
+        m_BlocksByEnd.Erase(Block.Offset + Block.Size);
+        VERIFY_EXPR(m_NumFreeBlocks > 0);
+        --m_NumFreeBlocks;
+
+        // Keep the size as the upper bound until the new maximum is requested or a larger block is inserted
+        if (Block.Size == m_MaxFreeBlockSize)
+            m_IsMaxFreeBlockSizeValid = false;
+    }
+
+#ifdef DILIGENT_DEBUG
+    void DbgVerifyBlocks() const
+    {
+        OffsetType TotalFreeSize = 0;
+        size_t     NumBlocks     = 0;
+        for (Uint32 FL = 0; FL < FLIndexCount; ++FL)
+        {
+            VERIFY_EXPR(((m_FLBitmap >> FL) & 1) == (m_SLBitmaps[FL] != 0 ? 1 : 0));
+            for (Uint32 SL = 0; SL < SLIndexCount; ++SL)
+            {
+                const auto Head = m_FreeLists[FL][SL];
+                VERIFY_EXPR(((m_SLBitmaps[FL] >> SL) & 1) == (Head != InvalidIndex ? 1u : 0u));
+                auto Prev = InvalidIndex;
+                for (auto BlockIdx = Head; BlockIdx != InvalidIndex; BlockIdx = m_Blocks[BlockIdx].NextFree)
+                {
+                    const auto& Block = m_Blocks[BlockIdx];
+                    VERIFY_EXPR(Block.PrevFree == Prev);
+                    VERIFY_EXPR(Block.Size > 0 && Block.Offset + Block.Size <= m_MaxSize);
+
+                    Uint32 BlockFL = 0, BlockSL = 0;
+                    MapSize(Block.Size, BlockFL, BlockSL);
+                    VERIFY(BlockFL == FL && BlockSL == SL, "Block is in the wrong free list");
+                    VERIFY_EXPR(m_BlocksByStart.Find(Block.Offset) == BlockIdx);
+                    VERIFY_EXPR(m_BlocksByEnd.Find(Block.Offset + Block.Size) == BlockIdx);
+                    // Adjacent free blocks must have been merged
+                    VERIFY(m_BlocksByEnd.Find(Block.Offset) == InvalidIndex, "Unmerged adjacent blocks detected");
+
+                    TotalFreeSize += Block.Size;
+                    ++NumBlocks;
+                    Prev = BlockIdx;
+                }
+            }
+        }
+        VERIFY_EXPR(NumBlocks == m_NumFreeBlocks);
+        VERIFY_EXPR(m_BlocksByStart.GetCount() == m_NumFreeBlocks && m_BlocksByEnd.GetCount() == m_NumFreeBlocks);
+        VERIFY_EXPR(TotalFreeSize == m_FreeSize);
+
+        const auto MaxFreeBlockSize = ComputeMaxFreeBlockSize();
+        if (m_IsMaxFreeBlockSizeValid)
+            VERIFY(m_MaxFreeBlockSize == MaxFreeBlockSize, "Cached max free block size is invalid");
+        else
+            VERIFY(m_MaxFreeBlockSize >= MaxFreeBlockSize, "Cached max free block size must be the upper bound of the actual size");
+    }
+#endif
+
+    std::vector<FreeBlockInfo, STDAllocatorRawMem<FreeBlockInfo>> m_Blocks;
+
+    OffsetHashMap m_BlocksByStart;
+    OffsetHashMap m_BlocksByEnd;
+
+    // Heads of the segregated free lists
+    std::array<std::array<Uint32, SLIndexCount>, FLIndexCount> m_FreeLists;
+
+    // Bit SL of m_SLBitmaps[FL] is set if the list m_FreeLists[FL][SL] is not empty
+    std::array<Uint32, FLIndexCount> m_SLBitmaps = {};
+    // Bit FL is set if m_SLBitmaps[FL] is not zero
+    Uint64 m_FLBitmap = 0;
+
+    // Head of the list of recycled block descriptors
+    Uint32 m_FirstUnusedBlock = InvalidIndex;
+    size_t m_NumFreeBlocks    = 0;
+
+    OffsetType m_MaxSize  = 0;
+    OffsetType m_FreeSize = 0;
+
+    // Size of the largest free block, or its upper bound if m_IsMaxFreeBlockSizeValid is false
+    mutable OffsetType m_MaxFreeBlockSize        = 0;
+    mutable bool       m_IsMaxFreeBlockSizeValid = true;
+    // When adding new members, do not forget to update move ctor
+};
+} // namespace Diligent
@@ -357,6 +357,12 @@ public:
         return m_FreeBlocksByOffset.size();
     }
 
+    // Returns the size of the largest free block
+    OffsetType GetMaxFreeBlockSize() const
+    {
+        return !m_FreeBlocksBySize.empty() ? m_FreeBlocksBySize.rbegin()->first : 0;
+    }
+
 private:
     void AddNewBlock(OffsetType Offset, OffsetType Size)
     {
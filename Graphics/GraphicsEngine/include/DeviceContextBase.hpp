@@ -31,6 +31,7 @@
 /// Implementation of the Diligent::DeviceContextBase template class and related structures
 
 #include <unordered_map>
+#include <algorithm>
 
 #include "DeviceContext.h"
 #include "DeviceObjectBase.hpp"
@@ -95,14 +96,12 @@ public:
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_DeviceContext, TObjectBase)
 
-    /// Base implementation of IDeviceContext::SetVertexBuffers(); validates parameters and
-    /// caches references to the buffers.
-    inline virtual void DILIGENT_CALL_TYPE SetVertexBuffers(Uint32                         StartSlot,
-                                                            Uint32                         NumBuffersSet,
-                                                            IBuffer**                      ppBuffers,
-                                                            Uint32*                        pOffsets,
-                                                            RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
-                                                            SET_VERTEX_BUFFERS_FLAGS       Flags) override = 0;
+    virtual void DILIGENT_CALL_TYPE SetVertexBuffers(Uint32                         StartSlot,
+                                                     Uint32                         NumBuffersSet,
+                                                     IBuffer**                      ppBuffers,
+                                                     Uint32*                        pOffsets,
+                                                     RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
+                                                     SET_VERTEX_BUFFERS_FLAGS       Flags) override = 0;
 
     inline virtual void DILIGENT_CALL_TYPE InvalidateState() override = 0;
 
@@ -111,14 +110,15 @@ public:
                                       RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
                                       int);
 
-    /// Base implementation of IDeviceContext::SetIndexBuffer(); caches the strong reference to the index buffer
-    inline virtual void DILIGENT_CALL_TYPE SetIndexBuffer(IBuffer* pIndexBuffer, Uint32 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode) override = 0;
+    virtual void DILIGENT_CALL_TYPE SetIndexBuffer(IBuffer* pIndexBuffer, Uint32 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode) override = 0;
 
-    /// Caches the viewports
-    inline void SetViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32& RTWidth, Uint32& RTHeight);
+    /// Caches the viewports. Returns true if the viewports differ from the cached
+    /// ones and false otherwise.
+    inline bool SetViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32& RTWidth, Uint32& RTHeight);
 
-    /// Caches the scissor rects
-    inline void SetScissorRects(Uint32 NumRects, const Rect* pRects, Uint32& RTWidth, Uint32& RTHeight);
+    /// Caches the scissor rects. Returns true if the rects differ from the cached
+    /// ones and false otherwise.
+    inline bool SetScissorRects(Uint32 NumRects, const Rect* pRects, Uint32& RTWidth, Uint32& RTHeight);
 
     /// Caches the render target and depth stencil views. Returns true if any view is different
     /// from the cached value and false otherwise.
@@ -190,6 +190,12 @@ public:
     /// Returns currently set viewports
     inline void GetViewports(Uint32& NumViewports, Viewport* pViewports);
 
+    /// Implementation of IDeviceContext::GetStateStats().
+    virtual void DILIGENT_CALL_TYPE GetStateStats(DeviceContextStateStats& Stats) const override final
+    {
+        Stats = m_StateStats;
+    }
+
     /// Returns the render device
     IRenderDevice* GetDevice() { return m_pDevice; }
 
@@ -202,12 +208,35 @@ public:
     bool UnbindTextureFromFramebuffer(TextureImplType* pTexture, bool bShowMessage);
 
 protected:
+    /// Base implementation of IDeviceContext::SetVertexBuffers(); validates parameters and
+    /// caches references to the buffers. Returns true if any stream differs from the cached
+    /// one and false otherwise.
+    inline bool SetVertexBuffers(Uint32                   StartSlot,
+                                 Uint32                   NumBuffersSet,
+                                 IBuffer**                ppBuffers,
+                                 Uint32*                  pOffsets,
+                                 SET_VERTEX_BUFFERS_FLAGS Flags,
+                                 int                      Dummy);
+
+    /// Base implementation of IDeviceContext::SetIndexBuffer(); caches the strong reference to the index buffer.
+    /// Returns true if the buffer or the offset differ from the cached ones and false otherwise.
+    inline bool SetIndexBuffer(IBuffer* pIndexBuffer, Uint32 ByteOffset, int Dummy);
+
     inline bool SetBlendFactors(const float* BlendFactors, int Dummy);
 
     inline bool SetStencilRef(Uint32 StencilRef, int Dummy);
 
     inline void SetPipelineState(PipelineStateImplType* pPipelineState, int /*Dummy*/);
 
+    /// Returns true if the pipeline state is already bound to the context, in which case
+    /// the call to IDeviceContext::SetPipelineState() is counted as filtered.
+    inline bool IsPipelineStateBound(PipelineStateImplType* pPipelineState);
+
+    /// Returns true if vertex buffer strides of the pipeline state differ from the strides of the
+    /// currently bound pipeline. Back-ends that take the strides from the pipeline state must commit
+    /// the vertex buffers again in this case.
+    inline bool VertexBufferStridesDiffer(const PipelineStateImplType* pPipelineState) const;
+
     /// Clears all cached resources
     inline void ClearStateCache();
 
@@ -231,6 +260,8 @@ protected:
     bool DvpVerifyDrawIndexedArguments        (const DrawIndexedAttribs&         Attribs)const;
     bool DvpVerifyDrawIndirectArguments       (const DrawIndirectAttribs&        Attribs, const IBuffer* pAttribsBuffer)const;
     bool DvpVerifyDrawIndexedIndirectArguments(const DrawIndexedIndirectAttribs& Attribs, const IBuffer* pAttribsBuffer)const;
+    bool DvpVerifyMultiDrawArguments          (const MultiDrawAttribs&           Attribs)const;
+    bool DvpVerifyMultiDrawIndexedArguments   (const MultiDrawIndexedAttribs&    Attribs)const;
 
     bool DvpVerifyDispatchArguments        (const DispatchComputeAttribs& Attribs)const;
     bool DvpVerifyDispatchIndirectArguments(const DispatchComputeIndirectAttribs& Attribs, const IBuffer* pAttribsBuffer)const;
@@ -244,6 +275,8 @@ protected:
     bool DvpVerifyDrawIndexedArguments        (const DrawIndexedAttribs&         Attribs)const {return true;}
     bool DvpVerifyDrawIndirectArguments       (const DrawIndirectAttribs&        Attribs, const IBuffer* pAttribsBuffer)const {return true;}
     bool DvpVerifyDrawIndexedIndirectArguments(const DrawIndexedIndirectAttribs& Attribs, const IBuffer* pAttribsBuffer)const {return true;}
+    bool DvpVerifyMultiDrawArguments          (const MultiDrawAttribs&           Attribs)const {return true;}
+    bool DvpVerifyMultiDrawIndexedArguments   (const MultiDrawIndexedAttribs&    Attribs)const {return true;}
 
     bool DvpVerifyDispatchArguments        (const DispatchComputeAttribs& Attribs)const {return true;}
     bool DvpVerifyDispatchIndirectArguments(const DispatchComputeIndirectAttribs& Attribs, const IBuffer* pAttribsBuffer)const {return true;}
@@ -287,11 +320,16 @@ protected:
     Viewport m_Viewports[MAX_VIEWPORTS];
     /// Number of current viewports
     Uint32 m_NumViewports = 0;
+    /// Render target size the current viewports were set for
+    Uint32 m_ViewportsRTWidth  = 0;
+    Uint32 m_ViewportsRTHeight = 0;
 
     /// Current scissor rects
     Rect m_ScissorRects[MAX_VIEWPORTS];
     /// Number of current scissor rects
     Uint32 m_NumScissorRects = 0;
+    /// Render target height the current scissor rects were set for
+    Uint32 m_ScissorRectsRTHeight = 0;
 
     /// Vector of strong references to the bound render targets.
     /// Use final texture view implementation type to avoid virtual calls to AddRef()/Release()
@@ -311,6 +349,9 @@ protected:
 
     const bool m_bIsDeferred = false;
 
+    /// Redundant state filtering statistics
+    DeviceContextStateStats m_StateStats;
+
 #ifdef DILIGENT_DEBUG
     // std::unordered_map is unbelievably slow. Keeping track of mapped buffers
     // in release builds is not feasible
@@ -324,19 +365,19 @@ protected:
 
 
 template <typename BaseInterface, typename ImplementationTraits>
-inline void DeviceContextBase<BaseInterface, ImplementationTraits>::
-    SetVertexBuffers(Uint32                         StartSlot,
-                     Uint32                         NumBuffersSet,
-                     IBuffer**                      ppBuffers,
-                     Uint32*                        pOffsets,
-                     RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
-                     SET_VERTEX_BUFFERS_FLAGS       Flags)
+inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::
+    SetVertexBuffers(Uint32                   StartSlot,
+                     Uint32                   NumBuffersSet,
+                     IBuffer**                ppBuffers,
+                     Uint32*                  pOffsets,
+                     SET_VERTEX_BUFFERS_FLAGS Flags,
+                     int /*Dummy*/)
 {
 #ifdef DILIGENT_DEVELOPMENT
     if (StartSlot >= MAX_BUFFER_SLOTS)
     {
         LOG_ERROR_MESSAGE("Start vertex buffer slot ", StartSlot, " is out of allowed range [0, ", MAX_BUFFER_SLOTS - 1, "].");
-        return;
+        return false;
     }
 
     if (StartSlot + NumBuffersSet > MAX_BUFFER_SLOTS)
@@ -346,24 +387,45 @@ inline void DeviceContextBase<BaseInterface, ImplementationTraits>::
     }
 #endif
 
+    const auto OldNumVertexStreams = m_NumVertexStreams;
+
+    bool StreamsChanged = false;
     if (Flags & SET_VERTEX_BUFFERS_FLAG_RESET)
     {
         // Reset only these buffer slots that are not being set.
         // It is very important to not reset buffers that stay unchanged
         // as AddRef()/Release() are not free
         for (Uint32 s = 0; s < StartSlot; ++s)
-            m_VertexStreams[s] = VertexStreamInfo<BufferImplType>{};
+        {
+            if (m_VertexStreams[s].pBuffer)
+            {
+                m_VertexStreams[s] = VertexStreamInfo<BufferImplType>{};
+                StreamsChanged     = true;
+            }
+        }
         for (Uint32 s = StartSlot + NumBuffersSet; s < m_NumVertexStreams; ++s)
-            m_VertexStreams[s] = VertexStreamInfo<BufferImplType>{};
+        {
+            if (m_VertexStreams[s].pBuffer)
+            {
+                m_VertexStreams[s] = VertexStreamInfo<BufferImplType>{};
+                StreamsChanged     = true;
+            }
+        }
         m_NumVertexStreams = 0;
     }
     m_NumVertexStreams = std::max(m_NumVertexStreams, StartSlot + NumBuffersSet);
 
     for (Uint32 Buff = 0; Buff < NumBuffersSet; ++Buff)
     {
-        auto& CurrStream   = m_VertexStreams[StartSlot + Buff];
-        CurrStream.pBuffer = ppBuffers ? ValidatedCast<BufferImplType>(ppBuffers[Buff]) : nullptr;
-        CurrStream.Offset  = pOffsets ? pOffsets[Buff] : 0;
+        auto&      CurrStream = m_VertexStreams[StartSlot + Buff];
+        auto*      pBuffer    = ppBuffers ? ValidatedCast<BufferImplType>(ppBuffers[Buff]) : nullptr;
+        const auto Offset     = pOffsets ? pOffsets[Buff] : 0;
+        if (CurrStream.pBuffer != pBuffer || CurrStream.Offset != Offset)
+        {
+            CurrStream.pBuffer = pBuffer;
+            CurrStream.Offset  = Offset;
+            StreamsChanged     = true;
+        }
 #ifdef DILIGENT_DEVELOPMENT
         if (CurrStream.pBuffer)
         {
@@ -378,6 +440,14 @@ inline void DeviceContextBase<BaseInterface, ImplementationTraits>::
     // Remove null buffers from the end of the array
     while (m_NumVertexStreams > 0 && !m_VertexStreams[m_NumVertexStreams - 1].pBuffer)
         m_VertexStreams[m_NumVertexStreams--] = VertexStreamInfo<BufferImplType>{};
+
+    StreamsChanged = StreamsChanged || m_NumVertexStreams != OldNumVertexStreams;
+    if (StreamsChanged)
+        ++m_StateStats.VertexBuffers.Applied;
+    else
+        ++m_StateStats.VertexBuffers.Filtered;
+
+    return StreamsChanged;
 }
 
 template <typename BaseInterface, typename ImplementationTraits>
@@ -385,6 +455,35 @@ inline void DeviceContextBase<BaseInterface, ImplementationTraits>::
     SetPipelineState(PipelineStateImplType* pPipelineState, int /*Dummy*/)
 {
     m_pPipelineState = pPipelineState;
+    ++m_StateStats.PipelineState.Applied;
+}
+
+template <typename BaseInterface, typename ImplementationTraits>
+inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::
+    IsPipelineStateBound(PipelineStateImplType* pPipelineState)
+{
+    if (PipelineStateImplType::IsSameObject(m_pPipelineState, pPipelineState))
+    {
+        ++m_StateStats.PipelineState.Filtered;
+        return true;
+    }
+    return false;
+}
+
+template <typename BaseInterface, typename ImplementationTraits>
+inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::
+    VertexBufferStridesDiffer(const PipelineStateImplType* pPipelineState) const
+{
+    if (!m_pPipelineState)
+        return true;
+
+    const auto NumSlots = std::max(m_pPipelineState->GetNumBufferSlotsUsed(), pPipelineState->GetNumBufferSlotsUsed());
+    for (Uint32 Slot = 0; Slot < NumSlots; ++Slot)
+    {
+        if (m_pPipelineState->GetBufferStride(Slot) != pPipelineState->GetBufferStride(Slot))
+            return true;
+    }
+    return false;
 }
 
 template <typename BaseInterface, typename ImplementationTraits>
@@ -417,10 +516,17 @@ inline void DeviceContextBase<BaseInterface, ImplementationTraits>::InvalidateSt
 }
 
 template <typename BaseInterface, typename ImplementationTraits>
-inline void DeviceContextBase<BaseInterface, ImplementationTraits>::
-    SetIndexBuffer(IBuffer* pIndexBuffer, Uint32 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::
+    SetIndexBuffer(IBuffer* pIndexBuffer, Uint32 ByteOffset, int /*Dummy*/)
 {
-    m_pIndexBuffer         = ValidatedCast<BufferImplType>(pIndexBuffer);
+    auto* pIndexBufferImpl = ValidatedCast<BufferImplType>(pIndexBuffer);
+    if (m_pIndexBuffer == pIndexBufferImpl && m_IndexDataStartOffset == ByteOffset)
+    {
+        ++m_StateStats.IndexBuffer.Filtered;
+        return false;
+    }
+
+    m_pIndexBuffer         = pIndexBufferImpl;
     m_IndexDataStartOffset = ByteOffset;
 #ifdef DILIGENT_DEVELOPMENT
     if (m_pIndexBuffer)
@@ -432,6 +538,8 @@ inline void DeviceContextBase<BaseInterface, ImplementationTraits>::
         }
     }
 #endif
+    ++m_StateStats.IndexBuffer.Applied;
+    return true;
 }
 
 
@@ -464,6 +572,10 @@ inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::SetBlendFact
             FactorsDiffer = true;
         m_BlendFactors[f] = BlendFactors[f];
     }
+    if (FactorsDiffer)
+        ++m_StateStats.BlendFactors.Applied;
+    else
+        ++m_StateStats.BlendFactors.Filtered;
     return FactorsDiffer;
 }
 
@@ -473,13 +585,15 @@ inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::SetStencilRe
     if (m_StencilRef != StencilRef)
     {
         m_StencilRef = StencilRef;
+        ++m_StateStats.StencilRef.Applied;
         return true;
     }
+    ++m_StateStats.StencilRef.Filtered;
     return false;
 }
 
 template <typename BaseInterface, typename ImplementationTraits>
-inline void DeviceContextBase<BaseInterface, ImplementationTraits>::
+inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::
     SetViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32& RTWidth, Uint32& RTHeight)
 {
     if (RTWidth == 0 || RTHeight == 0)
@@ -489,15 +603,30 @@ inline void DeviceContextBase<BaseInterface, ImplementationTraits>::
     }
 
     VERIFY(NumViewports < MAX_VIEWPORTS, "Number of viewports (", NumViewports, ") exceeds the limit (", MAX_VIEWPORTS, ")");
-    m_NumViewports = std::min(MAX_VIEWPORTS, NumViewports);
+    NumViewports = std::min(MAX_VIEWPORTS, NumViewports);
 
     Viewport DefaultVP(0, 0, static_cast<float>(RTWidth), static_cast<float>(RTHeight));
     // If no viewports are specified, use default viewport
-    if (m_NumViewports == 1 && pViewports == nullptr)
+    if (NumViewports == 1 && pViewports == nullptr)
     {
         pViewports = &DefaultVP;
     }
 
+    // Some backends (e.g. OpenGL) use the render target size to compute the
+    // viewport position, so it is a part of the state as well.
+    bool ViewportsChanged = (m_NumViewports != NumViewports || m_ViewportsRTWidth != RTWidth || m_ViewportsRTHeight != RTHeight);
+    for (Uint32 vp = 0; vp < NumViewports && !ViewportsChanged; ++vp)
+        ViewportsChanged = m_Viewports[vp] != pViewports[vp];
+
+    if (!ViewportsChanged)
+    {
+        ++m_StateStats.Viewports.Filtered;
+        return false;
+    }
+
+    m_NumViewports      = NumViewports;
+    m_ViewportsRTWidth  = RTWidth;
+    m_ViewportsRTHeight = RTHeight;
     for (Uint32 vp = 0; vp < m_NumViewports; ++vp)
     {
         m_Viewports[vp] = pViewports[vp];
@@ -505,6 +634,8 @@ inline void DeviceContextBase<BaseInterface, ImplementationTraits>::
         VERIFY(m_Viewports[vp].Height >= 0, "Incorrect viewport height (", m_Viewports[vp].Height, ")");
         VERIFY(m_Viewports[vp].MaxDepth >= m_Viewports[vp].MinDepth, "Incorrect viewport depth range [", m_Viewports[vp].MinDepth, ", ", m_Viewports[vp].MaxDepth, "]");
     }
+    ++m_StateStats.Viewports.Applied;
+    return true;
 }
 
 template <typename BaseInterface, typename ImplementationTraits>
@@ -519,7 +650,7 @@ inline void DeviceContextBase<BaseInterface, ImplementationTraits>::GetViewports
 }
 
 template <typename BaseInterface, typename ImplementationTraits>
-inline void DeviceContextBase<BaseInterface, ImplementationTraits>::
+inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::
     SetScissorRects(Uint32 NumRects, const Rect* pRects, Uint32& RTWidth, Uint32& RTHeight)
 {
     if (RTWidth == 0 || RTHeight == 0)
@@ -529,14 +660,28 @@ inline void DeviceContextBase<BaseInterface, ImplementationTraits>::
     }
 
     VERIFY(NumRects < MAX_VIEWPORTS, "Number of scissor rects (", NumRects, ") exceeds the limit (", MAX_VIEWPORTS, ")");
-    m_NumScissorRects = std::min(MAX_VIEWPORTS, NumRects);
+    NumRects = std::min(MAX_VIEWPORTS, NumRects);
+
+    bool RectsChanged = (m_NumScissorRects != NumRects || m_ScissorRectsRTHeight != RTHeight);
+    for (Uint32 sr = 0; sr < NumRects && !RectsChanged; ++sr)
+        RectsChanged = m_ScissorRects[sr] != pRects[sr];
+
+    if (!RectsChanged)
+    {
+        ++m_StateStats.ScissorRects.Filtered;
+        return false;
+    }
 
+    m_NumScissorRects      = NumRects;
+    m_ScissorRectsRTHeight = RTHeight;
     for (Uint32 sr = 0; sr < m_NumScissorRects; ++sr)
     {
         m_ScissorRects[sr] = pRects[sr];
         VERIFY(m_ScissorRects[sr].left <= m_ScissorRects[sr].right, "Incorrect horizontal bounds for a scissor rect [", m_ScissorRects[sr].left, ", ", m_ScissorRects[sr].right, ")");
         VERIFY(m_ScissorRects[sr].top <= m_ScissorRects[sr].bottom, "Incorrect vertical bounds for a scissor rect [", m_ScissorRects[sr].top, ", ", m_ScissorRects[sr].bottom, ")");
     }
+    ++m_StateStats.ScissorRects.Applied;
+    return true;
 }
 
 template <typename BaseInterface, typename ImplementationTraits>
@@ -546,6 +691,7 @@ inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::
     if (NumRenderTargets == 0 && pDepthStencil == nullptr)
     {
         ResetRenderTargets();
+        ++m_StateStats.RenderTargets.Applied;
         return false;
     }
 
@@ -646,6 +792,11 @@ inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::
 
     VERIFY_EXPR(m_FramebufferWidth > 0 && m_FramebufferHeight > 0 && m_FramebufferSlices > 0);
 
+    if (bBindRenderTargets)
+        ++m_StateStats.RenderTargets.Applied;
+    else
+        ++m_StateStats.RenderTargets.Filtered;
+
     return bBindRenderTargets;
 }
 
@@ -709,11 +860,14 @@ inline void DeviceContextBase<BaseInterface, ImplementationTraits>::ClearStateCa
 
     for (Uint32 vp = 0; vp < m_NumViewports; ++vp)
         m_Viewports[vp] = Viewport();
-    m_NumViewports = 0;
+    m_NumViewports      = 0;
+    m_ViewportsRTWidth  = 0;
+    m_ViewportsRTHeight = 0;
 
     for (Uint32 sr = 0; sr < m_NumScissorRects; ++sr)
         m_ScissorRects[sr] = Rect();
-    m_NumScissorRects = 0;
+    m_NumScissorRects      = 0;
+    m_ScissorRectsRTHeight = 0;
 
     ResetRenderTargets();
 }
@@ -1320,6 +1474,88 @@ inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::
     return true;
 }
 
+template <typename BaseInterface, typename ImplementationTraits>
+inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::
+    DvpVerifyMultiDrawArguments(const MultiDrawAttribs& Attribs) const
+{
+    if ((Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) == 0)
+        return true;
+
+    if (!m_pPipelineState)
+    {
+        LOG_ERROR_MESSAGE("MultiDraw command arguments are invalid: no pipeline state is bound.");
+        return false;
+    }
+
+    if (m_pPipelineState->GetDesc().IsComputePipeline)
+    {
+        LOG_ERROR_MESSAGE("MultiDraw command arguments are invalid: pipeline state '", m_pPipelineState->GetDesc().Name, "' is a compute pipeline.");
+        return false;
+    }
+
+    if (Attribs.DrawCount != 0 && Attribs.pDrawItems == nullptr)
+    {
+        LOG_ERROR_MESSAGE("MultiDraw command arguments are invalid: DrawCount is ", Attribs.DrawCount, ", but pDrawItems is null.");
+        return false;
+    }
+
+    for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+    {
+        if (Attribs.pDrawItems[i].NumVertices == 0)
+            LOG_WARNING_MESSAGE("MultiDraw command arguments are invalid: number of vertices to draw in item ", i, " is zero.");
+    }
+
+    return true;
+}
+
+template <typename BaseInterface, typename ImplementationTraits>
+inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::
+    DvpVerifyMultiDrawIndexedArguments(const MultiDrawIndexedAttribs& Attribs) const
+{
+    if ((Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) == 0)
+        return true;
+
+    if (!m_pPipelineState)
+    {
+        LOG_ERROR_MESSAGE("MultiDrawIndexed command arguments are invalid: no pipeline state is bound.");
+        return false;
+    }
+
+    if (m_pPipelineState->GetDesc().IsComputePipeline)
+    {
+        LOG_ERROR_MESSAGE("MultiDrawIndexed command arguments are invalid: pipeline state '",
+                          m_pPipelineState->GetDesc().Name, "' is a compute pipeline.");
+        return false;
+    }
+
+    if (Attribs.IndexType != VT_UINT16 && Attribs.IndexType != VT_UINT32)
+    {
+        LOG_ERROR_MESSAGE("MultiDrawIndexed command arguments are invalid: IndexType (",
+                          GetValueTypeString(Attribs.IndexType), ") must be VT_UINT16 or VT_UINT32.");
+        return false;
+    }
+
+    if (!m_pIndexBuffer)
+    {
+        LOG_ERROR_MESSAGE("MultiDrawIndexed command arguments are invalid: no index buffer is bound.");
+        return false;
+    }
+
+    if (Attribs.DrawCount != 0 && Attribs.pDrawItems == nullptr)
+    {
+        LOG_ERROR_MESSAGE("MultiDrawIndexed command arguments are invalid: DrawCount is ", Attribs.DrawCount, ", but pDrawItems is null.");
+        return false;
+    }
+
+    for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+    {
+        if (Attribs.pDrawItems[i].NumIndices == 0)
+            LOG_WARNING_MESSAGE("MultiDrawIndexed command arguments are invalid: number of indices to draw in item ", i, " is zero.");
+    }
+
+    return true;
+}
+
 template <typename BaseInterface, typename ImplementationTraits>
 inline void DeviceContextBase<BaseInterface, ImplementationTraits>::
     DvpVerifyRenderTargets() const
@@ -335,6 +335,15 @@ public:
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_PipelineState, TDeviceObjectBase)
 
+    /// Implementation of IPipelineState::GetStaticVariableByHashedName().
+
+    /// Back-ends that do not index variables by name hash fall back to the regular lookup.
+    virtual IShaderResourceVariable* DILIGENT_CALL_TYPE GetStaticVariableByHashedName(SHADER_TYPE                     ShaderType,
+                                                                                      const HashedShaderVariableName& Name) override
+    {
+        return this->GetStaticVariableByName(ShaderType, Name.Name);
+    }
+
     Uint32 GetBufferStride(Uint32 BufferSlot) const
     {
         return BufferSlot < m_BufferSlotsUsed ? m_pStrides[BufferSlot] : 0;
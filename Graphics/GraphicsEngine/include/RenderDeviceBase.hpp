@@ -230,6 +230,8 @@ public:
     ///
     /// \remarks Render device uses fixed block allocators (see FixedBlockMemoryAllocator) to allocate memory for
     ///          device objects. The object sizes provided to constructor are used to initialize the allocators.
+    ///          Allocators for the objects that are typically created by many threads (textures, buffers,
+    ///          views and SRBs) use per-thread block caches.
     RenderDeviceBase(IReferenceCounters*      pRefCounters,
                      IMemoryAllocator&        RawMemAllocator,
                      IEngineFactory*          pEngineFactory,
@@ -243,17 +245,17 @@ public:
         m_TexFmtInfoInitFlags   (TEX_FORMAT_NUM_FORMATS, false, STD_ALLOCATOR_RAW_MEM(bool, RawMemAllocator, "Allocator for vector<bool>")),
         m_wpDeferredContexts    (NumDeferredContexts, RefCntWeakPtr<IDeviceContext>(), STD_ALLOCATOR_RAW_MEM(RefCntWeakPtr<IDeviceContext>, RawMemAllocator, "Allocator for vector< RefCntWeakPtr<IDeviceContext> >")),
         m_RawMemAllocator       {RawMemAllocator},
-        m_TexObjAllocator       {RawMemAllocator, ObjectSizes.TextureObjSize,   64  },
-        m_TexViewObjAllocator   {RawMemAllocator, ObjectSizes.TexViewObjSize,   64  },
-        m_BufObjAllocator       {RawMemAllocator, ObjectSizes.BufferObjSize,    128 },
-        m_BuffViewObjAllocator  {RawMemAllocator, ObjectSizes.BuffViewObjSize,  128 },
-        m_ShaderObjAllocator    {RawMemAllocator, ObjectSizes.ShaderObjSize,    32  },
-        m_SamplerObjAllocator   {RawMemAllocator, ObjectSizes.SamplerObjSize,   32  },
-        m_PSOAllocator          {RawMemAllocator, ObjectSizes.PSOSize,          128 },
-        m_SRBAllocator          {RawMemAllocator, ObjectSizes.SRBSize,          1024},
-        m_ResMappingAllocator   {RawMemAllocator, sizeof(ResourceMappingImpl),  16  },
-        m_FenceAllocator        {RawMemAllocator, ObjectSizes.FenceSize,        16  },
-        m_QueryAllocator        {RawMemAllocator, ObjectSizes.QuerySize,        16  }
+        m_TexObjAllocator       {RawMemAllocator, ObjectSizes.TextureObjSize,   64,   true },
+        m_TexViewObjAllocator   {RawMemAllocator, ObjectSizes.TexViewObjSize,   64,   true },
+        m_BufObjAllocator       {RawMemAllocator, ObjectSizes.BufferObjSize,    128,  true },
+        m_BuffViewObjAllocator  {RawMemAllocator, ObjectSizes.BuffViewObjSize,  128,  true },
+        m_ShaderObjAllocator    {RawMemAllocator, ObjectSizes.ShaderObjSize,    32,   false},
+        m_SamplerObjAllocator   {RawMemAllocator, ObjectSizes.SamplerObjSize,   32,   false},
+        m_PSOAllocator          {RawMemAllocator, ObjectSizes.PSOSize,          128,  false},
+        m_SRBAllocator          {RawMemAllocator, ObjectSizes.SRBSize,          1024, true },
+        m_ResMappingAllocator   {RawMemAllocator, sizeof(ResourceMappingImpl),  16,   false},
+        m_FenceAllocator        {RawMemAllocator, ObjectSizes.FenceSize,        16,   false},
+        m_QueryAllocator        {RawMemAllocator, ObjectSizes.QuerySize,        16,   false}
     // clang-format on
     {
         // Initialize texture format info
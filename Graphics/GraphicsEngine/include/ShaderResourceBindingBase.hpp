@@ -67,6 +67,15 @@ public:
         return m_pPSO;
     }
 
+    /// Implementation of IShaderResourceBinding::GetVariableByHashedName().
+
+    /// Back-ends that do not index variables by name hash fall back to the regular lookup.
+    virtual IShaderResourceVariable* DILIGENT_CALL_TYPE GetVariableByHashedName(SHADER_TYPE                     ShaderType,
+                                                                                const HashedShaderVariableName& Name) override
+    {
+        return this->GetVariableByName(ShaderType, Name.Name);
+    }
+
     template <typename PSOType>
     PSOType* GetPipelineState()
     {
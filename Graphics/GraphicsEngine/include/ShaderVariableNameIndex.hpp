@@ -0,0 +1,110 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+#pragma once
+
+/// \file
+/// Implementation of the Diligent::ShaderVariableNameIndex class
+
+#include <vector>
+#include <cstring>
+
+#include "ShaderResourceVariable.h"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+/// Open-addressing hash table that maps shader variable names to variable indices.
+
+/// The table is built once when the pipeline state is created and is shared by all objects
+/// that enumerate variables in the same order (for instance, all shader resource bindings created
+/// by the pipeline state). The table only keeps name hashes and indices. Variable names are
+/// requested through the NameGetter functor (Uint32 Index -> const Char*) to resolve collisions.
+class ShaderVariableNameIndex
+{
+public:
+    static constexpr Uint32 InvalidIndex = ~0u;
+
+    template <typename NameGetterType>
+    void Initialize(Uint32 NumVariables, NameGetterType NameGetter)
+    {
+        m_Entries.clear();
+        m_Mask = 0;
+        if (NumVariables == 0)
+            return;
+
+        // Keep the load factor at or below 1/2 so that probe sequences remain short
+        Uint32 Capacity = 4;
+        while (Capacity < NumVariables * 2)
+            Capacity *= 2;
+        m_Entries.resize(Capacity);
+        m_Mask = Capacity - 1;
+
+        for (Uint32 i = 0; i < NumVariables; ++i)
+        {
+            const auto Hash = ComputeShaderVariableNameHash(NameGetter(i));
+
+            auto Slot = Hash & m_Mask;
+            while (m_Entries[Slot].Index != InvalidIndex)
+                Slot = (Slot + 1) & m_Mask;
+
+            m_Entries[Slot].Hash  = Hash;
+            m_Entries[Slot].Index = i;
+        }
+    }
+
+    /// Returns the index of the variable with the given name, or InvalidIndex if there is no such variable.
+    /// If there are multiple variables with the same name, returns the smallest index.
+    template <typename NameGetterType>
+    Uint32 Find(const HashedShaderVariableName& Name, NameGetterType NameGetter) const
+    {
+        VERIFY(Name.Hash == ComputeShaderVariableNameHash(Name.Name), "The hash of variable name '", (Name.Name != nullptr ? Name.Name : "<null>"), "' is invalid");
+        if (m_Entries.empty() || Name.Name == nullptr)
+            return InvalidIndex;
+
+        for (auto Slot = Name.Hash & m_Mask;; Slot = (Slot + 1) & m_Mask)
+        {
+            const auto& Entry = m_Entries[Slot];
+            if (Entry.Index == InvalidIndex)
+                return InvalidIndex;
+
+            if (Entry.Hash == Name.Hash && strcmp(NameGetter(Entry.Index), Name.Name) == 0)
+                return Entry.Index;
+        }
+    }
+
+private:
+    struct HashEntry
+    {
+        Uint32 Hash  = 0;
+        Uint32 Index = InvalidIndex;
+    };
+    std::vector<HashEntry> m_Entries;
+    Uint32                 m_Mask = 0;
+};
+
+} // namespace Diligent
@@ -279,6 +279,159 @@ struct DrawIndexedAttribs
 };
 typedef struct DrawIndexedAttribs DrawIndexedAttribs;
 
+
+/// Defines a single draw of the multi-draw command.
+
+/// This structure is used by IDeviceContext::MultiDraw().
+struct MultiDrawItem
+{
+    /// The number of vertices to draw.
+    Uint32 NumVertices           DEFAULT_INITIALIZER(0);
+
+    /// The number of instances to draw.
+    Uint32 NumInstances          DEFAULT_INITIALIZER(1);
+
+    /// LOCATION (or INDEX, but NOT the byte offset) of the first vertex in the
+    /// vertex buffer to start reading vertices from.
+    Uint32 StartVertexLocation   DEFAULT_INITIALIZER(0);
+
+    /// LOCATION (or INDEX, but NOT the byte offset) in the vertex buffer to start
+    /// reading instance data from.
+    Uint32 FirstInstanceLocation DEFAULT_INITIALIZER(0);
+
+
+#if DILIGENT_CPP_INTERFACE
+    /// Initializes the structure members with default values.
+    MultiDrawItem()noexcept{}
+
+    /// Initializes the structure with user-specified values.
+    MultiDrawItem(Uint32 _NumVertices,
+                  Uint32 _NumInstances          = 1,
+                  Uint32 _StartVertexLocation   = 0,
+                  Uint32 _FirstInstanceLocation = 0)noexcept : 
+        NumVertices          {_NumVertices          },
+        NumInstances         {_NumInstances         },
+        StartVertexLocation  {_StartVertexLocation  },
+        FirstInstanceLocation{_FirstInstanceLocation}
+    {}
+#endif
+};
+typedef struct MultiDrawItem MultiDrawItem;
+
+
+/// Defines the multi-draw command attributes.
+
+/// This structure is used by IDeviceContext::MultiDraw().
+struct MultiDrawAttribs
+{
+    /// The number of draws in pDrawItems array.
+    Uint32                     DrawCount  DEFAULT_INITIALIZER(0);
+
+    /// Pointer to the array of DrawCount draw items.
+    const MultiDrawItem*       pDrawItems DEFAULT_INITIALIZER(nullptr);
+
+    /// Additional flags that apply to all draws, see Diligent::DRAW_FLAGS.
+    DRAW_FLAGS                 Flags      DEFAULT_INITIALIZER(DRAW_FLAG_NONE);
+
+
+#if DILIGENT_CPP_INTERFACE
+    /// Initializes the structure members with default values.
+    MultiDrawAttribs()noexcept{}
+
+    /// Initializes the structure with user-specified values.
+    MultiDrawAttribs(Uint32               _DrawCount,
+                     const MultiDrawItem* _pDrawItems,
+                     DRAW_FLAGS           _Flags)noexcept : 
+        DrawCount {_DrawCount },
+        pDrawItems{_pDrawItems},
+        Flags     {_Flags     }
+    {}
+#endif
+};
+typedef struct MultiDrawAttribs MultiDrawAttribs;
+
+
+/// Defines a single draw of the indexed multi-draw command.
+
+/// This structure is used by IDeviceContext::MultiDrawIndexed().
+struct MultiDrawIndexedItem
+{
+    /// The number of indices to draw.
+    Uint32 NumIndices            DEFAULT_INITIALIZER(0);
+
+    /// The number of instances to draw.
+    Uint32 NumInstances          DEFAULT_INITIALIZER(1);
+
+    /// LOCATION (NOT the byte offset) of the first index in
+    /// the index buffer to start reading indices from.
+    Uint32 FirstIndexLocation    DEFAULT_INITIALIZER(0);
+
+    /// A constant which is added to each index before accessing the vertex buffer.
+    Uint32 BaseVertex            DEFAULT_INITIALIZER(0);
+
+    /// LOCATION (or INDEX, but NOT the byte offset) in the vertex
+    /// buffer to start reading instance data from.
+    Uint32 FirstInstanceLocation DEFAULT_INITIALIZER(0);
+
+
+#if DILIGENT_CPP_INTERFACE
+    /// Initializes the structure members with default values.
+    MultiDrawIndexedItem()noexcept{}
+
+    /// Initializes the structure with user-specified values.
+    MultiDrawIndexedItem(Uint32 _NumIndices,
+                         Uint32 _NumInstances          = 1,
+                         Uint32 _FirstIndexLocation    = 0,
+                         Uint32 _BaseVertex            = 0,
+                         Uint32 _FirstInstanceLocation = 0)noexcept : 
+        NumIndices           {_NumIndices           },
+        NumInstances         {_NumInstances         },
+        FirstIndexLocation   {_FirstIndexLocation   },
+        BaseVertex           {_BaseVertex           },
+        FirstInstanceLocation{_FirstInstanceLocation}
+    {}
+#endif
+};
+typedef struct MultiDrawIndexedItem MultiDrawIndexedItem;
+
+
+/// Defines the indexed multi-draw command attributes.
+
+/// This structure is used by IDeviceContext::MultiDrawIndexed().
+struct MultiDrawIndexedAttribs
+{
+    /// The number of draws in pDrawItems array.
+    Uint32                      DrawCount  DEFAULT_INITIALIZER(0);
+
+    /// Pointer to the array of DrawCount draw items.
+    const MultiDrawIndexedItem* pDrawItems DEFAULT_INITIALIZER(nullptr);
+
+    /// The type of elements in the index buffer.
+    /// Allowed values: VT_UINT16 and VT_UINT32.
+    VALUE_TYPE                  IndexType  DEFAULT_INITIALIZER(VT_UNDEFINED);
+
+    /// Additional flags that apply to all draws, see Diligent::DRAW_FLAGS.
+    DRAW_FLAGS                  Flags      DEFAULT_INITIALIZER(DRAW_FLAG_NONE);
+
+
+#if DILIGENT_CPP_INTERFACE
+    /// Initializes the structure members with default values.
+    MultiDrawIndexedAttribs()noexcept{}
+
+    /// Initializes the structure with user-specified values.
+    MultiDrawIndexedAttribs(Uint32                      _DrawCount,
+                            const MultiDrawIndexedItem* _pDrawItems,
+                            VALUE_TYPE                  _IndexType,
+                            DRAW_FLAGS                  _Flags)noexcept : 
+        DrawCount {_DrawCount },
+        pDrawItems{_pDrawItems},
+        IndexType {_IndexType },
+        Flags     {_Flags     }
+    {}
+#endif
+};
+typedef struct MultiDrawIndexedAttribs MultiDrawIndexedAttribs;
+
 /// Defines the indirect draw command attributes.
 
 /// This structure is used by IDeviceContext::DrawIndirect().
@@ -512,6 +665,22 @@ struct Viewport
     {}
 
     Viewport()noexcept{}
+
+    /// Tests if two viewports are equal.
+    bool operator == (const Viewport& RHS)const
+    {
+        return TopLeftX == RHS.TopLeftX &&
+               TopLeftY == RHS.TopLeftY &&
+               Width    == RHS.Width    &&
+               Height   == RHS.Height   &&
+               MinDepth == RHS.MinDepth &&
+               MaxDepth == RHS.MaxDepth;
+    }
+
+    bool operator != (const Viewport& RHS)const
+    {
+        return !(*this == RHS);
+    }
 #endif
 };
 typedef struct Viewport Viewport;
@@ -546,6 +715,20 @@ struct Rect
     {
         return right > left && bottom > top;
     }
+
+    /// Tests if two rectangles are equal.
+    bool operator == (const Rect& RHS)const
+    {
+        return left   == RHS.left   &&
+               top    == RHS.top    &&
+               right  == RHS.right  &&
+               bottom == RHS.bottom;
+    }
+
+    bool operator != (const Rect& RHS)const
+    {
+        return !(*this == RHS);
+    }
 #endif
 };
 typedef struct Rect Rect;
@@ -609,6 +792,50 @@ struct CopyTextureAttribs
 };
 typedef struct CopyTextureAttribs CopyTextureAttribs;
 
+
+/// Counters of a single device context state setter, see Diligent::DeviceContextStateStats.
+struct StateChangeCounters
+{
+    /// Number of calls that changed the context state and were forwarded to the
+    /// underlying graphics API.
+    Uint64 Applied  DEFAULT_INITIALIZER(0);
+
+    /// Number of calls that set the state identical to the one currently
+    /// bound in the context and were filtered out.
+    Uint64 Filtered DEFAULT_INITIALIZER(0);
+};
+typedef struct StateChangeCounters StateChangeCounters;
+
+
+/// Redundant state filtering statistics, see Diligent::IDeviceContext::GetStateStats.
+struct DeviceContextStateStats
+{
+    /// IDeviceContext::SetPipelineState() counters.
+    StateChangeCounters PipelineState;
+
+    /// IDeviceContext::SetVertexBuffers() counters.
+    StateChangeCounters VertexBuffers;
+
+    /// IDeviceContext::SetIndexBuffer() counters.
+    StateChangeCounters IndexBuffer;
+
+    /// IDeviceContext::SetViewports() counters.
+    StateChangeCounters Viewports;
+
+    /// IDeviceContext::SetScissorRects() counters.
+    StateChangeCounters ScissorRects;
+
+    /// IDeviceContext::SetRenderTargets() counters.
+    StateChangeCounters RenderTargets;
+
+    /// IDeviceContext::SetBlendFactors() counters.
+    StateChangeCounters BlendFactors;
+
+    /// IDeviceContext::SetStencilRef() counters.
+    StateChangeCounters StencilRef;
+};
+typedef struct DeviceContextStateStats DeviceContextStateStats;
+
 #define DILIGENT_INTERFACE_NAME IDeviceContext
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
@@ -932,6 +1159,36 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
                                              IBuffer*                             pAttribsBuffer) PURE;
 
 
+    /// Executes a batch of draw commands that share the same pipeline state and resources.
+
+    /// \param [in] Attribs - Multi-draw command attributes, see Diligent::MultiDrawAttribs for details.
+    ///
+    /// \remarks  The method is equivalent to calling IDeviceContext::Draw() for every draw item, but
+    ///           draw arguments are validated and the pipeline states are committed only once
+    ///           for the whole batch.
+    ///
+    ///           If Diligent::DRAW_FLAG_VERIFY_STATES flag is set, the method reads the state of vertex
+    ///           buffers, so no other threads are allowed to alter the states of the same resources.
+    ///           It is OK to read these states.
+    VIRTUAL void METHOD(MultiDraw)(THIS_
+                                   const MultiDrawAttribs REF Attribs) PURE;
+
+
+    /// Executes a batch of indexed draw commands that share the same pipeline state and resources.
+
+    /// \param [in] Attribs - Multi-draw command attributes, see Diligent::MultiDrawIndexedAttribs for details.
+    ///
+    /// \remarks  The method is equivalent to calling IDeviceContext::DrawIndexed() for every draw item, but
+    ///           draw arguments are validated and the pipeline states are committed only once
+    ///           for the whole batch.
+    ///
+    ///           If Diligent::DRAW_FLAG_VERIFY_STATES flag is set, the method reads the state of vertex/index
+    ///           buffers, so no other threads are allowed to alter the states of the same resources.
+    ///           It is OK to read these states.
+    VIRTUAL void METHOD(MultiDrawIndexed)(THIS_
+                                          const MultiDrawIndexedAttribs REF Attribs) PURE;
+
+
     /// Executes a dispatch compute command.
     
     /// \param [in] Attribs - Dispatch command attributes, see Diligent::DispatchComputeAttribs for details.
@@ -1316,6 +1573,20 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
                                                    ITexture*                                  pSrcTexture,
                                                    ITexture*                                  pDstTexture,
                                                    const ResolveTextureSubresourceAttribs REF ResolveAttribs) PURE;
+
+
+    /// Returns redundant state filtering statistics of the context.
+
+    /// \param [out] Stats - Statistics accumulated since the context was created.
+    ///
+    /// \remarks The context compares every pipeline state, vertex and index buffer,
+    ///          viewport, scissor rect, render target, blend factor and stencil
+    ///          reference value being set with the one currently bound and does not
+    ///          forward the call to the graphics API if they are identical.
+    ///          InvalidateState() resets the cached state, so the first call to
+    ///          every setter after that always counts as applied.
+    VIRTUAL void METHOD(GetStateStats)(THIS_
+                                       DeviceContextStateStats REF Stats) CONST PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -1340,6 +1611,8 @@ DILIGENT_END_INTERFACE
 #    define IDeviceContext_DrawIndexed(This, ...)               CALL_IFACE_METHOD(DeviceContext, DrawIndexed,               This, __VA_ARGS__)
 #    define IDeviceContext_DrawIndirect(This, ...)              CALL_IFACE_METHOD(DeviceContext, DrawIndirect,              This, __VA_ARGS__)
 #    define IDeviceContext_DrawIndexedIndirect(This, ...)       CALL_IFACE_METHOD(DeviceContext, DrawIndexedIndirect,       This, __VA_ARGS__)
+#    define IDeviceContext_MultiDraw(This, ...)                 CALL_IFACE_METHOD(DeviceContext, MultiDraw,                 This, __VA_ARGS__)
+#    define IDeviceContext_MultiDrawIndexed(This, ...)          CALL_IFACE_METHOD(DeviceContext, MultiDrawIndexed,          This, __VA_ARGS__)
 #    define IDeviceContext_DispatchCompute(This, ...)           CALL_IFACE_METHOD(DeviceContext, DispatchCompute,           This, __VA_ARGS__)
 #    define IDeviceContext_DispatchComputeIndirect(This, ...)   CALL_IFACE_METHOD(DeviceContext, DispatchComputeIndirect,   This, __VA_ARGS__)
 #    define IDeviceContext_ClearDepthStencil(This, ...)         CALL_IFACE_METHOD(DeviceContext, ClearDepthStencil,         This, __VA_ARGS__)
@@ -1364,6 +1637,7 @@ DILIGENT_END_INTERFACE
 #    define IDeviceContext_FinishFrame(This)                    CALL_IFACE_METHOD(DeviceContext, FinishFrame,               This)
 #    define IDeviceContext_TransitionResourceStates(This, ...)  CALL_IFACE_METHOD(DeviceContext, TransitionResourceStates,  This, __VA_ARGS__)
 #    define IDeviceContext_ResolveTextureSubresource(This, ...) CALL_IFACE_METHOD(DeviceContext, ResolveTextureSubresource, This, __VA_ARGS__)
+#    define IDeviceContext_GetStateStats(This, ...)             CALL_IFACE_METHOD(DeviceContext, GetStateStats,             This, __VA_ARGS__)
 
 // clang-format on
 
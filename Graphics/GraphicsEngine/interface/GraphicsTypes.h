@@ -914,7 +914,20 @@ DILIGENT_TYPED_ENUM(MISC_TEXTURE_FLAGS, Uint8)
     /// Allow automatic mipmap generation with ITextureView::GenerateMips()
 
     /// \note A texture must be created with BIND_RENDER_TARGET bind flag
-    MISC_TEXTURE_FLAG_GENERATE_MIPS = 0x01
+    MISC_TEXTURE_FLAG_GENERATE_MIPS = 0x01,
+
+    /// The texture is only used within a part of the frame defined by TextureDesc::TransientLifetime,
+    /// and may share device memory with other transient textures whose lifetimes do not overlap.
+
+    /// The contents of a transient texture are undefined at the beginning of its lifetime: when another
+    /// texture that shares its memory is used, the texture is returned to RESOURCE_STATE_UNDEFINED state.
+    /// The aliasing barriers are inserted automatically when a texture transitions out of undefined state.
+    /// \note A transient texture must use USAGE_DEFAULT and can't be initialized with data.
+    ///       The memory owner is resolved when the commands are recorded, so transient textures
+    ///       can only be used by the immediate context.
+    ///       Memory aliasing is currently only implemented in Vulkan backend; other backends
+    ///       allocate separate memory for every transient texture.
+    MISC_TEXTURE_FLAG_TRANSIENT     = 0x02
 };
 DEFINE_FLAG_ENUM_OPERATORS(MISC_TEXTURE_FLAGS)
 
@@ -1328,6 +1341,11 @@ struct EngineGLCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
 
 	/// Native window wrapper
 	NativeWindow Window;
+
+	/// Directory where GLSL sources converted from HLSL are cached between runs.
+	/// If the directory does not exist, it will be created.
+	/// If null, converted sources are only cached in memory.
+	const Char* HLSL2GLSLCacheDirectory DEFAULT_INITIALIZER(nullptr);
 };
 typedef struct EngineGLCreateInfo EngineGLCreateInfo;
 
@@ -1500,6 +1518,22 @@ struct EngineD3D12CreateInfo DILIGENT_DERIVE(EngineCreateInfo)
 typedef struct EngineD3D12CreateInfo EngineD3D12CreateInfo;
 
 
+/// Range of the bindless descriptor heap, see Diligent::IRenderDeviceVk::AllocateBindlessDescriptor().
+DILIGENT_TYPED_ENUM(BINDLESS_DESCRIPTOR_RANGE_VK, Uint32){
+    /// Shader resource texture views. Accessed in shaders through runtime
+    /// arrays of separate images, e.g. Texture2D g_Textures[].
+    BINDLESS_DESCRIPTOR_RANGE_VK_TEXTURES = 0,
+
+    /// Shader resource or unordered access views of structured and raw buffers.
+    /// Accessed through runtime arrays of storage buffers, e.g. StructuredBuffer<T> g_Buffers[].
+    BINDLESS_DESCRIPTOR_RANGE_VK_BUFFERS,
+
+    /// Samplers. Accessed through runtime arrays of separate samplers, e.g. SamplerState g_Samplers[].
+    BINDLESS_DESCRIPTOR_RANGE_VK_SAMPLERS,
+
+    /// The number of ranges
+    BINDLESS_DESCRIPTOR_RANGE_VK_COUNT};
+
 /// Descriptor pool size
 struct VulkanDescriptorPoolSize
 {
@@ -1601,6 +1635,13 @@ struct EngineVkCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     /// pages when resources are released
     Uint32 HostVisibleMemoryReserveSize     DEFAULT_INITIALIZER(256 << 20);
 
+    /// Whether memory pages are suballocated by the two-level segregated fit manager
+    /// (TLSFAllocationsManager) rather than by the tree-based VariableSizeAllocationsManager.
+    /// TLSF manager finds free blocks with a few bit scans and does not allocate memory in
+    /// steady state, but it rounds requests up to size classes and may fail large allocations
+    /// from nearly full pages that the tree-based manager would serve.
+    bool UseTLSFMemoryPageAllocator         DEFAULT_INITIALIZER(false);
+
     /// Page size of the upload heap that is allocated by immediate/deferred
     /// contexts from the global memory manager to perform lock-free dynamic
     /// suballocations.
@@ -1627,6 +1668,69 @@ struct EngineVkCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     }
 #endif
     ;
+
+    /// Directory where SPIR-V byte code compiled from HLSL and GLSL sources is cached
+    /// between runs. If the directory does not exist, it will be created.
+    /// If null, shaders are always compiled and nothing is cached.
+    const Char* SPIRVCacheDirectory         DEFAULT_INITIALIZER(nullptr);
+
+    /// Pipeline cache data previously obtained from IRenderDeviceVk::GetPipelineCacheData()
+    /// that is used to initialize the device pipeline cache. The data is ignored if it was
+    /// produced by a different physical device or driver version.
+    const void* pPipelineCacheData          DEFAULT_INITIALIZER(nullptr);
+
+    /// Size of the pipeline cache data, in bytes.
+    Uint32 PipelineCacheDataSize            DEFAULT_INITIALIZER(0);
+
+    /// The number of descriptors in each range of the bindless descriptor heap
+    /// (see Diligent::BINDLESS_DESCRIPTOR_RANGE_VK): textures, structured buffers and samplers.
+    /// The heap is only created if the device supports VK_EXT_descriptor_indexing.
+    /// If all sizes are zero (the default), the heap is disabled, and descriptor
+    /// indexing is not enabled.
+    Uint32 BindlessDescriptorHeapSize[BINDLESS_DESCRIPTOR_RANGE_VK_COUNT]
+#if DILIGENT_CPP_INTERFACE
+    {
+        0, // BINDLESS_DESCRIPTOR_RANGE_VK_TEXTURES
+        0, // BINDLESS_DESCRIPTOR_RANGE_VK_BUFFERS
+        0  // BINDLESS_DESCRIPTOR_RANGE_VK_SAMPLERS
+    }
+#endif
+    ;
+
+    /// Size of the staging buffer used to batch initialization of buffers and textures.
+    /// If non-zero, initial data of new resources is written to this buffer, and the copy
+    /// commands are recorded into a single transfer command buffer that is submitted when
+    /// ResourceUploadBatchFlushSize bytes are pending, when IRenderDeviceVk::FlushResourceUploads()
+    /// is called, or before the immediate context submits its commands. Resources whose data
+    /// does not fit into the buffer are initialized individually.
+    /// If zero, every resource is initialized by a separate submission.
+    Uint32 ResourceUploadBatchStagingSize   DEFAULT_INITIALIZER(0);
+
+    /// The amount of pending initial data, in bytes, after which the batch is submitted.
+    Uint32 ResourceUploadBatchFlushSize     DEFAULT_INITIALIZER(16 << 20);
+
+    /// Maximum size of a buffer, in bytes, that is suballocated from a shared Vulkan buffer.
+    /// If non-zero, USAGE_DEFAULT and USAGE_STATIC buffers that are not larger than this size
+    /// and have no BIND_UNORDERED_ACCESS flag are placed into large Vulkan buffers shared with
+    /// other buffers created with the same bind flags. IBufferVk::GetVkBuffer() then returns
+    /// the shared buffer, and IBufferVk::GetVkBufferOffset() returns the offset of the buffer
+    /// data in it.
+    /// If zero, every buffer is created as a separate Vulkan buffer.
+    Uint32 BufferSuballocationMaxSize       DEFAULT_INITIALIZER(0);
+
+    /// Size of a shared Vulkan buffer that small buffers are suballocated from.
+    /// When all buffers in a shared buffer are released, it is kept for reuse
+    /// if there is no other empty shared buffer with the same bind flags.
+    Uint32 BufferSuballocationBlockSize     DEFAULT_INITIALIZER(4 << 20);
+
+    /// Size of a device memory heap that transient textures (see MISC_TEXTURE_FLAG_TRANSIENT) are
+    /// placed into. Textures that are larger than this size are placed into heaps of their own size.
+    Uint32 TransientTextureHeapSize         DEFAULT_INITIALIZER(64 << 20);
+
+    /// Whether to write dynamic descriptor sets with descriptor update templates if the device
+    /// supports VK_KHR_descriptor_update_template extension. If false, or if the extension is not
+    /// supported, descriptors are written with vkUpdateDescriptorSets().
+    bool EnableDescriptorUpdateTemplates    DEFAULT_INITIALIZER(true);
 };
 typedef struct EngineVkCreateInfo EngineVkCreateInfo;
 
@@ -343,6 +343,19 @@ DILIGENT_BEGIN_INTERFACE(IPipelineState, IDeviceObject)
                                                                      const Char* Name) PURE;
 
 
+    /// Returns static shader resource variable using the name with the precomputed hash.
+    /// If the variable is not found, returns nullptr.
+
+    /// \param [in] ShaderType - Type of the shader to look up the variable.
+    ///                          Must be one of Diligent::SHADER_TYPE.
+    /// \param [in] Name - Name of the variable with the precomputed hash.
+    /// \remark The method does not increment the reference counter
+    ///         of the returned interface.
+    VIRTUAL IShaderResourceVariable* METHOD(GetStaticVariableByHashedName)(THIS_
+                                                                           SHADER_TYPE                         ShaderType,
+                                                                           const HashedShaderVariableName REF Name) PURE;
+
+
     /// Returns static shader resource variable by its index.
 
     /// \param [in] ShaderType - Type of the shader to look up the variable. 
@@ -397,12 +410,13 @@ DILIGENT_END_INTERFACE
 
 #    define IPipelineState_GetDesc(This) (const struct PipelineStateDesc*)IDeviceObject_GetDesc(This)
 
-#    define IPipelineState_BindStaticResources(This, ...)         CALL_IFACE_METHOD(PipelineState, BindStaticResources,         This, __VA_ARGS__)
-#    define IPipelineState_GetStaticVariableCount(This, ...)      CALL_IFACE_METHOD(PipelineState, GetStaticVariableCount,      This, __VA_ARGS__)
-#    define IPipelineState_GetStaticVariableByName(This, ...)     CALL_IFACE_METHOD(PipelineState, GetStaticVariableByName,     This, __VA_ARGS__)
-#    define IPipelineState_GetStaticVariableByIndex(This, ...)    CALL_IFACE_METHOD(PipelineState, GetStaticVariableByIndex,    This, __VA_ARGS__)
-#    define IPipelineState_CreateShaderResourceBinding(This, ...) CALL_IFACE_METHOD(PipelineState, CreateShaderResourceBinding, This, __VA_ARGS__)
-#    define IPipelineState_IsCompatibleWith(This, ...)            CALL_IFACE_METHOD(PipelineState, IsCompatibleWith,            This, __VA_ARGS__)
+#    define IPipelineState_BindStaticResources(This, ...)           CALL_IFACE_METHOD(PipelineState, BindStaticResources,           This, __VA_ARGS__)
+#    define IPipelineState_GetStaticVariableCount(This, ...)        CALL_IFACE_METHOD(PipelineState, GetStaticVariableCount,        This, __VA_ARGS__)
+#    define IPipelineState_GetStaticVariableByName(This, ...)       CALL_IFACE_METHOD(PipelineState, GetStaticVariableByName,       This, __VA_ARGS__)
+#    define IPipelineState_GetStaticVariableByHashedName(This, ...) CALL_IFACE_METHOD(PipelineState, GetStaticVariableByHashedName, This, __VA_ARGS__)
+#    define IPipelineState_GetStaticVariableByIndex(This, ...)      CALL_IFACE_METHOD(PipelineState, GetStaticVariableByIndex,      This, __VA_ARGS__)
+#    define IPipelineState_CreateShaderResourceBinding(This, ...)   CALL_IFACE_METHOD(PipelineState, CreateShaderResourceBinding,   This, __VA_ARGS__)
+#    define IPipelineState_IsCompatibleWith(This, ...)              CALL_IFACE_METHOD(PipelineState, IsCompatibleWith,              This, __VA_ARGS__)
 
 // clang-format on
 
@@ -85,6 +85,19 @@ DILIGENT_BEGIN_INTERFACE(IShaderResourceBinding, IObject)
                                                                SHADER_TYPE ShaderType,
                                                                const char* Name) PURE;
 
+    /// Returns variable using the name with the precomputed hash
+
+    /// \param [in] ShaderType - Type of the shader to look up the variable.
+    ///                          Must be one of Diligent::SHADER_TYPE.
+    /// \param [in] Name       - Variable name with the precomputed hash.
+    ///
+    /// \note  This method works the same way as IShaderResourceBinding::GetVariableByName, but
+    ///        avoids hashing the variable name. An application may cache the hashed name and
+    ///        reuse it to look up the same variable in multiple shader resource binding objects.
+    VIRTUAL IShaderResourceVariable* METHOD(GetVariableByHashedName)(THIS_
+                                                                     SHADER_TYPE                         ShaderType,
+                                                                     const HashedShaderVariableName REF Name) PURE;
+
     /// Returns the total variable count for the specific shader stage.
 
     /// \param [in] ShaderType - Type of the shader.
@@ -140,6 +153,7 @@ DILIGENT_END_INTERFACE
 #    define IShaderResourceBinding_GetPipelineState(This)               CALL_IFACE_METHOD(ShaderResourceBinding, GetPipelineState,          This)
 #    define IShaderResourceBinding_BindResources(This, ...)             CALL_IFACE_METHOD(ShaderResourceBinding, BindResources,             This, __VA_ARGS__)
 #    define IShaderResourceBinding_GetVariableByName(This, ...)         CALL_IFACE_METHOD(ShaderResourceBinding, GetVariableByName,         This, __VA_ARGS__)
+#    define IShaderResourceBinding_GetVariableByHashedName(This, ...)   CALL_IFACE_METHOD(ShaderResourceBinding, GetVariableByHashedName,   This, __VA_ARGS__)
 #    define IShaderResourceBinding_GetVariableCount(This, ...)          CALL_IFACE_METHOD(ShaderResourceBinding, GetVariableCount,          This, __VA_ARGS__)
 #    define IShaderResourceBinding_GetVariableByIndex(This, ...)        CALL_IFACE_METHOD(ShaderResourceBinding, GetVariableByIndex,        This, __VA_ARGS__)
 #    define IShaderResourceBinding_InitializeStaticResources(This, ...) CALL_IFACE_METHOD(ShaderResourceBinding, InitializeStaticResources, This, __VA_ARGS__)
@@ -104,6 +104,51 @@ DILIGENT_TYPED_ENUM(BIND_SHADER_RESOURCES_FLAGS, Uint32)
 
 // clang-format on
 
+#if DILIGENT_CPP_INTERFACE
+/// Computes the hash of the shader variable name that is used by Diligent::HashedShaderVariableName.
+
+/// The hash is the 32-bit FNV-1a hash of the name characters, not including the null terminator.
+inline Uint32 ComputeShaderVariableNameHash(const Char* Name) noexcept
+{
+    Uint32 Hash = 2166136261u;
+    if (Name != nullptr)
+    {
+        for (; *Name != 0; ++Name)
+        {
+            Hash ^= static_cast<Uint8>(*Name);
+            Hash *= 16777619u;
+        }
+    }
+    return Hash;
+}
+#endif
+
+/// Shader variable name with the precomputed hash.
+
+/// An application may create the name once and reuse it to look up the variable
+/// in multiple pipeline states or shader resource bindings without hashing the name again,
+/// see IShaderResourceBinding::GetVariableByHashedName and IPipelineState::GetStaticVariableByHashedName.
+struct HashedShaderVariableName
+{
+    /// Variable name. The string must remain valid while the struct is in use.
+    const Char* Name DEFAULT_INITIALIZER(nullptr);
+
+    /// The hash of the name. In C++, the hash is computed by the constructor.
+    /// C applications must compute the 32-bit FNV-1a hash of the name characters.
+    Uint32 Hash DEFAULT_INITIALIZER(0);
+
+#if DILIGENT_CPP_INTERFACE
+    HashedShaderVariableName() noexcept
+    {}
+
+    explicit HashedShaderVariableName(const Char* _Name) noexcept :
+        Name{_Name},
+        Hash{ComputeShaderVariableNameHash(_Name)}
+    {}
+#endif
+};
+typedef struct HashedShaderVariableName HashedShaderVariableName;
+
 #define DILIGENT_INTERFACE_NAME IShaderResourceVariable
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
@@ -89,6 +89,44 @@ struct OptimizedClearValue
 };
 typedef struct OptimizedClearValue OptimizedClearValue;
 
+/// Defines the range of frame passes that use a transient texture.
+
+/// Passes are numbered in the order they are executed within a frame (e.g. by a frame graph).
+/// Transient textures whose pass ranges do not overlap may share device memory,
+/// see Diligent::MISC_TEXTURE_FLAG_TRANSIENT.
+struct TransientTextureLifetime
+{
+    /// Index of the first pass that uses the texture
+    Uint32 FirstPass    DEFAULT_INITIALIZER(0);
+
+    /// Index of the last pass that uses the texture.
+    /// By default, the texture is used throughout the frame and never shares memory.
+    Uint32 LastPass     DEFAULT_INITIALIZER(0xFFFFFFFFu);
+
+#if DILIGENT_CPP_INTERFACE
+    TransientTextureLifetime()noexcept{}
+
+    TransientTextureLifetime(Uint32 _FirstPass,
+                             Uint32 _LastPass)noexcept : 
+        FirstPass {_FirstPass},
+        LastPass  {_LastPass }
+    {}
+
+    /// Tests if the texture is used in any of the passes that use the other texture
+    bool Overlaps(const TransientTextureLifetime& rhs)const
+    {
+        return FirstPass <= rhs.LastPass && rhs.FirstPass <= LastPass;
+    }
+
+    bool operator == (const TransientTextureLifetime& rhs)const
+    {
+        return FirstPass == rhs.FirstPass &&
+               LastPass  == rhs.LastPass;
+    }
+#endif
+};
+typedef struct TransientTextureLifetime TransientTextureLifetime;
+
 /// Texture description
 struct TextureDesc DILIGENT_DERIVE(DeviceObjectAttribs)
 
@@ -144,6 +182,10 @@ struct TextureDesc DILIGENT_DERIVE(DeviceObjectAttribs)
     /// Defines which command queues this texture can be used with
     Uint64 CommandQueueMask              DEFAULT_INITIALIZER(1);
 
+    /// Passes of the frame that use the texture. Only used by the textures
+    /// created with Diligent::MISC_TEXTURE_FLAG_TRANSIENT flag.
+    TransientTextureLifetime TransientLifetime;
+
 
 #if DILIGENT_CPP_INTERFACE
     TextureDesc()noexcept{}
@@ -201,7 +243,8 @@ struct TextureDesc DILIGENT_DERIVE(DeviceObjectAttribs)
                 CPUAccessFlags   == RHS.CPUAccessFlags &&
                 MiscFlags        == RHS.MiscFlags      &&
                 ClearValue       == RHS.ClearValue     &&
-                CommandQueueMask == RHS.CommandQueueMask;
+                CommandQueueMask == RHS.CommandQueueMask &&
+                TransientLifetime == RHS.TransientLifetime;
     }
 #endif
 };
@@ -128,6 +128,15 @@ void ValidateTextureDesc(const TextureDesc& Desc)
         if ((Desc.CPUAccessFlags & (CPU_ACCESS_READ | CPU_ACCESS_WRITE)) == (CPU_ACCESS_READ | CPU_ACCESS_WRITE))
             LOG_TEXTURE_ERROR_AND_THROW("Staging textures must use exactly one of ACESS_READ or ACCESS_WRITE flags");
     }
+
+    if (Desc.MiscFlags & MISC_TEXTURE_FLAG_TRANSIENT)
+    {
+        if (Desc.Usage != USAGE_DEFAULT)
+            LOG_TEXTURE_ERROR_AND_THROW("Transient textures must use USAGE_DEFAULT");
+
+        if (Desc.TransientLifetime.FirstPass > Desc.TransientLifetime.LastPass)
+            LOG_TEXTURE_ERROR_AND_THROW("The first pass (", Desc.TransientLifetime.FirstPass, ") of the transient texture lifetime must not be greater than the last pass (", Desc.TransientLifetime.LastPass, ")");
+    }
 }
 
 
@@ -70,9 +70,13 @@ IMPLEMENT_QUERY_INTERFACE(DeviceContextD3D11Impl, IID_DeviceContextD3D11, TDevic
 void DeviceContextD3D11Impl::SetPipelineState(IPipelineState* pPipelineState)
 {
     auto* pPipelineStateD3D11 = ValidatedCast<PipelineStateD3D11Impl>(pPipelineState);
-    if (PipelineStateD3D11Impl::IsSameObject(m_pPipelineState, pPipelineStateD3D11))
+    if (IsPipelineStateBound(pPipelineStateD3D11))
         return;
 
+    // Vertex buffer strides are defined by the pipeline state
+    if (VertexBufferStridesDiffer(pPipelineStateD3D11))
+        m_bCommittedD3D11VBsUpToDate = false;
+
     TDeviceContextBase::SetPipelineState(pPipelineStateD3D11, 0 /*Dummy*/);
     auto& Desc = pPipelineStateD3D11->GetDesc();
     if (Desc.IsComputePipeline)
@@ -870,6 +874,40 @@ void DeviceContextD3D11Impl::DrawIndexedIndirect(const DrawIndexedIndirectAttrib
     m_pd3d11DeviceContext->DrawIndexedInstancedIndirect(pd3d11ArgsBuff, Attribs.IndirectDrawArgsOffset);
 }
 
+void DeviceContextD3D11Impl::MultiDraw(const MultiDrawAttribs& Attribs)
+{
+    if (!DvpVerifyMultiDrawArguments(Attribs) || Attribs.DrawCount == 0)
+        return;
+
+    PrepareForDraw(Attribs.Flags);
+
+    for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+    {
+        const auto& Item = Attribs.pDrawItems[i];
+        if (Item.NumInstances > 1 || Item.FirstInstanceLocation != 0)
+            m_pd3d11DeviceContext->DrawInstanced(Item.NumVertices, Item.NumInstances, Item.StartVertexLocation, Item.FirstInstanceLocation);
+        else
+            m_pd3d11DeviceContext->Draw(Item.NumVertices, Item.StartVertexLocation);
+    }
+}
+
+void DeviceContextD3D11Impl::MultiDrawIndexed(const MultiDrawIndexedAttribs& Attribs)
+{
+    if (!DvpVerifyMultiDrawIndexedArguments(Attribs) || Attribs.DrawCount == 0)
+        return;
+
+    PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
+
+    for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+    {
+        const auto& Item = Attribs.pDrawItems[i];
+        if (Item.NumInstances > 1 || Item.FirstInstanceLocation != 0)
+            m_pd3d11DeviceContext->DrawIndexedInstanced(Item.NumIndices, Item.NumInstances, Item.FirstIndexLocation, Item.BaseVertex, Item.FirstInstanceLocation);
+        else
+            m_pd3d11DeviceContext->DrawIndexed(Item.NumIndices, Item.FirstIndexLocation, Item.BaseVertex);
+    }
+}
+
 void DeviceContextD3D11Impl::DispatchCompute(const DispatchComputeAttribs& Attribs)
 {
     if (!DvpVerifyDispatchArguments(Attribs))
@@ -1166,7 +1204,9 @@ void DeviceContextD3D11Impl::SetVertexBuffers(Uint32                         Sta
                                               RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
                                               SET_VERTEX_BUFFERS_FLAGS       Flags)
 {
-    TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
+    // Buffer states must be checked even if the buffers are not changed as
+    // they may have been used in a different state since the last call
+    const auto StreamsChanged = TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, Flags, 0 /*Dummy*/);
     for (Uint32 Slot = 0; Slot < m_NumVertexStreams; ++Slot)
     {
         auto& CurrStream = m_VertexStreams[Slot];
@@ -1193,12 +1233,13 @@ void DeviceContextD3D11Impl::SetVertexBuffers(Uint32                         Sta
         }
     }
 
-    m_bCommittedD3D11VBsUpToDate = false;
+    if (StreamsChanged)
+        m_bCommittedD3D11VBsUpToDate = false;
 }
 
 void DeviceContextD3D11Impl::SetIndexBuffer(IBuffer* pIndexBuffer, Uint32 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
-    TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
+    const auto IBChanged = TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, 0 /*Dummy*/);
 
     if (m_pIndexBuffer)
     {
@@ -1222,13 +1263,15 @@ void DeviceContextD3D11Impl::SetIndexBuffer(IBuffer* pIndexBuffer, Uint32 ByteOf
 #endif
     }
 
-    m_bCommittedD3D11IBUpToDate = false;
+    if (IBChanged)
+        m_bCommittedD3D11IBUpToDate = false;
 }
 
 void DeviceContextD3D11Impl::SetViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32 RTWidth, Uint32 RTHeight)
 {
     static_assert(MAX_VIEWPORTS >= D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE, "MaxViewports constant must be greater than D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE");
-    TDeviceContextBase::SetViewports(NumViewports, pViewports, RTWidth, RTHeight);
+    if (!TDeviceContextBase::SetViewports(NumViewports, pViewports, RTWidth, RTHeight))
+        return;
 
     D3D11_VIEWPORT d3d11Viewports[MAX_VIEWPORTS];
     VERIFY(NumViewports == m_NumViewports, "Unexpected number of viewports");
@@ -1249,7 +1292,8 @@ void DeviceContextD3D11Impl::SetViewports(Uint32 NumViewports, const Viewport* p
 void DeviceContextD3D11Impl::SetScissorRects(Uint32 NumRects, const Rect* pRects, Uint32 RTWidth, Uint32 RTHeight)
 {
     static_assert(MAX_VIEWPORTS >= D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE, "MaxViewports constant must be greater than D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE");
-    TDeviceContextBase::SetScissorRects(NumRects, pRects, RTWidth, RTHeight);
+    if (!TDeviceContextBase::SetScissorRects(NumRects, pRects, RTWidth, RTHeight))
+        return;
 
     D3D11_RECT d3d11ScissorRects[MAX_VIEWPORTS];
     VERIFY(NumRects == m_NumScissorRects, "Unexpected number of scissor rects");
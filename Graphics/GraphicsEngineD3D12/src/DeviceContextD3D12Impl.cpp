@@ -175,7 +175,7 @@ IMPLEMENT_QUERY_INTERFACE(DeviceContextD3D12Impl, IID_DeviceContextD3D12, TDevic
 void DeviceContextD3D12Impl::SetPipelineState(IPipelineState* pPipelineState)
 {
     auto* pPipelineStateD3D12 = ValidatedCast<PipelineStateD3D12Impl>(pPipelineState);
-    if (PipelineStateD3D12Impl::IsSameObject(m_pPipelineState, pPipelineStateD3D12))
+    if (IsPipelineStateBound(pPipelineStateD3D12))
         return;
 
     // Never flush deferred context!
@@ -209,6 +209,10 @@ void DeviceContextD3D12Impl::SetPipelineState(IPipelineState* pPipelineState)
         CommitScissor = OldPSODesc.GraphicsPipeline.RasterizerDesc.ScissorEnable != PSODesc.GraphicsPipeline.RasterizerDesc.ScissorEnable;
     }
 
+    // Vertex buffer strides are defined by the pipeline state
+    if (VertexBufferStridesDiffer(pPipelineStateD3D12))
+        m_State.bCommittedD3D12VBsUpToDate = false;
+
     TDeviceContextBase::SetPipelineState(pPipelineStateD3D12, 0 /*Dummy*/);
 
     auto& CmdCtx = GetCmdContext();
@@ -541,6 +545,36 @@ void DeviceContextD3D12Impl::DrawIndexedIndirect(const DrawIndexedIndirectAttrib
     ++m_State.NumCommands;
 }
 
+void DeviceContextD3D12Impl::MultiDraw(const MultiDrawAttribs& Attribs)
+{
+    if (!DvpVerifyMultiDrawArguments(Attribs) || Attribs.DrawCount == 0)
+        return;
+
+    auto& GraphCtx = GetCmdContext().AsGraphicsContext();
+    PrepareForDraw(GraphCtx, Attribs.Flags);
+    for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+    {
+        const auto& Item = Attribs.pDrawItems[i];
+        GraphCtx.Draw(Item.NumVertices, Item.NumInstances, Item.StartVertexLocation, Item.FirstInstanceLocation);
+    }
+    m_State.NumCommands += Attribs.DrawCount;
+}
+
+void DeviceContextD3D12Impl::MultiDrawIndexed(const MultiDrawIndexedAttribs& Attribs)
+{
+    if (!DvpVerifyMultiDrawIndexedArguments(Attribs) || Attribs.DrawCount == 0)
+        return;
+
+    auto& GraphCtx = GetCmdContext().AsGraphicsContext();
+    PrepareForIndexedDraw(GraphCtx, Attribs.Flags, Attribs.IndexType);
+    for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+    {
+        const auto& Item = Attribs.pDrawItems[i];
+        GraphCtx.DrawIndexed(Item.NumIndices, Item.NumInstances, Item.FirstIndexLocation, Item.BaseVertex, Item.FirstInstanceLocation);
+    }
+    m_State.NumCommands += Attribs.DrawCount;
+}
+
 void DeviceContextD3D12Impl::PrepareForDispatchCompute(ComputeContext& ComputeCtx)
 {
     ComputeCtx.SetRootSignature(m_pPipelineState->GetD3D12RootSignature());
@@ -768,7 +802,9 @@ void DeviceContextD3D12Impl::SetVertexBuffers(Uint32                         Sta
                                               RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
                                               SET_VERTEX_BUFFERS_FLAGS       Flags)
 {
-    TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
+    // Buffer states must be checked even if the buffers are not changed as
+    // they may have been used in a different state since the last call
+    const auto StreamsChanged = TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, Flags, 0 /*Dummy*/);
 
     auto& CmdCtx = GetCmdContext();
     for (Uint32 Buff = 0; Buff < m_NumVertexStreams; ++Buff)
@@ -778,7 +814,8 @@ void DeviceContextD3D12Impl::SetVertexBuffers(Uint32                         Sta
             TransitionOrVerifyBufferState(CmdCtx, *pBufferD3D12, StateTransitionMode, RESOURCE_STATE_VERTEX_BUFFER, "Setting vertex buffers (DeviceContextD3D12Impl::SetVertexBuffers)");
     }
 
-    m_State.bCommittedD3D12VBsUpToDate = false;
+    if (StreamsChanged)
+        m_State.bCommittedD3D12VBsUpToDate = false;
 }
 
 void DeviceContextD3D12Impl::InvalidateState()
@@ -792,13 +829,14 @@ void DeviceContextD3D12Impl::InvalidateState()
 
 void DeviceContextD3D12Impl::SetIndexBuffer(IBuffer* pIndexBuffer, Uint32 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
-    TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
+    const auto IBChanged = TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, 0 /*Dummy*/);
     if (m_pIndexBuffer)
     {
         auto& CmdCtx = GetCmdContext();
         TransitionOrVerifyBufferState(CmdCtx, *m_pIndexBuffer, StateTransitionMode, RESOURCE_STATE_INDEX_BUFFER, "Setting index buffer (DeviceContextD3D12Impl::SetIndexBuffer)");
     }
-    m_State.bCommittedD3D12IBUpToDate = false;
+    if (IBChanged)
+        m_State.bCommittedD3D12IBUpToDate = false;
 }
 
 void DeviceContextD3D12Impl::CommitViewports()
@@ -823,7 +861,10 @@ void DeviceContextD3D12Impl::CommitViewports()
 void DeviceContextD3D12Impl::SetViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32 RTWidth, Uint32 RTHeight)
 {
     static_assert(MAX_VIEWPORTS >= D3D12_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE, "MaxViewports constant must be greater than D3D12_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE");
-    TDeviceContextBase::SetViewports(NumViewports, pViewports, RTWidth, RTHeight);
+    // When a new command list is started, m_pPipelineState is null and
+    // the viewports are committed by SetPipelineState().
+    if (!TDeviceContextBase::SetViewports(NumViewports, pViewports, RTWidth, RTHeight))
+        return;
     VERIFY(NumViewports == m_NumViewports, "Unexpected number of viewports");
 
     CommitViewports();
@@ -886,7 +927,8 @@ void DeviceContextD3D12Impl::SetScissorRects(Uint32 NumRects, const Rect* pRects
     VERIFY(NumRects < MaxScissorRects, "Too many scissor rects are being set");
     NumRects = std::min(NumRects, MaxScissorRects);
 
-    TDeviceContextBase::SetScissorRects(NumRects, pRects, RTWidth, RTHeight);
+    if (!TDeviceContextBase::SetScissorRects(NumRects, pRects, RTWidth, RTHeight))
+        return;
 
     // Only commit scissor rects if scissor test is enabled in the rasterizer state.
     // If scissor is currently disabled, or no PSO is bound, scissor rects will be committed by
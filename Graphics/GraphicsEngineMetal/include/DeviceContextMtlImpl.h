@@ -96,6 +96,8 @@ public:
     virtual void DrawIndexed(const DrawIndexedAttribs& Attribs) override final;
     virtual void DrawIndirect(const DrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer) override final;
     virtual void DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer) override final;
+    virtual void MultiDraw(const MultiDrawAttribs& Attribs) override final;
+    virtual void MultiDrawIndexed(const MultiDrawIndexedAttribs& Attribs) override final;
 
     virtual void DispatchCompute(const DispatchComputeAttribs& Attribs) override final;
     virtual void DispatchComputeIndirect(const DispatchComputeIndirectAttribs& Attribs, IBuffer* pAttribsBuffer) override final;
@@ -138,6 +138,22 @@ namespace Diligent
         LOG_ERROR_MESSAGE("DeviceContextMtlImpl::DrawIndexedIndirect() is not implemented");
     }
 
+    void DeviceContextMtlImpl::MultiDraw(const MultiDrawAttribs& Attribs)
+    {
+        if (!DvpVerifyMultiDrawArguments(Attribs))
+            return;
+
+        LOG_ERROR_MESSAGE("DeviceContextMtlImpl::MultiDraw() is not implemented");
+    }
+
+    void DeviceContextMtlImpl::MultiDrawIndexed(const MultiDrawIndexedAttribs& Attribs)
+    {
+        if (!DvpVerifyMultiDrawIndexedArguments(Attribs))
+            return;
+
+        LOG_ERROR_MESSAGE("DeviceContextMtlImpl::MultiDrawIndexed() is not implemented");
+    }
+
     void DeviceContextMtlImpl::DispatchCompute(const DispatchComputeAttribs& Attribs)
     {
         if (!DvpVerifyDispatchArguments(Attribs))
@@ -321,7 +337,7 @@ namespace Diligent
                                                  RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
                                                  SET_VERTEX_BUFFERS_FLAGS       Flags )
     {
-        TDeviceContextBase::SetVertexBuffers( StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags );
+        TDeviceContextBase::SetVertexBuffers( StartSlot, NumBuffersSet, ppBuffers, pOffsets, Flags, 0 /*Dummy*/ );
 
         LOG_ERROR_MESSAGE("DeviceContextMtlImpl::SetVertexBuffers() is not implemented");
         for (Uint32 Slot = 0; Slot < m_NumVertexStreams; ++Slot)
@@ -336,7 +352,7 @@ namespace Diligent
 
     void DeviceContextMtlImpl::SetIndexBuffer( IBuffer* pIndexBuffer, Uint32 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode )
     {
-        TDeviceContextBase::SetIndexBuffer( pIndexBuffer, ByteOffset, StateTransitionMode );
+        TDeviceContextBase::SetIndexBuffer( pIndexBuffer, ByteOffset, 0 /*Dummy*/ );
 
         LOG_ERROR_MESSAGE("DeviceContextMtlImpl::SetIndexBuffer() is not implemented");
         if (m_pIndexBuffer)
@@ -34,6 +34,7 @@
 #include "BaseInterfacesGL.h"
 #include "FBOCache.hpp"
 #include "TexRegionRender.hpp"
+#include "HLSL2GLSLConversionCache.hpp"
 
 enum class GPU_VENDOR
 {
@@ -150,6 +151,8 @@ public:
 
     void InitTexRegionRender();
 
+    HLSL2GLSLConversionCache* GetHLSL2GLSLConversionCache() { return m_pHLSL2GLSLConversionCache.get(); }
+
 protected:
     friend class DeviceContextGLImpl;
     friend class TextureBaseGL;
@@ -175,6 +178,8 @@ protected:
 
     std::unique_ptr<TexRegionRender> m_pTexRegionRender;
 
+    std::unique_ptr<HLSL2GLSLConversionCache> m_pHLSL2GLSLConversionCache;
+
 private:
     virtual void TestTextureFormat(TEXTURE_FORMAT TexFormat) override final;
     bool         CheckExtension(const Char* ExtensionString);
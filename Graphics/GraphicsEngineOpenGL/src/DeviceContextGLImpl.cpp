@@ -78,7 +78,7 @@ IMPLEMENT_QUERY_INTERFACE(DeviceContextGLImpl, IID_DeviceContextGL, TDeviceConte
 void DeviceContextGLImpl::SetPipelineState(IPipelineState* pPipelineState)
 {
     auto* pPipelineStateGLImpl = ValidatedCast<PipelineStateGLImpl>(pPipelineState);
-    if (PipelineStateGLImpl::IsSameObject(m_pPipelineState, pPipelineStateGLImpl))
+    if (IsPipelineStateBound(pPipelineStateGLImpl))
         return;
 
     TDeviceContextBase::SetPipelineState(pPipelineStateGLImpl, 0 /*Dummy*/);
@@ -187,8 +187,8 @@ void DeviceContextGLImpl::SetVertexBuffers(Uint32                         StartS
                                            RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
                                            SET_VERTEX_BUFFERS_FLAGS       Flags)
 {
-    TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
-    m_ContextState.InvalidateVAO();
+    if (TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, Flags, 0 /*Dummy*/))
+        m_ContextState.InvalidateVAO();
 }
 
 void DeviceContextGLImpl::InvalidateState()
@@ -203,13 +203,14 @@ void DeviceContextGLImpl::InvalidateState()
 
 void DeviceContextGLImpl::SetIndexBuffer(IBuffer* pIndexBuffer, Uint32 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
-    TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
-    m_ContextState.InvalidateVAO();
+    if (TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, 0 /*Dummy*/))
+        m_ContextState.InvalidateVAO();
 }
 
 void DeviceContextGLImpl::SetViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32 RTWidth, Uint32 RTHeight)
 {
-    TDeviceContextBase::SetViewports(NumViewports, pViewports, RTWidth, RTHeight);
+    if (!TDeviceContextBase::SetViewports(NumViewports, pViewports, RTWidth, RTHeight))
+        return;
 
     VERIFY(NumViewports == m_NumViewports, "Unexpected number of viewports");
     if (NumViewports == 1)
@@ -272,7 +273,8 @@ void DeviceContextGLImpl::SetViewports(Uint32 NumViewports, const Viewport* pVie
 
 void DeviceContextGLImpl::SetScissorRects(Uint32 NumRects, const Rect* pRects, Uint32 RTWidth, Uint32 RTHeight)
 {
-    TDeviceContextBase::SetScissorRects(NumRects, pRects, RTWidth, RTHeight);
+    if (!TDeviceContextBase::SetScissorRects(NumRects, pRects, RTWidth, RTHeight))
+        return;
 
     VERIFY(NumRects == m_NumScissorRects, "Unexpected number of scissor rects");
     if (NumRects == 1)
@@ -719,25 +721,64 @@ void DeviceContextGLImpl::PostDraw()
     m_CommitedResourcesTentativeBarriers = 0;
 }
 
-void DeviceContextGLImpl::Draw(const DrawAttribs& Attribs)
+void DeviceContextGLImpl::DrawArrays(GLenum GlTopology, Uint32 NumVertices, Uint32 NumInstances, Uint32 StartVertexLocation, Uint32 FirstInstanceLocation)
 {
-    if (!DvpVerifyDrawArguments(Attribs))
-        return;
+    if (NumInstances > 1 || FirstInstanceLocation != 0)
+    {
+        if (FirstInstanceLocation != 0)
+            glDrawArraysInstancedBaseInstance(GlTopology, StartVertexLocation, NumVertices, NumInstances, FirstInstanceLocation);
+        else
+            glDrawArraysInstanced(GlTopology, StartVertexLocation, NumVertices, NumInstances);
+    }
+    else
+    {
+        glDrawArrays(GlTopology, StartVertexLocation, NumVertices);
+    }
+}
 
-    GLenum GlTopology;
-    PrepareForDraw(Attribs.Flags, false, GlTopology);
+void DeviceContextGLImpl::DrawElements(GLenum GlTopology, GLenum GLIndexType, Uint32 FirstIndexByteOffset, Uint32 NumIndices, Uint32 NumInstances, Uint32 BaseVertex, Uint32 FirstInstanceLocation)
+{
+    // NOTE: Base Vertex and Base Instance versions are not supported even in OpenGL ES 3.1
+    // This functionality can be emulated by adjusting stream offsets. This, however may cause
+    // errors in case instance data is read from the same stream as vertex data. Thus handling
+    // such cases is left to the application
 
-    if (Attribs.NumInstances > 1 || Attribs.FirstInstanceLocation != 0)
+    auto* pIndices = reinterpret_cast<GLvoid*>(static_cast<size_t>(FirstIndexByteOffset));
+    if (NumInstances > 1 || FirstInstanceLocation != 0)
     {
-        if (Attribs.FirstInstanceLocation != 0)
-            glDrawArraysInstancedBaseInstance(GlTopology, Attribs.StartVertexLocation, Attribs.NumVertices, Attribs.NumInstances, Attribs.FirstInstanceLocation);
+        if (BaseVertex > 0)
+        {
+            if (FirstInstanceLocation != 0)
+                glDrawElementsInstancedBaseVertexBaseInstance(GlTopology, NumIndices, GLIndexType, pIndices, NumInstances, BaseVertex, FirstInstanceLocation);
+            else
+                glDrawElementsInstancedBaseVertex(GlTopology, NumIndices, GLIndexType, pIndices, NumInstances, BaseVertex);
+        }
         else
-            glDrawArraysInstanced(GlTopology, Attribs.StartVertexLocation, Attribs.NumVertices, Attribs.NumInstances);
+        {
+            if (FirstInstanceLocation != 0)
+                glDrawElementsInstancedBaseInstance(GlTopology, NumIndices, GLIndexType, pIndices, NumInstances, FirstInstanceLocation);
+            else
+                glDrawElementsInstanced(GlTopology, NumIndices, GLIndexType, pIndices, NumInstances);
+        }
     }
     else
     {
-        glDrawArrays(GlTopology, Attribs.StartVertexLocation, Attribs.NumVertices);
+        if (BaseVertex > 0)
+            glDrawElementsBaseVertex(GlTopology, NumIndices, GLIndexType, pIndices, BaseVertex);
+        else
+            glDrawElements(GlTopology, NumIndices, GLIndexType, pIndices);
     }
+}
+
+void DeviceContextGLImpl::Draw(const DrawAttribs& Attribs)
+{
+    if (!DvpVerifyDrawArguments(Attribs))
+        return;
+
+    GLenum GlTopology;
+    PrepareForDraw(Attribs.Flags, false, GlTopology);
+
+    DrawArrays(GlTopology, Attribs.NumVertices, Attribs.NumInstances, Attribs.StartVertexLocation, Attribs.FirstInstanceLocation);
     DEV_CHECK_GL_ERROR("OpenGL draw command failed");
 
     PostDraw();
@@ -754,36 +795,49 @@ void DeviceContextGLImpl::DrawIndexed(const DrawIndexedAttribs& Attribs)
     Uint32 FirstIndexByteOffset;
     PrepareForIndexedDraw(Attribs.IndexType, Attribs.FirstIndexLocation, GLIndexType, FirstIndexByteOffset);
 
-    // NOTE: Base Vertex and Base Instance versions are not supported even in OpenGL ES 3.1
-    // This functionality can be emulated by adjusting stream offsets. This, however may cause
-    // errors in case instance data is read from the same stream as vertex data. Thus handling
-    // such cases is left to the application
+    DrawElements(GlTopology, GLIndexType, FirstIndexByteOffset, Attribs.NumIndices, Attribs.NumInstances, Attribs.BaseVertex, Attribs.FirstInstanceLocation);
+    DEV_CHECK_GL_ERROR("OpenGL draw command failed");
+
+    PostDraw();
+}
 
-    if (Attribs.NumInstances > 1 || Attribs.FirstInstanceLocation != 0)
+void DeviceContextGLImpl::MultiDraw(const MultiDrawAttribs& Attribs)
+{
+    if (!DvpVerifyMultiDrawArguments(Attribs) || Attribs.DrawCount == 0)
+        return;
+
+    GLenum GlTopology;
+    PrepareForDraw(Attribs.Flags, false, GlTopology);
+
+    for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
     {
-        if (Attribs.BaseVertex > 0)
-        {
-            if (Attribs.FirstInstanceLocation != 0)
-                glDrawElementsInstancedBaseVertexBaseInstance(GlTopology, Attribs.NumIndices, GLIndexType, reinterpret_cast<GLvoid*>(static_cast<size_t>(FirstIndexByteOffset)), Attribs.NumInstances, Attribs.BaseVertex, Attribs.FirstInstanceLocation);
-            else
-                glDrawElementsInstancedBaseVertex(GlTopology, Attribs.NumIndices, GLIndexType, reinterpret_cast<GLvoid*>(static_cast<size_t>(FirstIndexByteOffset)), Attribs.NumInstances, Attribs.BaseVertex);
-        }
-        else
-        {
-            if (Attribs.FirstInstanceLocation != 0)
-                glDrawElementsInstancedBaseInstance(GlTopology, Attribs.NumIndices, GLIndexType, reinterpret_cast<GLvoid*>(static_cast<size_t>(FirstIndexByteOffset)), Attribs.NumInstances, Attribs.FirstInstanceLocation);
-            else
-                glDrawElementsInstanced(GlTopology, Attribs.NumIndices, GLIndexType, reinterpret_cast<GLvoid*>(static_cast<size_t>(FirstIndexByteOffset)), Attribs.NumInstances);
-        }
+        const auto& Item = Attribs.pDrawItems[i];
+        DrawArrays(GlTopology, Item.NumVertices, Item.NumInstances, Item.StartVertexLocation, Item.FirstInstanceLocation);
     }
-    else
+    DEV_CHECK_GL_ERROR("OpenGL multi-draw command failed");
+
+    PostDraw();
+}
+
+void DeviceContextGLImpl::MultiDrawIndexed(const MultiDrawIndexedAttribs& Attribs)
+{
+    if (!DvpVerifyMultiDrawIndexedArguments(Attribs) || Attribs.DrawCount == 0)
+        return;
+
+    GLenum GlTopology;
+    PrepareForDraw(Attribs.Flags, true, GlTopology);
+    GLenum GLIndexType;
+    Uint32 IndexDataStartOffset;
+    PrepareForIndexedDraw(Attribs.IndexType, 0, GLIndexType, IndexDataStartOffset);
+
+    const auto IndexSize = static_cast<Uint32>(GetValueSize(Attribs.IndexType));
+    for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
     {
-        if (Attribs.BaseVertex > 0)
-            glDrawElementsBaseVertex(GlTopology, Attribs.NumIndices, GLIndexType, reinterpret_cast<GLvoid*>(static_cast<size_t>(FirstIndexByteOffset)), Attribs.BaseVertex);
-        else
-            glDrawElements(GlTopology, Attribs.NumIndices, GLIndexType, reinterpret_cast<GLvoid*>(static_cast<size_t>(FirstIndexByteOffset)));
+        const auto& Item = Attribs.pDrawItems[i];
+        DrawElements(GlTopology, GLIndexType, IndexDataStartOffset + IndexSize * Item.FirstIndexLocation,
+                     Item.NumIndices, Item.NumInstances, Item.BaseVertex, Item.FirstInstanceLocation);
     }
-    DEV_CHECK_GL_ERROR("OpenGL draw command failed");
+    DEV_CHECK_GL_ERROR("OpenGL multi-draw command failed");
 
     PostDraw();
 }
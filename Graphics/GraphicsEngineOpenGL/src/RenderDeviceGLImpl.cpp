@@ -79,7 +79,8 @@ RenderDeviceGLImpl::RenderDeviceGLImpl(IReferenceCounters*       pRefCounters,
         }
     },
     // Device caps must be filled in before the constructor of Pipeline Cache is called!
-    m_GLContext{InitAttribs, m_DeviceCaps, pSCDesc}
+    m_GLContext{InitAttribs, m_DeviceCaps, pSCDesc},
+    m_pHLSL2GLSLConversionCache{new HLSL2GLSLConversionCache{InitAttribs.HLSL2GLSLCacheDirectory}}
 // clang-format on
 {
     GLint NumExtensions = 0;
@@ -0,0 +1,129 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::BindlessDescriptorHeap class
+
+#include <array>
+#include <vector>
+#include <mutex>
+#include <atomic>
+
+#include "RenderDeviceVk.h"
+#include "SPIRVShaderResources.hpp"
+#include "VulkanUtilities/VulkanObjectWrappers.hpp"
+
+namespace Diligent
+{
+
+class RenderDeviceVkImpl;
+
+// Device-wide descriptor set that holds large runtime arrays of textures, storage buffers
+// and samplers (VK_EXT_descriptor_indexing). The set is allocated from an update-after-bind
+// pool, so that descriptors that are not used by pending command buffers can be written
+// at any time without invalidating them.
+//
+//   binding 0:  VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE   [BINDLESS_DESCRIPTOR_RANGE_VK_TEXTURES]
+//   binding 1:  VK_DESCRIPTOR_TYPE_STORAGE_BUFFER  [BINDLESS_DESCRIPTOR_RANGE_VK_BUFFERS]
+//   binding 2:  VK_DESCRIPTOR_TYPE_SAMPLER         [BINDLESS_DESCRIPTOR_RANGE_VK_SAMPLERS]
+//
+// Released indices are moved into the device release queues and are only returned to the
+// free list once the GPU has completed all command buffers that could have accessed them.
+class BindlessDescriptorHeap
+{
+public:
+    BindlessDescriptorHeap(RenderDeviceVkImpl& DeviceVkImpl, const Uint32 RangeSizes[]);
+    ~BindlessDescriptorHeap();
+
+    // clang-format off
+    BindlessDescriptorHeap             (const BindlessDescriptorHeap&) = delete;
+    BindlessDescriptorHeap             (BindlessDescriptorHeap&&)      = delete;
+    BindlessDescriptorHeap& operator = (const BindlessDescriptorHeap&) = delete;
+    BindlessDescriptorHeap& operator = (BindlessDescriptorHeap&&)      = delete;
+    // clang-format on
+
+    // Allocates the index in the range that corresponds to the object type and writes the descriptor.
+    // Returns INVALID_BINDLESS_DESCRIPTOR_INDEX if the object is not supported or the range is full.
+    Uint32 Allocate(IDeviceObject* pObject);
+
+    // Releases the index once the GPU is done with all command buffers submitted so far
+    void Free(BINDLESS_DESCRIPTOR_RANGE_VK Range, Uint32 Index);
+
+    Uint32 GetRangeSize(BINDLESS_DESCRIPTOR_RANGE_VK Range) const
+    {
+        return Range < BINDLESS_DESCRIPTOR_RANGE_VK_COUNT ? m_Ranges[Range].Size : 0;
+    }
+
+    VkDescriptorSetLayout GetVkDescriptorSetLayout() const { return m_VkSetLayout; }
+    VkDescriptorSet       GetVkDescriptorSet() const { return m_VkSet; }
+
+    // Returns the range (which is also the binding index in the heap descriptor set) that holds
+    // the runtime arrays of the given resource type, or BINDLESS_DESCRIPTOR_RANGE_VK_COUNT if
+    // the resources of this type can't be accessed through the heap.
+    static BINDLESS_DESCRIPTOR_RANGE_VK GetResourceRange(SPIRVShaderResourceAttribs::ResourceType ResType);
+
+#ifdef DILIGENT_DEVELOPMENT
+    int32_t GetPendingReleaseIndexCounter() const
+    {
+        return m_PendingReleaseIndexCounter;
+    }
+#endif
+
+private:
+    class StaleIndex;
+    void ReturnIndex(BINDLESS_DESCRIPTOR_RANGE_VK Range, Uint32 Index);
+
+    struct IndexRange
+    {
+        Uint32 Size = 0;
+        // Indices in [NextUnusedIndex, Size) have never been allocated
+        Uint32              NextUnusedIndex = 0;
+        std::vector<Uint32> FreeIndices;
+#ifdef DILIGENT_DEVELOPMENT
+        std::vector<bool> dvpIsAllocated;
+#endif
+    };
+
+    RenderDeviceVkImpl& m_DeviceVkImpl;
+
+    VulkanUtilities::DescriptorSetLayoutWrapper m_VkSetLayout;
+    VulkanUtilities::DescriptorPoolWrapper      m_VkPool;
+    VkDescriptorSet                             m_VkSet = VK_NULL_HANDLE;
+
+    // Protects the index ranges and the descriptor set, which must be externally synchronized
+    // when it is updated (13.2.4)
+    std::mutex                                                 m_Mutex;
+    std::array<IndexRange, BINDLESS_DESCRIPTOR_RANGE_VK_COUNT> m_Ranges;
+
+#ifdef DILIGENT_DEVELOPMENT
+    std::atomic_int32_t m_PendingReleaseIndexCounter;
+#endif
+};
+
+} // namespace Diligent
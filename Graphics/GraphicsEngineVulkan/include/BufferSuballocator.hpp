@@ -0,0 +1,136 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::BufferSuballocator class
+
+#include <mutex>
+#include <list>
+
+#include "VariableSizeAllocationsManager.hpp"
+#include "VulkanUtilities/VulkanObjectWrappers.hpp"
+#include "VulkanUtilities/VulkanMemoryManager.hpp"
+
+namespace Diligent
+{
+
+class RenderDeviceVkImpl;
+
+// Places small buffers into large Vulkan buffers shared by all buffers with the same usage flags:
+//
+//     __________________________________________________________
+//    | Buffer A | Buffer B |        | Buffer C |                |
+//    |__________|__________|________|__________|________________|
+//    Block start                                        Block end
+//
+// A suballocated buffer is addressed through the shared Vulkan buffer and the offset of its range.
+// One empty block is kept for every usage when all of its buffers are released, other empty blocks are destroyed.
+class BufferSuballocator
+{
+private:
+    struct Block;
+
+public:
+    BufferSuballocator(RenderDeviceVkImpl& DeviceVkImpl, VkDeviceSize MaxBufferSize, VkDeviceSize BlockSize);
+    ~BufferSuballocator();
+
+    // clang-format off
+    BufferSuballocator             (const BufferSuballocator&) = delete;
+    BufferSuballocator             (BufferSuballocator&&)      = delete;
+    BufferSuballocator& operator = (const BufferSuballocator&) = delete;
+    BufferSuballocator& operator = (BufferSuballocator&&)      = delete;
+    // clang-format on
+
+    // Range of a shared Vulkan buffer occupied by a buffer. The range is returned to the
+    // suballocator when the object is destroyed, so the object must go through the release
+    // queue to keep the range occupied until the GPU is done with the buffer.
+    class Allocation
+    {
+    public:
+        Allocation() noexcept {}
+        ~Allocation();
+
+        // clang-format off
+        Allocation             (Allocation&& rhs) noexcept;
+        Allocation& operator = (Allocation&& rhs) noexcept;
+        Allocation             (const Allocation&) = delete;
+        Allocation& operator = (const Allocation&) = delete;
+        // clang-format on
+
+        explicit operator bool() const { return m_pBlock != nullptr; }
+
+        VkBuffer     GetVkBuffer() const;
+        VkDeviceSize GetOffset() const { return m_AlignedOffset; }
+
+    private:
+        friend BufferSuballocator;
+        Allocation(BufferSuballocator& Allocator, Block& BuffBlock, const VariableSizeAllocationsManager::Allocation& Range, VkDeviceSize AlignedOffset) noexcept;
+
+        void Release();
+
+        BufferSuballocator*                        m_pAllocator = nullptr;
+        Block*                                     m_pBlock     = nullptr;
+        VariableSizeAllocationsManager::Allocation m_Range;
+        VkDeviceSize                               m_AlignedOffset = 0;
+    };
+
+    // Buffers larger than this size are not suballocated
+    VkDeviceSize GetMaxBufferSize() const { return m_MaxBufferSize; }
+
+    // Allocates the range of Size bytes aligned by Alignment in a shared buffer created with the Usage flags.
+    Allocation Allocate(VkBufferUsageFlags Usage, VkDeviceSize Size, VkDeviceSize Alignment);
+
+private:
+    void Free(Block& BuffBlock, VariableSizeAllocationsManager::Allocation& Range);
+
+    struct Block
+    {
+        const VkBufferUsageFlags                Usage;
+        VulkanUtilities::BufferWrapper          Buffer;
+        VulkanUtilities::VulkanMemoryAllocation Memory;
+        VariableSizeAllocationsManager          RangeMgr;
+
+        Block(VkBufferUsageFlags _Usage, VkDeviceSize Size, IMemoryAllocator& Allocator) :
+            // clang-format off
+            Usage   {_Usage},
+            RangeMgr{static_cast<VariableSizeAllocationsManager::OffsetType>(Size), Allocator}
+        // clang-format on
+        {}
+    };
+
+    RenderDeviceVkImpl& m_DeviceVkImpl;
+
+    const VkDeviceSize m_MaxBufferSize;
+    const VkDeviceSize m_BlockSize;
+
+    std::mutex       m_Mtx;
+    std::list<Block> m_Blocks;
+};
+
+} // namespace Diligent
@@ -72,11 +72,13 @@ public:
     void DvpVerifyDynamicAllocation(DeviceContextVkImpl* pCtx) const;
 #endif
 
+    // Returns the offset of the buffer data in the Vulkan buffer returned by GetVkBuffer()
     Uint32 GetDynamicOffset(Uint32 CtxId, DeviceContextVkImpl* pCtx) const
     {
         if (m_VulkanBuffer != VK_NULL_HANDLE)
         {
-            return 0;
+            // The offset is only non-zero if the buffer is suballocated from a shared Vulkan buffer
+            return static_cast<Uint32>(m_Suballocation.GetOffset());
         }
         else
         {
@@ -93,6 +95,18 @@ public:
     /// Implementation of IBufferVk::GetVkBuffer().
     virtual VkBuffer DILIGENT_CALL_TYPE GetVkBuffer() const override final;
 
+    /// Implementation of IBufferVk::GetVkBufferOffset().
+    virtual VkDeviceSize DILIGENT_CALL_TYPE GetVkBufferOffset() const override final
+    {
+        return m_Suballocation.GetOffset();
+    }
+
+    // Returns the size of the range of the Vulkan buffer that holds the buffer data
+    VkDeviceSize GetVkBufferRange() const
+    {
+        return m_Suballocation ? VkDeviceSize{m_Desc.uiSizeInBytes} : VK_WHOLE_SIZE;
+    }
+
     /// Implementation of IBuffer::GetNativeHandle() in Vulkan backend.
     virtual void* DILIGENT_CALL_TYPE GetNativeHandle() override final
     {
@@ -131,6 +145,10 @@ private:
 
     VulkanUtilities::BufferWrapper          m_VulkanBuffer;
     VulkanUtilities::VulkanMemoryAllocation m_MemoryAllocation;
+
+    // Range of the shared Vulkan buffer if the buffer is suballocated. In this case,
+    // m_VulkanBuffer does not own the Vulkan buffer.
+    BufferSuballocator::Allocation m_Suballocation;
 };
 
 } // namespace Diligent
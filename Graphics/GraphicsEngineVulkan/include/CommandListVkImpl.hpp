@@ -46,11 +46,13 @@ public:
     CommandListVkImpl(IReferenceCounters* pRefCounters,
                       RenderDeviceVkImpl* pDevice,
                       IDeviceContext*     pDeferredCtx,
-                      VkCommandBuffer     vkCmdBuff) :
+                      VkCommandBuffer     vkCmdBuff,
+                      VkRenderPass        vkInheritedRenderPass = VK_NULL_HANDLE) :
         // clang-format off
-        TCommandListBase {pRefCounters, pDevice},
-        m_pDeferredCtx   {pDeferredCtx},
-        m_vkCmdBuff      {vkCmdBuff   }
+        TCommandListBase        {pRefCounters, pDevice},
+        m_pDeferredCtx          {pDeferredCtx         },
+        m_vkCmdBuff             {vkCmdBuff            },
+        m_vkInheritedRenderPass {vkInheritedRenderPass}
     // clang-format on
     {
     }
@@ -68,9 +70,15 @@ public:
         pDeferredCtx = std::move(m_pDeferredCtx);
     }
 
+    // Secondary command lists are executed inside the render pass they inherit
+    bool IsSecondary() const { return m_vkInheritedRenderPass != VK_NULL_HANDLE; }
+
+    VkRenderPass GetInheritedRenderPass() const { return m_vkInheritedRenderPass; }
+
 private:
     RefCntAutoPtr<IDeviceContext> m_pDeferredCtx;
     VkCommandBuffer               m_vkCmdBuff;
+    const VkRenderPass            m_vkInheritedRenderPass;
 };
 
 } // namespace Diligent
@@ -34,6 +34,8 @@
 #include <deque>
 #include <mutex>
 #include <atomic>
+#include <array>
+#include <unordered_map>
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
 
 namespace Diligent
@@ -45,19 +47,23 @@ class RenderDeviceVkImpl;
 // This class manages descriptor set allocation.
 // The class destructor calls DescriptorSetAllocator::FreeDescriptorSet() that moves
 // the set into the release queue.
-// sizeof(DescriptorSetAllocation) == 32 (x64)
+// sizeof(DescriptorSetAllocation) == 48 (x64)
 class DescriptorSetAllocation
 {
 public:
     // clang-format off
     DescriptorSetAllocation(VkDescriptorSet         _Set,
                             VkDescriptorPool        _Pool,
+                            VkDescriptorSetLayout   _Layout,
+                            Uint32                  _RecycleBin,
                             Uint64                  _CmdQueueMask,
                             DescriptorSetAllocator& _DescrSetAllocator)noexcept :
         Set              {_Set               },
         Pool             {_Pool              },
+        Layout           {_Layout            },
         CmdQueueMask     {_CmdQueueMask      },
-        DescrSetAllocator{&_DescrSetAllocator}
+        DescrSetAllocator{&_DescrSetAllocator},
+        RecycleBin       {_RecycleBin        }
     {}
     DescriptorSetAllocation()noexcept{}
 
@@ -67,8 +73,10 @@ public:
     DescriptorSetAllocation(DescriptorSetAllocation&& rhs)noexcept : 
         Set              {rhs.Set              },
         Pool             {rhs.Pool             },
+        Layout           {rhs.Layout           },
         CmdQueueMask     {rhs.CmdQueueMask     },
-        DescrSetAllocator{rhs.DescrSetAllocator}
+        DescrSetAllocator{rhs.DescrSetAllocator},
+        RecycleBin       {rhs.RecycleBin       }
     {
         rhs.Reset();
     }
@@ -81,7 +89,9 @@ public:
         Set               = rhs.Set;
         CmdQueueMask      = rhs.CmdQueueMask;
         Pool              = rhs.Pool;
+        Layout            = rhs.Layout;
         DescrSetAllocator = rhs.DescrSetAllocator;
+        RecycleBin        = rhs.RecycleBin;
 
         rhs.Reset();
 
@@ -97,8 +107,10 @@ public:
     {
         Set               = VK_NULL_HANDLE;
         Pool              = VK_NULL_HANDLE;
+        Layout            = VK_NULL_HANDLE;
         CmdQueueMask      = 0;
         DescrSetAllocator = nullptr;
+        RecycleBin        = 0;
     }
 
     void Release();
@@ -113,8 +125,10 @@ public:
 private:
     VkDescriptorSet         Set               = VK_NULL_HANDLE;
     VkDescriptorPool        Pool              = VK_NULL_HANDLE;
+    VkDescriptorSetLayout   Layout            = VK_NULL_HANDLE;
     Uint64                  CmdQueueMask      = 0;
     DescriptorSetAllocator* DescrSetAllocator = nullptr;
+    Uint32                  RecycleBin        = 0;
 };
 
 
@@ -192,7 +206,21 @@ private:
 
 
 // The class allocates descriptor sets from the main descriptor pool.
-// Descriptors sets can be released and returned to the pool
+// Released descriptor sets are not freed, but are put into per-layout recycle lists once
+// the GPU is done with them, and are handed out again by subsequent allocations with the
+// same layout. The lists are split into several bins indexed by the allocating thread,
+// so that threads creating shader resource bindings rarely contend for the same mutex
+// and never lock the pool mutex when a recycled set is available.
+//
+//   Allocate()                                      Release()
+//       |                                               |
+//       |    ____________________________________       V
+//       |-->|   Recycle bin[hash(thread id) % N]  |<--[Release queue]
+//       |   |  Layout -> | Set | Set | ... |      |       |
+//       |   |_____________________________________|       | Bin is full
+//       |                                                 V
+//       |--------------------------------------------> Pool (reset when all sets are returned)
+//
 class DescriptorSetAllocator : public DescriptorPoolManager
 {
 public:
@@ -222,6 +250,21 @@ public:
 
     DescriptorSetAllocation Allocate(Uint64 CommandQueueMask, VkDescriptorSetLayout SetLayout, const char* DebugName = "");
 
+    // Releases the descriptor set layout once the GPU is done with it. Recycled sets that
+    // use the layout are returned to the pool first, as the handle may be reused by
+    // a new layout afterwards.
+    void DisposeDescriptorSetLayout(VulkanUtilities::DescriptorSetLayoutWrapper&& Layout, Uint64 QueueMask);
+
+    struct Statistics
+    {
+        Uint64 NumAllocations     = 0;
+        Uint64 NumRecycledSets    = 0;
+        Uint64 NumPoolAllocations = 0;
+        Uint64 NumPoolResets      = 0;
+        Uint32 NumCachedSets      = 0;
+    };
+    Statistics GetStatistics() const;
+
 #ifdef DILIGENT_DEVELOPMENT
     int32_t GetAllocatedDescriptorSetCounter() const
     {
@@ -230,7 +273,42 @@ public:
 #endif
 
 private:
-    void FreeDescriptorSet(VkDescriptorSet Set, VkDescriptorPool Pool, Uint64 QueueMask);
+    void FreeDescriptorSet(VkDescriptorSet Set, VkDescriptorPool Pool, VkDescriptorSetLayout Layout, Uint32 BinIdx, Uint64 QueueMask);
+
+    void RecycleDescriptorSet(VkDescriptorSet Set, VkDescriptorPool Pool, VkDescriptorSetLayout Layout, Uint32 BinIdx);
+    void ReturnDescriptorSetToPool(VkDescriptorSet Set, VkDescriptorPool Pool);
+    void ReleaseRecycledSets(VkDescriptorSetLayout Layout);
+
+    static Uint32 GetThreadRecycleBin();
+
+    struct RecycledSet
+    {
+        VkDescriptorSet  Set;
+        VkDescriptorPool Pool;
+    };
+
+    struct RecycleBin
+    {
+        std::mutex                                                          Mtx;
+        std::unordered_map<VkDescriptorSetLayout, std::vector<RecycledSet>> Sets;
+    };
+
+    static constexpr Uint32 NumRecycleBins = 8;
+    // The maximum number of sets with the same layout kept in one bin.
+    // Extra sets are freed back to the pool.
+    static constexpr size_t MaxRecycledSetsPerLayout = 256;
+
+    std::array<RecycleBin, NumRecycleBins> m_RecycleBins;
+
+    // The number of sets allocated from every pool that have not been freed back to it,
+    // including the sets in recycle bins. Protected by m_Mutex.
+    std::unordered_map<VkDescriptorPool, Uint32> m_PoolSetCounts;
+
+    std::atomic<Uint64> m_NumAllocations{0};
+    std::atomic<Uint64> m_NumRecycledSets{0};
+    std::atomic<Uint64> m_NumPoolAllocations{0};
+    std::atomic<Uint64> m_NumPoolResets{0};
+    std::atomic<Int32>  m_NumCachedSets{0};
 
 #ifdef DILIGENT_DEVELOPMENT
     std::atomic_int32_t m_AllocatedSetCounter;
@@ -142,6 +142,10 @@ public:
     virtual void DILIGENT_CALL_TYPE DrawIndirect       (const DrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer) override final;
     /// Implementation of IDeviceContext::DrawIndexedIndirect() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer) override final;
+    /// Implementation of IDeviceContext::MultiDraw() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE MultiDraw          (const MultiDrawAttribs& Attribs) override final;
+    /// Implementation of IDeviceContext::MultiDrawIndexed() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE MultiDrawIndexed   (const MultiDrawIndexedAttribs& Attribs) override final;
 
     /// Implementation of IDeviceContext::DispatchCompute() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE DispatchCompute        (const DispatchComputeAttribs& Attribs) override final;
@@ -263,6 +267,15 @@ public:
     /// Implementation of IDeviceContextVk::BufferMemoryBarrier().
     virtual void DILIGENT_CALL_TYPE BufferMemoryBarrier(IBuffer* pBuffer, VkAccessFlags NewAccessFlags) override final;
 
+    /// Implementation of IDeviceContextVk::GetPipelineBarrierStats().
+    virtual void DILIGENT_CALL_TYPE GetPipelineBarrierStats(PipelineBarrierStats& Stats) override final;
+
+    /// Implementation of IDeviceContextVk::BeginSecondaryCommandList().
+    virtual void DILIGENT_CALL_TYPE BeginSecondaryCommandList(IDeviceContext* pImmediateContext) override final;
+
+    /// Implementation of IDeviceContextVk::ExecuteCommandLists().
+    virtual void DILIGENT_CALL_TYPE ExecuteCommandLists(Uint32 NumCommandLists, ICommandList* const* ppCommandLists) override final;
+
 
     void AddWaitSemaphore(ManagedSemaphore* pWaitSemaphore, VkPipelineStageFlags WaitDstStageMask)
     {
@@ -306,6 +319,9 @@ public:
 
     size_t GetNumCommandsInCtx() const { return m_State.NumCommands; }
 
+    // Batched pipeline barriers are not counted as commands, but must be submitted as well
+    bool HasPendingCommands() const { return m_State.NumCommands != 0 || m_CommandBuffer.HasPendingBarriers(); }
+
     __forceinline VulkanUtilities::VulkanCommandBuffer& GetCommandBuffer()
     {
         EnsureVkCmdBuffer();
@@ -368,7 +384,10 @@ private:
         }
     }
 
-    inline void DisposeVkCmdBuffer(Uint32 CmdQueue, VkCommandBuffer vkCmdBuff, Uint64 FenceValue);
+    inline void DisposeVkCmdBuffer(Uint32 CmdQueue, VkCommandBuffer vkCmdBuff, Uint64 FenceValue, VkCommandBufferLevel Level = VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+
+    void        ExecutePrimaryCommandLists(Uint32 NumCommandLists, ICommandList* const* ppCommandLists);
+    void        ExecuteSecondaryCommandLists(Uint32 NumCommandLists, ICommandList* const* ppCommandLists);
     inline void DisposeCurrentCmdBuffer(Uint32 CmdQueue, Uint64 FenceValue);
 
     struct BufferToTextureCopyInfo
@@ -446,6 +465,17 @@ private:
     // List of fences to signal next time the command context is flushed
     std::vector<std::pair<Uint64, RefCntAutoPtr<IFence>>> m_PendingFences;
 
+    // Secondary command buffers executed by the current command buffer. They are
+    // returned to the pools of their deferred contexts when the context is flushed.
+    std::vector<std::pair<VkCommandBuffer, RefCntAutoPtr<IDeviceContext>>> m_ExecutedSecondaryCmdBuffers;
+
+    // Scratch array of the command buffers of the command lists being executed
+    std::vector<VkCommandBuffer> m_vkCmdListBuffers;
+
+    // Scratch array of the layouts in which the transient textures that alias
+    // the memory of the texture being transitioned may have accessed it
+    std::vector<VkImageLayout> m_AliasedLayouts;
+
     std::unordered_map<BufferVkImpl*, VulkanUploadAllocation> m_UploadAllocations;
 
     struct MappedTextureKey
@@ -489,6 +519,13 @@ private:
 
     std::unique_ptr<QueryManagerVk> m_QueryMgr;
     Int32                           m_ActiveQueriesCounter = 0;
+
+    // Multi-draw batches with at least this many draws are recorded as indirect draws
+    // with arguments written to the dynamic heap
+    static constexpr Uint32 MinMultiDrawIndirectCount = 32;
+
+    // Maximum number of draws in a single indirect draw command, or 0 if multi-draw indirect is not enabled
+    Uint32 m_MaxMultiDrawIndirectCount = 0;
 };
 
 } // namespace Diligent
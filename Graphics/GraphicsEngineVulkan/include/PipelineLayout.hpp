@@ -43,6 +43,7 @@ namespace Diligent
 class RenderDeviceVkImpl;
 class DeviceContextVkImpl;
 class ShaderResourceCacheVk;
+class BindlessDescriptorHeap;
 
 /// Implementation of the Diligent::PipelineLayout class
 class PipelineLayout
@@ -72,6 +73,13 @@ public:
                               Uint32&                           OffsetInCache,
                               std::vector<uint32_t>&            SPIRV);
 
+    // Maps the runtime array to the binding of the bindless descriptor heap. The heap
+    // descriptor set always goes last; its index is written to SPIR-V by Finalize().
+    void AllocateBindlessResourceSlot(const SPIRVShaderResourceAttribs& ResAttribs,
+                                      BindlessDescriptorHeap*           pBindlessHeap,
+                                      const char*                       ShaderName,
+                                      std::vector<uint32_t>&            SPIRV);
+
     Uint32 GetTotalDescriptors(SHADER_RESOURCE_VARIABLE_TYPE VarType) const
     {
         VERIFY_EXPR(VarType >= 0 && VarType < SHADER_RESOURCE_VARIABLE_TYPE_NUM_TYPES);
@@ -87,11 +95,31 @@ public:
         return m_LayoutMgr.GetHash();
     }
 
+    // Returns true if any shader in the pipeline accesses the bindless descriptor heap
+    bool UsesBindlessHeap() const
+    {
+        return m_LayoutMgr.GetBindlessSetIndex() >= 0;
+    }
+
     VkDescriptorSetLayout GetDynamicDescriptorSetVkLayout() const
     {
         return m_LayoutMgr.GetDescriptorSet(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC).VkLayout;
     }
 
+    // Returns the template that writes all descriptors of the dynamic descriptor set from the
+    // data kept in the resource cache, or null if descriptor update templates are not enabled.
+    VkDescriptorUpdateTemplateKHR GetDynamicDescriptorSetUpdateTemplate() const
+    {
+        return m_LayoutMgr.GetDescriptorSet(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC).VkUpdateTemplate;
+    }
+
+    // Returns the index of the descriptor set that is written with the update template, or -1
+    Int32 GetDescriptorUpdateTemplateSetIndex() const
+    {
+        const auto& DynamicSet = m_LayoutMgr.GetDescriptorSet(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC);
+        return DynamicSet.VkUpdateTemplate != VK_NULL_HANDLE ? DynamicSet.SetIndex : -1;
+    }
+
     struct DescriptorSetBindInfo
     {
         std::vector<VkDescriptorSet> vkSets;
@@ -168,10 +196,13 @@ private:
             uint16_t                                    NumLayoutBindings     = 0;
             VkDescriptorSetLayoutBinding*               pBindings             = nullptr;
             VulkanUtilities::DescriptorSetLayoutWrapper VkLayout;
+            // Only created for the dynamic descriptor set
+            VulkanUtilities::DescriptorUpdateTemplateWrapper VkUpdateTemplate;
 
             ~DescriptorSetLayout();
             void AddBinding(const VkDescriptorSetLayoutBinding& Binding, IMemoryAllocator& MemAllocator);
             void Finalize(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice, IMemoryAllocator& MemAllocator, VkDescriptorSetLayoutBinding* pNewBindings);
+            void CreateUpdateTemplate(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice);
             void Release(RenderDeviceVkImpl* pRenderDeviceVk, IMemoryAllocator& MemAllocator, Uint64 CommandQueueMask);
 
             bool   operator==(const DescriptorSetLayout& rhs) const;
@@ -212,16 +243,32 @@ private:
                                   Uint32&                           Binding,
                                   Uint32&                           OffsetInCache);
 
+        void UseBindlessHeap(const BindlessDescriptorHeap& BindlessHeap);
+
+        // Returns the index of the bindless heap descriptor set, or -1 if the heap is not used
+        int8_t          GetBindlessSetIndex() const { return m_BindlessSetIndex; }
+        VkDescriptorSet GetBindlessVkDescriptorSet() const { return m_vkBindlessSet; }
+
     private:
         IMemoryAllocator&                                                                           m_MemAllocator;
         VulkanUtilities::PipelineLayoutWrapper                                                      m_VkPipelineLayout;
         std::array<DescriptorSetLayout, 2>                                                          m_DescriptorSetLayouts;
         std::vector<VkDescriptorSetLayoutBinding, STDAllocatorRawMem<VkDescriptorSetLayoutBinding>> m_LayoutBindings;
         uint8_t                                                                                     m_ActiveSets = 0;
+
+        // The bindless heap layout and set are owned by the render device
+        VkDescriptorSetLayout m_vkBindlessSetLayout = VK_NULL_HANDLE;
+        VkDescriptorSet       m_vkBindlessSet       = VK_NULL_HANDLE;
+        int8_t                m_BindlessSetIndex    = -1;
     };
 
     IMemoryAllocator&          m_MemAllocator;
     DescriptorSetLayoutManager m_LayoutMgr;
+
+    // Descriptor set decorations of the runtime arrays that are patched by Finalize().
+    // The pointers reference SPIR-V byte code that is kept alive by the pipeline
+    // state constructor until shader modules are created.
+    std::vector<uint32_t*> m_BindlessSetDecorations;
 };
 
 
@@ -83,6 +83,9 @@ public:
     /// Implementation of IPipelineState::GetStaticVariableByName() in Vulkan backend.
     virtual IShaderResourceVariable* DILIGENT_CALL_TYPE GetStaticVariableByName(SHADER_TYPE ShaderType, const Char* Name) override final;
 
+    /// Implementation of IPipelineState::GetStaticVariableByHashedName() in Vulkan backend.
+    virtual IShaderResourceVariable* DILIGENT_CALL_TYPE GetStaticVariableByHashedName(SHADER_TYPE ShaderType, const HashedShaderVariableName& Name) override final;
+
     /// Implementation of IPipelineState::GetStaticVariableByIndex() in Vulkan backend.
     virtual IShaderResourceVariable* DILIGENT_CALL_TYPE GetStaticVariableByIndex(SHADER_TYPE ShaderType, Uint32 Index) override final;
 
@@ -108,6 +111,13 @@ public:
         return m_ShaderResourceLayouts[ShaderInd];
     }
 
+    // Returns the name index of mutable and dynamic variables that is shared by all SRBs of this PSO
+    const ShaderVariableNameIndex& GetSRBVarNameIndex(Uint32 ShaderInd) const
+    {
+        VERIFY_EXPR(ShaderInd < m_NumShaders);
+        return m_VarNameIndices[ShaderInd];
+    }
+
     SRBMemoryAllocator& GetSRBMemoryAllocator()
     {
         return m_SRBMemAllocator;
@@ -147,6 +157,10 @@ private:
     ShaderResourceCacheVk*   m_StaticResCaches       = nullptr;
     ShaderVariableManagerVk* m_StaticVarsMgrs        = nullptr;
 
+    // Variable name indices: [0, m_NumShaders) - mutable and dynamic variables of SRBs,
+    // [m_NumShaders, 2*m_NumShaders) - static variables
+    std::vector<ShaderVariableNameIndex> m_VarNameIndices;
+
     // SRB memory allocator must be declared before m_pDefaultShaderResBinding
     SRBMemoryAllocator m_SRBMemAllocator;
 
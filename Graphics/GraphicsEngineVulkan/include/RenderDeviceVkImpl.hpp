@@ -48,6 +48,11 @@
 #include "FramebufferCache.hpp"
 #include "RenderPassCache.hpp"
 #include "CommandPoolManager.hpp"
+#include "SPIRVCache.hpp"
+#include "BindlessDescriptorHeap.hpp"
+#include "ResourceUploadBatch.hpp"
+#include "TransientTextureAllocator.hpp"
+#include "BufferSuballocator.hpp"
 
 namespace Diligent
 {
@@ -119,6 +124,36 @@ public:
                                                                    RESOURCE_STATE    InitialState,
                                                                    IBuffer**         ppBuffer) override final;
 
+    /// Implementation of IRenderDeviceVk::GetSPIRVCacheStats().
+    virtual void DILIGENT_CALL_TYPE GetSPIRVCacheStats(SPIRVCacheStats& Stats) override final;
+
+    /// Implementation of IRenderDeviceVk::GetPipelineCacheData().
+    virtual void DILIGENT_CALL_TYPE GetPipelineCacheData(IDataBlob** ppData) override final;
+
+    /// Implementation of IRenderDeviceVk::AllocateBindlessDescriptor().
+    virtual Uint32 DILIGENT_CALL_TYPE AllocateBindlessDescriptor(IDeviceObject* pObject) override final;
+
+    /// Implementation of IRenderDeviceVk::ReleaseBindlessDescriptor().
+    virtual void DILIGENT_CALL_TYPE ReleaseBindlessDescriptor(BINDLESS_DESCRIPTOR_RANGE_VK Range, Uint32 Index) override final;
+
+    /// Implementation of IRenderDeviceVk::GetBindlessDescriptorHeapSize().
+    virtual Uint32 DILIGENT_CALL_TYPE GetBindlessDescriptorHeapSize(BINDLESS_DESCRIPTOR_RANGE_VK Range) override final;
+
+    /// Implementation of IRenderDeviceVk::GetDescriptorSetAllocationStats().
+    virtual void DILIGENT_CALL_TYPE GetDescriptorSetAllocationStats(DescriptorSetAllocationStats& Stats) override final;
+
+    /// Implementation of IRenderDeviceVk::FlushResourceUploads().
+    virtual void DILIGENT_CALL_TYPE FlushResourceUploads(IFence* pFence, Uint64 FenceValue) override final;
+
+    /// Implementation of IRenderDeviceVk::GetResourceUploadBatchStats().
+    virtual void DILIGENT_CALL_TYPE GetResourceUploadBatchStats(ResourceUploadBatchStats& Stats) override final;
+
+    /// Implementation of IRenderDeviceVk::GetDeviceMemoryHeapCount().
+    virtual Uint32 DILIGENT_CALL_TYPE GetDeviceMemoryHeapCount() const override final { return m_MemoryMgr.GetHeapCount(); }
+
+    /// Implementation of IRenderDeviceVk::GetDeviceMemoryHeapStats().
+    virtual void DILIGENT_CALL_TYPE GetDeviceMemoryHeapStats(Uint32 HeapIndex, DeviceMemoryHeapStats& Stats) override final;
+
     /// Implementation of IRenderDevice::IdleGPU() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE IdleGPU() override final;
 
@@ -127,7 +162,12 @@ public:
     Uint64 ExecuteCommandBuffer(Uint32 QueueIndex, const VkSubmitInfo& SubmitInfo, class DeviceContextVkImpl* pImmediateCtx, std::vector<std::pair<Uint64, RefCntAutoPtr<IFence>>>* pSignalFences);
 
     void AllocateTransientCmdPool(VulkanUtilities::CommandPoolWrapper& CmdPool, VkCommandBuffer& vkCmdBuff, const Char* DebugPoolName = nullptr);
-    void ExecuteAndDisposeTransientCmdBuff(Uint32 QueueIndex, VkCommandBuffer vkCmdBuff, VulkanUtilities::CommandPoolWrapper&& CmdPool);
+    // Returns the fence value associated with the submitted command buffer. Fences in pSignalFences
+    // are signaled right after the command buffer is executed.
+    Uint64 ExecuteAndDisposeTransientCmdBuff(Uint32                                                 QueueIndex,
+                                             VkCommandBuffer                                        vkCmdBuff,
+                                             VulkanUtilities::CommandPoolWrapper&&                  CmdPool,
+                                             std::vector<std::pair<Uint64, RefCntAutoPtr<IFence>>>* pSignalFences = nullptr);
 
     /// Implementation of IRenderDevice::ReleaseStaleResources() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE ReleaseStaleResources(bool ForceRelease = false) override final;
@@ -136,6 +176,10 @@ public:
     {
         return m_DescriptorSetAllocator.Allocate(CommandQueueMask, SetLayout, DebugName);
     }
+    void DisposeDescriptorSetLayout(VulkanUtilities::DescriptorSetLayoutWrapper&& Layout, Uint64 CommandQueueMask)
+    {
+        m_DescriptorSetAllocator.DisposeDescriptorSetLayout(std::move(Layout), CommandQueueMask);
+    }
     DescriptorPoolManager& GetDynamicDescriptorPool() { return m_DynamicDescriptorPool; }
 
     std::shared_ptr<const VulkanUtilities::VulkanInstance> GetVulkanInstance() const { return m_VulkanInstance; }
@@ -143,6 +187,8 @@ public:
     const VulkanUtilities::VulkanPhysicalDevice& GetPhysicalDevice() const { return *m_PhysicalDevice; }
     const VulkanUtilities::VulkanLogicalDevice&  GetLogicalDevice() { return *m_LogicalVkDevice; }
 
+    VkPipelineCache GetVkPipelineCache() const { return m_PipelineCache; }
+
     FramebufferCache& GetFramebufferCache() { return m_FramebufferCache; }
     RenderPassCache&  GetRenderPassCache() { return m_RenderPassCache; }
 
@@ -150,15 +196,39 @@ public:
     {
         return m_MemoryMgr.Allocate(MemReqs, MemoryProperties);
     }
+    VulkanUtilities::VulkanMemoryAllocation AllocateMemory(const VkMemoryRequirements&             MemReqs,
+                                                           VkMemoryPropertyFlags                   MemoryProperties,
+                                                           const VkMemoryDedicatedRequirementsKHR& DedicatedReqs,
+                                                           VkBuffer                                vkBuffer,
+                                                           VkImage                                 vkImage)
+    {
+        return m_MemoryMgr.Allocate(MemReqs, MemoryProperties, DedicatedReqs, vkBuffer, vkImage);
+    }
     VulkanUtilities::VulkanMemoryManager& GetGlobalMemoryManager() { return m_MemoryMgr; }
 
     VulkanDynamicMemoryManager& GetDynamicMemoryManager() { return m_DynamicMemoryManager; }
 
+    // Returns null if SPIR-V cache is disabled
+    SPIRVCache* GetSPIRVCache() { return m_pSPIRVCache.get(); }
+
+    // Returns null if the bindless descriptor heap is disabled or not supported
+    BindlessDescriptorHeap* GetBindlessDescriptorHeap() { return m_pBindlessHeap.get(); }
+
+    // Returns null if batched resource initialization is disabled
+    ResourceUploadBatch* GetResourceUploadBatch() { return m_pUploadBatch.get(); }
+
+    TransientTextureAllocator& GetTransientTextureAllocator() { return m_TransientTexAllocator; }
+
+    // Returns null if buffer suballocation is disabled
+    BufferSuballocator* GetBufferSuballocator() { return m_pBufferSuballocator.get(); }
+
     void FlushStaleResources(Uint32 CmdQueueIndex);
 
 private:
     virtual void TestTextureFormat(TEXTURE_FORMAT TexFormat) override final;
 
+    void CreatePipelineCache(const void* pCacheData, size_t CacheDataSize);
+
     // Submits command buffer for execution to the command queue
     // Returns the submitted command buffer number and the fence value
     // Parameters:
@@ -172,6 +242,8 @@ private:
 
     EngineVkCreateInfo m_EngineAttribs;
 
+    VulkanUtilities::PipelineCacheWrapper m_PipelineCache;
+
     FramebufferCache       m_FramebufferCache;
     RenderPassCache        m_RenderPassCache;
     DescriptorSetAllocator m_DescriptorSetAllocator;
@@ -184,7 +256,18 @@ private:
 
     VulkanUtilities::VulkanMemoryManager m_MemoryMgr;
 
+    // Must be declared after the memory manager as the heaps of transient textures are allocated from it
+    TransientTextureAllocator m_TransientTexAllocator;
+
     VulkanDynamicMemoryManager m_DynamicMemoryManager;
+
+    std::unique_ptr<SPIRVCache> m_pSPIRVCache;
+
+    std::unique_ptr<BindlessDescriptorHeap> m_pBindlessHeap;
+
+    std::unique_ptr<ResourceUploadBatch> m_pUploadBatch;
+
+    std::unique_ptr<BufferSuballocator> m_pBufferSuballocator;
 };
 
 } // namespace Diligent
@@ -0,0 +1,152 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::ResourceUploadBatch class
+
+#include <mutex>
+
+#include "RenderDeviceVk.h"
+#include "RingBuffer.hpp"
+#include "RefCntAutoPtr.hpp"
+#include "VulkanUtilities/VulkanObjectWrappers.hpp"
+#include "VulkanUtilities/VulkanMemoryManager.hpp"
+
+namespace Diligent
+{
+
+class RenderDeviceVkImpl;
+class FenceVkImpl;
+
+// Collects the commands that initialize new buffers and textures into a single transfer
+// command buffer (see EngineVkCreateInfo::ResourceUploadBatchStagingSize). The initial data
+// is written to a persistently mapped staging buffer that is managed as a ring: the space used
+// by a batch is reclaimed once the GPU has completed it. The batch is submitted when the amount of
+// pending staging data reaches the flush size, when the space in the ring is exhausted, or when
+// Flush() is called. The device flushes the batch before it submits any other command buffer,
+// so resources are always initialized before they can be accessed by the GPU.
+//
+//    ____________________________________________________________________
+//   |                         Staging buffer                             |
+//   |     | Batch N-1 (in flight) |  Batch N (recording)  |              |
+//   |_____|_______________________|_______________________|______________|
+//                                 A                       A
+//                                 |                       |
+//                               Tail                     Head
+//
+class ResourceUploadBatch
+{
+public:
+    ResourceUploadBatch(RenderDeviceVkImpl& DeviceVkImpl,
+                        Uint32              StagingBufferSize,
+                        Uint32              FlushSize);
+    ~ResourceUploadBatch();
+
+    // clang-format off
+    ResourceUploadBatch             (const ResourceUploadBatch&) = delete;
+    ResourceUploadBatch             (ResourceUploadBatch&&)      = delete;
+    ResourceUploadBatch& operator = (const ResourceUploadBatch&) = delete;
+    ResourceUploadBatch& operator = (ResourceUploadBatch&&)      = delete;
+    // clang-format on
+
+    // Region of the staging buffer reserved for the initial data of one resource
+    struct StagingRegion
+    {
+        VkBuffer     vkBuffer    = VK_NULL_HANDLE;
+        VkDeviceSize Offset      = 0;
+        Uint8*       pCPUAddress = nullptr;
+    };
+
+    // Reserves StagingSize bytes in the staging buffer and calls RecordCommands(vkCmdBuff, Region)
+    // that must write the initial data to Region.pCPUAddress and record the commands that initialize
+    // the resource into vkCmdBuff. Alignment does not need to be a power of two.
+    // Returns false if the data does not fit into the staging buffer, in which case the resource
+    // must be initialized by a separate submission.
+    template <typename RecordCommandsType>
+    bool Record(size_t StagingSize, size_t Alignment, RecordCommandsType RecordCommands)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        StagingRegion Region;
+        if (StagingSize > 0 && !AllocateStagingSpace(StagingSize, Alignment, Region))
+        {
+            ++m_Stats.NumFallbackUploads;
+            return false;
+        }
+
+        if (m_vkCmdBuff == VK_NULL_HANDLE)
+            BeginCommandBuffer();
+
+        RecordCommands(m_vkCmdBuff, Region);
+
+        ++m_Stats.NumBatchedResources;
+        ++m_Stats.NumPendingResources;
+        m_Stats.StagingBytesUploaded += StagingSize;
+        m_PendingStagingSize += StagingSize;
+        if (m_PendingStagingSize >= m_FlushSize)
+            Submit(nullptr, 0);
+
+        return true;
+    }
+
+    // Submits the pending commands to the command queue and signals pFence with FenceValue
+    // once they are complete. Returns false if there were no pending commands, in which
+    // case the fence is not signaled.
+    bool Flush(IFence* pFence, Uint64 FenceValue);
+
+    ResourceUploadBatchStats GetStats();
+
+private:
+    bool AllocateStagingSpace(size_t Size, size_t Alignment, StagingRegion& Region);
+    void BeginCommandBuffer();
+    void Submit(IFence* pFence, Uint64 FenceValue);
+
+    RenderDeviceVkImpl& m_DeviceVkImpl;
+
+    std::mutex m_Mtx;
+
+    VulkanUtilities::BufferWrapper          m_StagingBuffer;
+    VulkanUtilities::VulkanMemoryAllocation m_StagingMemory;
+    Uint8*                                  m_StagingCPUAddress = nullptr;
+    const size_t                            m_FlushSize;
+
+    // Every frame of the ring is the staging data of one batch, which is released
+    // when the batch fence reaches the batch number.
+    RingBuffer                 m_StagingRing;
+    RefCntAutoPtr<FenceVkImpl> m_pBatchFence;
+    Uint64                     m_NumSubmittedBatches = 0;
+
+    VulkanUtilities::CommandPoolWrapper m_CmdPool;
+    VkCommandBuffer                     m_vkCmdBuff          = VK_NULL_HANDLE;
+    size_t                              m_PendingStagingSize = 0;
+
+    ResourceUploadBatchStats m_Stats;
+};
+
+} // namespace Diligent
@@ -60,6 +60,9 @@ public:
     /// Implementation of IShaderResourceBinding::GetVariableByName() in Vulkan backend.
     virtual IShaderResourceVariable* DILIGENT_CALL_TYPE GetVariableByName(SHADER_TYPE ShaderType, const char* Name) override final;
 
+    /// Implementation of IShaderResourceBinding::GetVariableByHashedName() in Vulkan backend.
+    virtual IShaderResourceVariable* DILIGENT_CALL_TYPE GetVariableByHashedName(SHADER_TYPE ShaderType, const HashedShaderVariableName& Name) override final;
+
     /// Implementation of IShaderResourceBinding::GetVariableCount() in Vulkan backend.
     virtual Uint32 DILIGENT_CALL_TYPE GetVariableCount(SHADER_TYPE ShaderType) const override final;
 
@@ -52,8 +52,17 @@
 //
 // Descriptor set for static and mutable resources is assigned during cache initialization
 // Descriptor set for dynamic resources is assigned at every draw call
+//
+// When descriptor update templates are used, one descriptor set (the dynamic one) additionally keeps
+// descriptor data for every resource in a continuous array located after all resources. The data are
+// updated when resources are bound, so that the entire set can be written by a single call to
+// vkUpdateDescriptorSetWithTemplate():
+//
+//  | ... |  Res[m-1]  ||  Data[0]  |  ... |  Data[m-1]  |
 
 #include <vector>
+#include <mutex>
+#include <atomic>
 #include "DescriptorPoolManager.hpp"
 #include "SPIRVShaderResources.hpp"
 #include "BufferVkImpl.hpp"
@@ -63,7 +72,7 @@ namespace Diligent
 
 class DeviceContextVkImpl;
 
-// sizeof(ShaderResourceCacheVk) == 24 (x64, msvc, Release)
+// sizeof(ShaderResourceCacheVk) == 48 (x64, msvc, Release)
 class ShaderResourceCacheVk
 {
 public:
@@ -90,9 +99,10 @@ public:
 
     ~ShaderResourceCacheVk();
 
-    static size_t GetRequiredMemorySize(Uint32 NumSets, Uint32 SetSizes[]);
+    // DescriptorDataSet is the index of the set that keeps descriptor data for the update template, or -1
+    static size_t GetRequiredMemorySize(Uint32 NumSets, Uint32 SetSizes[], Int32 DescriptorDataSet = -1);
 
-    void InitializeSets(IMemoryAllocator& MemAllocator, Uint32 NumSets, Uint32 SetSizes[]);
+    void InitializeSets(IMemoryAllocator& MemAllocator, Uint32 NumSets, Uint32 SetSizes[], Int32 DescriptorDataSet = -1);
     void InitializeResources(Uint32 Set, Uint32 Offset, Uint32 ArraySize, SPIRVShaderResourceAttribs::ResourceType Type);
 
     // sizeof(Resource) == 16 (x64, msvc, Release)
@@ -120,14 +130,25 @@ public:
         // clang-format on
     };
 
-    // sizeof(DescriptorSet) == 48 (x64, msvc, Release)
+    // Descriptor data written by vkUpdateDescriptorSetWithTemplate(). Every resource in the
+    // set occupies one element; the element type is defined by the resource type.
+    // sizeof(DescriptorData) == 24 (x64)
+    union DescriptorData
+    {
+        VkDescriptorImageInfo  ImageInfo;
+        VkDescriptorBufferInfo BufferInfo;
+        VkBufferView           TexelBufferView;
+    };
+
+    // sizeof(DescriptorSet) == 56 (x64, msvc, Release)
     class DescriptorSet
     {
     public:
         // clang-format off
-        DescriptorSet(Uint32 NumResources, Resource *pResources) :
-            m_NumResources  {NumResources},
-            m_pResources    {pResources  }
+        DescriptorSet(Uint32 NumResources, Resource *pResources, DescriptorData* pDescriptorData) :
+            m_NumResources   {NumResources   },
+            m_pResources     {pResources     },
+            m_pDescriptorData{pDescriptorData}
         {}
 
         DescriptorSet             (const DescriptorSet&) = delete;
@@ -160,13 +181,20 @@ public:
             m_DescriptorSetAllocation = std::move(Allocation);
         }
 
+        // Returns descriptor data for the update template, or null if the set does not keep it
+        const DescriptorData* GetDescriptorData() const { return m_pDescriptorData; }
+
+        // Updates the descriptor data of the resource at the given offset from the cached object
+        void UpdateDescriptorData(Uint32 CacheOffset, bool IsImmutableSampler);
+
         // clang-format off
 /* 0 */ const Uint32 m_NumResources = 0;
 
     private:
-/* 8 */ Resource* const m_pResources = nullptr;
-/*16 */ DescriptorSetAllocation m_DescriptorSetAllocation;
-/*48 */ // End of structure
+/* 8 */ Resource* const       m_pResources      = nullptr;
+/*16 */ DescriptorData* const m_pDescriptorData = nullptr;
+/*24 */ DescriptorSetAllocation m_DescriptorSetAllocation;
+/*56 */ // End of structure
         // clang-format on
     };
 
@@ -196,6 +224,23 @@ public:
     template <bool VerifyOnly>
     void TransitionResources(DeviceContextVkImpl* pCtxVkImpl);
 
+    // Records a descriptor write for the resource at the given cache offset. Static and mutable
+    // resource descriptors are not written when the resources are bound; instead all pending writes
+    // are coalesced and submitted by a single vkUpdateDescriptorSets call when the SRB is committed.
+    void AddPendingDescriptorWrite(Uint32           Set,
+                                   Uint32           CacheOffset,
+                                   Uint32           Binding,
+                                   Uint32           ArrayElement,
+                                   VkDescriptorType DescriptorType,
+                                   bool             IsImmutableSampler);
+
+    bool HasPendingDescriptorWrites() const { return m_HasPendingWrites.load(); }
+
+    // Writes all pending descriptors. The same SRB may be committed by several contexts
+    // simultaneously, so the writes are flushed under the lock. Binding resources while
+    // the SRB is being committed by another thread is not allowed.
+    void FlushPendingDescriptorWrites(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice);
+
     __forceinline Uint32 GetDynamicBufferOffsets(Uint32 CtxId, DeviceContextVkImpl* pCtxVkImpl, std::vector<uint32_t>& Offsets) const;
 
 private:
@@ -215,6 +260,20 @@ private:
     Uint16 m_NumDynamicBuffers = 0;
     Uint32 m_TotalResources    = 0;
 
+    // sizeof(PendingWrite) == 20
+    struct PendingWrite
+    {
+        Uint32           CacheOffset;
+        Uint32           Binding;
+        Uint32           ArrayElement;
+        VkDescriptorType DescriptorType;
+        Uint16           Set;
+        bool             IsImmutableSampler;
+    };
+    std::vector<PendingWrite> m_PendingWrites;
+    std::mutex                m_PendingWritesMtx;
+    std::atomic_bool          m_HasPendingWrites{false};
+
 #ifdef DILIGENT_DEBUG
     // Only for debug purposes: indicates what types of resources are stored in the cache
     const DbgCacheContentType m_DbgContentType;
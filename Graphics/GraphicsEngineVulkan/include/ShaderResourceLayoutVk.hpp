@@ -208,13 +208,6 @@ public:
         // Binds a resource pObject in the ResourceCache
         void BindResource(IDeviceObject* pObject, Uint32 ArrayIndex, ShaderResourceCacheVk& ResourceCache) const;
 
-        // Updates resource descriptor in the descriptor set
-        inline void UpdateDescriptorHandle(VkDescriptorSet               vkDescrSet,
-                                           uint32_t                      ArrayElement,
-                                           const VkDescriptorImageInfo*  pImageInfo,
-                                           const VkDescriptorBufferInfo* pBufferInfo,
-                                           const VkBufferView*           pTexelBufferView) const;
-
         bool IsImmutableSamplerAssigned() const
         {
             VERIFY(ImmutableSamplerAssigned == 0 ||
@@ -232,32 +225,27 @@ public:
     private:
         void CacheUniformBuffer(IDeviceObject*                   pBuffer,
                                 ShaderResourceCacheVk::Resource& DstRes,
-                                VkDescriptorSet                  vkDescrSet,
                                 Uint32                           ArrayInd,
                                 Uint16&                          DynamicBuffersCounter) const;
 
         void CacheStorageBuffer(IDeviceObject*                   pBufferView,
                                 ShaderResourceCacheVk::Resource& DstRes,
-                                VkDescriptorSet                  vkDescrSet,
                                 Uint32                           ArrayInd,
                                 Uint16&                          DynamicBuffersCounter) const;
 
         void CacheTexelBuffer(IDeviceObject*                   pBufferView,
                               ShaderResourceCacheVk::Resource& DstRes,
-                              VkDescriptorSet                  vkDescrSet,
                               Uint32                           ArrayInd,
                               Uint16&                          DynamicBuffersCounter) const;
 
         template <typename TCacheSampler>
         void CacheImage(IDeviceObject*                   pTexView,
                         ShaderResourceCacheVk::Resource& DstRes,
-                        VkDescriptorSet                  vkDescrSet,
                         Uint32                           ArrayInd,
                         TCacheSampler                    CacheSampler) const;
 
         void CacheSeparateSampler(IDeviceObject*                   pSampler,
                                   ShaderResourceCacheVk::Resource& DstRes,
-                                  VkDescriptorSet                  vkDescrSet,
                                   Uint32                           ArrayInd) const;
 
         template <typename ObjectType, typename TPreUpdateObject>
@@ -63,28 +63,33 @@
 
 #include "ShaderResourceLayoutVk.hpp"
 #include "ShaderResourceVariableBase.hpp"
+#include "ShaderVariableNameIndex.hpp"
 
 namespace Diligent
 {
 
 class ShaderVariableVkImpl;
 
-// sizeof(ShaderVariableManagerVk) == 32 (x64, msvc, Release)
+// sizeof(ShaderVariableManagerVk) == 40 (x64, msvc, Release)
 class ShaderVariableManagerVk
 {
 public:
+    // pNameIndex is the name index built by InitNameIndex() for the same layout and allowed variable types.
+    // The index is owned by the pipeline state and is shared by all variable managers created from the layout.
     ShaderVariableManagerVk(IObject&                             Owner,
                             const ShaderResourceLayoutVk&        SrcLayout,
                             IMemoryAllocator&                    Allocator,
                             const SHADER_RESOURCE_VARIABLE_TYPE* AllowedVarTypes,
                             Uint32                               NumAllowedTypes,
-                            ShaderResourceCacheVk&               ResourceCache);
+                            ShaderResourceCacheVk&               ResourceCache,
+                            const ShaderVariableNameIndex*       pNameIndex = nullptr);
 
     ~ShaderVariableManagerVk();
 
     void DestroyVariables(IMemoryAllocator& Allocator);
 
     ShaderVariableVkImpl* GetVariable(const Char* Name);
+    ShaderVariableVkImpl* GetVariable(const HashedShaderVariableName& Name);
     ShaderVariableVkImpl* GetVariable(Uint32 Index);
 
     void BindResources(IResourceMapping* pResourceMapping, Uint32 Flags);
@@ -94,11 +99,21 @@ public:
                                         Uint32                               NumAllowedTypes,
                                         Uint32&                              NumVariables);
 
+    // Builds the name index for the variables that a manager created from the layout with
+    // the same allowed variable types will contain.
+    static void InitNameIndex(const ShaderResourceLayoutVk&        Layout,
+                              const SHADER_RESOURCE_VARIABLE_TYPE* AllowedVarTypes,
+                              Uint32                               NumAllowedTypes,
+                              ShaderVariableNameIndex&             NameIndex);
+
     Uint32 GetVariableCount() const { return m_NumVariables; }
 
 private:
     friend ShaderVariableVkImpl;
 
+    template <typename HandlerType>
+    static void ProcessLayoutResources(const ShaderResourceLayoutVk& Layout, Uint32 AllowedTypeBits, HandlerType Handler);
+
     Uint32 GetVariableIndex(const ShaderVariableVkImpl& Variable);
 
     IObject& m_Owner;
@@ -114,6 +129,8 @@ private:
     ShaderVariableVkImpl* m_pVariables   = nullptr;
     Uint32                m_NumVariables = 0;
 
+    const ShaderVariableNameIndex* const m_pNameIndex;
+
 #ifdef DILIGENT_DEBUG
     IMemoryAllocator& m_DbgAllocator;
 #endif
@@ -101,6 +101,11 @@ public:
 
     void InvalidateStagingRange(VkDeviceSize Offset, VkDeviceSize Size);
 
+    // Returns true if the texture shares memory with other transient textures (see MISC_TEXTURE_FLAG_TRANSIENT)
+    bool IsTransient() const { return static_cast<bool>(m_TransientAllocation); }
+
+    const TransientTextureAllocator::Allocation& GetTransientAllocation() const { return m_TransientAllocation; }
+
 protected:
     void CreateViewInternal(const struct TextureViewDesc& ViewDesc, ITextureView** ppView, bool bIsDefaultView) override;
     //void PrepareVkInitData(const TextureData &InitData, Uint32 NumSubresources, std::vector<Vk_SUBRESOURCE_DATA> &VkInitData);
@@ -112,6 +117,7 @@ protected:
     VulkanUtilities::ImageWrapper           m_VulkanImage;
     VulkanUtilities::BufferWrapper          m_StagingBuffer;
     VulkanUtilities::VulkanMemoryAllocation m_MemoryAllocation;
+    TransientTextureAllocator::Allocation   m_TransientAllocation;
     VkDeviceSize                            m_StagingDataAlignedOffset;
     bool                                    m_bCSBasedMipGenerationSupported = false;
 };
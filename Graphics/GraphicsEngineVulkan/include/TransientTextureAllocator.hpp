@@ -0,0 +1,168 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::TransientTextureAllocator class
+
+#include <mutex>
+#include <list>
+#include <vector>
+
+#include "Texture.h"
+#include "VulkanUtilities/VulkanMemoryManager.hpp"
+
+namespace Diligent
+{
+
+class RenderDeviceVkImpl;
+class TextureVkImpl;
+
+// Places the textures created with MISC_TEXTURE_FLAG_TRANSIENT flag into device memory heaps
+// shared by all transient textures. Memory ranges of two textures may overlap only if their
+// lifetimes (TextureDesc::TransientLifetime) do not overlap:
+//
+//     __________________________________________________________
+//    |  Texture A (passes 0-1)  |                               |
+//    |  Texture C (passes 2-3)  |  Texture B (passes 0-3)       |
+//    |__________________________|_______________________________|
+//    Heap start                                            Heap end
+//
+// At any time, only one of the textures that share memory holds valid contents. A texture takes
+// over its memory range when it is transitioned out of RESOURCE_STATE_UNDEFINED state (see Activate()).
+// The textures that alias the range are then returned to RESOURCE_STATE_UNDEFINED state.
+// Since the owner is resolved when the commands are recorded rather than when they are submitted,
+// transient textures may only be used by the immediate context.
+class TransientTextureAllocator
+{
+private:
+    struct Heap;
+    struct Placement;
+
+public:
+    // Textures that are larger than HeapSize are placed into the heaps of their own size.
+    TransientTextureAllocator(RenderDeviceVkImpl& DeviceVkImpl, VkDeviceSize HeapSize);
+    ~TransientTextureAllocator();
+
+    // clang-format off
+    TransientTextureAllocator             (const TransientTextureAllocator&) = delete;
+    TransientTextureAllocator             (TransientTextureAllocator&&)      = delete;
+    TransientTextureAllocator& operator = (const TransientTextureAllocator&) = delete;
+    TransientTextureAllocator& operator = (TransientTextureAllocator&&)      = delete;
+    // clang-format on
+
+    // Memory range occupied by a transient texture. The range is returned to the allocator when
+    // the object is destroyed, so the object must go through the release queue to keep the range
+    // occupied until the GPU is done with the texture.
+    class Allocation
+    {
+    public:
+        Allocation() noexcept {}
+        ~Allocation();
+
+        // clang-format off
+        Allocation             (Allocation&& rhs) noexcept;
+        Allocation& operator = (Allocation&& rhs) noexcept;
+        Allocation             (const Allocation&) = delete;
+        Allocation& operator = (const Allocation&) = delete;
+        // clang-format on
+
+        explicit operator bool() const { return m_pPlacement != nullptr; }
+
+        VkDeviceMemory GetVkMemory() const;
+        VkDeviceSize   GetOffset() const;
+
+    private:
+        friend TransientTextureAllocator;
+        Allocation(TransientTextureAllocator& Allocator, Heap& TexHeap, Placement& TexPlacement) noexcept;
+
+        TransientTextureAllocator* m_pAllocator = nullptr;
+        Heap*                      m_pHeap      = nullptr;
+        Placement*                 m_pPlacement = nullptr;
+    };
+
+    // Finds the memory range for the texture. The range is aligned as required by MemReqs.
+    Allocation Allocate(TextureVkImpl& Texture, const VkMemoryRequirements& MemReqs);
+
+    // Detaches the texture that is being destroyed from its memory range. LastLayout is the
+    // layout of the texture; the range will be synchronized with the textures that reuse it.
+    void OnTextureDestroyed(Allocation& TexAllocation, VkImageLayout LastLayout);
+
+    // Makes the texture the owner of its memory range. The textures that alias the range lose their
+    // contents and are returned to RESOURCE_STATE_UNDEFINED state. The layouts in which the aliasing
+    // textures may have accessed the memory are written to AliasedLayouts: all these accesses must be
+    // complete before the memory is used by the texture.
+    void Activate(const Allocation& TexAllocation, std::vector<VkImageLayout>& AliasedLayouts);
+
+private:
+    void Free(Heap& TexHeap, Placement& TexPlacement);
+
+    bool FindOffset(const Heap& TexHeap, const VkMemoryRequirements& MemReqs, const TransientTextureLifetime& Lifetime, VkDeviceSize& Offset) const;
+
+    struct Placement
+    {
+        TextureVkImpl*           pTexture; // Null when the texture has been destroyed
+        TransientTextureLifetime Lifetime;
+        VkDeviceSize             Offset;
+        VkDeviceSize             Size;
+
+        // The layout in which the memory range was last accessed by the texture
+        VkImageLayout LastLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        // Whether the texture currently owns its memory range
+        bool IsActive = false;
+
+        Placement(TextureVkImpl* _pTexture, const TransientTextureLifetime& _Lifetime, VkDeviceSize _Offset, VkDeviceSize _Size) noexcept :
+            // clang-format off
+            pTexture{_pTexture},
+            Lifetime{_Lifetime},
+            Offset  {_Offset  },
+            Size    {_Size    }
+        // clang-format on
+        {}
+
+        bool MemoryOverlaps(const Placement& rhs) const
+        {
+            return Offset < rhs.Offset + rhs.Size && rhs.Offset < Offset + Size;
+        }
+    };
+
+    struct Heap
+    {
+        VulkanUtilities::VulkanMemoryAllocation Memory;
+        uint32_t                                MemoryTypeIndex = 0;
+        std::list<Placement>                    Placements;
+    };
+
+    RenderDeviceVkImpl& m_DeviceVkImpl;
+    const VkDeviceSize  m_HeapSize;
+
+    std::mutex      m_Mtx;
+    std::list<Heap> m_Heaps;
+};
+
+} // namespace Diligent
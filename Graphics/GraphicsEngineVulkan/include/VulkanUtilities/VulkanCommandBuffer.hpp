@@ -27,6 +27,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "vulkan.h"
 #include "DebugUtilities.hpp"
 
@@ -54,6 +56,7 @@ public:
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
         VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "vkCmdClearColorImage() must be called outside of render pass (17.1)");
         VERIFY(Subresource.aspectMask == VK_IMAGE_ASPECT_COLOR_BIT, "The aspectMask of all image subresource ranges must only include VK_IMAGE_ASPECT_COLOR_BIT (17.1)");
+        FlushBarriers();
 
         vkCmdClearColorImage(
             m_VkCmdBuffer,
@@ -75,6 +78,7 @@ public:
                (Subresource.aspectMask & ~(VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT)) == 0,
                "The aspectMask of all image subresource ranges must only include VK_IMAGE_ASPECT_DEPTH_BIT or VK_IMAGE_ASPECT_STENCIL_BIT(17.1)");
         // clang-format on
+        FlushBarriers();
 
         vkCmdClearDepthStencilImage(
             m_VkCmdBuffer,
@@ -143,6 +147,7 @@ public:
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
         VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "vkCmdDispatch() must be called outside of render pass (27)");
         VERIFY(m_State.ComputePipeline != VK_NULL_HANDLE, "No compute pipeline bound");
+        FlushBarriers();
 
         vkCmdDispatch(m_VkCmdBuffer, GroupCountX, GroupCountY, GroupCountZ);
     }
@@ -152,15 +157,23 @@ public:
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
         VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "vkCmdDispatchIndirect() must be called outside of render pass (27)");
         VERIFY(m_State.ComputePipeline != VK_NULL_HANDLE, "No compute pipeline bound");
+        FlushBarriers();
 
         vkCmdDispatchIndirect(m_VkCmdBuffer, Buffer, Offset);
     }
 
-    __forceinline void BeginRenderPass(VkRenderPass RenderPass, VkFramebuffer Framebuffer, uint32_t FramebufferWidth, uint32_t FramebufferHeight)
+    __forceinline void BeginRenderPass(VkRenderPass      RenderPass,
+                                       VkFramebuffer     Framebuffer,
+                                       uint32_t          FramebufferWidth,
+                                       uint32_t          FramebufferHeight,
+                                       VkSubpassContents SubpassContents = VK_SUBPASS_CONTENTS_INLINE)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
         VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "Current pass has not been ended");
 
+        // Pending barriers must be recorded before the render pass instance begins
+        FlushBarriers();
+
         if (m_State.RenderPass != RenderPass || m_State.Framebuffer != Framebuffer)
         {
             VkRenderPassBeginInfo BeginInfo;
@@ -179,26 +192,51 @@ public:
                                                  // ignored (7.4)
 
             vkCmdBeginRenderPass(m_VkCmdBuffer, &BeginInfo,
-                                 VK_SUBPASS_CONTENTS_INLINE // the contents of the subpass will be recorded inline in the
-                                                            // primary command buffer, and secondary command buffers must not
-                                                            // be executed within the subpass
+                                 SubpassContents // VK_SUBPASS_CONTENTS_INLINE: the contents of the subpass will be recorded inline in the
+                                                 // primary command buffer, and secondary command buffers must not be executed within the subpass.
+                                                 // VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS: the contents are recorded in secondary command
+                                                 // buffers, and vkCmdExecuteCommands is the only valid command in the subpass (7.4)
             );
             m_State.RenderPass        = RenderPass;
             m_State.Framebuffer       = Framebuffer;
             m_State.FramebufferWidth  = FramebufferWidth;
             m_State.FramebufferHeight = FramebufferHeight;
+            m_State.SubpassContents   = SubpassContents;
         }
     }
 
+    // Makes the secondary command buffer continue the render pass that is begun by the primary
+    // command buffer executing it. The inherited render pass is never ended by this command buffer.
+    __forceinline void SetInheritedRenderPass(VkRenderPass RenderPass, VkFramebuffer Framebuffer, uint32_t FramebufferWidth, uint32_t FramebufferHeight)
+    {
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "Current pass has not been ended");
+        VERIFY(!HasPendingBarriers(), "Barriers can't be recorded inside the inherited render pass");
+
+        m_State.RenderPass          = RenderPass;
+        m_State.Framebuffer         = Framebuffer;
+        m_State.FramebufferWidth    = FramebufferWidth;
+        m_State.FramebufferHeight   = FramebufferHeight;
+        m_State.RenderPassInherited = true;
+    }
+
     __forceinline void EndRenderPass()
     {
         VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "Render pass has not been started");
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        if (m_State.RenderPassInherited)
+        {
+            LOG_ERROR_MESSAGE("Secondary command buffer can't end the render pass it inherits. Commands that must be recorded outside "
+                              "of render pass (copy, dispatch, clear or resource state transition commands) are not allowed in "
+                              "secondary command lists.");
+            return;
+        }
         vkCmdEndRenderPass(m_VkCmdBuffer);
         m_State.RenderPass        = VK_NULL_HANDLE;
         m_State.Framebuffer       = VK_NULL_HANDLE;
         m_State.FramebufferWidth  = 0;
         m_State.FramebufferHeight = 0;
+        m_State.SubpassContents   = VK_SUBPASS_CONTENTS_INLINE;
         if (m_State.InsidePassQueries != 0)
         {
             LOG_ERROR_MESSAGE("Ending render pass while there are outstanding queries that have been started inside the pass, "
@@ -208,14 +246,40 @@ public:
         }
     }
 
+    __forceinline void ExecuteCommands(uint32_t CommandBufferCount, const VkCommandBuffer* pCommandBuffers)
+    {
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        VERIFY(m_State.RenderPass != VK_NULL_HANDLE && m_State.SubpassContents == VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS,
+               "Secondary command buffers must be executed inside render pass begun with VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS (7.4)");
+
+        vkCmdExecuteCommands(m_VkCmdBuffer, CommandBufferCount, pCommandBuffers);
+
+        // The state bound in the primary command buffer becomes undefined after vkCmdExecuteCommands
+        m_State.GraphicsPipeline  = VK_NULL_HANDLE;
+        m_State.ComputePipeline   = VK_NULL_HANDLE;
+        m_State.IndexBuffer       = VK_NULL_HANDLE;
+        m_State.IndexBufferOffset = 0;
+        m_State.IndexType         = VK_INDEX_TYPE_MAX_ENUM;
+    }
+
     __forceinline void EndCommandBuffer()
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        FlushBarriers();
         vkEndCommandBuffer(m_VkCmdBuffer);
     }
 
     __forceinline void Reset()
     {
+        VERIFY(!HasPendingBarriers(), "Resetting command buffer with pending barriers");
+        m_ImageBarriers.clear();
+        m_BufferBarriers.clear();
+        m_PendingMemoryBarrier.srcAccessMask = 0;
+        m_PendingMemoryBarrier.dstAccessMask = 0;
+        m_MemoryBarrierPending               = false;
+        m_PendingSrcStages                   = 0;
+        m_PendingDstStages                   = 0;
+
         m_VkCmdBuffer = VK_NULL_HANDLE;
         m_State       = StateCache{};
     }
@@ -310,8 +374,12 @@ public:
             // Image layout transitions within a render pass execute
             // dependencies between attachments
             EndRenderPass();
+            if (m_State.RenderPass != VK_NULL_HANDLE)
+                return; // Inherited render pass can't be ended
         }
-        TransitionImageLayout(m_VkCmdBuffer, Image, OldLayout, NewLayout, SubresRange, m_EnabledGraphicsShaderStages, SrcStages, DestStages);
+        // The barrier is not recorded immediately, but is merged with other pending barriers
+        // into a single vkCmdPipelineBarrier() issued before the next command that may depend on it.
+        AddImageBarrier(Image, OldLayout, NewLayout, SubresRange, SrcStages, DestStages);
     }
 
 
@@ -321,13 +389,18 @@ public:
                                     VkAccessFlags        dstAccessMask,
                                     VkPipelineStageFlags EnabledGraphicsShaderStages,
                                     VkPipelineStageFlags SrcStages  = 0,
-                                    VkPipelineStageFlags DestStages = 0);
+                                    VkPipelineStageFlags DestStages = 0,
+                                    VkDeviceSize         Offset     = 0,
+                                    VkDeviceSize         Size       = VK_WHOLE_SIZE);
 
+    // Offset and Size define the range of the buffer affected by the barrier
     __forceinline void BufferMemoryBarrier(VkBuffer             Buffer,
                                            VkAccessFlags        srcAccessMask,
                                            VkAccessFlags        dstAccessMask,
                                            VkPipelineStageFlags SrcStages  = 0,
-                                           VkPipelineStageFlags DestStages = 0)
+                                           VkPipelineStageFlags DestStages = 0,
+                                           VkDeviceSize         Offset     = 0,
+                                           VkDeviceSize         Size       = VK_WHOLE_SIZE)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
         if (m_State.RenderPass != VK_NULL_HANDLE)
@@ -335,8 +408,24 @@ public:
             // Image layout transitions within a render pass execute
             // dependencies between attachments
             EndRenderPass();
+            if (m_State.RenderPass != VK_NULL_HANDLE)
+                return; // Inherited render pass can't be ended
         }
-        BufferMemoryBarrier(m_VkCmdBuffer, Buffer, srcAccessMask, dstAccessMask, m_EnabledGraphicsShaderStages, SrcStages, DestStages);
+        AddBufferBarrier(Buffer, srcAccessMask, dstAccessMask, SrcStages, DestStages, Offset, Size);
+    }
+
+    // Makes sure that all accesses to the memory of a resource that was last used in PrevLayout are
+    // complete before the memory is accessed by another resource that aliases it in NewLayout
+    __forceinline void AliasingBarrier(VkImageLayout PrevLayout, VkImageLayout NewLayout)
+    {
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        if (m_State.RenderPass != VK_NULL_HANDLE)
+        {
+            EndRenderPass();
+            if (m_State.RenderPass != VK_NULL_HANDLE)
+                return; // Inherited render pass can't be ended
+        }
+        AddAliasingBarrier(PrevLayout, NewLayout);
     }
 
     __forceinline void BindDescriptorSets(VkPipelineBindPoint    pipelineBindPoint,
@@ -362,6 +451,7 @@ public:
             // Copy buffer operation must be performed outside of render pass.
             EndRenderPass();
         }
+        FlushBarriers();
         vkCmdCopyBuffer(m_VkCmdBuffer, srcBuffer, dstBuffer, regionCount, pRegions);
     }
 
@@ -378,7 +468,7 @@ public:
             // Copy operations must be performed outside of render pass.
             EndRenderPass();
         }
-
+        FlushBarriers();
         vkCmdCopyImage(m_VkCmdBuffer, srcImage, srcImageLayout, dstImage, dstImageLayout, regionCount, pRegions);
     }
 
@@ -394,7 +484,7 @@ public:
             // Copy operations must be performed outside of render pass.
             EndRenderPass();
         }
-
+        FlushBarriers();
         vkCmdCopyBufferToImage(m_VkCmdBuffer, srcBuffer, dstImage, dstImageLayout, regionCount, pRegions);
     }
 
@@ -410,7 +500,7 @@ public:
             // Copy operations must be performed outside of render pass.
             EndRenderPass();
         }
-
+        FlushBarriers();
         vkCmdCopyImageToBuffer(m_VkCmdBuffer, srcImage, srcImageLayout, dstBuffer, regionCount, pRegions);
     }
 
@@ -428,7 +518,7 @@ public:
             // Blit must be performed outside of render pass.
             EndRenderPass();
         }
-
+        FlushBarriers();
         vkCmdBlitImage(m_VkCmdBuffer, srcImage, srcImageLayout, dstImage, dstImageLayout, regionCount, pRegions, filter);
     }
 
@@ -445,6 +535,7 @@ public:
             // Resolve must be performed outside of render pass.
             EndRenderPass();
         }
+        FlushBarriers();
         vkCmdResolveImage(m_VkCmdBuffer, srcImage, srcImageLayout, dstImage, dstImageLayout, regionCount, pRegions);
     }
 
@@ -498,6 +589,7 @@ public:
                                       uint32_t                query)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        FlushBarriers();
         vkCmdWriteTimestamp(m_VkCmdBuffer, pipelineStage, queryPool, query);
     }
 
@@ -511,6 +603,7 @@ public:
             // Query pool reset must be performed outside of render pass (17.2).
             EndRenderPass();
         }
+        FlushBarriers();
         vkCmdResetQueryPool(m_VkCmdBuffer, queryPool, firstQuery, queryCount);
     }
 
@@ -528,11 +621,31 @@ public:
             // Copy query results must be performed outside of render pass (17.2).
             EndRenderPass();
         }
+        FlushBarriers();
         vkCmdCopyQueryPoolResults(m_VkCmdBuffer, queryPool, firstQuery, queryCount,
                                   dstBuffer, dstOffset, stride, flags);
     }
 
-    void FlushBarriers();
+    // Records all pending memory, image and buffer barriers with a single vkCmdPipelineBarrier() command
+    __forceinline void FlushBarriers()
+    {
+        if (HasPendingBarriers())
+            RecordPendingBarriers();
+    }
+
+    bool HasPendingBarriers() const
+    {
+        return !m_ImageBarriers.empty() || !m_BufferBarriers.empty() || m_MemoryBarrierPending;
+    }
+
+    struct BarrierStatistics
+    {
+        uint64_t NumImageBarriers    = 0; // Total number of image memory barriers issued
+        uint64_t NumBufferBarriers   = 0; // Total number of buffer memory barriers issued
+        uint64_t NumBarrierCommands  = 0; // Total number of vkCmdPipelineBarrier() commands recorded
+        uint64_t NumAliasingBarriers = 0; // Total number of memory barriers issued for resources that alias memory
+    };
+    const BarrierStatistics& GetBarrierStatistics() const { return m_BarrierStats; }
 
     __forceinline void SetVkCmdBuffer(VkCommandBuffer VkCmdBuffer)
     {
@@ -553,14 +666,46 @@ public:
         uint32_t      FramebufferHeight  = 0;
         uint32_t      InsidePassQueries  = 0;
         uint32_t      OutsidePassQueries = 0;
+
+        VkSubpassContents SubpassContents     = VK_SUBPASS_CONTENTS_INLINE;
+        bool              RenderPassInherited = false;
     };
 
     const StateCache& GetState() const { return m_State; }
 
 private:
+    void AddImageBarrier(VkImage                        Image,
+                         VkImageLayout                  OldLayout,
+                         VkImageLayout                  NewLayout,
+                         const VkImageSubresourceRange& SubresRange,
+                         VkPipelineStageFlags           SrcStages,
+                         VkPipelineStageFlags           DestStages);
+
+    void AddBufferBarrier(VkBuffer             Buffer,
+                          VkAccessFlags        srcAccessMask,
+                          VkAccessFlags        dstAccessMask,
+                          VkPipelineStageFlags SrcStages,
+                          VkPipelineStageFlags DestStages,
+                          VkDeviceSize         Offset,
+                          VkDeviceSize         Size);
+
+    void AddAliasingBarrier(VkImageLayout PrevLayout, VkImageLayout NewLayout);
+
+    void RecordPendingBarriers();
+
     StateCache                 m_State;
     VkCommandBuffer            m_VkCmdBuffer = VK_NULL_HANDLE;
     const VkPipelineStageFlags m_EnabledGraphicsShaderStages;
+
+    // Barriers that have been issued, but not yet recorded into the command buffer
+    std::vector<VkImageMemoryBarrier>  m_ImageBarriers;
+    std::vector<VkBufferMemoryBarrier> m_BufferBarriers;
+    VkMemoryBarrier                    m_PendingMemoryBarrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER, nullptr, 0, 0};
+    bool                               m_MemoryBarrierPending = false;
+    VkPipelineStageFlags               m_PendingSrcStages     = 0;
+    VkPipelineStageFlags               m_PendingDstStages     = 0;
+
+    BarrierStatistics m_BarrierStats;
 };
 
 } // namespace VulkanUtilities
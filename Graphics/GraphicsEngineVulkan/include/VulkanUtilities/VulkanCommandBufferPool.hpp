@@ -54,9 +54,11 @@ public:
 
     ~VulkanCommandBufferPool();
 
-    VkCommandBuffer GetCommandBuffer(const char* DebugName = "");
+    // When pInheritanceInfo is not null, a secondary command buffer that continues the
+    // render pass specified by the inheritance info is returned
+    VkCommandBuffer GetCommandBuffer(const char* DebugName = "", const VkCommandBufferInheritanceInfo* pInheritanceInfo = nullptr);
     // The GPU must have finished with the command buffer being returned to the pool
-    void FreeCommandBuffer(VkCommandBuffer&& CmdBuffer);
+    void FreeCommandBuffer(VkCommandBuffer&& CmdBuffer, VkCommandBufferLevel Level = VK_COMMAND_BUFFER_LEVEL_PRIMARY);
 
     CommandPoolWrapper&& Release();
 
@@ -74,6 +76,7 @@ private:
 
     std::mutex                  m_Mutex;
     std::deque<VkCommandBuffer> m_CmdBuffers;
+    std::deque<VkCommandBuffer> m_SecondaryCmdBuffers;
 #ifdef DILIGENT_DEVELOPMENT
     std::atomic_int32_t m_BuffCounter;
 #endif
@@ -64,6 +64,9 @@ public:
     bool IsLayerAvailable    (const char* LayerName)    const;
     bool IsExtensionAvailable(const char* ExtensionName)const;
 
+    // Returns true if VK_KHR_get_physical_device_properties2 extension is enabled
+    bool IsPhysicalDeviceProperties2Enabled()const{return m_PhysicalDeviceProperties2Enabled;}
+
     VkPhysicalDevice SelectPhysicalDevice()const;
 
     VkAllocationCallbacks* GetVkAllocator()const{return m_pVkAllocator;}
@@ -76,7 +79,8 @@ private:
                    const char* const*     ppGlobalExtensionNames,
                    VkAllocationCallbacks* pVkAllocator);
 
-    bool                         m_DebugUtilsEnabled = false;
+    bool                         m_DebugUtilsEnabled                = false;
+    bool                         m_PhysicalDeviceProperties2Enabled = false;
     VkAllocationCallbacks* const m_pVkAllocator;
     VkInstance                   m_VkInstance = VK_NULL_HANDLE;
 
@@ -57,7 +57,9 @@ enum class VulkanHandleTypeId : uint32_t
     Semaphore,
     Queue,
     Event,
-    QueryPool
+    QueryPool,
+    PipelineCache,
+    DescriptorUpdateTemplate
 };
 
 template <typename VulkanObjectType, VulkanHandleTypeId>
@@ -81,6 +83,9 @@ using DescriptorPoolWrapper      = DEFINE_VULKAN_OBJECT_WRAPPER(DescriptorPool);
 using DescriptorSetLayoutWrapper = DEFINE_VULKAN_OBJECT_WRAPPER(DescriptorSetLayout);
 using SemaphoreWrapper           = DEFINE_VULKAN_OBJECT_WRAPPER(Semaphore);
 using QueryPoolWrapper           = DEFINE_VULKAN_OBJECT_WRAPPER(QueryPool);
+using PipelineCacheWrapper       = DEFINE_VULKAN_OBJECT_WRAPPER(PipelineCache);
+// Descriptor update templates are provided by VK_KHR_descriptor_update_template extension
+using DescriptorUpdateTemplateWrapper = DEFINE_VULKAN_OBJECT_WRAPPER(DescriptorUpdateTemplate);
 #undef DEFINE_VULKAN_OBJECT_WRAPPER
 
 class VulkanLogicalDevice : public std::enable_shared_from_this<VulkanLogicalDevice>
@@ -141,6 +146,10 @@ public:
     SemaphoreWrapper    CreateSemaphore(const VkSemaphoreCreateInfo& SemaphoreCI, const char* DebugName = "") const;
     QueryPoolWrapper    CreateQueryPool(const VkQueryPoolCreateInfo& QueryPoolCI, const char* DebugName = "") const;
 
+    PipelineCacheWrapper CreatePipelineCache(const VkPipelineCacheCreateInfo& PipelineCacheCI, const char* DebugName = "") const;
+
+    DescriptorUpdateTemplateWrapper CreateDescriptorUpdateTemplate(const VkDescriptorUpdateTemplateCreateInfoKHR& TemplateCI, const char* DebugName = "") const;
+
     VkCommandBuffer     AllocateVkCommandBuffer(const VkCommandBufferAllocateInfo& AllocInfo, const char* DebugName = "") const;
     VkDescriptorSet     AllocateVkDescriptorSet(const VkDescriptorSetAllocateInfo& AllocInfo, const char* DebugName = "") const;
 
@@ -161,12 +170,19 @@ public:
     void ReleaseVulkanObject(DescriptorSetLayoutWrapper&& DescriptorSetLayout) const;
     void ReleaseVulkanObject(SemaphoreWrapper&&     Semaphore) const;
     void ReleaseVulkanObject(QueryPoolWrapper&&     QueryPool) const;
+    void ReleaseVulkanObject(PipelineCacheWrapper&& PipelineCache) const;
+    void ReleaseVulkanObject(DescriptorUpdateTemplateWrapper&& DescriptorUpdateTemplate) const;
 
     void FreeDescriptorSet(VkDescriptorPool Pool, VkDescriptorSet Set) const;
 
     VkMemoryRequirements GetBufferMemoryRequirements(VkBuffer vkBuffer) const;
     VkMemoryRequirements GetImageMemoryRequirements (VkImage vkImage  ) const;
 
+    // Also queries whether the resource prefers or requires a dedicated allocation. If VK_KHR_dedicated_allocation
+    // is not enabled, both requiresDedicatedAllocation and prefersDedicatedAllocation are set to VK_FALSE.
+    VkMemoryRequirements GetBufferMemoryRequirements(VkBuffer vkBuffer, VkMemoryDedicatedRequirementsKHR& DedicatedReqs) const;
+    VkMemoryRequirements GetImageMemoryRequirements (VkImage vkImage,   VkMemoryDedicatedRequirementsKHR& DedicatedReqs) const;
+
     VkResult BindBufferMemory(VkBuffer buffer, VkDeviceMemory memory, VkDeviceSize memoryOffset) const;
     VkResult BindImageMemory (VkImage image,   VkDeviceMemory memory, VkDeviceSize memoryOffset) const;
     // clang-format on
@@ -189,9 +205,19 @@ public:
                               uint32_t                    descriptorCopyCount,
                               const VkCopyDescriptorSet*  pDescriptorCopies) const;
 
+    // Writes all descriptors of the set at once using the template.
+    // VK_KHR_descriptor_update_template extension must be enabled.
+    void UpdateDescriptorSetWithTemplate(VkDescriptorSet               descriptorSet,
+                                         VkDescriptorUpdateTemplateKHR descriptorUpdateTemplate,
+                                         const void*                   pData) const;
+
     VkResult ResetCommandPool(VkCommandPool           vkCmdPool,
                               VkCommandPoolResetFlags flags = 0) const;
 
+    VkResult GetPipelineCacheData(VkPipelineCache pipelineCache,
+                                  size_t*         pDataSize,
+                                  void*           pData) const;
+
     VkResult ResetDescriptorPool(VkDescriptorPool           descriptorPool,
                                  VkDescriptorPoolResetFlags flags = 0) const;
 
@@ -207,7 +233,13 @@ public:
                                      dataSize, pData, stride, flags);
     }
 
-    VkPipelineStageFlags GetEnabledGraphicsShaderStages() const { return m_EnabledGraphicsShaderStages; }
+    VkPipelineStageFlags            GetEnabledGraphicsShaderStages() const { return m_EnabledGraphicsShaderStages; }
+    const VkPhysicalDeviceFeatures& GetEnabledFeatures() const { return m_EnabledFeatures; }
+
+    bool IsDescriptorUpdateTemplateEnabled() const { return m_vkUpdateDescriptorSetWithTemplate != nullptr; }
+    bool IsDescriptorIndexingEnabled() const { return m_DescriptorIndexingEnabled; }
+    bool IsDedicatedAllocationEnabled() const { return m_vkGetImageMemoryRequirements2 != nullptr; }
+    bool IsMemoryBudgetEnabled() const { return m_MemoryBudgetEnabled; }
 
 private:
     VulkanLogicalDevice(VkPhysicalDevice             vkPhysicalDevice,
@@ -226,6 +258,18 @@ private:
     VkDevice                           m_VkDevice = VK_NULL_HANDLE;
     const VkAllocationCallbacks* const m_VkAllocator;
     VkPipelineStageFlags               m_EnabledGraphicsShaderStages = 0;
+    VkPhysicalDeviceFeatures           m_EnabledFeatures             = {};
+    bool                               m_DescriptorIndexingEnabled   = false;
+    bool                               m_MemoryBudgetEnabled         = false;
+
+    // VK_KHR_descriptor_update_template entry points. All are null if the extension is not enabled.
+    PFN_vkCreateDescriptorUpdateTemplateKHR  m_vkCreateDescriptorUpdateTemplate  = nullptr;
+    PFN_vkDestroyDescriptorUpdateTemplateKHR m_vkDestroyDescriptorUpdateTemplate = nullptr;
+    PFN_vkUpdateDescriptorSetWithTemplateKHR m_vkUpdateDescriptorSetWithTemplate = nullptr;
+
+    // VK_KHR_get_memory_requirements2 entry points. Only loaded when VK_KHR_dedicated_allocation is also enabled.
+    PFN_vkGetBufferMemoryRequirements2KHR m_vkGetBufferMemoryRequirements2 = nullptr;
+    PFN_vkGetImageMemoryRequirements2KHR  m_vkGetImageMemoryRequirements2  = nullptr;
 };
 
 } // namespace VulkanUtilities
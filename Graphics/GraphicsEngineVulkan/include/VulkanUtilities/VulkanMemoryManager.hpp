@@ -29,15 +29,18 @@
 
 #include <mutex>
 #include <array>
-#include <unordered_map>
+#include <list>
+#include <vector>
 #include <atomic>
 #include <string>
+#include <memory>
 #include "MemoryAllocator.h"
 #include "VariableSizeAllocationsManager.hpp"
+#include "TLSFAllocationsManager.hpp"
+#include "BestFitPageIndex.hpp"
 #include "VulkanUtilities/VulkanPhysicalDevice.hpp"
 #include "VulkanUtilities/VulkanLogicalDevice.hpp"
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
-#include "HashUtils.hpp"
 
 namespace VulkanUtilities
 {
@@ -92,54 +95,85 @@ struct VulkanMemoryAllocation
     VkDeviceSize      Size            = 0;       // Reserved size of this allocation
 };
 
+// Memory statistics of a single device memory heap, see VulkanMemoryManager::GetHeapStats()
+struct VulkanMemoryHeapStats
+{
+    VkDeviceSize HeapSize                = 0;
+    VkDeviceSize Budget                  = 0; // Reported by VK_EXT_memory_budget or estimated as 80% of the heap size
+    VkDeviceSize Usage                   = 0; // Usage of the heap by the process, estimated between budget queries
+    VkDeviceSize AllocatedSize           = 0; // Device memory allocated by the manager, including empty pages
+    VkDeviceSize UsedSize                = 0; // Total size of live allocations
+    uint32_t     NumPages                = 0;
+    uint32_t     NumDedicatedAllocations = 0;
+    bool         IsDeviceLocal           = false;
+    bool         IsBudgetReported        = false; // True if VK_EXT_memory_budget is enabled
+};
+
 class VulkanMemoryPage
 {
 public:
-    VulkanMemoryPage(VulkanMemoryManager& ParentMemoryMgr,
-                     VkDeviceSize         PageSize,
-                     uint32_t             MemoryTypeIndex,
-                     bool                 IsHostVisible) noexcept;
+    // Pages sorted by the size of their largest free block
+    using FreeBlockIndexType = Diligent::BestFitPageIndex<VulkanMemoryPage, VkDeviceSize>;
+
+    VulkanMemoryPage(VulkanMemoryManager&                    ParentMemoryMgr,
+                     VkDeviceSize                            PageSize,
+                     uint32_t                                MemoryTypeIndex,
+                     bool                                    IsHostVisible,
+                     bool                                    IsDedicated         = false,
+                     const VkMemoryDedicatedAllocateInfoKHR* pDedicatedAllocInfo = nullptr) noexcept;
     ~VulkanMemoryPage();
 
     // clang-format off
-    VulkanMemoryPage(VulkanMemoryPage&& rhs)noexcept :
-        m_ParentMemoryMgr {rhs.m_ParentMemoryMgr         },
-        m_AllocationMgr   {std::move(rhs.m_AllocationMgr)},
-        m_VkMemory        {std::move(rhs.m_VkMemory)     },
-        m_CPUMemory       {rhs.m_CPUMemory               }
-    {
-        rhs.m_CPUMemory = nullptr;
-    }
-
-    VulkanMemoryPage            (const VulkanMemoryPage&) = delete;
-    VulkanMemoryPage& operator= (VulkanMemoryPage&)       = delete;
-    VulkanMemoryPage& operator= (VulkanMemoryPage&& rhs)  = delete;
+    // Pages are never moved as allocations keep pointers to them
+    VulkanMemoryPage            (const VulkanMemoryPage&)  = delete;
+    VulkanMemoryPage            (VulkanMemoryPage&&)       = delete;
+    VulkanMemoryPage& operator= (const VulkanMemoryPage&)  = delete;
+    VulkanMemoryPage& operator= (VulkanMemoryPage&&)       = delete;
     
-    bool IsEmpty() const { return m_AllocationMgr.IsEmpty(); }
-    bool IsFull()  const { return m_AllocationMgr.IsFull();  }
-    VkDeviceSize GetPageSize() const { return m_AllocationMgr.GetMaxSize();  }
-    VkDeviceSize GetUsedSize() const { return m_AllocationMgr.GetUsedSize(); }
-
+    bool IsEmpty() const { return m_TLSFAllocationMgr ? m_TLSFAllocationMgr->IsEmpty() : m_VarSizeAllocationMgr->IsEmpty(); }
+    bool IsFull()  const { return m_TLSFAllocationMgr ? m_TLSFAllocationMgr->IsFull()  : m_VarSizeAllocationMgr->IsFull();  }
+    VkDeviceSize GetPageSize() const { return m_TLSFAllocationMgr ? m_TLSFAllocationMgr->GetMaxSize()  : m_VarSizeAllocationMgr->GetMaxSize();  }
+    VkDeviceSize GetUsedSize() const { return m_TLSFAllocationMgr ? m_TLSFAllocationMgr->GetUsedSize() : m_VarSizeAllocationMgr->GetUsedSize(); }
+    uint32_t     GetMemoryTypeIndex() const { return m_MemoryTypeIndex; }
+    // Dedicated pages hold a single allocation and are destroyed when it is released
+    bool         IsDedicated()        const { return m_IsDedicated; }
     // clang-format on
 
-    VulkanMemoryAllocation Allocate(VkDeviceSize size, VkDeviceSize alignment);
-
     VkDeviceMemory GetVkMemory() const { return m_VkMemory; }
     void*          GetCPUMemory() const { return m_CPUMemory; }
 
 private:
+    // Both managers use the same offset type and Allocation struct
     using AllocationsMgrOffsetType = Diligent::VariableSizeAllocationsManager::OffsetType;
 
     friend struct VulkanMemoryAllocation;
+    friend class VulkanMemoryManager;
+
+    // The page is not thread-safe. The parent manager serializes all allocations
+    // and deallocations using the mutex of the page's memory type shard.
+    VulkanMemoryAllocation Allocate(VkDeviceSize size, VkDeviceSize alignment);
 
     // Memory is reclaimed immediately. The application is responsible to ensure it is not in use by the GPU
     void Free(VulkanMemoryAllocation&& Allocation);
 
-    VulkanMemoryManager&                     m_ParentMemoryMgr;
-    std::mutex                               m_Mutex;
-    Diligent::VariableSizeAllocationsManager m_AllocationMgr;
-    VulkanUtilities::DeviceMemoryWrapper     m_VkMemory;
-    void*                                    m_CPUMemory = nullptr;
+    // Returns the range to the allocations manager
+    void FreeRange(AllocationsMgrOffsetType Offset, AllocationsMgrOffsetType Size);
+
+    VkDeviceSize GetMaxFreeBlockSize() const;
+
+    VulkanMemoryManager& m_ParentMemoryMgr;
+    const uint32_t       m_MemoryTypeIndex;
+    const bool           m_IsDedicated;
+
+    // Only one of the managers is created, see VulkanMemoryManager::m_UseTLSFPageAllocator
+    std::unique_ptr<Diligent::VariableSizeAllocationsManager> m_VarSizeAllocationMgr;
+    std::unique_ptr<Diligent::TLSFAllocationsManager>         m_TLSFAllocationMgr;
+
+    VulkanUtilities::DeviceMemoryWrapper m_VkMemory;
+    void*                                m_CPUMemory = nullptr;
+
+    // Position of this page in the free block index of its memory type shard
+    FreeBlockIndexType::Handle m_FreeBlockIndexHandle;
 };
 
 class VulkanMemoryManager
@@ -153,7 +187,8 @@ public:
                         VkDeviceSize                 DeviceLocalPageSize,
                         VkDeviceSize                 HostVisiblePageSize,
                         VkDeviceSize                 DeviceLocalReserveSize,
-                        VkDeviceSize                 HostVisibleReserveSize) : 
+                        VkDeviceSize                 HostVisibleReserveSize,
+                        bool                         UseTLSFPageAllocator = false) : 
         m_MgrName               {std::move(MgrName)    },
         m_LogicalDevice         {LogicalDevice         },
         m_PhysicalDevice        {PhysicalDevice        },
@@ -161,8 +196,13 @@ public:
         m_DeviceLocalPageSize   {DeviceLocalPageSize   },
         m_HostVisiblePageSize   {HostVisiblePageSize   },
         m_DeviceLocalReserveSize{DeviceLocalReserveSize},
-        m_HostVisibleReserveSize{HostVisibleReserveSize}
-    {}
+        m_HostVisibleReserveSize{HostVisibleReserveSize},
+        m_UseTLSFPageAllocator  {UseTLSFPageAllocator  },
+        m_Shards                (PhysicalDevice.GetMemoryProperties().memoryTypeCount * 2),
+        m_Heaps                 (PhysicalDevice.GetMemoryProperties().memoryHeapCount)
+    {
+        UpdateMemoryBudget();
+    }
 
 
     // We have to write this constructor because on msvc default
@@ -173,21 +213,24 @@ public:
         m_LogicalDevice   {rhs.m_LogicalDevice     },
         m_PhysicalDevice  {rhs.m_PhysicalDevice    },
         m_Allocator       {rhs.m_Allocator         },
-        m_Pages           {std::move(rhs.m_Pages)  },
     
         m_DeviceLocalPageSize    {rhs.m_DeviceLocalPageSize   },
         m_HostVisiblePageSize    {rhs.m_HostVisiblePageSize   },
         m_DeviceLocalReserveSize {rhs.m_DeviceLocalReserveSize},
         m_HostVisibleReserveSize {rhs.m_HostVisibleReserveSize},
-    
-        //m_CurrUsedSize      {rhs.m_CurrUsedSize},
-        m_PeakUsedSize      {rhs.m_PeakUsedSize     },
-        m_CurrAllocatedSize {rhs.m_CurrAllocatedSize},
-        m_PeakAllocatedSize {rhs.m_PeakAllocatedSize}
+        m_UseTLSFPageAllocator   {rhs.m_UseTLSFPageAllocator  },
+
+        m_Shards {std::move(rhs.m_Shards)},
+        m_Heaps  {std::move(rhs.m_Heaps) }
     {
         // clang-format on
         for (size_t i = 0; i < m_CurrUsedSize.size(); ++i)
+        {
             m_CurrUsedSize[i].store(rhs.m_CurrUsedSize[i].load());
+            m_PeakUsedSize[i].store(rhs.m_PeakUsedSize[i].load());
+            m_CurrAllocatedSize[i].store(rhs.m_CurrAllocatedSize[i].load());
+            m_PeakAllocatedSize[i].store(rhs.m_PeakAllocatedSize[i].load());
+        }
     }
 
     ~VulkanMemoryManager();
@@ -200,7 +243,24 @@ public:
 
     VulkanMemoryAllocation Allocate(VkDeviceSize Size, VkDeviceSize Alignment, uint32_t MemoryTypeIndex, bool HostVisible);
     VulkanMemoryAllocation Allocate(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProps);
-    void                   ShrinkMemory();
+
+    // Allocates memory for the buffer or the image (the other handle must be null). If the resource
+    // prefers or requires a dedicated allocation (VK_KHR_dedicated_allocation), it gets its own memory object.
+    VulkanMemoryAllocation Allocate(const VkMemoryRequirements&             MemReqs,
+                                    VkMemoryPropertyFlags                   MemoryProps,
+                                    const VkMemoryDedicatedRequirementsKHR& DedicatedReqs,
+                                    VkBuffer                                vkBuffer,
+                                    VkImage                                 vkImage);
+
+    // Releases empty pages that exceed the reserve size. When a heap is close to its
+    // budget, all empty pages of this heap are released regardless of the reserve size.
+    void ShrinkMemory();
+
+    // Queries the current memory budget if VK_EXT_memory_budget is enabled
+    void UpdateMemoryBudget();
+
+    uint32_t GetHeapCount() const { return static_cast<uint32_t>(m_Heaps.size()); }
+    void     GetHeapStats(uint32_t HeapIndex, VulkanMemoryHeapStats& Stats);
 
 protected:
     friend class VulkanMemoryPage;
@@ -215,48 +275,91 @@ protected:
 
     Diligent::IMemoryAllocator& m_Allocator;
 
-    std::mutex m_PagesMtx;
-    struct MemoryPageIndex
-    {
-        const uint32_t MemoryTypeIndex;
-        const bool     IsHostVisible;
+    const VkDeviceSize m_DeviceLocalPageSize;
+    const VkDeviceSize m_HostVisiblePageSize;
+    const VkDeviceSize m_DeviceLocalReserveSize;
+    const VkDeviceSize m_HostVisibleReserveSize;
 
-        // clang-format off
-        MemoryPageIndex(uint32_t _MemoryTypeIndex,
-                        bool     _IsHostVisible) : 
-            MemoryTypeIndex(_MemoryTypeIndex),
-            IsHostVisible  (_IsHostVisible)
-        {}
+    // Whether pages are suballocated by Diligent::TLSFAllocationsManager rather than by
+    // Diligent::VariableSizeAllocationsManager (see EngineVkCreateInfo::UseTLSFMemoryPageAllocator)
+    const bool m_UseTLSFPageAllocator;
 
-        bool operator == (const MemoryPageIndex& rhs)const
-        {
-            return MemoryTypeIndex == rhs.MemoryTypeIndex &&
-                   IsHostVisible   == rhs.IsHostVisible;
-        }
-        // clang-format on
+    // Pages of a single memory type. Host-visible and device-local pages of the same memory type
+    // are kept in separate shards (see Allocate()). Every shard is protected by its own mutex, so that
+    // threads allocating memory of different types never contend.
+    struct MemoryTypeShard
+    {
+        std::mutex Mtx;
 
-        struct Hasher
-        {
-            size_t operator()(const MemoryPageIndex& PageIndex) const
-            {
-                return Diligent::ComputeHash(PageIndex.MemoryTypeIndex, PageIndex.IsHostVisible);
-            }
-        };
+        // Pages are kept in a list as allocations reference them by pointer
+        std::list<VulkanMemoryPage> Pages;
+
+        // Allows finding the best-fitting page in O(log n)
+        VulkanMemoryPage::FreeBlockIndexType PagesByFreeBlockSize;
     };
-    std::unordered_multimap<MemoryPageIndex, VulkanMemoryPage, MemoryPageIndex::Hasher> m_Pages;
 
-    const VkDeviceSize m_DeviceLocalPageSize;
-    const VkDeviceSize m_HostVisiblePageSize;
-    const VkDeviceSize m_DeviceLocalReserveSize;
-    const VkDeviceSize m_HostVisibleReserveSize;
+    MemoryTypeShard& GetShard(uint32_t MemoryTypeIndex, bool HostVisible)
+    {
+        VERIFY_EXPR(MemoryTypeIndex * 2 < m_Shards.size());
+        return m_Shards[MemoryTypeIndex * 2 + (HostVisible ? 1 : 0)];
+    }
+
+    uint32_t GetHeapIndex(uint32_t MemoryTypeIndex) const
+    {
+        return m_PhysicalDevice.GetMemoryProperties().memoryTypes[MemoryTypeIndex].heapIndex;
+    }
+
+    uint32_t FindMemoryTypeIndex(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProps) const;
+
+    VulkanMemoryAllocation AllocateDedicated(VkDeviceSize                            Size,
+                                             uint32_t                                MemoryTypeIndex,
+                                             bool                                    HostVisible,
+                                             const VkMemoryDedicatedAllocateInfoKHR* pDedicatedAllocInfo);
+
+    void OnNewAllocation(const VulkanMemoryAllocation& Allocation, bool HostVisible);
+
+    // Releases empty pages of the shard while the allocated size exceeds the reserve
+    void ReleaseEmptyPages(size_t ShardIdx, bool KeepReserve);
+
+    // Releases all empty pages of the heap if allocating Size more bytes would exceed its budget.
+    // Must not be called with any shard mutex locked.
+    void EnsureBudget(uint32_t HeapIndex, VkDeviceSize Size);
+
+    // Returns true if the estimated usage of the heap exceeds 90% of its budget
+    bool IsBudgetTight(uint32_t HeapIndex);
+
+    // The following methods must be called with the shard mutex locked
+    VulkanMemoryAllocation AllocateFromShard(MemoryTypeShard& Shard, VkDeviceSize Size, VkDeviceSize Alignment);
+    void                   UpdateFreeBlockIndex(MemoryTypeShard& Shard, VulkanMemoryPage& Page);
+
+    void OnFreeAllocation(VulkanMemoryPage& Page, VkDeviceSize UnalignedOffset, VkDeviceSize Size);
+
+    // Indexed by MemoryTypeIndex * 2 + (HostVisible ? 1 : 0)
+    std::vector<MemoryTypeShard> m_Shards;
+
+    struct HeapInfo
+    {
+        std::atomic<VkDeviceSize> AllocatedSize{0};
+        std::atomic<VkDeviceSize> UsedSize{0};
+        std::atomic<uint32_t>     NumPages{0};
+        std::atomic<uint32_t>     NumDedicatedAllocations{0};
+
+        // The following members are protected by m_BudgetMtx
+        VkDeviceSize Budget               = 0;
+        VkDeviceSize Usage                = 0;
+        VkDeviceSize AllocatedSizeAtQuery = 0;
+    };
+    // Must be called with m_BudgetMtx locked
+    VkDeviceSize GetEstimatedUsage(const HeapInfo& Heap) const;
 
-    void OnFreeAllocation(VkDeviceSize Size, bool IsHostVisble);
+    std::mutex            m_BudgetMtx;
+    std::vector<HeapInfo> m_Heaps;
 
     // 0 == Device local, 1 == Host-visible
-    std::array<std::atomic_int64_t, 2> m_CurrUsedSize      = {};
-    std::array<VkDeviceSize, 2>        m_PeakUsedSize      = {};
-    std::array<VkDeviceSize, 2>        m_CurrAllocatedSize = {};
-    std::array<VkDeviceSize, 2>        m_PeakAllocatedSize = {};
+    std::array<std::atomic_int64_t, 2>       m_CurrUsedSize      = {};
+    std::array<std::atomic<VkDeviceSize>, 2> m_PeakUsedSize      = {};
+    std::array<std::atomic<VkDeviceSize>, 2> m_CurrAllocatedSize = {};
+    std::array<std::atomic<VkDeviceSize>, 2> m_PeakAllocatedSize = {};
 
     // If adding new member, do not forget to update move ctor
 };
@@ -34,6 +34,8 @@
 namespace VulkanUtilities
 {
 
+class VulkanInstance;
+
 class VulkanPhysicalDevice
 {
 public:
@@ -44,7 +46,7 @@ public:
     VulkanPhysicalDevice& operator = (VulkanPhysicalDevice&&)      = delete;
     // clang-format on
 
-    static std::unique_ptr<VulkanPhysicalDevice> Create(VkPhysicalDevice vkDevice);
+    static std::unique_ptr<VulkanPhysicalDevice> Create(VkPhysicalDevice vkDevice, const VulkanInstance& Instance);
 
     // clang-format off
     uint32_t         FindQueueFamily     (VkQueueFlags QueueFlags)                           const;
@@ -57,19 +59,35 @@ public:
 
     uint32_t GetMemoryTypeIndex(uint32_t typeBits, VkMemoryPropertyFlags properties) const;
 
-    const VkPhysicalDeviceProperties& GetProperties() const { return m_Properties; }
-    const VkPhysicalDeviceFeatures&   GetFeatures() const { return m_Features; }
-    VkFormatProperties                GetPhysicalDeviceFormatProperties(VkFormat imageFormat) const;
+    const VkPhysicalDeviceProperties&       GetProperties() const { return m_Properties; }
+    const VkPhysicalDeviceFeatures&         GetFeatures() const { return m_Features; }
+    const VkPhysicalDeviceMemoryProperties& GetMemoryProperties() const { return m_MemoryProperties; }
+
+    // Returns true if VK_EXT_memory_budget is supported and its properties can be queried
+    bool IsMemoryBudgetSupported() const { return m_vkGetPhysicalDeviceMemoryProperties2 != nullptr; }
+    // Queries current per-heap budget and usage. The extension must be enabled in the logical device.
+    void GetMemoryBudget(VkPhysicalDeviceMemoryBudgetPropertiesEXT& MemoryBudget) const;
+    // Descriptor indexing features and properties are zero-initialized if VK_EXT_descriptor_indexing
+    // is not supported or if they can't be queried because VK_KHR_get_physical_device_properties2
+    // is not enabled in the instance
+    const VkPhysicalDeviceDescriptorIndexingFeaturesEXT&   GetDescriptorIndexingFeatures() const { return m_DescriptorIndexingFeatures; }
+    const VkPhysicalDeviceDescriptorIndexingPropertiesEXT& GetDescriptorIndexingProperties() const { return m_DescriptorIndexingProperties; }
+    VkFormatProperties                                     GetPhysicalDeviceFormatProperties(VkFormat imageFormat) const;
 
 private:
-    VulkanPhysicalDevice(VkPhysicalDevice vkDevice);
+    VulkanPhysicalDevice(VkPhysicalDevice vkDevice, const VulkanInstance& Instance);
+
+    const VkPhysicalDevice                          m_VkDevice;
+    VkPhysicalDeviceProperties                      m_Properties                   = {};
+    VkPhysicalDeviceFeatures                        m_Features                     = {};
+    VkPhysicalDeviceMemoryProperties                m_MemoryProperties             = {};
+    VkPhysicalDeviceDescriptorIndexingFeaturesEXT   m_DescriptorIndexingFeatures   = {};
+    VkPhysicalDeviceDescriptorIndexingPropertiesEXT m_DescriptorIndexingProperties = {};
+    std::vector<VkQueueFamilyProperties>            m_QueueFamilyProperties;
+    std::vector<VkExtensionProperties>              m_SupportedExtensions;
 
-    const VkPhysicalDevice               m_VkDevice;
-    VkPhysicalDeviceProperties           m_Properties       = {};
-    VkPhysicalDeviceFeatures             m_Features         = {};
-    VkPhysicalDeviceMemoryProperties     m_MemoryProperties = {};
-    std::vector<VkQueueFamilyProperties> m_QueueFamilyProperties;
-    std::vector<VkExtensionProperties>   m_SupportedExtensions;
+    // Only loaded if VK_EXT_memory_budget is supported
+    PFN_vkGetPhysicalDeviceMemoryProperties2KHR m_vkGetPhysicalDeviceMemoryProperties2 = nullptr;
 };
 
 } // namespace VulkanUtilities
@@ -0,0 +1,94 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <cstring>
+#include "vulkan.h"
+#include "BasicTypes.h"
+#include "Errors.hpp"
+
+namespace VulkanUtilities
+{
+
+// Checks that the pipeline cache data was produced by the same device and driver, see
+// https://www.khronos.org/registry/vulkan/specs/1.2/html/vkspec.html#pipelines-cache-header
+inline bool IsPipelineCacheDataCompatible(const void* pCacheData, size_t CacheDataSize, const VkPhysicalDeviceProperties& DeviceProps)
+{
+    // clang-format off
+    static constexpr size_t HeaderLengthOffset  = 0;
+    static constexpr size_t HeaderVersionOffset = 4;
+    static constexpr size_t VendorIDOffset      = 8;
+    static constexpr size_t DeviceIDOffset      = 12;
+    static constexpr size_t UUIDOffset          = 16;
+    static constexpr size_t MinHeaderLength     = UUIDOffset + VK_UUID_SIZE;
+    // clang-format on
+
+    if (pCacheData == nullptr || CacheDataSize < MinHeaderLength)
+    {
+        LOG_WARNING_MESSAGE("Pipeline cache data size (", CacheDataSize, ") is smaller than the header size");
+        return false;
+    }
+
+    const auto* pBytes = reinterpret_cast<const Diligent::Uint8*>(pCacheData);
+
+    auto ReadUint32 = [pBytes](size_t Offset) {
+        Diligent::Uint32 Value = 0;
+        memcpy(&Value, pBytes + Offset, sizeof(Value));
+        return Value;
+    };
+
+    const auto HeaderLength = ReadUint32(HeaderLengthOffset);
+    if (HeaderLength < MinHeaderLength || HeaderLength > CacheDataSize)
+    {
+        LOG_WARNING_MESSAGE("Pipeline cache header length (", HeaderLength, ") is invalid");
+        return false;
+    }
+
+    const auto HeaderVersion = ReadUint32(HeaderVersionOffset);
+    if (HeaderVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE)
+    {
+        LOG_WARNING_MESSAGE("Unsupported pipeline cache header version (", HeaderVersion, ")");
+        return false;
+    }
+
+    if (ReadUint32(VendorIDOffset) != DeviceProps.vendorID || ReadUint32(DeviceIDOffset) != DeviceProps.deviceID)
+    {
+        LOG_INFO_MESSAGE("Pipeline cache data was produced by a different device and will be ignored");
+        return false;
+    }
+
+    if (memcmp(pBytes + UUIDOffset, DeviceProps.pipelineCacheUUID, VK_UUID_SIZE) != 0)
+    {
+        LOG_INFO_MESSAGE("Pipeline cache data was produced by a different driver version and will be ignored");
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace VulkanUtilities
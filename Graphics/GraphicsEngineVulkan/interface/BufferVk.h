@@ -53,6 +53,14 @@ DILIGENT_BEGIN_INTERFACE(IBufferVk, IBuffer)
     /// Returns a vulkan buffer handle
     VIRTUAL VkBuffer METHOD(GetVkBuffer)(THIS) CONST PURE;
 
+    /// Returns the offset of the buffer data in the Vulkan buffer returned by GetVkBuffer()
+
+    /// \remarks   The offset is only non-zero for buffers that are suballocated from a Vulkan buffer
+    ///             shared with other buffers (see EngineVkCreateInfo::BufferSuballocationMaxSize).
+    ///             It does not include the offset of the memory allocated by dynamic buffers when
+    ///             they are mapped.
+    VIRTUAL VkDeviceSize METHOD(GetVkBufferOffset)(THIS) CONST PURE;
+
     /// Sets vulkan access flags
 
     /// \param [in] AccessFlags - Vulkan access flags to be set for this buffer
@@ -70,6 +78,7 @@ DILIGENT_END_INTERFACE
 #if DILIGENT_C_INTERFACE
 
 #    define IBufferVk_GetVkBuffer(This)         CALL_IFACE_METHOD(BufferVk, GetVkBuffer, This)
+#    define IBufferVk_GetVkBufferOffset(This)   CALL_IFACE_METHOD(BufferVk, GetVkBufferOffset, This)
 #    define IBufferVk_SetAccessFlags(This, ...) CALL_IFACE_METHOD(BufferVk, SetAccessFlags, This, __VA_ARGS__)
 #    define IBufferVk_GetAccessFlags(This)      CALL_IFACE_METHOD(BufferVk, GetAccessFlags, This)
 
@@ -39,6 +39,26 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 static const INTERFACE_ID IID_DeviceContextVk =
     {0x72aeb1ba, 0xc6ad, 0x42ec, {0x88, 0x11, 0x7e, 0xd9, 0xc7, 0x21, 0x76, 0xbb}};
 
+/// Pipeline barrier statistics, see Diligent::IDeviceContextVk::GetPipelineBarrierStats.
+struct PipelineBarrierStats
+{
+    /// Total number of image memory barriers issued by the context
+    Uint64 NumImageBarriers DEFAULT_INITIALIZER(0);
+
+    /// Total number of buffer memory barriers issued by the context
+    Uint64 NumBufferBarriers DEFAULT_INITIALIZER(0);
+
+    /// Total number of vkCmdPipelineBarrier commands recorded by the context.
+    /// Barriers issued between two commands are batched together, so this
+    /// number is normally much smaller than the total number of barriers.
+    Uint64 NumBarrierCommands DEFAULT_INITIALIZER(0);
+
+    /// Total number of memory barriers issued by the context when a transient texture
+    /// takes over the memory of the textures that alias it (see Diligent::MISC_TEXTURE_FLAG_TRANSIENT).
+    Uint64 NumAliasingBarriers DEFAULT_INITIALIZER(0);
+};
+typedef struct PipelineBarrierStats PipelineBarrierStats;
+
 #define DILIGENT_INTERFACE_NAME IDeviceContextVk
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
@@ -89,6 +109,53 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContextVk, IDeviceContext)
 
     /// Unlocks the command queue that was previously locked by IDeviceContextVk::LockCommandQueue().
     VIRTUAL void METHOD(UnlockCommandQueue)(THIS) PURE;
+
+    /// Returns pipeline barrier statistics of the context.
+
+    /// \param [out] Stats - Pipeline barrier statistics accumulated since the context was created.
+    VIRTUAL void METHOD(GetPipelineBarrierStats)(THIS_
+                                                 PipelineBarrierStats REF Stats) PURE;
+
+    /// Begins recording a secondary command list that continues the render pass of an immediate context.
+
+    /// \param [in] pImmediateContext - Immediate context that will execute the command list. The render
+    ///                                 targets currently bound to this context are bound to the deferred
+    ///                                 context, and the command list is recorded inside the render pass
+    ///                                 that matches these render targets.
+    ///
+    /// \remarks This method can only be called for a deferred context before any command is recorded
+    ///          into the command list. The command list is finished with IDeviceContext::FinishCommandList().
+    ///
+    ///          Secondary command lists are recorded into per-context command pools, so multiple deferred
+    ///          contexts can record them in parallel. The immediate context executes secondary command lists
+    ///          inside its current render pass without submitting them to the queue separately. The lists
+    ///          are submitted with the next IDeviceContext::Flush() of the immediate context.
+    ///
+    ///          The render targets bound to the immediate context must not change until the lists are executed.
+    ///          Commands that must be recorded outside of render pass (copy, dispatch, clear of resources other than
+    ///          bound render targets, resource state transitions) are not allowed in secondary command lists. All
+    ///          resources must be transitioned to required states before the lists are recorded, and
+    ///          RESOURCE_STATE_TRANSITION_MODE_VERIFY or RESOURCE_STATE_TRANSITION_MODE_NONE mode must be used.
+    VIRTUAL void METHOD(BeginSecondaryCommandList)(THIS_
+                                                   IDeviceContext* pImmediateContext) PURE;
+
+    /// Executes multiple command lists.
+
+    /// \param [in] NumCommandLists - Number of command lists to execute.
+    /// \param [in] ppCommandLists  - Pointer to the array of NumCommandLists command lists.
+    ///
+    /// \remarks Consecutive primary command lists are submitted to the queue with a single submit command.
+    ///          Consecutive secondary command lists (see IDeviceContextVk::BeginSecondaryCommandList()) are
+    ///          executed with a single vkCmdExecuteCommands command inside a render pass instance that matches
+    ///          the currently bound render targets.
+    ///
+    ///          Similar to IDeviceContext::ExecuteCommandList(), the context state is invalidated after primary
+    ///          command lists are executed. After secondary command lists are executed, the pipeline state and
+    ///          shader resources must be set again, while render targets, viewports, scissor rects and vertex and
+    ///          index buffers remain bound.
+    VIRTUAL void METHOD(ExecuteCommandLists)(THIS_
+                                             Uint32               NumCommandLists,
+                                             ICommandList* const* ppCommandLists) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -98,10 +165,13 @@ DILIGENT_END_INTERFACE
 
 // clang-format off
 
-#    define IDeviceContextVk_TransitionImageLayout(This, ...) CALL_IFACE_METHOD(DeviceContextVk, TransitionImageLayout, This, __VA_ARGS__)
-#    define IDeviceContextVk_BufferMemoryBarrier(This, ...)   CALL_IFACE_METHOD(DeviceContextVk, BufferMemoryBarrier,   This, __VA_ARGS__)
-#    define IDeviceContextVk_LockCommandQueue(This)           CALL_IFACE_METHOD(DeviceContextVk, LockCommandQueue,      This)
-#    define IDeviceContextVk_UnlockCommandQueue(This)         CALL_IFACE_METHOD(DeviceContextVk, UnlockCommandQueue,    This)
+#    define IDeviceContextVk_TransitionImageLayout(This, ...)     CALL_IFACE_METHOD(DeviceContextVk, TransitionImageLayout,     This, __VA_ARGS__)
+#    define IDeviceContextVk_BufferMemoryBarrier(This, ...)       CALL_IFACE_METHOD(DeviceContextVk, BufferMemoryBarrier,       This, __VA_ARGS__)
+#    define IDeviceContextVk_LockCommandQueue(This)               CALL_IFACE_METHOD(DeviceContextVk, LockCommandQueue,          This)
+#    define IDeviceContextVk_UnlockCommandQueue(This)             CALL_IFACE_METHOD(DeviceContextVk, UnlockCommandQueue,        This)
+#    define IDeviceContextVk_GetPipelineBarrierStats(This, ...)   CALL_IFACE_METHOD(DeviceContextVk, GetPipelineBarrierStats,   This, __VA_ARGS__)
+#    define IDeviceContextVk_BeginSecondaryCommandList(This, ...) CALL_IFACE_METHOD(DeviceContextVk, BeginSecondaryCommandList, This, __VA_ARGS__)
+#    define IDeviceContextVk_ExecuteCommandLists(This, ...)       CALL_IFACE_METHOD(DeviceContextVk, ExecuteCommandLists,       This, __VA_ARGS__)
 
 // clang-format on
 
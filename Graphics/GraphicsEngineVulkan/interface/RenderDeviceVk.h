@@ -30,6 +30,7 @@
 /// \file
 /// Definition of the Diligent::IRenderDeviceVk interface
 
+#include "../../../Primitives/interface/DataBlob.h"
 #include "../../GraphicsEngine/interface/RenderDevice.h"
 
 DILIGENT_BEGIN_NAMESPACE(Diligent)
@@ -38,6 +39,101 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 static const INTERFACE_ID IID_RenderDeviceVk =
     {0xab8cf3a6, 0xd959, 0x41c1, {0xae, 0x0, 0xa5, 0x8a, 0xe9, 0x82, 0xe, 0x6a}};
 
+/// SPIR-V compilation cache statistics, see Diligent::EngineVkCreateInfo::SPIRVCacheDirectory.
+struct SPIRVCacheStats
+{
+    /// Number of shaders whose byte code was loaded from the cache
+    Uint32 NumHits DEFAULT_INITIALIZER(0);
+
+    /// Number of shaders that were not found in the cache and were compiled
+    Uint32 NumMisses DEFAULT_INITIALIZER(0);
+
+    /// Number of compiled shaders that could not be written to the cache
+    Uint32 NumWriteFailures DEFAULT_INITIALIZER(0);
+};
+typedef struct SPIRVCacheStats SPIRVCacheStats;
+
+/// Descriptor set allocation statistics, see Diligent::IRenderDeviceVk::GetDescriptorSetAllocationStats.
+struct DescriptorSetAllocationStats
+{
+    /// Total number of descriptor sets allocated for shader resource binding objects
+    Uint64 NumAllocations DEFAULT_INITIALIZER(0);
+
+    /// Number of allocations served by reusing a previously released descriptor set
+    Uint64 NumRecycledSets DEFAULT_INITIALIZER(0);
+
+    /// Number of allocations that required allocating a new set from a descriptor pool
+    Uint64 NumPoolAllocations DEFAULT_INITIALIZER(0);
+
+    /// Number of times a descriptor pool was reset after all its sets had been released
+    Uint64 NumPoolResets DEFAULT_INITIALIZER(0);
+
+    /// Number of released descriptor sets currently available for reuse
+    Uint32 NumCachedSets DEFAULT_INITIALIZER(0);
+};
+typedef struct DescriptorSetAllocationStats DescriptorSetAllocationStats;
+
+/// Batched resource initialization statistics, see Diligent::IRenderDeviceVk::GetResourceUploadBatchStats.
+struct ResourceUploadBatchStats
+{
+    /// Number of buffers and textures whose initialization commands were recorded into a batch
+    Uint64 NumBatchedResources DEFAULT_INITIALIZER(0);
+
+    /// Number of buffers and textures that were initialized by a separate submission
+    /// because their initial data did not fit into the staging buffer
+    Uint64 NumFallbackUploads DEFAULT_INITIALIZER(0);
+
+    /// Number of batches submitted to the command queue
+    Uint64 NumSubmittedBatches DEFAULT_INITIALIZER(0);
+
+    /// Number of times resource creation had to wait for the GPU to release space in the staging buffer
+    Uint64 NumStagingBufferWaits DEFAULT_INITIALIZER(0);
+
+    /// Total amount of initial data, in bytes, copied through the staging buffer
+    Uint64 StagingBytesUploaded DEFAULT_INITIALIZER(0);
+
+    /// Number of resources recorded into the batch that has not been submitted yet
+    Uint32 NumPendingResources DEFAULT_INITIALIZER(0);
+};
+typedef struct ResourceUploadBatchStats ResourceUploadBatchStats;
+
+/// Device memory heap statistics, see Diligent::IRenderDeviceVk::GetDeviceMemoryHeapStats.
+struct DeviceMemoryHeapStats
+{
+    /// Size of the heap, in bytes
+    Uint64 HeapSize DEFAULT_INITIALIZER(0);
+
+    /// Amount of heap memory the process can use without degrading performance. Reported by
+    /// VK_EXT_memory_budget if the extension is supported, or estimated as 80% of the heap size otherwise.
+    Uint64 Budget DEFAULT_INITIALIZER(0);
+
+    /// Heap memory used by the process. With VK_EXT_memory_budget, this includes
+    /// memory allocated outside of the engine; otherwise, only engine allocations are counted.
+    Uint64 Usage DEFAULT_INITIALIZER(0);
+
+    /// Device memory allocated by the engine in this heap, including empty pages kept for reuse
+    Uint64 AllocatedSize DEFAULT_INITIALIZER(0);
+
+    /// Total size of live resource allocations
+    Uint64 UsedSize DEFAULT_INITIALIZER(0);
+
+    /// Number of memory pages that are shared by multiple resources
+    Uint32 NumPages DEFAULT_INITIALIZER(0);
+
+    /// Number of resources that have their own device memory object
+    Uint32 NumDedicatedAllocations DEFAULT_INITIALIZER(0);
+
+    /// Whether the heap is local to the device
+    Bool IsDeviceLocal DEFAULT_INITIALIZER(False);
+
+    /// Whether Budget and Usage are reported by VK_EXT_memory_budget
+    Bool IsBudgetReported DEFAULT_INITIALIZER(False);
+};
+typedef struct DeviceMemoryHeapStats DeviceMemoryHeapStats;
+
+/// Index returned by IRenderDeviceVk::AllocateBindlessDescriptor() when the allocation fails
+static const Uint32 INVALID_BINDLESS_DESCRIPTOR_INDEX = 0xFFFFFFFFu;
+
 #define DILIGENT_INTERFACE_NAME IRenderDeviceVk
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
@@ -112,6 +208,107 @@ DILIGENT_BEGIN_INTERFACE(IRenderDeviceVk, IRenderDevice)
                                                         const BufferDesc REF BuffDesc,
                                                         RESOURCE_STATE       InitialState,
                                                         IBuffer**            ppBuffer) PURE;
+
+    /// Returns SPIR-V compilation cache statistics.
+
+    /// \param [out] Stats - SPIR-V cache statistics. If the cache is disabled,
+    ///                      all counters are zero.
+    VIRTUAL void METHOD(GetSPIRVCacheStats)(THIS_
+                                            SPIRVCacheStats REF Stats) PURE;
+
+    /// Serializes the contents of the device pipeline cache.
+
+    /// \param [out] ppData - Address of the memory location where the pointer to the data blob
+    ///                       containing the pipeline cache data will be written.
+    ///                       The data can be passed to EngineVkCreateInfo::pPipelineCacheData
+    ///                       to speed up pipeline creation in subsequent runs.
+    VIRTUAL void METHOD(GetPipelineCacheData)(THIS_
+                                              IDataBlob** ppData) PURE;
+
+    /// Writes the descriptor of an object into the bindless descriptor heap.
+
+    /// \param [in] pObject - Shader resource texture view, shader resource or unordered access
+    ///                       view of a structured or raw buffer, or sampler.
+    ///
+    /// \return Index of the descriptor in the heap range that corresponds to the object type
+    ///         (see Diligent::BINDLESS_DESCRIPTOR_RANGE_VK), or Diligent::INVALID_BINDLESS_DESCRIPTOR_INDEX
+    ///         if the heap is not available or the range is full.
+    ///
+    /// \remarks All runtime arrays of separate images, storage buffers and separate samplers
+    ///          (e.g. Texture2D g_Textures[]) are bound to the heap rather than to shader
+    ///          resource binding objects, and the index is used to access the array in the shader.
+    ///          The heap does not keep strong references to the objects. The application must
+    ///          keep the object alive and transition the resource to the required state for
+    ///          as long as the descriptor may be accessed by the GPU.
+    ///          The method is thread-safe.
+    VIRTUAL Uint32 METHOD(AllocateBindlessDescriptor)(THIS_
+                                                      IDeviceObject* pObject) PURE;
+
+    /// Releases the descriptor allocated by AllocateBindlessDescriptor().
+
+    /// \param [in] Range - Heap range the descriptor was allocated from.
+    /// \param [in] Index - Descriptor index.
+    ///
+    /// \remarks The index is not reused until all command buffers submitted before
+    ///          the call have been completed by the GPU. The method is thread-safe.
+    VIRTUAL void METHOD(ReleaseBindlessDescriptor)(THIS_
+                                                   BINDLESS_DESCRIPTOR_RANGE_VK Range,
+                                                   Uint32                       Index) PURE;
+
+    /// Returns the number of descriptors in the given range of the bindless descriptor heap,
+    /// or zero if the heap is not available.
+    VIRTUAL Uint32 METHOD(GetBindlessDescriptorHeapSize)(THIS_
+                                                         BINDLESS_DESCRIPTOR_RANGE_VK Range) PURE;
+
+    /// Returns descriptor set allocation statistics.
+
+    /// \param [out] Stats - Descriptor set allocation statistics.
+    ///
+    /// \remarks Descriptor sets of released shader resource binding objects are reused by
+    ///          new objects with the same resource layout once the GPU is done with them.
+    ///          The ratio of NumRecycledSets to NumAllocations shows how often this happens.
+    VIRTUAL void METHOD(GetDescriptorSetAllocationStats)(THIS_
+                                                         DescriptorSetAllocationStats REF Stats) PURE;
+
+    /// Submits the pending batch of buffer and texture initialization commands.
+
+    /// \param [in] pFence     - Optional fence to signal once all resources created so far
+    ///                          have been initialized by the GPU.
+    /// \param [in] FenceValue - Value to signal the fence with.
+    ///
+    /// \remarks When batching is enabled (see EngineVkCreateInfo::ResourceUploadBatchStagingSize),
+    ///          new resources are initialized by commands recorded into a shared transfer command buffer.
+    ///          The batch is also submitted automatically when it reaches EngineVkCreateInfo::ResourceUploadBatchFlushSize
+    ///          and before the immediate context submits its commands, so calling this method is only
+    ///          required to start the upload early or to get the completion fence.
+    ///          The method is thread-safe.
+    VIRTUAL void METHOD(FlushResourceUploads)(THIS_
+                                              IFence* pFence,
+                                              Uint64  FenceValue) PURE;
+
+    /// Returns batched resource initialization statistics.
+
+    /// \param [out] Stats - Batched resource initialization statistics. If batching
+    ///                      is disabled, all counters are zero.
+    VIRTUAL void METHOD(GetResourceUploadBatchStats)(THIS_
+                                                     ResourceUploadBatchStats REF Stats) PURE;
+
+    /// Returns the number of device memory heaps, see VkPhysicalDeviceMemoryProperties::memoryHeapCount.
+    VIRTUAL Uint32 METHOD(GetDeviceMemoryHeapCount)(THIS) CONST PURE;
+
+    /// Returns device memory heap statistics.
+
+    /// \param [in]  HeapIndex - Heap index, must be less than the value returned by GetDeviceMemoryHeapCount().
+    /// \param [out] Stats     - Heap statistics.
+    ///
+    /// \remarks Resources that require or prefer a dedicated allocation and allocations larger
+    ///          than half of the memory page size get their own device memory objects.
+    ///          When the usage of a heap approaches its budget, the engine releases empty pages
+    ///          of that heap even if they are within EngineVkCreateInfo::DeviceLocalMemoryReserveSize
+    ///          or EngineVkCreateInfo::HostVisibleMemoryReserveSize. The method is thread-safe.
+    VIRTUAL void METHOD(GetDeviceMemoryHeapStats)(THIS_
+                                                  Uint32                    HeapIndex,
+                                                  DeviceMemoryHeapStats REF Stats) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -121,14 +318,24 @@ DILIGENT_END_INTERFACE
 
 // clang-format off
 
-#    define IRenderDeviceVk_GetVkDevice(This)                         CALL_IFACE_METHOD(RenderDeviceVk, GetVkDevice,                    This)
-#    define IRenderDeviceVk_GetVkPhysicalDevice(This)                 CALL_IFACE_METHOD(RenderDeviceVk, GetVkPhysicalDevice,            This)
-#    define IRenderDeviceVk_GetVkInstance(This)                       CALL_IFACE_METHOD(RenderDeviceVk, GetVkInstance,                  This)
-#    define IRenderDeviceVk_GetNextFenceValue(This, ...)              CALL_IFACE_METHOD(RenderDeviceVk, GetNextFenceValue,              This, __VA_ARGS__)
-#    define IRenderDeviceVk_GetCompletedFenceValue(This, ...)         CALL_IFACE_METHOD(RenderDeviceVk, GetCompletedFenceValue,         This, __VA_ARGS__)
-#    define IRenderDeviceVk_IsFenceSignaled(This, ...)                CALL_IFACE_METHOD(RenderDeviceVk, IsFenceSignaled,                This, __VA_ARGS__)
-#    define IRenderDeviceVk_CreateTextureFromVulkanImage(This, ...)   CALL_IFACE_METHOD(RenderDeviceVk, CreateTextureFromVulkanImage,   This, __VA_ARGS__)
-#    define IRenderDeviceVk_CreateBufferFromVulkanResource(This, ...) CALL_IFACE_METHOD(RenderDeviceVk, CreateBufferFromVulkanResource, This, __VA_ARGS__)
+#    define IRenderDeviceVk_GetVkDevice(This)                          CALL_IFACE_METHOD(RenderDeviceVk, GetVkDevice,                     This)
+#    define IRenderDeviceVk_GetVkPhysicalDevice(This)                  CALL_IFACE_METHOD(RenderDeviceVk, GetVkPhysicalDevice,             This)
+#    define IRenderDeviceVk_GetVkInstance(This)                        CALL_IFACE_METHOD(RenderDeviceVk, GetVkInstance,                   This)
+#    define IRenderDeviceVk_GetNextFenceValue(This, ...)               CALL_IFACE_METHOD(RenderDeviceVk, GetNextFenceValue,               This, __VA_ARGS__)
+#    define IRenderDeviceVk_GetCompletedFenceValue(This, ...)          CALL_IFACE_METHOD(RenderDeviceVk, GetCompletedFenceValue,          This, __VA_ARGS__)
+#    define IRenderDeviceVk_IsFenceSignaled(This, ...)                 CALL_IFACE_METHOD(RenderDeviceVk, IsFenceSignaled,                 This, __VA_ARGS__)
+#    define IRenderDeviceVk_CreateTextureFromVulkanImage(This, ...)    CALL_IFACE_METHOD(RenderDeviceVk, CreateTextureFromVulkanImage,    This, __VA_ARGS__)
+#    define IRenderDeviceVk_CreateBufferFromVulkanResource(This, ...)  CALL_IFACE_METHOD(RenderDeviceVk, CreateBufferFromVulkanResource,  This, __VA_ARGS__)
+#    define IRenderDeviceVk_GetSPIRVCacheStats(This, ...)              CALL_IFACE_METHOD(RenderDeviceVk, GetSPIRVCacheStats,              This, __VA_ARGS__)
+#    define IRenderDeviceVk_GetPipelineCacheData(This, ...)            CALL_IFACE_METHOD(RenderDeviceVk, GetPipelineCacheData,            This, __VA_ARGS__)
+#    define IRenderDeviceVk_AllocateBindlessDescriptor(This, ...)      CALL_IFACE_METHOD(RenderDeviceVk, AllocateBindlessDescriptor,      This, __VA_ARGS__)
+#    define IRenderDeviceVk_ReleaseBindlessDescriptor(This, ...)       CALL_IFACE_METHOD(RenderDeviceVk, ReleaseBindlessDescriptor,       This, __VA_ARGS__)
+#    define IRenderDeviceVk_GetBindlessDescriptorHeapSize(This, ...)   CALL_IFACE_METHOD(RenderDeviceVk, GetBindlessDescriptorHeapSize,   This, __VA_ARGS__)
+#    define IRenderDeviceVk_GetDescriptorSetAllocationStats(This, ...) CALL_IFACE_METHOD(RenderDeviceVk, GetDescriptorSetAllocationStats, This, __VA_ARGS__)
+#    define IRenderDeviceVk_FlushResourceUploads(This, ...)            CALL_IFACE_METHOD(RenderDeviceVk, FlushResourceUploads,            This, __VA_ARGS__)
+#    define IRenderDeviceVk_GetResourceUploadBatchStats(This, ...)     CALL_IFACE_METHOD(RenderDeviceVk, GetResourceUploadBatchStats,     This, __VA_ARGS__)
+#    define IRenderDeviceVk_GetDeviceMemoryHeapCount(This)             CALL_IFACE_METHOD(RenderDeviceVk, GetDeviceMemoryHeapCount,        This)
+#    define IRenderDeviceVk_GetDeviceMemoryHeapStats(This, ...)        CALL_IFACE_METHOD(RenderDeviceVk, GetDeviceMemoryHeapStats,        This, __VA_ARGS__)
 
 // clang-format on
 
@@ -0,0 +1,380 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "BindlessDescriptorHeap.hpp"
+#include "RenderDeviceVkImpl.hpp"
+#include "TextureViewVkImpl.hpp"
+#include "TextureVkImpl.hpp"
+#include "BufferViewVkImpl.hpp"
+#include "BufferVkImpl.hpp"
+#include "SamplerVkImpl.hpp"
+
+namespace Diligent
+{
+
+// Returns the index to the heap free list when the stale index is discarded by the release queue
+class BindlessDescriptorHeap::StaleIndex
+{
+public:
+    // clang-format off
+    StaleIndex(BindlessDescriptorHeap& Heap, BINDLESS_DESCRIPTOR_RANGE_VK Range, Uint32 Index) noexcept :
+        m_pHeap{&Heap },
+        m_Range{Range },
+        m_Index{Index }
+    {}
+
+    StaleIndex(StaleIndex&& rhs) noexcept :
+        m_pHeap{rhs.m_pHeap},
+        m_Range{rhs.m_Range},
+        m_Index{rhs.m_Index}
+    {
+        rhs.m_pHeap = nullptr;
+    }
+
+    StaleIndex             (const StaleIndex&) = delete;
+    StaleIndex& operator = (const StaleIndex&) = delete;
+    StaleIndex& operator = (StaleIndex&&)      = delete;
+    // clang-format on
+
+    ~StaleIndex()
+    {
+        if (m_pHeap != nullptr)
+            m_pHeap->ReturnIndex(m_Range, m_Index);
+    }
+
+private:
+    BindlessDescriptorHeap*            m_pHeap;
+    const BINDLESS_DESCRIPTOR_RANGE_VK m_Range;
+    const Uint32                       m_Index;
+};
+
+static VkDescriptorType GetRangeDescriptorType(BINDLESS_DESCRIPTOR_RANGE_VK Range)
+{
+    static_assert(BINDLESS_DESCRIPTOR_RANGE_VK_COUNT == 3, "Please handle the new range below");
+    switch (Range)
+    {
+        // clang-format off
+        case BINDLESS_DESCRIPTOR_RANGE_VK_TEXTURES: return VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+        case BINDLESS_DESCRIPTOR_RANGE_VK_BUFFERS:  return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        case BINDLESS_DESCRIPTOR_RANGE_VK_SAMPLERS: return VK_DESCRIPTOR_TYPE_SAMPLER;
+        // clang-format on
+        default:
+            UNEXPECTED("Unexpected bindless descriptor range");
+            return VK_DESCRIPTOR_TYPE_MAX_ENUM;
+    }
+}
+
+static const char* GetRangeName(BINDLESS_DESCRIPTOR_RANGE_VK Range)
+{
+    static_assert(BINDLESS_DESCRIPTOR_RANGE_VK_COUNT == 3, "Please handle the new range below");
+    switch (Range)
+    {
+        // clang-format off
+        case BINDLESS_DESCRIPTOR_RANGE_VK_TEXTURES: return "textures";
+        case BINDLESS_DESCRIPTOR_RANGE_VK_BUFFERS:  return "buffers";
+        case BINDLESS_DESCRIPTOR_RANGE_VK_SAMPLERS: return "samplers";
+        // clang-format on
+        default:
+            UNEXPECTED("Unexpected bindless descriptor range");
+            return "<unknown>";
+    }
+}
+
+BindlessDescriptorHeap::BindlessDescriptorHeap(RenderDeviceVkImpl& DeviceVkImpl, const Uint32 RangeSizes[]) :
+    m_DeviceVkImpl{DeviceVkImpl}
+{
+#ifdef DILIGENT_DEVELOPMENT
+    m_PendingReleaseIndexCounter = 0;
+#endif
+
+    const auto& LogicalDevice = DeviceVkImpl.GetLogicalDevice();
+    VERIFY(LogicalDevice.IsDescriptorIndexingEnabled(), "Descriptor indexing must be enabled to create the bindless descriptor heap");
+
+    // The heap is accessible from all shader stages, so per-stage limits apply as well
+    const auto&  IndexingProps   = DeviceVkImpl.GetPhysicalDevice().GetDescriptorIndexingProperties();
+    const Uint32 MaxRangeSizes[] = //
+        {
+            std::min(IndexingProps.maxDescriptorSetUpdateAfterBindSampledImages, IndexingProps.maxPerStageDescriptorUpdateAfterBindSampledImages),
+            std::min(IndexingProps.maxDescriptorSetUpdateAfterBindStorageBuffers, IndexingProps.maxPerStageDescriptorUpdateAfterBindStorageBuffers),
+            std::min(IndexingProps.maxDescriptorSetUpdateAfterBindSamplers, IndexingProps.maxPerStageDescriptorUpdateAfterBindSamplers) //
+        };
+    static_assert(_countof(MaxRangeSizes) == BINDLESS_DESCRIPTOR_RANGE_VK_COUNT, "Please initialize the max size of every range");
+
+    std::array<VkDescriptorSetLayoutBinding, BINDLESS_DESCRIPTOR_RANGE_VK_COUNT> Bindings     = {};
+    std::array<VkDescriptorBindingFlagsEXT, BINDLESS_DESCRIPTOR_RANGE_VK_COUNT>  BindingFlags = {};
+    std::vector<VkDescriptorPoolSize>                                            PoolSizes;
+    for (Uint32 r = 0; r < BINDLESS_DESCRIPTOR_RANGE_VK_COUNT; ++r)
+    {
+        const auto RangeType = static_cast<BINDLESS_DESCRIPTOR_RANGE_VK>(r);
+
+        auto Size = RangeSizes[r];
+        if (Size > MaxRangeSizes[r])
+        {
+            LOG_WARNING_MESSAGE("The size of the bindless ", GetRangeName(RangeType), " range (", Size,
+                                ") exceeds the device limit and will be clamped to ", MaxRangeSizes[r]);
+            Size = MaxRangeSizes[r];
+        }
+
+        auto& Range = m_Ranges[r];
+        Range.Size  = Size;
+#ifdef DILIGENT_DEVELOPMENT
+        Range.dvpIsAllocated.resize(Size);
+#endif
+
+        auto& Binding              = Bindings[r];
+        Binding.binding            = r;
+        Binding.descriptorType     = GetRangeDescriptorType(RangeType);
+        Binding.descriptorCount    = Size;
+        Binding.stageFlags         = VK_SHADER_STAGE_ALL;
+        Binding.pImmutableSamplers = nullptr;
+
+        // Descriptors that are not dynamically used by shaders do not need to be valid, and
+        // can be written while command buffers that use the set are pending execution
+        BindingFlags[r] =
+            VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT |
+            VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT |
+            VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT;
+
+        if (Size > 0)
+            PoolSizes.push_back({Binding.descriptorType, Size});
+    }
+    VERIFY(!PoolSizes.empty(), "At least one bindless range must not be empty");
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfoEXT BindingFlagsCI = {};
+
+    BindingFlagsCI.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+    BindingFlagsCI.pNext         = nullptr;
+    BindingFlagsCI.bindingCount  = static_cast<uint32_t>(BindingFlags.size());
+    BindingFlagsCI.pBindingFlags = BindingFlags.data();
+
+    VkDescriptorSetLayoutCreateInfo SetLayoutCI = {};
+
+    SetLayoutCI.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    SetLayoutCI.pNext        = &BindingFlagsCI;
+    SetLayoutCI.flags        = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
+    SetLayoutCI.bindingCount = static_cast<uint32_t>(Bindings.size());
+    SetLayoutCI.pBindings    = Bindings.data();
+    m_VkSetLayout            = LogicalDevice.CreateDescriptorSetLayout(SetLayoutCI, "Bindless descriptor set layout");
+
+    VkDescriptorPoolCreateInfo PoolCI = {};
+
+    PoolCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    PoolCI.pNext = nullptr;
+    // Descriptor sets with update-after-bind layouts can only be allocated from the pools
+    // created with VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT flag
+    PoolCI.flags         = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+    PoolCI.maxSets       = 1;
+    PoolCI.poolSizeCount = static_cast<uint32_t>(PoolSizes.size());
+    PoolCI.pPoolSizes    = PoolSizes.data();
+    m_VkPool             = LogicalDevice.CreateDescriptorPool(PoolCI, "Bindless descriptor pool");
+
+    VkDescriptorSetLayout vkSetLayout = m_VkSetLayout;
+
+    VkDescriptorSetAllocateInfo SetAllocInfo = {};
+
+    SetAllocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    SetAllocInfo.pNext              = nullptr;
+    SetAllocInfo.descriptorPool     = m_VkPool;
+    SetAllocInfo.descriptorSetCount = 1;
+    SetAllocInfo.pSetLayouts        = &vkSetLayout;
+    m_VkSet                         = LogicalDevice.AllocateVkDescriptorSet(SetAllocInfo, "Bindless descriptor set");
+    if (m_VkSet == VK_NULL_HANDLE)
+        LOG_ERROR_AND_THROW("Failed to allocate bindless descriptor set");
+}
+
+BindlessDescriptorHeap::~BindlessDescriptorHeap()
+{
+    DEV_CHECK_ERR(m_PendingReleaseIndexCounter == 0, "All released bindless descriptor indices must have been returned to the heap.");
+    // The descriptor set is freed when the pool is destroyed
+}
+
+BINDLESS_DESCRIPTOR_RANGE_VK BindlessDescriptorHeap::GetResourceRange(SPIRVShaderResourceAttribs::ResourceType ResType)
+{
+    switch (ResType)
+    {
+        case SPIRVShaderResourceAttribs::ResourceType::SeparateImage:
+            return BINDLESS_DESCRIPTOR_RANGE_VK_TEXTURES;
+
+        case SPIRVShaderResourceAttribs::ResourceType::ROStorageBuffer:
+        case SPIRVShaderResourceAttribs::ResourceType::RWStorageBuffer:
+            return BINDLESS_DESCRIPTOR_RANGE_VK_BUFFERS;
+
+        case SPIRVShaderResourceAttribs::ResourceType::SeparateSampler:
+            return BINDLESS_DESCRIPTOR_RANGE_VK_SAMPLERS;
+
+        default:
+            return BINDLESS_DESCRIPTOR_RANGE_VK_COUNT;
+    }
+}
+
+Uint32 BindlessDescriptorHeap::Allocate(IDeviceObject* pObject)
+{
+    DEV_CHECK_ERR(pObject != nullptr, "Object must not be null");
+    if (pObject == nullptr)
+        return INVALID_BINDLESS_DESCRIPTOR_INDEX;
+
+    auto                   Range      = BINDLESS_DESCRIPTOR_RANGE_VK_COUNT;
+    VkDescriptorImageInfo  ImageInfo  = {};
+    VkDescriptorBufferInfo BufferInfo = {};
+
+    RefCntAutoPtr<ITextureView> pTexView{pObject, IID_TextureView};
+    RefCntAutoPtr<IBufferView>  pBuffView{pObject, IID_BufferView};
+    RefCntAutoPtr<ISampler>     pSampler{pObject, IID_Sampler};
+    if (pTexView)
+    {
+        const auto* pTexViewVk = pTexView.RawPtr<const TextureViewVkImpl>();
+        const auto& ViewDesc   = pTexViewVk->GetDesc();
+        if (ViewDesc.ViewType != TEXTURE_VIEW_SHADER_RESOURCE)
+        {
+            LOG_ERROR_MESSAGE("Unable to allocate bindless descriptor for texture view '", ViewDesc.Name,
+                              "': only shader resource views can be placed into the heap");
+            return INVALID_BINDLESS_DESCRIPTOR_INDEX;
+        }
+
+        const auto* pTexVk = ValidatedCast<const TextureVkImpl>(pTexViewVk->GetTexture());
+
+        Range                 = BINDLESS_DESCRIPTOR_RANGE_VK_TEXTURES;
+        ImageInfo.sampler     = VK_NULL_HANDLE;
+        ImageInfo.imageView   = pTexViewVk->GetVulkanImageView();
+        ImageInfo.imageLayout = (pTexVk->GetDesc().BindFlags & BIND_DEPTH_STENCIL) != 0 ?
+            VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL :
+            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    }
+    else if (pBuffView)
+    {
+        const auto* pBuffViewVk = pBuffView.RawPtr<const BufferViewVkImpl>();
+        const auto& ViewDesc    = pBuffViewVk->GetDesc();
+        const auto* pBuffVk     = pBuffViewVk->GetBufferVk();
+        const auto& BuffDesc    = pBuffVk->GetDesc();
+        if (BuffDesc.Mode != BUFFER_MODE_STRUCTURED && BuffDesc.Mode != BUFFER_MODE_RAW)
+        {
+            LOG_ERROR_MESSAGE("Unable to allocate bindless descriptor for buffer view '", ViewDesc.Name,
+                              "': only structured and raw buffers can be placed into the heap");
+            return INVALID_BINDLESS_DESCRIPTOR_INDEX;
+        }
+        if (BuffDesc.Usage == USAGE_DYNAMIC)
+        {
+            // Dynamic buffers are suballocated from the dynamic heap, and their offset changes every time they are mapped
+            LOG_ERROR_MESSAGE("Unable to allocate bindless descriptor for buffer view '", ViewDesc.Name,
+                              "': dynamic buffers can't be placed into the heap");
+            return INVALID_BINDLESS_DESCRIPTOR_INDEX;
+        }
+
+        Range             = BINDLESS_DESCRIPTOR_RANGE_VK_BUFFERS;
+        BufferInfo.buffer = pBuffVk->GetVkBuffer();
+        BufferInfo.offset = pBuffVk->GetVkBufferOffset() + ViewDesc.ByteOffset;
+        BufferInfo.range  = ViewDesc.ByteWidth;
+    }
+    else if (pSampler)
+    {
+        Range             = BINDLESS_DESCRIPTOR_RANGE_VK_SAMPLERS;
+        ImageInfo.sampler = pSampler.RawPtr<const SamplerVkImpl>()->GetVkSampler();
+    }
+    else
+    {
+        LOG_ERROR_MESSAGE("Unable to allocate bindless descriptor for object '", pObject->GetDesc().Name,
+                          "': only texture views, buffer views and samplers can be placed into the heap");
+        return INVALID_BINDLESS_DESCRIPTOR_INDEX;
+    }
+
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+
+    auto&  IdxRange = m_Ranges[Range];
+    Uint32 Index    = INVALID_BINDLESS_DESCRIPTOR_INDEX;
+    if (!IdxRange.FreeIndices.empty())
+    {
+        Index = IdxRange.FreeIndices.back();
+        IdxRange.FreeIndices.pop_back();
+    }
+    else if (IdxRange.NextUnusedIndex < IdxRange.Size)
+    {
+        Index = IdxRange.NextUnusedIndex++;
+    }
+    else
+    {
+        LOG_ERROR_MESSAGE("Unable to allocate bindless descriptor for object '", pObject->GetDesc().Name, "': all ",
+                          IdxRange.Size, " descriptors in the ", GetRangeName(Range), " range are in use. "
+                                                                                      "Increase the range size in EngineVkCreateInfo::BindlessDescriptorHeapSize.");
+        return INVALID_BINDLESS_DESCRIPTOR_INDEX;
+    }
+#ifdef DILIGENT_DEVELOPMENT
+    VERIFY_EXPR(!IdxRange.dvpIsAllocated[Index]);
+    IdxRange.dvpIsAllocated[Index] = true;
+#endif
+
+    VkWriteDescriptorSet WriteDescrSet = {};
+
+    WriteDescrSet.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    WriteDescrSet.pNext           = nullptr;
+    WriteDescrSet.dstSet          = m_VkSet;
+    WriteDescrSet.dstBinding      = Range;
+    WriteDescrSet.dstArrayElement = Index;
+    WriteDescrSet.descriptorCount = 1;
+    WriteDescrSet.descriptorType  = GetRangeDescriptorType(Range);
+    if (Range == BINDLESS_DESCRIPTOR_RANGE_VK_BUFFERS)
+        WriteDescrSet.pBufferInfo = &BufferInfo;
+    else
+        WriteDescrSet.pImageInfo = &ImageInfo;
+    m_DeviceVkImpl.GetLogicalDevice().UpdateDescriptorSets(1, &WriteDescrSet, 0, nullptr);
+
+    return Index;
+}
+
+void BindlessDescriptorHeap::Free(BINDLESS_DESCRIPTOR_RANGE_VK Range, Uint32 Index)
+{
+    DEV_CHECK_ERR(Range < BINDLESS_DESCRIPTOR_RANGE_VK_COUNT, "Invalid bindless descriptor range");
+    DEV_CHECK_ERR(Range >= BINDLESS_DESCRIPTOR_RANGE_VK_COUNT || Index < m_Ranges[Range].Size,
+                  "Bindless descriptor index ", Index, " is out of range");
+    if (Range >= BINDLESS_DESCRIPTOR_RANGE_VK_COUNT || Index >= m_Ranges[Range].Size)
+        return;
+
+#ifdef DILIGENT_DEVELOPMENT
+    {
+        std::lock_guard<std::mutex> Lock{m_Mutex};
+        DEV_CHECK_ERR(m_Ranges[Range].dvpIsAllocated[Index], "Bindless descriptor ", Index, " in the ", GetRangeName(Range),
+                      " range is not allocated or has already been released");
+        m_Ranges[Range].dvpIsAllocated[Index] = false;
+    }
+    ++m_PendingReleaseIndexCounter;
+#endif
+
+    // The descriptor may still be accessed by the command buffers that are being recorded or executed,
+    // so the index can only be reused when all of them have been completed
+    m_DeviceVkImpl.SafeReleaseDeviceObject(StaleIndex{*this, Range, Index}, ~Uint64{0});
+}
+
+void BindlessDescriptorHeap::ReturnIndex(BINDLESS_DESCRIPTOR_RANGE_VK Range, Uint32 Index)
+{
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+    m_Ranges[Range].FreeIndices.push_back(Index);
+#ifdef DILIGENT_DEVELOPMENT
+    --m_PendingReleaseIndexCounter;
+#endif
+}
+
+} // namespace Diligent
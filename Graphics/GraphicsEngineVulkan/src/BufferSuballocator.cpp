@@ -0,0 +1,200 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "BufferSuballocator.hpp"
+#include "RenderDeviceVkImpl.hpp"
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+BufferSuballocator::Allocation::Allocation(BufferSuballocator&                               Allocator,
+                                           Block&                                            BuffBlock,
+                                           const VariableSizeAllocationsManager::Allocation& Range,
+                                           VkDeviceSize                                      AlignedOffset) noexcept :
+    // clang-format off
+    m_pAllocator   {&Allocator   },
+    m_pBlock       {&BuffBlock   },
+    m_Range        {Range        },
+    m_AlignedOffset{AlignedOffset}
+// clang-format on
+{
+}
+
+BufferSuballocator::Allocation::Allocation(Allocation&& rhs) noexcept :
+    // clang-format off
+    m_pAllocator   {rhs.m_pAllocator   },
+    m_pBlock       {rhs.m_pBlock       },
+    m_Range        {rhs.m_Range        },
+    m_AlignedOffset{rhs.m_AlignedOffset}
+// clang-format on
+{
+    rhs.m_pAllocator    = nullptr;
+    rhs.m_pBlock        = nullptr;
+    rhs.m_Range         = VariableSizeAllocationsManager::Allocation{};
+    rhs.m_AlignedOffset = 0;
+}
+
+BufferSuballocator::Allocation& BufferSuballocator::Allocation::operator=(Allocation&& rhs) noexcept
+{
+    Release();
+
+    m_pAllocator    = rhs.m_pAllocator;
+    m_pBlock        = rhs.m_pBlock;
+    m_Range         = rhs.m_Range;
+    m_AlignedOffset = rhs.m_AlignedOffset;
+
+    rhs.m_pAllocator    = nullptr;
+    rhs.m_pBlock        = nullptr;
+    rhs.m_Range         = VariableSizeAllocationsManager::Allocation{};
+    rhs.m_AlignedOffset = 0;
+    return *this;
+}
+
+BufferSuballocator::Allocation::~Allocation()
+{
+    Release();
+}
+
+void BufferSuballocator::Allocation::Release()
+{
+    if (m_pBlock != nullptr)
+    {
+        m_pAllocator->Free(*m_pBlock, m_Range);
+        m_pAllocator    = nullptr;
+        m_pBlock        = nullptr;
+        m_AlignedOffset = 0;
+    }
+}
+
+VkBuffer BufferSuballocator::Allocation::GetVkBuffer() const
+{
+    VERIFY_EXPR(m_pBlock != nullptr);
+    return m_pBlock->Buffer;
+}
+
+
+BufferSuballocator::BufferSuballocator(RenderDeviceVkImpl& DeviceVkImpl, VkDeviceSize MaxBufferSize, VkDeviceSize BlockSize) :
+    // clang-format off
+    m_DeviceVkImpl {DeviceVkImpl                      },
+    m_MaxBufferSize{std::min(MaxBufferSize, BlockSize)},
+    m_BlockSize    {BlockSize                         }
+// clang-format on
+{
+}
+
+BufferSuballocator::~BufferSuballocator()
+{
+#ifdef DILIGENT_DEVELOPMENT
+    for (const auto& BuffBlock : m_Blocks)
+        DEV_CHECK_ERR(BuffBlock.RangeMgr.IsEmpty(), "All suballocated buffers must have been released by now");
+#endif
+}
+
+BufferSuballocator::Allocation BufferSuballocator::Allocate(VkBufferUsageFlags Usage, VkDeviceSize Size, VkDeviceSize Alignment)
+{
+    VERIFY_EXPR(Size > 0 && Size <= m_MaxBufferSize);
+    VERIFY(IsPowerOfTwo(Alignment), "Alignment is not power of 2!");
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    for (auto& BuffBlock : m_Blocks)
+    {
+        // Only the buffers with the same usage flags share the Vulkan buffer
+        if (BuffBlock.Usage != Usage)
+            continue;
+
+        auto Range = BuffBlock.RangeMgr.Allocate(static_cast<size_t>(Size), static_cast<size_t>(Alignment));
+        if (Range.IsValid())
+            return Allocation{*this, BuffBlock, Range, Align(VkDeviceSize{Range.UnalignedOffset}, Alignment)};
+    }
+
+    const auto& LogicalDevice = m_DeviceVkImpl.GetLogicalDevice();
+
+    VkBufferCreateInfo VkBuffCI    = {};
+    VkBuffCI.sType                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    VkBuffCI.pNext                 = nullptr;
+    VkBuffCI.flags                 = 0;
+    VkBuffCI.size                  = m_BlockSize;
+    VkBuffCI.usage                 = Usage;
+    VkBuffCI.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
+    VkBuffCI.queueFamilyIndexCount = 0;
+    VkBuffCI.pQueueFamilyIndices   = nullptr;
+
+    m_Blocks.emplace_back(Usage, m_BlockSize, GetRawAllocator());
+    auto& NewBlock = m_Blocks.back();
+    try
+    {
+        NewBlock.Buffer = LogicalDevice.CreateBuffer(VkBuffCI, "Shared buffer for suballocated buffers");
+
+        VkMemoryRequirements MemReqs = LogicalDevice.GetBufferMemoryRequirements(NewBlock.Buffer);
+        VERIFY(IsPowerOfTwo(MemReqs.alignment), "Alignment is not power of 2!");
+        NewBlock.Memory = m_DeviceVkImpl.AllocateMemory(MemReqs, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+        auto AlignedMemOffset = Align(VkDeviceSize{NewBlock.Memory.UnalignedOffset}, MemReqs.alignment);
+        VERIFY(NewBlock.Memory.Size >= MemReqs.size + (AlignedMemOffset - NewBlock.Memory.UnalignedOffset), "Size of memory allocation is too small");
+        auto err = LogicalDevice.BindBufferMemory(NewBlock.Buffer, NewBlock.Memory.Page->GetVkMemory(), AlignedMemOffset);
+        CHECK_VK_ERROR_AND_THROW(err, "Failed to bind shared buffer memory");
+    }
+    catch (...)
+    {
+        m_Blocks.pop_back();
+        throw;
+    }
+
+    auto Range = NewBlock.RangeMgr.Allocate(static_cast<size_t>(Size), static_cast<size_t>(Alignment));
+    VERIFY(Range.IsValid(), "The buffer must fit into the new block");
+    return Allocation{*this, NewBlock, Range, Align(VkDeviceSize{Range.UnalignedOffset}, Alignment)};
+}
+
+void BufferSuballocator::Free(Block& BuffBlock, VariableSizeAllocationsManager::Allocation& Range)
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    BuffBlock.RangeMgr.Free(std::move(Range));
+    if (!BuffBlock.RangeMgr.IsEmpty())
+        return;
+
+    // Keep one empty block for every usage, so that creating and releasing a single buffer
+    // does not create and destroy the shared Vulkan buffer every time. The allocations are
+    // released through the release queue, so the GPU no longer uses the other empty blocks.
+    auto BlockIt            = m_Blocks.end();
+    bool HasOtherEmptyBlock = false;
+    for (auto it = m_Blocks.begin(); it != m_Blocks.end(); ++it)
+    {
+        if (&*it == &BuffBlock)
+            BlockIt = it;
+        else if (it->Usage == BuffBlock.Usage && it->RangeMgr.IsEmpty())
+            HasOtherEmptyBlock = true;
+    }
+    VERIFY_EXPR(BlockIt != m_Blocks.end());
+    if (HasOtherEmptyBlock)
+        m_Blocks.erase(BlockIt);
+}
+
+} // namespace Diligent
@@ -180,105 +180,151 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
         VkBuffCI.pQueueFamilyIndices   = nullptr;                   // list of queue families that will access this buffer
                                                                     // (ignored if sharingMode is not VK_SHARING_MODE_CONCURRENT).
 
-        m_VulkanBuffer = LogicalDevice.CreateBuffer(VkBuffCI, m_Desc.Name);
-
-        VkMemoryRequirements MemReqs = LogicalDevice.GetBufferMemoryRequirements(m_VulkanBuffer);
+        auto* pSuballocator = pRenderDeviceVk->GetBufferSuballocator();
+        // Buffers with BIND_UNORDERED_ACCESS flag may be bound as atomic counters through
+        // non-dynamic descriptors that do not account for the offset in the shared buffer
+        if (pSuballocator != nullptr &&
+            (m_Desc.Usage == USAGE_DEFAULT || m_Desc.Usage == USAGE_STATIC) &&
+            (m_Desc.BindFlags & BIND_UNORDERED_ACCESS) == 0 &&
+            m_Desc.uiSizeInBytes <= pSuballocator->GetMaxBufferSize())
+        {
+            m_Suballocation = pSuballocator->Allocate(VkBuffCI.usage, m_Desc.uiSizeInBytes, m_DynamicOffsetAlignment);
+        }
 
-        VkMemoryPropertyFlags BufferMemoryFlags = 0;
-        if (m_Desc.Usage == USAGE_STAGING)
-            BufferMemoryFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+        if (m_Suballocation)
+        {
+            // The shared Vulkan buffer is not owned by this buffer
+            m_VulkanBuffer = VulkanUtilities::BufferWrapper{m_Suballocation.GetVkBuffer()};
+        }
         else
-            BufferMemoryFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+        {
+            m_VulkanBuffer = LogicalDevice.CreateBuffer(VkBuffCI, m_Desc.Name);
+
+            VkMemoryDedicatedRequirementsKHR DedicatedReqs;
+            VkMemoryRequirements             MemReqs = LogicalDevice.GetBufferMemoryRequirements(m_VulkanBuffer, DedicatedReqs);
 
-        VERIFY(IsPowerOfTwo(MemReqs.alignment), "Alignment is not power of 2!");
-        m_MemoryAllocation = pRenderDeviceVk->AllocateMemory(MemReqs, BufferMemoryFlags);
+            VkMemoryPropertyFlags BufferMemoryFlags = 0;
+            if (m_Desc.Usage == USAGE_STAGING)
+                BufferMemoryFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+            else
+                BufferMemoryFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
 
-        m_BufferMemoryAlignedOffset = Align(VkDeviceSize{m_MemoryAllocation.UnalignedOffset}, MemReqs.alignment);
-        VERIFY(m_MemoryAllocation.Size >= MemReqs.size + (m_BufferMemoryAlignedOffset - m_MemoryAllocation.UnalignedOffset), "Size of memory allocation is too small");
-        auto Memory = m_MemoryAllocation.Page->GetVkMemory();
-        auto err    = LogicalDevice.BindBufferMemory(m_VulkanBuffer, Memory, m_BufferMemoryAlignedOffset);
-        CHECK_VK_ERROR_AND_THROW(err, "Failed to bind buffer memory");
+            VERIFY(IsPowerOfTwo(MemReqs.alignment), "Alignment is not power of 2!");
+            m_MemoryAllocation = pRenderDeviceVk->AllocateMemory(MemReqs, BufferMemoryFlags, DedicatedReqs, m_VulkanBuffer, VK_NULL_HANDLE);
+
+            m_BufferMemoryAlignedOffset = Align(VkDeviceSize{m_MemoryAllocation.UnalignedOffset}, MemReqs.alignment);
+            VERIFY(m_MemoryAllocation.Size >= MemReqs.size + (m_BufferMemoryAlignedOffset - m_MemoryAllocation.UnalignedOffset), "Size of memory allocation is too small");
+            auto Memory = m_MemoryAllocation.Page->GetVkMemory();
+            auto err    = LogicalDevice.BindBufferMemory(m_VulkanBuffer, Memory, m_BufferMemoryAlignedOffset);
+            CHECK_VK_ERROR_AND_THROW(err, "Failed to bind buffer memory");
+        }
 
         bool           bInitializeBuffer = (pBuffData != nullptr && pBuffData->pData != nullptr && pBuffData->DataSize > 0);
         RESOURCE_STATE InitialState      = RESOURCE_STATE_UNDEFINED;
         if (bInitializeBuffer)
         {
-            VkBufferCreateInfo VkStaginBuffCI = VkBuffCI;
-            VkStaginBuffCI.usage              = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-
-            std::string StagingBufferName = "Upload buffer for '";
-            StagingBufferName += m_Desc.Name;
-            StagingBufferName += '\'';
-            VulkanUtilities::BufferWrapper StagingBuffer = LogicalDevice.CreateBuffer(VkStaginBuffCI, StagingBufferName.c_str());
-
-            VkMemoryRequirements StagingBufferMemReqs = LogicalDevice.GetBufferMemoryRequirements(StagingBuffer);
-            VERIFY(IsPowerOfTwo(StagingBufferMemReqs.alignment), "Alignment is not power of 2!");
-
-            // VK_MEMORY_PROPERTY_HOST_COHERENT_BIT bit specifies that the host cache management commands vkFlushMappedMemoryRanges
-            // and vkInvalidateMappedMemoryRanges are NOT needed to flush host writes to the device or make device writes visible
-            // to the host (10.2)
-            auto StagingMemoryAllocation = pRenderDeviceVk->AllocateMemory(StagingBufferMemReqs, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-            auto StagingBufferMemory     = StagingMemoryAllocation.Page->GetVkMemory();
-            auto AlignedStagingMemOffset = Align(VkDeviceSize{StagingMemoryAllocation.UnalignedOffset}, StagingBufferMemReqs.alignment);
-            VERIFY_EXPR(StagingMemoryAllocation.Size >= StagingBufferMemReqs.size + (AlignedStagingMemOffset - StagingMemoryAllocation.UnalignedOffset));
-
-            auto* StagingData = reinterpret_cast<uint8_t*>(StagingMemoryAllocation.Page->GetCPUMemory());
-            if (StagingData == nullptr)
-                LOG_BUFFER_ERROR_AND_THROW("Failed to allocate staging data");
-            memcpy(StagingData + AlignedStagingMemOffset, pBuffData->pData, pBuffData->DataSize);
-
-            err = LogicalDevice.BindBufferMemory(StagingBuffer, StagingBufferMemory, AlignedStagingMemOffset);
-            CHECK_VK_ERROR_AND_THROW(err, "Failed to bind staging bufer memory");
-
-            VulkanUtilities::CommandPoolWrapper CmdPool;
-            VkCommandBuffer                     vkCmdBuff;
-            pRenderDeviceVk->AllocateTransientCmdPool(CmdPool, vkCmdBuff, "Transient command pool to copy staging data to a device buffer");
-
-            auto EnabledGraphicsShaderStages = LogicalDevice.GetEnabledGraphicsShaderStages();
-            VulkanUtilities::VulkanCommandBuffer::BufferMemoryBarrier(vkCmdBuff, StagingBuffer, 0, VK_ACCESS_TRANSFER_READ_BIT, EnabledGraphicsShaderStages);
             InitialState              = RESOURCE_STATE_COPY_DEST;
             VkAccessFlags AccessFlags = ResourceStateFlagsToVkAccessFlags(InitialState);
             VERIFY_EXPR(AccessFlags == VK_ACCESS_TRANSFER_WRITE_BIT);
-            VulkanUtilities::VulkanCommandBuffer::BufferMemoryBarrier(vkCmdBuff, m_VulkanBuffer, 0, AccessFlags, EnabledGraphicsShaderStages);
-
-            // Copy commands MUST be recorded outside of a render pass instance. This is OK here
-            // as copy will be the only command in the cmd buffer
-            VkBufferCopy BuffCopy = {};
-            BuffCopy.srcOffset    = 0;
-            BuffCopy.dstOffset    = 0;
-            BuffCopy.size         = VkBuffCI.size;
-            vkCmdCopyBuffer(vkCmdBuff, StagingBuffer, m_VulkanBuffer, 1, &BuffCopy);
-
-            Uint32 QueueIndex = 0;
-            pRenderDeviceVk->ExecuteAndDisposeTransientCmdBuff(QueueIndex, vkCmdBuff, std::move(CmdPool));
-
-
-            // After command buffer is submitted, safe-release staging resources. This strategy
-            // is little overconservative as the resources will only be released after the
-            // first command buffer submitted through the immediate context is complete
-
-            // Next Cmd Buff| Next Fence |               This Thread                      |           Immediate Context
-            //              |            |                                                |
-            //      N       |     F      |                                                |
-            //              |            |                                                |
-            //              |            |  ExecuteAndDisposeTransientCmdBuff(vkCmdBuff)  |
-            //              |            |  - SubmittedCmdBuffNumber = N                  |
-            //              |            |  - SubmittedFenceValue = F                     |
-            //     N+1 -  - | -  F+1  -  |                                                |
-            //              |            |  Release(StagingBuffer)                        |
-            //              |            |  - {N+1, StagingBuffer} -> Stale Objects       |
-            //              |            |                                                |
-            //              |            |                                                |
-            //              |            |                                                | ExecuteCommandBuffer()
-            //              |            |                                                | - SubmittedCmdBuffNumber = N+1
-            //              |            |                                                | - SubmittedFenceValue = F+1
-            //     N+2 -  - | -  F+2  -  |  -   -   -   -   -   -   -   -   -   -   -   - |
-            //              |            |                                                | - DiscardStaleVkObjects(N+1, F+1)
-            //              |            |                                                |   - {F+1, StagingBuffer} -> Release Queue
-            //              |            |                                                |
-
-            pRenderDeviceVk->SafeReleaseDeviceObject(std::move(StagingBuffer), Uint64{1} << Uint64{QueueIndex});
-            pRenderDeviceVk->SafeReleaseDeviceObject(std::move(StagingMemoryAllocation), Uint64{1} << Uint64{QueueIndex});
+
+            auto EnabledGraphicsShaderStages = LogicalDevice.GetEnabledGraphicsShaderStages();
+
+            auto RecordCopyCommands = [&](VkCommandBuffer vkCmdBuff, VkBuffer vkStagingBuffer, VkDeviceSize StagingBufferOffset) //
+            {
+                VulkanUtilities::VulkanCommandBuffer::BufferMemoryBarrier(vkCmdBuff, m_VulkanBuffer, 0, AccessFlags, EnabledGraphicsShaderStages, 0, 0, GetVkBufferOffset(), GetVkBufferRange());
+
+                // Copy commands MUST be recorded outside of a render pass instance. This is OK here
+                // as the command buffer only contains resource initialization commands
+                VkBufferCopy BuffCopy = {};
+                BuffCopy.srcOffset    = StagingBufferOffset;
+                BuffCopy.dstOffset    = GetVkBufferOffset();
+                BuffCopy.size         = VkBuffCI.size;
+                vkCmdCopyBuffer(vkCmdBuff, vkStagingBuffer, m_VulkanBuffer, 1, &BuffCopy);
+            };
+
+            auto* pUploadBatch = pRenderDeviceVk->GetResourceUploadBatch();
+            bool  IsBatched    = false;
+            if (pUploadBatch != nullptr)
+            {
+                IsBatched = pUploadBatch->Record(
+                    static_cast<size_t>(VkBuffCI.size), static_cast<size_t>(DeviceLimits.optimalBufferCopyOffsetAlignment),
+                    [&](VkCommandBuffer vkCmdBuff, const ResourceUploadBatch::StagingRegion& Staging) //
+                    {
+                        // Host writes to the shared staging buffer are made visible to the device
+                        // when the batch is submitted, so no buffer barrier is required
+                        memcpy(Staging.pCPUAddress, pBuffData->pData, pBuffData->DataSize);
+                        RecordCopyCommands(vkCmdBuff, Staging.vkBuffer, Staging.Offset);
+                    } //
+                );
+            }
+
+            if (!IsBatched)
+            {
+                VkBufferCreateInfo VkStaginBuffCI = VkBuffCI;
+                VkStaginBuffCI.usage              = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+                std::string StagingBufferName = "Upload buffer for '";
+                StagingBufferName += m_Desc.Name;
+                StagingBufferName += '\'';
+                VulkanUtilities::BufferWrapper StagingBuffer = LogicalDevice.CreateBuffer(VkStaginBuffCI, StagingBufferName.c_str());
+
+                VkMemoryRequirements StagingBufferMemReqs = LogicalDevice.GetBufferMemoryRequirements(StagingBuffer);
+                VERIFY(IsPowerOfTwo(StagingBufferMemReqs.alignment), "Alignment is not power of 2!");
+
+                // VK_MEMORY_PROPERTY_HOST_COHERENT_BIT bit specifies that the host cache management commands vkFlushMappedMemoryRanges
+                // and vkInvalidateMappedMemoryRanges are NOT needed to flush host writes to the device or make device writes visible
+                // to the host (10.2)
+                auto StagingMemoryAllocation = pRenderDeviceVk->AllocateMemory(StagingBufferMemReqs, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+                auto StagingBufferMemory     = StagingMemoryAllocation.Page->GetVkMemory();
+                auto AlignedStagingMemOffset = Align(VkDeviceSize{StagingMemoryAllocation.UnalignedOffset}, StagingBufferMemReqs.alignment);
+                VERIFY_EXPR(StagingMemoryAllocation.Size >= StagingBufferMemReqs.size + (AlignedStagingMemOffset - StagingMemoryAllocation.UnalignedOffset));
+
+                auto* StagingData = reinterpret_cast<uint8_t*>(StagingMemoryAllocation.Page->GetCPUMemory());
+                if (StagingData == nullptr)
+                    LOG_BUFFER_ERROR_AND_THROW("Failed to allocate staging data");
+                memcpy(StagingData + AlignedStagingMemOffset, pBuffData->pData, pBuffData->DataSize);
+
+                auto err = LogicalDevice.BindBufferMemory(StagingBuffer, StagingBufferMemory, AlignedStagingMemOffset);
+                CHECK_VK_ERROR_AND_THROW(err, "Failed to bind staging bufer memory");
+
+                VulkanUtilities::CommandPoolWrapper CmdPool;
+                VkCommandBuffer                     vkCmdBuff;
+                pRenderDeviceVk->AllocateTransientCmdPool(CmdPool, vkCmdBuff, "Transient command pool to copy staging data to a device buffer");
+
+                VulkanUtilities::VulkanCommandBuffer::BufferMemoryBarrier(vkCmdBuff, StagingBuffer, 0, VK_ACCESS_TRANSFER_READ_BIT, EnabledGraphicsShaderStages);
+                RecordCopyCommands(vkCmdBuff, StagingBuffer, 0);
+
+                Uint32 QueueIndex = 0;
+                pRenderDeviceVk->ExecuteAndDisposeTransientCmdBuff(QueueIndex, vkCmdBuff, std::move(CmdPool));
+
+
+                // After command buffer is submitted, safe-release staging resources. This strategy
+                // is little overconservative as the resources will only be released after the
+                // first command buffer submitted through the immediate context is complete
+
+                // Next Cmd Buff| Next Fence |               This Thread                      |           Immediate Context
+                //              |            |                                                |
+                //      N       |     F      |                                                |
+                //              |            |                                                |
+                //              |            |  ExecuteAndDisposeTransientCmdBuff(vkCmdBuff)  |
+                //              |            |  - SubmittedCmdBuffNumber = N                  |
+                //              |            |  - SubmittedFenceValue = F                     |
+                //     N+1 -  - | -  F+1  -  |                                                |
+                //              |            |  Release(StagingBuffer)                        |
+                //              |            |  - {N+1, StagingBuffer} -> Stale Objects       |
+                //              |            |                                                |
+                //              |            |                                                |
+                //              |            |                                                | ExecuteCommandBuffer()
+                //              |            |                                                | - SubmittedCmdBuffNumber = N+1
+                //              |            |                                                | - SubmittedFenceValue = F+1
+                //     N+2 -  - | -  F+2  -  |  -   -   -   -   -   -   -   -   -   -   -   - |
+                //              |            |                                                | - DiscardStaleVkObjects(N+1, F+1)
+                //              |            |                                                |   - {F+1, StagingBuffer} -> Release Queue
+                //              |            |                                                |
+
+                pRenderDeviceVk->SafeReleaseDeviceObject(std::move(StagingBuffer), Uint64{1} << Uint64{QueueIndex});
+                pRenderDeviceVk->SafeReleaseDeviceObject(std::move(StagingMemoryAllocation), Uint64{1} << Uint64{QueueIndex});
+            }
         }
 
         SetState(InitialState);
@@ -317,6 +363,8 @@ BufferVkImpl::~BufferVkImpl()
         m_pDevice->SafeReleaseDeviceObject(std::move(m_VulkanBuffer), m_Desc.CommandQueueMask);
     if (m_MemoryAllocation.Page != nullptr)
         m_pDevice->SafeReleaseDeviceObject(std::move(m_MemoryAllocation), m_Desc.CommandQueueMask);
+    if (m_Suballocation)
+        m_pDevice->SafeReleaseDeviceObject(std::move(m_Suballocation), m_Desc.CommandQueueMask);
 }
 
 IMPLEMENT_QUERY_INTERFACE(BufferVkImpl, IID_BufferVk, TBufferBase)
@@ -375,8 +423,8 @@ VulkanUtilities::BufferViewWrapper BufferVkImpl::CreateView(struct BufferViewDes
             DEV_CHECK_ERR(ViewDesc.Format.ValueType != VT_UNDEFINED, "Undefined format");
             ViewCI.format = TypeToVkFormat(ViewDesc.Format.ValueType, ViewDesc.Format.NumComponents, ViewDesc.Format.IsNormalized);
         }
-        ViewCI.offset = ViewDesc.ByteOffset; // offset in bytes from the base address of the buffer
-        ViewCI.range  = ViewDesc.ByteWidth;  // size in bytes of the buffer view
+        ViewCI.offset = GetVkBufferOffset() + ViewDesc.ByteOffset; // offset in bytes from the base address of the buffer
+        ViewCI.range  = ViewDesc.ByteWidth;                        // size in bytes of the buffer view
 
         const auto& LogicalDevice = m_pDevice->GetLogicalDevice();
         BuffView                  = LogicalDevice.CreateBufferView(ViewCI, ViewDesc.Name);
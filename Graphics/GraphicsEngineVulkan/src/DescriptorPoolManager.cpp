@@ -26,6 +26,7 @@
  */
 
 #include "pch.h"
+#include <thread>
 #include "DescriptorPoolManager.hpp"
 #include "RenderDeviceVkImpl.hpp"
 
@@ -37,7 +38,7 @@ void DescriptorSetAllocation::Release()
     if (Set != VK_NULL_HANDLE)
     {
         VERIFY_EXPR(DescrSetAllocator != nullptr && Pool != VK_NULL_HANDLE);
-        DescrSetAllocator->FreeDescriptorSet(Set, Pool, CmdQueueMask);
+        DescrSetAllocator->FreeDescriptorSet(Set, Pool, Layout, RecycleBin, CmdQueueMask);
 
         Reset();
     }
@@ -155,14 +156,51 @@ static VkDescriptorSet AllocateDescriptorSet(const VulkanUtilities::VulkanLogica
 DescriptorSetAllocator::~DescriptorSetAllocator()
 {
     DEV_CHECK_ERR(m_AllocatedSetCounter == 0, m_AllocatedSetCounter, " descriptor set(s) have not been returned to the allocator. If there are outstanding references to the sets in release queues, the app will crash when DescriptorSetAllocator::FreeDescriptorSet() is called");
+
+    // Recycled sets are implicitly freed when the pools are destroyed
+}
+
+Uint32 DescriptorSetAllocator::GetThreadRecycleBin()
+{
+    return static_cast<Uint32>(std::hash<std::thread::id>{}(std::this_thread::get_id()) % NumRecycleBins);
 }
 
 DescriptorSetAllocation DescriptorSetAllocator::Allocate(Uint64 CommandQueueMask, VkDescriptorSetLayout SetLayout, const char* DebugName)
 {
+    m_NumAllocations.fetch_add(1, std::memory_order_relaxed);
+
+    const auto BinIdx = GetThreadRecycleBin();
+    {
+        auto& Bin = m_RecycleBins[BinIdx];
+
+        std::lock_guard<std::mutex> BinLock{Bin.Mtx};
+
+        auto it = Bin.Sets.find(SetLayout);
+        if (it != Bin.Sets.end() && !it->second.empty())
+        {
+            const auto Recycled = it->second.back();
+            it->second.pop_back();
+
+            m_NumRecycledSets.fetch_add(1, std::memory_order_relaxed);
+            m_NumCachedSets.fetch_add(-1, std::memory_order_relaxed);
+#ifdef DILIGENT_DEVELOPMENT
+            ++m_AllocatedSetCounter;
+#endif
+            if (DebugName != nullptr && *DebugName != 0)
+                VulkanUtilities::SetDescriptorSetName(m_DeviceVkImpl.GetLogicalDevice().GetVkDevice(), Recycled.Set, DebugName);
+
+            // The set still contains the descriptors written by its previous owner. All descriptors
+            // used by the pipeline are overwritten by the new owner before the set is bound.
+            return {Recycled.Set, Recycled.Pool, SetLayout, BinIdx, CommandQueueMask, *this};
+        }
+    }
+
     // Descriptor pools are externally synchronized, meaning that the application must not allocate
     // and/or free descriptor sets from the same pool in multiple threads simultaneously (13.2.3)
     std::lock_guard<std::mutex> Lock{m_Mutex};
 
+    m_NumPoolAllocations.fetch_add(1, std::memory_order_relaxed);
+
     const auto& LogicalDevice = m_DeviceVkImpl.GetLogicalDevice();
     // Try all pools starting from the frontmost
     for (auto it = m_Pools.begin(); it != m_Pools.end(); ++it)
@@ -177,10 +215,12 @@ DescriptorSetAllocation DescriptorSetAllocator::Allocate(Uint64 CommandQueueMask
                 std::swap(*it, m_Pools.front());
             }
 
+            VkDescriptorPool vkPool = m_Pools.front();
+            ++m_PoolSetCounts[vkPool];
 #ifdef DILIGENT_DEVELOPMENT
             ++m_AllocatedSetCounter;
 #endif
-            return {Set, Pool, CommandQueueMask, *this};
+            return {Set, vkPool, SetLayout, BinIdx, CommandQueueMask, *this};
         }
     }
 
@@ -192,14 +232,16 @@ DescriptorSetAllocation DescriptorSetAllocator::Allocate(Uint64 CommandQueueMask
     auto  Set     = AllocateDescriptorSet(LogicalDevice, NewPool, SetLayout, DebugName);
     DEV_CHECK_ERR(Set != VK_NULL_HANDLE, "Failed to allocate descriptor set");
 
+    VkDescriptorPool vkNewPool = NewPool;
+    ++m_PoolSetCounts[vkNewPool];
 #ifdef DILIGENT_DEVELOPMENT
     ++m_AllocatedSetCounter;
 #endif
 
-    return {Set, NewPool, CommandQueueMask, *this};
+    return {Set, vkNewPool, SetLayout, BinIdx, CommandQueueMask, *this};
 }
 
-void DescriptorSetAllocator::FreeDescriptorSet(VkDescriptorSet Set, VkDescriptorPool Pool, Uint64 QueueMask)
+void DescriptorSetAllocator::FreeDescriptorSet(VkDescriptorSet Set, VkDescriptorPool Pool, VkDescriptorSetLayout Layout, Uint32 BinIdx, Uint64 QueueMask)
 {
     class DescriptorSetDeleter
     {
@@ -207,10 +249,14 @@ void DescriptorSetAllocator::FreeDescriptorSet(VkDescriptorSet Set, VkDescriptor
         // clang-format off
         DescriptorSetDeleter(DescriptorSetAllocator& _Allocator,
                              VkDescriptorSet         _Set,
-                             VkDescriptorPool        _Pool) : 
+                             VkDescriptorPool        _Pool,
+                             VkDescriptorSetLayout   _Layout,
+                             Uint32                  _BinIdx) : 
             Allocator {&_Allocator},
             Set       {_Set       },
-            Pool      {_Pool      }
+            Pool      {_Pool      },
+            Layout    {_Layout    },
+            BinIdx    {_BinIdx    }
         {}
 
         DescriptorSetDeleter             (const DescriptorSetDeleter&) = delete;
@@ -220,11 +266,14 @@ void DescriptorSetAllocator::FreeDescriptorSet(VkDescriptorSet Set, VkDescriptor
         DescriptorSetDeleter(DescriptorSetDeleter&& rhs)noexcept : 
             Allocator {rhs.Allocator},
             Set       {rhs.Set      },
-            Pool      {rhs.Pool     }
+            Pool      {rhs.Pool     },
+            Layout    {rhs.Layout   },
+            BinIdx    {rhs.BinIdx   }
         {
             rhs.Allocator = nullptr;
             rhs.Set       = VK_NULL_HANDLE;
             rhs.Pool      = VK_NULL_HANDLE;
+            rhs.Layout    = VK_NULL_HANDLE;
         }
         // clang-format on
 
@@ -232,8 +281,8 @@ void DescriptorSetAllocator::FreeDescriptorSet(VkDescriptorSet Set, VkDescriptor
         {
             if (Allocator != nullptr)
             {
-                std::lock_guard<std::mutex> Lock{Allocator->m_Mutex};
-                Allocator->m_DeviceVkImpl.GetLogicalDevice().FreeDescriptorSet(Pool, Set);
+                // The GPU is done with the set, so it can be handed out again
+                Allocator->RecycleDescriptorSet(Set, Pool, Layout, BinIdx);
 #ifdef DILIGENT_DEVELOPMENT
                 --Allocator->m_AllocatedSetCounter;
 #endif
@@ -244,8 +293,125 @@ void DescriptorSetAllocator::FreeDescriptorSet(VkDescriptorSet Set, VkDescriptor
         DescriptorSetAllocator* Allocator;
         VkDescriptorSet         Set;
         VkDescriptorPool        Pool;
+        VkDescriptorSetLayout   Layout;
+        Uint32                  BinIdx;
+    };
+    m_DeviceVkImpl.SafeReleaseDeviceObject(DescriptorSetDeleter{*this, Set, Pool, Layout, BinIdx}, QueueMask);
+}
+
+void DescriptorSetAllocator::RecycleDescriptorSet(VkDescriptorSet Set, VkDescriptorPool Pool, VkDescriptorSetLayout Layout, Uint32 BinIdx)
+{
+    VERIFY_EXPR(BinIdx < NumRecycleBins);
+    {
+        auto& Bin = m_RecycleBins[BinIdx];
+
+        std::lock_guard<std::mutex> BinLock{Bin.Mtx};
+
+        auto& Sets = Bin.Sets[Layout];
+        if (Sets.size() < MaxRecycledSetsPerLayout)
+        {
+            Sets.push_back({Set, Pool});
+            m_NumCachedSets.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    ReturnDescriptorSetToPool(Set, Pool);
+}
+
+void DescriptorSetAllocator::ReturnDescriptorSetToPool(VkDescriptorSet Set, VkDescriptorPool Pool)
+{
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+
+    const auto& LogicalDevice = m_DeviceVkImpl.GetLogicalDevice();
+
+    auto it = m_PoolSetCounts.find(Pool);
+    VERIFY(it != m_PoolSetCounts.end() && it->second > 0, "The set was not allocated from this pool");
+    if (--it->second == 0)
+    {
+        // All sets allocated from the pool have been returned: reset the pool in bulk, which
+        // also eliminates fragmentation caused by freeing individual sets
+        LogicalDevice.ResetDescriptorPool(Pool);
+        m_NumPoolResets.fetch_add(1, std::memory_order_relaxed);
+    }
+    else if (m_AllowFreeing)
+    {
+        LogicalDevice.FreeDescriptorSet(Pool, Set);
+    }
+}
+
+void DescriptorSetAllocator::ReleaseRecycledSets(VkDescriptorSetLayout Layout)
+{
+    for (auto& Bin : m_RecycleBins)
+    {
+        std::vector<RecycledSet> Sets;
+        {
+            std::lock_guard<std::mutex> BinLock{Bin.Mtx};
+
+            auto it = Bin.Sets.find(Layout);
+            if (it == Bin.Sets.end())
+                continue;
+            Sets = std::move(it->second);
+            Bin.Sets.erase(it);
+        }
+
+        m_NumCachedSets.fetch_add(-static_cast<Int32>(Sets.size()), std::memory_order_relaxed);
+        for (const auto& Recycled : Sets)
+            ReturnDescriptorSetToPool(Recycled.Set, Recycled.Pool);
+    }
+}
+
+void DescriptorSetAllocator::DisposeDescriptorSetLayout(VulkanUtilities::DescriptorSetLayoutWrapper&& Layout, Uint64 QueueMask)
+{
+    class DescriptorSetLayoutDeleter
+    {
+    public:
+        // clang-format off
+        DescriptorSetLayoutDeleter(DescriptorSetAllocator&                       _Allocator,
+                                   VulkanUtilities::DescriptorSetLayoutWrapper&& _Layout) noexcept : 
+            Allocator{&_Allocator       },
+            Layout   {std::move(_Layout)}
+        {}
+
+        DescriptorSetLayoutDeleter            (const DescriptorSetLayoutDeleter&) = delete;
+        DescriptorSetLayoutDeleter& operator= (const DescriptorSetLayoutDeleter&) = delete;
+        DescriptorSetLayoutDeleter& operator= (      DescriptorSetLayoutDeleter&&)= delete;
+
+        DescriptorSetLayoutDeleter(DescriptorSetLayoutDeleter&& rhs)noexcept : 
+            Allocator{rhs.Allocator        },
+            Layout   {std::move(rhs.Layout)}
+        {
+            rhs.Allocator = nullptr;
+        }
+        // clang-format on
+
+        ~DescriptorSetLayoutDeleter()
+        {
+            if (Allocator != nullptr)
+            {
+                // Sets released before the layout have already been recycled as the release
+                // queue is processed in order
+                Allocator->ReleaseRecycledSets(Layout);
+            }
+        }
+
+    private:
+        DescriptorSetAllocator*                     Allocator;
+        VulkanUtilities::DescriptorSetLayoutWrapper Layout;
     };
-    m_DeviceVkImpl.SafeReleaseDeviceObject(DescriptorSetDeleter{*this, Set, Pool}, QueueMask);
+
+    m_DeviceVkImpl.SafeReleaseDeviceObject(DescriptorSetLayoutDeleter{*this, std::move(Layout)}, QueueMask);
+}
+
+DescriptorSetAllocator::Statistics DescriptorSetAllocator::GetStatistics() const
+{
+    Statistics Stats;
+    Stats.NumAllocations     = m_NumAllocations.load(std::memory_order_relaxed);
+    Stats.NumRecycledSets    = m_NumRecycledSets.load(std::memory_order_relaxed);
+    Stats.NumPoolAllocations = m_NumPoolAllocations.load(std::memory_order_relaxed);
+    Stats.NumPoolResets      = m_NumPoolResets.load(std::memory_order_relaxed);
+    Stats.NumCachedSets      = static_cast<Uint32>(std::max(m_NumCachedSets.load(std::memory_order_relaxed), 0));
+    return Stats;
 }
 
 
@@ -36,6 +36,7 @@
 #include "CommandListVkImpl.hpp"
 #include "FenceVkImpl.hpp"
 #include "GraphicsAccessories.hpp"
+#include "CPUProfiler.hpp"
 
 namespace Diligent
 {
@@ -114,11 +115,15 @@ DeviceContextVkImpl::DeviceContextVkImpl(IReferenceCounters*                   p
     RefCntAutoPtr<IBuffer> pDummyVB;
     m_pDevice->CreateBuffer(DummyVBDesc, nullptr, &pDummyVB);
     m_DummyVB = pDummyVB.RawPtr<BufferVkImpl>();
+
+    const auto& EnabledFeatures = pDeviceVkImpl->GetLogicalDevice().GetEnabledFeatures();
+    if (EnabledFeatures.multiDrawIndirect && EnabledFeatures.drawIndirectFirstInstance)
+        m_MaxMultiDrawIndirectCount = pDeviceVkImpl->GetPhysicalDevice().GetProperties().limits.maxDrawIndirectCount;
 }
 
 DeviceContextVkImpl::~DeviceContextVkImpl()
 {
-    if (m_State.NumCommands != 0)
+    if (HasPendingCommands())
     {
         if (m_bIsDeferred)
         {
@@ -168,7 +173,7 @@ DeviceContextVkImpl::~DeviceContextVkImpl()
 
 IMPLEMENT_QUERY_INTERFACE(DeviceContextVkImpl, IID_DeviceContextVk, TDeviceContextBase)
 
-void DeviceContextVkImpl::DisposeVkCmdBuffer(Uint32 CmdQueue, VkCommandBuffer vkCmdBuff, Uint64 FenceValue)
+void DeviceContextVkImpl::DisposeVkCmdBuffer(Uint32 CmdQueue, VkCommandBuffer vkCmdBuff, Uint64 FenceValue, VkCommandBufferLevel Level)
 {
     VERIFY_EXPR(vkCmdBuff != VK_NULL_HANDLE);
     class CmdBufferDeleter
@@ -176,9 +181,11 @@ void DeviceContextVkImpl::DisposeVkCmdBuffer(Uint32 CmdQueue, VkCommandBuffer vk
     public:
         // clang-format off
         CmdBufferDeleter(VkCommandBuffer                           _vkCmdBuff, 
-                            VulkanUtilities::VulkanCommandBufferPool& _Pool) noexcept :
+                            VulkanUtilities::VulkanCommandBufferPool& _Pool,
+                            VkCommandBufferLevel                      _Level) noexcept :
             vkCmdBuff {_vkCmdBuff},
-            Pool      {&_Pool    }
+            Pool      {&_Pool    },
+            Level     {_Level    }
         {
             VERIFY_EXPR(vkCmdBuff != VK_NULL_HANDLE);
         }
@@ -189,7 +196,8 @@ void DeviceContextVkImpl::DisposeVkCmdBuffer(Uint32 CmdQueue, VkCommandBuffer vk
 
         CmdBufferDeleter(CmdBufferDeleter&& rhs) noexcept : 
             vkCmdBuff {rhs.vkCmdBuff},
-            Pool      {rhs.Pool     }
+            Pool      {rhs.Pool     },
+            Level     {rhs.Level    }
         {
             rhs.vkCmdBuff = VK_NULL_HANDLE;
             rhs.Pool      = nullptr;
@@ -200,17 +208,18 @@ void DeviceContextVkImpl::DisposeVkCmdBuffer(Uint32 CmdQueue, VkCommandBuffer vk
         {
             if (Pool != nullptr)
             {
-                Pool->FreeCommandBuffer(std::move(vkCmdBuff));
+                Pool->FreeCommandBuffer(std::move(vkCmdBuff), Level);
             }
         }
 
     private:
         VkCommandBuffer                           vkCmdBuff;
         VulkanUtilities::VulkanCommandBufferPool* Pool;
+        VkCommandBufferLevel                      Level;
     };
 
     auto& ReleaseQueue = m_pDevice->GetReleaseQueue(CmdQueue);
-    ReleaseQueue.DiscardResource(CmdBufferDeleter{vkCmdBuff, m_CmdPool}, FenceValue);
+    ReleaseQueue.DiscardResource(CmdBufferDeleter{vkCmdBuff, m_CmdPool, Level}, FenceValue);
 }
 
 inline void DeviceContextVkImpl::DisposeCurrentCmdBuffer(Uint32 CmdQueue, Uint64 FenceValue)
@@ -228,7 +237,7 @@ inline void DeviceContextVkImpl::DisposeCurrentCmdBuffer(Uint32 CmdQueue, Uint64
 void DeviceContextVkImpl::SetPipelineState(IPipelineState* pPipelineState)
 {
     auto* pPipelineStateVk = ValidatedCast<PipelineStateVkImpl>(pPipelineState);
-    if (PipelineStateVkImpl::IsSameObject(m_pPipelineState, pPipelineStateVk))
+    if (IsPipelineStateBound(pPipelineStateVk))
         return;
 
     // Never flush deferred context!
@@ -301,6 +310,8 @@ void DeviceContextVkImpl::TransitionShaderResources(IPipelineState* pPipelineSta
 
 void DeviceContextVkImpl::CommitShaderResources(IShaderResourceBinding* pShaderResourceBinding, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    DILIGENT_PROFILE_SCOPE("DeviceContextVkImpl::CommitShaderResources");
+
     if (!DeviceContextBase::CommitShaderResources(pShaderResourceBinding, StateTransitionMode, 0 /*Dummy*/))
         return;
 
@@ -414,6 +425,8 @@ void DeviceContextVkImpl::DvpLogRenderPass_PSOMismatch()
 
 void DeviceContextVkImpl::PrepareForDraw(DRAW_FLAGS Flags)
 {
+    DILIGENT_PROFILE_SCOPE("DeviceContextVkImpl::PrepareForDraw");
+
 #ifdef DILIGENT_DEVELOPMENT
     if ((Flags & DRAW_FLAG_VERIFY_RENDER_TARGETS) != 0)
         DvpVerifyRenderTargets();
@@ -553,9 +566,104 @@ void DeviceContextVkImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs&
     ++m_State.NumCommands;
 }
 
+void DeviceContextVkImpl::MultiDraw(const MultiDrawAttribs& Attribs)
+{
+    if (!DvpVerifyMultiDrawArguments(Attribs) || Attribs.DrawCount == 0)
+        return;
+
+    PrepareForDraw(Attribs.Flags);
+
+    if (Attribs.DrawCount >= MinMultiDrawIndirectCount && m_MaxMultiDrawIndirectCount > 1)
+    {
+        constexpr Uint32 Stride = sizeof(VkDrawIndirectCommand);
+
+        auto DynAlloc = AllocateDynamicSpace(Stride * Attribs.DrawCount, 16);
+        if (DynAlloc.pDynamicMemMgr != nullptr)
+        {
+            auto* pCommands = reinterpret_cast<VkDrawIndirectCommand*>(DynAlloc.pDynamicMemMgr->GetCPUAddress() + DynAlloc.AlignedOffset);
+            for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+            {
+                const auto& Item = Attribs.pDrawItems[i];
+                auto&       Cmd  = pCommands[i];
+
+                Cmd.vertexCount   = Item.NumVertices;
+                Cmd.instanceCount = Item.NumInstances;
+                Cmd.firstVertex   = Item.StartVertexLocation;
+                Cmd.firstInstance = Item.FirstInstanceLocation;
+            }
+
+            // Host writes to the dynamic heap are made visible to the device by the queue submission
+            const auto vkBuffer = DynAlloc.pDynamicMemMgr->GetVkBuffer();
+            for (Uint32 FirstDraw = 0; FirstDraw < Attribs.DrawCount; FirstDraw += m_MaxMultiDrawIndirectCount)
+            {
+                const auto DrawCount = std::min(Attribs.DrawCount - FirstDraw, m_MaxMultiDrawIndirectCount);
+                m_CommandBuffer.DrawIndirect(vkBuffer, DynAlloc.AlignedOffset + VkDeviceSize{FirstDraw} * Stride, DrawCount, Stride);
+                ++m_State.NumCommands;
+            }
+            return;
+        }
+    }
+
+    for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+    {
+        const auto& Item = Attribs.pDrawItems[i];
+        m_CommandBuffer.Draw(Item.NumVertices, Item.NumInstances, Item.StartVertexLocation, Item.FirstInstanceLocation);
+    }
+    m_State.NumCommands += Attribs.DrawCount;
+}
+
+void DeviceContextVkImpl::MultiDrawIndexed(const MultiDrawIndexedAttribs& Attribs)
+{
+    if (!DvpVerifyMultiDrawIndexedArguments(Attribs) || Attribs.DrawCount == 0)
+        return;
+
+    PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
+
+    if (Attribs.DrawCount >= MinMultiDrawIndirectCount && m_MaxMultiDrawIndirectCount > 1)
+    {
+        constexpr Uint32 Stride = sizeof(VkDrawIndexedIndirectCommand);
+
+        auto DynAlloc = AllocateDynamicSpace(Stride * Attribs.DrawCount, 16);
+        if (DynAlloc.pDynamicMemMgr != nullptr)
+        {
+            auto* pCommands = reinterpret_cast<VkDrawIndexedIndirectCommand*>(DynAlloc.pDynamicMemMgr->GetCPUAddress() + DynAlloc.AlignedOffset);
+            for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+            {
+                const auto& Item = Attribs.pDrawItems[i];
+                auto&       Cmd  = pCommands[i];
+
+                Cmd.indexCount    = Item.NumIndices;
+                Cmd.instanceCount = Item.NumInstances;
+                Cmd.firstIndex    = Item.FirstIndexLocation;
+                Cmd.vertexOffset  = static_cast<int32_t>(Item.BaseVertex);
+                Cmd.firstInstance = Item.FirstInstanceLocation;
+            }
+
+            // Host writes to the dynamic heap are made visible to the device by the queue submission
+            const auto vkBuffer = DynAlloc.pDynamicMemMgr->GetVkBuffer();
+            for (Uint32 FirstDraw = 0; FirstDraw < Attribs.DrawCount; FirstDraw += m_MaxMultiDrawIndirectCount)
+            {
+                const auto DrawCount = std::min(Attribs.DrawCount - FirstDraw, m_MaxMultiDrawIndirectCount);
+                m_CommandBuffer.DrawIndexedIndirect(vkBuffer, DynAlloc.AlignedOffset + VkDeviceSize{FirstDraw} * Stride, DrawCount, Stride);
+                ++m_State.NumCommands;
+            }
+            return;
+        }
+    }
+
+    for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+    {
+        const auto& Item = Attribs.pDrawItems[i];
+        m_CommandBuffer.DrawIndexed(Item.NumIndices, Item.NumInstances, Item.FirstIndexLocation, Item.BaseVertex, Item.FirstInstanceLocation);
+    }
+    m_State.NumCommands += Attribs.DrawCount;
+}
+
 
 void DeviceContextVkImpl::PrepareForDispatchCompute()
 {
+    DILIGENT_PROFILE_SCOPE("DeviceContextVkImpl::PrepareForDispatchCompute");
+
     EnsureVkCmdBuffer();
 
     // Dispatch commands must be executed outside of render pass
@@ -814,7 +922,7 @@ void DeviceContextVkImpl::FinishFrame()
     }
 #endif
 
-    if (GetNumCommandsInCtx() != 0)
+    if (HasPendingCommands())
     {
         if (m_bIsDeferred)
         {
@@ -864,6 +972,8 @@ void DeviceContextVkImpl::FinishFrame()
 
 void DeviceContextVkImpl::Flush()
 {
+    DILIGENT_PROFILE_SCOPE("DeviceContextVkImpl::Flush");
+
     if (m_bIsDeferred)
     {
         LOG_ERROR_MESSAGE("Flush() should only be called for immediate contexts");
@@ -889,7 +999,7 @@ void DeviceContextVkImpl::Flush()
             m_State.NumCommands += m_QueryMgr->ResetStaleQueries(m_CommandBuffer);
         }
 
-        if (m_State.NumCommands != 0)
+        if (HasPendingCommands())
         {
             if (m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
             {
@@ -930,6 +1040,15 @@ void DeviceContextVkImpl::Flush()
         DisposeCurrentCmdBuffer(m_CommandQueueId, SubmittedFenceValue);
     }
 
+    for (auto& ExecutedCmdBuff : m_ExecutedSecondaryCmdBuffers)
+    {
+        auto* pDeferredCtxVkImpl = ExecutedCmdBuff.second.RawPtr<DeviceContextVkImpl>();
+        // Set the bit in the deferred context cmd queue mask corresponding to cmd queue of this context
+        pDeferredCtxVkImpl->m_SubmittedBuffersCmdQueueMask |= Uint64{1} << m_CommandQueueId;
+        pDeferredCtxVkImpl->DisposeVkCmdBuffer(m_CommandQueueId, ExecutedCmdBuff.first, SubmittedFenceValue, VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+    }
+    m_ExecutedSecondaryCmdBuffers.clear();
+
     m_State = ContextState{};
     m_DescrSetBindInfo.Reset();
     m_CommandBuffer.Reset();
@@ -943,7 +1062,9 @@ void DeviceContextVkImpl::SetVertexBuffers(Uint32                         StartS
                                            RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
                                            SET_VERTEX_BUFFERS_FLAGS       Flags)
 {
-    TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
+    // Buffer states must be checked even if the buffers are not changed as
+    // they may have been used in a different state since the last call
+    const auto StreamsChanged = TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, Flags, 0 /*Dummy*/);
     for (Uint32 Buff = 0; Buff < m_NumVertexStreams; ++Buff)
     {
         auto& CurrStream = m_VertexStreams[Buff];
@@ -953,12 +1074,13 @@ void DeviceContextVkImpl::SetVertexBuffers(Uint32                         StartS
                                           "Setting vertex buffers (DeviceContextVkImpl::SetVertexBuffers)");
         }
     }
-    m_State.CommittedVBsUpToDate = false;
+    if (StreamsChanged)
+        m_State.CommittedVBsUpToDate = false;
 }
 
 void DeviceContextVkImpl::InvalidateState()
 {
-    if (m_State.NumCommands != 0)
+    if (HasPendingCommands())
         LOG_WARNING_MESSAGE("Invalidating context that has outstanding commands in it. Call Flush() to submit commands for execution");
 
     TDeviceContextBase::InvalidateState();
@@ -967,17 +1089,23 @@ void DeviceContextVkImpl::InvalidateState()
     m_Framebuffer = VK_NULL_HANDLE;
     m_DescrSetBindInfo.Reset();
     VERIFY(m_CommandBuffer.GetState().RenderPass == VK_NULL_HANDLE, "Invalidating context with unifinished render pass");
+    if (m_CommandBuffer.GetVkCmdBuffer() != VK_NULL_HANDLE)
+    {
+        // Resource states have already been updated, so the barriers must not be lost
+        m_CommandBuffer.FlushBarriers();
+    }
     m_CommandBuffer.Reset();
 }
 
 void DeviceContextVkImpl::SetIndexBuffer(IBuffer* pIndexBuffer, Uint32 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
-    TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
+    const auto IBChanged = TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, 0 /*Dummy*/);
     if (m_pIndexBuffer)
     {
         TransitionOrVerifyBufferState(*m_pIndexBuffer, StateTransitionMode, RESOURCE_STATE_INDEX_BUFFER, VK_ACCESS_INDEX_READ_BIT, "Binding buffer as index buffer  (DeviceContextVkImpl::SetIndexBuffer)");
     }
-    m_State.CommittedIBUpToDate = false;
+    if (IBChanged)
+        m_State.CommittedIBUpToDate = false;
 }
 
 
@@ -1030,7 +1158,11 @@ void DeviceContextVkImpl::CommitViewports()
 
 void DeviceContextVkImpl::SetViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32 RTWidth, Uint32 RTHeight)
 {
-    TDeviceContextBase::SetViewports(NumViewports, pViewports, RTWidth, RTHeight);
+    // Viewports are part of the dynamic state of the command buffer that is preserved
+    // across render passes. When a new command buffer is started, m_pPipelineState is
+    // null and the viewports are committed by SetPipelineState().
+    if (!TDeviceContextBase::SetViewports(NumViewports, pViewports, RTWidth, RTHeight))
+        return;
     VERIFY(NumViewports == m_NumViewports, "Unexpected number of viewports");
 
     CommitViewports();
@@ -1059,7 +1191,8 @@ void DeviceContextVkImpl::CommitScissorRects()
 
 void DeviceContextVkImpl::SetScissorRects(Uint32 NumRects, const Rect* pRects, Uint32 RTWidth, Uint32 RTHeight)
 {
-    TDeviceContextBase::SetScissorRects(NumRects, pRects, RTWidth, RTHeight);
+    if (!TDeviceContextBase::SetScissorRects(NumRects, pRects, RTWidth, RTHeight))
+        return;
 
     // Only commit scissor rects if scissor test is enabled in the rasterizer state.
     // If scissor is currently disabled, or no PSO is bound, scissor rects will be committed by
@@ -1099,7 +1232,8 @@ void DeviceContextVkImpl::TransitionRenderTargets(RESOURCE_STATE_TRANSITION_MODE
 void DeviceContextVkImpl::CommitRenderPassAndFramebuffer(bool VerifyStates)
 {
     const auto& CmdBufferState = m_CommandBuffer.GetState();
-    if (CmdBufferState.Framebuffer != m_Framebuffer)
+    // Render pass instance that executes secondary command buffers can't contain inline commands
+    if (CmdBufferState.Framebuffer != m_Framebuffer || CmdBufferState.SubpassContents != VK_SUBPASS_CONTENTS_INLINE)
     {
         if (CmdBufferState.RenderPass != VK_NULL_HANDLE)
             m_CommandBuffer.EndRenderPass();
@@ -1209,9 +1343,9 @@ void DeviceContextVkImpl::UpdateBufferRegion(BufferVkImpl*                  pBuf
 
     VkBufferCopy CopyRegion;
     CopyRegion.srcOffset = SrcOffset;
-    CopyRegion.dstOffset = DstOffset;
+    CopyRegion.dstOffset = DstOffset + pBuffVk->GetVkBufferOffset();
     CopyRegion.size      = NumBytes;
-    VERIFY(pBuffVk->m_VulkanBuffer != VK_NULL_HANDLE, "Copy destination buffer must not be suballocated");
+    VERIFY(pBuffVk->m_VulkanBuffer != VK_NULL_HANDLE, "Copy destination buffer must not be suballocated in the dynamic heap");
     m_CommandBuffer.CopyBuffer(vkSrcBuffer, pBuffVk->GetVkBuffer(), 1, &CopyRegion);
     ++m_State.NumCommands;
 }
@@ -1272,10 +1406,9 @@ void DeviceContextVkImpl::CopyBuffer(IBuffer*                       pSrcBuffer,
 
     VkBufferCopy CopyRegion;
     CopyRegion.srcOffset = SrcOffset + pSrcBuffVk->GetDynamicOffset(m_ContextId, this);
-    CopyRegion.dstOffset = DstOffset;
+    CopyRegion.dstOffset = DstOffset + pDstBuffVk->GetVkBufferOffset();
     CopyRegion.size      = Size;
-    VERIFY(pDstBuffVk->m_VulkanBuffer != VK_NULL_HANDLE, "Copy destination buffer must not be suballocated");
-    VERIFY_EXPR(pDstBuffVk->GetDynamicOffset(m_ContextId, this) == 0);
+    VERIFY(pDstBuffVk->m_VulkanBuffer != VK_NULL_HANDLE, "Copy destination buffer must not be suballocated in the dynamic heap");
     m_CommandBuffer.CopyBuffer(pSrcBuffVk->GetVkBuffer(), pDstBuffVk->GetVkBuffer(), 1, &CopyRegion);
     ++m_State.NumCommands;
 }
@@ -1938,17 +2071,21 @@ void DeviceContextVkImpl::UnmapTextureSubresource(ITexture* pTexture,
 
 void DeviceContextVkImpl::FinishCommandList(class ICommandList** ppCommandList)
 {
-    if (m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
+    // Secondary command buffer must not end the render pass it inherits
+    const auto vkInheritedRenderPass = m_CommandBuffer.GetState().RenderPassInherited ? m_CommandBuffer.GetState().RenderPass : VK_NULL_HANDLE;
+    if (m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE && vkInheritedRenderPass == VK_NULL_HANDLE)
     {
         m_CommandBuffer.EndRenderPass();
     }
 
+    m_CommandBuffer.FlushBarriers();
+
     auto vkCmdBuff = m_CommandBuffer.GetVkCmdBuffer();
     auto err       = vkEndCommandBuffer(vkCmdBuff);
     DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to end command buffer");
     (void)err;
 
-    CommandListVkImpl* pCmdListVk(NEW_RC_OBJ(m_CmdListAllocator, "CommandListVkImpl instance", CommandListVkImpl)(m_pDevice, this, vkCmdBuff));
+    CommandListVkImpl* pCmdListVk(NEW_RC_OBJ(m_CmdListAllocator, "CommandListVkImpl instance", CommandListVkImpl)(m_pDevice, this, vkCmdBuff, vkInheritedRenderPass));
     pCmdListVk->QueryInterface(IID_CommandList, reinterpret_cast<IObject**>(ppCommandList));
 
     m_CommandBuffer.Reset();
@@ -1959,7 +2096,58 @@ void DeviceContextVkImpl::FinishCommandList(class ICommandList** ppCommandList)
     InvalidateState();
 }
 
+void DeviceContextVkImpl::BeginSecondaryCommandList(IDeviceContext* pImmediateContext)
+{
+    if (!m_bIsDeferred)
+    {
+        LOG_ERROR_MESSAGE("Secondary command lists can only be recorded by deferred contexts");
+        return;
+    }
+
+    if (m_CommandBuffer.GetVkCmdBuffer() != VK_NULL_HANDLE)
+    {
+        LOG_ERROR_MESSAGE("Secondary command list must be started before any command is recorded by the deferred context #", m_ContextId);
+        return;
+    }
+
+    DEV_CHECK_ERR(pImmediateContext != nullptr, "Immediate context must not be null");
+    auto* pImmediateCtxVk = ValidatedCast<DeviceContextVkImpl>(pImmediateContext);
+    DEV_CHECK_ERR(!pImmediateCtxVk->IsDeferred(), "Secondary command lists can only be executed by immediate contexts");
+    if (pImmediateCtxVk->m_RenderPass == VK_NULL_HANDLE)
+    {
+        LOG_ERROR_MESSAGE("No render targets are bound to the immediate context. Secondary command list must be executed inside a render pass");
+        return;
+    }
+
+    // Render pass and framebuffer are shared through the device caches, so the same
+    // objects will be found when the render targets are bound to this context below.
+    VkCommandBufferInheritanceInfo InheritanceInfo = {};
+
+    InheritanceInfo.sType       = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    InheritanceInfo.pNext       = nullptr;
+    InheritanceInfo.renderPass  = pImmediateCtxVk->m_RenderPass;
+    InheritanceInfo.subpass     = 0;
+    InheritanceInfo.framebuffer = pImmediateCtxVk->m_Framebuffer; // Providing the framebuffer may allow better performance
+
+    m_State.NumCommands = 1;
+    m_CommandBuffer.SetVkCmdBuffer(m_CmdPool.GetCommandBuffer("", &InheritanceInfo));
+    m_CommandBuffer.SetInheritedRenderPass(pImmediateCtxVk->m_RenderPass, pImmediateCtxVk->m_Framebuffer,
+                                           pImmediateCtxVk->m_FramebufferWidth, pImmediateCtxVk->m_FramebufferHeight);
+
+    // Barriers are not allowed inside the render pass, so render targets must already be in the required states
+    ITextureView* ppRTVs[MAX_RENDER_TARGETS];
+    for (Uint32 rt = 0; rt < pImmediateCtxVk->m_NumBoundRenderTargets; ++rt)
+        ppRTVs[rt] = pImmediateCtxVk->m_pBoundRenderTargets[rt];
+    SetRenderTargets(pImmediateCtxVk->m_NumBoundRenderTargets, ppRTVs, pImmediateCtxVk->m_pBoundDepthStencil, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+    VERIFY_EXPR(m_RenderPass == pImmediateCtxVk->m_RenderPass && m_Framebuffer == pImmediateCtxVk->m_Framebuffer);
+}
+
 void DeviceContextVkImpl::ExecuteCommandList(class ICommandList* pCommandList)
+{
+    ExecuteCommandLists(1, &pCommandList);
+}
+
+void DeviceContextVkImpl::ExecuteCommandLists(Uint32 NumCommandLists, ICommandList* const* ppCommandLists)
 {
     if (m_bIsDeferred)
     {
@@ -1967,31 +2155,119 @@ void DeviceContextVkImpl::ExecuteCommandList(class ICommandList* pCommandList)
         return;
     }
 
+    // Execute runs of consecutive primary or secondary command lists in order
+    Uint32 FirstList = 0;
+    while (FirstList < NumCommandLists)
+    {
+        const bool IsSecondary = ValidatedCast<CommandListVkImpl>(ppCommandLists[FirstList])->IsSecondary();
+
+        Uint32 LastList = FirstList + 1;
+        while (LastList < NumCommandLists && ValidatedCast<CommandListVkImpl>(ppCommandLists[LastList])->IsSecondary() == IsSecondary)
+            ++LastList;
+
+        if (IsSecondary)
+            ExecuteSecondaryCommandLists(LastList - FirstList, ppCommandLists + FirstList);
+        else
+            ExecutePrimaryCommandLists(LastList - FirstList, ppCommandLists + FirstList);
+
+        FirstList = LastList;
+    }
+}
+
+void DeviceContextVkImpl::ExecutePrimaryCommandLists(Uint32 NumCommandLists, ICommandList* const* ppCommandLists)
+{
     Flush();
 
     InvalidateState();
 
-    CommandListVkImpl* pCmdListVk = ValidatedCast<CommandListVkImpl>(pCommandList);
-    VkCommandBuffer    vkCmdBuff  = VK_NULL_HANDLE;
+    m_vkCmdListBuffers.resize(NumCommandLists);
+    std::vector<RefCntAutoPtr<IDeviceContext>> DeferredCtxs(NumCommandLists);
+    for (Uint32 i = 0; i < NumCommandLists; ++i)
+    {
+        CommandListVkImpl* pCmdListVk = ValidatedCast<CommandListVkImpl>(ppCommandLists[i]);
+        pCmdListVk->Close(m_vkCmdListBuffers[i], DeferredCtxs[i]);
+        VERIFY(m_vkCmdListBuffers[i] != VK_NULL_HANDLE, "Trying to execute empty command buffer");
+        VERIFY_EXPR(DeferredCtxs[i]);
+    }
 
-    RefCntAutoPtr<IDeviceContext> pDeferredCtx;
-    pCmdListVk->Close(vkCmdBuff, pDeferredCtx);
-    VERIFY(vkCmdBuff != VK_NULL_HANDLE, "Trying to execute empty command buffer");
-    VERIFY_EXPR(pDeferredCtx);
+    // All command buffers are submitted with a single submit command
     VkSubmitInfo SubmitInfo = {};
 
     SubmitInfo.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
     SubmitInfo.pNext              = nullptr;
-    SubmitInfo.commandBufferCount = 1;
-    SubmitInfo.pCommandBuffers    = &vkCmdBuff;
+    SubmitInfo.commandBufferCount = NumCommandLists;
+    SubmitInfo.pCommandBuffers    = m_vkCmdListBuffers.data();
     VERIFY_EXPR(m_PendingFences.empty());
-    auto pDeferredCtxVkImpl  = pDeferredCtx.RawPtr<DeviceContextVkImpl>();
     auto SubmittedFenceValue = m_pDevice->ExecuteCommandBuffer(m_CommandQueueId, SubmitInfo, this, nullptr);
-    // Set the bit in the deferred context cmd queue mask corresponding to cmd queue of this context
-    pDeferredCtxVkImpl->m_SubmittedBuffersCmdQueueMask |= Uint64{1} << m_CommandQueueId;
-    // It is OK to dispose command buffer from another thread. We are not going to
-    // record any commands and only need to add the buffer to the queue
-    pDeferredCtxVkImpl->DisposeVkCmdBuffer(m_CommandQueueId, vkCmdBuff, SubmittedFenceValue);
+    for (Uint32 i = 0; i < NumCommandLists; ++i)
+    {
+        auto pDeferredCtxVkImpl = DeferredCtxs[i].RawPtr<DeviceContextVkImpl>();
+        // Set the bit in the deferred context cmd queue mask corresponding to cmd queue of this context
+        pDeferredCtxVkImpl->m_SubmittedBuffersCmdQueueMask |= Uint64{1} << m_CommandQueueId;
+        // It is OK to dispose command buffer from another thread. We are not going to
+        // record any commands and only need to add the buffer to the queue
+        pDeferredCtxVkImpl->DisposeVkCmdBuffer(m_CommandQueueId, m_vkCmdListBuffers[i], SubmittedFenceValue);
+    }
+    m_vkCmdListBuffers.clear();
+}
+
+void DeviceContextVkImpl::ExecuteSecondaryCommandLists(Uint32 NumCommandLists, ICommandList* const* ppCommandLists)
+{
+    if (m_RenderPass == VK_NULL_HANDLE)
+    {
+        LOG_ERROR_MESSAGE("Secondary command lists can only be executed when render targets are bound to the context");
+    }
+
+    m_vkCmdListBuffers.clear();
+    for (Uint32 i = 0; i < NumCommandLists; ++i)
+    {
+        CommandListVkImpl* pCmdListVk = ValidatedCast<CommandListVkImpl>(ppCommandLists[i]);
+
+        VkCommandBuffer               vkCmdBuff = VK_NULL_HANDLE;
+        RefCntAutoPtr<IDeviceContext> pDeferredCtx;
+        pCmdListVk->Close(vkCmdBuff, pDeferredCtx);
+        VERIFY(vkCmdBuff != VK_NULL_HANDLE, "Trying to execute empty command buffer");
+        VERIFY_EXPR(pDeferredCtx);
+
+        // Render passes are compatible when they are created from the same render pass cache key
+        if (pCmdListVk->GetInheritedRenderPass() == m_RenderPass)
+        {
+            m_vkCmdListBuffers.push_back(vkCmdBuff);
+        }
+        else
+        {
+            LOG_ERROR_MESSAGE("Secondary command list was recorded for render targets that are not currently bound to the context. The list will be skipped.");
+        }
+        // The buffer is returned to the pool after the command buffer executing it is submitted
+        m_ExecutedSecondaryCmdBuffers.emplace_back(vkCmdBuff, std::move(pDeferredCtx));
+    }
+
+    if (m_vkCmdListBuffers.empty())
+        return;
+
+    EnsureVkCmdBuffer();
+
+    const auto& CmdBufferState = m_CommandBuffer.GetState();
+    if (CmdBufferState.SubpassContents != VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS || CmdBufferState.Framebuffer != m_Framebuffer)
+    {
+        if (CmdBufferState.RenderPass != VK_NULL_HANDLE)
+            m_CommandBuffer.EndRenderPass();
+
+        // All render pass attachments use VK_ATTACHMENT_LOAD_OP_LOAD, so the pass may be begun again
+        m_CommandBuffer.BeginRenderPass(m_RenderPass, m_Framebuffer, m_FramebufferWidth, m_FramebufferHeight, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+    }
+
+    m_CommandBuffer.ExecuteCommands(static_cast<uint32_t>(m_vkCmdListBuffers.size()), m_vkCmdListBuffers.data());
+    m_State.NumCommands += static_cast<Uint32>(m_vkCmdListBuffers.size());
+    m_vkCmdListBuffers.clear();
+
+    // The state bound in the command buffer is undefined after the secondary command buffers are executed.
+    // Releasing the pipeline makes the next SetPipelineState() commit viewports, scissor rects, stencil
+    // reference and blend factors again. Vertex and index buffers are rebound by the next draw command.
+    m_pPipelineState.Release();
+    m_DescrSetBindInfo.Reset();
+    m_State.CommittedVBsUpToDate = false;
+    m_State.CommittedIBUpToDate  = false;
 }
 
 void DeviceContextVkImpl::SignalFence(IFence* pFence, Uint64 Value)
@@ -2180,6 +2456,16 @@ void DeviceContextVkImpl::TransitionTextureState(TextureVkImpl&           Textur
     // to make sure that all UAV writes are complete and visible.
     auto OldLayout = ResourceStateToVkImageLayout(OldState);
     auto NewLayout = ResourceStateToVkImageLayout(NewState);
+    if (OldState == RESOURCE_STATE_UNDEFINED && TextureVk.IsTransient())
+    {
+        // The texture takes over the memory it shares with other transient textures. All accesses
+        // to the memory through these textures must be complete before the texture is used.
+        DEV_CHECK_ERR(!m_bIsDeferred, "Transient texture '", TextureVk.GetDesc().Name, "' is used by a deferred context. "
+                                                                                       "The owner of the shared memory is resolved at recording time, so transient textures can only be used by the immediate context.");
+        m_pDevice->GetTransientTextureAllocator().Activate(TextureVk.GetTransientAllocation(), m_AliasedLayouts);
+        for (auto AliasedLayout : m_AliasedLayouts)
+            m_CommandBuffer.AliasingBarrier(AliasedLayout, NewLayout);
+    }
     m_CommandBuffer.TransitionImageLayout(vkImg, OldLayout, NewLayout, *pSubresRange);
     if (UpdateTextureState)
     {
@@ -2241,6 +2527,15 @@ void DeviceContextVkImpl::BufferMemoryBarrier(IBuffer* pBuffer, VkAccessFlags Ne
     }
 }
 
+void DeviceContextVkImpl::GetPipelineBarrierStats(PipelineBarrierStats& Stats)
+{
+    const auto& CmdBuffStats  = m_CommandBuffer.GetBarrierStatistics();
+    Stats.NumImageBarriers    = CmdBuffStats.NumImageBarriers;
+    Stats.NumBufferBarriers   = CmdBuffStats.NumBufferBarriers;
+    Stats.NumBarrierCommands  = CmdBuffStats.NumBarrierCommands;
+    Stats.NumAliasingBarriers = CmdBuffStats.NumAliasingBarriers;
+}
+
 void DeviceContextVkImpl::TransitionBufferState(BufferVkImpl& BufferVk, RESOURCE_STATE OldState, RESOURCE_STATE NewState, bool UpdateBufferState)
 {
     if (OldState == RESOURCE_STATE_UNKNOWN)
@@ -2269,14 +2564,14 @@ void DeviceContextVkImpl::TransitionBufferState(BufferVkImpl& BufferVk, RESOURCE
     // to make sure that all UAV writes are complete and visible.
     if (((OldState & NewState) != NewState) || NewState == RESOURCE_STATE_UNORDERED_ACCESS)
     {
-        DEV_CHECK_ERR(BufferVk.m_VulkanBuffer != VK_NULL_HANDLE, "Cannot transition suballocated buffer");
-        VERIFY_EXPR(BufferVk.GetDynamicOffset(m_ContextId, this) == 0);
+        DEV_CHECK_ERR(BufferVk.m_VulkanBuffer != VK_NULL_HANDLE, "Cannot transition buffer suballocated in the dynamic heap");
 
         EnsureVkCmdBuffer();
         auto vkBuff         = BufferVk.GetVkBuffer();
         auto OldAccessFlags = ResourceStateFlagsToVkAccessFlags(OldState);
         auto NewAccessFlags = ResourceStateFlagsToVkAccessFlags(NewState);
-        m_CommandBuffer.BufferMemoryBarrier(vkBuff, OldAccessFlags, NewAccessFlags);
+        // The barrier only covers the range of the buffer if it shares the Vulkan buffer with other buffers
+        m_CommandBuffer.BufferMemoryBarrier(vkBuff, OldAccessFlags, NewAccessFlags, 0, 0, BufferVk.GetVkBufferOffset(), BufferVk.GetVkBufferRange());
         if (UpdateBufferState)
         {
             BufferVk.SetState(NewState);
@@ -2320,6 +2615,8 @@ VulkanDynamicAllocation DeviceContextVkImpl::AllocateDynamicSpace(Uint32 SizeInB
 
 void DeviceContextVkImpl::TransitionResourceStates(Uint32 BarrierCount, StateTransitionDesc* pResourceBarriers)
 {
+    DILIGENT_PROFILE_SCOPE("DeviceContextVkImpl::TransitionResourceStates");
+
     if (BarrierCount == 0)
         return;
 
@@ -134,7 +134,7 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& _E
             reinterpret_cast<VkAllocationCallbacks*>(EngineCI.pVkAllocator));
 
         auto        vkDevice               = Instance->SelectPhysicalDevice();
-        auto        PhysicalDevice         = VulkanUtilities::VulkanPhysicalDevice::Create(vkDevice);
+        auto        PhysicalDevice         = VulkanUtilities::VulkanPhysicalDevice::Create(vkDevice, *Instance);
         const auto& PhysicalDeviceFeatures = PhysicalDevice->GetFeatures();
 
         // If an implementation exposes any queue family that supports graphics operations,
@@ -180,6 +180,9 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& _E
         ENABLE_FEATURE(vertexPipelineStoresAndAtomics);
         ENABLE_FEATURE(fragmentStoresAndAtomics);
         ENABLE_FEATURE(shaderStorageImageExtendedFormats);
+        // Used by IDeviceContext::MultiDraw() and IDeviceContext::MultiDrawIndexed()
+        ENABLE_FEATURE(multiDrawIndirect);
+        ENABLE_FEATURE(drawIndirectFirstInstance);
 #undef ENABLE_FEATURE
 
         DeviceCreateInfo.pEnabledFeatures = &DeviceFeatures; // NULL or a pointer to a VkPhysicalDeviceFeatures structure that contains
@@ -190,6 +193,60 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& _E
                 VK_KHR_SWAPCHAIN_EXTENSION_NAME,
                 VK_KHR_MAINTENANCE1_EXTENSION_NAME // To allow negative viewport height
             };
+        // Descriptor update templates are used to write dynamic descriptor sets
+        if (EngineCI.EnableDescriptorUpdateTemplates && PhysicalDevice->IsExtensionSupported(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME))
+            DeviceExtensions.push_back(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME);
+
+        // Dedicated allocations are used for resources that prefer or require them
+        if (PhysicalDevice->IsExtensionSupported(VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME) &&
+            PhysicalDevice->IsExtensionSupported(VK_KHR_DEDICATED_ALLOCATION_EXTENSION_NAME))
+        {
+            DeviceExtensions.push_back(VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME);
+            DeviceExtensions.push_back(VK_KHR_DEDICATED_ALLOCATION_EXTENSION_NAME);
+        }
+
+        // Memory budget lets the memory manager release cached pages when the heap is nearly full
+        if (PhysicalDevice->IsMemoryBudgetSupported())
+            DeviceExtensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+
+        // Descriptor indexing is required by the bindless descriptor heap
+        VkPhysicalDeviceDescriptorIndexingFeaturesEXT DescriptorIndexingFeatures = {};
+        DescriptorIndexingFeatures.sType                                         = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+        {
+            const auto& SupportedFeatures = PhysicalDevice->GetDescriptorIndexingFeatures();
+
+            bool BindlessHeapRequested = false;
+            for (auto HeapSize : EngineCI.BindlessDescriptorHeapSize)
+                BindlessHeapRequested = BindlessHeapRequested || HeapSize != 0;
+
+            // clang-format off
+            if (BindlessHeapRequested &&
+                PhysicalDevice->IsExtensionSupported(VK_KHR_MAINTENANCE3_EXTENSION_NAME) &&
+                SupportedFeatures.runtimeDescriptorArray                       != VK_FALSE &&
+                SupportedFeatures.descriptorBindingPartiallyBound              != VK_FALSE &&
+                SupportedFeatures.descriptorBindingUpdateUnusedWhilePending    != VK_FALSE &&
+                SupportedFeatures.descriptorBindingSampledImageUpdateAfterBind != VK_FALSE &&
+                SupportedFeatures.descriptorBindingStorageBufferUpdateAfterBind != VK_FALSE)
+            // clang-format on
+            {
+#define ENABLE_FEATURE(Feature) DescriptorIndexingFeatures.Feature = SupportedFeatures.Feature
+                ENABLE_FEATURE(runtimeDescriptorArray);
+                ENABLE_FEATURE(descriptorBindingPartiallyBound);
+                ENABLE_FEATURE(descriptorBindingUpdateUnusedWhilePending);
+                ENABLE_FEATURE(descriptorBindingSampledImageUpdateAfterBind);
+                ENABLE_FEATURE(descriptorBindingStorageBufferUpdateAfterBind);
+                // Allow indexing the heap with values that are not dynamically uniform
+                ENABLE_FEATURE(shaderSampledImageArrayNonUniformIndexing);
+                ENABLE_FEATURE(shaderStorageBufferArrayNonUniformIndexing);
+#undef ENABLE_FEATURE
+                DeviceCreateInfo.pNext = &DescriptorIndexingFeatures;
+
+                // VK_EXT_descriptor_indexing requires VK_KHR_maintenance3
+                DeviceExtensions.push_back(VK_KHR_MAINTENANCE3_EXTENSION_NAME);
+                DeviceExtensions.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+            }
+        }
+
         DeviceCreateInfo.ppEnabledExtensionNames = DeviceExtensions.empty() ? nullptr : DeviceExtensions.data();
         DeviceCreateInfo.enabledExtensionCount   = static_cast<uint32_t>(DeviceExtensions.size());
 
@@ -36,6 +36,7 @@
 #include "BufferVkImpl.hpp"
 #include "VulkanTypeConversions.hpp"
 #include "HashUtils.hpp"
+#include "BindlessDescriptorHeap.hpp"
 
 namespace Diligent
 {
@@ -190,9 +191,63 @@ void PipelineLayout::DescriptorSetLayoutManager::DescriptorSetLayout::Finalize(c
     pBindings = pNewBindings;
 }
 
+void PipelineLayout::DescriptorSetLayoutManager::DescriptorSetLayout::CreateUpdateTemplate(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice)
+{
+    VERIFY(VkLayout != VK_NULL_HANDLE, "Descriptor set layout must be finalized");
+    VERIFY(VkUpdateTemplate == VK_NULL_HANDLE, "Update template has already been created");
+
+    // Every resource in the set occupies one ShaderResourceCacheVk::DescriptorData element, and
+    // resources are stored in the cache in the binding order (see AllocateResourceSlot())
+    std::vector<VkDescriptorUpdateTemplateEntryKHR> Entries;
+    Entries.reserve(NumLayoutBindings);
+    size_t OffsetInCache = 0;
+    for (uint32_t b = 0; b < NumLayoutBindings; ++b)
+    {
+        const auto& Binding = pBindings[b];
+        VERIFY_EXPR(Binding.binding == b);
+        // Immutable samplers are permanently bound into the set layout (13.2.1). Atomic counters
+        // (the only resources with VK_DESCRIPTOR_TYPE_STORAGE_BUFFER type) are never written.
+        const bool IsImmutableSampler = Binding.descriptorType == VK_DESCRIPTOR_TYPE_SAMPLER && Binding.pImmutableSamplers != nullptr;
+        if (!IsImmutableSampler && Binding.descriptorType != VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)
+        {
+            VkDescriptorUpdateTemplateEntryKHR Entry = {};
+
+            Entry.dstBinding      = Binding.binding;
+            Entry.dstArrayElement = 0;
+            Entry.descriptorCount = Binding.descriptorCount;
+            Entry.descriptorType  = Binding.descriptorType;
+            Entry.offset          = OffsetInCache * sizeof(ShaderResourceCacheVk::DescriptorData);
+            Entry.stride          = sizeof(ShaderResourceCacheVk::DescriptorData);
+            Entries.push_back(Entry);
+        }
+        OffsetInCache += Binding.descriptorCount;
+    }
+    VERIFY_EXPR(OffsetInCache == TotalDescriptors);
+
+    if (Entries.empty())
+        return;
+
+    VkDescriptorUpdateTemplateCreateInfoKHR TemplateCI = {};
+
+    TemplateCI.sType                      = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO_KHR;
+    TemplateCI.pNext                      = nullptr;
+    TemplateCI.flags                      = 0; // reserved for future use
+    TemplateCI.descriptorUpdateEntryCount = static_cast<uint32_t>(Entries.size());
+    TemplateCI.pDescriptorUpdateEntries   = Entries.data();
+    TemplateCI.templateType               = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET_KHR;
+    TemplateCI.descriptorSetLayout        = VkLayout;
+    // pipelineBindPoint, pipelineLayout and set are only used for push descriptors
+    TemplateCI.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    TemplateCI.pipelineLayout    = VK_NULL_HANDLE;
+    TemplateCI.set               = 0;
+    VkUpdateTemplate             = LogicalDevice.CreateDescriptorUpdateTemplate(TemplateCI);
+}
+
 void PipelineLayout::DescriptorSetLayoutManager::DescriptorSetLayout::Release(RenderDeviceVkImpl* pRenderDeviceVk, IMemoryAllocator& MemAllocator, Uint64 CommandQueueMask)
 {
-    pRenderDeviceVk->SafeReleaseDeviceObject(std::move(VkLayout), CommandQueueMask);
+    pRenderDeviceVk->DisposeDescriptorSetLayout(std::move(VkLayout), CommandQueueMask);
+    if (VkUpdateTemplate != VK_NULL_HANDLE)
+        pRenderDeviceVk->SafeReleaseDeviceObject(std::move(VkUpdateTemplate), CommandQueueMask);
     for (uint32_t b = 0; b < NumLayoutBindings; ++b)
     {
         if (pBindings[b].pImmutableSamplers != nullptr)
@@ -205,6 +260,7 @@ void PipelineLayout::DescriptorSetLayoutManager::DescriptorSetLayout::Release(Re
 PipelineLayout::DescriptorSetLayoutManager::DescriptorSetLayout::~DescriptorSetLayout()
 {
     VERIFY(VkLayout == VK_NULL_HANDLE, "Vulkan descriptor set layout has not been released. Did you forget to call Release()?");
+    VERIFY(VkUpdateTemplate == VK_NULL_HANDLE, "Vulkan descriptor update template has not been released. Did you forget to call Release()?");
 }
 
 bool PipelineLayout::DescriptorSetLayoutManager::DescriptorSetLayout::operator==(const DescriptorSetLayout& rhs) const
@@ -259,7 +315,7 @@ void PipelineLayout::DescriptorSetLayoutManager::Finalize(const VulkanUtilities:
     m_LayoutBindings.resize(TotalBindings);
     size_t BindingOffset = 0;
 
-    std::array<VkDescriptorSetLayout, 2> ActiveDescrSetLayouts = {};
+    std::array<VkDescriptorSetLayout, 3> ActiveDescrSetLayouts = {};
     for (auto& Layout : m_DescriptorSetLayouts)
     {
         if (Layout.SetIndex >= 0)
@@ -270,6 +326,12 @@ void PipelineLayout::DescriptorSetLayoutManager::Finalize(const VulkanUtilities:
             ActiveDescrSetLayouts[Layout.SetIndex] = Layout.VkLayout;
         }
     }
+
+    // Dynamic descriptor set is allocated and written at every commit, so use
+    // the update template to write all its descriptors at once
+    auto& DynamicSet = GetDescriptorSet(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC);
+    if (DynamicSet.SetIndex >= 0 && LogicalDevice.IsDescriptorUpdateTemplateEnabled())
+        DynamicSet.CreateUpdateTemplate(LogicalDevice);
     VERIFY_EXPR(BindingOffset == TotalBindings);
     // clang-format off
     VERIFY_EXPR(m_ActiveSets == 0 && ActiveDescrSetLayouts[0] == VK_NULL_HANDLE && ActiveDescrSetLayouts[1] == VK_NULL_HANDLE ||
@@ -277,6 +339,13 @@ void PipelineLayout::DescriptorSetLayoutManager::Finalize(const VulkanUtilities:
                 m_ActiveSets == 2 && ActiveDescrSetLayouts[0] != VK_NULL_HANDLE && ActiveDescrSetLayouts[1] != VK_NULL_HANDLE);
     // clang-format on
 
+    // The bindless heap set goes after all other sets, so that their indices in the resource cache are not affected
+    if (m_vkBindlessSetLayout != VK_NULL_HANDLE)
+    {
+        m_BindlessSetIndex                        = m_ActiveSets++;
+        ActiveDescrSetLayouts[m_BindlessSetIndex] = m_vkBindlessSetLayout;
+    }
+
     VkPipelineLayoutCreateInfo PipelineLayoutCI = {};
 
     PipelineLayoutCI.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
@@ -310,7 +379,7 @@ bool PipelineLayout::DescriptorSetLayoutManager::operator==(const DescriptorSetL
     // defined descriptor set layouts for sets zero through N, and if they were created with identical push
     // constant ranges (13.2.2)
 
-    if (m_ActiveSets != rhs.m_ActiveSets)
+    if (m_ActiveSets != rhs.m_ActiveSets || m_BindlessSetIndex != rhs.m_BindlessSetIndex)
         return false;
 
     for (size_t i = 0; i < m_DescriptorSetLayouts.size(); ++i)
@@ -325,6 +394,7 @@ size_t PipelineLayout::DescriptorSetLayoutManager::GetHash() const
     size_t Hash = 0;
     for (const auto& SetLayout : m_DescriptorSetLayouts)
         HashCombine(Hash, SetLayout.GetHash());
+    HashCombine(Hash, m_BindlessSetIndex);
 
     return Hash;
 }
@@ -370,6 +440,14 @@ void PipelineLayout::DescriptorSetLayoutManager::AllocateResourceSlot(const SPIR
     DescrSet.AddBinding(VkBinding, m_MemAllocator);
 }
 
+void PipelineLayout::DescriptorSetLayoutManager::UseBindlessHeap(const BindlessDescriptorHeap& BindlessHeap)
+{
+    VERIFY(m_vkBindlessSetLayout == VK_NULL_HANDLE || m_vkBindlessSetLayout == BindlessHeap.GetVkDescriptorSetLayout(),
+           "There is only one bindless descriptor heap per device");
+    m_vkBindlessSetLayout = BindlessHeap.GetVkDescriptorSetLayout();
+    m_vkBindlessSet       = BindlessHeap.GetVkDescriptorSet();
+}
+
 PipelineLayout::PipelineLayout() :
     m_MemAllocator{GetRawAllocator()},
     m_LayoutMgr{m_MemAllocator}
@@ -399,9 +477,45 @@ void PipelineLayout::AllocateResourceSlot(const SPIRVShaderResourceAttribs& ResA
     SPIRV[ResAttribs.DescriptorSetDecorationOffset] = DescriptorSet;
 }
 
+void PipelineLayout::AllocateBindlessResourceSlot(const SPIRVShaderResourceAttribs& ResAttribs,
+                                                  BindlessDescriptorHeap*           pBindlessHeap,
+                                                  const char*                       ShaderName,
+                                                  std::vector<uint32_t>&            SPIRV)
+{
+    VERIFY_EXPR(ResAttribs.IsRuntimeArray());
+    if (pBindlessHeap == nullptr)
+    {
+        LOG_ERROR_AND_THROW("Shader '", ShaderName, "' declares runtime array '", ResAttribs.Name,
+                            "', which requires the bindless descriptor heap. The heap is not available as the device does not "
+                            "support descriptor indexing or all ranges of EngineVkCreateInfo::BindlessDescriptorHeapSize are zero.");
+    }
+
+    const auto Range = BindlessDescriptorHeap::GetResourceRange(ResAttribs.Type);
+    if (Range >= BINDLESS_DESCRIPTOR_RANGE_VK_COUNT)
+    {
+        LOG_ERROR_AND_THROW("Runtime array '", ResAttribs.Name, "' in shader '", ShaderName, "' is not supported: only runtime arrays "
+                                                                                             "of separate images, storage buffers and separate samplers can be bound to the bindless descriptor heap.");
+    }
+    if (pBindlessHeap->GetRangeSize(Range) == 0)
+    {
+        LOG_WARNING_MESSAGE("Runtime array '", ResAttribs.Name, "' in shader '", ShaderName, "' is bound to the empty range of the bindless descriptor heap.");
+    }
+
+    m_LayoutMgr.UseBindlessHeap(*pBindlessHeap);
+    // The heap binding index is the same as the range index
+    SPIRV[ResAttribs.BindingDecorationOffset] = static_cast<uint32_t>(Range);
+    m_BindlessSetDecorations.push_back(&SPIRV[ResAttribs.DescriptorSetDecorationOffset]);
+}
+
 void PipelineLayout::Finalize(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice)
 {
     m_LayoutMgr.Finalize(LogicalDevice);
+
+    const auto BindlessSetIndex = m_LayoutMgr.GetBindlessSetIndex();
+    VERIFY_EXPR(m_BindlessSetDecorations.empty() || BindlessSetIndex >= 0);
+    for (auto* pDescriptorSetDecoration : m_BindlessSetDecorations)
+        *pDescriptorSetDecoration = static_cast<uint32_t>(BindlessSetIndex);
+    m_BindlessSetDecorations.clear();
 }
 
 std::array<Uint32, 2> PipelineLayout::GetDescriptorSetSizes(Uint32& NumSets) const
@@ -436,7 +550,7 @@ void PipelineLayout::InitResourceCache(RenderDeviceVkImpl*    pDeviceVkImpl,
 
     // This call only initializes descriptor sets (ShaderResourceCacheVk::DescriptorSet) in the resource cache
     // Resources are initialized by source layout when shader resource binding objects are created
-    ResourceCache.InitializeSets(CacheMemAllocator, NumSets, SetSizes.data());
+    ResourceCache.InitializeSets(CacheMemAllocator, NumSets, SetSizes.data(), GetDescriptorUpdateTemplateSetIndex());
 
     const auto& StaticAndMutSet = m_LayoutMgr.GetDescriptorSet(SHADER_RESOURCE_VARIABLE_TYPE_STATIC);
     if (StaticAndMutSet.SetIndex >= 0)
@@ -491,6 +605,17 @@ void PipelineLayout::PrepareDescriptorSets(DeviceContextVkImpl*         pCtxVkIm
         TotalDynamicDescriptors += Set.NumDynamicDescriptors;
     }
 
+    const auto BindlessSetIndex = m_LayoutMgr.GetBindlessSetIndex();
+    if (BindlessSetIndex >= 0)
+    {
+        // The bindless heap set is always the last one
+        VERIFY_EXPR(static_cast<Uint32>(BindlessSetIndex) == BindInfo.SetCout);
+        BindInfo.SetCout = BindlessSetIndex + 1;
+        if (BindInfo.SetCout > BindInfo.vkSets.size())
+            BindInfo.vkSets.resize(BindInfo.SetCout);
+        BindInfo.vkSets[BindlessSetIndex] = m_LayoutMgr.GetBindlessVkDescriptorSet();
+    }
+
 #ifdef DILIGENT_DEBUG
     for (const auto& set : BindInfo.vkSets)
         VERIFY(set != VK_NULL_HANDLE, "Descriptor set must not be null");
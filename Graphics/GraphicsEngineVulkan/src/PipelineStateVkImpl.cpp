@@ -35,6 +35,7 @@
 #include "ShaderResourceBindingVkImpl.hpp"
 #include "EngineMemory.h"
 #include "StringTools.hpp"
+#include "CPUProfiler.hpp"
 #include "spirv-tools/optimizer.hpp"
 
 namespace Diligent
@@ -155,6 +156,8 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters*            pRefCoun
     TPipelineStateBase{pRefCounters, pDeviceVk, CreateInfo.PSODesc},
     m_SRBMemAllocator{GetRawAllocator()}
 {
+    DILIGENT_PROFILE_SCOPE("PipelineStateVkImpl::PipelineStateVkImpl");
+
     const auto& LogicalDevice = pDeviceVk->GetLogicalDevice();
 
     // Initialize shader resource layouts
@@ -166,6 +169,7 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters*            pRefCoun
     m_ShaderResourceLayouts = ALLOCATE(ShaderResLayoutAllocator, "Raw memory for ShaderResourceLayoutVk", ShaderResourceLayoutVk, m_NumShaders * 2);
     m_StaticResCaches       = ALLOCATE(GetRawAllocator(), "Raw memory for ShaderResourceCacheVk", ShaderResourceCacheVk, m_NumShaders);
     m_StaticVarsMgrs        = ALLOCATE(GetRawAllocator(), "Raw memory for ShaderVariableManagerVk", ShaderVariableManagerVk, m_NumShaders);
+    m_VarNameIndices.resize(m_NumShaders * 2);
     for (Uint32 s = 0; s < m_NumShaders; ++s)
     {
         new (m_ShaderResourceLayouts + s) ShaderResourceLayoutVk(LogicalDevice);
@@ -181,7 +185,9 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters*            pRefCoun
         auto* pStaticResCache  = new (m_StaticResCaches + s) ShaderResourceCacheVk(ShaderResourceCacheVk::DbgCacheContentType::StaticShaderResources);
         pStaticResLayout->InitializeStaticResourceLayout(ShaderResources[s], ShaderResLayoutAllocator, m_Desc.ResourceLayout, m_StaticResCaches[s]);
 
-        new (m_StaticVarsMgrs + s) ShaderVariableManagerVk(*this, *pStaticResLayout, GetRawAllocator(), nullptr, 0, *pStaticResCache);
+        auto& StaticVarNameIndex = m_VarNameIndices[m_NumShaders + s];
+        ShaderVariableManagerVk::InitNameIndex(*pStaticResLayout, nullptr, 0, StaticVarNameIndex);
+        new (m_StaticVarsMgrs + s) ShaderVariableManagerVk(*this, *pStaticResLayout, GetRawAllocator(), nullptr, 0, *pStaticResCache, &StaticVarNameIndex);
     }
     ShaderResourceLayoutVk::Initialize(pDeviceVk, m_NumShaders, m_ShaderResourceLayouts, ShaderResources.data(), GetRawAllocator(),
                                        m_Desc.ResourceLayout, ShaderSPIRVs.data(), m_PipelineLayout,
@@ -189,6 +195,13 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters*            pRefCoun
                                        (CreateInfo.Flags & PSO_CREATE_FLAG_IGNORE_MISSING_STATIC_SAMPLERS) == 0);
     m_PipelineLayout.Finalize(LogicalDevice);
 
+    for (Uint32 s = 0; s < m_NumShaders; ++s)
+    {
+        // Build the name index once; it is shared by all SRBs created by this PSO
+        const SHADER_RESOURCE_VARIABLE_TYPE SRBVarTypes[] = {SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC};
+        ShaderVariableManagerVk::InitNameIndex(m_ShaderResourceLayouts[s], SRBVarTypes, _countof(SRBVarTypes), m_VarNameIndices[s]);
+    }
+
     if (m_Desc.SRBAllocationGranularity > 1)
     {
         std::array<size_t, MAX_SHADERS_IN_PIPELINE> ShaderVariableDataSizes = {};
@@ -202,7 +215,7 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters*            pRefCoun
 
         Uint32 NumSets            = 0;
         auto   DescriptorSetSizes = m_PipelineLayout.GetDescriptorSetSizes(NumSets);
-        auto   CacheMemorySize    = ShaderResourceCacheVk::GetRequiredMemorySize(NumSets, DescriptorSetSizes.data());
+        auto   CacheMemorySize    = ShaderResourceCacheVk::GetRequiredMemorySize(NumSets, DescriptorSetSizes.data(), m_PipelineLayout.GetDescriptorUpdateTemplateSetIndex());
 
         m_SRBMemAllocator.Initialize(m_Desc.SRBAllocationGranularity, m_NumShaders, ShaderVariableDataSizes.data(), 1, &CacheMemorySize);
     }
@@ -211,6 +224,8 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters*            pRefCoun
     std::array<VkPipelineShaderStageCreateInfo, MAX_SHADERS_IN_PIPELINE> ShaderStages = {};
     for (Uint32 s = 0; s < m_NumShaders; ++s)
     {
+        DILIGENT_PROFILE_SCOPE("PipelineStateVkImpl: create shader module");
+
         auto* pShaderVk  = GetShader<const ShaderVkImpl>(s);
         auto  ShaderType = pShaderVk->GetDesc().ShaderType;
 
@@ -282,7 +297,8 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters*            pRefCoun
         PipelineCI.stage  = ShaderStages[0];
         PipelineCI.layout = m_PipelineLayout.GetVkPipelineLayout();
 
-        m_Pipeline = LogicalDevice.CreateComputePipeline(PipelineCI, VK_NULL_HANDLE, m_Desc.Name);
+        DILIGENT_PROFILE_SCOPE("vkCreateComputePipelines");
+        m_Pipeline = LogicalDevice.CreateComputePipeline(PipelineCI, pDeviceVk->GetVkPipelineCache(), m_Desc.Name);
     }
     else
     {
@@ -440,7 +456,8 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters*            pRefCoun
         PipelineCI.basePipelineHandle = VK_NULL_HANDLE; // a pipeline to derive from
         PipelineCI.basePipelineIndex  = 0;              // an index into the pCreateInfos parameter to use as a pipeline to derive from
 
-        m_Pipeline = LogicalDevice.CreateGraphicsPipeline(PipelineCI, VK_NULL_HANDLE, m_Desc.Name);
+        DILIGENT_PROFILE_SCOPE("vkCreateGraphicsPipelines");
+        m_Pipeline = LogicalDevice.CreateGraphicsPipeline(PipelineCI, pDeviceVk->GetVkPipelineCache(), m_Desc.Name);
     }
 
     m_HasStaticResources    = false;
@@ -455,6 +472,9 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters*            pRefCoun
             Layout.GetResourceCount(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC) != 0)
             m_HasNonStaticResources = true;
     }
+    // The bindless heap descriptor set is bound when the SRB is committed
+    if (m_PipelineLayout.UsesBindlessHeap())
+        m_HasNonStaticResources = true;
 
     m_ShaderResourceLayoutHash = m_PipelineLayout.GetHash();
 }
@@ -613,6 +633,10 @@ void PipelineStateVkImpl::CommitAndTransitionShaderResources(IShaderResourceBind
 
     if (CommitResources)
     {
+        // Write static and mutable resource descriptors bound since the last commit
+        if (ResourceCache.HasPendingDescriptorWrites())
+            ResourceCache.FlushPendingDescriptorWrites(m_pDevice->GetLogicalDevice());
+
         VkDescriptorSet DynamicDescrSet              = VK_NULL_HANDLE;
         auto            DynamicDescriptorSetVkLayout = m_PipelineLayout.GetDynamicDescriptorSetVkLayout();
         if (DynamicDescriptorSetVkLayout != VK_NULL_HANDLE)
@@ -626,11 +650,23 @@ void PipelineStateVkImpl::CommitAndTransitionShaderResources(IShaderResourceBind
             // Allocate vulkan descriptor set for dynamic resources
             DynamicDescrSet = pCtxVkImpl->AllocateDynamicDescriptorSet(DynamicDescriptorSetVkLayout, DynamicDescrSetName);
             // Commit all dynamic resource descriptors
-            for (Uint32 s = 0; s < m_NumShaders; ++s)
+            auto vkUpdateTemplate = m_PipelineLayout.GetDynamicDescriptorSetUpdateTemplate();
+            if (vkUpdateTemplate != VK_NULL_HANDLE)
             {
-                const auto& Layout = m_ShaderResourceLayouts[s];
-                if (Layout.GetResourceCount(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC) != 0)
-                    Layout.CommitDynamicResources(ResourceCache, DynamicDescrSet);
+                // Descriptor data for all dynamic resources are kept up to date by the resource cache,
+                // so the entire set is written by a single call
+                const auto& DynamicSetResources = ResourceCache.GetDescriptorSet(m_PipelineLayout.GetDescriptorUpdateTemplateSetIndex());
+                VERIFY_EXPR(DynamicSetResources.GetDescriptorData() != nullptr);
+                m_pDevice->GetLogicalDevice().UpdateDescriptorSetWithTemplate(DynamicDescrSet, vkUpdateTemplate, DynamicSetResources.GetDescriptorData());
+            }
+            else
+            {
+                for (Uint32 s = 0; s < m_NumShaders; ++s)
+                {
+                    const auto& Layout = m_ShaderResourceLayouts[s];
+                    if (Layout.GetResourceCount(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC) != 0)
+                        Layout.CommitDynamicResources(ResourceCache, DynamicDescrSet);
+                }
             }
         }
         // Prepare descriptor sets, and also bind them if there are no dynamic descriptors
@@ -674,6 +710,16 @@ IShaderResourceVariable* PipelineStateVkImpl::GetStaticVariableByName(SHADER_TYP
     return StaticVarMgr.GetVariable(Name);
 }
 
+IShaderResourceVariable* PipelineStateVkImpl::GetStaticVariableByHashedName(SHADER_TYPE ShaderType, const HashedShaderVariableName& Name)
+{
+    const auto LayoutInd = m_ResourceLayoutIndex[GetShaderTypeIndex(ShaderType)];
+    if (LayoutInd < 0)
+        return nullptr;
+
+    auto& StaticVarMgr = GetStaticVarMgr(LayoutInd);
+    return StaticVarMgr.GetVariable(Name);
+}
+
 IShaderResourceVariable* PipelineStateVkImpl::GetStaticVariableByIndex(SHADER_TYPE ShaderType, Uint32 Index)
 {
     const auto LayoutInd = m_ResourceLayoutIndex[GetShaderTypeIndex(ShaderType)];
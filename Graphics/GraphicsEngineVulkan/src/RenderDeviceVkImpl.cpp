@@ -38,6 +38,8 @@
 #include "FenceVkImpl.hpp"
 #include "QueryVkImpl.hpp"
 #include "EngineMemory.h"
+#include "DataBlobImpl.hpp"
+#include "VulkanUtilities/VulkanPipelineCache.hpp"
 
 namespace Diligent
 {
@@ -136,8 +138,10 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
         EngineCI.DeviceLocalMemoryPageSize,
         EngineCI.HostVisibleMemoryPageSize,
         EngineCI.DeviceLocalMemoryReserveSize,
-        EngineCI.HostVisibleMemoryReserveSize
+        EngineCI.HostVisibleMemoryReserveSize,
+        EngineCI.UseTLSFMemoryPageAllocator
     },
+    m_TransientTexAllocator{*this, EngineCI.TransientTextureHeapSize},
     m_DynamicMemoryManager
     {
         GetRawAllocator(),
@@ -199,6 +203,175 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
     SamCaps.BorderSamplingModeSupported   = True;
     SamCaps.AnisotropicFilteringSupported = vkDeviceFeatures.samplerAnisotropy;
     SamCaps.LODBiasSupported              = True;
+
+    if (EngineCI.SPIRVCacheDirectory != nullptr)
+    {
+#if NO_GLSLANG
+        LOG_WARNING_MESSAGE("SPIR-V cache directory is ignored as Diligent engine was not linked with glslang.");
+#else
+        m_pSPIRVCache.reset(new SPIRVCache{EngineCI.SPIRVCacheDirectory});
+#endif
+    }
+    // m_EngineAttribs only holds the pointer to the string that may be released by the application
+    m_EngineAttribs.SPIRVCacheDirectory = nullptr;
+
+    CreatePipelineCache(EngineCI.pPipelineCacheData, EngineCI.PipelineCacheDataSize);
+    m_EngineAttribs.pPipelineCacheData    = nullptr;
+    m_EngineAttribs.PipelineCacheDataSize = 0;
+
+    bool BindlessHeapRequested = false;
+    for (auto HeapSize : EngineCI.BindlessDescriptorHeapSize)
+        BindlessHeapRequested = BindlessHeapRequested || HeapSize != 0;
+    if (BindlessHeapRequested)
+    {
+        // Descriptor indexing features are only known if they were queried from the physical device
+        if (m_LogicalVkDevice->IsDescriptorIndexingEnabled() && m_PhysicalDevice->GetDescriptorIndexingFeatures().runtimeDescriptorArray != VK_FALSE)
+            m_pBindlessHeap.reset(new BindlessDescriptorHeap{*this, EngineCI.BindlessDescriptorHeapSize});
+        else
+            LOG_INFO_MESSAGE("Bindless descriptor heap is disabled as the device does not support descriptor indexing");
+    }
+
+    if (EngineCI.ResourceUploadBatchStagingSize != 0)
+        m_pUploadBatch.reset(new ResourceUploadBatch{*this, EngineCI.ResourceUploadBatchStagingSize, EngineCI.ResourceUploadBatchFlushSize});
+
+    if (EngineCI.BufferSuballocationMaxSize != 0)
+        m_pBufferSuballocator.reset(new BufferSuballocator{*this, EngineCI.BufferSuballocationMaxSize, EngineCI.BufferSuballocationBlockSize});
+}
+
+void RenderDeviceVkImpl::CreatePipelineCache(const void* pCacheData, size_t CacheDataSize)
+{
+    VkPipelineCacheCreateInfo PipelineCacheCI = {};
+
+    PipelineCacheCI.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    PipelineCacheCI.pNext = nullptr;
+    PipelineCacheCI.flags = 0;
+    if (pCacheData != nullptr && CacheDataSize != 0)
+    {
+        // Drivers are supposed to reject incompatible data, but some of them crash instead
+        if (VulkanUtilities::IsPipelineCacheDataCompatible(pCacheData, CacheDataSize, m_PhysicalDevice->GetProperties()))
+        {
+            PipelineCacheCI.initialDataSize = CacheDataSize;
+            PipelineCacheCI.pInitialData    = pCacheData;
+        }
+    }
+
+    m_PipelineCache = m_LogicalVkDevice->CreatePipelineCache(PipelineCacheCI, "Device pipeline cache");
+}
+
+void RenderDeviceVkImpl::GetPipelineCacheData(IDataBlob** ppData)
+{
+    DEV_CHECK_ERR(ppData != nullptr, "ppData must not be null");
+    DEV_CHECK_ERR(*ppData == nullptr, "Overwriting reference to an existing object may result in memory leaks");
+    *ppData = nullptr;
+
+    RefCntAutoPtr<DataBlobImpl> pDataBlob;
+    // The cache may grow between the two calls, in which case VK_INCOMPLETE is returned
+    for (VkResult err = VK_INCOMPLETE; err == VK_INCOMPLETE;)
+    {
+        size_t DataSize = 0;
+        err             = m_LogicalVkDevice->GetPipelineCacheData(m_PipelineCache, &DataSize, nullptr);
+        if (err != VK_SUCCESS)
+        {
+            LOG_ERROR_MESSAGE("Failed to get pipeline cache data size");
+            return;
+        }
+
+        pDataBlob = MakeNewRCObj<DataBlobImpl>()(DataSize);
+        err       = m_LogicalVkDevice->GetPipelineCacheData(m_PipelineCache, &DataSize, pDataBlob->GetDataPtr());
+        if (err == VK_SUCCESS)
+        {
+            pDataBlob->Resize(DataSize);
+        }
+        else if (err != VK_INCOMPLETE)
+        {
+            LOG_ERROR_MESSAGE("Failed to get pipeline cache data");
+            return;
+        }
+    }
+
+    pDataBlob->QueryInterface(IID_DataBlob, reinterpret_cast<IObject**>(ppData));
+}
+
+Uint32 RenderDeviceVkImpl::AllocateBindlessDescriptor(IDeviceObject* pObject)
+{
+    if (!m_pBindlessHeap)
+    {
+        LOG_ERROR_MESSAGE("Bindless descriptor heap is not available");
+        return INVALID_BINDLESS_DESCRIPTOR_INDEX;
+    }
+    return m_pBindlessHeap->Allocate(pObject);
+}
+
+void RenderDeviceVkImpl::ReleaseBindlessDescriptor(BINDLESS_DESCRIPTOR_RANGE_VK Range, Uint32 Index)
+{
+    DEV_CHECK_ERR(m_pBindlessHeap, "Bindless descriptor heap is not available");
+    if (m_pBindlessHeap)
+        m_pBindlessHeap->Free(Range, Index);
+}
+
+Uint32 RenderDeviceVkImpl::GetBindlessDescriptorHeapSize(BINDLESS_DESCRIPTOR_RANGE_VK Range)
+{
+    return m_pBindlessHeap ? m_pBindlessHeap->GetRangeSize(Range) : 0;
+}
+
+void RenderDeviceVkImpl::GetDescriptorSetAllocationStats(DescriptorSetAllocationStats& Stats)
+{
+    const auto AllocatorStats = m_DescriptorSetAllocator.GetStatistics();
+
+    Stats.NumAllocations     = AllocatorStats.NumAllocations;
+    Stats.NumRecycledSets    = AllocatorStats.NumRecycledSets;
+    Stats.NumPoolAllocations = AllocatorStats.NumPoolAllocations;
+    Stats.NumPoolResets      = AllocatorStats.NumPoolResets;
+    Stats.NumCachedSets      = AllocatorStats.NumCachedSets;
+}
+
+void RenderDeviceVkImpl::FlushResourceUploads(IFence* pFence, Uint64 FenceValue)
+{
+    if (m_pUploadBatch && m_pUploadBatch->Flush(pFence, FenceValue))
+        return;
+
+    if (pFence != nullptr)
+    {
+        // There are no pending commands, so the fence is signaled once all resources
+        // initialized by previously submitted command buffers are ready
+        LockCmdQueueAndRun(0,
+                           [&](ICommandQueueVk* pCmdQueueVk) //
+                           {
+                               auto* pFenceVkImpl = ValidatedCast<FenceVkImpl>(pFence);
+                               auto  vkFence      = pFenceVkImpl->GetVkFence();
+                               pCmdQueueVk->SignalFence(vkFence);
+                               pFenceVkImpl->AddPendingFence(std::move(vkFence), FenceValue);
+                           } //
+        );
+    }
+}
+
+void RenderDeviceVkImpl::GetResourceUploadBatchStats(ResourceUploadBatchStats& Stats)
+{
+    Stats = m_pUploadBatch ? m_pUploadBatch->GetStats() : ResourceUploadBatchStats{};
+}
+
+void RenderDeviceVkImpl::GetDeviceMemoryHeapStats(Uint32 HeapIndex, DeviceMemoryHeapStats& Stats)
+{
+    Stats = DeviceMemoryHeapStats{};
+    if (HeapIndex >= m_MemoryMgr.GetHeapCount())
+    {
+        LOG_ERROR_MESSAGE("Heap index (", HeapIndex, ") is out of range: the device only has ", m_MemoryMgr.GetHeapCount(), " memory heaps");
+        return;
+    }
+
+    VulkanUtilities::VulkanMemoryHeapStats HeapStats;
+    m_MemoryMgr.GetHeapStats(HeapIndex, HeapStats);
+
+    Stats.HeapSize                = HeapStats.HeapSize;
+    Stats.Budget                  = HeapStats.Budget;
+    Stats.Usage                   = HeapStats.Usage;
+    Stats.AllocatedSize           = HeapStats.AllocatedSize;
+    Stats.UsedSize                = HeapStats.UsedSize;
+    Stats.NumPages                = HeapStats.NumPages;
+    Stats.NumDedicatedAllocations = HeapStats.NumDedicatedAllocations;
+    Stats.IsDeviceLocal           = HeapStats.IsDeviceLocal ? True : False;
+    Stats.IsBudgetReported        = HeapStats.IsBudgetReported ? True : False;
 }
 
 RenderDeviceVkImpl::~RenderDeviceVkImpl()
@@ -207,11 +380,20 @@ RenderDeviceVkImpl::~RenderDeviceVkImpl()
     // the heap into release queues
     m_DynamicMemoryManager.Destroy();
 
-    // Wait for the GPU to complete all its operations
+    // Wait for the GPU to complete all its operations. This also submits the pending resource upload batch.
     IdleGPU();
 
+    // The batch staging buffer is not used by the GPU anymore and is destroyed immediately
+    m_pUploadBatch.reset();
+
     ReleaseStaleResources(true);
 
+    // All stale bindless descriptor indices have been returned to the heap by now
+    m_pBindlessHeap.reset();
+
+    // All suballocated buffers have been released by now
+    m_pBufferSuballocator.reset();
+
     DEV_CHECK_ERR(m_DescriptorSetAllocator.GetAllocatedDescriptorSetCounter() == 0, "All allocated descriptor sets must have been released now.");
     DEV_CHECK_ERR(m_TransientCmdPoolMgr.GetAllocatedPoolCount() == 0, "All allocated transient command pools must have been released now. If there are outstanding references to the pools in release queues, the app will crash when CommandPoolManager::FreeCommandPool() is called.");
     DEV_CHECK_ERR(m_DynamicDescriptorPool.GetAllocatedPoolCounter() == 0, "All allocated dynamic descriptor pools must have been released now.");
@@ -264,7 +446,10 @@ void RenderDeviceVkImpl::AllocateTransientCmdPool(VulkanUtilities::CommandPoolWr
 }
 
 
-void RenderDeviceVkImpl::ExecuteAndDisposeTransientCmdBuff(Uint32 QueueIndex, VkCommandBuffer vkCmdBuff, VulkanUtilities::CommandPoolWrapper&& CmdPool)
+Uint64 RenderDeviceVkImpl::ExecuteAndDisposeTransientCmdBuff(Uint32                                                 QueueIndex,
+                                                             VkCommandBuffer                                        vkCmdBuff,
+                                                             VulkanUtilities::CommandPoolWrapper&&                  CmdPool,
+                                                             std::vector<std::pair<Uint64, RefCntAutoPtr<IFence>>>* pSignalFences)
 {
     VERIFY_EXPR(vkCmdBuff != VK_NULL_HANDLE);
 
@@ -308,9 +493,20 @@ void RenderDeviceVkImpl::ExecuteAndDisposeTransientCmdBuff(Uint32 QueueIndex, Vk
                        [&](ICommandQueueVk* pCmdQueueVk) //
                        {
                            FenceValue = pCmdQueueVk->Submit(SubmitInfo);
+                           if (pSignalFences != nullptr)
+                           {
+                               for (auto& val_fence : *pSignalFences)
+                               {
+                                   auto* pFenceVkImpl = val_fence.second.RawPtr<FenceVkImpl>();
+                                   auto  vkFence      = pFenceVkImpl->GetVkFence();
+                                   pCmdQueueVk->SignalFence(vkFence);
+                                   pFenceVkImpl->AddPendingFence(std::move(vkFence), val_fence.first);
+                               }
+                           }
                        } //
     );
     m_TransientCmdPoolMgr.SafeReleaseCommandPool(std::move(CmdPool), QueueIndex, FenceValue);
+    return FenceValue;
 }
 
 void RenderDeviceVkImpl::SubmitCommandBuffer(Uint32                                                 QueueIndex,
@@ -342,6 +538,10 @@ Uint64 RenderDeviceVkImpl::ExecuteCommandBuffer(Uint32 QueueIndex, const VkSubmi
     // Stale objects MUST only be discarded when submitting cmd list from the immediate context
     VERIFY(!pImmediateCtx->IsDeferred(), "Command buffers must be submitted from immediate context only");
 
+    // Resources used by the command buffer must be initialized first
+    if (m_pUploadBatch)
+        m_pUploadBatch->Flush(nullptr, 0);
+
     Uint64 SubmittedFenceValue    = 0;
     Uint64 SubmittedCmdBuffNumber = 0;
     SubmitCommandBuffer(QueueIndex, SubmitInfo, SubmittedCmdBuffNumber, SubmittedFenceValue, pSignalFences);
@@ -355,6 +555,8 @@ Uint64 RenderDeviceVkImpl::ExecuteCommandBuffer(Uint32 QueueIndex, const VkSubmi
 
 void RenderDeviceVkImpl::IdleGPU()
 {
+    if (m_pUploadBatch)
+        m_pUploadBatch->Flush(nullptr, 0);
     IdleAllCommandQueues(true);
     m_LogicalVkDevice->WaitIdle();
     ReleaseStaleResources();
@@ -363,7 +565,11 @@ void RenderDeviceVkImpl::IdleGPU()
 void RenderDeviceVkImpl::FlushStaleResources(Uint32 CmdQueueIndex)
 {
     // Submit empty command buffer to the queue. This will effectively signal the fence and
-    // discard all resources
+    // discard all resources. Pending resource initialization commands must be submitted
+    // first as they may reference resources that have been released.
+    if (m_pUploadBatch)
+        m_pUploadBatch->Flush(nullptr, 0);
+
     VkSubmitInfo DummySumbitInfo = {};
     TRenderDeviceBase::SubmitCommandBuffer(0, DummySumbitInfo, true);
 }
@@ -500,6 +706,19 @@ void RenderDeviceVkImpl::CreateBufferFromVulkanResource(VkBuffer vkBuffer, const
 }
 
 
+void RenderDeviceVkImpl::GetSPIRVCacheStats(SPIRVCacheStats& Stats)
+{
+    Stats = SPIRVCacheStats{};
+    if (m_pSPIRVCache)
+    {
+        const auto CacheStats  = m_pSPIRVCache->GetStatistics();
+        Stats.NumHits          = CacheStats.NumHits;
+        Stats.NumMisses        = CacheStats.NumMisses;
+        Stats.NumWriteFailures = CacheStats.NumWriteFailures;
+    }
+}
+
+
 void RenderDeviceVkImpl::CreateBuffer(const BufferDesc& BuffDesc, const BufferData* pBuffData, IBuffer** ppBuffer)
 {
     CreateDeviceObject(
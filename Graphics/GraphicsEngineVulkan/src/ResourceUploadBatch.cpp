@@ -0,0 +1,178 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "ResourceUploadBatch.hpp"
+#include "RenderDeviceVkImpl.hpp"
+#include "FenceVkImpl.hpp"
+#include "VulkanErrors.hpp"
+#include "EngineMemory.h"
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+ResourceUploadBatch::ResourceUploadBatch(RenderDeviceVkImpl& DeviceVkImpl,
+                                         Uint32              StagingBufferSize,
+                                         Uint32              FlushSize) :
+    // clang-format off
+    m_DeviceVkImpl{DeviceVkImpl                          },
+    m_FlushSize   {FlushSize                             },
+    m_StagingRing {StagingBufferSize, GetRawAllocator()  }
+// clang-format on
+{
+    const auto& LogicalDevice = DeviceVkImpl.GetLogicalDevice();
+
+    VkBufferCreateInfo StagingBuffCI    = {};
+    StagingBuffCI.sType                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    StagingBuffCI.pNext                 = nullptr;
+    StagingBuffCI.flags                 = 0;
+    StagingBuffCI.size                  = StagingBufferSize;
+    StagingBuffCI.usage                 = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    StagingBuffCI.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
+    StagingBuffCI.queueFamilyIndexCount = 0;
+    StagingBuffCI.pQueueFamilyIndices   = nullptr;
+
+    m_StagingBuffer = LogicalDevice.CreateBuffer(StagingBuffCI, "Resource upload batch staging buffer");
+
+    VkMemoryRequirements MemReqs = LogicalDevice.GetBufferMemoryRequirements(m_StagingBuffer);
+    VERIFY(IsPowerOfTwo(MemReqs.alignment), "Alignment is not power of 2!");
+    // Host-coherent memory does not require vkFlushMappedMemoryRanges to make host writes
+    // visible to the device (10.2)
+    m_StagingMemory = DeviceVkImpl.AllocateMemory(MemReqs, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+    auto AlignedOffset = Align(VkDeviceSize{m_StagingMemory.UnalignedOffset}, MemReqs.alignment);
+    VERIFY_EXPR(m_StagingMemory.Size >= MemReqs.size + (AlignedOffset - m_StagingMemory.UnalignedOffset));
+    auto err = LogicalDevice.BindBufferMemory(m_StagingBuffer, m_StagingMemory.Page->GetVkMemory(), AlignedOffset);
+    CHECK_VK_ERROR_AND_THROW(err, "Failed to bind staging buffer memory");
+
+    m_StagingCPUAddress = reinterpret_cast<Uint8*>(m_StagingMemory.Page->GetCPUMemory());
+    VERIFY_EXPR(m_StagingCPUAddress != nullptr);
+    m_StagingCPUAddress += AlignedOffset;
+
+    FenceDesc BatchFenceDesc;
+    BatchFenceDesc.Name = "Resource upload batch fence";
+    m_pBatchFence       = NEW_RC_OBJ(GetRawAllocator(), "FenceVkImpl instance", FenceVkImpl)(&DeviceVkImpl, BatchFenceDesc, true);
+}
+
+ResourceUploadBatch::~ResourceUploadBatch()
+{
+    VERIFY(m_vkCmdBuff == VK_NULL_HANDLE, "Resource upload batch must be flushed before it is destroyed");
+
+    // Staging buffer is destroyed immediately, so wait until the GPU is done with all batches
+    m_pBatchFence->Wait(m_NumSubmittedBatches);
+    m_StagingRing.ReleaseCompletedFrames(m_NumSubmittedBatches);
+}
+
+bool ResourceUploadBatch::AllocateStagingSpace(size_t Size, size_t Alignment, StagingRegion& Region)
+{
+    VERIFY_EXPR(Size > 0 && Alignment > 0);
+
+    // The ring only supports power-of-two alignments, so other alignments (e.g. 12 bytes
+    // required for RGB32 texture formats) are satisfied by reserving extra space
+    const bool   IsPow2Alignment = IsPowerOfTwo(Alignment);
+    const size_t RingAlignment   = IsPow2Alignment ? Alignment : 4;
+    const size_t ReservedSize    = IsPow2Alignment ? Size : Size + Alignment - 1;
+    if (Align(ReservedSize, RingAlignment) > m_StagingRing.GetMaxSize())
+        return false;
+
+    m_StagingRing.ReleaseCompletedFrames(m_pBatchFence->GetCompletedValue());
+
+    auto Offset = m_StagingRing.Allocate(ReservedSize, RingAlignment);
+    if (Offset == RingBuffer::InvalidOffset)
+    {
+        // Submit the pending commands and wait until the GPU is done with all staging data.
+        // Since the ring is then empty, the allocation will succeed.
+        if (m_vkCmdBuff != VK_NULL_HANDLE)
+            Submit(nullptr, 0);
+        m_pBatchFence->Wait(m_NumSubmittedBatches);
+        m_StagingRing.ReleaseCompletedFrames(m_pBatchFence->GetCompletedValue());
+        ++m_Stats.NumStagingBufferWaits;
+
+        Offset = m_StagingRing.Allocate(ReservedSize, RingAlignment);
+        if (Offset == RingBuffer::InvalidOffset)
+        {
+            UNEXPECTED("Failed to allocate space in the empty staging ring");
+            return false;
+        }
+    }
+
+    if (!IsPow2Alignment)
+        Offset = (Offset + Alignment - 1) / Alignment * Alignment;
+
+    Region.vkBuffer    = m_StagingBuffer;
+    Region.Offset      = Offset;
+    Region.pCPUAddress = m_StagingCPUAddress + Offset;
+
+    return true;
+}
+
+void ResourceUploadBatch::BeginCommandBuffer()
+{
+    VERIFY_EXPR(m_vkCmdBuff == VK_NULL_HANDLE);
+    m_DeviceVkImpl.AllocateTransientCmdPool(m_CmdPool, m_vkCmdBuff, "Transient command pool for batched resource initialization");
+}
+
+void ResourceUploadBatch::Submit(IFence* pFence, Uint64 FenceValue)
+{
+    VERIFY_EXPR(m_vkCmdBuff != VK_NULL_HANDLE);
+
+    ++m_NumSubmittedBatches;
+
+    std::vector<std::pair<Uint64, RefCntAutoPtr<IFence>>> SignalFences;
+    SignalFences.emplace_back(m_NumSubmittedBatches, RefCntAutoPtr<IFence>{m_pBatchFence.RawPtr()});
+    if (pFence != nullptr)
+        SignalFences.emplace_back(FenceValue, RefCntAutoPtr<IFence>{pFence});
+
+    // Resources are always initialized through the first queue, same as when they are not batched
+    m_DeviceVkImpl.ExecuteAndDisposeTransientCmdBuff(0, m_vkCmdBuff, std::move(m_CmdPool), &SignalFences);
+    m_vkCmdBuff = VK_NULL_HANDLE;
+
+    m_StagingRing.FinishCurrentFrame(m_NumSubmittedBatches);
+    m_PendingStagingSize = 0;
+
+    ++m_Stats.NumSubmittedBatches;
+    m_Stats.NumPendingResources = 0;
+}
+
+bool ResourceUploadBatch::Flush(IFence* pFence, Uint64 FenceValue)
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    if (m_vkCmdBuff == VK_NULL_HANDLE)
+        return false;
+
+    Submit(pFence, FenceValue);
+    return true;
+}
+
+ResourceUploadBatchStats ResourceUploadBatch::GetStats()
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    return m_Stats;
+}
+
+} // namespace Diligent
@@ -76,7 +76,7 @@ ShaderResourceBindingVkImpl::ShaderResourceBindingVkImpl(IReferenceCounters*  pR
         // Initialize vars manager to reference mutable and dynamic variables
         // Note that the cache has space for all variable types
         const SHADER_RESOURCE_VARIABLE_TYPE VarTypes[] = {SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC};
-        new (m_pShaderVarMgrs + s) ShaderVariableManagerVk(*this, SrcLayout, VarDataAllocator, VarTypes, _countof(VarTypes), m_ShaderResourceCache);
+        new (m_pShaderVarMgrs + s) ShaderVariableManagerVk(*this, SrcLayout, VarDataAllocator, VarTypes, _countof(VarTypes), m_ShaderResourceCache, &pPSO->GetSRBVarNameIndex(s));
     }
 #ifdef DILIGENT_DEBUG
     m_ShaderResourceCache.DbgVerifyResourceInitialization();
@@ -126,6 +126,19 @@ IShaderResourceVariable* ShaderResourceBindingVkImpl::GetVariableByName(SHADER_T
     return m_pShaderVarMgrs[ResLayoutInd].GetVariable(Name);
 }
 
+IShaderResourceVariable* ShaderResourceBindingVkImpl::GetVariableByHashedName(SHADER_TYPE ShaderType, const HashedShaderVariableName& Name)
+{
+    auto ShaderInd    = GetShaderTypeIndex(ShaderType);
+    auto ResLayoutInd = m_ResourceLayoutIndex[ShaderInd];
+    if (ResLayoutInd < 0)
+    {
+        LOG_WARNING_MESSAGE("Unable to find mutable/dynamic variable '", Name.Name, "': shader stage ", GetShaderTypeLiteralName(ShaderType),
+                            " is inactive in Pipeline State '", m_pPSO->GetDesc().Name, "'.");
+        return nullptr;
+    }
+    return m_pShaderVarMgrs[ResLayoutInd].GetVariable(Name);
+}
+
 Uint32 ShaderResourceBindingVkImpl::GetVariableCount(SHADER_TYPE ShaderType) const
 {
     auto ShaderInd    = GetShaderTypeIndex(ShaderType);
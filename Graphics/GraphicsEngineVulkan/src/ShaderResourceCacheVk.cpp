@@ -27,6 +27,8 @@
 
 #include "pch.h"
 
+#include <algorithm>
+
 #include "ShaderResourceCacheVk.hpp"
 #include "DeviceContextVkImpl.hpp"
 #include "BufferViewVkImpl.hpp"
@@ -38,26 +40,32 @@
 namespace Diligent
 {
 
-size_t ShaderResourceCacheVk::GetRequiredMemorySize(Uint32 NumSets, Uint32 SetSizes[])
+size_t ShaderResourceCacheVk::GetRequiredMemorySize(Uint32 NumSets, Uint32 SetSizes[], Int32 DescriptorDataSet)
 {
     Uint32 TotalResources = 0;
     for (Uint32 t = 0; t < NumSets; ++t)
         TotalResources += SetSizes[t];
     auto MemorySize = NumSets * sizeof(DescriptorSet) + TotalResources * sizeof(Resource);
+    if (DescriptorDataSet >= 0)
+    {
+        VERIFY_EXPR(static_cast<Uint32>(DescriptorDataSet) < NumSets);
+        MemorySize += SetSizes[DescriptorDataSet] * sizeof(DescriptorData);
+    }
     return MemorySize;
 }
 
-void ShaderResourceCacheVk::InitializeSets(IMemoryAllocator& MemAllocator, Uint32 NumSets, Uint32 SetSizes[])
+void ShaderResourceCacheVk::InitializeSets(IMemoryAllocator& MemAllocator, Uint32 NumSets, Uint32 SetSizes[], Int32 DescriptorDataSet)
 {
     // Memory layout:
     //
     //  m_pMemory
     //  |
     //  V
-    // ||  DescriptorSet[0]  |   ....    |  DescriptorSet[Ns-1]  |  Res[0]  |  ... |  Res[n-1]  |    ....     | Res[0]  |  ... |  Res[m-1]  ||
+    // ||  DescriptorSet[0]  |   ....    |  DescriptorSet[Ns-1]  |  Res[0]  |  ... |  Res[n-1]  |    ....     | Res[0]  |  ... |  Res[m-1]  || Data[0] | ... | Data[k-1] ||
     //
     //
     //  Ns = m_NumSets
+    //  k  = SetSizes[DescriptorDataSet] if DescriptorDataSet >= 0, or zero otherwise
 
     VERIFY(m_pAllocator == nullptr && m_pMemory == nullptr, "Cache already initialized");
     m_pAllocator = &MemAllocator;
@@ -66,8 +74,10 @@ void ShaderResourceCacheVk::InitializeSets(IMemoryAllocator& MemAllocator, Uint3
     m_TotalResources = 0;
     for (Uint32 t = 0; t < NumSets; ++t)
         m_TotalResources += SetSizes[t];
-    auto MemorySize = NumSets * sizeof(DescriptorSet) + m_TotalResources * sizeof(Resource);
-    VERIFY_EXPR(MemorySize == GetRequiredMemorySize(NumSets, SetSizes));
+    const Uint32 NumDescriptorData = DescriptorDataSet >= 0 ? SetSizes[DescriptorDataSet] : 0;
+
+    auto MemorySize = NumSets * sizeof(DescriptorSet) + m_TotalResources * sizeof(Resource) + NumDescriptorData * sizeof(DescriptorData);
+    VERIFY_EXPR(MemorySize == GetRequiredMemorySize(NumSets, SetSizes, DescriptorDataSet));
 #ifdef DILIGENT_DEBUG
     m_DbgInitializedResources.resize(m_NumSets);
 #endif
@@ -76,15 +86,22 @@ void ShaderResourceCacheVk::InitializeSets(IMemoryAllocator& MemAllocator, Uint3
         m_pMemory         = ALLOCATE_RAW(*m_pAllocator, "Memory for shader resource cache data", MemorySize);
         auto* pSets       = reinterpret_cast<DescriptorSet*>(m_pMemory);
         auto* pCurrResPtr = reinterpret_cast<Resource*>(pSets + m_NumSets);
+        auto* pDescrData  = reinterpret_cast<DescriptorData*>(pCurrResPtr + m_TotalResources);
+        if (NumDescriptorData > 0)
+        {
+            // Null handles are written for resources that are not bound
+            memset(pDescrData, 0, NumDescriptorData * sizeof(DescriptorData));
+        }
         for (Uint32 t = 0; t < NumSets; ++t)
         {
-            new (&GetDescriptorSet(t)) DescriptorSet(SetSizes[t], SetSizes[t] > 0 ? pCurrResPtr : nullptr);
+            auto* pSetDescrData = (static_cast<Int32>(t) == DescriptorDataSet && SetSizes[t] > 0) ? pDescrData : nullptr;
+            new (&GetDescriptorSet(t)) DescriptorSet(SetSizes[t], SetSizes[t] > 0 ? pCurrResPtr : nullptr, pSetDescrData);
             pCurrResPtr += SetSizes[t];
 #ifdef DILIGENT_DEBUG
             m_DbgInitializedResources[t].resize(SetSizes[t]);
 #endif
         }
-        VERIFY_EXPR((char*)pCurrResPtr == (char*)m_pMemory + MemorySize);
+        VERIFY_EXPR((char*)(pDescrData + NumDescriptorData) == (char*)m_pMemory + MemorySize);
     }
 }
 
@@ -148,6 +165,153 @@ ShaderResourceCacheVk::~ShaderResourceCacheVk()
     }
 }
 
+void ShaderResourceCacheVk::AddPendingDescriptorWrite(Uint32           Set,
+                                                      Uint32           CacheOffset,
+                                                      Uint32           Binding,
+                                                      Uint32           ArrayElement,
+                                                      VkDescriptorType DescriptorType,
+                                                      bool             IsImmutableSampler)
+{
+    VERIFY(GetDescriptorSet(Set).GetVkDescriptorSet() != VK_NULL_HANDLE, "Descriptor writes can only be recorded for sets with Vulkan descriptor set assigned");
+
+    PendingWrite Write;
+    Write.CacheOffset        = CacheOffset;
+    Write.Binding            = Binding;
+    Write.ArrayElement       = ArrayElement;
+    Write.DescriptorType     = DescriptorType;
+    Write.Set                = static_cast<Uint16>(Set);
+    Write.IsImmutableSampler = IsImmutableSampler;
+
+    std::lock_guard<std::mutex> Lock{m_PendingWritesMtx};
+    m_PendingWrites.push_back(Write);
+    m_HasPendingWrites.store(true);
+}
+
+void ShaderResourceCacheVk::FlushPendingDescriptorWrites(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice)
+{
+    // Other contexts committing the same SRB must wait until the descriptors are written
+    std::lock_guard<std::mutex> Lock{m_PendingWritesMtx};
+    if (m_PendingWrites.empty())
+        return;
+
+    // Sort the writes so that consecutive array elements of the same binding can be coalesced
+    // into a single VkWriteDescriptorSet structure
+    std::sort(m_PendingWrites.begin(), m_PendingWrites.end(),
+              [](const PendingWrite& lhs, const PendingWrite& rhs) //
+              {
+                  if (lhs.Set != rhs.Set)
+                      return lhs.Set < rhs.Set;
+                  if (lhs.Binding != rhs.Binding)
+                      return lhs.Binding < rhs.Binding;
+                  return lhs.ArrayElement < rhs.ArrayElement;
+              });
+
+    // Write structures keep pointers to the elements of these arrays,
+    // so the arrays must never be reallocated
+    const auto                          MaxWrites = m_PendingWrites.size();
+    std::vector<VkDescriptorImageInfo>  DescrImgInfos;
+    std::vector<VkDescriptorBufferInfo> DescrBuffInfos;
+    std::vector<VkBufferView>           DescrBuffViews;
+    std::vector<VkWriteDescriptorSet>   WriteDescrSets;
+    DescrImgInfos.reserve(MaxWrites);
+    DescrBuffInfos.reserve(MaxWrites);
+    DescrBuffViews.reserve(MaxWrites);
+    WriteDescrSets.reserve(MaxWrites);
+
+    for (size_t w = 0; w < m_PendingWrites.size(); ++w)
+    {
+        const auto& Write = m_PendingWrites[w];
+        if (w > 0)
+        {
+            const auto& PrevWrite = m_PendingWrites[w - 1];
+            if (PrevWrite.Set == Write.Set && PrevWrite.Binding == Write.Binding && PrevWrite.ArrayElement == Write.ArrayElement)
+                continue; // The same descriptor has been recorded more than once
+        }
+
+        const auto& DescrSet = GetDescriptorSet(Write.Set);
+        const auto& Res      = DescrSet.GetResource(Write.CacheOffset);
+        if (!Res.pObject)
+            continue; // The resource has been unbound after the write was recorded
+
+        const VkDescriptorImageInfo*  pImageInfo       = nullptr;
+        const VkDescriptorBufferInfo* pBufferInfo      = nullptr;
+        const VkBufferView*           pTexelBufferView = nullptr;
+        switch (Res.Type)
+        {
+            case SPIRVShaderResourceAttribs::ResourceType::UniformBuffer:
+                DescrBuffInfos.emplace_back(Res.GetUniformBufferDescriptorWriteInfo());
+                pBufferInfo = &DescrBuffInfos.back();
+                break;
+
+            case SPIRVShaderResourceAttribs::ResourceType::ROStorageBuffer:
+            case SPIRVShaderResourceAttribs::ResourceType::RWStorageBuffer:
+                DescrBuffInfos.emplace_back(Res.GetStorageBufferDescriptorWriteInfo());
+                pBufferInfo = &DescrBuffInfos.back();
+                break;
+
+            case SPIRVShaderResourceAttribs::ResourceType::UniformTexelBuffer:
+            case SPIRVShaderResourceAttribs::ResourceType::StorageTexelBuffer:
+                DescrBuffViews.emplace_back(Res.GetBufferViewWriteInfo());
+                pTexelBufferView = &DescrBuffViews.back();
+                break;
+
+            case SPIRVShaderResourceAttribs::ResourceType::SeparateImage:
+            case SPIRVShaderResourceAttribs::ResourceType::StorageImage:
+            case SPIRVShaderResourceAttribs::ResourceType::SampledImage:
+                DescrImgInfos.emplace_back(Res.GetImageDescriptorWriteInfo(Write.IsImmutableSampler));
+                pImageInfo = &DescrImgInfos.back();
+                break;
+
+            case SPIRVShaderResourceAttribs::ResourceType::SeparateSampler:
+                VERIFY(!Write.IsImmutableSampler, "Immutable samplers are permanently bound into the set layout and can't be written (13.2.1)");
+                DescrImgInfos.emplace_back(Res.GetSamplerDescriptorWriteInfo());
+                pImageInfo = &DescrImgInfos.back();
+                break;
+
+            default:
+                UNEXPECTED("Unexpected resource type");
+                continue;
+        }
+
+        auto vkDescrSet = DescrSet.GetVkDescriptorSet();
+        if (!WriteDescrSets.empty())
+        {
+            // Since the writes are sorted, the descriptor info of the next array element of the same
+            // binding immediately follows the infos of the last write in the same array
+            auto& LastWrite = WriteDescrSets.back();
+            if (LastWrite.dstSet == vkDescrSet &&
+                LastWrite.dstBinding == Write.Binding &&
+                LastWrite.dstArrayElement + LastWrite.descriptorCount == Write.ArrayElement)
+            {
+                VERIFY_EXPR(LastWrite.descriptorType == Write.DescriptorType);
+                ++LastWrite.descriptorCount;
+                continue;
+            }
+        }
+
+        VkWriteDescriptorSet WriteDescrSet;
+        WriteDescrSet.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        WriteDescrSet.pNext           = nullptr;
+        WriteDescrSet.dstSet          = vkDescrSet;
+        WriteDescrSet.dstBinding      = Write.Binding;
+        WriteDescrSet.dstArrayElement = Write.ArrayElement;
+        WriteDescrSet.descriptorCount = 1;
+        // descriptorType must be the same type as that specified in VkDescriptorSetLayoutBinding for dstSet at dstBinding.
+        // The type of the descriptor also controls which array the descriptors are taken from. (13.2.4)
+        WriteDescrSet.descriptorType   = Write.DescriptorType;
+        WriteDescrSet.pImageInfo       = pImageInfo;
+        WriteDescrSet.pBufferInfo      = pBufferInfo;
+        WriteDescrSet.pTexelBufferView = pTexelBufferView;
+        WriteDescrSets.push_back(WriteDescrSet);
+    }
+
+    if (!WriteDescrSets.empty())
+        LogicalDevice.UpdateDescriptorSets(static_cast<uint32_t>(WriteDescrSets.size()), WriteDescrSets.data(), 0, nullptr);
+
+    m_PendingWrites.clear();
+    m_HasPendingWrites.store(false);
+}
+
 template <bool VerifyOnly>
 void ShaderResourceCacheVk::TransitionResources(DeviceContextVkImpl* pCtxVkImpl)
 {
@@ -457,6 +621,54 @@ VkBufferView ShaderResourceCacheVk::Resource::GetBufferViewWriteInfo() const
     return pBuffViewVk->GetVkBufferView();
 }
 
+void ShaderResourceCacheVk::DescriptorSet::UpdateDescriptorData(Uint32 CacheOffset, bool IsImmutableSampler)
+{
+    VERIFY(m_pDescriptorData != nullptr, "This descriptor set does not keep descriptor data");
+
+    const auto& Res  = GetResource(CacheOffset);
+    auto&       Data = m_pDescriptorData[CacheOffset];
+    if (!Res.pObject)
+    {
+        memset(&Data, 0, sizeof(Data));
+        return;
+    }
+
+    switch (Res.Type)
+    {
+        case SPIRVShaderResourceAttribs::ResourceType::UniformBuffer:
+            Data.BufferInfo = Res.GetUniformBufferDescriptorWriteInfo();
+            break;
+
+        case SPIRVShaderResourceAttribs::ResourceType::ROStorageBuffer:
+        case SPIRVShaderResourceAttribs::ResourceType::RWStorageBuffer:
+            Data.BufferInfo = Res.GetStorageBufferDescriptorWriteInfo();
+            break;
+
+        case SPIRVShaderResourceAttribs::ResourceType::UniformTexelBuffer:
+        case SPIRVShaderResourceAttribs::ResourceType::StorageTexelBuffer:
+            Data.TexelBufferView = Res.GetBufferViewWriteInfo();
+            break;
+
+        case SPIRVShaderResourceAttribs::ResourceType::SeparateImage:
+        case SPIRVShaderResourceAttribs::ResourceType::StorageImage:
+        case SPIRVShaderResourceAttribs::ResourceType::SampledImage:
+            Data.ImageInfo = Res.GetImageDescriptorWriteInfo(IsImmutableSampler);
+            break;
+
+        case SPIRVShaderResourceAttribs::ResourceType::SeparateSampler:
+            VERIFY(!IsImmutableSampler, "Immutable samplers are not written to descriptor sets");
+            Data.ImageInfo = Res.GetSamplerDescriptorWriteInfo();
+            break;
+
+        case SPIRVShaderResourceAttribs::ResourceType::AtomicCounter:
+            // Atomic counters are not written, see ShaderResourceLayoutVk::CommitDynamicResources()
+            break;
+
+        default:
+            UNEXPECTED("Unexpected resource type");
+    }
+}
+
 VkDescriptorImageInfo ShaderResourceCacheVk::Resource::GetSamplerDescriptorWriteInfo() const
 {
     VERIFY(Type == SPIRVShaderResourceAttribs::ResourceType::SeparateSampler, "Separate sampler resource is expected");
@@ -39,6 +39,7 @@
 #include "ShaderResourceVariableBase.hpp"
 #include "StringTools.hpp"
 #include "PipelineStateVkImpl.hpp"
+#include "RenderDeviceVkImpl.hpp"
 
 namespace Diligent
 {
@@ -123,6 +124,10 @@ void ShaderResourceLayoutVk::AllocateMemory(std::shared_ptr<const SPIRVShaderRes
     m_pResources->ProcessResources(
         [&](const SPIRVShaderResourceAttribs& ResAttribs, Uint32) //
         {
+            // Runtime arrays are bound to the bindless descriptor heap and are not exposed as variables
+            if (ResAttribs.IsRuntimeArray())
+                return;
+
             auto VarType = FindShaderVariableType(ShaderType, ResAttribs, ResourceLayoutDesc, CombinedSamplerSuffix);
             if (IsAllowedType(VarType, AllowedTypeBits))
             {
@@ -191,6 +196,9 @@ void ShaderResourceLayoutVk::InitializeStaticResourceLayout(std::shared_ptr<cons
     m_pResources->ProcessResources(
         [&](const SPIRVShaderResourceAttribs& Attribs, Uint32) //
         {
+            if (Attribs.IsRuntimeArray())
+                return;
+
             auto VarType = FindShaderVariableType(ShaderType, Attribs, ResourceLayoutDesc, CombinedSamplerSuffix);
             if (!IsAllowedType(VarType, AllowedTypeBits))
                 return;
@@ -400,6 +408,13 @@ void ShaderResourceLayoutVk::Initialize(IRenderDevice*
                            const SPIRVShaderResources&       Resources,
                            const SPIRVShaderResourceAttribs& Attribs) //
     {
+        if (Attribs.IsRuntimeArray())
+        {
+            auto* pBindlessHeap = ValidatedCast<RenderDeviceVkImpl>(pRenderDevice)->GetBindlessDescriptorHeap();
+            PipelineLayout.AllocateBindlessResourceSlot(Attribs, pBindlessHeap, Resources.GetShaderName(), SPIRVs[ShaderInd]);
+            return;
+        }
+
         const auto                          ShaderType = Resources.GetShaderType();
         const SHADER_RESOURCE_VARIABLE_TYPE VarType    = FindShaderVariableType(ShaderType, Attribs, ResourceLayoutDesc, Resources.GetCombinedSamplerSuffix());
         if (!IsAllowedType(VarType, AllowedTypeBits))
@@ -582,31 +597,6 @@ Uint32 ShaderResourceLayoutVk::FindAssignedSampler(const SPIRVShaderResourceAttr
 }
 
 
-void ShaderResourceLayoutVk::VkResource::UpdateDescriptorHandle(VkDescriptorSet               vkDescrSet,
-                                                                uint32_t                      ArrayElement,
-                                                                const VkDescriptorImageInfo*  pImageInfo,
-                                                                const VkDescriptorBufferInfo* pBufferInfo,
-                                                                const VkBufferView*           pTexelBufferView) const
-{
-    VERIFY_EXPR(vkDescrSet != VK_NULL_HANDLE);
-
-    VkWriteDescriptorSet WriteDescrSet;
-    WriteDescrSet.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-    WriteDescrSet.pNext           = nullptr;
-    WriteDescrSet.dstSet          = vkDescrSet;
-    WriteDescrSet.dstBinding      = Binding;
-    WriteDescrSet.dstArrayElement = ArrayElement;
-    WriteDescrSet.descriptorCount = 1;
-    // descriptorType must be the same type as that specified in VkDescriptorSetLayoutBinding for dstSet at dstBinding.
-    // The type of the descriptor also controls which array the descriptors are taken from. (13.2.4)
-    WriteDescrSet.descriptorType   = PipelineLayout::GetVkDescriptorType(SpirvAttribs);
-    WriteDescrSet.pImageInfo       = pImageInfo;
-    WriteDescrSet.pBufferInfo      = pBufferInfo;
-    WriteDescrSet.pTexelBufferView = pTexelBufferView;
-
-    ParentResLayout.m_LogicalDevice.UpdateDescriptorSets(1, &WriteDescrSet, 0, nullptr);
-}
-
 template <typename ObjectType, typename TPreUpdateObject>
 bool ShaderResourceLayoutVk::VkResource::UpdateCachedResource(ShaderResourceCacheVk::Resource& DstRes,
                                                               RefCntAutoPtr<ObjectType>&&      pObject,
@@ -616,6 +606,12 @@ bool ShaderResourceLayoutVk::VkResource::UpdateCachedResource(ShaderResourceCach
     // resource mapping can be of wrong type
     if (pObject)
     {
+        if (DstRes.pObject.template RawPtr<ObjectType>() == pObject.RawPtr())
+        {
+            // The same object is already bound - there is nothing to update
+            return false;
+        }
+
         if (GetVariableType() != SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC && DstRes.pObject != nullptr)
         {
             // Do not update resource if one is already bound unless it is dynamic. This may be
@@ -635,7 +631,6 @@ bool ShaderResourceLayoutVk::VkResource::UpdateCachedResource(ShaderResourceCach
 
 void ShaderResourceLayoutVk::VkResource::CacheUniformBuffer(IDeviceObject*                   pBuffer,
                                                             ShaderResourceCacheVk::Resource& DstRes,
-                                                            VkDescriptorSet                  vkDescrSet,
                                                             Uint32                           ArrayInd,
                                                             Uint16&                          DynamicBuffersCounter) const
 {
@@ -654,24 +649,13 @@ void ShaderResourceLayoutVk::VkResource::CacheUniformBuffer(IDeviceObject*
         if (pNewBuffer != nullptr && pNewBuffer->GetDesc().Usage == USAGE_DYNAMIC)
             ++DynamicBuffersCounter;
     };
-    if (UpdateCachedResource(DstRes, std::move(pBufferVk), UpdateDynamicBuffersCounter))
-    {
-        // VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER or VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC descriptor type require
-        // buffer to be created with VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT
-
-        // Do not update descriptor for a dynamic uniform buffer. All dynamic resource
-        // descriptors are updated at once by CommitDynamicResources() when SRB is committed.
-        if (vkDescrSet != VK_NULL_HANDLE && GetVariableType() != SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
-        {
-            VkDescriptorBufferInfo DescrBuffInfo = DstRes.GetUniformBufferDescriptorWriteInfo();
-            UpdateDescriptorHandle(vkDescrSet, ArrayInd, nullptr, &DescrBuffInfo, nullptr);
-        }
-    }
+    // VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER or VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC descriptor type require
+    // buffer to be created with VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT
+    UpdateCachedResource(DstRes, std::move(pBufferVk), UpdateDynamicBuffersCounter);
 }
 
 void ShaderResourceLayoutVk::VkResource::CacheStorageBuffer(IDeviceObject*                   pBufferView,
                                                             ShaderResourceCacheVk::Resource& DstRes,
-                                                            VkDescriptorSet                  vkDescrSet,
                                                             Uint32                           ArrayInd,
                                                             Uint16&                          DynamicBuffersCounter) const
 {
@@ -700,24 +684,13 @@ void ShaderResourceLayoutVk::VkResource::CacheStorageBuffer(IDeviceObject*
             ++DynamicBuffersCounter;
     };
 
-    if (UpdateCachedResource(DstRes, std::move(pBufferViewVk), UpdateDynamicBuffersCounter))
-    {
-        // VK_DESCRIPTOR_TYPE_STORAGE_BUFFER or VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC descriptor type
-        // require buffer to be created with VK_BUFFER_USAGE_STORAGE_BUFFER_BIT (13.2.4)
-
-        // Do not update descriptor for a dynamic storage buffer. All dynamic resource
-        // descriptors are updated at once by CommitDynamicResources() when SRB is committed.
-        if (vkDescrSet != VK_NULL_HANDLE && GetVariableType() != SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
-        {
-            VkDescriptorBufferInfo DescrBuffInfo = DstRes.GetStorageBufferDescriptorWriteInfo();
-            UpdateDescriptorHandle(vkDescrSet, ArrayInd, nullptr, &DescrBuffInfo, nullptr);
-        }
-    }
+    // VK_DESCRIPTOR_TYPE_STORAGE_BUFFER or VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC descriptor type
+    // require buffer to be created with VK_BUFFER_USAGE_STORAGE_BUFFER_BIT (13.2.4)
+    UpdateCachedResource(DstRes, std::move(pBufferViewVk), UpdateDynamicBuffersCounter);
 }
 
 void ShaderResourceLayoutVk::VkResource::CacheTexelBuffer(IDeviceObject*                   pBufferView,
                                                           ShaderResourceCacheVk::Resource& DstRes,
-                                                          VkDescriptorSet                  vkDescrSet,
                                                           Uint32                           ArrayInd,
                                                           Uint16&                          DynamicBuffersCounter) const
 {
@@ -746,26 +719,15 @@ void ShaderResourceLayoutVk::VkResource::CacheTexelBuffer(IDeviceObject*
             ++DynamicBuffersCounter;
     };
 
-    if (UpdateCachedResource(DstRes, std::move(pBufferViewVk), UpdateDynamicBuffersCounter))
-    {
-        // The following bits must have been set at buffer creation time:
-        //  * VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER  ->  VK_BUFFER_USAGE_STORAGE_TEXEL_BUFFER_BIT
-        //  * VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER  ->  VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT
-
-        // Do not update descriptor for a dynamic texel buffer. All dynamic resource descriptors
-        // are updated at once by CommitDynamicResources() when SRB is committed.
-        if (vkDescrSet != VK_NULL_HANDLE && GetVariableType() != SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
-        {
-            VkBufferView BuffView = DstRes.pObject.RawPtr<BufferViewVkImpl>()->GetVkBufferView();
-            UpdateDescriptorHandle(vkDescrSet, ArrayInd, nullptr, nullptr, &BuffView);
-        }
-    }
+    // The following bits must have been set at buffer creation time:
+    //  * VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER  ->  VK_BUFFER_USAGE_STORAGE_TEXEL_BUFFER_BIT
+    //  * VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER  ->  VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT
+    UpdateCachedResource(DstRes, std::move(pBufferViewVk), UpdateDynamicBuffersCounter);
 }
 
 template <typename TCacheSampler>
 void ShaderResourceLayoutVk::VkResource::CacheImage(IDeviceObject*                   pTexView,
                                                     ShaderResourceCacheVk::Resource& DstRes,
-                                                    VkDescriptorSet                  vkDescrSet,
                                                     Uint32                           ArrayInd,
                                                     TCacheSampler                    CacheSampler) const
 {
@@ -799,14 +761,6 @@ void ShaderResourceLayoutVk::VkResource::CacheImage(IDeviceObject*
         }
 #endif
 
-        // Do not update descriptor for a dynamic image. All dynamic resource descriptors
-        // are updated at once by CommitDynamicResources() when SRB is committed.
-        if (vkDescrSet != VK_NULL_HANDLE && GetVariableType() != SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
-        {
-            VkDescriptorImageInfo DescrImgInfo = DstRes.GetImageDescriptorWriteInfo(IsImmutableSamplerAssigned());
-            UpdateDescriptorHandle(vkDescrSet, ArrayInd, &DescrImgInfo, nullptr, nullptr);
-        }
-
         if (SamplerInd != InvalidSamplerInd)
         {
             VERIFY(SpirvAttribs.Type == SPIRVShaderResourceAttribs::ResourceType::SeparateImage,
@@ -834,7 +788,6 @@ void ShaderResourceLayoutVk::VkResource::CacheImage(IDeviceObject*
 
 void ShaderResourceLayoutVk::VkResource::CacheSeparateSampler(IDeviceObject*                   pSampler,
                                                               ShaderResourceCacheVk::Resource& DstRes,
-                                                              VkDescriptorSet                  vkDescrSet,
                                                               Uint32                           ArrayInd) const
 {
     VERIFY(SpirvAttribs.Type == SPIRVShaderResourceAttribs::ResourceType::SeparateSampler, "Separate sampler resource is expected");
@@ -856,16 +809,7 @@ void ShaderResourceLayoutVk::VkResource::CacheSeparateSampler(IDeviceObject*
                           "cause unpredicted behavior. Use another shader resource binding instance or label the variable as dynamic.");
     }
 #endif
-    if (UpdateCachedResource(DstRes, std::move(pSamplerVk), [](const SamplerVkImpl*, const SamplerVkImpl*) {}))
-    {
-        // Do not update descriptor for a dynamic sampler. All dynamic resource descriptors
-        // are updated at once by CommitDynamicResources() when SRB is committed.
-        if (vkDescrSet != VK_NULL_HANDLE && GetVariableType() != SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
-        {
-            VkDescriptorImageInfo DescrImgInfo = DstRes.GetSamplerDescriptorWriteInfo();
-            UpdateDescriptorHandle(vkDescrSet, ArrayInd, &DescrImgInfo, nullptr, nullptr);
-        }
-    }
+    UpdateCachedResource(DstRes, std::move(pSamplerVk), [](const SamplerVkImpl*, const SamplerVkImpl*) {});
 }
 
 
@@ -896,28 +840,30 @@ void ShaderResourceLayoutVk::VkResource::BindResource(IDeviceObject* pObj, Uint3
     auto& DstRes = DstDescrSet.GetResource(CacheOffset + ArrayIndex);
     VERIFY(DstRes.Type == SpirvAttribs.Type, "Inconsistent types");
 
+    const IDeviceObject* const pPrevObject = DstRes.pObject.RawPtr();
+
     if (pObj)
     {
         switch (SpirvAttribs.Type)
         {
             case SPIRVShaderResourceAttribs::ResourceType::UniformBuffer:
-                CacheUniformBuffer(pObj, DstRes, vkDescrSet, ArrayIndex, ResourceCache.GetDynamicBuffersCounter());
+                CacheUniformBuffer(pObj, DstRes, ArrayIndex, ResourceCache.GetDynamicBuffersCounter());
                 break;
 
             case SPIRVShaderResourceAttribs::ResourceType::ROStorageBuffer:
             case SPIRVShaderResourceAttribs::ResourceType::RWStorageBuffer:
-                CacheStorageBuffer(pObj, DstRes, vkDescrSet, ArrayIndex, ResourceCache.GetDynamicBuffersCounter());
+                CacheStorageBuffer(pObj, DstRes, ArrayIndex, ResourceCache.GetDynamicBuffersCounter());
                 break;
 
             case SPIRVShaderResourceAttribs::ResourceType::UniformTexelBuffer:
             case SPIRVShaderResourceAttribs::ResourceType::StorageTexelBuffer:
-                CacheTexelBuffer(pObj, DstRes, vkDescrSet, ArrayIndex, ResourceCache.GetDynamicBuffersCounter());
+                CacheTexelBuffer(pObj, DstRes, ArrayIndex, ResourceCache.GetDynamicBuffersCounter());
                 break;
 
             case SPIRVShaderResourceAttribs::ResourceType::StorageImage:
             case SPIRVShaderResourceAttribs::ResourceType::SeparateImage:
             case SPIRVShaderResourceAttribs::ResourceType::SampledImage:
-                CacheImage(pObj, DstRes, vkDescrSet, ArrayIndex,
+                CacheImage(pObj, DstRes, ArrayIndex,
                            [&](const VkResource& SeparateSampler, ISampler* pSampler) {
                                VERIFY(!SeparateSampler.IsImmutableSamplerAssigned(), "Separate sampler '", SeparateSampler.SpirvAttribs.Name, "' is assigned an immutable sampler");
                                VERIFY_EXPR(SpirvAttribs.Type == SPIRVShaderResourceAttribs::ResourceType::SeparateImage);
@@ -935,7 +881,7 @@ void ShaderResourceLayoutVk::VkResource::BindResource(IDeviceObject* pObj, Uint3
             case SPIRVShaderResourceAttribs::ResourceType::SeparateSampler:
                 if (!IsImmutableSamplerAssigned())
                 {
-                    CacheSeparateSampler(pObj, DstRes, vkDescrSet, ArrayIndex);
+                    CacheSeparateSampler(pObj, DstRes, ArrayIndex);
                 }
                 else
                 {
@@ -959,6 +905,26 @@ void ShaderResourceLayoutVk::VkResource::BindResource(IDeviceObject* pObj, Uint3
 
         DstRes.pObject.Release();
     }
+
+    // Nothing needs to be written if the same object has been bound again. Note that immutable
+    // samplers are permanently bound into the set layout and are never written (13.2.1).
+    if (DstRes.pObject.RawPtr() != pPrevObject)
+    {
+        // Static and mutable resource descriptors are not written right away. The writes are recorded
+        // in the cache and are flushed in one batch when the SRB is committed.
+        if (vkDescrSet != VK_NULL_HANDLE && GetVariableType() != SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC && DstRes.pObject)
+        {
+            ResourceCache.AddPendingDescriptorWrite(DescriptorSet, CacheOffset + ArrayIndex, Binding, ArrayIndex,
+                                                    PipelineLayout::GetVkDescriptorType(SpirvAttribs), IsImmutableSamplerAssigned());
+        }
+
+        // Keep descriptor data for the update template in sync with the cached object
+        if (DstDescrSet.GetDescriptorData() != nullptr)
+        {
+            VERIFY(GetVariableType() == SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC, "Only dynamic resources are expected to be written with the update template");
+            DstDescrSet.UpdateDescriptorData(CacheOffset + ArrayIndex, IsImmutableSamplerAssigned());
+        }
+    }
 }
 
 bool ShaderResourceLayoutVk::VkResource::IsBound(Uint32 ArrayIndex, const ShaderResourceCacheVk& ResourceCache) const
@@ -33,53 +33,82 @@
 namespace Diligent
 {
 
-size_t ShaderVariableManagerVk::GetRequiredMemorySize(const ShaderResourceLayoutVk&        Layout,
-                                                      const SHADER_RESOURCE_VARIABLE_TYPE* AllowedVarTypes,
-                                                      Uint32                               NumAllowedTypes,
-                                                      Uint32&                              NumVariables)
+template <typename HandlerType>
+void ShaderVariableManagerVk::ProcessLayoutResources(const ShaderResourceLayoutVk& Layout, Uint32 AllowedTypeBits, HandlerType Handler)
 {
-    NumVariables                       = 0;
-    const Uint32 AllowedTypeBits       = GetAllowedTypeBits(AllowedVarTypes, NumAllowedTypes);
-    const bool   UsingSeparateSamplers = Layout.IsUsingSeparateSamplers();
+    const bool UsingSeparateSamplers = Layout.IsUsingSeparateSamplers();
     for (SHADER_RESOURCE_VARIABLE_TYPE VarType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC; VarType < SHADER_RESOURCE_VARIABLE_TYPE_NUM_TYPES; VarType = static_cast<SHADER_RESOURCE_VARIABLE_TYPE>(VarType + 1))
     {
-        if (IsAllowedType(VarType, AllowedTypeBits))
+        if (!IsAllowedType(VarType, AllowedTypeBits))
+            continue;
+
+        Uint32 NumResources = Layout.GetResourceCount(VarType);
+        for (Uint32 r = 0; r < NumResources; ++r)
         {
-            auto NumResources = Layout.GetResourceCount(VarType);
-            for (Uint32 r = 0; r < NumResources; ++r)
-            {
-                const auto& SrcRes = Layout.GetResource(VarType, r);
+            const auto& SrcRes = Layout.GetResource(VarType, r);
 
-                // When using HLSL-style combined image samplers, we need to skip separate samplers.
-                // Also always skip immutable separate samplers.
-                if (SrcRes.SpirvAttribs.Type == SPIRVShaderResourceAttribs::ResourceType::SeparateSampler &&
-                    (!UsingSeparateSamplers || SrcRes.IsImmutableSamplerAssigned()))
-                    continue;
+            // When using HLSL-style combined image samplers, we need to skip separate samplers.
+            // Also always skip immutable separate samplers.
+            if (SrcRes.SpirvAttribs.Type == SPIRVShaderResourceAttribs::ResourceType::SeparateSampler &&
+                (!UsingSeparateSamplers || SrcRes.IsImmutableSamplerAssigned()))
+                continue;
 
-                ++NumVariables;
-            }
+            Handler(SrcRes);
         }
     }
+}
+
+size_t ShaderVariableManagerVk::GetRequiredMemorySize(const ShaderResourceLayoutVk&        Layout,
+                                                      const SHADER_RESOURCE_VARIABLE_TYPE* AllowedVarTypes,
+                                                      Uint32                               NumAllowedTypes,
+                                                      Uint32&                              NumVariables)
+{
+    NumVariables = 0;
+    ProcessLayoutResources(Layout, GetAllowedTypeBits(AllowedVarTypes, NumAllowedTypes),
+                           [&](const ShaderResourceLayoutVk::VkResource&) //
+                           {
+                               ++NumVariables;
+                           });
 
     return NumVariables * sizeof(ShaderVariableVkImpl);
 }
 
+void ShaderVariableManagerVk::InitNameIndex(const ShaderResourceLayoutVk&        Layout,
+                                            const SHADER_RESOURCE_VARIABLE_TYPE* AllowedVarTypes,
+                                            Uint32                               NumAllowedTypes,
+                                            ShaderVariableNameIndex&             NameIndex)
+{
+    std::vector<const Char*> Names;
+    ProcessLayoutResources(Layout, GetAllowedTypeBits(AllowedVarTypes, NumAllowedTypes),
+                           [&](const ShaderResourceLayoutVk::VkResource& SrcRes) //
+                           {
+                               Names.push_back(SrcRes.SpirvAttribs.Name);
+                           });
+
+    NameIndex.Initialize(static_cast<Uint32>(Names.size()),
+                         [&](Uint32 Index) //
+                         {
+                             return Names[Index];
+                         });
+}
+
 // Creates shader variable for every resource from SrcLayout whose type is one AllowedVarTypes
 ShaderVariableManagerVk::ShaderVariableManagerVk(IObject&                             Owner,
                                                  const ShaderResourceLayoutVk&        SrcLayout,
                                                  IMemoryAllocator&                    Allocator,
                                                  const SHADER_RESOURCE_VARIABLE_TYPE* AllowedVarTypes,
                                                  Uint32                               NumAllowedTypes,
-                                                 ShaderResourceCacheVk&               ResourceCache) :
+                                                 ShaderResourceCacheVk&               ResourceCache,
+                                                 const ShaderVariableNameIndex*       pNameIndex) :
     // clang-format off
     m_Owner        {Owner        },
-    m_ResourceCache{ResourceCache}
+    m_ResourceCache{ResourceCache},
+    m_pNameIndex   {pNameIndex   }
 #ifdef DILIGENT_DEBUG
   , m_DbgAllocator {Allocator}
 #endif
 // clang-format on
 {
-    const Uint32 AllowedTypeBits = GetAllowedTypeBits(AllowedVarTypes, NumAllowedTypes);
     VERIFY_EXPR(m_NumVariables == 0);
     auto MemSize = GetRequiredMemorySize(SrcLayout, AllowedVarTypes, NumAllowedTypes, m_NumVariables);
 
@@ -89,26 +118,13 @@ ShaderVariableManagerVk::ShaderVariableManagerVk(IObject&
     auto* pRawMem = ALLOCATE_RAW(Allocator, "Raw memory buffer for shader variables", MemSize);
     m_pVariables  = reinterpret_cast<ShaderVariableVkImpl*>(pRawMem);
 
-    Uint32     VarInd                = 0;
-    const bool UsingSeparateSamplers = SrcLayout.IsUsingSeparateSamplers();
-    for (SHADER_RESOURCE_VARIABLE_TYPE VarType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC; VarType < SHADER_RESOURCE_VARIABLE_TYPE_NUM_TYPES; VarType = static_cast<SHADER_RESOURCE_VARIABLE_TYPE>(VarType + 1))
-    {
-        if (!IsAllowedType(VarType, AllowedTypeBits))
-            continue;
-
-        Uint32 NumResources = SrcLayout.GetResourceCount(VarType);
-        for (Uint32 r = 0; r < NumResources; ++r)
-        {
-            const auto& SrcRes = SrcLayout.GetResource(VarType, r);
-            // Skip separate samplers when using combined HLSL-style image samplers. Also always skip immutable separate samplers.
-            if (SrcRes.SpirvAttribs.Type == SPIRVShaderResourceAttribs::ResourceType::SeparateSampler &&
-                (!UsingSeparateSamplers || SrcRes.IsImmutableSamplerAssigned()))
-                continue;
-
-            ::new (m_pVariables + VarInd) ShaderVariableVkImpl(*this, SrcRes);
-            ++VarInd;
-        }
-    }
+    Uint32 VarInd = 0;
+    ProcessLayoutResources(SrcLayout, GetAllowedTypeBits(AllowedVarTypes, NumAllowedTypes),
+                           [&](const ShaderResourceLayoutVk::VkResource& SrcRes) //
+                           {
+                               ::new (m_pVariables + VarInd) ShaderVariableVkImpl(*this, SrcRes);
+                               ++VarInd;
+                           });
     VERIFY_EXPR(VarInd == m_NumVariables);
 }
 
@@ -130,8 +146,25 @@ void ShaderVariableManagerVk::DestroyVariables(IMemoryAllocator& Allocator)
     }
 }
 
+ShaderVariableVkImpl* ShaderVariableManagerVk::GetVariable(const HashedShaderVariableName& Name)
+{
+    if (m_pNameIndex == nullptr)
+        return GetVariable(Name.Name);
+
+    const auto VarInd = m_pNameIndex->Find(Name,
+                                           [this](Uint32 Index) //
+                                           {
+                                               VERIFY_EXPR(Index < m_NumVariables);
+                                               return m_pVariables[Index].m_Resource.SpirvAttribs.Name;
+                                           });
+    return VarInd != ShaderVariableNameIndex::InvalidIndex ? m_pVariables + VarInd : nullptr;
+}
+
 ShaderVariableVkImpl* ShaderVariableManagerVk::GetVariable(const Char* Name)
 {
+    if (m_pNameIndex != nullptr)
+        return GetVariable(HashedShaderVariableName{Name});
+
     ShaderVariableVkImpl* pVar = nullptr;
     for (Uint32 v = 0; v < m_NumVariables; ++v)
     {
@@ -33,6 +33,7 @@
 #include "RenderDeviceVkImpl.hpp"
 #include "DataBlobImpl.hpp"
 #include "GLSLSourceBuilder.hpp"
+#include "CPUProfiler.hpp"
 
 #if !NO_GLSLANG
 #    include "SPIRVUtils.hpp"
@@ -53,17 +54,24 @@ ShaderVkImpl::ShaderVkImpl(IReferenceCounters*     pRefCounters,
     }
 // clang-format on
 {
+    DILIGENT_PROFILE_SCOPE("ShaderVkImpl::ShaderVkImpl");
+
     if (CreationAttribs.Source != nullptr || CreationAttribs.FilePath != nullptr)
     {
+        DILIGENT_PROFILE_SCOPE("ShaderVkImpl: compile SPIRV");
+
 #if NO_GLSLANG
         LOG_ERROR_AND_THROW("Diligent engine was not linked with glslang and can only consume compiled SPIRV bytecode.");
 #else
         DEV_CHECK_ERR(CreationAttribs.ByteCode == nullptr, "'ByteCode' must be null when shader is created from source code or a file");
         DEV_CHECK_ERR(CreationAttribs.ByteCodeSize == 0, "'ByteCodeSize' must be 0 when shader is created from source code or a file");
 
+        auto* pSPIRVCache = pRenderDeviceVk->GetSPIRVCache();
         if (CreationAttribs.SourceLanguage == SHADER_SOURCE_LANGUAGE_HLSL)
         {
-            m_SPIRV = HLSLtoSPIRV(CreationAttribs, CreationAttribs.ppCompilerOutput);
+            m_SPIRV = pSPIRVCache != nullptr ?
+                pSPIRVCache->HLSLtoSPIRV(CreationAttribs, CreationAttribs.ppCompilerOutput) :
+                HLSLtoSPIRV(CreationAttribs, CreationAttribs.ppCompilerOutput);
         }
         else
         {
@@ -71,9 +79,13 @@ ShaderVkImpl::ShaderVkImpl(IReferenceCounters*     pRefCounters,
                                                     TargetGLSLCompiler::glslang,
                                                     "#define TARGET_API_VULKAN 1\n");
 
-            m_SPIRV = GLSLtoSPIRV(m_Desc.ShaderType, GLSLSource.c_str(),
-                                  static_cast<int>(GLSLSource.length()),
-                                  CreationAttribs.ppCompilerOutput);
+            m_SPIRV = pSPIRVCache != nullptr ?
+                pSPIRVCache->GLSLtoSPIRV(m_Desc.ShaderType, GLSLSource.c_str(),
+                                         static_cast<int>(GLSLSource.length()),
+                                         CreationAttribs.ppCompilerOutput) :
+                GLSLtoSPIRV(m_Desc.ShaderType, GLSLSource.c_str(),
+                            static_cast<int>(GLSLSource.length()),
+                            CreationAttribs.ppCompilerOutput);
         }
 
         if (m_SPIRV.empty())
@@ -57,6 +57,9 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
     if (m_Desc.Usage == USAGE_STATIC && (pInitData == nullptr || pInitData->pSubResources == nullptr))
         LOG_ERROR_AND_THROW("Static textures must be initialized with data at creation time: pInitData can't be null");
 
+    if ((m_Desc.MiscFlags & MISC_TEXTURE_FLAG_TRANSIENT) != 0 && pInitData != nullptr && pInitData->pSubResources != nullptr)
+        LOG_ERROR_AND_THROW("Transient textures can't be initialized with data as their memory may be shared with other textures");
+
     const auto& FmtAttribs    = GetTextureFormatAttribs(m_Desc.Format);
     const auto& LogicalDevice = pRenderDeviceVk->GetLogicalDevice();
 
@@ -178,7 +181,8 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
 
         m_VulkanImage = LogicalDevice.CreateImage(ImageCI, m_Desc.Name);
 
-        VkMemoryRequirements MemReqs = LogicalDevice.GetImageMemoryRequirements(m_VulkanImage);
+        VkMemoryDedicatedRequirementsKHR DedicatedReqs;
+        VkMemoryRequirements             MemReqs = LogicalDevice.GetImageMemoryRequirements(m_VulkanImage, DedicatedReqs);
 
         VkMemoryPropertyFlags ImageMemoryFlags = 0;
         if (m_Desc.Usage == USAGE_STAGING)
@@ -187,21 +191,37 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
             ImageMemoryFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
 
         VERIFY(IsPowerOfTwo(MemReqs.alignment), "Alignment is not power of 2!");
-        m_MemoryAllocation = pRenderDeviceVk->AllocateMemory(MemReqs, ImageMemoryFlags);
-        auto AlignedOffset = Align(m_MemoryAllocation.UnalignedOffset, MemReqs.alignment);
-        VERIFY_EXPR(m_MemoryAllocation.Size >= MemReqs.size + (AlignedOffset - m_MemoryAllocation.UnalignedOffset));
-        auto Memory = m_MemoryAllocation.Page->GetVkMemory();
-        auto err    = LogicalDevice.BindImageMemory(m_VulkanImage, Memory, AlignedOffset);
+        VkDeviceMemory Memory        = VK_NULL_HANDLE;
+        VkDeviceSize   AlignedOffset = 0;
+        if (m_Desc.MiscFlags & MISC_TEXTURE_FLAG_TRANSIENT)
+        {
+            // Dedicated allocation preference is ignored as the memory is shared with other transient textures
+            m_TransientAllocation = pRenderDeviceVk->GetTransientTextureAllocator().Allocate(*this, MemReqs);
+            Memory                = m_TransientAllocation.GetVkMemory();
+            AlignedOffset         = m_TransientAllocation.GetOffset();
+        }
+        else
+        {
+            m_MemoryAllocation = pRenderDeviceVk->AllocateMemory(MemReqs, ImageMemoryFlags, DedicatedReqs, VK_NULL_HANDLE, m_VulkanImage);
+            AlignedOffset      = Align(m_MemoryAllocation.UnalignedOffset, MemReqs.alignment);
+            VERIFY_EXPR(m_MemoryAllocation.Size >= MemReqs.size + (AlignedOffset - m_MemoryAllocation.UnalignedOffset));
+            Memory = m_MemoryAllocation.Page->GetVkMemory();
+        }
+        auto err = LogicalDevice.BindImageMemory(m_VulkanImage, Memory, AlignedOffset);
         CHECK_VK_ERROR_AND_THROW(err, "Failed to bind image memory");
 
+        if (IsTransient())
+        {
+            // The memory may currently hold the contents of another transient texture, so it must not be
+            // cleared. The texture takes over the memory when it is transitioned out of the undefined state.
+            SetState(RESOURCE_STATE_UNDEFINED);
+            return;
+        }
+
 
         // Vulkan validation layers do not like uninitialized memory, so if no initial data
         // is provided, we will clear the memory
 
-        VulkanUtilities::CommandPoolWrapper CmdPool;
-        VkCommandBuffer                     vkCmdBuff;
-        pRenderDeviceVk->AllocateTransientCmdPool(CmdPool, vkCmdBuff, "Transient command pool to copy staging data to a device buffer");
-
         VkImageAspectFlags aspectMask = 0;
         if (FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH)
             aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
@@ -225,21 +245,22 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
         SubresRange.baseMipLevel         = 0;
         SubresRange.levelCount           = VK_REMAINING_MIP_LEVELS;
         auto EnabledGraphicsShaderStages = LogicalDevice.GetEnabledGraphicsShaderStages();
-        VulkanUtilities::VulkanCommandBuffer::TransitionImageLayout(vkCmdBuff, m_VulkanImage, ImageCI.initialLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, SubresRange, EnabledGraphicsShaderStages);
         SetState(RESOURCE_STATE_COPY_DEST);
         const auto CurrentLayout = GetLayout();
         VERIFY_EXPR(CurrentLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
 
+        std::vector<VkBufferImageCopy> Regions;
+
+        Uint64 uploadBufferSize = 0;
         if (bInitializeTexture)
         {
             Uint32 ExpectedNumSubresources = ImageCI.mipLevels * ImageCI.arrayLayers;
             if (pInitData->NumSubresources != ExpectedNumSubresources)
                 LOG_ERROR_AND_THROW("Incorrect number of subresources in init data. ", ExpectedNumSubresources, " expected, while ", pInitData->NumSubresources, " provided");
 
-            std::vector<VkBufferImageCopy> Regions(pInitData->NumSubresources);
+            Regions.resize(pInitData->NumSubresources);
 
-            Uint64 uploadBufferSize = 0;
-            Uint32 subres           = 0;
+            Uint32 subres = 0;
             for (Uint32 layer = 0; layer < ImageCI.arrayLayers; ++layer)
             {
                 for (Uint32 mip = 0; mip < ImageCI.mipLevels; ++mip)
@@ -279,37 +300,12 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
                 }
             }
             VERIFY_EXPR(subres == pInitData->NumSubresources);
+        }
 
-            VkBufferCreateInfo VkStagingBuffCI    = {};
-            VkStagingBuffCI.sType                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-            VkStagingBuffCI.pNext                 = nullptr;
-            VkStagingBuffCI.flags                 = 0;
-            VkStagingBuffCI.size                  = uploadBufferSize;
-            VkStagingBuffCI.usage                 = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-            VkStagingBuffCI.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
-            VkStagingBuffCI.queueFamilyIndexCount = 0;
-            VkStagingBuffCI.pQueueFamilyIndices   = nullptr;
-
-            std::string StagingBufferName = "Upload buffer for '";
-            StagingBufferName += m_Desc.Name;
-            StagingBufferName += '\'';
-            VulkanUtilities::BufferWrapper StagingBuffer = LogicalDevice.CreateBuffer(VkStagingBuffCI, StagingBufferName.c_str());
-
-            VkMemoryRequirements StagingBufferMemReqs = LogicalDevice.GetBufferMemoryRequirements(StagingBuffer);
-            VERIFY(IsPowerOfTwo(StagingBufferMemReqs.alignment), "Alignment is not power of 2!");
-            // VK_MEMORY_PROPERTY_HOST_COHERENT_BIT bit specifies that the host cache management commands vkFlushMappedMemoryRanges
-            // and vkInvalidateMappedMemoryRanges are NOT needed to flush host writes to the device or make device writes visible
-            // to the host (10.2)
-            auto StagingMemoryAllocation = pRenderDeviceVk->AllocateMemory(StagingBufferMemReqs, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-            auto StagingBufferMemory     = StagingMemoryAllocation.Page->GetVkMemory();
-            auto AlignedStagingMemOffset = Align(StagingMemoryAllocation.UnalignedOffset, StagingBufferMemReqs.alignment);
-            VERIFY_EXPR(StagingMemoryAllocation.Size >= StagingBufferMemReqs.size + (AlignedStagingMemOffset - StagingMemoryAllocation.UnalignedOffset));
-
-            auto* StagingData = reinterpret_cast<uint8_t*>(StagingMemoryAllocation.Page->GetCPUMemory());
-            VERIFY_EXPR(StagingData != nullptr);
-            StagingData += AlignedStagingMemOffset;
-
-            subres = 0;
+        // Writes the initial data to the staging memory at the offsets specified by the copy regions
+        auto WriteStagingData = [&](uint8_t* StagingData) //
+        {
+            Uint32 subres = 0;
             for (Uint32 layer = 0; layer < ImageCI.arrayLayers; ++layer)
             {
                 for (Uint32 mip = 0; mip < ImageCI.mipLevels; ++mip)
@@ -323,10 +319,6 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
                     VERIFY_EXPR(MipInfo.LogicalHeight == CopyRegion.imageExtent.height);
                     VERIFY_EXPR(MipInfo.Depth == CopyRegion.imageExtent.depth);
 
-                    VERIFY(SubResData.Stride == 0 || SubResData.Stride >= MipInfo.RowSize, "Stride is too small");
-                    // For compressed-block formats, MipInfo.RowSize is the size of one row of blocks
-                    VERIFY(SubResData.DepthStride == 0 || SubResData.DepthStride >= (MipInfo.StorageHeight / FmtAttribs.BlockHeight) * MipInfo.RowSize, "Depth stride is too small");
-
                     for (Uint32 z = 0; z < MipInfo.Depth; ++z)
                     {
                         for (Uint32 y = 0; y < MipInfo.StorageHeight; y += FmtAttribs.BlockHeight)
@@ -342,59 +334,142 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
                 }
             }
             VERIFY_EXPR(subres == pInitData->NumSubresources);
+        };
 
-            err = LogicalDevice.BindBufferMemory(StagingBuffer, StagingBufferMemory, AlignedStagingMemOffset);
-            CHECK_VK_ERROR_AND_THROW(err, "Failed to bind staging bufer memory");
+        // Records the commands that initialize the texture. The copy regions are
+        // specified relative to StagingBufferOffset in the staging buffer.
+        auto RecordInitCommands = [&](VkCommandBuffer vkCmdBuff, VkBuffer vkStagingBuffer, VkDeviceSize StagingBufferOffset) //
+        {
+            VulkanUtilities::VulkanCommandBuffer::TransitionImageLayout(vkCmdBuff, m_VulkanImage, ImageCI.initialLayout, CurrentLayout, SubresRange, EnabledGraphicsShaderStages);
 
-            VulkanUtilities::VulkanCommandBuffer::BufferMemoryBarrier(vkCmdBuff, StagingBuffer, 0, VK_ACCESS_TRANSFER_READ_BIT, EnabledGraphicsShaderStages);
+            if (bInitializeTexture)
+            {
+                for (auto& CopyRegion : Regions)
+                    CopyRegion.bufferOffset += StagingBufferOffset;
+
+                // Copy commands MUST be recorded outside of a render pass instance. This is OK here
+                // as the command buffer only contains resource initialization commands
+                vkCmdCopyBufferToImage(vkCmdBuff, vkStagingBuffer, m_VulkanImage,
+                                       CurrentLayout, // dstImageLayout must be VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL or VK_IMAGE_LAYOUT_GENERAL (18.4)
+                                       static_cast<uint32_t>(Regions.size()), Regions.data());
+            }
+            else
+            {
+                VkImageSubresourceRange Subresource;
+                Subresource.aspectMask     = aspectMask;
+                Subresource.baseMipLevel   = 0;
+                Subresource.levelCount     = VK_REMAINING_MIP_LEVELS;
+                Subresource.baseArrayLayer = 0;
+                Subresource.layerCount     = VK_REMAINING_ARRAY_LAYERS;
+                if (aspectMask == VK_IMAGE_ASPECT_COLOR_BIT)
+                {
+                    if (FmtAttribs.ComponentType != COMPONENT_TYPE_COMPRESSED)
+                    {
+                        VkClearColorValue ClearColor = {};
+                        vkCmdClearColorImage(vkCmdBuff, m_VulkanImage,
+                                             CurrentLayout, // must be VK_IMAGE_LAYOUT_GENERAL or VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
+                                             &ClearColor, 1, &Subresource);
+                    }
+                }
+                else if (aspectMask == VK_IMAGE_ASPECT_DEPTH_BIT ||
+                         aspectMask == (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT))
+                {
+                    VkClearDepthStencilValue ClearValue = {};
+                    vkCmdClearDepthStencilImage(vkCmdBuff, m_VulkanImage,
+                                                CurrentLayout, // must be VK_IMAGE_LAYOUT_GENERAL or VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
+                                                &ClearValue, 1, &Subresource);
+                }
+                else
+                {
+                    UNEXPECTED("Unexpected aspect mask");
+                }
+            }
+        };
 
-            // Copy commands MUST be recorded outside of a render pass instance. This is OK here
-            // as copy will be the only command in the cmd buffer
-            vkCmdCopyBufferToImage(vkCmdBuff, StagingBuffer, m_VulkanImage,
-                                   CurrentLayout, // dstImageLayout must be VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL or VK_IMAGE_LAYOUT_GENERAL (18.4)
-                                   static_cast<uint32_t>(Regions.size()), Regions.data());
+        // bufferOffset must be a multiple of 4 and of the texel block size (18.4)
+        const size_t TexelBlockSize = FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED ?
+            size_t{FmtAttribs.ComponentSize} :
+            size_t{FmtAttribs.ComponentSize} * size_t{FmtAttribs.NumComponents};
 
-            Uint32 QueueIndex = 0;
-            pRenderDeviceVk->ExecuteAndDisposeTransientCmdBuff(QueueIndex, vkCmdBuff, std::move(CmdPool));
+        size_t StagingAlignment = std::max(TexelBlockSize, size_t{1});
+        while (StagingAlignment % 4 != 0)
+            StagingAlignment += TexelBlockSize;
 
-            // After command buffer is submitted, safe-release resources. This strategy
-            // is little overconservative as the resources will be released after the first
-            // command buffer submitted through the immediate context will be completed
-            pRenderDeviceVk->SafeReleaseDeviceObject(std::move(StagingBuffer), Uint64{1} << Uint64{QueueIndex});
-            pRenderDeviceVk->SafeReleaseDeviceObject(std::move(StagingMemoryAllocation), Uint64{1} << Uint64{QueueIndex});
-        }
-        else
+        auto* pUploadBatch = pRenderDeviceVk->GetResourceUploadBatch();
+        bool  IsBatched    = false;
+        if (pUploadBatch != nullptr)
         {
-            VkImageSubresourceRange Subresource;
-            Subresource.aspectMask     = aspectMask;
-            Subresource.baseMipLevel   = 0;
-            Subresource.levelCount     = VK_REMAINING_MIP_LEVELS;
-            Subresource.baseArrayLayer = 0;
-            Subresource.layerCount     = VK_REMAINING_ARRAY_LAYERS;
-            if (aspectMask == VK_IMAGE_ASPECT_COLOR_BIT)
-            {
-                if (FmtAttribs.ComponentType != COMPONENT_TYPE_COMPRESSED)
+            IsBatched = pUploadBatch->Record(
+                static_cast<size_t>(uploadBufferSize), StagingAlignment,
+                [&](VkCommandBuffer vkCmdBuff, const ResourceUploadBatch::StagingRegion& Staging) //
                 {
-                    VkClearColorValue ClearColor = {};
-                    vkCmdClearColorImage(vkCmdBuff, m_VulkanImage,
-                                         CurrentLayout, // must be VK_IMAGE_LAYOUT_GENERAL or VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
-                                         &ClearColor, 1, &Subresource);
-                }
-            }
-            else if (aspectMask == VK_IMAGE_ASPECT_DEPTH_BIT ||
-                     aspectMask == (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT))
-            {
-                VkClearDepthStencilValue ClearValue = {};
-                vkCmdClearDepthStencilImage(vkCmdBuff, m_VulkanImage,
-                                            CurrentLayout, // must be VK_IMAGE_LAYOUT_GENERAL or VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
-                                            &ClearValue, 1, &Subresource);
-            }
-            else
+                    // Host writes to the shared staging buffer are made visible to the device
+                    // when the batch is submitted, so no buffer barrier is required
+                    if (bInitializeTexture)
+                        WriteStagingData(Staging.pCPUAddress);
+                    RecordInitCommands(vkCmdBuff, Staging.vkBuffer, Staging.Offset);
+                } //
+            );
+        }
+
+        if (!IsBatched)
+        {
+            VulkanUtilities::CommandPoolWrapper CmdPool;
+            VkCommandBuffer                     vkCmdBuff;
+            pRenderDeviceVk->AllocateTransientCmdPool(CmdPool, vkCmdBuff, "Transient command pool to copy staging data to a device buffer");
+
+            VulkanUtilities::BufferWrapper          StagingBuffer;
+            VulkanUtilities::VulkanMemoryAllocation StagingMemoryAllocation;
+            if (bInitializeTexture)
             {
-                UNEXPECTED("Unexpected aspect mask");
+                VkBufferCreateInfo VkStagingBuffCI    = {};
+                VkStagingBuffCI.sType                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+                VkStagingBuffCI.pNext                 = nullptr;
+                VkStagingBuffCI.flags                 = 0;
+                VkStagingBuffCI.size                  = uploadBufferSize;
+                VkStagingBuffCI.usage                 = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+                VkStagingBuffCI.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
+                VkStagingBuffCI.queueFamilyIndexCount = 0;
+                VkStagingBuffCI.pQueueFamilyIndices   = nullptr;
+
+                std::string StagingBufferName = "Upload buffer for '";
+                StagingBufferName += m_Desc.Name;
+                StagingBufferName += '\'';
+                StagingBuffer = LogicalDevice.CreateBuffer(VkStagingBuffCI, StagingBufferName.c_str());
+
+                VkMemoryRequirements StagingBufferMemReqs = LogicalDevice.GetBufferMemoryRequirements(StagingBuffer);
+                VERIFY(IsPowerOfTwo(StagingBufferMemReqs.alignment), "Alignment is not power of 2!");
+                // VK_MEMORY_PROPERTY_HOST_COHERENT_BIT bit specifies that the host cache management commands vkFlushMappedMemoryRanges
+                // and vkInvalidateMappedMemoryRanges are NOT needed to flush host writes to the device or make device writes visible
+                // to the host (10.2)
+                StagingMemoryAllocation      = pRenderDeviceVk->AllocateMemory(StagingBufferMemReqs, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+                auto StagingBufferMemory     = StagingMemoryAllocation.Page->GetVkMemory();
+                auto AlignedStagingMemOffset = Align(StagingMemoryAllocation.UnalignedOffset, StagingBufferMemReqs.alignment);
+                VERIFY_EXPR(StagingMemoryAllocation.Size >= StagingBufferMemReqs.size + (AlignedStagingMemOffset - StagingMemoryAllocation.UnalignedOffset));
+
+                auto* StagingData = reinterpret_cast<uint8_t*>(StagingMemoryAllocation.Page->GetCPUMemory());
+                VERIFY_EXPR(StagingData != nullptr);
+                WriteStagingData(StagingData + AlignedStagingMemOffset);
+
+                err = LogicalDevice.BindBufferMemory(StagingBuffer, StagingBufferMemory, AlignedStagingMemOffset);
+                CHECK_VK_ERROR_AND_THROW(err, "Failed to bind staging bufer memory");
+
+                VulkanUtilities::VulkanCommandBuffer::BufferMemoryBarrier(vkCmdBuff, StagingBuffer, 0, VK_ACCESS_TRANSFER_READ_BIT, EnabledGraphicsShaderStages);
             }
+
+            RecordInitCommands(vkCmdBuff, StagingBuffer, 0);
+
             Uint32 QueueIndex = 0;
             pRenderDeviceVk->ExecuteAndDisposeTransientCmdBuff(QueueIndex, vkCmdBuff, std::move(CmdPool));
+
+            if (bInitializeTexture)
+            {
+                // After command buffer is submitted, safe-release resources. This strategy
+                // is little overconservative as the resources will be released after the first
+                // command buffer submitted through the immediate context will be completed
+                pRenderDeviceVk->SafeReleaseDeviceObject(std::move(StagingBuffer), Uint64{1} << Uint64{QueueIndex});
+                pRenderDeviceVk->SafeReleaseDeviceObject(std::move(StagingMemoryAllocation), Uint64{1} << Uint64{QueueIndex});
+            }
         }
     }
     else if (m_Desc.Usage == USAGE_STAGING)
@@ -597,6 +672,12 @@ TextureVkImpl::~TextureVkImpl()
     if (m_StagingBuffer)
         m_pDevice->SafeReleaseDeviceObject(std::move(m_StagingBuffer), m_Desc.CommandQueueMask);
     m_pDevice->SafeReleaseDeviceObject(std::move(m_MemoryAllocation), m_Desc.CommandQueueMask);
+    if (m_TransientAllocation)
+    {
+        // The memory range remains occupied until the GPU is done with the texture
+        m_pDevice->GetTransientTextureAllocator().OnTextureDestroyed(m_TransientAllocation, IsInKnownState() ? GetLayout() : VK_IMAGE_LAYOUT_GENERAL);
+        m_pDevice->SafeReleaseDeviceObject(std::move(m_TransientAllocation), m_Desc.CommandQueueMask);
+    }
 }
 
 VulkanUtilities::ImageViewWrapper TextureVkImpl::CreateImageView(TextureViewDesc& ViewDesc)
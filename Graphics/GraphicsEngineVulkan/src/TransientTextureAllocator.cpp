@@ -0,0 +1,256 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include <algorithm>
+#include "TransientTextureAllocator.hpp"
+#include "RenderDeviceVkImpl.hpp"
+#include "TextureVkImpl.hpp"
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+TransientTextureAllocator::Allocation::Allocation(TransientTextureAllocator& Allocator, Heap& TexHeap, Placement& TexPlacement) noexcept :
+    // clang-format off
+    m_pAllocator{&Allocator   },
+    m_pHeap     {&TexHeap     },
+    m_pPlacement{&TexPlacement}
+// clang-format on
+{
+}
+
+TransientTextureAllocator::Allocation::Allocation(Allocation&& rhs) noexcept :
+    // clang-format off
+    m_pAllocator{rhs.m_pAllocator},
+    m_pHeap     {rhs.m_pHeap     },
+    m_pPlacement{rhs.m_pPlacement}
+// clang-format on
+{
+    rhs.m_pAllocator = nullptr;
+    rhs.m_pHeap      = nullptr;
+    rhs.m_pPlacement = nullptr;
+}
+
+TransientTextureAllocator::Allocation& TransientTextureAllocator::Allocation::operator=(Allocation&& rhs) noexcept
+{
+    if (m_pPlacement != nullptr)
+        m_pAllocator->Free(*m_pHeap, *m_pPlacement);
+
+    m_pAllocator = rhs.m_pAllocator;
+    m_pHeap      = rhs.m_pHeap;
+    m_pPlacement = rhs.m_pPlacement;
+
+    rhs.m_pAllocator = nullptr;
+    rhs.m_pHeap      = nullptr;
+    rhs.m_pPlacement = nullptr;
+    return *this;
+}
+
+TransientTextureAllocator::Allocation::~Allocation()
+{
+    if (m_pPlacement != nullptr)
+        m_pAllocator->Free(*m_pHeap, *m_pPlacement);
+}
+
+VkDeviceMemory TransientTextureAllocator::Allocation::GetVkMemory() const
+{
+    VERIFY_EXPR(m_pHeap != nullptr);
+    return m_pHeap->Memory.Page->GetVkMemory();
+}
+
+VkDeviceSize TransientTextureAllocator::Allocation::GetOffset() const
+{
+    VERIFY_EXPR(m_pPlacement != nullptr);
+    return m_pPlacement->Offset;
+}
+
+
+TransientTextureAllocator::TransientTextureAllocator(RenderDeviceVkImpl& DeviceVkImpl, VkDeviceSize HeapSize) :
+    // clang-format off
+    m_DeviceVkImpl{DeviceVkImpl},
+    m_HeapSize    {HeapSize    }
+// clang-format on
+{
+}
+
+TransientTextureAllocator::~TransientTextureAllocator()
+{
+    DEV_CHECK_ERR(m_Heaps.empty(), "All transient textures must have been released by now");
+}
+
+bool TransientTextureAllocator::FindOffset(const Heap&                     TexHeap,
+                                           const VkMemoryRequirements&     MemReqs,
+                                           const TransientTextureLifetime& Lifetime,
+                                           VkDeviceSize&                   Offset) const
+{
+    // Only the ranges of the textures that are used in the same passes are occupied
+    std::vector<std::pair<VkDeviceSize, VkDeviceSize>> OccupiedRanges;
+    for (const auto& OtherPlacement : TexHeap.Placements)
+    {
+        if (OtherPlacement.Lifetime.Overlaps(Lifetime))
+            OccupiedRanges.emplace_back(OtherPlacement.Offset, OtherPlacement.Offset + OtherPlacement.Size);
+    }
+    std::sort(OccupiedRanges.begin(), OccupiedRanges.end());
+
+    const auto HeapStart = TexHeap.Memory.UnalignedOffset;
+    const auto HeapEnd   = TexHeap.Memory.UnalignedOffset + TexHeap.Memory.Size;
+
+    // Find the first gap that is large enough
+    auto Candidate = Align(HeapStart, MemReqs.alignment);
+    for (const auto& Range : OccupiedRanges)
+    {
+        if (Candidate + MemReqs.size <= Range.first)
+            break;
+        Candidate = std::max(Candidate, Align(Range.second, MemReqs.alignment));
+    }
+
+    if (Candidate + MemReqs.size > HeapEnd)
+        return false;
+
+    Offset = Candidate;
+    return true;
+}
+
+TransientTextureAllocator::Allocation TransientTextureAllocator::Allocate(TextureVkImpl& Texture, const VkMemoryRequirements& MemReqs)
+{
+    VERIFY(IsPowerOfTwo(MemReqs.alignment), "Alignment is not power of 2!");
+
+    const auto& Lifetime = Texture.GetDesc().TransientLifetime;
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    VkDeviceSize Offset = 0;
+    for (auto& TexHeap : m_Heaps)
+    {
+        if ((MemReqs.memoryTypeBits & (1u << TexHeap.MemoryTypeIndex)) == 0)
+            continue;
+
+        if (FindOffset(TexHeap, MemReqs, Lifetime, Offset))
+        {
+            TexHeap.Placements.emplace_back(&Texture, Lifetime, Offset, MemReqs.size);
+            return Allocation{*this, TexHeap, TexHeap.Placements.back()};
+        }
+    }
+
+    VkMemoryRequirements HeapMemReqs = MemReqs;
+    HeapMemReqs.size                 = std::max(MemReqs.size, m_HeapSize);
+
+    Heap NewHeap;
+    NewHeap.Memory          = m_DeviceVkImpl.AllocateMemory(HeapMemReqs, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    NewHeap.MemoryTypeIndex = NewHeap.Memory.Page->GetMemoryTypeIndex();
+    m_Heaps.emplace_back(std::move(NewHeap));
+
+    auto& TexHeap = m_Heaps.back();
+    if (!FindOffset(TexHeap, MemReqs, Lifetime, Offset))
+    {
+        UNEXPECTED("The texture must fit into the new heap");
+    }
+    TexHeap.Placements.emplace_back(&Texture, Lifetime, Offset, MemReqs.size);
+    return Allocation{*this, TexHeap, TexHeap.Placements.back()};
+}
+
+void TransientTextureAllocator::OnTextureDestroyed(Allocation& TexAllocation, VkImageLayout LastLayout)
+{
+    VERIFY_EXPR(TexAllocation);
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    auto& TexPlacement = *TexAllocation.m_pPlacement;
+    if (TexPlacement.IsActive)
+        TexPlacement.LastLayout = LastLayout;
+    TexPlacement.pTexture = nullptr;
+}
+
+void TransientTextureAllocator::Activate(const Allocation& TexAllocation, std::vector<VkImageLayout>& AliasedLayouts)
+{
+    VERIFY_EXPR(TexAllocation);
+    AliasedLayouts.clear();
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    auto& TexPlacement = *TexAllocation.m_pPlacement;
+    for (auto& OtherPlacement : TexAllocation.m_pHeap->Placements)
+    {
+        if (&OtherPlacement == &TexPlacement || !OtherPlacement.MemoryOverlaps(TexPlacement))
+            continue;
+
+        if (OtherPlacement.IsActive && OtherPlacement.pTexture != nullptr)
+        {
+            auto& OtherTexture = *OtherPlacement.pTexture;
+            if (OtherTexture.IsInKnownState())
+            {
+                OtherPlacement.LastLayout = OtherTexture.GetLayout();
+                // The contents of the texture are lost
+                OtherTexture.SetState(RESOURCE_STATE_UNDEFINED);
+            }
+            else
+            {
+                // The state is managed by the application, so any access is possible
+                OtherPlacement.LastLayout = VK_IMAGE_LAYOUT_GENERAL;
+            }
+        }
+        OtherPlacement.IsActive = false;
+
+        // The accesses of the textures that have been replaced before may still be in flight, so they
+        // are synchronized too.
+        const auto LastLayout = OtherPlacement.LastLayout;
+        if (LastLayout != VK_IMAGE_LAYOUT_UNDEFINED && std::find(AliasedLayouts.begin(), AliasedLayouts.end(), LastLayout) == AliasedLayouts.end())
+            AliasedLayouts.push_back(LastLayout);
+    }
+
+    TexPlacement.IsActive = true;
+}
+
+void TransientTextureAllocator::Free(Heap& TexHeap, Placement& TexPlacement)
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    for (auto it = TexHeap.Placements.begin(); it != TexHeap.Placements.end(); ++it)
+    {
+        if (&*it == &TexPlacement)
+        {
+            TexHeap.Placements.erase(it);
+            break;
+        }
+    }
+
+    if (TexHeap.Placements.empty())
+    {
+        // The placements are released through the release queue, so the GPU no longer uses the heap
+        for (auto it = m_Heaps.begin(); it != m_Heaps.end(); ++it)
+        {
+            if (&*it == &TexHeap)
+            {
+                m_Heaps.erase(it);
+                break;
+            }
+        }
+    }
+}
+
+} // namespace Diligent
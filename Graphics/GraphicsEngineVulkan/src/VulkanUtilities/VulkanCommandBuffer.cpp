@@ -235,17 +235,14 @@ static VkPipelineStageFlags AccessMaskFromImageLayout(VkImageLayout Layout,
     return AccessMask;
 }
 
-void VulkanCommandBuffer::TransitionImageLayout(VkCommandBuffer                CmdBuffer,
-                                                VkImage                        Image,
-                                                VkImageLayout                  OldLayout,
-                                                VkImageLayout                  NewLayout,
-                                                const VkImageSubresourceRange& SubresRange,
-                                                VkPipelineStageFlags           EnabledGraphicsShaderStages,
-                                                VkPipelineStageFlags           SrcStages,
-                                                VkPipelineStageFlags           DestStages)
+static VkImageMemoryBarrier InitImageMemoryBarrier(VkImage                        Image,
+                                                   VkImageLayout                  OldLayout,
+                                                   VkImageLayout                  NewLayout,
+                                                   const VkImageSubresourceRange& SubresRange,
+                                                   VkPipelineStageFlags           EnabledGraphicsShaderStages,
+                                                   VkPipelineStageFlags&          SrcStages,
+                                                   VkPipelineStageFlags&          DestStages)
 {
-    VERIFY_EXPR(CmdBuffer != VK_NULL_HANDLE);
-
     VkImageMemoryBarrier ImgBarrier = {};
     ImgBarrier.sType                = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
     ImgBarrier.pNext                = nullptr;
@@ -298,6 +295,62 @@ void VulkanCommandBuffer::TransitionImageLayout(VkCommandBuffer                C
         }
     }
 
+    return ImgBarrier;
+}
+
+static VkBufferMemoryBarrier InitBufferMemoryBarrier(VkBuffer              Buffer,
+                                                     VkAccessFlags         srcAccessMask,
+                                                     VkAccessFlags         dstAccessMask,
+                                                     VkPipelineStageFlags  EnabledGraphicsShaderStages,
+                                                     VkPipelineStageFlags& SrcStages,
+                                                     VkPipelineStageFlags& DestStages,
+                                                     VkDeviceSize          Offset,
+                                                     VkDeviceSize          Size)
+{
+    VkBufferMemoryBarrier BuffBarrier = {};
+    BuffBarrier.sType                 = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    BuffBarrier.pNext                 = nullptr;
+    BuffBarrier.srcAccessMask         = srcAccessMask;
+    BuffBarrier.dstAccessMask         = dstAccessMask;
+    BuffBarrier.srcQueueFamilyIndex   = VK_QUEUE_FAMILY_IGNORED;
+    BuffBarrier.dstQueueFamilyIndex   = VK_QUEUE_FAMILY_IGNORED;
+    BuffBarrier.buffer                = Buffer;
+    BuffBarrier.offset                = Offset;
+    BuffBarrier.size                  = Size;
+    if (SrcStages == 0)
+    {
+        if (BuffBarrier.srcAccessMask != 0)
+            SrcStages = PipelineStageFromAccessFlags(BuffBarrier.srcAccessMask, EnabledGraphicsShaderStages);
+        else
+        {
+            // An execution dependency with only VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT in the source stage
+            // mask will effectively not wait for any prior commands to complete. (6.1.2)
+            SrcStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+        }
+    }
+
+    if (DestStages == 0)
+    {
+        VERIFY(BuffBarrier.dstAccessMask != 0, "Dst access mask must not be zero");
+        DestStages = PipelineStageFromAccessFlags(BuffBarrier.dstAccessMask, EnabledGraphicsShaderStages);
+    }
+
+    return BuffBarrier;
+}
+
+void VulkanCommandBuffer::TransitionImageLayout(VkCommandBuffer                CmdBuffer,
+                                                VkImage                        Image,
+                                                VkImageLayout                  OldLayout,
+                                                VkImageLayout                  NewLayout,
+                                                const VkImageSubresourceRange& SubresRange,
+                                                VkPipelineStageFlags           EnabledGraphicsShaderStages,
+                                                VkPipelineStageFlags           SrcStages,
+                                                VkPipelineStageFlags           DestStages)
+{
+    VERIFY_EXPR(CmdBuffer != VK_NULL_HANDLE);
+
+    auto ImgBarrier = InitImageMemoryBarrier(Image, OldLayout, NewLayout, SubresRange, EnabledGraphicsShaderStages, SrcStages, DestStages);
+
     // Including a particular pipeline stage in the first synchronization scope of a command implicitly
     // includes logically earlier pipeline stages in the synchronization scope. Similarly, the second
     // synchronization scope includes logically later pipeline stages.
@@ -329,35 +382,11 @@ void VulkanCommandBuffer::BufferMemoryBarrier(VkCommandBuffer      CmdBuffer,
                                               VkAccessFlags        dstAccessMask,
                                               VkPipelineStageFlags EnabledGraphicsShaderStages,
                                               VkPipelineStageFlags SrcStages,
-                                              VkPipelineStageFlags DestStages)
+                                              VkPipelineStageFlags DestStages,
+                                              VkDeviceSize         Offset,
+                                              VkDeviceSize         Size)
 {
-    VkBufferMemoryBarrier BuffBarrier = {};
-    BuffBarrier.sType                 = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
-    BuffBarrier.pNext                 = nullptr;
-    BuffBarrier.srcAccessMask         = srcAccessMask;
-    BuffBarrier.dstAccessMask         = dstAccessMask;
-    BuffBarrier.srcQueueFamilyIndex   = VK_QUEUE_FAMILY_IGNORED;
-    BuffBarrier.dstQueueFamilyIndex   = VK_QUEUE_FAMILY_IGNORED;
-    BuffBarrier.buffer                = Buffer;
-    BuffBarrier.offset                = 0;
-    BuffBarrier.size                  = VK_WHOLE_SIZE;
-    if (SrcStages == 0)
-    {
-        if (BuffBarrier.srcAccessMask != 0)
-            SrcStages = PipelineStageFromAccessFlags(BuffBarrier.srcAccessMask, EnabledGraphicsShaderStages);
-        else
-        {
-            // An execution dependency with only VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT in the source stage
-            // mask will effectively not wait for any prior commands to complete. (6.1.2)
-            SrcStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-        }
-    }
-
-    if (DestStages == 0)
-    {
-        VERIFY(BuffBarrier.dstAccessMask != 0, "Dst access mask must not be zero");
-        DestStages = PipelineStageFromAccessFlags(BuffBarrier.dstAccessMask, EnabledGraphicsShaderStages);
-    }
+    auto BuffBarrier = InitBufferMemoryBarrier(Buffer, srcAccessMask, dstAccessMask, EnabledGraphicsShaderStages, SrcStages, DestStages, Offset, Size);
 
     vkCmdPipelineBarrier(CmdBuffer,
                          SrcStages,    // must not be 0
@@ -371,8 +400,138 @@ void VulkanCommandBuffer::BufferMemoryBarrier(VkCommandBuffer      CmdBuffer,
                          nullptr);
 }
 
-void VulkanCommandBuffer::FlushBarriers()
+
+static bool RangesOverlap(uint32_t First0, uint32_t Count0, uint32_t First1, uint32_t Count1)
+{
+    // VK_REMAINING_MIP_LEVELS and VK_REMAINING_ARRAY_LAYERS are equal to ~0U
+    const auto End0 = Count0 == ~0U ? ~0U : First0 + Count0;
+    const auto End1 = Count1 == ~0U ? ~0U : First1 + Count1;
+    return First0 < End1 && First1 < End0;
+}
+
+static bool SubresourceRangesOverlap(const VkImageSubresourceRange& Range0, const VkImageSubresourceRange& Range1)
+{
+    // clang-format off
+    return (Range0.aspectMask & Range1.aspectMask) != 0 &&
+           RangesOverlap(Range0.baseMipLevel,   Range0.levelCount, Range1.baseMipLevel,   Range1.levelCount) &&
+           RangesOverlap(Range0.baseArrayLayer, Range0.layerCount, Range1.baseArrayLayer, Range1.layerCount);
+    // clang-format on
+}
+
+static bool BufferRangesOverlap(VkDeviceSize Offset0, VkDeviceSize Size0, VkDeviceSize Offset1, VkDeviceSize Size1)
 {
+    const auto End0 = Size0 == VK_WHOLE_SIZE ? VK_WHOLE_SIZE : Offset0 + Size0;
+    const auto End1 = Size1 == VK_WHOLE_SIZE ? VK_WHOLE_SIZE : Offset1 + Size1;
+    return Offset0 < End1 && Offset1 < End0;
+}
+
+void VulkanCommandBuffer::AddImageBarrier(VkImage                        Image,
+                                          VkImageLayout                  OldLayout,
+                                          VkImageLayout                  NewLayout,
+                                          const VkImageSubresourceRange& SubresRange,
+                                          VkPipelineStageFlags           SrcStages,
+                                          VkPipelineStageFlags           DestStages)
+{
+    VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "Pipeline barriers must be issued outside of render pass");
+
+    // Layout transitions of the same subresource within one pipeline barrier are not ordered
+    // with respect to each other, so the pending barriers must be recorded first.
+    for (const auto& PendingBarrier : m_ImageBarriers)
+    {
+        if (PendingBarrier.image == Image && SubresourceRangesOverlap(PendingBarrier.subresourceRange, SubresRange))
+        {
+            RecordPendingBarriers();
+            break;
+        }
+    }
+
+    m_ImageBarriers.emplace_back(InitImageMemoryBarrier(Image, OldLayout, NewLayout, SubresRange, m_EnabledGraphicsShaderStages, SrcStages, DestStages));
+    // Merging the stage masks only widens the synchronization scopes of individual barriers,
+    // which is always valid (6.1.2)
+    m_PendingSrcStages |= SrcStages;
+    m_PendingDstStages |= DestStages;
+    ++m_BarrierStats.NumImageBarriers;
+}
+
+void VulkanCommandBuffer::AddBufferBarrier(VkBuffer             Buffer,
+                                           VkAccessFlags        srcAccessMask,
+                                           VkAccessFlags        dstAccessMask,
+                                           VkPipelineStageFlags SrcStages,
+                                           VkPipelineStageFlags DestStages,
+                                           VkDeviceSize         Offset,
+                                           VkDeviceSize         Size)
+{
+    VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "Pipeline barriers must be issued outside of render pass");
+
+    // Suballocated buffers share the Vulkan buffer, so only the barriers for overlapping ranges are ordered
+    for (const auto& PendingBarrier : m_BufferBarriers)
+    {
+        if (PendingBarrier.buffer == Buffer && BufferRangesOverlap(PendingBarrier.offset, PendingBarrier.size, Offset, Size))
+        {
+            // The second barrier must observe the first one
+            RecordPendingBarriers();
+            break;
+        }
+    }
+
+    m_BufferBarriers.emplace_back(InitBufferMemoryBarrier(Buffer, srcAccessMask, dstAccessMask, m_EnabledGraphicsShaderStages, SrcStages, DestStages, Offset, Size));
+    m_PendingSrcStages |= SrcStages;
+    m_PendingDstStages |= DestStages;
+    ++m_BarrierStats.NumBufferBarriers;
+}
+
+void VulkanCommandBuffer::AddAliasingBarrier(VkImageLayout PrevLayout, VkImageLayout NewLayout)
+{
+    VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "Pipeline barriers must be issued outside of render pass");
+
+    // Layout transitions of the resource that previously used the memory may still be pending and
+    // would not be ordered with respect to the transition of the resource that aliases it.
+    if (!m_ImageBarriers.empty() || !m_BufferBarriers.empty())
+        RecordPendingBarriers();
+
+    // The contents of the memory are discarded, so the global memory barrier only needs to make the
+    // previous writes available and order them before the new accesses.
+    const auto SrcAccessMask = static_cast<VkAccessFlags>(AccessMaskFromImageLayout(PrevLayout, false));
+    const auto DstAccessMask = static_cast<VkAccessFlags>(AccessMaskFromImageLayout(NewLayout, true));
+    if (SrcAccessMask == 0)
+        return;
+
+    m_PendingMemoryBarrier.srcAccessMask |= SrcAccessMask;
+    m_PendingMemoryBarrier.dstAccessMask |= DstAccessMask;
+    m_MemoryBarrierPending = true;
+
+    m_PendingSrcStages |= PipelineStageFromAccessFlags(SrcAccessMask, m_EnabledGraphicsShaderStages);
+    m_PendingDstStages |= DstAccessMask != 0 ?
+        static_cast<VkPipelineStageFlags>(PipelineStageFromAccessFlags(DstAccessMask, m_EnabledGraphicsShaderStages)) :
+        static_cast<VkPipelineStageFlags>(VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
+    ++m_BarrierStats.NumAliasingBarriers;
+}
+
+void VulkanCommandBuffer::RecordPendingBarriers()
+{
+    VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+    VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "Pending barriers must be recorded outside of render pass");
+    VERIFY_EXPR(m_PendingSrcStages != 0 && m_PendingDstStages != 0);
+
+    vkCmdPipelineBarrier(m_VkCmdBuffer,
+                         m_PendingSrcStages,
+                         m_PendingDstStages,
+                         0,
+                         m_MemoryBarrierPending ? 1 : 0,
+                         m_MemoryBarrierPending ? &m_PendingMemoryBarrier : nullptr,
+                         static_cast<uint32_t>(m_BufferBarriers.size()),
+                         m_BufferBarriers.empty() ? nullptr : m_BufferBarriers.data(),
+                         static_cast<uint32_t>(m_ImageBarriers.size()),
+                         m_ImageBarriers.empty() ? nullptr : m_ImageBarriers.data());
+    ++m_BarrierStats.NumBarrierCommands;
+
+    m_ImageBarriers.clear();
+    m_BufferBarriers.clear();
+    m_PendingMemoryBarrier.srcAccessMask = 0;
+    m_PendingMemoryBarrier.dstAccessMask = 0;
+    m_MemoryBarrierPending               = false;
+    m_PendingSrcStages                   = 0;
+    m_PendingDstStages                   = 0;
 }
 
 } // namespace VulkanUtilities
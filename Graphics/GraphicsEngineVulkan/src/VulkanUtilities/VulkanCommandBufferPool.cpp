@@ -60,16 +60,18 @@ VulkanCommandBufferPool::~VulkanCommandBufferPool()
     DEV_CHECK_ERR(m_BuffCounter == 0, m_BuffCounter, " command buffer(s) have not been returned to the pool. If there are outstanding references to these buffers in release queues, FreeCommandBuffer() will crash when attempting to return a buffer to the pool.");
 }
 
-VkCommandBuffer VulkanCommandBufferPool::GetCommandBuffer(const char* DebugName)
+VkCommandBuffer VulkanCommandBufferPool::GetCommandBuffer(const char* DebugName, const VkCommandBufferInheritanceInfo* pInheritanceInfo)
 {
     VkCommandBuffer CmdBuffer = VK_NULL_HANDLE;
 
+    const auto Level = pInheritanceInfo != nullptr ? VK_COMMAND_BUFFER_LEVEL_SECONDARY : VK_COMMAND_BUFFER_LEVEL_PRIMARY;
     {
         std::lock_guard<std::mutex> Lock{m_Mutex};
 
-        if (!m_CmdBuffers.empty())
+        auto& CmdBuffers = Level == VK_COMMAND_BUFFER_LEVEL_PRIMARY ? m_CmdBuffers : m_SecondaryCmdBuffers;
+        if (!CmdBuffers.empty())
         {
-            CmdBuffer = m_CmdBuffers.front();
+            CmdBuffer = CmdBuffers.front();
             auto err  = vkResetCommandBuffer(
                 CmdBuffer,
                 0 // VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT -  specifies that most or all memory resources currently
@@ -77,7 +79,7 @@ VkCommandBuffer VulkanCommandBufferPool::GetCommandBuffer(const char* DebugName)
             );
             DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to reset command buffer");
             (void)err;
-            m_CmdBuffers.pop_front();
+            CmdBuffers.pop_front();
         }
     }
 
@@ -89,7 +91,7 @@ VkCommandBuffer VulkanCommandBufferPool::GetCommandBuffer(const char* DebugName)
         BuffAllocInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
         BuffAllocInfo.pNext              = nullptr;
         BuffAllocInfo.commandPool        = m_CmdPool;
-        BuffAllocInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        BuffAllocInfo.level              = Level;
         BuffAllocInfo.commandBufferCount = 1;
 
         CmdBuffer = m_LogicalDevice->AllocateVkCommandBuffer(BuffAllocInfo);
@@ -103,7 +105,13 @@ VkCommandBuffer VulkanCommandBufferPool::GetCommandBuffer(const char* DebugName)
     CmdBuffBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT; // Each recording of the command buffer will only be
                                                                           // submitted once, and the command buffer will be reset
                                                                           // and recorded again between each submission.
-    CmdBuffBeginInfo.pInheritanceInfo = nullptr;                          // Ignored for a primary command buffer
+    if (pInheritanceInfo != nullptr)
+    {
+        // The secondary command buffer is entirely inside the render pass
+        // that is begun by the primary command buffer executing it
+        CmdBuffBeginInfo.flags |= VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    }
+    CmdBuffBeginInfo.pInheritanceInfo = pInheritanceInfo; // Ignored for a primary command buffer
 
     auto err = vkBeginCommandBuffer(CmdBuffer, &CmdBuffBeginInfo);
     DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to begin command buffer");
@@ -114,10 +122,13 @@ VkCommandBuffer VulkanCommandBufferPool::GetCommandBuffer(const char* DebugName)
     return CmdBuffer;
 }
 
-void VulkanCommandBufferPool::FreeCommandBuffer(VkCommandBuffer&& CmdBuffer)
+void VulkanCommandBufferPool::FreeCommandBuffer(VkCommandBuffer&& CmdBuffer, VkCommandBufferLevel Level)
 {
     std::lock_guard<std::mutex> Lock{m_Mutex};
-    m_CmdBuffers.emplace_back(CmdBuffer);
+    if (Level == VK_COMMAND_BUFFER_LEVEL_PRIMARY)
+        m_CmdBuffers.emplace_back(CmdBuffer);
+    else
+        m_SecondaryCmdBuffers.emplace_back(CmdBuffer);
     CmdBuffer = VK_NULL_HANDLE;
 #ifdef DILIGENT_DEVELOPMENT
     --m_BuffCounter;
@@ -128,6 +139,7 @@ CommandPoolWrapper&& VulkanCommandBufferPool::Release()
 {
     m_LogicalDevice.reset();
     m_CmdBuffers.clear();
+    m_SecondaryCmdBuffers.clear();
     return std::move(m_CmdPool);
 }
 
@@ -26,6 +26,7 @@
  */
 
 #include <vector>
+#include <algorithm>
 #include <cstring>
 #include "VulkanErrors.hpp"
 #include "VulkanUtilities/VulkanInstance.hpp"
@@ -135,6 +136,18 @@ VulkanInstance::VulkanInstance(bool                   EnableValidation,
             LOG_ERROR_AND_THROW("Required extension ", ExtName, " is not available");
     }
 
+    // Extended physical device features (e.g. descriptor indexing) can only be queried through
+    // vkGetPhysicalDeviceFeatures2KHR when Vulkan 1.0 instance is used
+    m_PhysicalDeviceProperties2Enabled = IsExtensionAvailable(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+    if (m_PhysicalDeviceProperties2Enabled)
+    {
+        auto ExtIt = std::find_if(GlobalExtensions.begin(), GlobalExtensions.end(), [](const char* ExtName) {
+            return strcmp(ExtName, VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME) == 0;
+        });
+        if (ExtIt == GlobalExtensions.end())
+            GlobalExtensions.push_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+    }
+
     if (EnableValidation)
     {
         m_DebugUtilsEnabled = IsExtensionAvailable(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
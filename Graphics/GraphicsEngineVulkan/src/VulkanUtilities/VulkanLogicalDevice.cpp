@@ -26,6 +26,7 @@
  */
 
 #include <limits>
+#include <cstring>
 #include "VulkanErrors.hpp"
 #include "VulkanUtilities/VulkanLogicalDevice.hpp"
 #include "VulkanUtilities/VulkanDebug.hpp"
@@ -55,11 +56,61 @@ VulkanLogicalDevice::VulkanLogicalDevice(VkPhysicalDevice             vkPhysical
     auto res = vkCreateDevice(vkPhysicalDevice, &DeviceCI, vkAllocator, &m_VkDevice);
     CHECK_VK_ERROR_AND_THROW(res, "Failed to create logical device");
 
+    if (DeviceCI.pEnabledFeatures != nullptr)
+        m_EnabledFeatures = *DeviceCI.pEnabledFeatures;
+
     m_EnabledGraphicsShaderStages = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-    if (DeviceCI.pEnabledFeatures->geometryShader)
+    if (m_EnabledFeatures.geometryShader)
         m_EnabledGraphicsShaderStages |= VK_PIPELINE_STAGE_GEOMETRY_SHADER_BIT;
-    if (DeviceCI.pEnabledFeatures->tessellationShader)
+    if (m_EnabledFeatures.tessellationShader)
         m_EnabledGraphicsShaderStages |= VK_PIPELINE_STAGE_TESSELLATION_CONTROL_SHADER_BIT | VK_PIPELINE_STAGE_TESSELLATION_EVALUATION_SHADER_BIT;
+
+    bool MemoryRequirements2Enabled = false;
+    bool DedicatedAllocationEnabled = false;
+    for (uint32_t ext = 0; ext < DeviceCI.enabledExtensionCount; ++ext)
+    {
+        if (strcmp(DeviceCI.ppEnabledExtensionNames[ext], VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME) == 0)
+        {
+            m_vkCreateDescriptorUpdateTemplate  = reinterpret_cast<PFN_vkCreateDescriptorUpdateTemplateKHR>(vkGetDeviceProcAddr(m_VkDevice, "vkCreateDescriptorUpdateTemplateKHR"));
+            m_vkDestroyDescriptorUpdateTemplate = reinterpret_cast<PFN_vkDestroyDescriptorUpdateTemplateKHR>(vkGetDeviceProcAddr(m_VkDevice, "vkDestroyDescriptorUpdateTemplateKHR"));
+            m_vkUpdateDescriptorSetWithTemplate = reinterpret_cast<PFN_vkUpdateDescriptorSetWithTemplateKHR>(vkGetDeviceProcAddr(m_VkDevice, "vkUpdateDescriptorSetWithTemplateKHR"));
+            if (m_vkCreateDescriptorUpdateTemplate == nullptr || m_vkDestroyDescriptorUpdateTemplate == nullptr || m_vkUpdateDescriptorSetWithTemplate == nullptr)
+            {
+                LOG_WARNING_MESSAGE("Failed to load ", VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME, " entry points. Descriptor update templates will not be used.");
+                m_vkCreateDescriptorUpdateTemplate  = nullptr;
+                m_vkDestroyDescriptorUpdateTemplate = nullptr;
+                m_vkUpdateDescriptorSetWithTemplate = nullptr;
+            }
+        }
+        else if (strcmp(DeviceCI.ppEnabledExtensionNames[ext], VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME) == 0)
+        {
+            m_DescriptorIndexingEnabled = true;
+        }
+        else if (strcmp(DeviceCI.ppEnabledExtensionNames[ext], VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME) == 0)
+        {
+            MemoryRequirements2Enabled = true;
+        }
+        else if (strcmp(DeviceCI.ppEnabledExtensionNames[ext], VK_KHR_DEDICATED_ALLOCATION_EXTENSION_NAME) == 0)
+        {
+            DedicatedAllocationEnabled = true;
+        }
+        else if (strcmp(DeviceCI.ppEnabledExtensionNames[ext], VK_EXT_MEMORY_BUDGET_EXTENSION_NAME) == 0)
+        {
+            m_MemoryBudgetEnabled = true;
+        }
+    }
+
+    if (MemoryRequirements2Enabled && DedicatedAllocationEnabled)
+    {
+        m_vkGetBufferMemoryRequirements2 = reinterpret_cast<PFN_vkGetBufferMemoryRequirements2KHR>(vkGetDeviceProcAddr(m_VkDevice, "vkGetBufferMemoryRequirements2KHR"));
+        m_vkGetImageMemoryRequirements2  = reinterpret_cast<PFN_vkGetImageMemoryRequirements2KHR>(vkGetDeviceProcAddr(m_VkDevice, "vkGetImageMemoryRequirements2KHR"));
+        if (m_vkGetBufferMemoryRequirements2 == nullptr || m_vkGetImageMemoryRequirements2 == nullptr)
+        {
+            LOG_WARNING_MESSAGE("Failed to load ", VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME, " entry points. Dedicated allocations will only be used for large resources.");
+            m_vkGetBufferMemoryRequirements2 = nullptr;
+            m_vkGetImageMemoryRequirements2  = nullptr;
+        }
+    }
 }
 
 VkQueue VulkanLogicalDevice::GetQueue(uint32_t queueFamilyIndex, uint32_t queueIndex)
@@ -257,6 +308,19 @@ QueryPoolWrapper VulkanLogicalDevice::CreateQueryPool(const VkQueryPoolCreateInf
     return CreateVulkanObject<VkQueryPool, VulkanHandleTypeId::QueryPool>(vkCreateQueryPool, QueryPoolCI, DebugName, "query pool");
 }
 
+PipelineCacheWrapper VulkanLogicalDevice::CreatePipelineCache(const VkPipelineCacheCreateInfo& PipelineCacheCI, const char* DebugName) const
+{
+    VERIFY_EXPR(PipelineCacheCI.sType == VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO);
+    return CreateVulkanObject<VkPipelineCache, VulkanHandleTypeId::PipelineCache>(vkCreatePipelineCache, PipelineCacheCI, DebugName, "pipeline cache");
+}
+
+DescriptorUpdateTemplateWrapper VulkanLogicalDevice::CreateDescriptorUpdateTemplate(const VkDescriptorUpdateTemplateCreateInfoKHR& TemplateCI, const char* DebugName) const
+{
+    VERIFY_EXPR(TemplateCI.sType == VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO_KHR);
+    VERIFY(m_vkCreateDescriptorUpdateTemplate != nullptr, "Descriptor update template extension is not enabled");
+    return CreateVulkanObject<VkDescriptorUpdateTemplateKHR, VulkanHandleTypeId::DescriptorUpdateTemplate>(m_vkCreateDescriptorUpdateTemplate, TemplateCI, DebugName, "descriptor update template");
+}
+
 VkCommandBuffer VulkanLogicalDevice::AllocateVkCommandBuffer(const VkCommandBufferAllocateInfo& AllocInfo, const char* DebugName) const
 {
     VERIFY_EXPR(AllocInfo.sType == VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO);
@@ -398,6 +462,19 @@ void VulkanLogicalDevice::ReleaseVulkanObject(QueryPoolWrapper&& QueryPool) cons
     QueryPool.m_VkObject = VK_NULL_HANDLE;
 }
 
+void VulkanLogicalDevice::ReleaseVulkanObject(PipelineCacheWrapper&& PipelineCache) const
+{
+    vkDestroyPipelineCache(m_VkDevice, PipelineCache.m_VkObject, m_VkAllocator);
+    PipelineCache.m_VkObject = VK_NULL_HANDLE;
+}
+
+void VulkanLogicalDevice::ReleaseVulkanObject(DescriptorUpdateTemplateWrapper&& DescriptorUpdateTemplate) const
+{
+    VERIFY_EXPR(m_vkDestroyDescriptorUpdateTemplate != nullptr);
+    m_vkDestroyDescriptorUpdateTemplate(m_VkDevice, DescriptorUpdateTemplate.m_VkObject, m_VkAllocator);
+    DescriptorUpdateTemplate.m_VkObject = VK_NULL_HANDLE;
+}
+
 void VulkanLogicalDevice::FreeDescriptorSet(VkDescriptorPool Pool, VkDescriptorSet Set) const
 {
     VERIFY_EXPR(Pool != VK_NULL_HANDLE && Set != VK_NULL_HANDLE);
@@ -421,6 +498,44 @@ VkMemoryRequirements VulkanLogicalDevice::GetImageMemoryRequirements(VkImage vkI
     return MemReqs;
 }
 
+VkMemoryRequirements VulkanLogicalDevice::GetBufferMemoryRequirements(VkBuffer vkBuffer, VkMemoryDedicatedRequirementsKHR& DedicatedReqs) const
+{
+    DedicatedReqs       = {};
+    DedicatedReqs.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS_KHR;
+    if (m_vkGetBufferMemoryRequirements2 == nullptr)
+        return GetBufferMemoryRequirements(vkBuffer);
+
+    VkBufferMemoryRequirementsInfo2KHR MemReqsInfo = {};
+    MemReqsInfo.sType                              = VK_STRUCTURE_TYPE_BUFFER_MEMORY_REQUIREMENTS_INFO_2_KHR;
+    MemReqsInfo.buffer                             = vkBuffer;
+
+    VkMemoryRequirements2KHR MemReqs2 = {};
+    MemReqs2.sType                    = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2_KHR;
+    MemReqs2.pNext                    = &DedicatedReqs;
+    m_vkGetBufferMemoryRequirements2(m_VkDevice, &MemReqsInfo, &MemReqs2);
+    DedicatedReqs.pNext = nullptr;
+    return MemReqs2.memoryRequirements;
+}
+
+VkMemoryRequirements VulkanLogicalDevice::GetImageMemoryRequirements(VkImage vkImage, VkMemoryDedicatedRequirementsKHR& DedicatedReqs) const
+{
+    DedicatedReqs       = {};
+    DedicatedReqs.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS_KHR;
+    if (m_vkGetImageMemoryRequirements2 == nullptr)
+        return GetImageMemoryRequirements(vkImage);
+
+    VkImageMemoryRequirementsInfo2KHR MemReqsInfo = {};
+    MemReqsInfo.sType                             = VK_STRUCTURE_TYPE_IMAGE_MEMORY_REQUIREMENTS_INFO_2_KHR;
+    MemReqsInfo.image                             = vkImage;
+
+    VkMemoryRequirements2KHR MemReqs2 = {};
+    MemReqs2.sType                    = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2_KHR;
+    MemReqs2.pNext                    = &DedicatedReqs;
+    m_vkGetImageMemoryRequirements2(m_VkDevice, &MemReqsInfo, &MemReqs2);
+    DedicatedReqs.pNext = nullptr;
+    return MemReqs2.memoryRequirements;
+}
+
 VkResult VulkanLogicalDevice::BindBufferMemory(VkBuffer buffer, VkDeviceMemory memory, VkDeviceSize memoryOffset) const
 {
     return vkBindBufferMemory(m_VkDevice, buffer, memory, memoryOffset);
@@ -479,6 +594,14 @@ void VulkanLogicalDevice::UpdateDescriptorSets(uint32_t                    descr
     vkUpdateDescriptorSets(m_VkDevice, descriptorWriteCount, pDescriptorWrites, descriptorCopyCount, pDescriptorCopies);
 }
 
+void VulkanLogicalDevice::UpdateDescriptorSetWithTemplate(VkDescriptorSet               descriptorSet,
+                                                          VkDescriptorUpdateTemplateKHR descriptorUpdateTemplate,
+                                                          const void*                   pData) const
+{
+    VERIFY(m_vkUpdateDescriptorSetWithTemplate != nullptr, "Descriptor update template extension is not enabled");
+    m_vkUpdateDescriptorSetWithTemplate(m_VkDevice, descriptorSet, descriptorUpdateTemplate, pData);
+}
+
 VkResult VulkanLogicalDevice::ResetCommandPool(VkCommandPool           vkCmdPool,
                                                VkCommandPoolResetFlags flags) const
 {
@@ -487,6 +610,15 @@ VkResult VulkanLogicalDevice::ResetCommandPool(VkCommandPool           vkCmdPool
     return err;
 }
 
+VkResult VulkanLogicalDevice::GetPipelineCacheData(VkPipelineCache pipelineCache,
+                                                   size_t*         pDataSize,
+                                                   void*           pData) const
+{
+    auto err = vkGetPipelineCacheData(m_VkDevice, pipelineCache, pDataSize, pData);
+    DEV_CHECK_ERR(err == VK_SUCCESS || err == VK_INCOMPLETE, "Failed to get pipeline cache data");
+    return err;
+}
+
 VkResult VulkanLogicalDevice::ResetDescriptorPool(VkDescriptorPool           vkDescriptorPool,
                                                   VkDescriptorPoolResetFlags flags) const
 {
@@ -27,6 +27,8 @@
 
 #include "pch.h"
 #include <sstream>
+#include <memory>
+#include <algorithm>
 #include "VulkanUtilities/VulkanMemoryManager.hpp"
 
 namespace VulkanUtilities
@@ -40,27 +42,35 @@ VulkanMemoryAllocation::~VulkanMemoryAllocation()
     }
 }
 
-VulkanMemoryPage::VulkanMemoryPage(VulkanMemoryManager& ParentMemoryMgr,
-                                   VkDeviceSize         PageSize,
-                                   uint32_t             MemoryTypeIndex,
-                                   bool                 IsHostVisible) noexcept :
+VulkanMemoryPage::VulkanMemoryPage(VulkanMemoryManager&                    ParentMemoryMgr,
+                                   VkDeviceSize                            PageSize,
+                                   uint32_t                                MemoryTypeIndex,
+                                   bool                                    IsHostVisible,
+                                   bool                                    IsDedicated,
+                                   const VkMemoryDedicatedAllocateInfoKHR* pDedicatedAllocInfo) noexcept :
     // clang-format off
     m_ParentMemoryMgr{ParentMemoryMgr},
-    m_AllocationMgr  {static_cast<AllocationsMgrOffsetType>(PageSize), ParentMemoryMgr.m_Allocator}
+    m_MemoryTypeIndex{MemoryTypeIndex},
+    m_IsDedicated    {IsDedicated    }
 // clang-format on
 {
     VERIFY(PageSize <= std::numeric_limits<AllocationsMgrOffsetType>::max(),
            "PageSize (", PageSize, ") exceeds maximum allowed value ",
            std::numeric_limits<AllocationsMgrOffsetType>::max());
 
+    if (ParentMemoryMgr.m_UseTLSFPageAllocator)
+        m_TLSFAllocationMgr.reset(new Diligent::TLSFAllocationsManager{static_cast<AllocationsMgrOffsetType>(PageSize), ParentMemoryMgr.m_Allocator});
+    else
+        m_VarSizeAllocationMgr.reset(new Diligent::VariableSizeAllocationsManager{static_cast<AllocationsMgrOffsetType>(PageSize), ParentMemoryMgr.m_Allocator});
+
     VkMemoryAllocateInfo MemAlloc = {};
 
-    MemAlloc.pNext           = nullptr;
+    MemAlloc.pNext           = pDedicatedAllocInfo;
     MemAlloc.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
     MemAlloc.allocationSize  = PageSize;
     MemAlloc.memoryTypeIndex = MemoryTypeIndex;
 
-    auto MemoryName = Diligent::FormatString("Device memory page. Size: ", Diligent::FormatMemorySize(PageSize, 2), ", type: ", MemoryTypeIndex);
+    auto MemoryName = Diligent::FormatString(IsDedicated ? "Dedicated device memory. Size: " : "Device memory page. Size: ", Diligent::FormatMemorySize(PageSize, 2), ", type: ", MemoryTypeIndex);
     m_VkMemory      = ParentMemoryMgr.m_LogicalDevice.AllocateDeviceMemory(MemAlloc, MemoryName.c_str());
 
     if (IsHostVisible)
@@ -88,11 +98,12 @@ VulkanMemoryPage::~VulkanMemoryPage()
 
 VulkanMemoryAllocation VulkanMemoryPage::Allocate(VkDeviceSize size, VkDeviceSize alignment)
 {
-    std::lock_guard<std::mutex> Lock{m_Mutex};
     VERIFY(size <= std::numeric_limits<AllocationsMgrOffsetType>::max(),
            "Allocation size (", size, ") exceeds maximum allowed value ",
            std::numeric_limits<AllocationsMgrOffsetType>::max());
-    auto Allocation = m_AllocationMgr.Allocate(static_cast<AllocationsMgrOffsetType>(size), static_cast<AllocationsMgrOffsetType>(alignment));
+    const auto Size       = static_cast<AllocationsMgrOffsetType>(size);
+    const auto Alignment  = static_cast<AllocationsMgrOffsetType>(alignment);
+    auto       Allocation = m_TLSFAllocationMgr ? m_TLSFAllocationMgr->Allocate(Size, Alignment) : m_VarSizeAllocationMgr->Allocate(Size, Alignment);
     if (Allocation.IsValid())
     {
         // Offset may not necessarily be aligned, but the allocation is guaranteed to be large enough
@@ -108,20 +119,34 @@ VulkanMemoryAllocation VulkanMemoryPage::Allocate(VkDeviceSize size, VkDeviceSiz
 
 void VulkanMemoryPage::Free(VulkanMemoryAllocation&& Allocation)
 {
-    m_ParentMemoryMgr.OnFreeAllocation(Allocation.Size, m_CPUMemory != nullptr);
-    std::lock_guard<std::mutex> Lock{m_Mutex};
     VERIFY_EXPR(Allocation.UnalignedOffset <= std::numeric_limits<AllocationsMgrOffsetType>::max());
     VERIFY_EXPR(Allocation.Size <= std::numeric_limits<AllocationsMgrOffsetType>::max());
-    m_AllocationMgr.Free(static_cast<AllocationsMgrOffsetType>(Allocation.UnalignedOffset), static_cast<AllocationsMgrOffsetType>(Allocation.Size));
-    Allocation = VulkanMemoryAllocation{};
+    const auto UnalignedOffset = Allocation.UnalignedOffset;
+    const auto Size            = Allocation.Size;
+    Allocation                 = VulkanMemoryAllocation{};
+    // Dedicated page is destroyed by the manager, so this must be the last statement
+    m_ParentMemoryMgr.OnFreeAllocation(*this, UnalignedOffset, Size);
 }
 
-VulkanMemoryAllocation VulkanMemoryManager::Allocate(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProps)
+void VulkanMemoryPage::FreeRange(AllocationsMgrOffsetType Offset, AllocationsMgrOffsetType Size)
+{
+    if (m_TLSFAllocationMgr)
+        m_TLSFAllocationMgr->Free(Offset, Size);
+    else
+        m_VarSizeAllocationMgr->Free(Offset, Size);
+}
+
+VkDeviceSize VulkanMemoryPage::GetMaxFreeBlockSize() const
+{
+    return m_TLSFAllocationMgr ? m_TLSFAllocationMgr->GetMaxFreeBlockSize() : m_VarSizeAllocationMgr->GetMaxFreeBlockSize();
+}
+
+uint32_t VulkanMemoryManager::FindMemoryTypeIndex(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProps) const
 {
     // memoryTypeBits is a bitmask and contains one bit set for every supported memory type for the resource.
     // Bit i is set if and only if the memory type i in the VkPhysicalDeviceMemoryProperties structure for the
     // physical device is supported for the resource.
-    auto MemoryTypeIndex = m_PhysicalDevice.GetMemoryTypeIndex(MemReqs.memoryTypeBits, MemoryProps);
+    const auto MemoryTypeIndex = m_PhysicalDevice.GetMemoryTypeIndex(MemReqs.memoryTypeBits, MemoryProps);
     if (MemoryProps == VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)
     {
         // There must be at least one memory type with the DEVICE_LOCAL_BIT bit set
@@ -144,14 +169,103 @@ VulkanMemoryAllocation VulkanMemoryManager::Allocate(const VkMemoryRequirements&
         LOG_ERROR_AND_THROW("Failed to find suitable device memory type for a buffer");
     }
 
-    bool HostVisible = (MemoryProps & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0;
+    return MemoryTypeIndex;
+}
+
+VulkanMemoryAllocation VulkanMemoryManager::Allocate(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProps)
+{
+    const auto MemoryTypeIndex = FindMemoryTypeIndex(MemReqs, MemoryProps);
+    const bool HostVisible     = (MemoryProps & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0;
     return Allocate(MemReqs.size, MemReqs.alignment, MemoryTypeIndex, HostVisible);
 }
 
-VulkanMemoryAllocation VulkanMemoryManager::Allocate(VkDeviceSize Size, VkDeviceSize Alignment, uint32_t MemoryTypeIndex, bool HostVisible)
+VulkanMemoryAllocation VulkanMemoryManager::Allocate(const VkMemoryRequirements&             MemReqs,
+                                                     VkMemoryPropertyFlags                   MemoryProps,
+                                                     const VkMemoryDedicatedRequirementsKHR& DedicatedReqs,
+                                                     VkBuffer                                vkBuffer,
+                                                     VkImage                                 vkImage)
+{
+    VERIFY((vkBuffer != VK_NULL_HANDLE) != (vkImage != VK_NULL_HANDLE), "Exactly one of vkBuffer and vkImage must not be null");
+
+    const auto MemoryTypeIndex = FindMemoryTypeIndex(MemReqs, MemoryProps);
+    const bool HostVisible     = (MemoryProps & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0;
+
+    // Dedicated requirements are only reported when VK_KHR_dedicated_allocation is enabled.
+    // Drivers typically prefer dedicated allocations for render targets and large images to enable
+    // optimizations such as compression, and require them for some imported resources.
+    if (DedicatedReqs.requiresDedicatedAllocation != VK_FALSE || DedicatedReqs.prefersDedicatedAllocation != VK_FALSE)
+    {
+        VkMemoryDedicatedAllocateInfoKHR DedicatedAllocInfo = {};
+
+        DedicatedAllocInfo.sType  = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO_KHR;
+        DedicatedAllocInfo.pNext  = nullptr;
+        DedicatedAllocInfo.buffer = vkBuffer;
+        DedicatedAllocInfo.image  = vkImage;
+        return AllocateDedicated(MemReqs.size, MemoryTypeIndex, HostVisible, &DedicatedAllocInfo);
+    }
+
+    return Allocate(MemReqs.size, MemReqs.alignment, MemoryTypeIndex, HostVisible);
+}
+
+static void UpdatePeakValue(std::atomic<VkDeviceSize>& PeakValue, VkDeviceSize CurrValue)
+{
+    auto PrevPeak = PeakValue.load();
+    while (PrevPeak < CurrValue && !PeakValue.compare_exchange_weak(PrevPeak, CurrValue))
+    {
+    }
+}
+
+void VulkanMemoryManager::UpdateFreeBlockIndex(MemoryTypeShard& Shard, VulkanMemoryPage& Page)
+{
+    Shard.PagesByFreeBlockSize.Update(Page, Page.GetMaxFreeBlockSize(), Page.m_FreeBlockIndexHandle);
+}
+
+VulkanMemoryAllocation VulkanMemoryManager::AllocateFromShard(MemoryTypeShard& Shard, VkDeviceSize Size, VkDeviceSize Alignment)
 {
     VulkanMemoryAllocation Allocation;
 
+    // Take the page with the smallest largest free block that may accommodate the allocation.
+    // Best fit leaves empty pages untouched for as long as possible so that ShrinkMemory() can release them.
+    const auto AlignedSize = Diligent::Align(Size, Alignment);
+
+    if (auto* pPage = Shard.PagesByFreeBlockSize.FindBestFit(AlignedSize))
+    {
+        Allocation = pPage->Allocate(Size, Alignment);
+        if (Allocation.Page == nullptr && Alignment > 1)
+        {
+            // The block is too small to accommodate the alignment padding.
+            // Any block that is at least AlignedSize + Alignment - 1 bytes large is guaranteed to fit.
+            pPage = Shard.PagesByFreeBlockSize.FindBestFit(AlignedSize + Alignment - 1);
+            if (pPage != nullptr)
+            {
+                Allocation = pPage->Allocate(Size, Alignment);
+                VERIFY_EXPR(Allocation.Page != nullptr);
+            }
+        }
+    }
+
+    if (Allocation.Page != nullptr)
+        UpdateFreeBlockIndex(Shard, *Allocation.Page);
+
+    return Allocation;
+}
+
+void VulkanMemoryManager::OnNewAllocation(const VulkanMemoryAllocation& Allocation, bool HostVisible)
+{
+    const size_t stat_ind     = HostVisible ? 1 : 0;
+    const auto   CurrUsedSize = m_CurrUsedSize[stat_ind].fetch_add(Allocation.Size) + static_cast<int64_t>(Allocation.Size);
+    UpdatePeakValue(m_PeakUsedSize[stat_ind], static_cast<VkDeviceSize>(CurrUsedSize));
+
+    m_Heaps[GetHeapIndex(Allocation.Page->GetMemoryTypeIndex())].UsedSize.fetch_add(Allocation.Size);
+}
+
+VulkanMemoryAllocation VulkanMemoryManager::Allocate(VkDeviceSize Size, VkDeviceSize Alignment, uint32_t MemoryTypeIndex, bool HostVisible)
+{
+    const auto PageSize = HostVisible ? m_HostVisiblePageSize : m_DeviceLocalPageSize;
+    // Large allocations would leave most of the page unusable, so they get their own memory object
+    if (Size > PageSize / 2)
+        return AllocateDedicated(Size, MemoryTypeIndex, HostVisible, nullptr);
+
     // On integrated GPUs, there is no difference between host-visible and GPU-only
     // memory, so MemoryTypeIndex is the same. As GPU-only pages do not have CPU address,
     // we need to use HostVisible flag to differentiate the two.
@@ -159,96 +273,263 @@ VulkanMemoryAllocation VulkanMemoryManager::Allocate(VkDeviceSize Size, VkDevice
     // even though on integrated GPUs same pages can be used for both GPU-only and staging
     // allocations. Staging allocations are short-living and will be released when upload is
     // complete, while GPU-only allocations are expected to be long-living.
-    MemoryPageIndex             PageIdx{MemoryTypeIndex, HostVisible};
-    std::lock_guard<std::mutex> Lock{m_PagesMtx};
+    auto& Shard = GetShard(MemoryTypeIndex, HostVisible);
 
-    auto range = m_Pages.equal_range(PageIdx);
-    for (auto page_it = range.first; page_it != range.second; ++page_it)
+    VulkanMemoryAllocation Allocation;
     {
-        Allocation = page_it->second.Allocate(Size, Alignment);
-        if (Allocation.Page != nullptr)
-            break;
+        std::lock_guard<std::mutex> Lock{Shard.Mtx};
+        Allocation = AllocateFromShard(Shard, Size, Alignment);
     }
 
-    size_t stat_ind = HostVisible ? 1 : 0;
     if (Allocation.Page == nullptr)
     {
-        auto PageSize = HostVisible ? m_HostVisiblePageSize : m_DeviceLocalPageSize;
-        while (PageSize < Size)
-            PageSize *= 2;
+        // Empty pages of this shard would have been used, but other memory types may share the heap
+        EnsureBudget(GetHeapIndex(MemoryTypeIndex), PageSize);
 
-        m_CurrAllocatedSize[stat_ind] += PageSize;
-        m_PeakAllocatedSize[stat_ind] = std::max(m_PeakAllocatedSize[stat_ind], m_CurrAllocatedSize[stat_ind]);
+        std::lock_guard<std::mutex> Lock{Shard.Mtx};
 
-        auto it = m_Pages.emplace(PageIdx, VulkanMemoryPage{*this, PageSize, MemoryTypeIndex, HostVisible});
-        LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': created new ", (HostVisible ? "host-visible" : "device-local"),
-                         " page. (", Diligent::FormatMemorySize(PageSize, 2), ", type idx: ", MemoryTypeIndex,
-                         "). Current allocated size: ", Diligent::FormatMemorySize(m_CurrAllocatedSize[stat_ind], 2));
-        OnNewPageCreated(it->second);
-        Allocation = it->second.Allocate(Size, Alignment);
-        DEV_CHECK_ERR(Allocation.Page != nullptr, "Failed to allocate new memory page");
+        // Another thread may have created a new page while the mutex was released
+        Allocation = AllocateFromShard(Shard, Size, Alignment);
+        if (Allocation.Page == nullptr)
+        {
+            size_t     stat_ind          = HostVisible ? 1 : 0;
+            const auto CurrAllocatedSize = m_CurrAllocatedSize[stat_ind].fetch_add(PageSize) + PageSize;
+            UpdatePeakValue(m_PeakAllocatedSize[stat_ind], CurrAllocatedSize);
+
+            auto& Heap = m_Heaps[GetHeapIndex(MemoryTypeIndex)];
+            Heap.AllocatedSize.fetch_add(PageSize);
+            Heap.NumPages.fetch_add(1);
+
+            Shard.Pages.emplace_back(*this, PageSize, MemoryTypeIndex, HostVisible);
+            auto& NewPage                  = Shard.Pages.back();
+            NewPage.m_FreeBlockIndexHandle = Shard.PagesByFreeBlockSize.NullHandle();
+            LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': created new ", (HostVisible ? "host-visible" : "device-local"),
+                             " page. (", Diligent::FormatMemorySize(PageSize, 2), ", type idx: ", MemoryTypeIndex,
+                             "). Current allocated size: ", Diligent::FormatMemorySize(CurrAllocatedSize, 2));
+            OnNewPageCreated(NewPage);
+            Allocation = NewPage.Allocate(Size, Alignment);
+            DEV_CHECK_ERR(Allocation.Page != nullptr, "Failed to allocate new memory page");
+            UpdateFreeBlockIndex(Shard, NewPage);
+        }
     }
 
     if (Allocation.Page != nullptr)
     {
         VERIFY_EXPR(Size + Diligent::Align(Allocation.UnalignedOffset, Alignment) - Allocation.UnalignedOffset <= Allocation.Size);
+        OnNewAllocation(Allocation, HostVisible);
     }
 
-    m_CurrUsedSize[stat_ind].fetch_add(Allocation.Size);
-    m_PeakUsedSize[stat_ind] = std::max(m_PeakUsedSize[stat_ind], static_cast<VkDeviceSize>(m_CurrUsedSize[stat_ind].load()));
+    return Allocation;
+}
+
+VulkanMemoryAllocation VulkanMemoryManager::AllocateDedicated(VkDeviceSize                            Size,
+                                                              uint32_t                                MemoryTypeIndex,
+                                                              bool                                    HostVisible,
+                                                              const VkMemoryDedicatedAllocateInfoKHR* pDedicatedAllocInfo)
+{
+    const auto HeapIndex = GetHeapIndex(MemoryTypeIndex);
+    EnsureBudget(HeapIndex, Size);
+
+    // Dedicated pages are not cached; the page is destroyed when its only allocation is released
+    std::unique_ptr<VulkanMemoryPage> pPage{new VulkanMemoryPage{*this, Size, MemoryTypeIndex, HostVisible, true, pDedicatedAllocInfo}};
+
+    auto& Heap = m_Heaps[HeapIndex];
+    Heap.AllocatedSize.fetch_add(Size);
+    Heap.NumDedicatedAllocations.fetch_add(1);
+    OnNewPageCreated(*pPage);
+
+    auto Allocation = pPage->Allocate(Size, 1);
+    DEV_CHECK_ERR(Allocation.Page == pPage.get(), "Failed to allocate dedicated memory");
+    pPage.release();
 
+    OnNewAllocation(Allocation, HostVisible);
     return Allocation;
 }
 
-void VulkanMemoryManager::ShrinkMemory()
+void VulkanMemoryManager::ReleaseEmptyPages(size_t ShardIdx, bool KeepReserve)
 {
-    std::lock_guard<std::mutex> Lock{m_PagesMtx};
-    if (m_CurrAllocatedSize[0] <= m_DeviceLocalReserveSize && m_CurrAllocatedSize[1] <= m_HostVisibleReserveSize)
+    const bool IsHostVisible     = (ShardIdx & 0x01) != 0;
+    const auto ReserveSize       = KeepReserve ? (IsHostVisible ? m_HostVisibleReserveSize : m_DeviceLocalReserveSize) : 0;
+    auto&      CurrAllocatedSize = m_CurrAllocatedSize[IsHostVisible ? 1 : 0];
+    if (CurrAllocatedSize.load() <= ReserveSize)
         return;
 
-    auto it = m_Pages.begin();
-    while (it != m_Pages.end())
+    auto&                       Shard = m_Shards[ShardIdx];
+    std::lock_guard<std::mutex> Lock{Shard.Mtx};
+
+    auto it = Shard.Pages.begin();
+    while (it != Shard.Pages.end())
     {
-        auto curr_it = it;
-        ++it;
-        auto& Page          = curr_it->second;
-        bool  IsHostVisible = Page.GetCPUMemory() != nullptr;
-        auto  ReserveSize   = IsHostVisible ? m_HostVisibleReserveSize : m_DeviceLocalReserveSize;
-        if (Page.IsEmpty() && m_CurrAllocatedSize[IsHostVisible ? 1 : 0] > ReserveSize)
+        auto& Page = *it;
+        if (Page.IsEmpty() && CurrAllocatedSize.load() > ReserveSize)
         {
             auto PageSize = Page.GetPageSize();
-            m_CurrAllocatedSize[IsHostVisible ? 1 : 0] -= PageSize;
+            CurrAllocatedSize.fetch_sub(PageSize);
+
+            auto& Heap = m_Heaps[GetHeapIndex(Page.GetMemoryTypeIndex())];
+            Heap.AllocatedSize.fetch_sub(PageSize);
+            Heap.NumPages.fetch_sub(1);
+
             LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': destroying ", (IsHostVisible ? "host-visible" : "device-local"),
                              " page (", Diligent::FormatMemorySize(PageSize, 2),
                              "). Current allocated size: ",
-                             Diligent::FormatMemorySize(m_CurrAllocatedSize[IsHostVisible ? 1 : 0], 2));
+                             Diligent::FormatMemorySize(CurrAllocatedSize.load(), 2));
             OnPageDestroy(Page);
-            m_Pages.erase(curr_it);
+            Shard.PagesByFreeBlockSize.Remove(Page.m_FreeBlockIndexHandle);
+            it = Shard.Pages.erase(it);
         }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void VulkanMemoryManager::ShrinkMemory()
+{
+    UpdateMemoryBudget();
+
+    for (size_t ShardIdx = 0; ShardIdx < m_Shards.size(); ++ShardIdx)
+    {
+        const auto HeapIndex = GetHeapIndex(static_cast<uint32_t>(ShardIdx / 2));
+        ReleaseEmptyPages(ShardIdx, !IsBudgetTight(HeapIndex));
     }
 }
 
-void VulkanMemoryManager::OnFreeAllocation(VkDeviceSize Size, bool IsHostVisble)
+void VulkanMemoryManager::EnsureBudget(uint32_t HeapIndex, VkDeviceSize Size)
 {
-    m_CurrUsedSize[IsHostVisble ? 1 : 0].fetch_add(-static_cast<int64_t>(Size));
+    {
+        auto&                       Heap = m_Heaps[HeapIndex];
+        std::lock_guard<std::mutex> Lock{m_BudgetMtx};
+        if (GetEstimatedUsage(Heap) + Size <= Heap.Budget)
+            return;
+    }
+
+    for (size_t ShardIdx = 0; ShardIdx < m_Shards.size(); ++ShardIdx)
+    {
+        if (GetHeapIndex(static_cast<uint32_t>(ShardIdx / 2)) == HeapIndex)
+            ReleaseEmptyPages(ShardIdx, false);
+    }
+}
+
+bool VulkanMemoryManager::IsBudgetTight(uint32_t HeapIndex)
+{
+    auto&                       Heap = m_Heaps[HeapIndex];
+    std::lock_guard<std::mutex> Lock{m_BudgetMtx};
+    return GetEstimatedUsage(Heap) > Heap.Budget / 10 * 9;
+}
+
+VkDeviceSize VulkanMemoryManager::GetEstimatedUsage(const HeapInfo& Heap) const
+{
+    // The usage reported by the driver does not reflect the memory allocated or released since the last query
+    const VkDeviceSize AllocatedSize = Heap.AllocatedSize.load();
+    if (AllocatedSize >= Heap.AllocatedSizeAtQuery)
+        return Heap.Usage + (AllocatedSize - Heap.AllocatedSizeAtQuery);
+    else
+        return Heap.Usage - std::min(Heap.Usage, Heap.AllocatedSizeAtQuery - AllocatedSize);
+}
+
+void VulkanMemoryManager::UpdateMemoryBudget()
+{
+    const bool BudgetEnabled = m_LogicalDevice.IsMemoryBudgetEnabled() && m_PhysicalDevice.IsMemoryBudgetSupported();
+
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT MemoryBudget = {};
+    if (BudgetEnabled)
+        m_PhysicalDevice.GetMemoryBudget(MemoryBudget);
+
+    const auto& MemoryProps = m_PhysicalDevice.GetMemoryProperties();
+
+    std::lock_guard<std::mutex> Lock{m_BudgetMtx};
+    for (uint32_t HeapIndex = 0; HeapIndex < m_Heaps.size(); ++HeapIndex)
+    {
+        auto& Heap                = m_Heaps[HeapIndex];
+        Heap.AllocatedSizeAtQuery = Heap.AllocatedSize.load();
+        if (BudgetEnabled)
+        {
+            Heap.Budget = MemoryBudget.heapBudget[HeapIndex];
+            Heap.Usage  = MemoryBudget.heapUsage[HeapIndex];
+        }
+        else
+        {
+            // Without the extension, only the memory allocated by this manager is known. Leave 20% of the heap to
+            // other allocations and the system.
+            Heap.Budget = MemoryProps.memoryHeaps[HeapIndex].size / 10 * 8;
+            Heap.Usage  = Heap.AllocatedSizeAtQuery;
+        }
+    }
+}
+
+void VulkanMemoryManager::GetHeapStats(uint32_t HeapIndex, VulkanMemoryHeapStats& Stats)
+{
+    VERIFY_EXPR(HeapIndex < m_Heaps.size());
+    UpdateMemoryBudget();
+
+    const auto& HeapProps = m_PhysicalDevice.GetMemoryProperties().memoryHeaps[HeapIndex];
+    auto&       Heap      = m_Heaps[HeapIndex];
+
+    Stats.HeapSize                = HeapProps.size;
+    Stats.AllocatedSize           = Heap.AllocatedSize.load();
+    Stats.UsedSize                = Heap.UsedSize.load();
+    Stats.NumPages                = Heap.NumPages.load();
+    Stats.NumDedicatedAllocations = Heap.NumDedicatedAllocations.load();
+    Stats.IsDeviceLocal           = (HeapProps.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+    Stats.IsBudgetReported        = m_LogicalDevice.IsMemoryBudgetEnabled() && m_PhysicalDevice.IsMemoryBudgetSupported();
+
+    std::lock_guard<std::mutex> Lock{m_BudgetMtx};
+    Stats.Budget = Heap.Budget;
+    Stats.Usage  = GetEstimatedUsage(Heap);
+}
+
+void VulkanMemoryManager::OnFreeAllocation(VulkanMemoryPage& Page, VkDeviceSize UnalignedOffset, VkDeviceSize Size)
+{
+    using OffsetType = VulkanMemoryPage::AllocationsMgrOffsetType;
+
+    const bool IsHostVisible = Page.GetCPUMemory() != nullptr;
+    auto&      Heap          = m_Heaps[GetHeapIndex(Page.GetMemoryTypeIndex())];
+    if (Page.IsDedicated())
+    {
+        // The page only contains this allocation, so no synchronization is required
+        Page.FreeRange(static_cast<OffsetType>(UnalignedOffset), static_cast<OffsetType>(Size));
+        Heap.AllocatedSize.fetch_sub(Page.GetPageSize());
+        Heap.NumDedicatedAllocations.fetch_sub(1);
+        OnPageDestroy(Page);
+        delete &Page;
+    }
+    else
+    {
+        auto&                       Shard = GetShard(Page.GetMemoryTypeIndex(), IsHostVisible);
+        std::lock_guard<std::mutex> Lock{Shard.Mtx};
+        Page.FreeRange(static_cast<OffsetType>(UnalignedOffset), static_cast<OffsetType>(Size));
+        UpdateFreeBlockIndex(Shard, Page);
+    }
+    Heap.UsedSize.fetch_sub(Size);
+    m_CurrUsedSize[IsHostVisible ? 1 : 0].fetch_add(-static_cast<int64_t>(Size));
 }
 
 VulkanMemoryManager::~VulkanMemoryManager()
 {
-    auto PeakDeviceLocalPages  = m_PeakAllocatedSize[0] / m_DeviceLocalPageSize;
-    auto PeakHostVisisblePages = m_PeakAllocatedSize[1] / m_HostVisiblePageSize;
+    const VkDeviceSize PeakUsedSize[]      = {m_PeakUsedSize[0].load(), m_PeakUsedSize[1].load()};
+    const VkDeviceSize PeakAllocatedSize[] = {m_PeakAllocatedSize[0].load(), m_PeakAllocatedSize[1].load()};
+
+    auto PeakDeviceLocalPages  = PeakAllocatedSize[0] / m_DeviceLocalPageSize;
+    auto PeakHostVisisblePages = PeakAllocatedSize[1] / m_HostVisiblePageSize;
     LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "' stats:\n"
                                                          "                       Peak used/allocated device-local memory size: ",
-                     Diligent::FormatMemorySize(m_PeakUsedSize[0], 2, m_PeakAllocatedSize[0]), " / ",
-                     Diligent::FormatMemorySize(m_PeakAllocatedSize[0], 2, m_PeakAllocatedSize[0]),
+                     Diligent::FormatMemorySize(PeakUsedSize[0], 2, PeakAllocatedSize[0]), " / ",
+                     Diligent::FormatMemorySize(PeakAllocatedSize[0], 2, PeakAllocatedSize[0]),
                      " (", PeakDeviceLocalPages, (PeakDeviceLocalPages == 1 ? " page)" : " pages)"),
                      "\n                       Peak used/allocated host-visible memory size: ",
-                     Diligent::FormatMemorySize(m_PeakUsedSize[1], 2, m_PeakAllocatedSize[1]), " / ",
-                     Diligent::FormatMemorySize(m_PeakAllocatedSize[1], 2, m_PeakAllocatedSize[1]),
+                     Diligent::FormatMemorySize(PeakUsedSize[1], 2, PeakAllocatedSize[1]), " / ",
+                     Diligent::FormatMemorySize(PeakAllocatedSize[1], 2, PeakAllocatedSize[1]),
                      " (", PeakHostVisisblePages, (PeakHostVisisblePages == 1 ? " page)" : " pages)"));
 
-    for (auto it = m_Pages.begin(); it != m_Pages.end(); ++it)
-        VERIFY(it->second.IsEmpty(), "The page contains outstanding allocations");
+#ifdef DILIGENT_DEBUG
+    for (const auto& Shard : m_Shards)
+    {
+        for (const auto& Page : Shard.Pages)
+            VERIFY(Page.IsEmpty(), "The page contains outstanding allocations");
+    }
+#endif
     VERIFY(m_CurrUsedSize[0] == 0 && m_CurrUsedSize[1] == 0, "Not all allocations have been released");
 }
 
@@ -29,17 +29,18 @@
 #include <cstring>
 #include "VulkanErrors.hpp"
 #include "VulkanUtilities/VulkanPhysicalDevice.hpp"
+#include "VulkanUtilities/VulkanInstance.hpp"
 
 namespace VulkanUtilities
 {
 
-std::unique_ptr<VulkanPhysicalDevice> VulkanPhysicalDevice::Create(VkPhysicalDevice vkDevice)
+std::unique_ptr<VulkanPhysicalDevice> VulkanPhysicalDevice::Create(VkPhysicalDevice vkDevice, const VulkanInstance& Instance)
 {
-    auto* PhysicalDevice = new VulkanPhysicalDevice{vkDevice};
+    auto* PhysicalDevice = new VulkanPhysicalDevice{vkDevice, Instance};
     return std::unique_ptr<VulkanPhysicalDevice>{PhysicalDevice};
 }
 
-VulkanPhysicalDevice::VulkanPhysicalDevice(VkPhysicalDevice vkDevice) :
+VulkanPhysicalDevice::VulkanPhysicalDevice(VkPhysicalDevice vkDevice, const VulkanInstance& Instance) :
     m_VkDevice{vkDevice}
 {
     VERIFY_EXPR(m_VkDevice != VK_NULL_HANDLE);
@@ -65,6 +66,49 @@ VulkanPhysicalDevice::VulkanPhysicalDevice(VkPhysicalDevice vkDevice) :
         (void)res;
         VERIFY_EXPR(ExtensionCount == m_SupportedExtensions.size());
     }
+
+    m_DescriptorIndexingFeatures.sType   = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+    m_DescriptorIndexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT;
+    if (Instance.IsPhysicalDeviceProperties2Enabled() && IsExtensionSupported(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME))
+    {
+        auto vkInstance                        = Instance.GetVkInstance();
+        auto vkGetPhysicalDeviceFeatures2KHR   = reinterpret_cast<PFN_vkGetPhysicalDeviceFeatures2KHR>(vkGetInstanceProcAddr(vkInstance, "vkGetPhysicalDeviceFeatures2KHR"));
+        auto vkGetPhysicalDeviceProperties2KHR = reinterpret_cast<PFN_vkGetPhysicalDeviceProperties2KHR>(vkGetInstanceProcAddr(vkInstance, "vkGetPhysicalDeviceProperties2KHR"));
+        if (vkGetPhysicalDeviceFeatures2KHR != nullptr && vkGetPhysicalDeviceProperties2KHR != nullptr)
+        {
+            VkPhysicalDeviceFeatures2KHR Features2 = {};
+            Features2.sType                        = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+            Features2.pNext                        = &m_DescriptorIndexingFeatures;
+            vkGetPhysicalDeviceFeatures2KHR(m_VkDevice, &Features2);
+            m_DescriptorIndexingFeatures.pNext = nullptr;
+
+            VkPhysicalDeviceProperties2KHR Properties2 = {};
+            Properties2.sType                          = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR;
+            Properties2.pNext                          = &m_DescriptorIndexingProperties;
+            vkGetPhysicalDeviceProperties2KHR(m_VkDevice, &Properties2);
+            m_DescriptorIndexingProperties.pNext = nullptr;
+        }
+    }
+
+    if (Instance.IsPhysicalDeviceProperties2Enabled() && IsExtensionSupported(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME))
+    {
+        m_vkGetPhysicalDeviceMemoryProperties2 = reinterpret_cast<PFN_vkGetPhysicalDeviceMemoryProperties2KHR>(
+            vkGetInstanceProcAddr(Instance.GetVkInstance(), "vkGetPhysicalDeviceMemoryProperties2KHR"));
+    }
+}
+
+void VulkanPhysicalDevice::GetMemoryBudget(VkPhysicalDeviceMemoryBudgetPropertiesEXT& MemoryBudget) const
+{
+    VERIFY(IsMemoryBudgetSupported(), "VK_EXT_memory_budget is not supported");
+
+    MemoryBudget       = {};
+    MemoryBudget.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+
+    VkPhysicalDeviceMemoryProperties2KHR MemoryProperties2 = {};
+    MemoryProperties2.sType                                = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2_KHR;
+    MemoryProperties2.pNext                                = &MemoryBudget;
+    m_vkGetPhysicalDeviceMemoryProperties2(m_VkDevice, &MemoryProperties2);
+    MemoryBudget.pNext = nullptr;
 }
 
 uint32_t VulkanPhysicalDevice::FindQueueFamily(VkQueueFlags QueueFlags) const
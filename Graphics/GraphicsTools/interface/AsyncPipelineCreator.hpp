@@ -0,0 +1,99 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::AsyncPipelineCreator class
+
+#include <vector>
+#include <future>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/ThreadPool.hpp"
+
+namespace Diligent
+{
+
+/// Creates shaders and pipeline states on a pool of worker threads.
+
+/// Shader compilation and pipeline creation are independent for every object, so
+/// loading a large set of shaders and pipelines scales with the number of cores.
+/// If the device does not support multithreaded resource creation (see
+/// DeviceFeatures::MultithreadedResourceCreation), all objects are created
+/// synchronously on the calling thread and the returned futures are ready immediately.
+///
+/// \note   All memory referenced by the create info structures (source code, macros,
+///         file paths, resource layout arrays, etc.) as well as the shaders referenced by
+///         the pipeline state create info must stay valid until the corresponding future is ready.
+class AsyncPipelineCreator
+{
+public:
+    using ShaderFuture        = std::future<RefCntAutoPtr<IShader>>;
+    using PipelineStateFuture = std::future<RefCntAutoPtr<IPipelineState>>;
+
+    /// \param [in] pDevice    - Render device.
+    /// \param [in] NumThreads - Number of worker threads. If 0, the number of threads is
+    ///                          selected based on the number of hardware threads.
+    explicit AsyncPipelineCreator(IRenderDevice* pDevice, Uint32 NumThreads = 0);
+
+    // clang-format off
+    AsyncPipelineCreator           (const AsyncPipelineCreator&) = delete;
+    AsyncPipelineCreator           (AsyncPipelineCreator&&)      = delete;
+    AsyncPipelineCreator& operator=(const AsyncPipelineCreator&) = delete;
+    AsyncPipelineCreator& operator=(AsyncPipelineCreator&&)      = delete;
+    // clang-format on
+
+    /// Waits for all pending objects to be created.
+    ~AsyncPipelineCreator();
+
+    /// Enqueues shader creation. The future holds null if the shader could not be created.
+    ShaderFuture CreateShader(const ShaderCreateInfo& ShaderCI);
+
+    /// Enqueues creation of NumShaders shaders and returns one future per shader.
+    std::vector<ShaderFuture> CreateShaders(const ShaderCreateInfo* pShaderCIs, Uint32 NumShaders);
+
+    /// Enqueues pipeline state creation. The future holds null if the pipeline state could not be created.
+    PipelineStateFuture CreatePipelineState(const PipelineStateCreateInfo& PSOCreateInfo);
+
+    /// Enqueues creation of NumPSOs pipeline states and returns one future per pipeline state.
+    std::vector<PipelineStateFuture> CreatePipelineStates(const PipelineStateCreateInfo* pPSOCreateInfos, Uint32 NumPSOs);
+
+    /// Blocks until all objects enqueued so far are created.
+    void WaitForIdle();
+
+    /// Returns the number of worker threads. Zero means that objects are created synchronously.
+    Uint32 GetNumThreads() const { return static_cast<Uint32>(m_ThreadPool.GetNumThreads()); }
+
+private:
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+
+    ThreadPool m_ThreadPool;
+};
+
+} // namespace Diligent
@@ -0,0 +1,225 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+#pragma once
+
+/// \file
+/// Declaration of Diligent::DrawPacketQueue class
+
+#include <vector>
+#include <memory>
+
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../../Common/interface/ThreadPool.hpp"
+
+namespace Diligent
+{
+
+/// Compact draw command recorded into Diligent::DrawPacketQueue.
+
+/// The packet stores raw pointers to the objects it references. The application must keep
+/// the objects alive until the queue is submitted or cleared.
+///
+/// \note  A packet references at most one vertex buffer that is bound to slot 0.
+///        Pipelines that read vertex buffers from other slots are not supported.
+struct DrawPacket
+{
+    /// Pipeline state to draw with. Must not be null.
+    IPipelineState* pPSO = nullptr;
+
+    /// Shader resource binding to commit, or null if the pipeline does not use any resources.
+    IShaderResourceBinding* pSRB = nullptr;
+
+    /// Vertex buffer bound to slot 0, or null if the pipeline does not use vertex buffers.
+    /// When Submit() sets the buffer, the buffers bound to other slots are unbound.
+    IBuffer* pVertexBuffer = nullptr;
+
+    /// Index buffer. If null, the packet is submitted with IDeviceContext::Draw(),
+    /// otherwise with IDeviceContext::DrawIndexed().
+    IBuffer* pIndexBuffer = nullptr;
+
+    /// Offset in bytes from the beginning of the vertex buffer.
+    Uint32 VertexBufferOffset = 0;
+
+    /// Offset in bytes from the beginning of the index buffer.
+    Uint32 IndexBufferOffset = 0;
+
+    /// Number of vertices to draw, or number of indices if the packet is indexed.
+    Uint32 NumVerticesOrIndices = 0;
+
+    /// Number of instances to draw.
+    Uint32 NumInstances = 1;
+
+    /// Location of the first vertex or the first index.
+    Uint32 FirstVertexOrIndex = 0;
+
+    /// Constant added to every index, ignored for non-indexed packets.
+    Uint32 BaseVertex = 0;
+
+    /// Location of the first instance.
+    Uint32 FirstInstance = 0;
+
+    /// Index type, ignored for non-indexed packets.
+    VALUE_TYPE IndexType = VT_UINT32;
+
+    /// Draw command flags.
+    DRAW_FLAGS Flags = DRAW_FLAG_NONE;
+};
+
+/// Statistics of a single DrawPacketQueue::Submit() call.
+struct DrawPacketQueueStats
+{
+    /// Number of submitted packets
+    Uint32 NumPackets = 0;
+
+    /// Number of IDeviceContext::SetPipelineState() calls
+    Uint32 NumPipelineStateChanges = 0;
+    /// Number of packets that reused the previous pipeline state
+    Uint32 NumPipelineStateChangesAvoided = 0;
+
+    /// Number of IDeviceContext::CommitShaderResources() calls
+    Uint32 NumSRBCommits = 0;
+    /// Number of packets that reused the previously committed shader resource binding
+    Uint32 NumSRBCommitsAvoided = 0;
+
+    /// Number of IDeviceContext::SetVertexBuffers() calls
+    Uint32 NumVertexBufferChanges = 0;
+    /// Number of packets that reused the previously bound vertex buffer
+    Uint32 NumVertexBufferChangesAvoided = 0;
+
+    /// Number of IDeviceContext::SetIndexBuffer() calls
+    Uint32 NumIndexBufferChanges = 0;
+    /// Number of packets that reused the previously bound index buffer
+    Uint32 NumIndexBufferChangesAvoided = 0;
+};
+
+/// Collects draw packets tagged with 64-bit sort keys and submits them in key order.
+
+/// Packets are pushed into per-thread buckets, so multiple threads can record packets
+/// in parallel without synchronization as long as every bucket is only used by one thread
+/// at a time. Submit() sorts all packets with a parallel radix sort and submits them to
+/// the device context, skipping pipeline state, shader resource binding, vertex buffer
+/// and index buffer changes between consecutive packets that use the same objects.
+/// The application encodes the submission order in the key, for instance by placing
+/// the pipeline state index in the most significant bits, followed by the SRB index and
+/// the depth.
+///
+/// \note   Only vertex buffer slot 0 is supported, see Diligent::DrawPacket.
+///
+/// \note   Packets with equal keys are submitted in the order of the buckets and in the
+///         order they were pushed into every bucket.
+class DrawPacketQueue
+{
+public:
+    /// \param [in] NumBuckets     - Number of buckets, normally one per recording thread.
+    /// \param [in] NumSortThreads - Number of worker threads used to sort the packets.
+    ///                              If 0, the packets are sorted on the submitting thread.
+    explicit DrawPacketQueue(Uint32 NumBuckets, Uint32 NumSortThreads = 0);
+
+    // clang-format off
+    DrawPacketQueue           (const DrawPacketQueue&) = delete;
+    DrawPacketQueue           (DrawPacketQueue&&)      = delete;
+    DrawPacketQueue& operator=(const DrawPacketQueue&) = delete;
+    DrawPacketQueue& operator=(DrawPacketQueue&&)      = delete;
+    // clang-format on
+
+    ~DrawPacketQueue();
+
+    /// Adds the packet to the bucket.
+
+    /// \param [in] Bucket  - Bucket index. Different threads must use different buckets.
+    /// \param [in] SortKey - Sort key. Packets are submitted in the ascending key order.
+    /// \param [in] Packet  - Draw packet.
+    void Push(Uint32 Bucket, Uint64 SortKey, const DrawPacket& Packet)
+    {
+        VERIFY(Bucket < m_NumBuckets, "Bucket index (", Bucket, ") is out of range");
+        VERIFY(Packet.pPSO != nullptr, "Pipeline state must not be null");
+        m_Buckets[Bucket].Packets.emplace_back(SortKey, Packet);
+    }
+
+    /// Reserves memory for NumPackets packets in the bucket.
+    void Reserve(Uint32 Bucket, size_t NumPackets);
+
+    /// Returns the total number of packets in all buckets.
+    /// Must not be called while other threads push packets.
+    size_t GetNumPackets() const;
+
+    Uint32 GetNumBuckets() const { return m_NumBuckets; }
+
+    /// Sorts the packets, submits them to the device context and clears the queue.
+
+    /// \param [in] pContext       - Device context to submit the packets to. Render targets,
+    ///                              viewports and other states not recorded in the packets
+    ///                              must be set by the application.
+    /// \param [in] TransitionMode - State transition mode for the shader resources, vertex and index buffers.
+    ///
+    /// \return     Submission statistics.
+    ///
+    /// \remarks    The method must not be called while other threads push packets.
+    DrawPacketQueueStats Submit(IDeviceContext* pContext, RESOURCE_STATE_TRANSITION_MODE TransitionMode = RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+    /// Removes all packets from the queue.
+    void Clear();
+
+private:
+    struct KeyedPacket
+    {
+        KeyedPacket(Uint64 _Key, const DrawPacket& _Packet) :
+            Key{_Key},
+            Packet{_Packet}
+        {}
+
+        Uint64     Key;
+        DrawPacket Packet;
+    };
+
+    // Buckets are aligned by the cache line size, so that the vectors
+    // written by different threads never share a cache line
+    struct alignas(64) Bucket
+    {
+        std::vector<KeyedPacket> Packets;
+    };
+
+    struct SortItem
+    {
+        Uint64            Key;
+        const DrawPacket* pPacket;
+    };
+
+    const Uint32 m_NumBuckets;
+
+    // Operator new does not respect the alignment of over-aligned types in C++11,
+    // so the buckets are constructed in the storage that is aligned manually.
+    std::unique_ptr<Uint8[]> m_BucketStorage;
+    Bucket*                  m_Buckets = nullptr;
+
+    std::vector<SortItem> m_SortItems;
+    std::vector<SortItem> m_SortScratch;
+
+    std::unique_ptr<ThreadPool> m_pSortThreadPool;
+};
+
+} // namespace Diligent
@@ -0,0 +1,115 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include <thread>
+#include <algorithm>
+
+#include "AsyncPipelineCreator.hpp"
+
+namespace Diligent
+{
+
+static size_t GetNumWorkerThreads(IRenderDevice* pDevice, Uint32 NumThreads)
+{
+    if (!pDevice->GetDeviceCaps().Features.MultithreadedResourceCreation)
+        return 0;
+
+    if (NumThreads != 0)
+        return NumThreads;
+
+    // Leave one core to the application thread that waits for the results
+    const auto NumHWThreads = std::thread::hardware_concurrency();
+    return std::max(NumHWThreads, 2u) - 1;
+}
+
+AsyncPipelineCreator::AsyncPipelineCreator(IRenderDevice* pDevice, Uint32 NumThreads) :
+    // clang-format off
+    m_pDevice   {pDevice},
+    m_ThreadPool{GetNumWorkerThreads(pDevice, NumThreads)}
+// clang-format on
+{
+}
+
+AsyncPipelineCreator::~AsyncPipelineCreator()
+{
+    WaitForIdle();
+}
+
+AsyncPipelineCreator::ShaderFuture AsyncPipelineCreator::CreateShader(const ShaderCreateInfo& ShaderCI)
+{
+    auto* pDevice = m_pDevice.RawPtr();
+    return m_ThreadPool.Enqueue(
+        [pDevice, ShaderCI]() //
+        {
+            RefCntAutoPtr<IShader> pShader;
+            pDevice->CreateShader(ShaderCI, &pShader);
+            return pShader;
+        });
+}
+
+std::vector<AsyncPipelineCreator::ShaderFuture> AsyncPipelineCreator::CreateShaders(const ShaderCreateInfo* pShaderCIs, Uint32 NumShaders)
+{
+    VERIFY_EXPR(pShaderCIs != nullptr || NumShaders == 0);
+
+    std::vector<ShaderFuture> Futures;
+    Futures.reserve(NumShaders);
+    for (Uint32 i = 0; i < NumShaders; ++i)
+        Futures.emplace_back(CreateShader(pShaderCIs[i]));
+    return Futures;
+}
+
+AsyncPipelineCreator::PipelineStateFuture AsyncPipelineCreator::CreatePipelineState(const PipelineStateCreateInfo& PSOCreateInfo)
+{
+    auto* pDevice = m_pDevice.RawPtr();
+    return m_ThreadPool.Enqueue(
+        [pDevice, PSOCreateInfo]() //
+        {
+            RefCntAutoPtr<IPipelineState> pPSO;
+            pDevice->CreatePipelineState(PSOCreateInfo, &pPSO);
+            return pPSO;
+        });
+}
+
+std::vector<AsyncPipelineCreator::PipelineStateFuture> AsyncPipelineCreator::CreatePipelineStates(const PipelineStateCreateInfo* pPSOCreateInfos, Uint32 NumPSOs)
+{
+    VERIFY_EXPR(pPSOCreateInfos != nullptr || NumPSOs == 0);
+
+    std::vector<PipelineStateFuture> Futures;
+    Futures.reserve(NumPSOs);
+    for (Uint32 i = 0; i < NumPSOs; ++i)
+        Futures.emplace_back(CreatePipelineState(pPSOCreateInfos[i]));
+    return Futures;
+}
+
+void AsyncPipelineCreator::WaitForIdle()
+{
+    m_ThreadPool.WaitForAllTasks();
+}
+
+} // namespace Diligent
@@ -0,0 +1,199 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include <new>
+
+#include "DrawPacketQueue.hpp"
+#include "RadixSort.hpp"
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+DrawPacketQueue::DrawPacketQueue(Uint32 NumBuckets, Uint32 NumSortThreads) :
+    m_NumBuckets{NumBuckets}
+{
+    VERIFY(NumBuckets > 0, "The queue must have at least one bucket");
+    m_BucketStorage.reset(new Uint8[sizeof(Bucket) * NumBuckets + alignof(Bucket) - 1]);
+    m_Buckets = reinterpret_cast<Bucket*>(Align(reinterpret_cast<size_t>(m_BucketStorage.get()), alignof(Bucket)));
+    for (Uint32 b = 0; b < NumBuckets; ++b)
+        new (m_Buckets + b) Bucket{};
+
+    if (NumSortThreads > 0)
+        m_pSortThreadPool.reset(new ThreadPool{NumSortThreads});
+}
+
+DrawPacketQueue::~DrawPacketQueue()
+{
+    for (Uint32 b = 0; b < m_NumBuckets; ++b)
+        m_Buckets[b].~Bucket();
+}
+
+void DrawPacketQueue::Reserve(Uint32 Bucket, size_t NumPackets)
+{
+    VERIFY(Bucket < m_NumBuckets, "Bucket index (", Bucket, ") is out of range");
+    m_Buckets[Bucket].Packets.reserve(NumPackets);
+}
+
+size_t DrawPacketQueue::GetNumPackets() const
+{
+    size_t NumPackets = 0;
+    for (Uint32 b = 0; b < m_NumBuckets; ++b)
+        NumPackets += m_Buckets[b].Packets.size();
+    return NumPackets;
+}
+
+void DrawPacketQueue::Clear()
+{
+    for (Uint32 b = 0; b < m_NumBuckets; ++b)
+        m_Buckets[b].Packets.clear();
+}
+
+DrawPacketQueueStats DrawPacketQueue::Submit(IDeviceContext* pContext, RESOURCE_STATE_TRANSITION_MODE TransitionMode)
+{
+    VERIFY_EXPR(pContext != nullptr);
+
+    DrawPacketQueueStats Stats;
+
+    const auto NumPackets = GetNumPackets();
+    if (NumPackets == 0)
+        return Stats;
+
+    m_SortItems.resize(NumPackets);
+    m_SortScratch.resize(NumPackets);
+
+    size_t Item = 0;
+    for (Uint32 b = 0; b < m_NumBuckets; ++b)
+    {
+        for (const auto& Keyed : m_Buckets[b].Packets)
+            m_SortItems[Item++] = SortItem{Keyed.Key, &Keyed.Packet};
+    }
+    VERIFY_EXPR(Item == NumPackets);
+
+    const auto* pSorted = RadixSort64(m_SortItems.data(), m_SortScratch.data(), NumPackets, m_pSortThreadPool.get());
+
+    IPipelineState*         pCurrPSO     = nullptr;
+    IShaderResourceBinding* pCurrSRB     = nullptr;
+    IBuffer*                pCurrVB      = nullptr;
+    Uint32                  CurrVBOffset = 0;
+    IBuffer*                pCurrIB      = nullptr;
+    Uint32                  CurrIBOffset = 0;
+    for (size_t i = 0; i < NumPackets; ++i)
+    {
+        const auto& Packet = *pSorted[i].pPacket;
+
+        if (Packet.pPSO != pCurrPSO)
+        {
+            pContext->SetPipelineState(Packet.pPSO);
+            pCurrPSO = Packet.pPSO;
+            // Shader resources must be committed again after the pipeline state is changed
+            pCurrSRB = nullptr;
+            ++Stats.NumPipelineStateChanges;
+        }
+        else
+        {
+            ++Stats.NumPipelineStateChangesAvoided;
+        }
+
+        if (Packet.pSRB != nullptr)
+        {
+            if (Packet.pSRB != pCurrSRB)
+            {
+                pContext->CommitShaderResources(Packet.pSRB, TransitionMode);
+                pCurrSRB = Packet.pSRB;
+                ++Stats.NumSRBCommits;
+            }
+            else
+            {
+                ++Stats.NumSRBCommitsAvoided;
+            }
+        }
+
+        if (Packet.pVertexBuffer != nullptr)
+        {
+            // The vertex buffer does not need to be set again after the pipeline state is changed:
+            // the device context recommits it if the new pipeline uses different strides.
+            if (Packet.pVertexBuffer != pCurrVB || Packet.VertexBufferOffset != CurrVBOffset)
+            {
+                IBuffer* pVBs[]    = {Packet.pVertexBuffer};
+                Uint32   Offsets[] = {Packet.VertexBufferOffset};
+                pContext->SetVertexBuffers(0, 1, pVBs, Offsets, TransitionMode, SET_VERTEX_BUFFERS_FLAG_RESET);
+                pCurrVB      = Packet.pVertexBuffer;
+                CurrVBOffset = Packet.VertexBufferOffset;
+                ++Stats.NumVertexBufferChanges;
+            }
+            else
+            {
+                ++Stats.NumVertexBufferChangesAvoided;
+            }
+        }
+
+        if (Packet.pIndexBuffer != nullptr)
+        {
+            if (Packet.pIndexBuffer != pCurrIB || Packet.IndexBufferOffset != CurrIBOffset)
+            {
+                pContext->SetIndexBuffer(Packet.pIndexBuffer, Packet.IndexBufferOffset, TransitionMode);
+                pCurrIB      = Packet.pIndexBuffer;
+                CurrIBOffset = Packet.IndexBufferOffset;
+                ++Stats.NumIndexBufferChanges;
+            }
+            else
+            {
+                ++Stats.NumIndexBufferChangesAvoided;
+            }
+
+            DrawIndexedAttribs DrawAttrs;
+            DrawAttrs.NumIndices            = Packet.NumVerticesOrIndices;
+            DrawAttrs.IndexType             = Packet.IndexType;
+            DrawAttrs.Flags                 = Packet.Flags;
+            DrawAttrs.NumInstances          = Packet.NumInstances;
+            DrawAttrs.FirstIndexLocation    = Packet.FirstVertexOrIndex;
+            DrawAttrs.BaseVertex            = Packet.BaseVertex;
+            DrawAttrs.FirstInstanceLocation = Packet.FirstInstance;
+            pContext->DrawIndexed(DrawAttrs);
+        }
+        else
+        {
+            DrawAttribs DrawAttrs;
+            DrawAttrs.NumVertices           = Packet.NumVerticesOrIndices;
+            DrawAttrs.Flags                 = Packet.Flags;
+            DrawAttrs.NumInstances          = Packet.NumInstances;
+            DrawAttrs.StartVertexLocation   = Packet.FirstVertexOrIndex;
+            DrawAttrs.FirstInstanceLocation = Packet.FirstInstance;
+            pContext->Draw(DrawAttrs);
+        }
+    }
+    Stats.NumPackets = static_cast<Uint32>(NumPackets);
+
+    Clear();
+
+    return Stats;
+}
+
+} // namespace Diligent
@@ -0,0 +1,128 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::HLSL2GLSLConversionCache class
+
+#include <unordered_map>
+#include <deque>
+#include <mutex>
+#include <atomic>
+
+#include "BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Cache of GLSL sources converted from HLSL.
+
+/// Entries are keyed by the hash of the HLSL source with all includes expanded, shader entry
+/// point, shader type and conversion options (see HLSL2GLSLConverterImpl::ConversionAttribs::pCache).
+/// Converted sources are kept in memory and, if cache directory is specified, are also stored on
+/// disk, one file per entry, so that they can be reused between runs. GLSL definitions are
+/// not stored in the cache.
+///
+/// \remarks The cache is thread-safe.
+class HLSL2GLSLConversionCache
+{
+public:
+    /// \param [in] CacheDirectory - Directory where converted shaders are stored between runs.
+    ///                              The directory is created if it does not exist. If null,
+    ///                              shaders are only cached in memory.
+    /// \param [in] MaxMemorySize  - Maximum total size of the sources kept in memory, in bytes.
+    ///                              When the size is exceeded, the oldest entries are evicted.
+    explicit HLSL2GLSLConversionCache(const Char* CacheDirectory = nullptr,
+                                      size_t      MaxMemorySize  = DefaultMaxMemorySize);
+
+    // clang-format off
+    HLSL2GLSLConversionCache           (const HLSL2GLSLConversionCache&) = delete;
+    HLSL2GLSLConversionCache           (HLSL2GLSLConversionCache&&)      = delete;
+    HLSL2GLSLConversionCache& operator=(const HLSL2GLSLConversionCache&) = delete;
+    HLSL2GLSLConversionCache& operator=(HLSL2GLSLConversionCache&&)      = delete;
+    // clang-format on
+
+    /// Looks up the converted source in memory and then on disk.
+    bool Find(Uint64 Key, Uint64 VerificationHash, String& GLSLSource);
+
+    /// Adds the converted source to the cache.
+    void Add(Uint64 Key, Uint64 VerificationHash, const String& GLSLSource);
+
+    struct Statistics
+    {
+        /// Number of shaders found in memory
+        Uint32 NumMemoryHits = 0;
+
+        /// Number of shaders loaded from disk
+        Uint32 NumDiskHits = 0;
+
+        /// Number of shaders that were not found in the cache
+        Uint32 NumMisses = 0;
+
+        /// Number of cache entries that could not be written to disk
+        Uint32 NumWriteFailures = 0;
+    };
+    Statistics GetStatistics() const;
+
+    /// Cache format version. Must be incremented every time the converter output
+    /// or the file format change.
+    static constexpr Uint32 Version = 1;
+
+    static constexpr size_t DefaultMaxMemorySize = size_t{32} << 20;
+
+    /// Returns the path of the file that stores the entry with the given key on disk.
+    String GetEntryPath(Uint64 Key) const;
+
+private:
+    bool ReadEntry(Uint64 Key, Uint64 VerificationHash, String& GLSLSource) const;
+    bool WriteEntry(Uint64 Key, Uint64 VerificationHash, const String& GLSLSource) const;
+
+    void AddToMemory(Uint64 Key, Uint64 VerificationHash, const String& GLSLSource);
+
+    struct MemoryEntry
+    {
+        Uint64 VerificationHash;
+        String GLSLSource;
+    };
+
+    std::mutex                              m_MemoryCacheMtx;
+    std::unordered_map<Uint64, MemoryEntry> m_MemoryCache;
+    std::deque<Uint64>                      m_InsertionOrder;
+    size_t                                  m_MemorySize = 0;
+    const size_t                            m_MaxMemorySize;
+
+    // Empty if the disk cache is disabled
+    String m_Directory;
+
+    std::atomic<Uint32> m_NumMemoryHits{0};
+    std::atomic<Uint32> m_NumDiskHits{0};
+    std::atomic<Uint32> m_NumMisses{0};
+    std::atomic<Uint32> m_NumWriteFailures{0};
+};
+
+} // namespace Diligent
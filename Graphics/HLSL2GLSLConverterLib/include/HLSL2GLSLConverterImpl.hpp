@@ -27,7 +27,8 @@
 
 #pragma once
 
-#include <list>
+#include <iterator>
+#include <memory>
 #include <unordered_set>
 #include <unordered_map>
 #include <vector>
@@ -37,6 +38,7 @@
 #include "HLSLKeywords.h"
 #include "Shader.h"
 #include "HashUtils.hpp"
+#include "HLSL2GLSLConversionCache.hpp"
 #include "HLSLKeywords.h"
 
 namespace Diligent
@@ -133,6 +135,10 @@ public:
         /// This requires separate shader objects extension:
         /// https://www.khronos.org/registry/OpenGL/extensions/ARB/ARB_separate_shader_objects.txt
         bool                                UseInOutLocationQualifiers = true;
+
+        /// Optional cache of converted shaders. If the shader is found in the cache,
+        /// the source is not converted again.
+        HLSL2GLSLConversionCache*           pCache                     = nullptr;
     };
 
     // clang-format on
@@ -239,11 +245,140 @@ private:
     };
     // clang-format on
 
+    // Immutable null-terminated string slice. Token literals and delimiters reference text
+    // owned by a TokenTextPool of the conversion stream or string literals with static
+    // storage duration, so that tokens can be copied and moved around without allocations.
+    class TokenString
+    {
+    public:
+        TokenString() noexcept {}
+
+        // String literals are referenced directly
+        template <size_t N>
+        TokenString(const Char (&Literal)[N]) noexcept :
+            m_Str{Literal},
+            m_Length{N - 1}
+        {}
+
+        // Str must be null-terminated and must outlive all tokens that reference it
+        TokenString(const Char* Str, size_t Length) noexcept :
+            m_Str{Str},
+            m_Length{Length}
+        {
+            VERIFY_EXPR(Str[Length] == 0);
+        }
+
+        const Char* c_str() const { return m_Str; }
+        size_t      length() const { return m_Length; }
+        bool        empty() const { return m_Length == 0; }
+
+        const Char* begin() const { return m_Str; }
+        const Char* end() const { return m_Str + m_Length; }
+
+        Char operator[](size_t i) const
+        {
+            VERIFY_EXPR(i < m_Length);
+            return m_Str[i];
+        }
+
+        Char back() const
+        {
+            VERIFY_EXPR(m_Length > 0);
+            return m_Str[m_Length - 1];
+        }
+
+        bool operator==(const TokenString& Str) const
+        {
+            return m_Length == Str.m_Length && (m_Str == Str.m_Str || memcmp(m_Str, Str.m_Str, m_Length) == 0);
+        }
+        bool operator==(const String& Str) const
+        {
+            return m_Length == Str.length() && memcmp(m_Str, Str.c_str(), m_Length) == 0;
+        }
+        bool operator==(const Char* Str) const
+        {
+            return strncmp(m_Str, Str, m_Length) == 0 && Str[m_Length] == 0;
+        }
+
+        template <typename T>
+        bool operator!=(const T& Str) const
+        {
+            return !(*this == Str);
+        }
+
+        String str() const { return String{m_Str, m_Length}; }
+
+        // clang-format off
+        friend bool operator==(const String& Str, const TokenString& TokStr) { return TokStr == Str; }
+        friend bool operator!=(const String& Str, const TokenString& TokStr) { return TokStr != Str; }
+
+        friend String operator+(const String&      Str,    const TokenString& TokStr) { return Str + TokStr.str(); }
+        friend String operator+(const Char*        Str,    const TokenString& TokStr) { return Str + TokStr.str(); }
+        friend String operator+(const TokenString& TokStr, const Char*        Str)    { return TokStr.str() + Str; }
+        friend String operator+(const TokenString& TokStr, const String&      Str)    { return TokStr.str() + Str; }
+        friend String operator+(const TokenString& TokStr, const TokenString& Str)    { return TokStr.str().append(Str.c_str(), Str.length()); }
+
+        friend std::ostream& operator<<(std::ostream& os, const TokenString& TokStr) { return os.write(TokStr.c_str(), TokStr.length()); }
+        // clang-format on
+
+    private:
+        const Char* m_Str    = "";
+        size_t      m_Length = 0;
+    };
+
+    // Linear allocator that owns the text of the tokens. Strings are never freed individually,
+    // the memory is released when the pool is cleared or destroyed.
+    class TokenTextPool
+    {
+    public:
+        TokenTextPool() noexcept {}
+
+        // clang-format off
+        TokenTextPool           (const TokenTextPool&) = delete;
+        TokenTextPool& operator=(const TokenTextPool&) = delete;
+        // clang-format on
+
+        TokenString Copy(const Char* Str, size_t Length);
+
+        TokenString Copy(const String& Str)
+        {
+            return Copy(Str.c_str(), Str.length());
+        }
+
+        template <typename IteratorType>
+        TokenString Copy(IteratorType Start, IteratorType End)
+        {
+            if (Start == End)
+                return TokenString{};
+            return Copy(&*Start, static_cast<size_t>(End - Start));
+        }
+
+        // Returns Str with symbol Sym appended. If Str is the last string allocated from the pool,
+        // it is extended in place.
+        TokenString Append(const TokenString& Str, Char Sym);
+
+        void Clear();
+
+        // Takes ownership of all strings allocated from the Other pool.
+        // The strings remain valid until this pool is cleared or destroyed.
+        void Adopt(TokenTextPool& Other);
+
+    private:
+        Char* Allocate(size_t Size);
+
+        static constexpr size_t PageSize = 64 << 10;
+
+        std::vector<std::unique_ptr<Char[]>> m_Pages;
+
+        Char*  m_pCurrPtr  = nullptr;
+        size_t m_Available = 0;
+    };
+
     struct TokenInfo
     {
-        TokenType Type;
-        String    Literal;
-        String    Delimiter;
+        TokenType   Type;
+        TokenString Literal;
+        TokenString Delimiter;
 
         bool IsBuiltInType() const
         {
@@ -260,14 +395,145 @@ private:
         }
 
         TokenInfo(TokenType   _Type      = TokenType::Undefined,
-                  const Char* _Literal   = "",
-                  const Char* _Delimiter = "") :
+                  TokenString _Literal   = TokenString{},
+                  TokenString _Delimiter = TokenString{}) :
             Type{_Type},
             Literal{_Literal},
             Delimiter{_Delimiter}
         {}
     };
-    typedef std::list<TokenInfo> TokenListType;
+
+    // Doubly-linked list of tokens that keeps the nodes in contiguous chunks
+    // and links them by indices rather than pointers. Similar to std::list, insertion
+    // does not invalidate iterators and references, and erasure only invalidates
+    // iterators and references to the erased elements.
+    class TokenListType
+    {
+        struct Node
+        {
+            TokenInfo Token;
+            Uint32    Prev = 0;
+            Uint32    Next = 0;
+        };
+
+    public:
+        class iterator
+        {
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type        = TokenInfo;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = TokenInfo*;
+            using reference         = TokenInfo&;
+
+            iterator() noexcept {}
+
+            // clang-format off
+            TokenInfo& operator* () const { return m_pList->GetNode(m_Idx).Token; }
+            TokenInfo* operator->() const { return &m_pList->GetNode(m_Idx).Token; }
+
+            bool operator==(const iterator& rhs) const { return m_Idx == rhs.m_Idx && m_pList == rhs.m_pList; }
+            bool operator!=(const iterator& rhs) const { return !(*this == rhs); }
+            // clang-format on
+
+            iterator& operator++()
+            {
+                m_Idx = m_pList->GetNode(m_Idx).Next;
+                return *this;
+            }
+
+            iterator& operator--()
+            {
+                m_Idx = m_pList->GetNode(m_Idx).Prev;
+                return *this;
+            }
+
+            iterator operator++(int)
+            {
+                auto Tmp = *this;
+                ++(*this);
+                return Tmp;
+            }
+
+            iterator operator--(int)
+            {
+                auto Tmp = *this;
+                --(*this);
+                return Tmp;
+            }
+
+        private:
+            friend class TokenListType;
+
+            iterator(TokenListType* pList, Uint32 Idx) noexcept :
+                m_pList{pList},
+                m_Idx{Idx}
+            {}
+
+            TokenListType* m_pList = nullptr;
+            Uint32         m_Idx   = 0;
+        };
+
+        TokenListType();
+
+        // Nodes are copied verbatim, so that an iterator to the original list
+        // refers to the same token after the copy is swapped into that list.
+        TokenListType(const TokenListType& List);
+
+        // clang-format off
+        TokenListType& operator=(const TokenListType&) = delete;
+        TokenListType& operator=(TokenListType&&)      = delete;
+        // clang-format on
+
+        // Node 0 is the sentinel node that is always present
+        iterator begin() { return iterator{this, GetNode(0).Next}; }
+        iterator end() { return iterator{this, 0}; }
+
+        TokenInfo& front() { return GetNode(GetNode(0).Next).Token; }
+        TokenInfo& back() { return GetNode(GetNode(0).Prev).Token; }
+
+        size_t size() const { return m_Size; }
+        bool   empty() const { return m_Size == 0; }
+
+        void push_back(const TokenInfo& Token)
+        {
+            insert(end(), Token);
+        }
+
+        // Inserts the token before Pos and returns iterator pointing to the inserted token
+        iterator insert(const iterator& Pos, const TokenInfo& Token);
+
+        // Erases the token and returns iterator following the removed element
+        iterator erase(const iterator& Pos);
+        iterator erase(const iterator& First, const iterator& Last);
+
+        void swap(TokenListType& List);
+
+    private:
+        static constexpr Uint32 ChunkSizeLog2 = 10;
+        static constexpr Uint32 ChunkSize     = 1u << ChunkSizeLog2;
+        static constexpr Uint32 InvalidIndex  = ~Uint32{0};
+
+        Node& GetNode(Uint32 Idx)
+        {
+            VERIFY_EXPR(Idx < m_NumNodes);
+            return m_Chunks[Idx >> ChunkSizeLog2][Idx & (ChunkSize - 1)];
+        }
+
+        const Node& GetNode(Uint32 Idx) const
+        {
+            VERIFY_EXPR(Idx < m_NumNodes);
+            return m_Chunks[Idx >> ChunkSizeLog2][Idx & (ChunkSize - 1)];
+        }
+
+        Uint32 AllocateNode();
+
+        std::vector<std::unique_ptr<Node[]>> m_Chunks;
+
+        Uint32 m_NumNodes     = 0;
+        Uint32 m_FirstFreeIdx = InvalidIndex;
+        size_t m_Size         = 0;
+    };
 
 
     class ConversionStream : public ObjectBase<IHLSL2GLSLConversionStream>
@@ -298,11 +564,12 @@ private:
                          size_t                           NumSymbols,
                          bool                             bPreserveTokens);
 
-        String Convert(const Char* EntryPoint,
-                       SHADER_TYPE ShaderType,
-                       bool        IncludeDefintions,
-                       const char* SamplerSuffix,
-                       bool        UseInOutLocationQualifiers);
+        String Convert(const Char*               EntryPoint,
+                       SHADER_TYPE               ShaderType,
+                       bool                      IncludeDefintions,
+                       const char*               SamplerSuffix,
+                       bool                      UseInOutLocationQualifiers,
+                       HLSL2GLSLConversionCache* pCache = nullptr);
 
         virtual void DILIGENT_CALL_TYPE Convert(const Char* EntryPoint,
                                                 SHADER_TYPE ShaderType,
@@ -319,9 +586,18 @@ private:
         void InsertIncludes(String& GLSLSource, IShaderSourceInputStreamFactory* pSourceStreamFactory);
         void Tokenize(const String& Source);
 
+        // Performs the part of the conversion that does not depend on the entry point,
+        // shader type and conversion options. This is only done once for the stream.
+        void PrepareTokens();
+
+        String ConvertTokens(const Char* EntryPoint,
+                             SHADER_TYPE ShaderType,
+                             const char* SamplerSuffix,
+                             bool        UseInOutLocationQualifiers);
+
         typedef std::unordered_map<String, bool> SamplerHashType;
 
-        const HLSLObjectInfo* FindHLSLObject(const String& Name);
+        const HLSLObjectInfo* FindHLSLObject(const Char* Name);
 
         void ProcessShaderDeclaration(TokenListType::iterator EntryPointToken, SHADER_TYPE ShaderType);
 
@@ -501,6 +777,20 @@ private:
 
         String BuildGLSLSource();
 
+        // HLSL source with all includes inserted. The source is only tokenized when
+        // the first shader that is not found in the conversion cache is converted.
+        String m_Source;
+
+        // Hash of the source, used to compute the conversion cache key
+        ContentHasher m_SourceHasher;
+
+        // Text of the tokens produced by the tokenizer and by PrepareTokens()
+        TokenTextPool m_SourceText;
+
+        // Text of the tokens that are added or modified during the conversion.
+        // If original tokens are preserved, the pool is cleared after every conversion.
+        TokenTextPool m_ConversionText;
+
         // Tokenized source code
         TokenListType m_Tokens;
 
@@ -515,8 +805,12 @@ private:
         //           defined as function arguments
         std::vector<ObjectsTypeHashType> m_Objects;
 
+        // Samplers declared in the global scope
+        SamplerHashType m_GlobalSamplers;
+
         const bool m_bPreserveTokens;
         bool       m_bUseInOutLocationQualifiers = true;
+        bool       m_bTokensPrepared             = false;
 
         const HLSL2GLSLConverterImpl& m_Converter;
 
@@ -0,0 +1,278 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include <cstdio>
+#include <sstream>
+#include <thread>
+#include <chrono>
+
+#include "HLSL2GLSLConversionCache.hpp"
+#include "HashUtils.hpp"
+#include "FileWrapper.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+struct HLSL2GLSLCacheEntryHeader
+{
+    static constexpr Uint32 ExpectedMagic = 0x47324844; // 'DH2G'
+
+    Uint32 Magic            = ExpectedMagic;
+    Uint32 Version          = HLSL2GLSLConversionCache::Version;
+    Uint64 Key              = 0;
+    Uint64 VerificationHash = 0;
+    Uint64 SourceHash       = 0;
+    Uint64 SourceLength     = 0;
+};
+
+Uint64 ComputeSourceHash(const String& Source)
+{
+    ContentHasher Hasher;
+    Hasher.Update(Source.c_str(), Source.length());
+    return Hasher.GetKey();
+}
+
+// Entries are first written to temporary files whose names must not collide
+// between the threads and processes that convert the same shader
+String GetTempEntryPath(const String& Path)
+{
+    static std::atomic<Uint32> TempFileCounter{0};
+
+    std::stringstream ss;
+    ss << Path << '.' << std::hash<std::thread::id>{}(std::this_thread::get_id())
+       << '.' << std::chrono::high_resolution_clock::now().time_since_epoch().count()
+       << '.' << TempFileCounter.fetch_add(1) << ".tmp";
+    return ss.str();
+}
+
+} // namespace
+
+HLSL2GLSLConversionCache::HLSL2GLSLConversionCache(const Char* CacheDirectory, size_t MaxMemorySize) :
+    m_MaxMemorySize{MaxMemorySize}
+{
+    if (CacheDirectory == nullptr)
+        return;
+
+    m_Directory = CacheDirectory;
+    if (m_Directory.empty())
+        m_Directory = ".";
+
+    const auto SlashSym = FileSystem::GetSlashSymbol();
+    FileSystem::CorrectSlashes(m_Directory, SlashSym);
+    if (m_Directory.back() == SlashSym)
+        m_Directory.pop_back();
+
+    if (!FileSystem::PathExists(m_Directory.c_str()))
+    {
+        if (!FileSystem::CreateDirectory(m_Directory.c_str()))
+            LOG_WARNING_MESSAGE("Failed to create HLSL->GLSL conversion cache directory '", m_Directory, "'. Converted shaders will not be stored on disk.");
+    }
+}
+
+String HLSL2GLSLConversionCache::GetEntryPath(Uint64 Key) const
+{
+    char FileName[32];
+    snprintf(FileName, sizeof(FileName), "%016llx.glsl", static_cast<unsigned long long>(Key));
+
+    String Path = m_Directory;
+    Path.push_back(FileSystem::GetSlashSymbol());
+    Path.append(FileName);
+    return Path;
+}
+
+bool HLSL2GLSLConversionCache::ReadEntry(Uint64 Key, Uint64 VerificationHash, String& GLSLSource) const
+{
+    const auto Path = GetEntryPath(Key);
+    if (!FileSystem::FileExists(Path.c_str()))
+        return false;
+
+    FileWrapper File{Path.c_str(), EFileAccessMode::Read};
+    if (!File)
+        return false;
+
+    const size_t FileSize = File->GetSize();
+    if (FileSize < sizeof(HLSL2GLSLCacheEntryHeader))
+        return false;
+
+    HLSL2GLSLCacheEntryHeader Header;
+    if (!File->Read(&Header, sizeof(Header)))
+        return false;
+
+    // clang-format off
+    if (Header.Magic            != HLSL2GLSLCacheEntryHeader::ExpectedMagic ||
+        Header.Version          != Version                                  ||
+        Header.Key              != Key                                      ||
+        Header.VerificationHash != VerificationHash                         ||
+        Header.SourceLength     == 0)
+    {
+        return false;
+    }
+    // clang-format on
+
+    // The source must occupy the rest of the file
+    if (Header.SourceLength != FileSize - sizeof(Header))
+    {
+        LOG_WARNING_MESSAGE("HLSL->GLSL conversion cache entry '", Path, "' is corrupted and will be overwritten.");
+        return false;
+    }
+
+    GLSLSource.resize(static_cast<size_t>(Header.SourceLength));
+    if (!File->Read(&GLSLSource[0], GLSLSource.length()))
+        return false;
+
+    // The entry may be corrupted if it was being written by another process
+    if (ComputeSourceHash(GLSLSource) != Header.SourceHash)
+    {
+        LOG_WARNING_MESSAGE("HLSL->GLSL conversion cache entry '", Path, "' is corrupted and will be overwritten.");
+        GLSLSource.clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool HLSL2GLSLConversionCache::WriteEntry(Uint64 Key, Uint64 VerificationHash, const String& GLSLSource) const
+{
+    const auto Path     = GetEntryPath(Key);
+    const auto TempPath = GetTempEntryPath(Path);
+
+    {
+        FileWrapper File{TempPath.c_str(), EFileAccessMode::Overwrite};
+        if (!File)
+            return false;
+
+        HLSL2GLSLCacheEntryHeader Header;
+        Header.Key              = Key;
+        Header.VerificationHash = VerificationHash;
+        Header.SourceHash       = ComputeSourceHash(GLSLSource);
+        Header.SourceLength     = GLSLSource.length();
+        if (!File->Write(&Header, sizeof(Header)) || !File->Write(GLSLSource.c_str(), GLSLSource.length()))
+        {
+            File.Close();
+            FileSystem::DeleteFile(TempPath.c_str());
+            return false;
+        }
+    }
+
+    // Other processes that read the entry see either the old or the new file, never a partially written one
+    if (!FileSystem::RenameFile(TempPath.c_str(), Path.c_str()))
+    {
+        FileSystem::DeleteFile(TempPath.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+void HLSL2GLSLConversionCache::AddToMemory(Uint64 Key, Uint64 VerificationHash, const String& GLSLSource)
+{
+    if (GLSLSource.length() > m_MaxMemorySize)
+        return;
+
+    std::lock_guard<std::mutex> Lock{m_MemoryCacheMtx};
+
+    auto it = m_MemoryCache.find(Key);
+    if (it != m_MemoryCache.end())
+    {
+        // Another thread may have converted the same shader, or the entry
+        // was produced from a different input with the same key
+        m_MemorySize -= it->second.GLSLSource.length();
+        m_MemorySize += GLSLSource.length();
+        it->second.VerificationHash = VerificationHash;
+        it->second.GLSLSource       = GLSLSource;
+    }
+    else
+    {
+        m_MemoryCache.emplace(Key, MemoryEntry{VerificationHash, GLSLSource});
+        m_InsertionOrder.push_back(Key);
+        m_MemorySize += GLSLSource.length();
+    }
+
+    while (m_MemorySize > m_MaxMemorySize)
+    {
+        VERIFY_EXPR(!m_InsertionOrder.empty());
+        auto EvictIt = m_MemoryCache.find(m_InsertionOrder.front());
+        VERIFY_EXPR(EvictIt != m_MemoryCache.end());
+        m_MemorySize -= EvictIt->second.GLSLSource.length();
+        m_MemoryCache.erase(EvictIt);
+        m_InsertionOrder.pop_front();
+    }
+}
+
+bool HLSL2GLSLConversionCache::Find(Uint64 Key, Uint64 VerificationHash, String& GLSLSource)
+{
+    {
+        std::lock_guard<std::mutex> Lock{m_MemoryCacheMtx};
+
+        auto it = m_MemoryCache.find(Key);
+        if (it != m_MemoryCache.end() && it->second.VerificationHash == VerificationHash)
+        {
+            GLSLSource = it->second.GLSLSource;
+            ++m_NumMemoryHits;
+            return true;
+        }
+    }
+
+    if (!m_Directory.empty() && ReadEntry(Key, VerificationHash, GLSLSource))
+    {
+        AddToMemory(Key, VerificationHash, GLSLSource);
+        ++m_NumDiskHits;
+        return true;
+    }
+
+    ++m_NumMisses;
+    return false;
+}
+
+void HLSL2GLSLConversionCache::Add(Uint64 Key, Uint64 VerificationHash, const String& GLSLSource)
+{
+    AddToMemory(Key, VerificationHash, GLSLSource);
+
+    if (!m_Directory.empty())
+    {
+        if (!WriteEntry(Key, VerificationHash, GLSLSource))
+            ++m_NumWriteFailures;
+    }
+}
+
+HLSL2GLSLConversionCache::Statistics HLSL2GLSLConversionCache::GetStatistics() const
+{
+    Statistics Stats;
+    Stats.NumMemoryHits    = m_NumMemoryHits.load();
+    Stats.NumDiskHits      = m_NumDiskHits.load();
+    Stats.NumMisses        = m_NumMisses.load();
+    Stats.NumWriteFailures = m_NumWriteFailures.load();
+    return Stats;
+}
+
+} // namespace Diligent
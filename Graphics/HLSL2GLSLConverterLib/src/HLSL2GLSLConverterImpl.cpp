@@ -847,7 +847,7 @@ String HLSL2GLSLConverterImpl::ConversionStream::PrintTokenContext(IteratorType&
     Int32 NumLinesAbove      = 0;
     while (CurrLineStartToken != m_Tokens.begin())
     {
-        NumLinesAbove += CountNewLines(CurrLineStartToken->Delimiter);
+        NumLinesAbove += CountNewLines(CurrLineStartToken->Delimiter.str());
         if (NumLinesAbove > 0)
             break;
         --CurrLineStartToken;
@@ -860,7 +860,7 @@ String HLSL2GLSLConverterImpl::ConversionStream::PrintTokenContext(IteratorType&
     while (TopLineStart != m_Tokens.begin() && NumLinesAbove <= NumAdjacentLines)
     {
         --TopLineStart;
-        NumLinesAbove += CountNewLines(TopLineStart->Delimiter);
+        NumLinesAbove += CountNewLines(TopLineStart->Delimiter.str());
     }
     //\n  ++ x ;
     //    ^
@@ -871,8 +871,8 @@ String HLSL2GLSLConverterImpl::ConversionStream::PrintTokenContext(IteratorType&
     auto Token = TopLineStart;
     for (; Token != CurrLineStartToken; ++Token)
     {
-        Ctx.append(CompressNewLines(Token->Delimiter));
-        Ctx.append(Token->Literal);
+        Ctx.append(CompressNewLines(Token->Delimiter.str()));
+        Ctx.append(Token->Literal.begin(), Token->Literal.end());
     }
 
     //\n  if ( x != 0 )
@@ -903,14 +903,14 @@ String HLSL2GLSLConverterImpl::ConversionStream::PrintTokenContext(IteratorType&
         if (AccumWhiteSpaces)
             Spaces.append(Token->Literal.length(), ' ');
 
-        Ctx.append(CompressNewLines(Token->Delimiter));
-        Ctx.append(Token->Literal);
+        Ctx.append(CompressNewLines(Token->Delimiter.str()));
+        Ctx.append(Token->Literal.begin(), Token->Literal.end());
         ++Token;
 
         if (Token == m_Tokens.end())
             break;
 
-        NumLinesBelow += CountNewLines(Token->Delimiter);
+        NumLinesBelow += CountNewLines(Token->Delimiter.str());
     }
 
     // Write ^ on the line below
@@ -921,14 +921,14 @@ String HLSL2GLSLConverterImpl::ConversionStream::PrintTokenContext(IteratorType&
     // Write NumAdjacentLines lines below current line
     while (Token != m_Tokens.end() && NumLinesBelow <= NumAdjacentLines)
     {
-        Ctx.append(CompressNewLines(Token->Delimiter));
-        Ctx.append(Token->Literal);
+        Ctx.append(CompressNewLines(Token->Delimiter.str()));
+        Ctx.append(Token->Literal.begin(), Token->Literal.end());
         ++Token;
 
         if (Token == m_Tokens.end())
             break;
 
-        NumLinesBelow += CountNewLines(Token->Delimiter);
+        NumLinesBelow += CountNewLines(Token->Delimiter.str());
     }
 
     Ctx.append("\n<");
@@ -973,10 +973,14 @@ void HLSL2GLSLConverterImpl::ConversionStream::InsertIncludes(String& GLSLSource
     // Put all the includes into the set to avoid multiple inclusion
     std::unordered_set<String> ProcessedIncludes;
 
+    // The text preceding the last processed #include directive contains no
+    // other includes, so there is no need to scan it again
+    size_t ScanStartOffset = 0;
+
     do
     {
-        // Find the first #include statement
-        auto Pos             = GLSLSource.begin();
+        // Find the next #include statement
+        auto Pos             = GLSLSource.begin() + ScanStartOffset;
         auto IncludeStartPos = GLSLSource.end();
         while (Pos != GLSLSource.end())
         {
@@ -1043,6 +1047,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::InsertIncludes(String& GLSLSource
         // #   include "TestFile.fxh"
         // ^                         ^
         // IncludeStartPos           Pos
+        ScanStartOffset = IncludeStartPos - GLSLSource.begin();
         GLSLSource.erase(IncludeStartPos, Pos);
 
         // Convert the name to lower case
@@ -1065,48 +1070,210 @@ void HLSL2GLSLConverterImpl::ConversionStream::InsertIncludes(String& GLSLSource
             size_t NumSymbols  = pIncludeData->GetSize();
 
             // Insert the text into source
-            GLSLSource.insert(IncludeStartPos - GLSLSource.begin(), IncludeText, NumSymbols);
+            GLSLSource.insert(ScanStartOffset, IncludeText, NumSymbols);
         }
     } while (true);
 }
 
 
-void ReadNumericConstant(const String& Source, String::const_iterator& Pos, String& Output)
+HLSL2GLSLConverterImpl::TokenString HLSL2GLSLConverterImpl::TokenTextPool::Copy(const Char* Str, size_t Length)
+{
+    auto* pDst = Allocate(Length + 1);
+    if (Length > 0)
+        memcpy(pDst, Str, Length);
+    pDst[Length] = 0;
+    return TokenString{pDst, Length};
+}
+
+HLSL2GLSLConverterImpl::TokenString HLSL2GLSLConverterImpl::TokenTextPool::Append(const TokenString& Str, Char Sym)
+{
+    auto Length = Str.length();
+    if (m_pCurrPtr != nullptr && Str.c_str() + Length + 1 == m_pCurrPtr && m_Available > 0)
+    {
+        // The string is the last one allocated from the current page - extend it in place
+        auto* pStr       = m_pCurrPtr - Length - 1;
+        pStr[Length]     = Sym;
+        pStr[Length + 1] = 0;
+        m_pCurrPtr += 1;
+        m_Available -= 1;
+        return TokenString{pStr, Length + 1};
+    }
+
+    auto* pDst = Allocate(Length + 2);
+    if (Length > 0)
+        memcpy(pDst, Str.c_str(), Length);
+    pDst[Length]     = Sym;
+    pDst[Length + 1] = 0;
+    return TokenString{pDst, Length + 1};
+}
+
+Char* HLSL2GLSLConverterImpl::TokenTextPool::Allocate(size_t Size)
+{
+    if (Size > m_Available)
+    {
+        if (Size > PageSize / 4)
+        {
+            // Allocate dedicated page for large strings and keep using the current page
+            m_Pages.emplace_back(new Char[Size]);
+            return m_Pages.back().get();
+        }
+
+        m_Pages.emplace_back(new Char[PageSize]);
+        m_pCurrPtr  = m_Pages.back().get();
+        m_Available = PageSize;
+    }
+
+    auto* pStr = m_pCurrPtr;
+    m_pCurrPtr += Size;
+    m_Available -= Size;
+    return pStr;
+}
+
+void HLSL2GLSLConverterImpl::TokenTextPool::Clear()
+{
+    m_Pages.clear();
+    m_pCurrPtr  = nullptr;
+    m_Available = 0;
+}
+
+void HLSL2GLSLConverterImpl::TokenTextPool::Adopt(TokenTextPool& Other)
+{
+    // Keep allocating from the current page: the strings in the adopted pages
+    // must not be extended in place by Append()
+    m_Pages.reserve(m_Pages.size() + Other.m_Pages.size());
+    for (auto& Page : Other.m_Pages)
+        m_Pages.emplace_back(std::move(Page));
+    Other.Clear();
+}
+
+
+HLSL2GLSLConverterImpl::TokenListType::TokenListType()
+{
+    // Create the sentinel node
+    auto SentinelIdx = AllocateNode();
+    VERIFY_EXPR(SentinelIdx == 0);
+    (void)SentinelIdx;
+}
+
+HLSL2GLSLConverterImpl::TokenListType::TokenListType(const TokenListType& List) :
+    m_NumNodes{List.m_NumNodes},
+    m_FirstFreeIdx{List.m_FirstFreeIdx},
+    m_Size{List.m_Size}
+{
+    m_Chunks.reserve(List.m_Chunks.size());
+    for (size_t Chunk = 0; Chunk < List.m_Chunks.size(); ++Chunk)
+    {
+        m_Chunks.emplace_back(new Node[ChunkSize]);
+
+        const auto NumChunkNodes = std::min(m_NumNodes - static_cast<Uint32>(Chunk << ChunkSizeLog2), Uint32{ChunkSize});
+        std::copy(List.m_Chunks[Chunk].get(), List.m_Chunks[Chunk].get() + NumChunkNodes, m_Chunks.back().get());
+    }
+}
+
+Uint32 HLSL2GLSLConverterImpl::TokenListType::AllocateNode()
+{
+    if (m_FirstFreeIdx != InvalidIndex)
+    {
+        auto Idx       = m_FirstFreeIdx;
+        m_FirstFreeIdx = GetNode(Idx).Next;
+        return Idx;
+    }
+
+    if ((m_NumNodes & (ChunkSize - 1)) == 0)
+        m_Chunks.emplace_back(new Node[ChunkSize]);
+    return m_NumNodes++;
+}
+
+HLSL2GLSLConverterImpl::TokenListType::iterator HLSL2GLSLConverterImpl::TokenListType::insert(const iterator& Pos, const TokenInfo& Token)
+{
+    VERIFY(Pos.m_pList == this, "Iterator does not belong to this list");
+    auto  NewIdx   = AllocateNode();
+    auto& NewNode  = GetNode(NewIdx);
+    auto& NextNode = GetNode(Pos.m_Idx);
+
+    NewNode.Token = Token;
+    NewNode.Prev  = NextNode.Prev;
+    NewNode.Next  = Pos.m_Idx;
+
+    GetNode(NewNode.Prev).Next = NewIdx;
+    NextNode.Prev              = NewIdx;
+    ++m_Size;
+
+    return iterator{this, NewIdx};
+}
+
+HLSL2GLSLConverterImpl::TokenListType::iterator HLSL2GLSLConverterImpl::TokenListType::erase(const iterator& Pos)
+{
+    VERIFY(Pos.m_pList == this, "Iterator does not belong to this list");
+    VERIFY(Pos.m_Idx != 0, "Attempting to erase end() iterator");
+    auto& Node = GetNode(Pos.m_Idx);
+    auto  Next = Node.Next;
+
+    GetNode(Node.Prev).Next = Node.Next;
+    GetNode(Node.Next).Prev = Node.Prev;
+    --m_Size;
+
+    // Add the node to the free list
+    Node.Token     = TokenInfo{};
+    Node.Next      = m_FirstFreeIdx;
+    m_FirstFreeIdx = Pos.m_Idx;
+
+    return iterator{this, Next};
+}
+
+HLSL2GLSLConverterImpl::TokenListType::iterator HLSL2GLSLConverterImpl::TokenListType::erase(const iterator& First, const iterator& Last)
+{
+    auto It = First;
+    while (It != Last)
+        It = erase(It);
+    return It;
+}
+
+void HLSL2GLSLConverterImpl::TokenListType::swap(TokenListType& List)
+{
+    std::swap(m_Chunks, List.m_Chunks);
+    std::swap(m_NumNodes, List.m_NumNodes);
+    std::swap(m_FirstFreeIdx, List.m_FirstFreeIdx);
+    std::swap(m_Size, List.m_Size);
+}
+
+
+void SkipNumericConstant(const String& Source, String::const_iterator& Pos)
 {
-#define COPY_SYMBOL()                    \
+#define SKIP_SYMBOL()                    \
     {                                    \
-        Output.push_back(*(Pos++));      \
+        ++Pos;                           \
         if (Pos == Source.end()) return; \
     }
 
     while (Pos != Source.end() && *Pos >= '0' && *Pos <= '9')
-        COPY_SYMBOL()
+        SKIP_SYMBOL()
 
     if (*Pos == '.')
     {
-        COPY_SYMBOL()
-        // Copy all numbers
+        SKIP_SYMBOL()
+        // Skip all numbers
         while (Pos != Source.end() && *Pos >= '0' && *Pos <= '9')
-            COPY_SYMBOL()
+            SKIP_SYMBOL()
     }
 
     // Scientific notation
     // e+1242, E-234
     if (*Pos == 'e' || *Pos == 'E')
     {
-        COPY_SYMBOL()
+        SKIP_SYMBOL()
 
         if (*Pos == '+' || *Pos == '-')
-            COPY_SYMBOL()
+            SKIP_SYMBOL()
 
         // Skip all numbers
         while (Pos != Source.end() && *Pos >= '0' && *Pos <= '9')
-            COPY_SYMBOL()
+            SKIP_SYMBOL()
     }
 
     if (*Pos == 'f' || *Pos == 'F')
-        COPY_SYMBOL()
-#undef COPY_SYMBOL
+        SKIP_SYMBOL()
+#undef SKIP_SYMBOL
 }
 
 
@@ -1138,17 +1305,20 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
     //   * This might be a + b, -a or -10
     // * Operator ?: is not detected
     auto SrcPos = Source.begin();
+
+    auto ReadSymbol = [&]() {
+        auto Symbol = m_SourceText.Copy(SrcPos, SrcPos + 1);
+        ++SrcPos;
+        return Symbol;
+    };
+
     while (SrcPos != Source.end())
     {
         TokenInfo NewToken;
         auto      DelimStart = SrcPos;
         SkipDelimetersAndComments(Source, SrcPos);
         if (DelimStart != SrcPos)
-        {
-            auto DelimSize = SrcPos - DelimStart;
-            NewToken.Delimiter.reserve(DelimSize);
-            NewToken.Delimiter.append(DelimStart, SrcPos);
-        }
+            NewToken.Delimiter = m_SourceText.Copy(DelimStart, SrcPos);
         if (SrcPos == Source.end())
             break;
 
@@ -1162,15 +1332,13 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
                 SkipDelimetersAndComments(Source, SrcPos);
                 CHECK_END("Missing preprocessor directive");
                 SkipIdentifier(Source, SrcPos);
-                auto DirectiveSize = SrcPos - DirectiveStart;
-                NewToken.Literal.reserve(DirectiveSize);
-                NewToken.Literal.append(DirectiveStart, SrcPos);
+                NewToken.Literal = m_SourceText.Copy(DirectiveStart, SrcPos);
             }
             break;
 
             case ';':
-                NewToken.Type = TokenType::Semicolon;
-                NewToken.Literal.push_back(*(SrcPos++));
+                NewToken.Type    = TokenType::Semicolon;
+                NewToken.Literal = ReadSymbol();
                 break;
 
             case '=':
@@ -1189,8 +1357,8 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
                         LastToken.Literal == "|" ||
                         LastToken.Literal == "^")
                     {
-                        LastToken.Type = TokenType::Assignment;
-                        LastToken.Literal.push_back(*(SrcPos++));
+                        LastToken.Type    = TokenType::Assignment;
+                        LastToken.Literal = m_SourceText.Append(LastToken.Literal, *(SrcPos++));
                         continue;
                     }
                     else if (LastToken.Literal == "<" ||
@@ -1198,14 +1366,14 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
                              LastToken.Literal == "=" ||
                              LastToken.Literal == "!")
                     {
-                        LastToken.Type = TokenType::ComparisonOp;
-                        LastToken.Literal.push_back(*(SrcPos++));
+                        LastToken.Type    = TokenType::ComparisonOp;
+                        LastToken.Literal = m_SourceText.Append(LastToken.Literal, *(SrcPos++));
                         continue;
                     }
                 }
 
-                NewToken.Type = TokenType::Assignment;
-                NewToken.Literal.push_back(*(SrcPos++));
+                NewToken.Type    = TokenType::Assignment;
+                NewToken.Literal = ReadSymbol();
                 break;
 
             case '|':
@@ -1213,14 +1381,14 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
                 if (m_Tokens.size() > 0 && NewToken.Delimiter == "" &&
                     m_Tokens.back().Literal.length() == 1 && m_Tokens.back().Literal[0] == *SrcPos)
                 {
-                    m_Tokens.back().Type = TokenType::BooleanOp;
-                    m_Tokens.back().Literal.push_back(*(SrcPos++));
+                    m_Tokens.back().Type    = TokenType::BooleanOp;
+                    m_Tokens.back().Literal = m_SourceText.Append(m_Tokens.back().Literal, *(SrcPos++));
                     continue;
                 }
                 else
                 {
-                    NewToken.Type = TokenType::BitwiseOp;
-                    NewToken.Literal.push_back(*(SrcPos++));
+                    NewToken.Type    = TokenType::BitwiseOp;
+                    NewToken.Literal = ReadSymbol();
                 }
                 break;
 
@@ -1229,8 +1397,8 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
                 if (m_Tokens.size() > 0 && NewToken.Delimiter == "" &&
                     m_Tokens.back().Literal.length() == 1 && m_Tokens.back().Literal[0] == *SrcPos)
                 {
-                    m_Tokens.back().Type = TokenType::BitwiseOp;
-                    m_Tokens.back().Literal.push_back(*(SrcPos++));
+                    m_Tokens.back().Type    = TokenType::BitwiseOp;
+                    m_Tokens.back().Literal = m_SourceText.Append(m_Tokens.back().Literal, *(SrcPos++));
                     continue;
                 }
                 else
@@ -1238,8 +1406,8 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
                     // Note: we do not distinguish between comparison operators
                     // and template arguments like in Texture2D<float> at this
                     // point. This will be clarified when textures are processed.
-                    NewToken.Type = TokenType::ComparisonOp;
-                    NewToken.Literal.push_back(*(SrcPos++));
+                    NewToken.Type    = TokenType::ComparisonOp;
+                    NewToken.Literal = ReadSymbol();
                 }
                 break;
 
@@ -1248,39 +1416,39 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
                 if (m_Tokens.size() > 0 && NewToken.Delimiter == "" &&
                     m_Tokens.back().Literal.length() == 1 && m_Tokens.back().Literal[0] == *SrcPos)
                 {
-                    m_Tokens.back().Type = TokenType::IncDecOp;
-                    m_Tokens.back().Literal.push_back(*(SrcPos++));
+                    m_Tokens.back().Type    = TokenType::IncDecOp;
+                    m_Tokens.back().Literal = m_SourceText.Append(m_Tokens.back().Literal, *(SrcPos++));
                     continue;
                 }
                 else
                 {
                     // We do not currently distinguish between math operator a + b,
                     // unary operator -a and numerical constant -1:
-                    NewToken.Literal.push_back(*(SrcPos++));
+                    NewToken.Literal = ReadSymbol();
                 }
                 break;
 
             case '~':
             case '^':
-                NewToken.Type = TokenType::BitwiseOp;
-                NewToken.Literal.push_back(*(SrcPos++));
+                NewToken.Type    = TokenType::BitwiseOp;
+                NewToken.Literal = ReadSymbol();
                 break;
 
             case '*':
             case '/':
             case '%':
-                NewToken.Type = TokenType::MathOp;
-                NewToken.Literal.push_back(*(SrcPos++));
+                NewToken.Type    = TokenType::MathOp;
+                NewToken.Literal = ReadSymbol();
                 break;
 
             case '!':
-                NewToken.Type = TokenType::BooleanOp;
-                NewToken.Literal.push_back(*(SrcPos++));
+                NewToken.Type    = TokenType::BooleanOp;
+                NewToken.Literal = ReadSymbol();
                 break;
 
             case ',':
-                NewToken.Type = TokenType::Comma;
-                NewToken.Literal.push_back(*(SrcPos++));
+                NewToken.Type    = TokenType::Comma;
+                NewToken.Literal = ReadSymbol();
                 break;
 
             case '"':
@@ -1290,8 +1458,12 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
                 ++SrcPos;
                 //[domain("quad")]
                 //         ^
-                while (SrcPos != Source.end() && *SrcPos != '"')
-                    NewToken.Literal.push_back(*(SrcPos++));
+                {
+                    auto StringStart = SrcPos;
+                    while (SrcPos != Source.end() && *SrcPos != '"')
+                        ++SrcPos;
+                    NewToken.Literal = m_SourceText.Copy(StringStart, SrcPos);
+                }
                 //[domain("quad")]
                 //             ^
                 if (SrcPos != Source.end())
@@ -1300,11 +1472,11 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
                 //              ^
                 break;
 
-#define BRACKET_CASE(Symbol, TokenType, Action)  \
-    case Symbol:                                 \
-        NewToken.Type = TokenType;               \
-        NewToken.Literal.push_back(*(SrcPos++)); \
-        Action;                                  \
+#define BRACKET_CASE(Symbol, TokenType, Action) \
+    case Symbol:                                \
+        NewToken.Type    = TokenType;           \
+        NewToken.Literal = ReadSymbol();        \
+        Action;                                 \
         break;
 
                 BRACKET_CASE('(', TokenType::OpenBracket, ++OpenBracketCount);
@@ -1323,10 +1495,8 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
                 SkipIdentifier(Source, SrcPos);
                 if (IdentifierStartPos != SrcPos)
                 {
-                    auto IDSize = SrcPos - IdentifierStartPos;
-                    NewToken.Literal.reserve(IDSize);
-                    NewToken.Literal.append(IdentifierStartPos, SrcPos);
-                    auto KeywordIt = m_Converter.m_HLSLKeywords.find(NewToken.Literal.c_str());
+                    NewToken.Literal = m_SourceText.Copy(IdentifierStartPos, SrcPos);
+                    auto KeywordIt   = m_Converter.m_HLSLKeywords.find(NewToken.Literal.c_str());
                     if (KeywordIt != m_Converter.m_HLSLKeywords.end())
                     {
                         NewToken.Type = KeywordIt->second.Type;
@@ -1348,14 +1518,16 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
                     }
                     if (bIsNumericalCostant)
                     {
-                        ReadNumericConstant(Source, SrcPos, NewToken.Literal);
-                        NewToken.Type = TokenType::NumericConstant;
+                        auto ConstantStart = SrcPos;
+                        SkipNumericConstant(Source, SrcPos);
+                        NewToken.Literal = m_SourceText.Copy(ConstantStart, SrcPos);
+                        NewToken.Type    = TokenType::NumericConstant;
                     }
                 }
 
                 if (NewToken.Type == TokenType::Undefined)
                 {
-                    NewToken.Literal.push_back(*(SrcPos++));
+                    NewToken.Literal = ReadSymbol();
                 }
                 // Operators
                 // https://msdn.microsoft.com/en-us/library/windows/desktop/bb509631(v=vs.85).aspx
@@ -1471,7 +1643,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessStructuredBuffer(TokenList
     {
         std::stringstream ss;
         ss << "layout(std140, binding=" << ShaderStorageBlockBinding << ") buffer";
-        Token->Literal = ss.str();
+        Token->Literal = m_ConversionText.Copy(ss.str());
         ++ShaderStorageBlockBinding;
     }
     else
@@ -1511,7 +1683,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessStructuredBuffer(TokenList
     if (Token->Delimiter.empty())
         Token->Delimiter = " ";
 
-    m_Tokens.insert(OpenBraceToken, TokenInfo(TokenType::Identifier, Token->Literal.c_str(), " "));
+    m_Tokens.insert(OpenBraceToken, TokenInfo(TokenType::Identifier, Token->Literal, " "));
     //          OpenBraceToken
     //              V
     // buffer g_Data{DataType g_Data;
@@ -1549,9 +1721,9 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessStructuredBuffer(TokenList
     //                                 ^
     ++Token;
     String NameRedefine("#define ");
-    NameRedefine += GlobalVarNameToken->Literal + ' ' + GlobalVarNameToken->Literal + "_data\r\n";
-    m_Tokens.insert(Token, TokenInfo(TokenType::TextBlock, NameRedefine.c_str(), "\r\n"));
-    GlobalVarNameToken->Literal.append("_data");
+    NameRedefine += GlobalVarNameToken->Literal + " " + GlobalVarNameToken->Literal + "_data\r\n";
+    m_Tokens.insert(Token, TokenInfo(TokenType::TextBlock, m_ConversionText.Copy(NameRedefine), "\r\n"));
+    GlobalVarNameToken->Literal = m_ConversionText.Copy(GlobalVarNameToken->Literal + "_data");
     // buffer g_Data{DataType g_Data_data[]};
     // #define g_Data g_Data_data
     //                           ^
@@ -1672,7 +1844,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ParseSamplers(TokenListType::iter
                 const auto& SamplerName = Token->Literal;
 
                 // Add sampler state into the hash map
-                SamplersHash.insert(std::make_pair(SamplerName, bIsComparison));
+                SamplersHash.insert(std::make_pair(SamplerName.str(), bIsComparison));
 
                 ++Token;
                 // SamplerState LinearClamp ;
@@ -1898,13 +2070,13 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessTextureDeclaration(TokenLi
         {
             // RWTexture2D<float /* format = r32f */ >
             //                                       ^
-            ParseImageFormat(Token->Delimiter, ImgFormat);
+            ParseImageFormat(Token->Delimiter.str(), ImgFormat);
             if (ImgFormat.length() == 0)
             {
                 // RWTexture2D</* format = r32f */ float >
                 //                                 ^
                 //                            TexFmtToken
-                ParseImageFormat(TexFmtToken->Delimiter, ImgFormat);
+                ParseImageFormat(TexFmtToken->Delimiter.str(), ImgFormat);
             }
 
             if (ImgFormat.length() != 0)
@@ -2007,23 +2179,24 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessTextureDeclaration(TokenLi
         // |
         // Texture2D TexName ;
         //           ^
-        TexDeclToken->Literal = "";
+        String TexDecl;
         if (IsGlobalScope)
         {
             // Use layout qualifier for global variables only, not for function arguments
-            TexDeclToken->Literal.append(LayoutQualifier);
+            TexDecl.append(LayoutQualifier);
             // Samplers and images in global scope must be declared uniform.
             // Function arguments must not be declared uniform
-            TexDeclToken->Literal.append("uniform ");
+            TexDecl.append("uniform ");
             // From GLES 3.1 spec:
             //    Except for image variables qualified with the format qualifiers r32f, r32i, and r32ui,
             //    image variables must specify either memory qualifier readonly or the memory qualifier writeonly.
             // So on GLES we have to assume that an image is a writeonly variable
             if (IsRWTexture && ImgFormat != "r32f" && ImgFormat != "r32i" && ImgFormat != "r32ui")
-                TexDeclToken->Literal.append("IMAGE_WRITEONLY "); // defined as 'writeonly' on GLES and as '' on desktop in GLSLDefinitions.h
+                TexDecl.append("IMAGE_WRITEONLY "); // defined as 'writeonly' on GLES and as '' on desktop in GLSLDefinitions.h
         }
-        TexDeclToken->Literal.append(CompleteGLSLSampler);
-        Objects.m.insert(std::make_pair(HashMapStringKey(TextureName), HLSLObjectInfo(CompleteGLSLSampler, NumComponents)));
+        TexDecl.append(CompleteGLSLSampler);
+        TexDeclToken->Literal = m_ConversionText.Copy(TexDecl);
+        Objects.m.insert(std::make_pair(HashMapStringKey(TextureName.c_str(), true), HLSLObjectInfo(CompleteGLSLSampler, NumComponents)));
 
         // In global scope, multiple variables can be declared in the same statement
         if (IsGlobalScope)
@@ -2096,11 +2269,12 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessTextureDeclaration(TokenLi
 
 
 // Finds an HLSL object with the given name in object stack
-const HLSL2GLSLConverterImpl::HLSLObjectInfo* HLSL2GLSLConverterImpl::ConversionStream::FindHLSLObject(const String& Name)
+const HLSL2GLSLConverterImpl::HLSLObjectInfo* HLSL2GLSLConverterImpl::ConversionStream::FindHLSLObject(const Char* Name)
 {
+    HashMapStringKey Key{Name};
     for (auto ScopeIt = m_Objects.rbegin(); ScopeIt != m_Objects.rend(); ++ScopeIt)
     {
-        auto It = ScopeIt->m.find(Name.c_str());
+        auto It = ScopeIt->m.find(Key);
         if (It != ScopeIt->m.end())
             return &It->second;
     }
@@ -2174,7 +2348,7 @@ bool HLSL2GLSLConverterImpl::ConversionStream::ProcessObjectMethod(TokenListType
     // IdentifierToken
 
     // Try to find identifier
-    const auto* pObjectInfo = FindHLSLObject(IdentifierToken->Literal);
+    const auto* pObjectInfo = FindHLSLObject(IdentifierToken->Literal.c_str());
     if (pObjectInfo == nullptr)
     {
         return false;
@@ -2221,7 +2395,7 @@ bool HLSL2GLSLConverterImpl::ConversionStream::ProcessObjectMethod(TokenListType
     // ^
     // IdentifierToken
 
-    m_Tokens.insert(IdentifierToken, TokenInfo(TokenType::Identifier, StubIt->second.Name.c_str(), IdentifierToken->Delimiter.c_str()));
+    m_Tokens.insert(IdentifierToken, TokenInfo(TokenType::Identifier, m_ConversionText.Copy(StubIt->second.Name), IdentifierToken->Delimiter));
     IdentifierToken->Delimiter = " ";
     // FunctionStub TestTextArr[2], TestTextArr_sampler, ...
     //              ^
@@ -2251,8 +2425,9 @@ bool HLSL2GLSLConverterImpl::ConversionStream::ProcessObjectMethod(TokenListType
         //                                                            ^
         //                                                     ArgsListEndToken
 
-        auto SwizzleToken = m_Tokens.insert(ArgsListEndToken, TokenInfo(TokenType::TextBlock, StubIt->second.Swizzle.c_str(), ""));
-        SwizzleToken->Literal.push_back(static_cast<Char>('0' + pObjectInfo->NumComponents));
+        auto Swizzle = StubIt->second.Swizzle;
+        Swizzle.push_back(static_cast<Char>('0' + pObjectInfo->NumComponents));
+        m_Tokens.insert(ArgsListEndToken, TokenInfo(TokenType::TextBlock, m_ConversionText.Copy(Swizzle), ""));
         // FunctionStub( TestTextArr[2], TestTextArr_sampler, ...    )_SWIZZLE4;
         //                                                                     ^
         //                                                            ArgsListEndToken
@@ -2430,7 +2605,7 @@ bool HLSL2GLSLConverterImpl::ConversionStream::ProcessRWTextureStore(TokenListTy
     // ^                                             ^
     // Token                                    SemicolonToken
 
-    m_Tokens.insert(Token, TokenInfo(TokenType::Identifier, "imageStore", Token->Delimiter.c_str()));
+    m_Tokens.insert(Token, TokenInfo(TokenType::Identifier, "imageStore", Token->Delimiter));
     m_Tokens.insert(Token, TokenInfo(TokenType::OpenBracket, "(", ""));
     Token->Delimiter = " ";
     // imageStore( RWTex[Location.x] = float4(0.0, 0.0, 0.0, 1.0);
@@ -2494,7 +2669,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessRWTextures(const TokenList
         if (Token->Type == TokenType::Identifier)
         {
             // Try to find the object in all scopes
-            const auto* pObjectInfo = FindHLSLObject(Token->Literal);
+            const auto* pObjectInfo = FindHLSLObject(Token->Literal.c_str());
             if (pObjectInfo == nullptr)
             {
                 ++Token;
@@ -2558,7 +2733,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessAtomics(const TokenListTyp
             ++Token;
             VERIFY_PARSER_STATE(Token, Token != ScopeEnd, "Unexpected EOF");
 
-            const auto* pObjectInfo = FindHLSLObject(Token->Literal);
+            const auto* pObjectInfo = FindHLSLObject(Token->Literal.c_str());
             if (pObjectInfo != nullptr)
             {
                 // InterlockedAdd(Tex2D[GTid.xy], 1, iOldVal);
@@ -2606,7 +2781,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessAtomics(const TokenListTyp
                 // InterlockedAdd(Tex2D,GTid.xy, 1, iOldVal);
                 //                     ^
 
-                OperationToken->Literal = StubIt->second.Name;
+                OperationToken->Literal = m_ConversionText.Copy(StubIt->second.Name);
                 // InterlockedAddImage_3(Tex2D,GTid.xy, 1, iOldVal);
             }
             else
@@ -2615,7 +2790,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessAtomics(const TokenListTyp
                 //                ^
                 auto StubIt = m_Converter.m_GLSLStubs.find(FunctionStubHashKey("shared_var", OperationToken->Literal.c_str(), NumArguments));
                 VERIFY_PARSER_STATE(OperationToken, StubIt != m_Converter.m_GLSLStubs.end(), "Unable to find function stub for funciton ", OperationToken->Literal, " with ", NumArguments, " arguments");
-                OperationToken->Literal = StubIt->second.Name;
+                OperationToken->Literal = m_ConversionText.Copy(StubIt->second.Name);
                 // InterlockedAddSharedVar_3(g_i4SharedArray[GTid.x].x, 1, iOldVal);
             }
             Token = ArgsListEndToken;
@@ -2632,14 +2807,14 @@ void HLSL2GLSLConverterImpl::ConversionStream::ParseShaderParameter(TokenListTyp
     VERIFY_PARSER_STATE(Token, Token->IsBuiltInType() || Token->Type == TokenType::Identifier,
                         "Missing argument type");
     auto TypeToken = Token;
-    ParamInfo.Type = Token->Literal;
+    ParamInfo.Type = Token->Literal.str();
 
     ++Token;
     //          out float4 Color : SV_Target,
     //                     ^
     VERIFY_PARSER_STATE(Token, Token != m_Tokens.end(), "Unexpected EOF while parsing argument list");
     VERIFY_PARSER_STATE(Token, Token->Type == TokenType::Identifier, "Missing argument name after ", ParamInfo.Type);
-    ParamInfo.Name = Token->Literal;
+    ParamInfo.Name = Token->Literal.str();
 
     ++Token;
     VERIFY_PARSER_STATE(Token, Token != m_Tokens.end(), "Unexpected EOF");
@@ -2651,8 +2826,8 @@ void HLSL2GLSLConverterImpl::ConversionStream::ParseShaderParameter(TokenListTyp
         ProcessScope(
             Token, m_Tokens.end(), TokenType::OpenStaple, TokenType::ClosingStaple,
             [&](TokenListType::iterator& tkn, int) {
-                ParamInfo.ArraySize.append(tkn->Delimiter);
-                ParamInfo.ArraySize.append(tkn->Literal);
+                ParamInfo.ArraySize.append(tkn->Delimiter.begin(), tkn->Delimiter.end());
+                ParamInfo.ArraySize.append(tkn->Literal.begin(), tkn->Literal.end());
                 ++tkn;
             } //
         );
@@ -2680,7 +2855,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ParseShaderParameter(TokenListTyp
             VERIFY_PARSER_STATE(Token, Token != m_Tokens.end(), "Unexpected end of file while looking for semantic for argument \"", ParamInfo.Name, '\"');
             VERIFY_PARSER_STATE(Token, Token->Type == TokenType::Identifier, "Missing semantic for argument \"", ParamInfo.Name, '\"');
             // Transform to lower case -  semantics are case-insensitive
-            ParamInfo.Semantic = StrToLower(Token->Literal);
+            ParamInfo.Semantic = StrToLower(Token->Literal.str());
 
             ++Token;
             //          out float4 Color : SV_Target,
@@ -2744,8 +2919,8 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessFunctionParameters(TokenLi
     if (!bIsVoid)
     {
         ShaderParameterInfo RetParam;
-        RetParam.Type             = TypeToken->Literal;
-        RetParam.Name             = FuncNameToken->Literal;
+        RetParam.Type             = TypeToken->Literal.str();
+        RetParam.Name             = FuncNameToken->Literal.str();
         RetParam.storageQualifier = ShaderParameterInfo::StorageQualifier::Ret;
         Params.push_back(RetParam);
     }
@@ -2919,7 +3094,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessFunctionParameters(TokenLi
                     //                                   ^
                     VERIFY_PARSER_STATE(TmpToken, TmpToken != m_Tokens.end() && TmpToken->Type == TokenType::NumericConstant, "Numeric constant expected");
 
-                    ParamInfo.ArraySize     = TmpToken->Literal;
+                    ParamInfo.ArraySize     = TmpToken->Literal.str();
                     auto NumCtrlPointsToken = TmpToken;
                     ++TmpToken;
                     VERIFY_PARSER_STATE(TmpToken, TmpToken != m_Tokens.end() && TmpToken->Literal == ">", "Angle bracket expected");
@@ -2969,7 +3144,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessFunctionParameters(TokenLi
             VERIFY_PARSER_STATE(SemanticToken, SemanticToken != m_Tokens.end(), "Unexpected EOF");
             VERIFY_PARSER_STATE(SemanticToken, SemanticToken->Type == TokenType::Identifier, "Exepcted semantic for the return argument ");
             // Transform to lower case -  semantics are case-insensitive
-            RetParam.Semantic = StrToLower(SemanticToken->Literal);
+            RetParam.Semantic = StrToLower(SemanticToken->Literal.str());
             ++SemanticToken;
             // float4 TestPS  ( in VSOutput In ) : SV_Target
             // {
@@ -3589,7 +3764,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessHullShaderConstantFunction
                 Argument.push_back('[');
                 Argument.append(TopLevelParam.ArraySize);
                 Argument.push_back(']');
-                m_Tokens.insert(ArgsListEndToken, TokenInfo(TokenType::TextBlock, Argument.c_str()));
+                m_Tokens.insert(ArgsListEndToken, TokenInfo(TokenType::TextBlock, m_ConversionText.Copy(Argument)));
             }
             else
             {
@@ -3632,7 +3807,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessHullShaderConstantFunction
         }
     }
     ReturnHandlerSS << "return;}\n";
-    m_Tokens.insert(TypeToken, TokenInfo(TokenType::TextBlock, ReturnHandlerSS.str().c_str(), TypeToken->Delimiter.c_str()));
+    m_Tokens.insert(TypeToken, TokenInfo(TokenType::TextBlock, m_ConversionText.Copy(ReturnHandlerSS.str()), TypeToken->Delimiter));
     TypeToken->Delimiter = "\n";
 
     String Prologue = PrologueSS.str();
@@ -3650,7 +3825,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessHullShaderConstantFunction
     VERIFY_PARSER_STATE(FirstStatementToken, FirstStatementToken != m_Tokens.end(), "Unexpected end of file while looking for the body of \"", EntryPoint, "\".");
 
     // Insert prologue before the first token
-    m_Tokens.insert(FirstStatementToken, TokenInfo(TokenType::TextBlock, Prologue.c_str(), "\n"));
+    m_Tokens.insert(FirstStatementToken, TokenInfo(TokenType::TextBlock, m_ConversionText.Copy(Prologue), "\n"));
 
     ProcessReturnStatements(Token, bIsVoid, EntryPoint, ReturnMacroName);
 }
@@ -3682,8 +3857,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessShaderAttributes(TokenList
         VERIFY_PARSER_STATE(TmpToken, TmpToken != m_Tokens.end() && TmpToken->Type == TokenType::Identifier, "Identifier expected");
         // [domain("quad")]
         //  ^
-        auto& Attrib = TmpToken->Literal;
-        StrToLowerInPlace(Attrib);
+        auto Attrib = StrToLower(TmpToken->Literal.str());
 
         ++TmpToken;
         VERIFY_PARSER_STATE(TmpToken, TmpToken != m_Tokens.end() && TmpToken->Type == TokenType::OpenBracket, "\'(\' expected");
@@ -3692,8 +3866,8 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessShaderAttributes(TokenList
             TmpToken, m_Tokens.end(), TokenType::OpenBracket, TokenType::ClosingBracket,
             [&](TokenListType::iterator& tkn, int) //
             {
-                AttribValue.append(tkn->Delimiter);
-                AttribValue.append(tkn->Literal);
+                AttribValue.append(tkn->Delimiter.begin(), tkn->Delimiter.end());
+                AttribValue.append(tkn->Literal.begin(), tkn->Literal.end());
                 ++tkn;
             } //
         );
@@ -3999,7 +4173,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessDomainShaderArguments(Toke
     // ^
 
     std::unordered_map<HashMapStringKey, String, HashMapStringKey::Hasher> Attributes;
-    ParseAttributesInComment(TypeToken->Delimiter, Attributes);
+    ParseAttributesInComment(TypeToken->Delimiter.str(), Attributes);
     ProcessShaderAttributes(Token, Attributes);
 
     stringstream GlobalsSS;
@@ -4159,7 +4333,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessReturnStatements(TokenList
                 //if( x < 0.5 ) return float4(0.0, 0.0, 0.0, 1.0);
                 //              ^
                 Token->Type    = TokenType::Identifier;
-                Token->Literal = MacroName;
+                Token->Literal = m_ConversionText.Copy(MacroName, strlen(MacroName));
                 //if( x < 0.5 ) _RETURN_ float4(0.0, 0.0, 0.0, 1.0);
                 //              ^
 
@@ -4217,7 +4391,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessReturnStatements(TokenList
     if (IsVoid)
     {
         // Insert return handler before the closing brace
-        m_Tokens.insert(Token, TokenInfo(TokenType::TextBlock, MacroName, Token->Delimiter.c_str()));
+        m_Tokens.insert(Token, TokenInfo(TokenType::TextBlock, m_ConversionText.Copy(MacroName, strlen(MacroName)), Token->Delimiter));
         Token->Delimiter = "\n";
         // void main ()
         // {
@@ -4254,15 +4428,15 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessGSOutStreamOperations(Toke
             //          ^
             VERIFY_PARSER_STATE(Token, Token != m_Tokens.end(), "Unexpected EOF");
             VERIFY_PARSER_STATE(Token, Token->Literal == ".", "\'.\' expected");
-            Token->Literal = "_";
-            Token->Delimiter.clear();
+            Token->Literal   = "_";
+            Token->Delimiter = "";
             // triStream_Append( Out );
             //          ^
             ++Token;
             // triStream_Append( Out );
             //           ^
             VERIFY_PARSER_STATE(Token, Token != m_Tokens.end(), "Unexpected EOF");
-            Token->Delimiter.clear();
+            Token->Delimiter = "";
             ++Token;
         }
         else
@@ -4336,8 +4510,8 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessShaderDeclaration(TokenLis
     // TypeToken
 
     // Insert global variables & return handler before the function
-    m_Tokens.insert(TypeToken, TokenInfo(TokenType::TextBlock, GlobalVariables.c_str(), TypeToken->Delimiter.c_str()));
-    m_Tokens.insert(TypeToken, TokenInfo(TokenType::TextBlock, ReturnHandlerSS.str().c_str(), "\n"));
+    m_Tokens.insert(TypeToken, TokenInfo(TokenType::TextBlock, m_ConversionText.Copy(GlobalVariables), TypeToken->Delimiter));
+    m_Tokens.insert(TypeToken, TokenInfo(TokenType::TextBlock, m_ConversionText.Copy(ReturnHandlerSS.str()), "\n"));
     TypeToken->Delimiter = "\n";
     auto BodyStartToken  = ArgsListEndToken;
     while (BodyStartToken != m_Tokens.end() && BodyStartToken->Type != TokenType::OpenBrace)
@@ -4355,7 +4529,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessShaderDeclaration(TokenLis
     VERIFY_PARSER_STATE(FirstStatementToken, FirstStatementToken != m_Tokens.end(), "Unexpected end of file while looking for the body of shader entry point \"", EntryPoint, "\".");
 
     // Insert prologue before the first token
-    m_Tokens.insert(FirstStatementToken, TokenInfo(TokenType::TextBlock, Prologue.c_str(), "\n"));
+    m_Tokens.insert(FirstStatementToken, TokenInfo(TokenType::TextBlock, m_ConversionText.Copy(Prologue), "\n"));
 
     auto BodyEndToken = BodyStartToken;
     if (ShaderType == SHADER_TYPE_VERTEX || ShaderType == SHADER_TYPE_HULL || ShaderType == SHADER_TYPE_DOMAIN || ShaderType == SHADER_TYPE_PIXEL)
@@ -4539,7 +4713,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::RemoveSpecialShaderAttributes()
                 // void CS(uint3 ThreadId  : SV_DispatchThreadID)
                 // ^
                 if (Token != m_Tokens.end())
-                    Token->Delimiter = OpenStaple->Delimiter + Token->Delimiter;
+                    Token->Delimiter = m_ConversionText.Copy(OpenStaple->Delimiter + Token->Delimiter);
                 m_Tokens.erase(OpenStaple, Token);
             }
             else
@@ -4553,8 +4727,8 @@ String HLSL2GLSLConverterImpl::ConversionStream::BuildGLSLSource()
     String Output;
     for (const auto& Token : m_Tokens)
     {
-        Output.append(Token.Delimiter);
-        Output.append(Token.Literal);
+        Output.append(Token.Delimiter.begin(), Token.Delimiter.end());
+        Output.append(Token.Literal.begin(), Token.Literal.end());
     }
     return Output;
 }
@@ -4593,11 +4767,12 @@ HLSL2GLSLConverterImpl::ConversionStream::ConversionStream(IReferenceCounters*
         NumSymbols = pFileData->GetSize();
     }
 
-    String Source(HLSLSource, NumSymbols);
+    m_Source.assign(HLSLSource, NumSymbols);
 
-    InsertIncludes(Source, pInputStreamFactory);
+    InsertIncludes(m_Source, pInputStreamFactory);
 
-    Tokenize(Source);
+    m_SourceHasher.Update(HLSL2GLSLConversionCache::Version);
+    m_SourceHasher.Update(m_Source.c_str(), m_Source.length());
 }
 
 
@@ -4608,7 +4783,7 @@ String HLSL2GLSLConverterImpl::Convert(ConversionAttribs& Attribs) const
         try
         {
             ConversionStream Stream(nullptr, *this, Attribs.InputFileName, Attribs.pSourceStreamFactory, Attribs.HLSLSource, Attribs.NumSymbols, false);
-            return Stream.Convert(Attribs.EntryPoint, Attribs.ShaderType, Attribs.IncludeDefinitions, Attribs.SamplerSuffix, Attribs.UseInOutLocationQualifiers);
+            return Stream.Convert(Attribs.EntryPoint, Attribs.ShaderType, Attribs.IncludeDefinitions, Attribs.SamplerSuffix, Attribs.UseInOutLocationQualifiers, Attribs.pCache);
         }
         catch (std::runtime_error&)
         {
@@ -4637,7 +4812,7 @@ String HLSL2GLSLConverterImpl::Convert(ConversionAttribs& Attribs) const
             pStream = ValidatedCast<ConversionStream>(*Attribs.ppConversionStream);
         }
 
-        return pStream->Convert(Attribs.EntryPoint, Attribs.ShaderType, Attribs.IncludeDefinitions, Attribs.SamplerSuffix, Attribs.UseInOutLocationQualifiers);
+        return pStream->Convert(Attribs.EntryPoint, Attribs.ShaderType, Attribs.IncludeDefinitions, Attribs.SamplerSuffix, Attribs.UseInOutLocationQualifiers, Attribs.pCache);
     }
 }
 
@@ -4677,19 +4852,48 @@ void HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryPoint,
     }
 }
 
-String HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryPoint,
-                                                         SHADER_TYPE ShaderType,
-                                                         bool        IncludeDefintions,
-                                                         const char* SamplerSuffix,
-                                                         bool        UseInOutLocationQualifiers)
+String HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char*               EntryPoint,
+                                                         SHADER_TYPE               ShaderType,
+                                                         bool                      IncludeDefintions,
+                                                         const char*               SamplerSuffix,
+                                                         bool                      UseInOutLocationQualifiers,
+                                                         HLSL2GLSLConversionCache* pCache)
 {
-    m_bUseInOutLocationQualifiers = UseInOutLocationQualifiers;
-    TokenListType TokensCopy(m_bPreserveTokens ? m_Tokens : TokenListType());
+    String GLSLSource;
 
-    Uint32 ShaderStorageBlockBinding = 0;
-    Uint32 ImageBinding              = 0;
+    bool   FoundInCache     = false;
+    Uint64 Key              = 0;
+    Uint64 VerificationHash = 0;
+    if (pCache != nullptr)
+    {
+        auto Hasher = m_SourceHasher;
+        Hasher.Update(EntryPoint);
+        Hasher.Update(static_cast<Uint32>(ShaderType));
+        Hasher.Update(SamplerSuffix);
+        Hasher.Update(Uint32{UseInOutLocationQualifiers ? 1u : 0u});
+        Key              = Hasher.GetKey();
+        VerificationHash = Hasher.GetVerificationHash();
+
+        FoundInCache = pCache->Find(Key, VerificationHash, GLSLSource);
+    }
 
-    std::unordered_map<String, bool> SamplersHash;
+    if (!FoundInCache)
+    {
+        GLSLSource = ConvertTokens(EntryPoint, ShaderType, SamplerSuffix, UseInOutLocationQualifiers);
+        if (pCache != nullptr)
+            pCache->Add(Key, VerificationHash, GLSLSource);
+    }
+
+    // Definitions are not stored in the cache
+    if (IncludeDefintions)
+        GLSLSource.insert(0, g_GLSLDefinitions);
+
+    return GLSLSource;
+}
+
+void HLSL2GLSLConverterImpl::ConversionStream::PrepareTokens()
+{
+    Uint32 ShaderStorageBlockBinding = 0;
 
     auto Token = m_Tokens.begin();
     // Process constant buffers, fix floating point constants,
@@ -4717,7 +4921,7 @@ String HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryPoint,
                 // WARNING: 0:259: Only GLSL version > 110 allows postfix "F" or "f" for float
                 // even when compiling for GL 4.3 AND the code IS UNDER #if 0
                 if (Token->Literal.back() == 'f' || Token->Literal.back() == 'F')
-                    Token->Literal.pop_back();
+                    Token->Literal = m_ConversionText.Copy(Token->Literal.c_str(), Token->Literal.length() - 1);
                 ++Token;
                 break;
 
@@ -4736,6 +4940,34 @@ String HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryPoint,
         }
     }
 
+    // Find all samplers in the global scope
+    Token = m_Tokens.begin();
+    ParseSamplers(Token, m_GlobalSamplers);
+    VERIFY_EXPR(Token == m_Tokens.end());
+}
+
+String HLSL2GLSLConverterImpl::ConversionStream::ConvertTokens(const Char* EntryPoint,
+                                                               SHADER_TYPE ShaderType,
+                                                               const char* SamplerSuffix,
+                                                               bool        UseInOutLocationQualifiers)
+{
+    if (!m_bTokensPrepared)
+    {
+        Tokenize(m_Source);
+        // Tokens keep their own copies of the text
+        String{}.swap(m_Source);
+
+        PrepareTokens();
+        // Tokens modified by PrepareTokens() must outlive the conversion
+        m_SourceText.Adopt(m_ConversionText);
+        m_bTokensPrepared = true;
+    }
+
+    m_bUseInOutLocationQualifiers = UseInOutLocationQualifiers;
+    TokenListType TokensCopy(m_bPreserveTokens ? m_Tokens : TokenListType());
+
+    Uint32 ImageBinding = 0;
+
     auto ShaderEntryPointToken = m_Tokens.end();
     // Process textures and search for the shader entry point.
     // GLSL does not allow local variables of sampler type, so the
@@ -4745,16 +4977,12 @@ String HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryPoint,
         TokenListType::iterator      FunctionStart = m_Tokens.end();
         std::vector<SamplerHashType> Samplers;
 
-        // Find all samplers in the global scope
-        Samplers.emplace_back();
+        Samplers.emplace_back(m_GlobalSamplers);
         m_Objects.emplace_back();
-        Token = m_Tokens.begin();
-        ParseSamplers(Token, Samplers.back());
-        VERIFY_EXPR(Token == m_Tokens.end());
 
         Int32 ScopeDepth = 0;
 
-        Token = m_Tokens.begin();
+        auto Token = m_Tokens.begin();
         while (Token != m_Tokens.end())
         {
             // Detect global function declaration by looking for the pattern
@@ -4912,14 +5140,13 @@ String HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryPoint,
 
     if (m_bPreserveTokens)
     {
+        // Struct definitions remain valid as the copy preserves node indices
         m_Tokens.swap(TokensCopy);
-        m_StructDefinitions.clear();
         m_Objects.clear();
+        // Prepared tokens only reference the source text
+        m_ConversionText.Clear();
     }
 
-    if (IncludeDefintions)
-        GLSLSource.insert(0, g_GLSLDefinitions);
-
     return GLSLSource;
 }
 
@@ -103,6 +103,9 @@ public:
 
     static bool IsPathAbsolute(const Diligent::Char* strPath);
 
+    /// Renames the file, replacing the file with the new name if it exists.
+    static bool RenameFile(const Diligent::Char* strOldPath, const Diligent::Char* strNewPath);
+
 protected:
     static Diligent::String m_strWorkingDirectory;
 };
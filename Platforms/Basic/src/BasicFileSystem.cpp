@@ -28,6 +28,7 @@
 #include "BasicFileSystem.hpp"
 #include "DebugUtilities.hpp"
 #include <algorithm>
+#include <cstdio>
 
 Diligent::String BasicFileSystem::m_strWorkingDirectory;
 
@@ -141,3 +142,12 @@ bool BasicFileSystem::IsPathAbsolute(const Diligent::Char* strPath)
 #    error Unknown platform.
 #endif
 }
+
+bool BasicFileSystem::RenameFile(const Diligent::Char* strOldPath, const Diligent::Char* strNewPath)
+{
+#if PLATFORM_WIN32 || PLATFORM_UNIVERSAL_WINDOWS
+    // On Windows, rename() fails if the file with the new name exists
+    std::remove(strNewPath);
+#endif
+    return std::rename(strOldPath, strNewPath) == 0;
+}
@@ -0,0 +1,253 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+// Replays synthetic allocation traces on VariableSizeAllocationsManager and TLSFAllocationsManager
+// and reports the replay time, the number of failed allocations and the fragmentation of the free space.
+//
+// Usage: AllocationsManagerBenchmark [NumOps]
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "TLSFAllocationsManager.hpp"
+#include "VariableSizeAllocationsManager.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "Timer.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+struct AllocationTrace
+{
+    struct Operation
+    {
+        Uint32 Id;
+        Uint32 Size; // 0 for deallocation
+        Uint32 Alignment;
+    };
+
+    const char*            Name     = nullptr;
+    size_t                 PoolSize = 0;
+    Uint32                 NumIds   = 0;
+    std::vector<Operation> Ops;
+};
+
+struct TraceReplayResult
+{
+    double Time              = 0;
+    size_t NumFailedAllocs   = 0;
+    size_t NumFreeBlocks     = 0;
+    size_t FreeSize          = 0;
+    size_t MaxFreeBlockSize  = 0;
+    size_t PeakNumFreeBlocks = 0;
+};
+
+// Random-lifetime allocations whose sizes follow the log-uniform distribution
+AllocationTrace CreateRandomTrace(const char* Name, size_t PoolSize, Uint32 MinSizeLog2, Uint32 MaxSizeLog2, Uint32 MaxAlignmentLog2, Uint32 NumLiveAllocs, Uint32 NumOps)
+{
+    AllocationTrace Trace;
+    Trace.Name     = Name;
+    Trace.PoolSize = PoolSize;
+
+    std::mt19937        Gen{1};
+    std::vector<Uint32> LiveIds;
+    while (Trace.Ops.size() < NumOps)
+    {
+        if (LiveIds.size() < NumLiveAllocs && (LiveIds.empty() || Gen() % 2 == 0))
+        {
+            const auto SizeLog2 = MinSizeLog2 + Gen() % (MaxSizeLog2 - MinSizeLog2 + 1);
+            const auto Size     = static_cast<Uint32>((1u << SizeLog2) + Gen() % (1u << SizeLog2));
+            const auto Id       = Trace.NumIds++;
+            Trace.Ops.push_back({Id, Size, 1u << static_cast<Uint32>(Gen() % (MaxAlignmentLog2 + 1))});
+            LiveIds.push_back(Id);
+        }
+        else
+        {
+            const auto Idx = Gen() % LiveIds.size();
+            Trace.Ops.push_back({LiveIds[Idx], 0, 0});
+            LiveIds[Idx] = LiveIds.back();
+            LiveIds.pop_back();
+        }
+    }
+    return Trace;
+}
+
+// Per-frame allocations that are released several frames later, similar to dynamic upload heaps
+AllocationTrace CreateFrameTrace(const char* Name, size_t PoolSize, Uint32 NumFrames, Uint32 AllocsPerFrame, Uint32 FrameLatency)
+{
+    AllocationTrace Trace;
+    Trace.Name     = Name;
+    Trace.PoolSize = PoolSize;
+
+    std::mt19937                     Gen{2};
+    std::vector<std::vector<Uint32>> FrameIds(FrameLatency);
+    for (Uint32 Frame = 0; Frame < NumFrames; ++Frame)
+    {
+        // Release allocations made FrameLatency frames ago in random order
+        auto& Ids = FrameIds[Frame % FrameLatency];
+        std::shuffle(Ids.begin(), Ids.end(), Gen);
+        for (auto Id : Ids)
+            Trace.Ops.push_back({Id, 0, 0});
+        Ids.clear();
+
+        const auto NumAllocs = AllocsPerFrame / 2 + Gen() % AllocsPerFrame;
+        for (Uint32 a = 0; a < NumAllocs; ++a)
+        {
+            const auto Size = 256u << static_cast<Uint32>(Gen() % 8);
+            Ids.push_back(Trace.NumIds);
+            Trace.Ops.push_back({Trace.NumIds++, Size, 256});
+        }
+    }
+    return Trace;
+}
+
+template <typename AllocationsManagerType>
+TraceReplayResult ReplayTrace(const AllocationTrace& Trace)
+{
+    using Allocation = typename AllocationsManagerType::Allocation;
+
+    TraceReplayResult Result;
+
+    AllocationsManagerType  ListMgr(Trace.PoolSize, DefaultRawMemoryAllocator::GetAllocator());
+    std::vector<Allocation> Allocs(Trace.NumIds);
+
+    // The number of free blocks is sampled separately, so that it does not affect the time
+    Timer T;
+    for (const auto& Op : Trace.Ops)
+    {
+        auto& Alloc = Allocs[Op.Id];
+        if (Op.Size != 0)
+        {
+            Alloc = ListMgr.Allocate(Op.Size, Op.Alignment);
+            if (!Alloc.IsValid())
+                ++Result.NumFailedAllocs;
+        }
+        else if (Alloc.IsValid())
+        {
+            ListMgr.Free(std::move(Alloc));
+        }
+    }
+    Result.Time = T.GetElapsedTime();
+
+    Result.NumFreeBlocks    = ListMgr.GetNumFreeBlocks();
+    Result.FreeSize         = ListMgr.GetFreeSize();
+    Result.MaxFreeBlockSize = ListMgr.GetMaxFreeBlockSize();
+
+    for (auto& Alloc : Allocs)
+    {
+        if (Alloc.IsValid())
+            ListMgr.Free(std::move(Alloc));
+    }
+
+    return Result;
+}
+
+template <typename AllocationsManagerType>
+size_t GetPeakNumFreeBlocks(const AllocationTrace& Trace)
+{
+    using Allocation = typename AllocationsManagerType::Allocation;
+
+    AllocationsManagerType  ListMgr(Trace.PoolSize, DefaultRawMemoryAllocator::GetAllocator());
+    std::vector<Allocation> Allocs(Trace.NumIds);
+
+    size_t PeakNumFreeBlocks = 0;
+    for (const auto& Op : Trace.Ops)
+    {
+        auto& Alloc = Allocs[Op.Id];
+        if (Op.Size != 0)
+            Alloc = ListMgr.Allocate(Op.Size, Op.Alignment);
+        else if (Alloc.IsValid())
+            ListMgr.Free(std::move(Alloc));
+        PeakNumFreeBlocks = std::max(PeakNumFreeBlocks, ListMgr.GetNumFreeBlocks());
+    }
+
+    for (auto& Alloc : Allocs)
+    {
+        if (Alloc.IsValid())
+            ListMgr.Free(std::move(Alloc));
+    }
+
+    return PeakNumFreeBlocks;
+}
+
+template <typename AllocationsManagerType>
+TraceReplayResult Measure(const AllocationTrace& Trace)
+{
+    // Warm up
+    ReplayTrace<AllocationsManagerType>(Trace);
+
+    auto Result              = ReplayTrace<AllocationsManagerType>(Trace);
+    Result.PeakNumFreeBlocks = GetPeakNumFreeBlocks<AllocationsManagerType>(Trace);
+    return Result;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const auto NumOps = static_cast<Uint32>(argc > 1 ? std::max(atoi(argv[1]), 256) : 1000000);
+
+    const AllocationTrace Traces[] = //
+        {
+            CreateRandomTrace("Small buffers", size_t{4} << 20, 4, 10, 4, 4096, NumOps),
+            CreateRandomTrace("Mixed resources", size_t{256} << 20, 8, 20, 16, 512, NumOps),
+            CreateRandomTrace("High pressure", size_t{16} << 20, 8, 16, 8, 1024, NumOps),
+            CreateFrameTrace("Frame upload heap", size_t{64} << 20, NumOps / 256, 128, 3),
+        };
+
+    std::cout << "Operations: " << NumOps << "\n\n";
+    std::cout << std::left << std::setw(20) << "Trace" << std::setw(10) << "Manager" << std::right
+              << std::setw(12) << "Time, ms" << std::setw(12) << "Mops/s" << std::setw(10) << "Failed"
+              << std::setw(14) << "Free blocks" << std::setw(14) << "Peak blocks" << std::setw(16) << "Fragmentation" << '\n';
+
+    auto Report = [](const AllocationTrace& Trace, const char* Manager, const TraceReplayResult& Res) {
+        // External fragmentation: the share of the free space that is not in the largest free block
+        const auto Fragmentation = Res.FreeSize > 0 ? 1.0 - static_cast<double>(Res.MaxFreeBlockSize) / static_cast<double>(Res.FreeSize) : 0.0;
+
+        std::cout << std::left << std::setw(20) << Trace.Name << std::setw(10) << Manager << std::right << std::fixed
+                  << std::setprecision(2) << std::setw(12) << Res.Time * 1000.0
+                  << std::setw(12) << Trace.Ops.size() / Res.Time * 1e-6
+                  << std::setw(10) << Res.NumFailedAllocs
+                  << std::setw(14) << Res.NumFreeBlocks
+                  << std::setw(14) << Res.PeakNumFreeBlocks
+                  << std::setprecision(1) << std::setw(15) << Fragmentation * 100.0 << "%\n";
+    };
+
+    for (const auto& Trace : Traces)
+    {
+        Report(Trace, "VarSize", Measure<VariableSizeAllocationsManager>(Trace));
+        Report(Trace, "TLSF", Measure<TLSFAllocationsManager>(Trace));
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,137 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+// Compares the throughput of the per-box GetBoxVisibility() function with the batched
+// GetBoxesVisibility() and GetBoxesVisibilityMask() functions.
+//
+// Usage: BoxVisibilityBenchmark [NumBoxes] [NumIterations]
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "AdvancedMath.hpp"
+#include "Timer.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+template <typename FuncType>
+double Measure(int NumIterations, FuncType Func)
+{
+    // Warm up
+    Func();
+
+    Timer T;
+    for (int i = 0; i < NumIterations; ++i)
+        Func();
+    return T.GetElapsedTime() / NumIterations;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const auto NumBoxes      = static_cast<size_t>(argc > 1 ? std::max(atoi(argv[1]), 1) : 200000);
+    const auto NumIterations = argc > 2 ? std::max(atoi(argv[2]), 1) : 100;
+
+    const auto ViewProj = float4x4::Translation(0.f, 0.f, 10.f) * float4x4::Projection(PI_F / 4.f, 16.f / 9.f, 1.f, 1000.f, false);
+
+    ViewFrustumExt Frustum;
+    ExtractViewFrustumPlanesFromMatrix(ViewProj, Frustum, false);
+
+    std::vector<BoundBox> BoxesAoS(NumBoxes);
+    std::vector<float>    MinX(NumBoxes), MinY(NumBoxes), MinZ(NumBoxes), MaxX(NumBoxes), MaxY(NumBoxes), MaxZ(NumBoxes);
+
+    std::mt19937                          Gen{0};
+    std::uniform_real_distribution<float> PosDistr{-500.f, 500.f};
+    std::uniform_real_distribution<float> SizeDistr{0.1f, 10.f};
+    for (size_t i = 0; i < NumBoxes; ++i)
+    {
+        auto& Box = BoxesAoS[i];
+        Box.Min   = float3{PosDistr(Gen), PosDistr(Gen), PosDistr(Gen)};
+        Box.Max   = Box.Min + float3{SizeDistr(Gen), SizeDistr(Gen), SizeDistr(Gen)};
+
+        MinX[i] = Box.Min.x;
+        MinY[i] = Box.Min.y;
+        MinZ[i] = Box.Min.z;
+        MaxX[i] = Box.Max.x;
+        MaxY[i] = Box.Max.y;
+        MaxZ[i] = Box.Max.z;
+    }
+
+    BoundBoxArrays Boxes;
+    Boxes.MinX = MinX.data();
+    Boxes.MinY = MinY.data();
+    Boxes.MinZ = MinZ.data();
+    Boxes.MaxX = MaxX.data();
+    Boxes.MaxY = MaxY.data();
+    Boxes.MaxZ = MaxZ.data();
+
+    std::vector<BoxVisibility> Visibility(NumBoxes);
+    std::vector<Uint32>        VisibilityMask((NumBoxes + 31) / 32);
+
+    std::cout << "Boxes: " << NumBoxes << "\nIterations: " << NumIterations << "\n\n";
+    std::cout << std::left << std::setw(36) << "Test" << std::right << std::setw(12) << "Time, ms" << std::setw(16) << "MBoxes/s" << '\n';
+
+    auto Report = [NumBoxes](const char* Name, double Time) {
+        std::cout << std::left << std::setw(36) << Name << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(12) << Time * 1000.0 << std::setprecision(1) << std::setw(16) << NumBoxes / Time * 1e-6 << '\n';
+    };
+
+    Report("GetBoxVisibility (ViewFrustum)", Measure(NumIterations, [&]() {
+               for (size_t i = 0; i < NumBoxes; ++i)
+                   Visibility[i] = GetBoxVisibility(static_cast<const ViewFrustum&>(Frustum), BoxesAoS[i]);
+           }));
+
+    Report("GetBoxesVisibility (ViewFrustum)", Measure(NumIterations, [&]() {
+               GetBoxesVisibility(static_cast<const ViewFrustum&>(Frustum), Boxes, NumBoxes, Visibility.data());
+           }));
+
+    Report("GetBoxesVisibilityMask (ViewFrustum)", Measure(NumIterations, [&]() {
+               GetBoxesVisibilityMask(static_cast<const ViewFrustum&>(Frustum), Boxes, NumBoxes, VisibilityMask.data());
+           }));
+
+    Report("GetBoxVisibility (ViewFrustumExt)", Measure(NumIterations, [&]() {
+               for (size_t i = 0; i < NumBoxes; ++i)
+                   Visibility[i] = GetBoxVisibility(Frustum, BoxesAoS[i]);
+           }));
+
+    Report("GetBoxesVisibility (ViewFrustumExt)", Measure(NumIterations, [&]() {
+               GetBoxesVisibility(Frustum, Boxes, NumBoxes, Visibility.data());
+           }));
+
+    const auto NumVisible = std::count_if(Visibility.begin(), Visibility.end(), [](BoxVisibility Vis) { return Vis != BoxVisibility::Invisible; });
+    std::cout << "\nVisible boxes: " << NumVisible << '\n';
+
+    return EXIT_SUCCESS;
+}
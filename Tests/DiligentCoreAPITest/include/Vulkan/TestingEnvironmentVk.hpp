@@ -28,12 +28,17 @@
 #pragma once
 
 #include <array>
+#include <functional>
+#include <vector>
 
 #include "TestingEnvironment.hpp"
+#include "EngineFactoryVk.h"
 
 #define VK_NO_PROTOTYPES
 #include "vulkan/vulkan.h"
 
+#include "RenderDeviceVk.h"
+
 namespace Diligent
 {
 
@@ -48,6 +53,16 @@ public:
 
     static TestingEnvironmentVk* GetInstance() { return ValidatedCast<TestingEnvironmentVk>(TestingEnvironment::GetInstance()); }
 
+    // Returns the create info of the environment's device. The device uses the default engine
+    // configuration except for the settings that all tests depend on.
+    static EngineVkCreateInfo GetEngineCreateInfo();
+
+    // Creates a separate device with the immediate context and CreateInfo.NumDeferredContexts deferred
+    // contexts. ppContexts must point to an array of 1 + CreateInfo.NumDeferredContexts elements.
+    static void CreateDevice(const EngineVkCreateInfo& CreateInfo,
+                             IRenderDevice**           ppDevice,
+                             IDeviceContext**          ppContexts);
+
     void CreateImage2D(uint32_t          Width,
                        uint32_t          Height,
                        VkFormat          vkFormat,
@@ -101,6 +116,32 @@ private:
     VkPhysicalDeviceMemoryProperties m_MemoryProperties = {};
 };
 
+// Base fixture for the tests of optional engine features. Every test suite runs on its own device,
+// so that the suite can enable the features without changing the configuration of the other tests.
+class DedicatedDeviceVkTest : public ::testing::Test
+{
+protected:
+    using ModifyEngineCIType = std::function<void(EngineVkCreateInfo&)>;
+
+    // Creates the device of the test suite. The derived fixture calls this method from its own
+    // SetUpTestSuite() and adjusts the create info returned by TestingEnvironmentVk::GetEngineCreateInfo()
+    // in ModifyEngineCI. The device is not created if the testing environment does not use Vulkan.
+    static void SetUpTestSuite(const ModifyEngineCIType& ModifyEngineCI);
+    static void TearDownTestSuite();
+
+    // Skips the test if the device has not been created
+    void SetUp() override;
+    // Releases the resources that were used by the test
+    void TearDown() override;
+
+    // Copies the buffer into a staging buffer and compares its contents with the reference data
+    static void VerifyBufferData(IBuffer* pBuffer, const std::vector<Uint32>& RefData);
+
+    static RefCntAutoPtr<IRenderDeviceVk>             sm_pDevice;
+    static RefCntAutoPtr<IDeviceContext>              sm_pContext;
+    static std::vector<RefCntAutoPtr<IDeviceContext>> sm_pDeferredContexts;
+};
+
 } // namespace Testing
 
 } // namespace Diligent
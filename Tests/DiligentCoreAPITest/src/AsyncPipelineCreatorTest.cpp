@@ -0,0 +1,128 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "TestingEnvironment.hpp"
+#include "AsyncPipelineCreator.hpp"
+#if D3D12_SUPPORTED
+#    include "D3D12/D3D12DebugLayerSetNameBugWorkaround.hpp"
+#endif
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static const char g_ShaderSource[] = R"(
+void VSMain(out float4 pos : SV_POSITION)
+{
+	pos = float4(0.0, 0.0, 0.0, 0.0);
+}
+
+void PSMain(out float4 col : SV_TARGET)
+{
+	col = float4(0.0, 0.0, 0.0, 0.0);
+}
+)";
+
+TEST(AsyncPipelineCreatorTest, CreateShadersAndPSOs)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+#if D3D12_SUPPORTED
+    D3D12DebugLayerSetNameBugWorkaround D3D12DebugLayerBugWorkaround(pDevice);
+#endif
+
+    TestingEnvironment::ScopedReleaseResources AutoResetEnvironment;
+
+    AsyncPipelineCreator Creator{pDevice};
+    if (pDevice->GetDeviceCaps().Features.MultithreadedResourceCreation)
+        EXPECT_GT(Creator.GetNumThreads(), 0u);
+    else
+        EXPECT_EQ(Creator.GetNumThreads(), 0u);
+
+    constexpr Uint32 NumPSOs = 16;
+
+    std::vector<ShaderCreateInfo> ShaderCIs(NumPSOs * 2);
+    for (Uint32 i = 0; i < NumPSOs; ++i)
+    {
+        auto& VSCI                      = ShaderCIs[i * 2 + 0];
+        VSCI.Source                     = g_ShaderSource;
+        VSCI.EntryPoint                 = "VSMain";
+        VSCI.Desc.ShaderType            = SHADER_TYPE_VERTEX;
+        VSCI.Desc.Name                  = "TrivialVS (AsyncPipelineCreatorTest)";
+        VSCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+        VSCI.UseCombinedTextureSamplers = true;
+
+        auto& PSCI           = ShaderCIs[i * 2 + 1];
+        PSCI                 = VSCI;
+        PSCI.EntryPoint      = "PSMain";
+        PSCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
+        PSCI.Desc.Name       = "TrivialPS (AsyncPipelineCreatorTest)";
+    }
+
+    auto ShaderFutures = Creator.CreateShaders(ShaderCIs.data(), static_cast<Uint32>(ShaderCIs.size()));
+    ASSERT_EQ(ShaderFutures.size(), ShaderCIs.size());
+
+    std::vector<RefCntAutoPtr<IShader>> Shaders;
+    for (auto& Future : ShaderFutures)
+    {
+        Shaders.emplace_back(Future.get());
+        ASSERT_NE(Shaders.back(), nullptr);
+    }
+
+    std::vector<PipelineStateCreateInfo> PSOCreateInfos(NumPSOs);
+    for (Uint32 i = 0; i < NumPSOs; ++i)
+    {
+        auto& PSODesc = PSOCreateInfos[i].PSODesc;
+
+        PSODesc.Name                               = "AsyncPipelineCreatorTest PSO";
+        PSODesc.GraphicsPipeline.pVS               = Shaders[i * 2 + 0];
+        PSODesc.GraphicsPipeline.pPS               = Shaders[i * 2 + 1];
+        PSODesc.GraphicsPipeline.PrimitiveTopology = PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
+        PSODesc.GraphicsPipeline.NumRenderTargets  = 1;
+        PSODesc.GraphicsPipeline.RTVFormats[0]     = TEX_FORMAT_RGBA8_UNORM;
+        PSODesc.GraphicsPipeline.DSVFormat         = TEX_FORMAT_D32_FLOAT;
+    }
+
+    auto PSOFutures = Creator.CreatePipelineStates(PSOCreateInfos.data(), NumPSOs);
+    ASSERT_EQ(PSOFutures.size(), size_t{NumPSOs});
+
+    Creator.WaitForIdle();
+    for (auto& Future : PSOFutures)
+    {
+        auto pPSO = Future.get();
+        EXPECT_NE(pPSO, nullptr) << "Failed to create test PSO";
+    }
+}
+
+} // namespace
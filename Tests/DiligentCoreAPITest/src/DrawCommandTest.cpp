@@ -25,6 +25,8 @@
  *  of the possibility of such damages.
  */
 
+#include <vector>
+
 #include "TestingEnvironment.hpp"
 #include "TestingSwapChainBase.hpp"
 #include "BasicMath.hpp"
@@ -587,6 +589,44 @@ TEST_F(DrawCommandTest, Draw_StartVertex_VBOffset_2xStride)
     Present();
 }
 
+TEST_F(DrawCommandTest, Draw_PSOSwitch_RedundantVBs_2xStride)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    SetRenderTargets(sm_pDrawPSO);
+
+    // clang-format off
+    const Vertex Triangles[] =
+    {
+        {}, {}, {},     // Skip 3 * sizeof(Vertex) using buffer offset
+        {}, {}, {}, {}, // Skip 2 vertices using StartVertexLocation
+        Vert[0], {}, Vert[1], {}, Vert[2], {}, 
+        Vert[3], {}, Vert[4], {}, Vert[5], {}
+    };
+    // clang-format on
+
+    auto     pVB       = CreateVertexBuffer(Triangles, sizeof(Triangles));
+    IBuffer* pVBs[]    = {pVB};
+    Uint32   Offsets[] = {3 * sizeof(Vertex)};
+    pContext->SetVertexBuffers(0, 1, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+
+    // Draw a degenerate triangle with the default stride to commit the vertex buffers
+    pContext->Draw(DrawAttribs{3, DRAW_FLAG_VERIFY_ALL});
+
+    // Setting the same vertex buffers again is filtered out, but the new
+    // pipeline state uses a different stride, so they must be committed again.
+    pContext->SetPipelineState(sm_pDraw_2xStride_PSO);
+    pContext->CommitShaderResources(nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->SetVertexBuffers(0, 1, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+
+    DrawAttribs drawAttrs{6, DRAW_FLAG_VERIFY_ALL};
+    drawAttrs.StartVertexLocation = 2;
+    pContext->Draw(drawAttrs);
+
+    Present();
+}
+
 
 
 // Indexed draw calls (glDrawElements/DrawIndexed)
@@ -1466,4 +1506,106 @@ TEST_F(DrawCommandTest, DrawIndexedInstancedIndirect_FirstInstance_BaseVertex_Fi
     Present();
 }
 
+
+// Multi-draw calls
+
+TEST_F(DrawCommandTest, MultiDraw)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    SetRenderTargets(sm_pDrawPSO);
+
+    // clang-format off
+    const Vertex Triangles[] =
+    {
+        Vert[0], Vert[1], Vert[2],
+        {}, {},
+        Vert[3], Vert[4], Vert[5]
+    };
+    // clang-format on
+
+    auto     pVB       = CreateVertexBuffer(Triangles, sizeof(Triangles));
+    IBuffer* pVBs[]    = {pVB};
+    Uint32   Offsets[] = {0};
+    pContext->SetVertexBuffers(0, 1, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+
+    const MultiDrawItem DrawItems[] = {{3, 1, 0}, {3, 1, 5}};
+
+    MultiDrawAttribs drawAttrs{_countof(DrawItems), DrawItems, DRAW_FLAG_VERIFY_ALL};
+    pContext->MultiDraw(drawAttrs);
+
+    Present();
+}
+
+TEST_F(DrawCommandTest, MultiDrawIndexed_BaseVertex)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    SetRenderTargets(sm_pDrawPSO);
+
+    // clang-format off
+    const Vertex Triangles[] =
+    {
+        {}, {},
+        Vert[0], {}, Vert[1], {}, {}, Vert[2],
+        Vert[3], {}, {}, Vert[5], Vert[4]
+    };
+    Uint32 Indices[] = {0,0,0,0, 2,4,7, 0,0, 6,10,9};
+    // clang-format on
+
+    auto pVB = CreateVertexBuffer(Triangles, sizeof(Triangles));
+    auto pIB = CreateIndexBuffer(Indices, _countof(Indices));
+
+    IBuffer* pVBs[]    = {pVB};
+    Uint32   Offsets[] = {0};
+    pContext->SetVertexBuffers(0, 1, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+    pContext->SetIndexBuffer(pIB, sizeof(Uint32) * 4, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    // The second triangle uses the base vertex and skips two indices
+    const MultiDrawIndexedItem DrawItems[] = {{3, 1, 0, 0}, {3, 1, 5, 2}};
+
+    MultiDrawIndexedAttribs drawAttrs{_countof(DrawItems), DrawItems, VT_UINT32, DRAW_FLAG_VERIFY_ALL};
+    pContext->MultiDrawIndexed(drawAttrs);
+
+    Present();
+}
+
+TEST_F(DrawCommandTest, MultiDrawIndexed_LargeBatch)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    SetRenderTargets(sm_pDrawPSO);
+
+    // clang-format off
+    const Vertex Triangles[] =
+    {
+        Vert[0], Vert[1], Vert[2],
+        Vert[3], Vert[4], Vert[5]
+    };
+    Uint32 Indices[] = {0,1,2, 3,4,5};
+    // clang-format on
+
+    auto pVB = CreateVertexBuffer(Triangles, sizeof(Triangles));
+    auto pIB = CreateIndexBuffer(Indices, _countof(Indices));
+
+    IBuffer* pVBs[]    = {pVB};
+    Uint32   Offsets[] = {0};
+    pContext->SetVertexBuffers(0, 1, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+    pContext->SetIndexBuffer(pIB, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    // Large batches may be recorded as indirect draws by the backend.
+    // Every triangle is drawn many times, which must produce the same image.
+    std::vector<MultiDrawIndexedItem> DrawItems(256);
+    for (size_t i = 0; i < DrawItems.size(); ++i)
+        DrawItems[i] = MultiDrawIndexedItem{3, 1, (i % 2) != 0 ? 3u : 0u};
+
+    MultiDrawIndexedAttribs drawAttrs{static_cast<Uint32>(DrawItems.size()), DrawItems.data(), VT_UINT32, DRAW_FLAG_VERIFY_ALL};
+    pContext->MultiDrawIndexed(drawAttrs);
+
+    Present();
+}
+
 } // namespace
@@ -0,0 +1,178 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <thread>
+#include <vector>
+
+#include "TestingEnvironment.hpp"
+#include "DrawPacketQueue.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+// clang-format off
+const char* DrawPacketQueueTestShaders = R"(
+struct PSInput 
+{ 
+    float4 Pos : SV_POSITION; 
+};
+
+void VSMain(in  uint    VertId : SV_VertexID,
+            out PSInput PSIn) 
+{
+    float4 Pos[3];
+    Pos[0] = float4(-1.0, -0.5, 0.0, 1.0);
+    Pos[1] = float4(-0.5, +0.5, 0.0, 1.0);
+    Pos[2] = float4( 0.0, -0.5, 0.0, 1.0);
+    PSIn.Pos = Pos[VertId];
+}
+
+float4 PSMain(in PSInput PSIn) : SV_Target
+{
+    return float4(0.0, 1.0, 0.0, 1.0);
+}
+)";
+// clang-format on
+
+TEST(DrawPacketQueueTest, SortAndSubmit)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto pRenderTarget = pEnv->CreateTexture("Draw packet queue test render target", TEX_FORMAT_RGBA8_UNORM, BIND_RENDER_TARGET, 256, 256);
+    ASSERT_NE(pRenderTarget, nullptr);
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.UseCombinedTextureSamplers = true;
+    ShaderCI.Source                     = DrawPacketQueueTestShaders;
+
+    RefCntAutoPtr<IShader> pVS;
+    {
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_VERTEX;
+        ShaderCI.EntryPoint      = "VSMain";
+        ShaderCI.Desc.Name       = "Draw packet queue test vertex shader";
+        pDevice->CreateShader(ShaderCI, &pVS);
+        ASSERT_NE(pVS, nullptr);
+    }
+
+    RefCntAutoPtr<IShader> pPS;
+    {
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
+        ShaderCI.EntryPoint      = "PSMain";
+        ShaderCI.Desc.Name       = "Draw packet queue test pixel shader";
+        pDevice->CreateShader(ShaderCI, &pPS);
+        ASSERT_NE(pPS, nullptr);
+    }
+
+    constexpr Uint32 NumPSOs = 3;
+
+    RefCntAutoPtr<IPipelineState> pPSOs[NumPSOs];
+    for (Uint32 i = 0; i < NumPSOs; ++i)
+    {
+        PipelineStateCreateInfo PSOCreateInfo;
+        PipelineStateDesc&      PSODesc = PSOCreateInfo.PSODesc;
+
+        PSODesc.Name = "Draw packet queue test";
+
+        PSODesc.IsComputePipeline                             = false;
+        PSODesc.GraphicsPipeline.NumRenderTargets             = 1;
+        PSODesc.GraphicsPipeline.RTVFormats[0]                = TEX_FORMAT_RGBA8_UNORM;
+        PSODesc.GraphicsPipeline.PrimitiveTopology            = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        PSODesc.GraphicsPipeline.RasterizerDesc.CullMode      = CULL_MODE_NONE;
+        PSODesc.GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+        PSODesc.GraphicsPipeline.pVS                          = pVS;
+        PSODesc.GraphicsPipeline.pPS                          = pPS;
+        pDevice->CreatePipelineState(PSOCreateInfo, &pPSOs[i]);
+        ASSERT_NE(pPSOs[i], nullptr);
+    }
+
+    ITextureView* pRTVs[] = {pRenderTarget->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET)};
+    pContext->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    constexpr Uint32 NumThreads          = 4;
+    constexpr Uint32 NumPacketsPerThread = 3000;
+
+    DrawPacketQueue Queue{NumThreads, 2};
+    ASSERT_EQ(Queue.GetNumBuckets(), NumThreads);
+
+    // Every thread pushes packets with interleaved pipeline states. After sorting,
+    // packets that use the same pipeline state must be submitted together.
+    std::vector<std::thread> Threads;
+    for (Uint32 t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back(
+            [&, t]() //
+            {
+                Queue.Reserve(t, NumPacketsPerThread);
+                for (Uint32 i = 0; i < NumPacketsPerThread; ++i)
+                {
+                    const auto PSOIdx = (i + t) % NumPSOs;
+
+                    DrawPacket Packet;
+                    Packet.pPSO                 = pPSOs[PSOIdx];
+                    Packet.NumVerticesOrIndices = 3;
+                    Queue.Push(t, (Uint64{PSOIdx} << 32) | i, Packet);
+                }
+            });
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    EXPECT_EQ(Queue.GetNumPackets(), size_t{NumThreads * NumPacketsPerThread});
+
+    DeviceContextStateStats StartCtxStats;
+    pContext->GetStateStats(StartCtxStats);
+
+    const auto Stats = Queue.Submit(pContext);
+    EXPECT_EQ(Stats.NumPackets, NumThreads * NumPacketsPerThread);
+    EXPECT_EQ(Stats.NumPipelineStateChanges, NumPSOs);
+    EXPECT_EQ(Stats.NumPipelineStateChangesAvoided, NumThreads * NumPacketsPerThread - NumPSOs);
+    EXPECT_EQ(Stats.NumSRBCommits, 0u);
+    EXPECT_EQ(Stats.NumVertexBufferChanges, 0u);
+    EXPECT_EQ(Stats.NumIndexBufferChanges, 0u);
+    EXPECT_EQ(Queue.GetNumPackets(), size_t{0});
+
+    DeviceContextStateStats CtxStats;
+    pContext->GetStateStats(CtxStats);
+    EXPECT_EQ(CtxStats.PipelineState.Applied - StartCtxStats.PipelineState.Applied, Uint64{NumPSOs});
+
+    // Empty queue must not touch the context
+    const auto EmptyStats = Queue.Submit(pContext);
+    EXPECT_EQ(EmptyStats.NumPackets, 0u);
+    EXPECT_EQ(EmptyStats.NumPipelineStateChanges, 0u);
+}
+
+} // namespace
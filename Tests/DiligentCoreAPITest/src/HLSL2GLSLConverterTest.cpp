@@ -28,6 +28,14 @@
 #include "TestingEnvironment.hpp"
 #include "HLSL2GLSLConverter.h"
 
+#ifdef HLSL2GLSL_CONVERTER_SUPPORTED
+#    include <cstring>
+#    include <vector>
+#    include "HLSL2GLSLConverterImpl.hpp"
+#    include "HLSL2GLSLConversionCache.hpp"
+#    include "FileWrapper.hpp"
+#endif
+
 #include "gtest/gtest.h"
 
 using namespace Diligent;
@@ -132,4 +140,173 @@ TEST(HLSL2GLSLConverterTest, CS_RWBuff)
     EXPECT_NE(pCS, nullptr);
 }
 
+#ifdef HLSL2GLSL_CONVERTER_SUPPORTED
+TEST(HLSL2GLSLConverterTest, ConversionCache)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pShaderSourceFactory;
+    pDevice->GetEngineFactory()->CreateDefaultShaderSourceStreamFactory("shaders/HLSL2GLSLConverter", &pShaderSourceFactory);
+
+    const auto& Converter = HLSL2GLSLConverterImpl::GetInstance();
+
+    struct EntryPointInfo
+    {
+        const char* Name;
+        SHADER_TYPE Type;
+    };
+    const EntryPointInfo EntryPoints[] = {
+        {"TestVS", SHADER_TYPE_VERTEX},
+        {"TestPS", SHADER_TYPE_PIXEL},
+        {"TestVS", SHADER_TYPE_VERTEX} //
+    };
+
+    HLSL2GLSLConversionCache Cache;
+
+    RefCntAutoPtr<IHLSL2GLSLConversionStream> pStream;
+    for (const auto& EntryPoint : EntryPoints)
+    {
+        HLSL2GLSLConverterImpl::ConversionAttribs Attribs;
+        Attribs.pSourceStreamFactory = pShaderSourceFactory;
+        Attribs.InputFileName        = "VS_PS.hlsl";
+        Attribs.EntryPoint           = EntryPoint.Name;
+        Attribs.ShaderType           = EntryPoint.Type;
+        Attribs.IncludeDefinitions   = true;
+
+        const auto RefGLSL = Converter.Convert(Attribs);
+        EXPECT_FALSE(RefGLSL.empty());
+
+        // Conversion from the stream reuses the tokens prepared by the previous conversions
+        Attribs.ppConversionStream = &pStream;
+        EXPECT_EQ(Converter.Convert(Attribs), RefGLSL) << EntryPoint.Name;
+
+        Attribs.pCache = &Cache;
+        EXPECT_EQ(Converter.Convert(Attribs), RefGLSL) << EntryPoint.Name;
+
+        // Definitions are not stored in the cache
+        Attribs.ppConversionStream = nullptr;
+        Attribs.IncludeDefinitions = false;
+        const auto GLSL            = Converter.Convert(Attribs);
+        EXPECT_LT(GLSL.length(), RefGLSL.length());
+        EXPECT_EQ(RefGLSL.compare(RefGLSL.length() - GLSL.length(), GLSL.length(), GLSL), 0) << EntryPoint.Name;
+    }
+
+    const auto Stats = Cache.GetStatistics();
+    EXPECT_EQ(Stats.NumMisses, 2u);
+    EXPECT_EQ(Stats.NumMemoryHits, 4u);
+    EXPECT_EQ(Stats.NumDiskHits, 0u);
+}
+
+const char* ConversionCacheDirectory = "HLSL2GLSLConversionCacheTest";
+
+TEST(HLSL2GLSLConverterTest, ConversionCache_Disk)
+{
+    const Uint64 Key              = 0x4469736B43616368ull;
+    const Uint64 VerificationHash = 0x0123456789ABCDEFull;
+    const String RefGLSL          = "void main()\n{\n}\n";
+
+    {
+        HLSL2GLSLConversionCache Cache{ConversionCacheDirectory};
+        FileSystem::DeleteFile(Cache.GetEntryPath(Key).c_str());
+
+        String GLSL;
+        EXPECT_FALSE(Cache.Find(Key, VerificationHash, GLSL));
+        Cache.Add(Key, VerificationHash, RefGLSL);
+        EXPECT_EQ(Cache.GetStatistics().NumWriteFailures, 0u);
+    }
+
+    // The entry written by the previous cache instance is loaded from disk, and then from memory
+    HLSL2GLSLConversionCache Cache{ConversionCacheDirectory};
+
+    String GLSL;
+    EXPECT_FALSE(Cache.Find(Key, VerificationHash + 1, GLSL));
+    EXPECT_TRUE(Cache.Find(Key, VerificationHash, GLSL));
+    EXPECT_EQ(GLSL, RefGLSL);
+    EXPECT_TRUE(Cache.Find(Key, VerificationHash, GLSL));
+    EXPECT_EQ(GLSL, RefGLSL);
+
+    const auto Stats = Cache.GetStatistics();
+    EXPECT_EQ(Stats.NumMisses, 1u);
+    EXPECT_EQ(Stats.NumDiskHits, 1u);
+    EXPECT_EQ(Stats.NumMemoryHits, 1u);
+
+    FileSystem::DeleteFile(Cache.GetEntryPath(Key).c_str());
+}
+
+TEST(HLSL2GLSLConverterTest, ConversionCache_CorruptEntry)
+{
+    const Uint64 Key              = 0x436F727275707445ull;
+    const Uint64 VerificationHash = 0xFEDCBA9876543210ull;
+    const String RefGLSL          = "void main()\n{\n}\n";
+
+    // Offset of the source length in the entry file
+    constexpr size_t SourceLengthOffset = 32;
+    constexpr size_t HeaderSize         = 40;
+
+    std::vector<Uint8> RefData;
+    String             Path;
+    {
+        HLSL2GLSLConversionCache Cache{ConversionCacheDirectory};
+        Path = Cache.GetEntryPath(Key);
+        Cache.Add(Key, VerificationHash, RefGLSL);
+
+        FileWrapper File{Path.c_str(), EFileAccessMode::Read};
+        CFile*      pFile = File;
+        ASSERT_NE(pFile, nullptr);
+        RefData.resize(pFile->GetSize());
+        ASSERT_TRUE(pFile->Read(RefData.data(), RefData.size()));
+        ASSERT_EQ(RefData.size(), HeaderSize + RefGLSL.length());
+    }
+
+    auto ExpectCorrupted = [&](const std::vector<Uint8>& Data, const char* Case) //
+    {
+        {
+            FileWrapper File{Path.c_str(), EFileAccessMode::Overwrite};
+            CFile*      pFile = File;
+            ASSERT_NE(pFile, nullptr);
+            ASSERT_TRUE(pFile->Write(Data.data(), Data.size()));
+        }
+
+        // Every cache instance starts with empty memory cache, so the entry is read from disk
+        HLSL2GLSLConversionCache Cache{ConversionCacheDirectory};
+
+        String GLSL;
+        EXPECT_FALSE(Cache.Find(Key, VerificationHash, GLSL)) << Case;
+        EXPECT_EQ(Cache.GetStatistics().NumDiskHits, 0u) << Case;
+    };
+
+    ExpectCorrupted(std::vector<Uint8>(RefData.begin(), RefData.begin() + HeaderSize / 2), "Truncated header");
+    ExpectCorrupted(std::vector<Uint8>(RefData.begin(), RefData.end() - 1), "Truncated source");
+
+    {
+        auto         Data         = RefData;
+        const Uint64 SourceLength = ~Uint64{0} >> 1;
+        memcpy(&Data[SourceLengthOffset], &SourceLength, sizeof(SourceLength));
+        ExpectCorrupted(Data, "Invalid source length");
+    }
+
+    {
+        auto Data = RefData;
+        Data.back() ^= 0xFF;
+        ExpectCorrupted(Data, "Invalid source");
+    }
+
+    // The corrupted entry is replaced by the new one
+    {
+        HLSL2GLSLConversionCache Cache{ConversionCacheDirectory};
+        Cache.Add(Key, VerificationHash, RefGLSL);
+    }
+    {
+        HLSL2GLSLConversionCache Cache{ConversionCacheDirectory};
+
+        String GLSL;
+        EXPECT_TRUE(Cache.Find(Key, VerificationHash, GLSL));
+        EXPECT_EQ(GLSL, RefGLSL);
+    }
+
+    FileSystem::DeleteFile(Path.c_str());
+}
+#endif
+
 } // namespace
@@ -34,6 +34,10 @@
 #if D3D12_SUPPORTED
 #    include "D3D12/D3D12DebugLayerSetNameBugWorkaround.hpp"
 #endif
+#if VULKAN_SUPPORTED
+#    include "vulkan/vulkan.h"
+#    include "RenderDeviceVk.h"
+#endif
 
 #include "gtest/gtest.h"
 
@@ -315,4 +319,145 @@ TEST_F(MultithreadedResourceCreationTest, CreateResources)
         t.join();
 }
 
+
+static const char g_SRBTestShaderSource[] = R"(
+Texture2D    g_Texture;
+SamplerState g_Texture_sampler;
+
+void VSMain(out float4 pos : SV_POSITION)
+{
+	pos = float4(0.0, 0.0, 0.0, 0.0);
+}
+
+void PSMain(in float4 pos : SV_POSITION, out float4 col : SV_TARGET)
+{
+	col = g_Texture.Sample(g_Texture_sampler, float2(0.5, 0.5));
+}
+)";
+
+TEST(MultithreadedSRBCreationTest, CreateAndRelease)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (pDevice->GetDeviceCaps().IsGLDevice())
+    {
+        GTEST_SKIP() << "Multithreading resource creation is not supported in OpenGL";
+    }
+
+    TestingEnvironment::ScopedReleaseResources AutoResetEnvironment;
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    {
+        ShaderCreateInfo Attrs;
+        Attrs.Source                     = g_SRBTestShaderSource;
+        Attrs.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+        Attrs.UseCombinedTextureSamplers = true;
+
+        RefCntAutoPtr<IShader> pVS, pPS;
+        Attrs.EntryPoint      = "VSMain";
+        Attrs.Desc.ShaderType = SHADER_TYPE_VERTEX;
+        Attrs.Desc.Name       = "VS (MTSRBCreationTest)";
+        pDevice->CreateShader(Attrs, &pVS);
+        ASSERT_NE(pVS, nullptr);
+
+        Attrs.EntryPoint      = "PSMain";
+        Attrs.Desc.ShaderType = SHADER_TYPE_PIXEL;
+        Attrs.Desc.Name       = "PS (MTSRBCreationTest)";
+        pDevice->CreateShader(Attrs, &pPS);
+        ASSERT_NE(pPS, nullptr);
+
+        PipelineStateCreateInfo PSOCreateInfo;
+        PipelineStateDesc&      PSODesc = PSOCreateInfo.PSODesc;
+
+        PSODesc.Name                               = "MT SRB creation test";
+        PSODesc.GraphicsPipeline.pVS               = pVS;
+        PSODesc.GraphicsPipeline.pPS               = pPS;
+        PSODesc.GraphicsPipeline.PrimitiveTopology = PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
+        PSODesc.GraphicsPipeline.NumRenderTargets  = 1;
+        PSODesc.GraphicsPipeline.RTVFormats[0]     = TEX_FORMAT_RGBA8_UNORM;
+        PSODesc.GraphicsPipeline.DSVFormat         = TEX_FORMAT_D32_FLOAT;
+
+        PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+
+        StaticSamplerDesc StaticSampler{SHADER_TYPE_PIXEL, "g_Texture", SamplerDesc{}};
+        PSODesc.ResourceLayout.NumStaticSamplers = 1;
+        PSODesc.ResourceLayout.StaticSamplers    = &StaticSampler;
+
+        pDevice->CreatePipelineState(PSOCreateInfo, &pPSO);
+        ASSERT_NE(pPSO, nullptr);
+    }
+
+    auto pTexture = pEnv->CreateTexture("MT SRB creation test texture", TEX_FORMAT_RGBA8_UNORM, BIND_SHADER_RESOURCE, 64, 64);
+    ASSERT_NE(pTexture, nullptr);
+    auto* pTexSRV = pTexture->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+
+#if VULKAN_SUPPORTED
+    DescriptorSetAllocationStats   StartStats;
+    RefCntAutoPtr<IRenderDeviceVk> pDeviceVk{pDevice, IID_RenderDeviceVk};
+    if (pDeviceVk)
+        pDeviceVk->GetDescriptorSetAllocationStats(StartStats);
+#endif
+
+#ifdef DILIGENT_DEBUG
+    constexpr Uint32 NumIterations = 5;
+#else
+    constexpr Uint32 NumIterations = 20;
+#endif
+    constexpr Uint32 NumSRBsPerThread = 64;
+
+    const auto NumThreads = std::max(std::thread::hardware_concurrency(), 4u);
+    for (Uint32 iter = 0; iter < NumIterations; ++iter)
+    {
+        std::vector<std::thread> Threads(NumThreads);
+        for (auto& t : Threads)
+        {
+            t = std::thread{
+                [&]() //
+                {
+                    std::vector<RefCntAutoPtr<IShaderResourceBinding>> SRBs(NumSRBsPerThread);
+                    for (auto& pSRB : SRBs)
+                    {
+                        pPSO->CreateShaderResourceBinding(&pSRB, true);
+                        if (!pSRB)
+                        {
+                            ADD_FAILURE() << "Failed to create shader resource binding";
+                            continue;
+                        }
+                        auto* pVar = pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_Texture");
+                        EXPECT_NE(pVar, nullptr);
+                        if (pVar != nullptr)
+                            pVar->Set(pTexSRV);
+                    }
+                    // Release half of the SRBs in reverse order to shuffle the recycle lists
+                    for (size_t i = 0; i < SRBs.size() / 2; ++i)
+                        SRBs[SRBs.size() - 1 - i].Release();
+                } //
+            };
+        }
+        for (auto& t : Threads)
+            t.join();
+
+        // Wait until the GPU is done with the released SRBs so that their resources can be reused
+        pEnv->ReleaseResources();
+        pDevice->IdleGPU();
+        pDevice->ReleaseStaleResources();
+    }
+
+#if VULKAN_SUPPORTED
+    if (pDeviceVk)
+    {
+        DescriptorSetAllocationStats EndStats;
+        pDeviceVk->GetDescriptorSetAllocationStats(EndStats);
+
+        const auto NumAllocations = EndStats.NumAllocations - StartStats.NumAllocations;
+        const auto NumRecycled    = EndStats.NumRecycledSets - StartStats.NumRecycledSets;
+        EXPECT_GE(NumAllocations, Uint64{NumIterations} * NumThreads * NumSRBsPerThread);
+        // Descriptor sets released in the previous iterations must be reused
+        EXPECT_GT(NumRecycled, Uint64{0});
+        EXPECT_EQ(EndStats.NumPoolAllocations - StartStats.NumPoolAllocations + NumRecycled, NumAllocations);
+        LOG_INFO_MESSAGE("Descriptor set allocations: ", NumAllocations, ", recycled: ", NumRecycled);
+    }
+#endif
+}
+
 } // namespace
@@ -0,0 +1,129 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+RefCntAutoPtr<IBuffer> CreateTestBuffer(const char* Name, BIND_FLAGS BindFlags)
+{
+    const Uint32 InitialData[16] = {};
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name          = Name;
+    BuffDesc.Usage         = USAGE_STATIC;
+    BuffDesc.BindFlags     = BindFlags;
+    BuffDesc.uiSizeInBytes = sizeof(InitialData);
+
+    BufferData InitData{InitialData, sizeof(InitialData)};
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    TestingEnvironment::GetInstance()->GetDevice()->CreateBuffer(BuffDesc, &InitData, &pBuffer);
+    return pBuffer;
+}
+
+TEST(RedundantStateFilteringTest, FilterIdenticalState)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+    pContext->InvalidateState();
+
+    auto pVB = CreateTestBuffer("Redundant state filtering test VB", BIND_VERTEX_BUFFER);
+    ASSERT_NE(pVB, nullptr);
+    auto pIB = CreateTestBuffer("Redundant state filtering test IB", BIND_INDEX_BUFFER);
+    ASSERT_NE(pIB, nullptr);
+
+    DeviceContextStateStats StartStats;
+    pContext->GetStateStats(StartStats);
+
+    Viewport VP{0, 0, 128, 128};
+    Rect     ScissorRect{0, 0, 64, 64};
+    IBuffer* pVBs[]     = {pVB};
+    Uint32   Offsets[]  = {0};
+    float    Factors[4] = {0.25f, 0.5f, 0.75f, 1.f};
+    for (Uint32 i = 0; i < 3; ++i)
+    {
+        pContext->SetViewports(1, &VP, 256, 256);
+        pContext->SetScissorRects(1, &ScissorRect, 256, 256);
+        pContext->SetVertexBuffers(0, 1, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+        pContext->SetIndexBuffer(pIB, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pContext->SetBlendFactors(Factors);
+        pContext->SetStencilRef(7);
+    }
+
+    DeviceContextStateStats Stats;
+    pContext->GetStateStats(Stats);
+    EXPECT_EQ(Stats.Viewports.Applied - StartStats.Viewports.Applied, 1u);
+    EXPECT_EQ(Stats.Viewports.Filtered - StartStats.Viewports.Filtered, 2u);
+    EXPECT_EQ(Stats.ScissorRects.Applied - StartStats.ScissorRects.Applied, 1u);
+    EXPECT_EQ(Stats.ScissorRects.Filtered - StartStats.ScissorRects.Filtered, 2u);
+    EXPECT_EQ(Stats.VertexBuffers.Applied - StartStats.VertexBuffers.Applied, 1u);
+    EXPECT_EQ(Stats.VertexBuffers.Filtered - StartStats.VertexBuffers.Filtered, 2u);
+    EXPECT_EQ(Stats.IndexBuffer.Applied - StartStats.IndexBuffer.Applied, 1u);
+    EXPECT_EQ(Stats.IndexBuffer.Filtered - StartStats.IndexBuffer.Filtered, 2u);
+    EXPECT_EQ(Stats.BlendFactors.Applied - StartStats.BlendFactors.Applied, 1u);
+    EXPECT_EQ(Stats.BlendFactors.Filtered - StartStats.BlendFactors.Filtered, 2u);
+    EXPECT_EQ(Stats.StencilRef.Applied - StartStats.StencilRef.Applied, 1u);
+    EXPECT_EQ(Stats.StencilRef.Filtered - StartStats.StencilRef.Filtered, 2u);
+
+    // Changing the state must never be filtered out
+    StartStats = Stats;
+    VP.Width   = 64;
+    Offsets[0] = 16;
+    pContext->SetViewports(1, &VP, 256, 256);
+    // The same viewport for a render target of a different size is a different state
+    pContext->SetViewports(1, &VP, 512, 512);
+    pContext->SetVertexBuffers(0, 1, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+    pContext->SetIndexBuffer(pIB, 4, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->SetIndexBuffer(nullptr, 0, RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+    pContext->GetStateStats(Stats);
+    EXPECT_EQ(Stats.Viewports.Applied - StartStats.Viewports.Applied, 2u);
+    EXPECT_EQ(Stats.VertexBuffers.Applied - StartStats.VertexBuffers.Applied, 1u);
+    EXPECT_EQ(Stats.IndexBuffer.Applied - StartStats.IndexBuffer.Applied, 2u);
+    EXPECT_EQ(Stats.Viewports.Filtered, StartStats.Viewports.Filtered);
+    EXPECT_EQ(Stats.VertexBuffers.Filtered, StartStats.VertexBuffers.Filtered);
+    EXPECT_EQ(Stats.IndexBuffer.Filtered, StartStats.IndexBuffer.Filtered);
+
+    // Invalidating the state resets the cache, so the next call is always applied
+    StartStats = Stats;
+    pContext->Flush();
+    pContext->InvalidateState();
+    pContext->SetViewports(1, &VP, 512, 512);
+    pContext->GetStateStats(Stats);
+    EXPECT_EQ(Stats.Viewports.Applied - StartStats.Viewports.Applied, 1u);
+}
+
+} // namespace
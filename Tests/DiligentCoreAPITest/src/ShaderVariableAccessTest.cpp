@@ -415,6 +415,7 @@ TEST(ShaderResourceLayout, VariableAccess)
             pVar->GetResourceDesc(ResDesc);
             auto pVar2 = pTestPSO->GetStaticVariableByName(SHADER_TYPE_VERTEX, ResDesc.Name);
             EXPECT_EQ(pVar, pVar2);
+            EXPECT_EQ(pVar, pTestPSO->GetStaticVariableByHashedName(SHADER_TYPE_VERTEX, HashedShaderVariableName{ResDesc.Name}));
         }
     }
 
@@ -882,6 +883,7 @@ TEST(ShaderResourceLayout, VariableAccess)
             pVar->GetResourceDesc(ResDesc);
             auto pVar2 = pSRB->GetVariableByName(SHADER_TYPE_VERTEX, ResDesc.Name);
             EXPECT_EQ(pVar, pVar2);
+            EXPECT_EQ(pVar, pSRB->GetVariableByHashedName(SHADER_TYPE_VERTEX, HashedShaderVariableName{ResDesc.Name}));
         }
     }
 
@@ -896,6 +898,7 @@ TEST(ShaderResourceLayout, VariableAccess)
             pVar->GetResourceDesc(ResDesc);
             auto pVar2 = pSRB->GetVariableByName(SHADER_TYPE_PIXEL, ResDesc.Name);
             EXPECT_EQ(pVar, pVar2);
+            EXPECT_EQ(pVar, pSRB->GetVariableByHashedName(SHADER_TYPE_PIXEL, HashedShaderVariableName{ResDesc.Name}));
         }
     }
 
@@ -912,6 +915,8 @@ TEST(ShaderResourceLayout, VariableAccess)
     pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_rwBuff_Dyn")->Set(pFormattedBuffUAV[3]);
     pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_Buffer_Dyn")->Set(pFormattedBuffSRVs[2]);
 
+    EXPECT_EQ(pSRB->GetVariableByHashedName(SHADER_TYPE_PIXEL, HashedShaderVariableName{"g_NonExistingVar"}), nullptr);
+
     {
         LOG_INFO_MESSAGE("No worries about 3 warnings below: testing accessing variables from inactive shader stage");
         auto pNonExistingVar = pSRB->GetVariableByName(SHADER_TYPE_GEOMETRY, "g_NonExistingVar");
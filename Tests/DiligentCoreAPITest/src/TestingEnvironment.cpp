@@ -42,7 +42,7 @@
 #endif
 
 #if VULKAN_SUPPORTED
-#    include "EngineFactoryVk.h"
+#    include "Vulkan/TestingEnvironmentVk.hpp"
 #endif
 
 #if METAL_SUPPORTED
@@ -303,14 +303,7 @@ TestingEnvironment::TestingEnvironment(RENDER_DEVICE_TYPE deviceType, ADAPTER_TY
             }
 #    endif
 
-            EngineVkCreateInfo CreateInfo;
-            CreateInfo.DebugMessageCallback      = MessageCallback;
-            CreateInfo.EnableValidation          = true;
-            CreateInfo.MainDescriptorPoolSize    = VulkanDescriptorPoolSize{64, 64, 256, 256, 64, 32, 32, 32, 32};
-            CreateInfo.DynamicDescriptorPoolSize = VulkanDescriptorPoolSize{64, 64, 256, 256, 64, 32, 32, 32, 32};
-            CreateInfo.UploadHeapPageSize        = 32 * 1024;
-            //CreateInfo.DeviceLocalMemoryReserveSize = 32 << 20;
-            //CreateInfo.HostVisibleMemoryReserveSize = 48 << 20;
+            auto CreateInfo = TestingEnvironmentVk::GetEngineCreateInfo();
 
             CreateInfo.NumDeferredContexts = NumDeferredCtx;
             ppContexts.resize(1 + NumDeferredCtx);
@@ -0,0 +1,348 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <array>
+#include <vector>
+
+#include "Vulkan/TestingEnvironmentVk.hpp"
+
+#include "RenderDeviceVk.h"
+#include "BasicMath.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+constexpr Uint32 NumResources = 4;
+
+// Every invocation reads the texture, the buffer and the sampler whose heap indices are
+// given by the uniform buffer, and writes the texture and buffer values to the output
+static const char* BindlessCS = R"(
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout(set = 0, binding = 0) uniform texture2D g_Textures[];
+layout(set = 0, binding = 0) uniform sampler   g_Samplers[];
+layout(std430, set = 0, binding = 0) readonly buffer BindlessBuffers
+{
+    vec4 Data[];
+} g_Buffers[];
+
+layout(std140) uniform IndicesCB
+{
+    // x - texture index, y - buffer index, z - sampler index
+    uvec4 Indices[4];
+} g_Indices;
+
+layout(std430) buffer g_Output
+{
+    vec4 Values[];
+};
+
+layout(local_size_x = 4, local_size_y = 1, local_size_z = 1) in;
+
+void main()
+{
+    uint  Idx        = gl_GlobalInvocationID.x;
+    uvec4 HeapIdx    = g_Indices.Indices[Idx];
+    Values[Idx * 2u]      = textureLod(sampler2D(g_Textures[nonuniformEXT(HeapIdx.x)], g_Samplers[nonuniformEXT(HeapIdx.z)]), vec2(0.5, 0.5), 0.0);
+    Values[Idx * 2u + 1u] = g_Buffers[nonuniformEXT(HeapIdx.y)].Data[1];
+}
+)";
+
+class BindlessDescriptorHeapVkTest : public DedicatedDeviceVkTest
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        DedicatedDeviceVkTest::SetUpTestSuite(
+            [](EngineVkCreateInfo& CreateInfo) //
+            {
+                CreateInfo.BindlessDescriptorHeapSize[BINDLESS_DESCRIPTOR_RANGE_VK_TEXTURES] = 64;
+                CreateInfo.BindlessDescriptorHeapSize[BINDLESS_DESCRIPTOR_RANGE_VK_BUFFERS]  = 32;
+                CreateInfo.BindlessDescriptorHeapSize[BINDLESS_DESCRIPTOR_RANGE_VK_SAMPLERS] = 8;
+            } //
+        );
+    }
+
+    void SetUp() override
+    {
+        DedicatedDeviceVkTest::SetUp();
+        if (IsSkipped())
+            return;
+
+        for (Uint32 Range = 0; Range < BINDLESS_DESCRIPTOR_RANGE_VK_COUNT; ++Range)
+        {
+            if (sm_pDevice->GetBindlessDescriptorHeapSize(static_cast<BINDLESS_DESCRIPTOR_RANGE_VK>(Range)) == 0)
+                GTEST_SKIP() << "Bindless descriptor heap is not available on this device";
+        }
+    }
+
+    static RefCntAutoPtr<ITexture> CreateTexture(const std::array<Uint8, 4>& Color)
+    {
+        TextureDesc TexDesc;
+        TexDesc.Name      = "Bindless heap test texture";
+        TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+        TexDesc.Width     = 1;
+        TexDesc.Height    = 1;
+        TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+        TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+
+        TextureSubResData SubresData{Color.data(), sizeof(Color)};
+        TextureData       InitData{&SubresData, 1};
+
+        RefCntAutoPtr<ITexture> pTexture;
+        sm_pDevice->CreateTexture(TexDesc, &InitData, &pTexture);
+        return pTexture;
+    }
+
+    static RefCntAutoPtr<IBuffer> CreateBuffer(const float4& Value)
+    {
+        // The shader reads the second element
+        const float4 Data[] = {float4{}, Value};
+
+        BufferDesc BuffDesc;
+        BuffDesc.Name              = "Bindless heap test buffer";
+        BuffDesc.uiSizeInBytes     = sizeof(Data);
+        BuffDesc.BindFlags         = BIND_SHADER_RESOURCE;
+        BuffDesc.Mode              = BUFFER_MODE_STRUCTURED;
+        BuffDesc.ElementByteStride = sizeof(float4);
+
+        BufferData InitData{Data, sizeof(Data)};
+
+        RefCntAutoPtr<IBuffer> pBuffer;
+        sm_pDevice->CreateBuffer(BuffDesc, &InitData, &pBuffer);
+        return pBuffer;
+    }
+};
+
+TEST_F(BindlessDescriptorHeapVkTest, DisabledByDefault)
+{
+    RefCntAutoPtr<IRenderDeviceVk> pEnvDeviceVk{TestingEnvironment::GetInstance()->GetDevice(), IID_RenderDeviceVk};
+    ASSERT_NE(pEnvDeviceVk, nullptr);
+    for (Uint32 Range = 0; Range < BINDLESS_DESCRIPTOR_RANGE_VK_COUNT; ++Range)
+        EXPECT_EQ(pEnvDeviceVk->GetBindlessDescriptorHeapSize(static_cast<BINDLESS_DESCRIPTOR_RANGE_VK>(Range)), 0u);
+}
+
+TEST_F(BindlessDescriptorHeapVkTest, AllocateAndRelease)
+{
+    auto* pEnv = TestingEnvironment::GetInstance();
+
+    auto pTexture = CreateTexture({});
+    ASSERT_NE(pTexture, nullptr);
+    auto* pTexSRV = pTexture->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+    ASSERT_NE(pTexSRV, nullptr);
+
+    auto pBuffer = CreateBuffer(float4{});
+    ASSERT_NE(pBuffer, nullptr);
+    auto* pBuffSRV = pBuffer->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE);
+    ASSERT_NE(pBuffSRV, nullptr);
+
+    RefCntAutoPtr<ISampler> pSampler;
+    sm_pDevice->CreateSampler(SamplerDesc{}, &pSampler);
+    ASSERT_NE(pSampler, nullptr);
+
+    const auto TexIdx = sm_pDevice->AllocateBindlessDescriptor(pTexSRV);
+    const auto BufIdx = sm_pDevice->AllocateBindlessDescriptor(pBuffSRV);
+    const auto SamIdx = sm_pDevice->AllocateBindlessDescriptor(pSampler);
+    ASSERT_NE(TexIdx, INVALID_BINDLESS_DESCRIPTOR_INDEX);
+    ASSERT_NE(BufIdx, INVALID_BINDLESS_DESCRIPTOR_INDEX);
+    ASSERT_NE(SamIdx, INVALID_BINDLESS_DESCRIPTOR_INDEX);
+
+    // Objects that are not shader resource views or samplers cannot be placed into the heap
+    pEnv->SetErrorAllowance(1, "\n\nNo worries, testing invalid bindless descriptor...\n\n");
+    EXPECT_EQ(sm_pDevice->AllocateBindlessDescriptor(pTexture), INVALID_BINDLESS_DESCRIPTOR_INDEX);
+
+    // The released index must not be reused until the GPU is done with it
+    sm_pDevice->ReleaseBindlessDescriptor(BINDLESS_DESCRIPTOR_RANGE_VK_TEXTURES, TexIdx);
+    const auto TexIdx2 = sm_pDevice->AllocateBindlessDescriptor(pTexSRV);
+    ASSERT_NE(TexIdx2, INVALID_BINDLESS_DESCRIPTOR_INDEX);
+    EXPECT_NE(TexIdx2, TexIdx);
+
+    sm_pDevice->ReleaseBindlessDescriptor(BINDLESS_DESCRIPTOR_RANGE_VK_TEXTURES, TexIdx2);
+    sm_pDevice->IdleGPU();
+    sm_pDevice->ReleaseStaleResources();
+    const auto TexIdx3 = sm_pDevice->AllocateBindlessDescriptor(pTexSRV);
+    EXPECT_TRUE(TexIdx3 == TexIdx || TexIdx3 == TexIdx2);
+
+    sm_pDevice->ReleaseBindlessDescriptor(BINDLESS_DESCRIPTOR_RANGE_VK_TEXTURES, TexIdx3);
+    sm_pDevice->ReleaseBindlessDescriptor(BINDLESS_DESCRIPTOR_RANGE_VK_BUFFERS, BufIdx);
+    sm_pDevice->ReleaseBindlessDescriptor(BINDLESS_DESCRIPTOR_RANGE_VK_SAMPLERS, SamIdx);
+    sm_pDevice->IdleGPU();
+}
+
+TEST_F(BindlessDescriptorHeapVkTest, RuntimeArrays)
+{
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_GLSL;
+    ShaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+    ShaderCI.Desc.Name       = "Bindless heap test - CS";
+    ShaderCI.EntryPoint      = "main";
+    ShaderCI.Source          = BindlessCS;
+    RefCntAutoPtr<IShader> pCS;
+    sm_pDevice->CreateShader(ShaderCI, &pCS);
+    ASSERT_NE(pCS, nullptr);
+
+    PipelineStateCreateInfo PSOCreateInfo;
+    PSOCreateInfo.PSODesc.Name                               = "Bindless heap test";
+    PSOCreateInfo.PSODesc.IsComputePipeline                  = true;
+    PSOCreateInfo.PSODesc.ComputePipeline.pCS                = pCS;
+    PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+    RefCntAutoPtr<IPipelineState> pPSO;
+    sm_pDevice->CreatePipelineState(PSOCreateInfo, &pPSO);
+    ASSERT_NE(pPSO, nullptr);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    pPSO->CreateShaderResourceBinding(&pSRB, true);
+    ASSERT_NE(pSRB, nullptr);
+
+    // Runtime arrays are not exposed as shader variables
+    EXPECT_EQ(pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Textures"), nullptr);
+    EXPECT_EQ(pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Buffers"), nullptr);
+    EXPECT_EQ(pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Samplers"), nullptr);
+
+    std::array<RefCntAutoPtr<ITexture>, NumResources> pTextures;
+    std::array<RefCntAutoPtr<IBuffer>, NumResources>  pBuffers;
+    std::array<std::array<Uint8, 4>, NumResources>    TexColors;
+    std::array<float4, NumResources>                  BufferValues;
+    std::array<Uint32, NumResources* 4>               HeapIndices = {};
+
+    RefCntAutoPtr<ISampler> pSampler;
+    sm_pDevice->CreateSampler(SamplerDesc{}, &pSampler);
+    ASSERT_NE(pSampler, nullptr);
+    const auto SamIdx = sm_pDevice->AllocateBindlessDescriptor(pSampler);
+    ASSERT_NE(SamIdx, INVALID_BINDLESS_DESCRIPTOR_INDEX);
+
+    for (Uint32 i = 0; i < NumResources; ++i)
+    {
+        TexColors[i]    = {static_cast<Uint8>(10 + i), static_cast<Uint8>(20 + i), static_cast<Uint8>(30 + i), 255};
+        BufferValues[i] = float4{static_cast<float>(i) + 0.5f, static_cast<float>(i) + 1.5f, static_cast<float>(i) + 2.5f, static_cast<float>(i) + 3.5f};
+
+        pTextures[i] = CreateTexture(TexColors[i]);
+        ASSERT_NE(pTextures[i], nullptr);
+        pBuffers[i] = CreateBuffer(BufferValues[i]);
+        ASSERT_NE(pBuffers[i], nullptr);
+    }
+
+    // Invocation i reads resources allocated in reverse order, so that
+    // the heap indices differ from the invocation indices
+    for (Uint32 i = 0; i < NumResources; ++i)
+    {
+        const auto r           = NumResources - 1 - i;
+        HeapIndices[i * 4 + 0] = sm_pDevice->AllocateBindlessDescriptor(pTextures[r]->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+        HeapIndices[i * 4 + 1] = sm_pDevice->AllocateBindlessDescriptor(pBuffers[r]->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
+        HeapIndices[i * 4 + 2] = SamIdx;
+        ASSERT_NE(HeapIndices[i * 4 + 0], INVALID_BINDLESS_DESCRIPTOR_INDEX);
+        ASSERT_NE(HeapIndices[i * 4 + 1], INVALID_BINDLESS_DESCRIPTOR_INDEX);
+    }
+
+    RefCntAutoPtr<IBuffer> pIndicesCB;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name          = "Bindless heap test indices";
+        BuffDesc.Usage         = USAGE_DEFAULT;
+        BuffDesc.BindFlags     = BIND_UNIFORM_BUFFER;
+        BuffDesc.uiSizeInBytes = sizeof(HeapIndices);
+
+        BufferData InitData{HeapIndices.data(), sizeof(HeapIndices)};
+        sm_pDevice->CreateBuffer(BuffDesc, &InitData, &pIndicesCB);
+        ASSERT_NE(pIndicesCB, nullptr);
+    }
+
+    RefCntAutoPtr<IBuffer> pOutput;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name              = "Bindless heap test output";
+        BuffDesc.Usage             = USAGE_DEFAULT;
+        BuffDesc.BindFlags         = BIND_UNORDERED_ACCESS;
+        BuffDesc.Mode              = BUFFER_MODE_STRUCTURED;
+        BuffDesc.ElementByteStride = sizeof(float4);
+        BuffDesc.uiSizeInBytes     = sizeof(float4) * NumResources * 2;
+        sm_pDevice->CreateBuffer(BuffDesc, nullptr, &pOutput);
+        ASSERT_NE(pOutput, nullptr);
+    }
+
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "IndicesCB")->Set(pIndicesCB);
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Output")->Set(pOutput->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+
+    // Heap descriptors are not tracked by the SRB, so the resources are transitioned explicitly
+    std::vector<StateTransitionDesc> Barriers;
+    for (Uint32 i = 0; i < NumResources; ++i)
+    {
+        Barriers.emplace_back(pTextures[i], RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, true);
+        Barriers.emplace_back(pBuffers[i], RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, true);
+    }
+    sm_pContext->TransitionResourceStates(static_cast<Uint32>(Barriers.size()), Barriers.data());
+
+    sm_pContext->SetPipelineState(pPSO);
+    sm_pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    sm_pContext->DispatchCompute(DispatchComputeAttribs{1, 1, 1});
+
+    RefCntAutoPtr<IBuffer> pStagingBuffer;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name           = "Bindless heap test staging buffer";
+        BuffDesc.Usage          = USAGE_STAGING;
+        BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+        BuffDesc.uiSizeInBytes  = sizeof(float4) * NumResources * 2;
+        sm_pDevice->CreateBuffer(BuffDesc, nullptr, &pStagingBuffer);
+        ASSERT_NE(pStagingBuffer, nullptr);
+    }
+    sm_pContext->CopyBuffer(pOutput, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                            pStagingBuffer, 0, sizeof(float4) * NumResources * 2, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    sm_pContext->WaitForIdle();
+
+    void* pData = nullptr;
+    sm_pContext->MapBuffer(pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+    ASSERT_NE(pData, nullptr);
+    const auto* pValues = reinterpret_cast<const float4*>(pData);
+    for (Uint32 i = 0; i < NumResources; ++i)
+    {
+        const auto r = NumResources - 1 - i;
+
+        const auto& TexValue = pValues[i * 2];
+        for (Uint32 c = 0; c < 4; ++c)
+            EXPECT_NEAR(TexValue[c], static_cast<float>(TexColors[r][c]) / 255.f, 1e-3f) << "Invocation " << i << ", texture component " << c;
+
+        EXPECT_EQ(pValues[i * 2 + 1], BufferValues[r]) << "Invocation " << i;
+    }
+    sm_pContext->UnmapBuffer(pStagingBuffer, MAP_READ);
+
+    for (Uint32 i = 0; i < NumResources; ++i)
+    {
+        sm_pDevice->ReleaseBindlessDescriptor(BINDLESS_DESCRIPTOR_RANGE_VK_TEXTURES, HeapIndices[i * 4 + 0]);
+        sm_pDevice->ReleaseBindlessDescriptor(BINDLESS_DESCRIPTOR_RANGE_VK_BUFFERS, HeapIndices[i * 4 + 1]);
+    }
+    sm_pDevice->ReleaseBindlessDescriptor(BINDLESS_DESCRIPTOR_RANGE_VK_SAMPLERS, SamIdx);
+    sm_pDevice->IdleGPU();
+}
+
+} // namespace
@@ -0,0 +1,379 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+
+#include "Vulkan/TestingEnvironmentVk.hpp"
+
+#include "BufferVk.h"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+class BufferSuballocationVkTest : public DedicatedDeviceVkTest
+{
+protected:
+    // Buffers up to this size are suballocated by the test device
+    static constexpr Uint32 MaxSuballocationSize = 64 << 10;
+
+    static void SetUpTestSuite()
+    {
+        DedicatedDeviceVkTest::SetUpTestSuite(
+            [](EngineVkCreateInfo& CreateInfo) //
+            {
+                CreateInfo.BufferSuballocationMaxSize = MaxSuballocationSize;
+            } //
+        );
+    }
+
+    static RefCntAutoPtr<IBufferVk> CreateBuffer(BIND_FLAGS BindFlags, const std::vector<Uint32>& Data)
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name          = "Buffer suballocation test buffer";
+        BuffDesc.Usage         = USAGE_DEFAULT;
+        BuffDesc.BindFlags     = BindFlags;
+        BuffDesc.uiSizeInBytes = static_cast<Uint32>(Data.size() * sizeof(Data[0]));
+        if (BindFlags & (BIND_SHADER_RESOURCE | BIND_UNORDERED_ACCESS))
+        {
+            BuffDesc.Mode              = BUFFER_MODE_STRUCTURED;
+            BuffDesc.ElementByteStride = sizeof(Data[0]);
+        }
+
+        BufferData InitData;
+        InitData.pData    = Data.data();
+        InitData.DataSize = BuffDesc.uiSizeInBytes;
+
+        RefCntAutoPtr<IBuffer> pBuffer;
+        sm_pDevice->CreateBuffer(BuffDesc, &InitData, &pBuffer);
+        return RefCntAutoPtr<IBufferVk>{pBuffer, IID_BufferVk};
+    }
+
+    // Creates a buffer with the same bind flags as the buffer it is followed by, so that
+    // the next suballocated buffer is placed at a non-zero offset in the shared Vulkan buffer
+    static RefCntAutoPtr<IBufferVk> CreatePaddingBuffer(BIND_FLAGS BindFlags, Uint32 Value)
+    {
+        return CreateBuffer(BindFlags, std::vector<Uint32>(64, Value));
+    }
+};
+
+constexpr Uint32 BufferSuballocationVkTest::MaxSuballocationSize;
+
+// Every work group reads the constant buffer and its own element of the structured buffer
+static const char* ReadBuffersCS = R"(
+#version 450
+
+layout(std140) uniform ConstantsCB
+{
+    uvec4 Value;
+} g_Constants;
+
+layout(std430) readonly buffer InputBuffer
+{
+    uint Values[];
+} g_Input;
+
+layout(std430) buffer OutputBuffer
+{
+    uvec4 Values[];
+} g_Output;
+
+layout(local_size_x = 1, local_size_y = 1, local_size_z = 1) in;
+
+void main()
+{
+    uint Idx = gl_WorkGroupID.x;
+    g_Output.Values[Idx] = g_Constants.Value + uvec4(g_Input.Values[Idx]);
+}
+)";
+
+// Every vertex is drawn as a point into its own pixel of the render target
+static const char* DrawIndicesVS = R"(
+#version 450
+
+layout(location = 0) out float out_Value;
+
+void main()
+{
+    gl_Position  = vec4((float(gl_VertexIndex) + 0.5) / 2.0 - 1.0, 0.0, 0.0, 1.0);
+    gl_PointSize = 1.0;
+    out_Value    = float(gl_VertexIndex + 1);
+}
+)";
+
+static const char* DrawIndicesPS = R"(
+#version 450
+
+layout(location = 0) in float in_Value;
+
+layout(location = 0) out float out_Color;
+
+void main()
+{
+    out_Color = in_Value;
+}
+)";
+
+TEST_F(BufferSuballocationVkTest, SharedVkBuffer)
+{
+    constexpr Uint32 NumBuffers = 16;
+    constexpr auto   BindFlags  = BIND_VERTEX_BUFFER | BIND_INDEX_BUFFER;
+
+    std::vector<RefCntAutoPtr<IBufferVk>> Buffers(NumBuffers);
+    for (Uint32 i = 0; i < NumBuffers; ++i)
+    {
+        Buffers[i] = CreateBuffer(BindFlags, std::vector<Uint32>(i + 1));
+        ASSERT_NE(Buffers[i], nullptr);
+    }
+
+    // The buffers with the same bind flags are placed into the same Vulkan buffer
+    std::vector<std::pair<VkDeviceSize, VkDeviceSize>> Ranges;
+    for (auto& pBuffer : Buffers)
+    {
+        EXPECT_EQ(pBuffer->GetVkBuffer(), Buffers[0]->GetVkBuffer());
+        EXPECT_EQ(reinterpret_cast<VkBuffer>(pBuffer->GetNativeHandle()), Buffers[0]->GetVkBuffer());
+
+        const auto Offset = pBuffer->GetVkBufferOffset();
+        EXPECT_EQ(Offset % 4, 0u) << "Index buffer offset must be a multiple of the index size";
+        Ranges.emplace_back(Offset, Offset + pBuffer->GetDesc().uiSizeInBytes);
+    }
+
+    std::sort(Ranges.begin(), Ranges.end());
+    for (size_t i = 1; i < Ranges.size(); ++i)
+        EXPECT_LE(Ranges[i - 1].second, Ranges[i].first) << "Ranges of suballocated buffers must not overlap";
+
+    // The buffers with other bind flags use different Vulkan buffers
+    auto pUniformBuffer = CreateBuffer(BIND_UNIFORM_BUFFER, std::vector<Uint32>(16));
+    ASSERT_NE(pUniformBuffer, nullptr);
+    EXPECT_NE(pUniformBuffer->GetVkBuffer(), Buffers[0]->GetVkBuffer());
+}
+
+TEST_F(BufferSuballocationVkTest, NotSuballocatedBuffers)
+{
+    auto pSmallBuffer = CreateBuffer(BIND_VERTEX_BUFFER, std::vector<Uint32>(16));
+    ASSERT_NE(pSmallBuffer, nullptr);
+
+    // The buffer is larger than the maximum suballocation size of the test device
+    auto pLargeBuffer = CreateBuffer(BIND_VERTEX_BUFFER, std::vector<Uint32>(MaxSuballocationSize / sizeof(Uint32) + 1));
+    ASSERT_NE(pLargeBuffer, nullptr);
+    EXPECT_NE(pLargeBuffer->GetVkBuffer(), pSmallBuffer->GetVkBuffer());
+    EXPECT_EQ(pLargeBuffer->GetVkBufferOffset(), 0u);
+
+    auto pUAVBuffer0 = CreateBuffer(BIND_UNORDERED_ACCESS, std::vector<Uint32>(16));
+    auto pUAVBuffer1 = CreateBuffer(BIND_UNORDERED_ACCESS, std::vector<Uint32>(16));
+    ASSERT_NE(pUAVBuffer0, nullptr);
+    ASSERT_NE(pUAVBuffer1, nullptr);
+    EXPECT_NE(pUAVBuffer0->GetVkBuffer(), pUAVBuffer1->GetVkBuffer());
+    EXPECT_EQ(pUAVBuffer0->GetVkBufferOffset(), 0u);
+    EXPECT_EQ(pUAVBuffer1->GetVkBufferOffset(), 0u);
+}
+
+TEST_F(BufferSuballocationVkTest, UpdateAndCopy)
+{
+    constexpr Uint32 NumBuffers = 4;
+    constexpr Uint32 NumValues  = 64;
+
+    std::vector<std::vector<Uint32>>      BuffersData(NumBuffers);
+    std::vector<RefCntAutoPtr<IBufferVk>> Buffers(NumBuffers);
+    for (Uint32 i = 0; i < NumBuffers; ++i)
+    {
+        BuffersData[i].resize(NumValues);
+        for (Uint32 j = 0; j < NumValues; ++j)
+            BuffersData[i][j] = i * 1000 + j;
+        Buffers[i] = CreateBuffer(BIND_VERTEX_BUFFER, BuffersData[i]);
+        ASSERT_NE(Buffers[i], nullptr);
+    }
+
+    // Update the first half of buffer 1
+    std::vector<Uint32> UpdateData(NumValues / 2, 0xFFFFFFFFu);
+    sm_pContext->UpdateBuffer(Buffers[1], 0, static_cast<Uint32>(UpdateData.size() * sizeof(Uint32)), UpdateData.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    std::copy(UpdateData.begin(), UpdateData.end(), BuffersData[1].begin());
+
+    // Copy the second half of buffer 0 into the second half of buffer 2
+    constexpr Uint32 HalfSize = NumValues / 2 * sizeof(Uint32);
+    sm_pContext->CopyBuffer(Buffers[0], HalfSize, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                            Buffers[2], HalfSize, HalfSize, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    std::copy(BuffersData[0].begin() + NumValues / 2, BuffersData[0].end(), BuffersData[2].begin() + NumValues / 2);
+
+    // The data of all buffers, including the ones that have not been written, must be intact
+    for (Uint32 i = 0; i < NumBuffers; ++i)
+        VerifyBufferData(Buffers[i], BuffersData[i]);
+}
+
+TEST_F(BufferSuballocationVkTest, DispatchWithOffsets)
+{
+    // The padding buffers hold the values the shader would read if the offsets were ignored
+    auto pConstantsPadding = CreatePaddingBuffer(BIND_UNIFORM_BUFFER, 100);
+    auto pConstants        = CreateBuffer(BIND_UNIFORM_BUFFER, {1, 2, 3, 4});
+    auto pInputPadding     = CreatePaddingBuffer(BIND_SHADER_RESOURCE, 1000);
+    auto pInput            = CreateBuffer(BIND_SHADER_RESOURCE, {10, 20});
+    auto pArgsPadding      = CreatePaddingBuffer(BIND_INDIRECT_DRAW_ARGS, 0);
+    auto pDispatchArgs     = CreateBuffer(BIND_INDIRECT_DRAW_ARGS, {2, 1, 1});
+    auto pOutput           = CreateBuffer(BIND_UNORDERED_ACCESS, std::vector<Uint32>(8));
+    ASSERT_TRUE(pConstantsPadding && pConstants && pInputPadding && pInput && pArgsPadding && pDispatchArgs && pOutput);
+
+    ASSERT_NE(pConstants->GetVkBufferOffset(), 0u);
+    ASSERT_NE(pInput->GetVkBufferOffset(), 0u);
+    ASSERT_NE(pDispatchArgs->GetVkBufferOffset(), 0u);
+    ASSERT_EQ(pConstants->GetVkBuffer(), pConstantsPadding->GetVkBuffer());
+    ASSERT_EQ(pInput->GetVkBuffer(), pInputPadding->GetVkBuffer());
+    ASSERT_EQ(pDispatchArgs->GetVkBuffer(), pArgsPadding->GetVkBuffer());
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_GLSL;
+    ShaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+    ShaderCI.Desc.Name       = "Buffer suballocation test - CS";
+    ShaderCI.EntryPoint      = "main";
+    ShaderCI.Source          = ReadBuffersCS;
+    RefCntAutoPtr<IShader> pCS;
+    sm_pDevice->CreateShader(ShaderCI, &pCS);
+    ASSERT_NE(pCS, nullptr);
+
+    PipelineStateCreateInfo PSOCreateInfo;
+    PSOCreateInfo.PSODesc.Name                               = "Buffer suballocation test - compute";
+    PSOCreateInfo.PSODesc.IsComputePipeline                  = true;
+    PSOCreateInfo.PSODesc.ComputePipeline.pCS                = pCS;
+    PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+    RefCntAutoPtr<IPipelineState> pPSO;
+    sm_pDevice->CreatePipelineState(PSOCreateInfo, &pPSO);
+    ASSERT_NE(pPSO, nullptr);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    pPSO->CreateShaderResourceBinding(&pSRB, true);
+    ASSERT_NE(pSRB, nullptr);
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "ConstantsCB")->Set(pConstants);
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "InputBuffer")->Set(pInput->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "OutputBuffer")->Set(pOutput->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+
+    sm_pContext->SetPipelineState(pPSO);
+    sm_pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    sm_pContext->DispatchComputeIndirect(DispatchComputeIndirectAttribs{RESOURCE_STATE_TRANSITION_MODE_TRANSITION}, pDispatchArgs);
+
+    VerifyBufferData(pOutput, {11, 12, 13, 14, 21, 22, 23, 24});
+}
+
+TEST_F(BufferSuballocationVkTest, DrawWithOffsets)
+{
+    constexpr Uint32 Width = 4;
+
+    // If the offsets were ignored, the draw would use the indices of the padding buffer or draw nothing
+    auto pIndexPadding = CreatePaddingBuffer(BIND_INDEX_BUFFER, 1);
+    auto pIndices      = CreateBuffer(BIND_INDEX_BUFFER, {2, 0});
+    auto pArgsPadding  = CreatePaddingBuffer(BIND_INDIRECT_DRAW_ARGS, 0);
+    // IndexCount, InstanceCount, FirstIndex, VertexOffset, FirstInstance
+    auto pDrawArgs = CreateBuffer(BIND_INDIRECT_DRAW_ARGS, {2, 1, 0, 0, 0});
+    ASSERT_TRUE(pIndexPadding && pIndices && pArgsPadding && pDrawArgs);
+    ASSERT_NE(pIndices->GetVkBufferOffset(), 0u);
+    ASSERT_NE(pDrawArgs->GetVkBufferOffset(), 0u);
+    ASSERT_EQ(pIndices->GetVkBuffer(), pIndexPadding->GetVkBuffer());
+    ASSERT_EQ(pDrawArgs->GetVkBuffer(), pArgsPadding->GetVkBuffer());
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "Buffer suballocation test render target";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = Width;
+    TexDesc.Height    = 1;
+    TexDesc.Format    = TEX_FORMAT_R32_FLOAT;
+    TexDesc.BindFlags = BIND_RENDER_TARGET;
+    RefCntAutoPtr<ITexture> pRenderTarget;
+    sm_pDevice->CreateTexture(TexDesc, nullptr, &pRenderTarget);
+    ASSERT_NE(pRenderTarget, nullptr);
+
+    TexDesc.Name           = "Buffer suballocation test staging texture";
+    TexDesc.Usage          = USAGE_STAGING;
+    TexDesc.BindFlags      = BIND_NONE;
+    TexDesc.CPUAccessFlags = CPU_ACCESS_READ;
+    RefCntAutoPtr<ITexture> pStagingTex;
+    sm_pDevice->CreateTexture(TexDesc, nullptr, &pStagingTex);
+    ASSERT_NE(pStagingTex, nullptr);
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_GLSL;
+    ShaderCI.EntryPoint     = "main";
+
+    RefCntAutoPtr<IShader> pVS;
+    ShaderCI.Desc.ShaderType = SHADER_TYPE_VERTEX;
+    ShaderCI.Desc.Name       = "Buffer suballocation test - VS";
+    ShaderCI.Source          = DrawIndicesVS;
+    sm_pDevice->CreateShader(ShaderCI, &pVS);
+    ASSERT_NE(pVS, nullptr);
+
+    RefCntAutoPtr<IShader> pPS;
+    ShaderCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
+    ShaderCI.Desc.Name       = "Buffer suballocation test - PS";
+    ShaderCI.Source          = DrawIndicesPS;
+    sm_pDevice->CreateShader(ShaderCI, &pPS);
+    ASSERT_NE(pPS, nullptr);
+
+    PipelineStateCreateInfo PSOCreateInfo;
+    PipelineStateDesc&      PSODesc = PSOCreateInfo.PSODesc;
+
+    PSODesc.Name                                          = "Buffer suballocation test - draw";
+    PSODesc.GraphicsPipeline.pVS                          = pVS;
+    PSODesc.GraphicsPipeline.pPS                          = pPS;
+    PSODesc.GraphicsPipeline.NumRenderTargets             = 1;
+    PSODesc.GraphicsPipeline.RTVFormats[0]                = TexDesc.Format;
+    PSODesc.GraphicsPipeline.PrimitiveTopology            = PRIMITIVE_TOPOLOGY_POINT_LIST;
+    PSODesc.GraphicsPipeline.RasterizerDesc.CullMode      = CULL_MODE_NONE;
+    PSODesc.GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+    RefCntAutoPtr<IPipelineState> pPSO;
+    sm_pDevice->CreatePipelineState(PSOCreateInfo, &pPSO);
+    ASSERT_NE(pPSO, nullptr);
+
+    ITextureView* pRTV = pRenderTarget->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
+    sm_pContext->SetRenderTargets(1, &pRTV, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    const float ClearColor[] = {0, 0, 0, 0};
+    sm_pContext->ClearRenderTarget(pRTV, ClearColor, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    sm_pContext->SetPipelineState(pPSO);
+    sm_pContext->SetIndexBuffer(pIndices, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    sm_pContext->DrawIndexedIndirect(DrawIndexedIndirectAttribs{VT_UINT32, DRAW_FLAG_VERIFY_ALL, RESOURCE_STATE_TRANSITION_MODE_TRANSITION}, pDrawArgs);
+    sm_pContext->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+    sm_pContext->CopyTexture(CopyTextureAttribs{pRenderTarget, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, pStagingTex, RESOURCE_STATE_TRANSITION_MODE_TRANSITION});
+    sm_pContext->WaitForIdle();
+
+    MappedTextureSubresource MappedData;
+    sm_pContext->MapTextureSubresource(pStagingTex, 0, 0, MAP_READ, MAP_FLAG_DO_NOT_WAIT, nullptr, MappedData);
+    ASSERT_NE(MappedData.pData, nullptr);
+    std::array<float, Width> Pixels;
+    memcpy(Pixels.data(), MappedData.pData, sizeof(Pixels));
+    sm_pContext->UnmapTextureSubresource(pStagingTex, 0, 0);
+
+    // Only the pixels of the vertices 2 and 0 are drawn
+    const std::array<float, Width> RefPixels = {1, 0, 3, 0};
+    EXPECT_EQ(Pixels, RefPixels);
+}
+
+} // namespace
@@ -0,0 +1,334 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <array>
+#include <cstring>
+#include <vector>
+
+#include "Vulkan/TestingEnvironmentVk.hpp"
+
+#include "RenderDeviceVk.h"
+
+#include "volk/volk.h"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+// The descriptors of the uniform and storage buffers are written from buffer infos,
+// and the descriptor of the texel buffer is written from the buffer view
+static const char* DynamicResourcesCS = R"(
+#version 450
+
+layout(std140) uniform ConstantsCB
+{
+    uvec4 Value;
+} g_Constants;
+
+layout(std430) readonly buffer InputBuffer
+{
+    uvec4 Values[];
+} g_Input;
+
+uniform usamplerBuffer g_TexelBuffer;
+
+layout(std430) buffer OutputBuffer
+{
+    uvec4 Values[];
+} g_Output;
+
+layout(local_size_x = 1, local_size_y = 1, local_size_z = 1) in;
+
+void main()
+{
+    g_Output.Values[0] = g_Constants.Value;
+    g_Output.Values[1] = g_Input.Values[1];
+    g_Output.Values[2] = texelFetch(g_TexelBuffer, 2);
+}
+)";
+
+using OutputValue = std::array<Uint32, 4>;
+
+constexpr Uint32 NumOutputValues = 3;
+
+// Resources that the shader reads through its dynamic variables
+struct InputResources
+{
+    InputResources(IRenderDevice* pDevice, Uint32 BaseValue)
+    {
+        for (Uint32 i = 0; i < NumOutputValues; ++i)
+            RefValues[i] = OutputValue{BaseValue + i * 10 + 1, BaseValue + i * 10 + 2, BaseValue + i * 10 + 3, BaseValue + i * 10 + 4};
+
+        {
+            BufferDesc BuffDesc;
+            BuffDesc.Name          = "Descriptor update template test constants";
+            BuffDesc.Usage         = USAGE_DEFAULT;
+            BuffDesc.BindFlags     = BIND_UNIFORM_BUFFER;
+            BuffDesc.uiSizeInBytes = sizeof(OutputValue);
+
+            BufferData InitData{RefValues[0].data(), sizeof(OutputValue)};
+            pDevice->CreateBuffer(BuffDesc, &InitData, &pConstants);
+        }
+
+        // The value that is read by the shader is not the first one, so that the
+        // descriptor must reference the buffer at the right offset
+        {
+            std::array<OutputValue, 2> Data = {OutputValue{}, RefValues[1]};
+
+            BufferDesc BuffDesc;
+            BuffDesc.Name              = "Descriptor update template test input buffer";
+            BuffDesc.Usage             = USAGE_DEFAULT;
+            BuffDesc.BindFlags         = BIND_SHADER_RESOURCE;
+            BuffDesc.Mode              = BUFFER_MODE_STRUCTURED;
+            BuffDesc.ElementByteStride = sizeof(OutputValue);
+            BuffDesc.uiSizeInBytes     = sizeof(Data);
+
+            BufferData InitData{Data.data(), sizeof(Data)};
+            pDevice->CreateBuffer(BuffDesc, &InitData, &pInput);
+        }
+
+        {
+            std::array<OutputValue, 3> Data = {OutputValue{}, OutputValue{}, RefValues[2]};
+
+            BufferDesc BuffDesc;
+            BuffDesc.Name              = "Descriptor update template test texel buffer";
+            BuffDesc.Usage             = USAGE_DEFAULT;
+            BuffDesc.BindFlags         = BIND_SHADER_RESOURCE;
+            BuffDesc.Mode              = BUFFER_MODE_FORMATTED;
+            BuffDesc.ElementByteStride = sizeof(OutputValue);
+            BuffDesc.uiSizeInBytes     = sizeof(Data);
+
+            BufferData InitData{Data.data(), sizeof(Data)};
+            pDevice->CreateBuffer(BuffDesc, &InitData, &pTexelBuffer);
+            if (pTexelBuffer)
+            {
+                BufferViewDesc ViewDesc;
+                ViewDesc.ViewType             = BUFFER_VIEW_SHADER_RESOURCE;
+                ViewDesc.Format.ValueType     = VT_UINT32;
+                ViewDesc.Format.NumComponents = 4;
+                pTexelBuffer->CreateView(ViewDesc, &pTexelBufferSRV);
+            }
+        }
+    }
+
+    bool IsValid() const
+    {
+        return pConstants && pInput && pTexelBuffer && pTexelBufferSRV;
+    }
+
+    void Bind(IShaderResourceBinding* pSRB)
+    {
+        pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "ConstantsCB")->Set(pConstants);
+        pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "InputBuffer")->Set(pInput->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
+        pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_TexelBuffer")->Set(pTexelBufferSRV);
+    }
+
+    std::array<OutputValue, NumOutputValues> RefValues;
+
+    RefCntAutoPtr<IBuffer>     pConstants;
+    RefCntAutoPtr<IBuffer>     pInput;
+    RefCntAutoPtr<IBuffer>     pTexelBuffer;
+    RefCntAutoPtr<IBufferView> pTexelBufferSRV;
+};
+
+RefCntAutoPtr<IBuffer> CreateOutputBuffer(IRenderDevice* pDevice)
+{
+    BufferDesc BuffDesc;
+    BuffDesc.Name              = "Descriptor update template test output buffer";
+    BuffDesc.Usage             = USAGE_DEFAULT;
+    BuffDesc.BindFlags         = BIND_UNORDERED_ACCESS;
+    BuffDesc.Mode              = BUFFER_MODE_STRUCTURED;
+    BuffDesc.ElementByteStride = sizeof(OutputValue);
+    BuffDesc.uiSizeInBytes     = sizeof(OutputValue) * NumOutputValues;
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+    return pBuffer;
+}
+
+void VerifyOutput(IRenderDevice* pDevice, IDeviceContext* pContext, IBuffer* pOutput, const std::array<OutputValue, NumOutputValues>& RefValues)
+{
+    BufferDesc BuffDesc;
+    BuffDesc.Name           = "Descriptor update template test staging buffer";
+    BuffDesc.Usage          = USAGE_STAGING;
+    BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+    BuffDesc.uiSizeInBytes  = sizeof(RefValues);
+
+    RefCntAutoPtr<IBuffer> pStagingBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pStagingBuffer);
+    ASSERT_NE(pStagingBuffer, nullptr);
+
+    pContext->CopyBuffer(pOutput, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                         pStagingBuffer, 0, sizeof(RefValues), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->WaitForIdle();
+
+    void* pData = nullptr;
+    pContext->MapBuffer(pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+    ASSERT_NE(pData, nullptr);
+    for (Uint32 i = 0; i < NumOutputValues; ++i)
+    {
+        OutputValue Value;
+        memcpy(Value.data(), reinterpret_cast<const OutputValue*>(pData) + i, sizeof(Value));
+        EXPECT_EQ(Value, RefValues[i]) << "Unexpected output value " << i;
+    }
+    pContext->UnmapBuffer(pStagingBuffer, MAP_READ);
+}
+
+// Binds dynamic resources, dispatches the shader and checks the values it has read
+void TestDynamicResources(IRenderDevice* pDevice, IDeviceContext* pContext)
+{
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_GLSL;
+    ShaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+    ShaderCI.Desc.Name       = "Descriptor update template test - CS";
+    ShaderCI.EntryPoint      = "main";
+    ShaderCI.Source          = DynamicResourcesCS;
+    RefCntAutoPtr<IShader> pCS;
+    pDevice->CreateShader(ShaderCI, &pCS);
+    ASSERT_NE(pCS, nullptr);
+
+    PipelineStateCreateInfo PSOCreateInfo;
+    PSOCreateInfo.PSODesc.Name                               = "Descriptor update template test";
+    PSOCreateInfo.PSODesc.IsComputePipeline                  = true;
+    PSOCreateInfo.PSODesc.ComputePipeline.pCS                = pCS;
+    PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
+    RefCntAutoPtr<IPipelineState> pPSO;
+    pDevice->CreatePipelineState(PSOCreateInfo, &pPSO);
+    ASSERT_NE(pPSO, nullptr);
+
+    InputResources Inputs0{pDevice, 0};
+    ASSERT_TRUE(Inputs0.IsValid());
+    InputResources Inputs1{pDevice, 100};
+    ASSERT_TRUE(Inputs1.IsValid());
+
+    RefCntAutoPtr<IBuffer> pOutputs[] = {CreateOutputBuffer(pDevice), CreateOutputBuffer(pDevice)};
+    ASSERT_NE(pOutputs[0], nullptr);
+    ASSERT_NE(pOutputs[1], nullptr);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRBs[2];
+    for (Uint32 i = 0; i < 2; ++i)
+    {
+        pPSO->CreateShaderResourceBinding(&pSRBs[i], true);
+        ASSERT_NE(pSRBs[i], nullptr);
+        pSRBs[i]->GetVariableByName(SHADER_TYPE_COMPUTE, "OutputBuffer")->Set(pOutputs[i]->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+    }
+
+    auto Dispatch = [&](IShaderResourceBinding* pSRB) //
+    {
+        pContext->SetPipelineState(pPSO);
+        pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pContext->DispatchCompute(DispatchComputeAttribs{1, 1, 1});
+    };
+
+    Inputs0.Bind(pSRBs[0]);
+    Dispatch(pSRBs[0]);
+    VerifyOutput(pDevice, pContext, pOutputs[0], Inputs0.RefValues);
+
+    // Dynamic variables may be rebound at any time. The descriptor set written at the next
+    // commit must reference the new resources.
+    Inputs1.Bind(pSRBs[0]);
+    Dispatch(pSRBs[0]);
+    VerifyOutput(pDevice, pContext, pOutputs[0], Inputs1.RefValues);
+
+    // Every commit writes its own dynamic descriptor set, so rebinding the resources
+    // must not affect the dispatches that have already been recorded
+    Inputs0.Bind(pSRBs[1]);
+    Dispatch(pSRBs[0]);
+    Dispatch(pSRBs[1]);
+    Inputs0.Bind(pSRBs[0]);
+    Inputs1.Bind(pSRBs[1]);
+    Dispatch(pSRBs[1]);
+    VerifyOutput(pDevice, pContext, pOutputs[0], Inputs1.RefValues);
+    VerifyOutput(pDevice, pContext, pOutputs[1], Inputs1.RefValues);
+
+    Dispatch(pSRBs[0]);
+    VerifyOutput(pDevice, pContext, pOutputs[0], Inputs0.RefValues);
+}
+
+bool IsDescriptorUpdateTemplateSupported(IRenderDevice* pDevice)
+{
+    RefCntAutoPtr<IRenderDeviceVk> pDeviceVk{pDevice, IID_RenderDeviceVk};
+    if (!pDeviceVk)
+        return false;
+
+    const auto vkPhysicalDevice = pDeviceVk->GetVkPhysicalDevice();
+
+    uint32_t NumExtensions = 0;
+    vkEnumerateDeviceExtensionProperties(vkPhysicalDevice, nullptr, &NumExtensions, nullptr);
+    std::vector<VkExtensionProperties> Extensions(NumExtensions);
+    vkEnumerateDeviceExtensionProperties(vkPhysicalDevice, nullptr, &NumExtensions, Extensions.data());
+    for (const auto& Extension : Extensions)
+    {
+        if (strcmp(Extension.extensionName, VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME) == 0)
+            return true;
+    }
+    return false;
+}
+
+TEST(DescriptorUpdateTemplateVkTest, DynamicResources)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceCaps().IsVulkanDevice())
+        GTEST_SKIP() << "Descriptor update templates are only used in Vulkan";
+    if (!IsDescriptorUpdateTemplateSupported(pDevice))
+        GTEST_SKIP() << VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME << " is not supported by this device";
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    // The device of the testing environment uses descriptor update templates when they are supported
+    TestDynamicResources(pDevice, pEnv->GetDeviceContext());
+}
+
+TEST(DescriptorUpdateTemplateVkTest, DynamicResources_Fallback)
+{
+    auto* pEnv = TestingEnvironment::GetInstance();
+    if (!pEnv->GetDevice()->GetDeviceCaps().IsVulkanDevice())
+        GTEST_SKIP() << "Descriptor update templates are only used in Vulkan";
+
+    auto CreateInfo                            = TestingEnvironmentVk::GetEngineCreateInfo();
+    CreateInfo.EnableDescriptorUpdateTemplates = false;
+
+    RefCntAutoPtr<IRenderDevice>  pDevice;
+    RefCntAutoPtr<IDeviceContext> pContext;
+    TestingEnvironmentVk::CreateDevice(CreateInfo, &pDevice, &pContext);
+    ASSERT_NE(pDevice, nullptr);
+    ASSERT_NE(pContext, nullptr);
+
+    // Every descriptor of the dynamic set is written by vkUpdateDescriptorSets()
+    TestDynamicResources(pDevice, pContext);
+
+    pContext->Flush();
+    pContext->FinishFrame();
+    pDevice->IdleGPU();
+}
+
+} // namespace
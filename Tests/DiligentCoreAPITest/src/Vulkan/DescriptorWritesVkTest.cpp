@@ -0,0 +1,298 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <array>
+#include <thread>
+#include <vector>
+
+#include "Vulkan/TestingEnvironmentVk.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+constexpr Uint32 NumInputs = 8;
+
+constexpr Uint32 NumDeferredContexts = 4;
+
+// Uniform buffer arrays may only be indexed with dynamically uniform expressions
+static const char* CopyInputsCS = R"(
+#version 450
+
+layout(std140) uniform InputCB
+{
+    uvec4 Value;
+} g_Inputs[8];
+
+layout(std430) buffer OutputBuffer
+{
+    uvec4 Values[];
+} g_Output;
+
+layout(local_size_x = 1, local_size_y = 1, local_size_z = 1) in;
+
+void main()
+{
+    for (int i = 0; i < 8; ++i)
+        g_Output.Values[i] = g_Inputs[i].Value;
+}
+)";
+
+using InputValue = std::array<Uint32, 4>;
+
+class DescriptorWritesVkTest : public DedicatedDeviceVkTest
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        DedicatedDeviceVkTest::SetUpTestSuite(
+            [](EngineVkCreateInfo& CreateInfo) //
+            {
+                // Deferred contexts commit the same SRB in the ConcurrentCommit test
+                CreateInfo.NumDeferredContexts = NumDeferredContexts;
+            } //
+        );
+        if (!sm_pDevice)
+            return;
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_GLSL;
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+        ShaderCI.Desc.Name       = "Descriptor writes test - CS";
+        ShaderCI.EntryPoint      = "main";
+        ShaderCI.Source          = CopyInputsCS;
+        RefCntAutoPtr<IShader> pCS;
+        sm_pDevice->CreateShader(ShaderCI, &pCS);
+        ASSERT_NE(pCS, nullptr);
+
+        PipelineStateCreateInfo PSOCreateInfo;
+        PSOCreateInfo.PSODesc.Name                               = "Descriptor writes test";
+        PSOCreateInfo.PSODesc.IsComputePipeline                  = true;
+        PSOCreateInfo.PSODesc.ComputePipeline.pCS                = pCS;
+        PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+        sm_pDevice->CreatePipelineState(PSOCreateInfo, &sm_pPSO);
+        ASSERT_NE(sm_pPSO, nullptr);
+
+        for (Uint32 i = 0; i < NumInputs; ++i)
+        {
+            sm_InputValues[i] = InputValue{i * 10 + 1, i * 10 + 2, i * 10 + 3, i * 10 + 4};
+            sm_pInputs[i]     = CreateInputBuffer(sm_InputValues[i]);
+            ASSERT_NE(sm_pInputs[i], nullptr);
+        }
+    }
+
+    static void TearDownTestSuite()
+    {
+        sm_pPSO.Release();
+        for (auto& pInput : sm_pInputs)
+            pInput.Release();
+        DedicatedDeviceVkTest::TearDownTestSuite();
+    }
+
+    static RefCntAutoPtr<IBuffer> CreateInputBuffer(const InputValue& Value)
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name          = "Descriptor writes test input buffer";
+        BuffDesc.Usage         = USAGE_DEFAULT;
+        BuffDesc.BindFlags     = BIND_UNIFORM_BUFFER;
+        BuffDesc.uiSizeInBytes = sizeof(Value);
+
+        BufferData InitData{Value.data(), sizeof(Value)};
+
+        RefCntAutoPtr<IBuffer> pBuffer;
+        sm_pDevice->CreateBuffer(BuffDesc, &InitData, &pBuffer);
+        return pBuffer;
+    }
+
+    static RefCntAutoPtr<IBuffer> CreateOutputBuffer()
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name              = "Descriptor writes test output buffer";
+        BuffDesc.Usage             = USAGE_DEFAULT;
+        BuffDesc.BindFlags         = BIND_UNORDERED_ACCESS;
+        BuffDesc.Mode              = BUFFER_MODE_STRUCTURED;
+        BuffDesc.ElementByteStride = sizeof(InputValue);
+        BuffDesc.uiSizeInBytes     = sizeof(InputValue) * NumInputs;
+
+        RefCntAutoPtr<IBuffer> pBuffer;
+        sm_pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+        return pBuffer;
+    }
+
+    static void Dispatch(IDeviceContext* pContext, IShaderResourceBinding* pSRB, RESOURCE_STATE_TRANSITION_MODE TransitionMode)
+    {
+        pContext->SetPipelineState(sm_pPSO);
+        pContext->CommitShaderResources(pSRB, TransitionMode);
+        pContext->DispatchCompute(DispatchComputeAttribs{1, 1, 1});
+    }
+
+    static void VerifyOutput(IBuffer* pOutput, const std::array<InputValue, NumInputs>& RefValues)
+    {
+        std::vector<Uint32> RefData;
+        for (const auto& Value : RefValues)
+            RefData.insert(RefData.end(), Value.begin(), Value.end());
+        VerifyBufferData(pOutput, RefData);
+    }
+
+    static RefCntAutoPtr<IPipelineState> sm_pPSO;
+
+    static std::array<InputValue, NumInputs>             sm_InputValues;
+    static std::array<RefCntAutoPtr<IBuffer>, NumInputs> sm_pInputs;
+};
+
+RefCntAutoPtr<IPipelineState>                 DescriptorWritesVkTest::sm_pPSO;
+std::array<InputValue, NumInputs>             DescriptorWritesVkTest::sm_InputValues;
+std::array<RefCntAutoPtr<IBuffer>, NumInputs> DescriptorWritesVkTest::sm_pInputs;
+
+TEST_F(DescriptorWritesVkTest, CoalescedArrayWrites)
+{
+    auto pOutput = CreateOutputBuffer();
+    ASSERT_NE(pOutput, nullptr);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    sm_pPSO->CreateShaderResourceBinding(&pSRB, true);
+    ASSERT_NE(pSRB, nullptr);
+
+    auto* pInputsVar = pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "InputCB");
+    ASSERT_NE(pInputsVar, nullptr);
+    auto* pOutputVar = pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "OutputBuffer");
+    ASSERT_NE(pOutputVar, nullptr);
+
+    IDeviceObject* pInputs[NumInputs] = {};
+    for (Uint32 i = 0; i < NumInputs; ++i)
+        pInputs[i] = sm_pInputs[i];
+
+    // Bind the array elements out of order and in ranges of different sizes. The writes
+    // are sorted at commit time, and the consecutive elements are merged into one write.
+    pInputsVar->SetArray(pInputs + 4, 4, 3);
+    pInputsVar->SetArray(pInputs + 7, 7, 1);
+    for (Uint32 i = 3; i >= 1; --i)
+        pInputsVar->SetArray(pInputs + i, i, 1);
+    pInputsVar->SetArray(pInputs, 0, 1);
+    pOutputVar->Set(pOutput->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+
+    Dispatch(sm_pContext, pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    VerifyOutput(pOutput, sm_InputValues);
+}
+
+TEST_F(DescriptorWritesVkTest, RebindSameObjects)
+{
+    auto pOutput = CreateOutputBuffer();
+    ASSERT_NE(pOutput, nullptr);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    sm_pPSO->CreateShaderResourceBinding(&pSRB, true);
+    ASSERT_NE(pSRB, nullptr);
+
+    auto* pInputsVar = pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "InputCB");
+    ASSERT_NE(pInputsVar, nullptr);
+    auto* pOutputVar = pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "OutputBuffer");
+    ASSERT_NE(pOutputVar, nullptr);
+
+    IDeviceObject* pInputs[NumInputs] = {};
+    for (Uint32 i = 0; i < NumInputs; ++i)
+        pInputs[i] = sm_pInputs[i];
+    pInputsVar->SetArray(pInputs, 0, NumInputs);
+    pOutputVar->Set(pOutput->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+
+    Dispatch(sm_pContext, pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    VerifyOutput(pOutput, sm_InputValues);
+
+    // Binding the objects that are already bound is a no-op. It must not be reported as
+    // an attempt to rebind a mutable variable, and must not invalidate the descriptors.
+    pInputsVar->SetArray(pInputs, 0, NumInputs);
+    pOutputVar->Set(pOutput->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+    for (Uint32 i = 0; i < NumInputs; ++i)
+        EXPECT_TRUE(pInputsVar->IsBound(i));
+
+    // Clear the output to make sure that the second dispatch writes it again
+    const std::array<InputValue, NumInputs> ZeroValues = {};
+    sm_pContext->UpdateBuffer(pOutput, 0, sizeof(ZeroValues), ZeroValues.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    VerifyOutput(pOutput, ZeroValues);
+
+    Dispatch(sm_pContext, pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    VerifyOutput(pOutput, sm_InputValues);
+}
+
+TEST_F(DescriptorWritesVkTest, ConcurrentCommit)
+{
+    const auto NumCtx = static_cast<Uint32>(sm_pDeferredContexts.size());
+
+    auto pOutput = CreateOutputBuffer();
+    ASSERT_NE(pOutput, nullptr);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    sm_pPSO->CreateShaderResourceBinding(&pSRB, true);
+    ASSERT_NE(pSRB, nullptr);
+
+    IDeviceObject* pInputs[NumInputs] = {};
+    for (Uint32 i = 0; i < NumInputs; ++i)
+        pInputs[i] = sm_pInputs[i];
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "InputCB")->SetArray(pInputs, 0, NumInputs);
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "OutputBuffer")->Set(pOutput->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+
+    // Deferred contexts can't transition resources
+    sm_pContext->TransitionShaderResources(sm_pPSO, pSRB);
+
+    // All contexts commit the same SRB simultaneously. The pending descriptor writes are flushed
+    // by the first context, and the others must wait until the writes are complete.
+    std::vector<RefCntAutoPtr<ICommandList>> CmdLists(NumCtx);
+    std::vector<std::thread>                 Threads;
+    for (Uint32 ctx = 0; ctx < NumCtx; ++ctx)
+    {
+        Threads.emplace_back(
+            [&, ctx]() //
+            {
+                IDeviceContext* pDeferredCtx = sm_pDeferredContexts[ctx];
+                Dispatch(pDeferredCtx, pSRB, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+                pDeferredCtx->FinishCommandList(&CmdLists[ctx]);
+            } //
+        );
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    for (auto& pCmdList : CmdLists)
+    {
+        ASSERT_NE(pCmdList, nullptr);
+        sm_pContext->ExecuteCommandList(pCmdList);
+    }
+    CmdLists.clear();
+
+    sm_pContext->Flush();
+    for (Uint32 ctx = 0; ctx < NumCtx; ++ctx)
+        sm_pDeferredContexts[ctx]->FinishFrame();
+
+    VerifyOutput(pOutput, sm_InputValues);
+}
+
+} // namespace
@@ -0,0 +1,220 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+
+#include "Vulkan/TestingEnvironmentVk.hpp"
+
+#include "RenderDeviceVk.h"
+
+#include "ThreadSignal.hpp"
+#include "Timer.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+// Creates and destroys buffers of varying sizes from multiple threads. Every buffer
+// is placed into a suballocation of a device memory page by the global memory manager.
+class MemoryManagerMTBenchmark
+{
+public:
+    MemoryManagerMTBenchmark(IRenderDevice* pDevice, size_t NumThreads) :
+        m_pDevice{pDevice},
+        m_Threads(NumThreads)
+    {
+    }
+
+    // Runs the benchmark and returns the time it took, in seconds
+    double Run()
+    {
+        m_NumThreadsReady = 0;
+        for (size_t t = 0; t < m_Threads.size(); ++t)
+            m_Threads[t] = std::thread(WorkerThreadFunc, this, t);
+
+        while (m_NumThreadsReady < m_Threads.size())
+            std::this_thread::yield();
+
+        Timer T;
+        m_StartSignal.Trigger(true);
+        for (auto& Thread : m_Threads)
+            Thread.join();
+        return T.GetElapsedTime();
+    }
+
+    static constexpr Uint32 NumIterations  = 8;
+    static constexpr Uint32 NumLiveBuffers = 128;
+
+private:
+    static void WorkerThreadFunc(MemoryManagerMTBenchmark* This, size_t ThreadNum)
+    {
+        std::vector<RefCntAutoPtr<IBuffer>> Buffers(NumLiveBuffers);
+
+        ++This->m_NumThreadsReady;
+        This->m_StartSignal.Wait();
+
+        Uint32 Seed         = static_cast<Uint32>(ThreadNum) * 7919u + 1u;
+        auto   CreateBuffer = [&](RefCntAutoPtr<IBuffer>& pBuffer) {
+            // Linear congruential generator; sizes range from 4 KB to 256 KB
+            Seed = Seed * 1664525u + 1013904223u;
+
+            BufferDesc BuffDesc;
+            BuffDesc.Name          = "Memory manager MT benchmark buffer";
+            BuffDesc.Usage         = USAGE_DEFAULT;
+            BuffDesc.BindFlags     = BIND_VERTEX_BUFFER;
+            BuffDesc.uiSizeInBytes = (1u + (Seed >> 26)) * 4096u;
+            This->m_pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+            EXPECT_NE(pBuffer, nullptr);
+        };
+
+        for (Uint32 i = 0; i < NumIterations; ++i)
+        {
+            for (auto& pBuffer : Buffers)
+                CreateBuffer(pBuffer);
+
+            // Release every other buffer to fragment the pages and create them again
+            for (size_t b = 0; b < Buffers.size(); b += 2)
+                Buffers[b].Release();
+            for (size_t b = 0; b < Buffers.size(); b += 2)
+                CreateBuffer(Buffers[b]);
+
+            for (auto& pBuffer : Buffers)
+                pBuffer.Release();
+        }
+    }
+
+    IRenderDevice* const m_pDevice;
+
+    std::vector<std::thread> m_Threads;
+    std::atomic<size_t>      m_NumThreadsReady{0};
+    ThreadingTools::Signal   m_StartSignal;
+};
+
+TEST(VulkanMemoryManagerTest, MultithreadedAllocation)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceCaps().IsVulkanDevice())
+        GTEST_SKIP() << "Vulkan memory manager is only available in Vulkan";
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    const size_t NumThreads = std::max(std::min(std::thread::hardware_concurrency(), 8u), 2u);
+
+    MemoryManagerMTBenchmark Benchmark{pDevice, NumThreads};
+    const auto               Time = Benchmark.Run();
+
+    const auto NumBuffers = static_cast<double>(NumThreads) * MemoryManagerMTBenchmark::NumIterations * MemoryManagerMTBenchmark::NumLiveBuffers * 3 / 2;
+    LOG_INFO_MESSAGE("Vulkan memory manager: ", NumThreads, " threads created and destroyed ", NumBuffers, " buffers in ",
+                     Time * 1000.0, " ms (", NumBuffers / Time, " buffers/s)");
+
+    // Return the released memory to the pages
+    pEnv->GetDeviceContext()->Flush();
+    pDevice->IdleGPU();
+}
+
+Uint32 GetTotalDedicatedAllocations(IRenderDeviceVk* pDeviceVk)
+{
+    Uint32 NumDedicatedAllocations = 0;
+    for (Uint32 HeapIdx = 0; HeapIdx < pDeviceVk->GetDeviceMemoryHeapCount(); ++HeapIdx)
+    {
+        DeviceMemoryHeapStats Stats;
+        pDeviceVk->GetDeviceMemoryHeapStats(HeapIdx, Stats);
+        NumDedicatedAllocations += Stats.NumDedicatedAllocations;
+    }
+    return NumDedicatedAllocations;
+}
+
+TEST(VulkanMemoryManagerTest, HeapStats)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceCaps().IsVulkanDevice())
+        GTEST_SKIP() << "Vulkan memory manager is only available in Vulkan";
+
+    RefCntAutoPtr<IRenderDeviceVk> pDeviceVk{pDevice, IID_RenderDeviceVk};
+    ASSERT_NE(pDeviceVk, nullptr);
+
+    const auto NumHeaps = pDeviceVk->GetDeviceMemoryHeapCount();
+    ASSERT_GT(NumHeaps, 0u);
+
+    bool DeviceLocalHeapFound = false;
+    for (Uint32 HeapIdx = 0; HeapIdx < NumHeaps; ++HeapIdx)
+    {
+        DeviceMemoryHeapStats Stats;
+        pDeviceVk->GetDeviceMemoryHeapStats(HeapIdx, Stats);
+        EXPECT_GT(Stats.HeapSize, Uint64{0});
+        EXPECT_GT(Stats.Budget, Uint64{0});
+        EXPECT_LE(Stats.Budget, Stats.HeapSize);
+        EXPECT_GE(Stats.AllocatedSize, Stats.UsedSize);
+        DeviceLocalHeapFound = DeviceLocalHeapFound || Stats.IsDeviceLocal;
+    }
+    EXPECT_TRUE(DeviceLocalHeapFound);
+}
+
+TEST(VulkanMemoryManagerTest, DedicatedAllocation)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceCaps().IsVulkanDevice())
+        GTEST_SKIP() << "Vulkan memory manager is only available in Vulkan";
+
+    RefCntAutoPtr<IRenderDeviceVk> pDeviceVk{pDevice, IID_RenderDeviceVk};
+    ASSERT_NE(pDeviceVk, nullptr);
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    pDevice->IdleGPU();
+    const auto NumDedicatedAllocations = GetTotalDedicatedAllocations(pDeviceVk);
+
+    {
+        // Allocations larger than half of the default 16 MB page get their own device memory object
+        BufferDesc BuffDesc;
+        BuffDesc.Name          = "Dedicated allocation test buffer";
+        BuffDesc.Usage         = USAGE_DEFAULT;
+        BuffDesc.BindFlags     = BIND_VERTEX_BUFFER;
+        BuffDesc.uiSizeInBytes = 32u << 20u;
+
+        RefCntAutoPtr<IBuffer> pBuffer;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+        ASSERT_NE(pBuffer, nullptr);
+
+        EXPECT_EQ(GetTotalDedicatedAllocations(pDeviceVk), NumDedicatedAllocations + 1);
+    }
+
+    pDevice->IdleGPU();
+    EXPECT_EQ(GetTotalDedicatedAllocations(pDeviceVk), NumDedicatedAllocations);
+}
+
+} // namespace
@@ -0,0 +1,116 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+#include <vector>
+
+#include "Vulkan/TestingEnvironmentVk.hpp"
+
+#include "DeviceContextVk.h"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(PipelineBarrierVkTest, BatchedBarriers)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceCaps().IsVulkanDevice())
+    {
+        GTEST_SKIP() << "Pipeline barrier statistics are only available in Vulkan";
+    }
+
+    RefCntAutoPtr<IDeviceContextVk> pCtxVk{pEnv->GetDeviceContext(), IID_DeviceContextVk};
+    ASSERT_NE(pCtxVk, nullptr);
+
+    constexpr Uint32 NumTextures = 6;
+    constexpr Uint32 NumBuffers  = 4;
+
+    std::vector<RefCntAutoPtr<ITexture>> Textures(NumTextures);
+    std::vector<RefCntAutoPtr<IBuffer>>  Buffers(NumBuffers);
+    std::vector<StateTransitionDesc>     Barriers;
+    for (Uint32 i = 0; i < NumTextures; ++i)
+    {
+        TextureDesc TexDesc;
+        TexDesc.Name      = "Pipeline barrier test texture";
+        TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+        TexDesc.Width     = 64;
+        TexDesc.Height    = 64;
+        TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+        TexDesc.BindFlags = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET;
+        pDevice->CreateTexture(TexDesc, nullptr, &Textures[i]);
+        ASSERT_NE(Textures[i], nullptr);
+        Barriers.emplace_back(Textures[i], RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, true);
+    }
+    for (Uint32 i = 0; i < NumBuffers; ++i)
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name          = "Pipeline barrier test buffer";
+        BuffDesc.uiSizeInBytes = 256;
+        BuffDesc.BindFlags     = BIND_UNIFORM_BUFFER;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &Buffers[i]);
+        ASSERT_NE(Buffers[i], nullptr);
+        Barriers.emplace_back(Buffers[i], RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_CONSTANT_BUFFER, true);
+    }
+
+    pCtxVk->Flush();
+
+    PipelineBarrierStats StartStats;
+    pCtxVk->GetPipelineBarrierStats(StartStats);
+
+    pCtxVk->TransitionResourceStates(static_cast<Uint32>(Barriers.size()), Barriers.data());
+    pCtxVk->Flush();
+
+    PipelineBarrierStats EndStats;
+    pCtxVk->GetPipelineBarrierStats(EndStats);
+
+    EXPECT_EQ(EndStats.NumImageBarriers - StartStats.NumImageBarriers, Uint64{NumTextures});
+    EXPECT_EQ(EndStats.NumBufferBarriers - StartStats.NumBufferBarriers, Uint64{NumBuffers});
+    // All transitions must be recorded with a single vkCmdPipelineBarrier command
+    EXPECT_EQ(EndStats.NumBarrierCommands - StartStats.NumBarrierCommands, Uint64{1});
+
+    // Transitioning the same texture twice requires the first barrier to complete
+    // before the second one is executed
+    StateTransitionDesc TexBarriers[] =
+        {
+            {Textures[0], RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_RENDER_TARGET, true},
+            {Textures[1], RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_RENDER_TARGET, true},
+            {Textures[0], RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, true} //
+        };
+    pCtxVk->TransitionResourceStates(_countof(TexBarriers), TexBarriers);
+    pCtxVk->Flush();
+
+    PipelineBarrierStats FinalStats;
+    pCtxVk->GetPipelineBarrierStats(FinalStats);
+    EXPECT_EQ(FinalStats.NumImageBarriers - EndStats.NumImageBarriers, Uint64{3});
+    EXPECT_EQ(FinalStats.NumBarrierCommands - EndStats.NumBarrierCommands, Uint64{2});
+}
+
+} // namespace
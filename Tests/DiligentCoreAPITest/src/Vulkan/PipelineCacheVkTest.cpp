@@ -0,0 +1,212 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <cstring>
+#include <vector>
+
+#include "Vulkan/TestingEnvironmentVk.hpp"
+
+#include "RenderDeviceVk.h"
+
+#include "volk/volk.h"
+#include "VulkanUtilities/VulkanPipelineCache.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static const char* FillBufferCS = R"(
+RWBuffer<float4> g_Buffer;
+
+[numthreads(16, 1, 1)]
+void main(uint3 DTid : SV_DispatchThreadID)
+{
+    g_Buffer[DTid.x] = float4(DTid.x, 0.0, 0.0, 1.0);
+}
+)";
+
+TEST(PipelineCacheVkTest, GetPipelineCacheData)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceCaps().IsVulkanDevice())
+    {
+        GTEST_SKIP() << "Pipeline cache is only supported in Vulkan";
+    }
+
+    RefCntAutoPtr<IRenderDeviceVk> pDeviceVk{pDevice, IID_RenderDeviceVk};
+    ASSERT_NE(pDeviceVk, nullptr);
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+    ShaderCI.Desc.Name       = "Pipeline cache test - CS";
+    ShaderCI.EntryPoint      = "main";
+    ShaderCI.Source          = FillBufferCS;
+    RefCntAutoPtr<IShader> pCS;
+    pDevice->CreateShader(ShaderCI, &pCS);
+    ASSERT_NE(pCS, nullptr);
+
+    PipelineStateCreateInfo PSOCreateInfo;
+    PSOCreateInfo.PSODesc.Name                = "Pipeline cache test";
+    PSOCreateInfo.PSODesc.IsComputePipeline   = true;
+    PSOCreateInfo.PSODesc.ComputePipeline.pCS = pCS;
+    RefCntAutoPtr<IPipelineState> pPSO;
+    pDevice->CreatePipelineState(PSOCreateInfo, &pPSO);
+    ASSERT_NE(pPSO, nullptr);
+
+    RefCntAutoPtr<IDataBlob> pCacheData;
+    pDeviceVk->GetPipelineCacheData(&pCacheData);
+    ASSERT_NE(pCacheData, nullptr);
+
+    // Every pipeline cache starts with the header defined by the spec
+    constexpr size_t HeaderSize = 16 + VK_UUID_SIZE;
+    ASSERT_GE(pCacheData->GetSize(), HeaderSize);
+
+    Uint32 Header[4] = {};
+    memcpy(Header, pCacheData->GetDataPtr(), sizeof(Header));
+
+    VkPhysicalDeviceProperties DeviceProps = {};
+    vkGetPhysicalDeviceProperties(pDeviceVk->GetVkPhysicalDevice(), &DeviceProps);
+
+    EXPECT_GE(Header[0], HeaderSize);
+    EXPECT_EQ(Header[1], Uint32{VK_PIPELINE_CACHE_HEADER_VERSION_ONE});
+    EXPECT_EQ(Header[2], DeviceProps.vendorID);
+    EXPECT_EQ(Header[3], DeviceProps.deviceID);
+    EXPECT_EQ(memcmp(reinterpret_cast<const Uint8*>(pCacheData->GetDataPtr()) + 16, DeviceProps.pipelineCacheUUID, VK_UUID_SIZE), 0);
+
+    // Creating the same pipeline again must hit the cache; the data must remain valid
+    RefCntAutoPtr<IPipelineState> pPSO2;
+    pDevice->CreatePipelineState(PSOCreateInfo, &pPSO2);
+    ASSERT_NE(pPSO2, nullptr);
+
+    RefCntAutoPtr<IDataBlob> pCacheData2;
+    pDeviceVk->GetPipelineCacheData(&pCacheData2);
+    ASSERT_NE(pCacheData2, nullptr);
+    EXPECT_GE(pCacheData2->GetSize(), HeaderSize);
+}
+
+// Returns the cache data of the testing device and its properties, or an empty vector
+// if the device is not a Vulkan device
+static std::vector<Uint8> GetDeviceCacheData(VkPhysicalDeviceProperties& DeviceProps)
+{
+    auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+    if (!pDevice->GetDeviceCaps().IsVulkanDevice())
+        return {};
+
+    RefCntAutoPtr<IRenderDeviceVk> pDeviceVk{pDevice, IID_RenderDeviceVk};
+    VERIFY_EXPR(pDeviceVk != nullptr);
+    vkGetPhysicalDeviceProperties(pDeviceVk->GetVkPhysicalDevice(), &DeviceProps);
+
+    RefCntAutoPtr<IDataBlob> pCacheData;
+    pDeviceVk->GetPipelineCacheData(&pCacheData);
+    if (!pCacheData)
+        return {};
+
+    const auto* pBytes = reinterpret_cast<const Uint8*>(pCacheData->GetDataPtr());
+    return std::vector<Uint8>{pBytes, pBytes + pCacheData->GetSize()};
+}
+
+class PipelineCacheCompatibilityVkTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        if (!TestingEnvironment::GetInstance()->GetDevice()->GetDeviceCaps().IsVulkanDevice())
+            GTEST_SKIP() << "Pipeline cache is only supported in Vulkan";
+
+        m_CacheData = GetDeviceCacheData(m_DeviceProps);
+        ASSERT_GE(m_CacheData.size(), size_t{16 + VK_UUID_SIZE});
+        // The data produced by the device itself must be accepted
+        ASSERT_TRUE(VulkanUtilities::IsPipelineCacheDataCompatible(m_CacheData.data(), m_CacheData.size(), m_DeviceProps));
+    }
+
+    bool IsCompatible() const
+    {
+        return VulkanUtilities::IsPipelineCacheDataCompatible(m_CacheData.data(), m_CacheData.size(), m_DeviceProps);
+    }
+
+    void WriteUint32(size_t Offset, Uint32 Value)
+    {
+        memcpy(&m_CacheData[Offset], &Value, sizeof(Value));
+    }
+
+    VkPhysicalDeviceProperties m_DeviceProps = {};
+    std::vector<Uint8>         m_CacheData;
+};
+
+TEST_F(PipelineCacheCompatibilityVkTest, WrongVendor)
+{
+    WriteUint32(8, m_DeviceProps.vendorID + 1);
+    EXPECT_FALSE(IsCompatible());
+}
+
+TEST_F(PipelineCacheCompatibilityVkTest, WrongDevice)
+{
+    WriteUint32(12, m_DeviceProps.deviceID + 1);
+    EXPECT_FALSE(IsCompatible());
+}
+
+TEST_F(PipelineCacheCompatibilityVkTest, WrongUUID)
+{
+    // Data produced by a different driver version
+    m_CacheData[16 + VK_UUID_SIZE - 1] ^= 0xFF;
+    EXPECT_FALSE(IsCompatible());
+}
+
+TEST_F(PipelineCacheCompatibilityVkTest, WrongHeaderVersion)
+{
+    WriteUint32(4, VK_PIPELINE_CACHE_HEADER_VERSION_ONE + 1);
+    EXPECT_FALSE(IsCompatible());
+}
+
+TEST_F(PipelineCacheCompatibilityVkTest, TruncatedHeader)
+{
+    // The data is shorter than the header
+    m_CacheData.resize(16 + VK_UUID_SIZE - 1);
+    EXPECT_FALSE(IsCompatible());
+
+    m_CacheData.clear();
+    EXPECT_FALSE(VulkanUtilities::IsPipelineCacheDataCompatible(nullptr, 0, m_DeviceProps));
+}
+
+TEST_F(PipelineCacheCompatibilityVkTest, InvalidHeaderLength)
+{
+    // The header claims to be longer than the data
+    WriteUint32(0, static_cast<Uint32>(m_CacheData.size() + 1));
+    EXPECT_FALSE(IsCompatible());
+
+    // The header is shorter than the minimum size
+    WriteUint32(0, 16);
+    EXPECT_FALSE(IsCompatible());
+}
+
+} // namespace
@@ -0,0 +1,209 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+#include <cstring>
+
+#include "Vulkan/TestingEnvironmentVk.hpp"
+
+#include "RenderDeviceVk.h"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+class ResourceUploadBatchVkTest : public DedicatedDeviceVkTest
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        DedicatedDeviceVkTest::SetUpTestSuite(
+            [](EngineVkCreateInfo& CreateInfo) //
+            {
+                CreateInfo.ResourceUploadBatchStagingSize = 4 << 20;
+                CreateInfo.ResourceUploadBatchFlushSize   = 1 << 20;
+            } //
+        );
+    }
+
+    void SetUp() override
+    {
+        DedicatedDeviceVkTest::SetUp();
+        if (IsSkipped())
+            return;
+
+        // Submit the resources that may have been created by the previous tests
+        sm_pDevice->FlushResourceUploads(nullptr, 0);
+        sm_pDevice->GetResourceUploadBatchStats(m_StartStats);
+    }
+
+    static RefCntAutoPtr<IBuffer> CreateBufferWithData(const std::vector<Uint32>& Data)
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name          = "Resource upload batch test buffer";
+        BuffDesc.Usage         = USAGE_DEFAULT;
+        BuffDesc.BindFlags     = BIND_VERTEX_BUFFER;
+        BuffDesc.uiSizeInBytes = static_cast<Uint32>(Data.size() * sizeof(Data[0]));
+
+        BufferData InitData;
+        InitData.pData    = Data.data();
+        InitData.DataSize = BuffDesc.uiSizeInBytes;
+
+        RefCntAutoPtr<IBuffer> pBuffer;
+        sm_pDevice->CreateBuffer(BuffDesc, &InitData, &pBuffer);
+        return pBuffer;
+    }
+
+    ResourceUploadBatchStats m_StartStats;
+};
+
+TEST_F(ResourceUploadBatchVkTest, BatchedInitialization)
+{
+    constexpr Uint32 NumResources = 32;
+
+    std::vector<std::vector<Uint32>>    BuffersData(NumResources);
+    std::vector<RefCntAutoPtr<IBuffer>> Buffers(NumResources);
+    for (Uint32 i = 0; i < NumResources; ++i)
+    {
+        BuffersData[i].resize(64);
+        for (Uint32 j = 0; j < BuffersData[i].size(); ++j)
+            BuffersData[i][j] = i * 1000 + j;
+        Buffers[i] = CreateBufferWithData(BuffersData[i]);
+        ASSERT_NE(Buffers[i], nullptr);
+    }
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "Resource upload batch test texture";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = 16;
+    TexDesc.Height    = 16;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.Usage     = USAGE_STATIC;
+    TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+
+    std::vector<Uint32> TexData(TexDesc.Width * TexDesc.Height, 0xFF00FF00u);
+
+    TextureSubResData SubresData;
+    SubresData.pData  = TexData.data();
+    SubresData.Stride = TexDesc.Width * 4;
+
+    TextureData InitData;
+    InitData.pSubResources   = &SubresData;
+    InitData.NumSubresources = 1;
+
+    std::vector<RefCntAutoPtr<ITexture>> Textures(NumResources);
+    for (Uint32 i = 0; i < NumResources; ++i)
+    {
+        sm_pDevice->CreateTexture(TexDesc, &InitData, &Textures[i]);
+        ASSERT_NE(Textures[i], nullptr);
+    }
+
+    // Textures without initial data are cleared by the batch
+    TexDesc.Name      = "Resource upload batch test render target";
+    TexDesc.Usage     = USAGE_DEFAULT;
+    TexDesc.BindFlags = BIND_RENDER_TARGET;
+    RefCntAutoPtr<ITexture> pRenderTarget;
+    sm_pDevice->CreateTexture(TexDesc, nullptr, &pRenderTarget);
+    ASSERT_NE(pRenderTarget, nullptr);
+
+    constexpr Uint32 NumCreatedResources = NumResources * 2 + 1;
+
+    ResourceUploadBatchStats Stats;
+    sm_pDevice->GetResourceUploadBatchStats(Stats);
+    EXPECT_EQ(Stats.NumBatchedResources - m_StartStats.NumBatchedResources, NumCreatedResources);
+    EXPECT_EQ(Stats.NumFallbackUploads, m_StartStats.NumFallbackUploads);
+    EXPECT_EQ(Stats.NumPendingResources, NumCreatedResources);
+    EXPECT_EQ(Stats.NumSubmittedBatches, m_StartStats.NumSubmittedBatches);
+
+    FenceDesc Desc;
+    Desc.Name = "Resource upload batch test fence";
+    RefCntAutoPtr<IFence> pFence;
+    sm_pDevice->CreateFence(Desc, &pFence);
+    ASSERT_NE(pFence, nullptr);
+
+    // All resources are initialized by a single submission
+    sm_pDevice->FlushResourceUploads(pFence, 1);
+    sm_pDevice->GetResourceUploadBatchStats(Stats);
+    EXPECT_EQ(Stats.NumPendingResources, 0u);
+    EXPECT_EQ(Stats.NumSubmittedBatches - m_StartStats.NumSubmittedBatches, 1u);
+
+    sm_pContext->WaitForFence(pFence, 1, false);
+    EXPECT_EQ(pFence->GetCompletedValue(), 1u);
+
+    // The fence is signaled even if there are no pending commands
+    sm_pDevice->FlushResourceUploads(pFence, 2);
+    sm_pContext->WaitForFence(pFence, 2, false);
+    EXPECT_EQ(pFence->GetCompletedValue(), 2u);
+
+    for (Uint32 i = 0; i < NumResources; i += 7)
+        VerifyBufferData(Buffers[i], BuffersData[i]);
+}
+
+TEST_F(ResourceUploadBatchVkTest, ImplicitFlush)
+{
+    std::vector<Uint32> Data(256);
+    for (Uint32 i = 0; i < Data.size(); ++i)
+        Data[i] = i * 3;
+
+    auto pBuffer = CreateBufferWithData(Data);
+    ASSERT_NE(pBuffer, nullptr);
+
+    ResourceUploadBatchStats Stats;
+    sm_pDevice->GetResourceUploadBatchStats(Stats);
+    EXPECT_EQ(Stats.NumPendingResources, 1u);
+
+    // The batch must be submitted before the context commands that use the buffer
+    VerifyBufferData(pBuffer, Data);
+
+    sm_pDevice->GetResourceUploadBatchStats(Stats);
+    EXPECT_EQ(Stats.NumPendingResources, 0u);
+    EXPECT_EQ(Stats.NumSubmittedBatches - m_StartStats.NumSubmittedBatches, 1u);
+}
+
+TEST_F(ResourceUploadBatchVkTest, LargeResourceFallback)
+{
+    // The data is larger than the staging buffer of the test device
+    std::vector<Uint32> Data(16 << 20 >> 2);
+    for (Uint32 i = 0; i < Data.size(); ++i)
+        Data[i] = i;
+
+    auto pBuffer = CreateBufferWithData(Data);
+    ASSERT_NE(pBuffer, nullptr);
+
+    ResourceUploadBatchStats Stats;
+    sm_pDevice->GetResourceUploadBatchStats(Stats);
+    EXPECT_EQ(Stats.NumFallbackUploads - m_StartStats.NumFallbackUploads, 1u);
+    EXPECT_EQ(Stats.NumBatchedResources, m_StartStats.NumBatchedResources);
+
+    VerifyBufferData(pBuffer, Data);
+}
+
+} // namespace
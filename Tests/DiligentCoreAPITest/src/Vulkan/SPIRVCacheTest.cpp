@@ -0,0 +1,266 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#include "TestingEnvironment.hpp"
+#include "SPIRVCache.hpp"
+#include "FileWrapper.hpp"
+#include "DataBlobImpl.hpp"
+#include "StringDataBlobImpl.hpp"
+#include "MemoryFileStream.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+const char* CacheDirectory = "SPIRVCacheTest";
+
+// Shader source stream factory that serves files from memory
+class MemoryStreamFactory final : public ObjectBase<IShaderSourceInputStreamFactory>
+{
+public:
+    MemoryStreamFactory(IReferenceCounters* pRefCounters) :
+        ObjectBase<IShaderSourceInputStreamFactory>{pRefCounters}
+    {}
+
+    virtual void DILIGENT_CALL_TYPE CreateInputStream(const Char* Name, IFileStream** ppStream) override final
+    {
+        *ppStream = nullptr;
+
+        auto it = m_Files.find(Name);
+        if (it == m_Files.end())
+            return;
+
+        RefCntAutoPtr<IDataBlob>   pData(MakeNewRCObj<StringDataBlobImpl>()(it->second));
+        RefCntAutoPtr<IFileStream> pStream(MakeNewRCObj<MemoryFileStream>()(pData));
+        *ppStream = pStream.Detach();
+    }
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_IShaderSourceInputStreamFactory, ObjectBase<IShaderSourceInputStreamFactory>);
+
+    void SetFile(const String& Name, const String& Content) { m_Files[Name] = Content; }
+
+private:
+    std::unordered_map<String, String> m_Files;
+};
+
+std::vector<Uint8> ReadFile(const String& Path)
+{
+    std::vector<Uint8> Data;
+
+    FileWrapper File{Path.c_str(), EFileAccessMode::Read};
+    if (File)
+    {
+        Data.resize(File->GetSize());
+        if (!File->Read(Data.data(), Data.size()))
+            Data.clear();
+    }
+    return Data;
+}
+
+void WriteFile(const String& Path, const std::vector<Uint8>& Data)
+{
+    FileWrapper File{Path.c_str(), EFileAccessMode::Overwrite};
+    CFile*      pFile = File;
+    ASSERT_NE(pFile, nullptr);
+    EXPECT_TRUE(pFile->Write(Data.data(), Data.size()));
+}
+
+// Offsets of the fields in the entry file
+constexpr size_t NumIncludesOffset = 32;
+constexpr size_t SPIRVSizeOffset   = 36;
+constexpr size_t HeaderSize        = 40;
+
+TEST(SPIRVCacheTest, HitAndMiss)
+{
+    SPIRVCache Cache{CacheDirectory};
+
+    const Uint64                    Key              = 0x5350495256546573ull;
+    const Uint64                    VerificationHash = 0x1234567890ABCDEFull;
+    const std::vector<unsigned int> RefSPIRV         = {0x07230203, 0x00010000, 1, 2, 3, 4, 5};
+
+    FileSystem::DeleteFile(Cache.GetEntryPath(Key).c_str());
+
+    std::vector<unsigned int> SPIRV;
+    EXPECT_FALSE(Cache.ReadEntry(Key, VerificationHash, nullptr, SPIRV));
+
+    ASSERT_TRUE(Cache.WriteEntry(Key, VerificationHash, {}, RefSPIRV));
+    EXPECT_TRUE(Cache.ReadEntry(Key, VerificationHash, nullptr, SPIRV));
+    EXPECT_EQ(SPIRV, RefSPIRV);
+
+    // The entry was created for a different input with the same key
+    EXPECT_FALSE(Cache.ReadEntry(Key, VerificationHash + 1, nullptr, SPIRV));
+
+    // The entry can be overwritten
+    const std::vector<unsigned int> NewSPIRV = {0x07230203, 0x00010000, 6, 7};
+    ASSERT_TRUE(Cache.WriteEntry(Key, VerificationHash, {}, NewSPIRV));
+    EXPECT_TRUE(Cache.ReadEntry(Key, VerificationHash, nullptr, SPIRV));
+    EXPECT_EQ(SPIRV, NewSPIRV);
+
+    FileSystem::DeleteFile(Cache.GetEntryPath(Key).c_str());
+}
+
+TEST(SPIRVCacheTest, CorruptEntry)
+{
+    SPIRVCache Cache{CacheDirectory};
+
+    const Uint64                    Key              = 0x436F727275707445ull;
+    const Uint64                    VerificationHash = 0xFEDCBA0987654321ull;
+    const std::vector<unsigned int> RefSPIRV         = {0x07230203, 0x00010000, 1, 2, 3, 4, 5};
+    const auto                      Path             = Cache.GetEntryPath(Key);
+
+    ASSERT_TRUE(Cache.WriteEntry(Key, VerificationHash, {}, RefSPIRV));
+    const auto RefData = ReadFile(Path);
+    ASSERT_EQ(RefData.size(), HeaderSize + RefSPIRV.size() * sizeof(RefSPIRV[0]));
+
+    auto ExpectCorrupted = [&](const std::vector<Uint8>& Data, const char* Case) //
+    {
+        WriteFile(Path, Data);
+
+        std::vector<unsigned int> SPIRV;
+        EXPECT_FALSE(Cache.ReadEntry(Key, VerificationHash, nullptr, SPIRV)) << Case;
+
+        // The entry is restored when it is written again
+        ASSERT_TRUE(Cache.WriteEntry(Key, VerificationHash, {}, RefSPIRV));
+        EXPECT_TRUE(Cache.ReadEntry(Key, VerificationHash, nullptr, SPIRV)) << Case;
+        EXPECT_EQ(SPIRV, RefSPIRV) << Case;
+    };
+
+    ExpectCorrupted(std::vector<Uint8>(RefData.begin(), RefData.begin() + HeaderSize / 2), "Truncated header");
+    ExpectCorrupted(std::vector<Uint8>(RefData.begin(), RefData.end() - sizeof(RefSPIRV[0])), "Truncated byte code");
+
+    {
+        auto Data = RefData;
+        Data.push_back(0);
+        ExpectCorrupted(Data, "Trailing data");
+    }
+
+    {
+        auto         Data        = RefData;
+        const Uint32 NumIncludes = 0xFFFFFFFFu;
+        memcpy(&Data[NumIncludesOffset], &NumIncludes, sizeof(NumIncludes));
+        ExpectCorrupted(Data, "Invalid number of includes");
+    }
+
+    {
+        auto         Data      = RefData;
+        const Uint32 SPIRVSize = 0x7FFFFFFFu;
+        memcpy(&Data[SPIRVSizeOffset], &SPIRVSize, sizeof(SPIRVSize));
+        ExpectCorrupted(Data, "Invalid byte code size");
+    }
+
+    {
+        // Hash of the byte code does not match
+        auto Data = RefData;
+        Data.back() ^= 0xFF;
+        ExpectCorrupted(Data, "Invalid byte code");
+    }
+
+    {
+        // The name length of the included file exceeds the file size
+        const std::vector<SPIRVCache::IncludeHash> Includes = {{"Include.fxh", Uint64{0}}};
+        ASSERT_TRUE(Cache.WriteEntry(Key, VerificationHash, Includes, RefSPIRV));
+
+        auto         Data    = ReadFile(Path);
+        const Uint32 NameLen = 0xFFFFFFF0u;
+        ASSERT_GT(Data.size(), HeaderSize + sizeof(NameLen));
+        memcpy(&Data[HeaderSize], &NameLen, sizeof(NameLen));
+        ExpectCorrupted(Data, "Invalid include name length");
+    }
+
+    FileSystem::DeleteFile(Path.c_str());
+}
+
+TEST(SPIRVCacheTest, IncludeInvalidation)
+{
+    auto* pEnv = TestingEnvironment::GetInstance();
+    if (!pEnv->GetDevice()->GetDeviceCaps().IsVulkanDevice())
+        GTEST_SKIP() << "glslang is only initialized by Vulkan testing environment";
+
+    RefCntAutoPtr<MemoryStreamFactory> pFactory{MakeNewRCObj<MemoryStreamFactory>()()};
+    pFactory->SetFile("SPIRVCacheTest.hlsl", R"(
+#include "SPIRVCacheTestInclude.fxh"
+
+RWBuffer<uint> g_Output;
+
+[numthreads(1, 1, 1)]
+void main()
+{
+    g_Output[0] = TEST_VALUE;
+}
+)");
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.Desc.ShaderType            = SHADER_TYPE_COMPUTE;
+    ShaderCI.Desc.Name                  = "SPIR-V cache test";
+    ShaderCI.EntryPoint                 = "main";
+    ShaderCI.FilePath                   = "SPIRVCacheTest.hlsl";
+    ShaderCI.pShaderSourceStreamFactory = pFactory;
+
+    SPIRVCache Cache{CacheDirectory};
+
+    // Compiles the shader and checks whether it was loaded from the cache
+    auto Compile = [&](bool ExpectHit) //
+    {
+        const auto StartStats = Cache.GetStatistics();
+        const auto SPIRV      = Cache.HLSLtoSPIRV(ShaderCI, nullptr);
+        const auto Stats      = Cache.GetStatistics();
+        EXPECT_FALSE(SPIRV.empty());
+        EXPECT_EQ(Stats.NumHits - StartStats.NumHits, ExpectHit ? 1u : 0u);
+        EXPECT_EQ(Stats.NumMisses - StartStats.NumMisses, ExpectHit ? 0u : 1u);
+        EXPECT_EQ(Stats.NumWriteFailures, 0u);
+        return SPIRV;
+    };
+
+    const char* IncludeA = "#define TEST_VALUE 1u\n";
+    const char* IncludeB = "#define TEST_VALUE 2u\n";
+
+    // The entry may have been left by a previous run
+    pFactory->SetFile("SPIRVCacheTestInclude.fxh", IncludeA);
+    Cache.HLSLtoSPIRV(ShaderCI, nullptr);
+
+    const auto SPIRV_A = Compile(true);
+
+    // The entry must not be used when the included file changes
+    pFactory->SetFile("SPIRVCacheTestInclude.fxh", IncludeB);
+    const auto SPIRV_B = Compile(false);
+    EXPECT_NE(SPIRV_A, SPIRV_B);
+    EXPECT_EQ(Compile(true), SPIRV_B);
+
+    pFactory->SetFile("SPIRVCacheTestInclude.fxh", IncludeA);
+    EXPECT_EQ(Compile(false), SPIRV_A);
+}
+
+} // namespace
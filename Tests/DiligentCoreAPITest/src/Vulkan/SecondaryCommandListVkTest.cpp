@@ -0,0 +1,275 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <thread>
+#include <vector>
+
+#include "Vulkan/TestingEnvironmentVk.hpp"
+
+#include "DeviceContextVk.h"
+#include "Timer.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+constexpr Uint32 NumDeferredContexts = 4;
+
+// clang-format off
+const char* ProceduralTriangleVS = R"(
+struct PSInput 
+{ 
+    float4 Pos   : SV_POSITION; 
+    float3 Color : COLOR; 
+};
+
+void main(in  uint    VertId : SV_VertexID,
+          out PSInput PSIn) 
+{
+    float4 Pos[3];
+    Pos[0] = float4(-1.0, -0.5, 0.0, 1.0);
+    Pos[1] = float4(-0.5, +0.5, 0.0, 1.0);
+    Pos[2] = float4( 0.0, -0.5, 0.0, 1.0);
+
+    PSIn.Pos   = Pos[VertId];
+    PSIn.Color = float3(VertId == 0 ? 1.0 : 0.0, VertId == 1 ? 1.0 : 0.0, VertId == 2 ? 1.0 : 0.0);
+}
+)";
+
+const char* ColorPS = R"(
+struct PSInput 
+{ 
+    float4 Pos   : SV_POSITION; 
+    float3 Color : COLOR; 
+};
+
+float4 main(in PSInput PSIn) : SV_Target
+{
+    return float4(PSIn.Color, 1.0);
+}
+)";
+// clang-format on
+
+class SecondaryCommandListVkTest : public DedicatedDeviceVkTest
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        DedicatedDeviceVkTest::SetUpTestSuite(
+            [](EngineVkCreateInfo& CreateInfo) //
+            {
+                // Secondary command lists are recorded by the deferred contexts
+                CreateInfo.NumDeferredContexts = NumDeferredContexts;
+            } //
+        );
+        if (!sm_pDevice)
+            return;
+
+        TextureDesc TexDesc;
+        TexDesc.Name      = "Secondary command list test render target";
+        TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+        TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+        TexDesc.BindFlags = BIND_RENDER_TARGET;
+        TexDesc.Width     = 256;
+        TexDesc.Height    = 256;
+        sm_pDevice->CreateTexture(TexDesc, nullptr, &sm_pRenderTarget);
+        ASSERT_NE(sm_pRenderTarget, nullptr);
+
+        PipelineStateCreateInfo PSOCreateInfo;
+        PipelineStateDesc&      PSODesc = PSOCreateInfo.PSODesc;
+
+        PSODesc.Name = "Secondary command list test";
+
+        PSODesc.IsComputePipeline                             = false;
+        PSODesc.GraphicsPipeline.NumRenderTargets             = 1;
+        PSODesc.GraphicsPipeline.RTVFormats[0]                = TEX_FORMAT_RGBA8_UNORM;
+        PSODesc.GraphicsPipeline.PrimitiveTopology            = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        PSODesc.GraphicsPipeline.RasterizerDesc.CullMode      = CULL_MODE_NONE;
+        PSODesc.GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.UseCombinedTextureSamplers = true;
+
+        RefCntAutoPtr<IShader> pVS;
+        {
+            ShaderCI.Desc.ShaderType = SHADER_TYPE_VERTEX;
+            ShaderCI.EntryPoint      = "main";
+            ShaderCI.Desc.Name       = "Secondary command list test vertex shader";
+            ShaderCI.Source          = ProceduralTriangleVS;
+            sm_pDevice->CreateShader(ShaderCI, &pVS);
+            ASSERT_NE(pVS, nullptr);
+        }
+
+        RefCntAutoPtr<IShader> pPS;
+        {
+            ShaderCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
+            ShaderCI.EntryPoint      = "main";
+            ShaderCI.Desc.Name       = "Secondary command list test pixel shader";
+            ShaderCI.Source          = ColorPS;
+            sm_pDevice->CreateShader(ShaderCI, &pPS);
+            ASSERT_NE(pPS, nullptr);
+        }
+
+        PSODesc.GraphicsPipeline.pVS = pVS;
+        PSODesc.GraphicsPipeline.pPS = pPS;
+        sm_pDevice->CreatePipelineState(PSOCreateInfo, &sm_pPSO);
+        ASSERT_NE(sm_pPSO, nullptr);
+    }
+
+    static void TearDownTestSuite()
+    {
+        sm_pPSO.Release();
+        sm_pRenderTarget.Release();
+        DedicatedDeviceVkTest::TearDownTestSuite();
+    }
+
+    // Binds the render target to the immediate context and transitions it to RESOURCE_STATE_RENDER_TARGET
+    // state, so that secondary command lists can be recorded without any state transitions.
+    static void BeginRenderPass(IDeviceContext* pContext)
+    {
+        ITextureView* pRTVs[] = {sm_pRenderTarget->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET)};
+        pContext->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        const float ClearColor[] = {0.f, 0.f, 0.f, 0.f};
+        pContext->ClearRenderTarget(pRTVs[0], ClearColor, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    }
+
+    static void RecordDraws(IDeviceContext* pDeferredCtx, IDeviceContext* pImmediateCtx, Uint32 NumDraws, ICommandList** ppCmdList)
+    {
+        RefCntAutoPtr<IDeviceContextVk> pDeferredCtxVk{pDeferredCtx, IID_DeviceContextVk};
+        pDeferredCtxVk->BeginSecondaryCommandList(pImmediateCtx);
+
+        pDeferredCtx->SetPipelineState(sm_pPSO);
+        pDeferredCtx->CommitShaderResources(nullptr, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+        DrawAttribs drawAttrs{3, DRAW_FLAG_NONE};
+        for (Uint32 i = 0; i < NumDraws; ++i)
+            pDeferredCtx->Draw(drawAttrs);
+
+        pDeferredCtx->FinishCommandList(ppCmdList);
+    }
+
+    static void ExecuteAndFinishFrame(IDeviceContext* pContext, std::vector<RefCntAutoPtr<ICommandList>>& CmdLists)
+    {
+        std::vector<ICommandList*> pCmdLists(CmdLists.size());
+        for (size_t i = 0; i < CmdLists.size(); ++i)
+            pCmdLists[i] = CmdLists[i];
+
+        RefCntAutoPtr<IDeviceContextVk> pContextVk{pContext, IID_DeviceContextVk};
+        pContextVk->ExecuteCommandLists(static_cast<Uint32>(pCmdLists.size()), pCmdLists.data());
+        CmdLists.clear();
+
+        pContext->Flush();
+        for (auto& pDeferredCtx : sm_pDeferredContexts)
+            pDeferredCtx->FinishFrame();
+    }
+
+    static RefCntAutoPtr<ITexture>       sm_pRenderTarget;
+    static RefCntAutoPtr<IPipelineState> sm_pPSO;
+};
+
+RefCntAutoPtr<ITexture>       SecondaryCommandListVkTest::sm_pRenderTarget;
+RefCntAutoPtr<IPipelineState> SecondaryCommandListVkTest::sm_pPSO;
+
+TEST_F(SecondaryCommandListVkTest, ExecuteInsideRenderPass)
+{
+    auto* pContext = sm_pContext.RawPtr();
+
+    BeginRenderPass(pContext);
+
+    std::vector<RefCntAutoPtr<ICommandList>> CmdLists(sm_pDeferredContexts.size());
+    for (Uint32 ctx = 0; ctx < CmdLists.size(); ++ctx)
+        RecordDraws(sm_pDeferredContexts[ctx], pContext, 16, &CmdLists[ctx]);
+
+    std::vector<ICommandList*> pCmdLists;
+    for (auto& pCmdList : CmdLists)
+        pCmdLists.push_back(pCmdList);
+
+    RefCntAutoPtr<IDeviceContextVk> pContextVk{pContext, IID_DeviceContextVk};
+    // Execute the lists with two calls to make sure that the render pass instance is reused
+    pContextVk->ExecuteCommandLists(1, pCmdLists.data());
+    pContextVk->ExecuteCommandLists(static_cast<Uint32>(pCmdLists.size() - 1), pCmdLists.data() + 1);
+    CmdLists.clear();
+
+    // The immediate context must restart the render pass to record inline draw commands
+    pContext->SetPipelineState(sm_pPSO);
+    pContext->CommitShaderResources(nullptr, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+    DrawAttribs drawAttrs{3, DRAW_FLAG_VERIFY_ALL};
+    pContext->Draw(drawAttrs);
+
+    // Secondary command lists can be executed again after inline commands
+    CmdLists.resize(1);
+    RecordDraws(sm_pDeferredContexts[0], pContext, 16, &CmdLists[0]);
+    ExecuteAndFinishFrame(pContext, CmdLists);
+}
+
+TEST_F(SecondaryCommandListVkTest, RecordingScalability)
+{
+    auto* pContext = sm_pContext.RawPtr();
+
+    const Uint32 MaxThreads     = static_cast<Uint32>(sm_pDeferredContexts.size());
+    const Uint32 DrawsPerThread = 10000;
+    const Uint32 TotalDraws     = MaxThreads * DrawsPerThread;
+
+    BeginRenderPass(pContext);
+    for (Uint32 NumThreads = 1; NumThreads <= MaxThreads; ++NumThreads)
+    {
+        std::vector<RefCntAutoPtr<ICommandList>> CmdLists(NumThreads);
+        std::vector<std::thread>                 Threads;
+
+        Timer T;
+        for (Uint32 t = 0; t < NumThreads; ++t)
+        {
+            const Uint32 NumDraws = TotalDraws / NumThreads + (t < TotalDraws % NumThreads ? 1 : 0);
+            Threads.emplace_back(
+                [&, t, NumDraws]() //
+                {
+                    RecordDraws(sm_pDeferredContexts[t], pContext, NumDraws, &CmdLists[t]);
+                } //
+            );
+        }
+        for (auto& Thread : Threads)
+            Thread.join();
+        const auto RecordingTime = T.GetElapsedTime();
+
+        for (const auto& pCmdList : CmdLists)
+            ASSERT_NE(pCmdList, nullptr);
+
+        LOG_INFO_MESSAGE("Recorded ", TotalDraws, " draw commands on ", NumThreads, (NumThreads == 1 ? " thread in " : " threads in "),
+                         RecordingTime * 1000, " ms");
+
+        // Render targets remain bound to the immediate context after it is flushed
+        ExecuteAndFinishFrame(pContext, CmdLists);
+    }
+}
+
+} // namespace
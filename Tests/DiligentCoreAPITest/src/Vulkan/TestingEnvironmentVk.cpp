@@ -25,6 +25,8 @@
  *  of the possibility of such damages.
  */
 
+#include <cstring>
+
 #include "Vulkan/TestingEnvironmentVk.hpp"
 
 #include "RenderDeviceVk.h"
@@ -636,6 +638,117 @@ void TestingEnvironmentVk::TransitionImageLayout(VkCommandBuffer
     CurrentLayout = NewLayout;
 }
 
+EngineVkCreateInfo TestingEnvironmentVk::GetEngineCreateInfo()
+{
+    EngineVkCreateInfo CreateInfo;
+    CreateInfo.DebugMessageCallback      = MessageCallback;
+    CreateInfo.EnableValidation          = true;
+    CreateInfo.MainDescriptorPoolSize    = VulkanDescriptorPoolSize{64, 64, 256, 256, 64, 32, 32, 32, 32};
+    CreateInfo.DynamicDescriptorPoolSize = VulkanDescriptorPoolSize{64, 64, 256, 256, 64, 32, 32, 32, 32};
+    CreateInfo.UploadHeapPageSize        = 32 * 1024;
+    //CreateInfo.DeviceLocalMemoryReserveSize = 32 << 20;
+    //CreateInfo.HostVisibleMemoryReserveSize = 48 << 20;
+    return CreateInfo;
+}
+
+void TestingEnvironmentVk::CreateDevice(const EngineVkCreateInfo& CreateInfo,
+                                        IRenderDevice**           ppDevice,
+                                        IDeviceContext**          ppContexts)
+{
+#if EXPLICITLY_LOAD_ENGINE_VK_DLL
+    // Load the dll and import GetEngineFactoryVk() function
+    auto GetEngineFactoryVk = LoadGraphicsEngineVk();
+    if (GetEngineFactoryVk == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Failed to load the engine");
+        return;
+    }
+#endif
+
+    GetEngineFactoryVk()->CreateDeviceAndContextsVk(CreateInfo, ppDevice, ppContexts);
+}
+
+RefCntAutoPtr<IRenderDeviceVk>             DedicatedDeviceVkTest::sm_pDevice;
+RefCntAutoPtr<IDeviceContext>              DedicatedDeviceVkTest::sm_pContext;
+std::vector<RefCntAutoPtr<IDeviceContext>> DedicatedDeviceVkTest::sm_pDeferredContexts;
+
+void DedicatedDeviceVkTest::SetUpTestSuite(const ModifyEngineCIType& ModifyEngineCI)
+{
+    auto* pEnv = TestingEnvironment::GetInstance();
+    if (!pEnv->GetDevice()->GetDeviceCaps().IsVulkanDevice())
+        return;
+
+    auto CreateInfo = TestingEnvironmentVk::GetEngineCreateInfo();
+    if (ModifyEngineCI)
+        ModifyEngineCI(CreateInfo);
+
+    RefCntAutoPtr<IRenderDevice> pDevice;
+    std::vector<IDeviceContext*> ppContexts(1 + CreateInfo.NumDeferredContexts);
+    TestingEnvironmentVk::CreateDevice(CreateInfo, &pDevice, ppContexts.data());
+
+    sm_pContext.Attach(ppContexts[0]);
+    sm_pDeferredContexts.resize(CreateInfo.NumDeferredContexts);
+    for (Uint32 ctx = 0; ctx < CreateInfo.NumDeferredContexts; ++ctx)
+        sm_pDeferredContexts[ctx].Attach(ppContexts[1 + ctx]);
+
+    ASSERT_NE(pDevice, nullptr);
+    ASSERT_NE(sm_pContext, nullptr);
+    sm_pDevice = RefCntAutoPtr<IRenderDeviceVk>{pDevice, IID_RenderDeviceVk};
+}
+
+void DedicatedDeviceVkTest::TearDownTestSuite()
+{
+    if (sm_pDevice)
+        sm_pDevice->IdleGPU();
+    sm_pDeferredContexts.clear();
+    sm_pContext.Release();
+    sm_pDevice.Release();
+}
+
+void DedicatedDeviceVkTest::SetUp()
+{
+    if (!sm_pDevice)
+        GTEST_SKIP() << "The test requires a Vulkan device";
+}
+
+void DedicatedDeviceVkTest::TearDown()
+{
+    if (!sm_pDevice)
+        return;
+
+    // See TestingEnvironment::ReleaseResources()
+    sm_pContext->Flush();
+    sm_pContext->FinishFrame();
+    for (auto& pDeferredCtx : sm_pDeferredContexts)
+        pDeferredCtx->FinishFrame();
+    sm_pDevice->ReleaseStaleResources();
+}
+
+void DedicatedDeviceVkTest::VerifyBufferData(IBuffer* pBuffer, const std::vector<Uint32>& RefData)
+{
+    const auto DataSize = static_cast<Uint32>(RefData.size() * sizeof(RefData[0]));
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name           = "Staging buffer for data verification";
+    BuffDesc.Usage          = USAGE_STAGING;
+    BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+    BuffDesc.uiSizeInBytes  = DataSize;
+
+    RefCntAutoPtr<IBuffer> pStagingBuffer;
+    sm_pDevice->CreateBuffer(BuffDesc, nullptr, &pStagingBuffer);
+    ASSERT_NE(pStagingBuffer, nullptr);
+
+    sm_pContext->CopyBuffer(pBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                            pStagingBuffer, 0, DataSize, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    sm_pContext->WaitForIdle();
+
+    void* pData = nullptr;
+    sm_pContext->MapBuffer(pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+    ASSERT_NE(pData, nullptr);
+    EXPECT_EQ(memcmp(pData, RefData.data(), DataSize), 0) << "Buffer data does not match reference values";
+    sm_pContext->UnmapBuffer(pStagingBuffer, MAP_READ);
+}
+
 TestingEnvironment* CreateTestingEnvironmentVk(RENDER_DEVICE_TYPE deviceType, ADAPTER_TYPE AdapterType, const SwapChainDesc& SCDesc)
 {
     return new TestingEnvironmentVk{deviceType, AdapterType, SCDesc};
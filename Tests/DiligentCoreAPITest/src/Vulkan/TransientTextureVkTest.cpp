@@ -0,0 +1,159 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "Vulkan/TestingEnvironmentVk.hpp"
+
+#include "DeviceContextVk.h"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+RefCntAutoPtr<ITexture> CreateTransientTexture(IRenderDevice* pDevice, const char* Name, Uint32 FirstPass, Uint32 LastPass)
+{
+    TextureDesc TexDesc;
+    TexDesc.Name              = Name;
+    TexDesc.Type              = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width             = 256;
+    TexDesc.Height            = 256;
+    TexDesc.Format            = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.BindFlags         = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET;
+    TexDesc.MiscFlags         = MISC_TEXTURE_FLAG_TRANSIENT;
+    TexDesc.TransientLifetime = TransientTextureLifetime{FirstPass, LastPass};
+
+    RefCntAutoPtr<ITexture> pTexture;
+    pDevice->CreateTexture(TexDesc, nullptr, &pTexture);
+    return pTexture;
+}
+
+void TransitionToState(IDeviceContext* pContext, ITexture* pTexture, RESOURCE_STATE NewState)
+{
+    StateTransitionDesc Barrier{pTexture, RESOURCE_STATE_UNKNOWN, NewState, true};
+    pContext->TransitionResourceStates(1, &Barrier);
+}
+
+TEST(TransientTextureVkTest, MemoryAliasing)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceCaps().IsVulkanDevice())
+    {
+        GTEST_SKIP() << "Transient texture memory aliasing is only implemented in Vulkan";
+    }
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    auto* pContext = pEnv->GetDeviceContext();
+
+    RefCntAutoPtr<IDeviceContextVk> pCtxVk{pContext, IID_DeviceContextVk};
+    ASSERT_NE(pCtxVk, nullptr);
+
+    // A and B are used in different passes and share memory; C is used in both passes
+    auto pTexA = CreateTransientTexture(pDevice, "Transient texture A", 0, 0);
+    auto pTexB = CreateTransientTexture(pDevice, "Transient texture B", 1, 1);
+    auto pTexC = CreateTransientTexture(pDevice, "Transient texture C", 0, 1);
+    ASSERT_NE(pTexA, nullptr);
+    ASSERT_NE(pTexB, nullptr);
+    ASSERT_NE(pTexC, nullptr);
+
+    EXPECT_EQ(pTexA->GetState(), RESOURCE_STATE_UNDEFINED);
+    EXPECT_EQ(pTexB->GetState(), RESOURCE_STATE_UNDEFINED);
+    EXPECT_EQ(pTexC->GetState(), RESOURCE_STATE_UNDEFINED);
+
+    PipelineBarrierStats StartStats;
+    pCtxVk->GetPipelineBarrierStats(StartStats);
+
+    // Pass 0
+    TransitionToState(pContext, pTexA, RESOURCE_STATE_RENDER_TARGET);
+    TransitionToState(pContext, pTexC, RESOURCE_STATE_RENDER_TARGET);
+    TransitionToState(pContext, pTexA, RESOURCE_STATE_SHADER_RESOURCE);
+
+    PipelineBarrierStats Pass0Stats;
+    pCtxVk->GetPipelineBarrierStats(Pass0Stats);
+    // No texture has used the memory before
+    EXPECT_EQ(Pass0Stats.NumAliasingBarriers, StartStats.NumAliasingBarriers);
+
+    // Pass 1: B takes over the memory of A
+    TransitionToState(pContext, pTexB, RESOURCE_STATE_RENDER_TARGET);
+    EXPECT_EQ(pTexA->GetState(), RESOURCE_STATE_UNDEFINED);
+    EXPECT_EQ(pTexB->GetState(), RESOURCE_STATE_RENDER_TARGET);
+    EXPECT_EQ(pTexC->GetState(), RESOURCE_STATE_RENDER_TARGET);
+
+    PipelineBarrierStats Pass1Stats;
+    pCtxVk->GetPipelineBarrierStats(Pass1Stats);
+    EXPECT_EQ(Pass1Stats.NumAliasingBarriers, Pass0Stats.NumAliasingBarriers + 1);
+
+    // Next frame: A takes the memory back
+    TransitionToState(pContext, pTexA, RESOURCE_STATE_RENDER_TARGET);
+    EXPECT_EQ(pTexA->GetState(), RESOURCE_STATE_RENDER_TARGET);
+    EXPECT_EQ(pTexB->GetState(), RESOURCE_STATE_UNDEFINED);
+    EXPECT_EQ(pTexC->GetState(), RESOURCE_STATE_RENDER_TARGET);
+
+    pContext->Flush();
+    pDevice->IdleGPU();
+}
+
+TEST(TransientTextureVkTest, OverlappingLifetimes)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceCaps().IsVulkanDevice())
+    {
+        GTEST_SKIP() << "Transient texture memory aliasing is only implemented in Vulkan";
+    }
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    auto* pContext = pEnv->GetDeviceContext();
+
+    // The textures are used in overlapping pass ranges and must not share memory
+    constexpr Uint32        NumTextures = 4;
+    RefCntAutoPtr<ITexture> pTextures[NumTextures];
+    for (Uint32 i = 0; i < NumTextures; ++i)
+    {
+        pTextures[i] = CreateTransientTexture(pDevice, "Transient texture", i, i + 1);
+        ASSERT_NE(pTextures[i], nullptr);
+    }
+
+    for (Uint32 i = 0; i < NumTextures; ++i)
+    {
+        TransitionToState(pContext, pTextures[i], RESOURCE_STATE_RENDER_TARGET);
+        if (i > 0)
+        {
+            EXPECT_EQ(pTextures[i - 1]->GetState(), RESOURCE_STATE_RENDER_TARGET);
+        }
+    }
+
+    pContext->Flush();
+    pDevice->IdleGPU();
+}
+
+} // namespace
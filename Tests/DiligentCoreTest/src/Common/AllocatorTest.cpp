@@ -25,8 +25,16 @@
  *  of the possibility of such damages.
  */
 
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+#include <unordered_set>
+
 #include "DefaultRawMemoryAllocator.hpp"
 #include "FixedBlockMemoryAllocator.hpp"
+#include "ThreadSignal.hpp"
 
 #include "gtest/gtest.h"
 
@@ -120,4 +128,170 @@ TEST(Common_FixedBlockMemoryAllocator, UnalignedSize)
     }
 }
 
+TEST(Common_FixedBlockMemoryAllocator, ThreadCache)
+{
+    constexpr Uint32 AllocSize             = 24;
+    constexpr Uint32 NumAllocationsPerPage = 8;
+    constexpr Uint32 NumAllocations        = 1000;
+
+    FixedBlockMemoryAllocator TestAllocator(DefaultRawMemoryAllocator::GetAllocator(), AllocSize, NumAllocationsPerPage, true);
+
+    std::vector<void*> Allocations(NumAllocations);
+    for (int pass = 0; pass < 3; ++pass)
+    {
+        std::unordered_set<void*> UniqueAllocations;
+        for (auto& pAlloc : Allocations)
+        {
+            pAlloc = TestAllocator.Allocate(AllocSize, "Fixed block allocator thread cache test", __FILE__, __LINE__);
+            ASSERT_NE(pAlloc, nullptr);
+            EXPECT_EQ(reinterpret_cast<size_t>(pAlloc) % sizeof(void*), size_t{0});
+            EXPECT_TRUE(UniqueAllocations.insert(pAlloc).second) << "The same block has been allocated twice";
+            memset(pAlloc, pass, AllocSize);
+        }
+
+        // Free every other allocation first, then the rest
+        for (int s = 0; s < 2; ++s)
+        {
+            for (size_t i = s; i < Allocations.size(); i += 2)
+                TestAllocator.Free(Allocations[i]);
+        }
+    }
+
+    {
+        void* pRawMem0 = TestAllocator.Allocate(AllocSize, "Fixed block allocator thread cache test", __FILE__, __LINE__);
+        TestAllocator.Free(pRawMem0);
+        void* pRawMem1 = TestAllocator.Allocate(AllocSize, "Fixed block allocator thread cache test", __FILE__, __LINE__);
+        EXPECT_EQ(pRawMem0, pRawMem1);
+        TestAllocator.Free(pRawMem1);
+    }
+}
+
+// Records the sizes of the memory chunks that hold aligned pages
+class PageChunkTrackingAllocator final : public IMemoryAllocator
+{
+public:
+    virtual void* Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber) override final
+    {
+        if (strcmp(dbgDescription, "FixedBlockMemoryAllocator page chunk") == 0)
+            ChunkSizes.push_back(Size);
+        return DefaultRawMemoryAllocator::GetAllocator().Allocate(Size, dbgDescription, dbgFileName, dbgLineNumber);
+    }
+
+    virtual void Free(void* Ptr) override final
+    {
+        DefaultRawMemoryAllocator::GetAllocator().Free(Ptr);
+    }
+
+    std::vector<size_t> ChunkSizes;
+};
+
+TEST(Common_FixedBlockMemoryAllocator, AlignedPages)
+{
+    constexpr Uint32 AllocSize             = 64;
+    constexpr Uint32 NumAllocationsPerPage = 64;
+    constexpr size_t PageSize              = AllocSize * NumAllocationsPerPage;
+
+    PageChunkTrackingAllocator RawAllocator;
+    {
+        FixedBlockMemoryAllocator TestAllocator(RawAllocator, AllocSize, NumAllocationsPerPage, true);
+        EXPECT_TRUE(RawAllocator.ChunkSizes.empty()) << "Pages must not be allocated until the first block is requested";
+
+        std::vector<void*> Allocations(NumAllocationsPerPage * 2);
+        for (auto& pAlloc : Allocations)
+        {
+            pAlloc = TestAllocator.Allocate(AllocSize, "Fixed block allocator aligned pages test", __FILE__, __LINE__);
+            ASSERT_NE(pAlloc, nullptr);
+        }
+        for (auto* pAlloc : Allocations)
+            TestAllocator.Free(pAlloc);
+    }
+
+    // The blocks fill the page exactly, so the header must take the space of the first block
+    // rather than double the page size. A chunk holds several pages and one extra page for alignment.
+    ASSERT_EQ(RawAllocator.ChunkSizes.size(), size_t{1});
+    EXPECT_EQ(RawAllocator.ChunkSizes[0] % PageSize, size_t{0});
+    EXPECT_NE(RawAllocator.ChunkSizes[0] % (PageSize * 2), size_t{0});
+}
+
+class FixedBlockAllocatorMTTest
+{
+public:
+    FixedBlockAllocatorMTTest(FixedBlockMemoryAllocator& Allocator, Uint32 BlockSize, size_t NumThreads) :
+        m_Allocator{Allocator},
+        m_BlockSize{BlockSize},
+        m_Threads(NumThreads)
+    {
+    }
+
+    void Run()
+    {
+        m_NumThreadsReady = 0;
+        for (size_t t = 0; t < m_Threads.size(); ++t)
+            m_Threads[t] = std::thread(WorkerThreadFunc, this, t);
+
+        while (m_NumThreadsReady < m_Threads.size())
+            std::this_thread::yield();
+
+        m_StartSignal.Trigger(true);
+        for (auto& Thread : m_Threads)
+            Thread.join();
+    }
+
+#ifdef DILIGENT_DEBUG
+    static constexpr Uint32 NumIterations = 200;
+#else
+    static constexpr Uint32 NumIterations = 2000;
+#endif
+    static constexpr Uint32 NumLiveAllocations = 256;
+
+private:
+    static void WorkerThreadFunc(FixedBlockAllocatorMTTest* This, size_t ThreadNum)
+    {
+        std::vector<void*> Allocations(NumLiveAllocations);
+
+        ++This->m_NumThreadsReady;
+        This->m_StartSignal.Wait();
+
+        const auto Pattern = static_cast<Uint8>(ThreadNum + 1);
+        for (Uint32 i = 0; i < NumIterations; ++i)
+        {
+            for (auto& pAlloc : Allocations)
+            {
+                pAlloc = This->m_Allocator.Allocate(This->m_BlockSize, "Fixed block allocator MT test", __FILE__, __LINE__);
+                memset(pAlloc, Pattern, This->m_BlockSize);
+            }
+
+            for (auto* pAlloc : Allocations)
+            {
+                auto* pBytes = reinterpret_cast<const Uint8*>(pAlloc);
+                EXPECT_TRUE(std::all_of(pBytes, pBytes + This->m_BlockSize, [Pattern](Uint8 b) { return b == Pattern; }))
+                    << "Block has been overwritten by another thread";
+                This->m_Allocator.Free(pAlloc);
+            }
+        }
+    }
+
+    FixedBlockMemoryAllocator& m_Allocator;
+    const Uint32               m_BlockSize;
+
+    std::vector<std::thread> m_Threads;
+    std::atomic<size_t>      m_NumThreadsReady{0};
+    ThreadingTools::Signal   m_StartSignal;
+};
+
+TEST(Common_FixedBlockMemoryAllocator, Multithreaded)
+{
+    constexpr Uint32 AllocSize             = 64;
+    constexpr Uint32 NumAllocationsPerPage = 256;
+
+    const size_t NumThreads = std::max(std::min(std::thread::hardware_concurrency(), 8u), 2u);
+
+    for (int UseThreadCache = 0; UseThreadCache < 2; ++UseThreadCache)
+    {
+        FixedBlockMemoryAllocator TestAllocator(DefaultRawMemoryAllocator::GetAllocator(), AllocSize, NumAllocationsPerPage, UseThreadCache != 0);
+        FixedBlockAllocatorMTTest Test(TestAllocator, AllocSize, NumThreads);
+        Test.Run();
+    }
+}
+
 } // namespace
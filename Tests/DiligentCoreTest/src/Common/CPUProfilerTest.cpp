@@ -0,0 +1,238 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <thread>
+#include <cstring>
+
+#include "CPUProfiler.hpp"
+#include "Timer.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+const CPUProfileThreadEvents* FindThread(const std::vector<CPUProfileThreadEvents>& Threads, const char* EventName)
+{
+    for (const auto& Thread : Threads)
+    {
+        for (const auto& Evt : Thread.Events)
+        {
+            if (strcmp(Evt.Name, EventName) == 0)
+                return &Thread;
+        }
+    }
+    return nullptr;
+}
+
+size_t CountSubstrings(const std::string& Str, const char* SubStr)
+{
+    size_t Count = 0;
+    for (auto Pos = Str.find(SubStr); Pos != std::string::npos; Pos = Str.find(SubStr, Pos + 1))
+        ++Count;
+    return Count;
+}
+
+TEST(Common_CPUProfiler, NestedScopes)
+{
+    CPUProfiler::Reset();
+    {
+        CPUProfileScope Outer{"Outer"};
+        {
+            CPUProfileScope Inner1{"Inner1"};
+            CPUProfileScope Inner2{"Inner2"};
+        }
+        CPUProfileScope Inner3{"Inner3"};
+    }
+
+    const auto  Threads = CPUProfiler::CollectEvents();
+    const auto* pThread = FindThread(Threads, "Outer");
+    ASSERT_NE(pThread, nullptr);
+
+    const auto& Events = pThread->Events;
+    ASSERT_EQ(Events.size(), size_t{4});
+    // Events are recorded in the order of scope completion
+    EXPECT_STREQ(Events[0].Name, "Inner2");
+    EXPECT_STREQ(Events[1].Name, "Inner1");
+    EXPECT_STREQ(Events[2].Name, "Inner3");
+    EXPECT_STREQ(Events[3].Name, "Outer");
+    EXPECT_EQ(Events[0].Depth, Uint32{2});
+    EXPECT_EQ(Events[1].Depth, Uint32{1});
+    EXPECT_EQ(Events[2].Depth, Uint32{1});
+    EXPECT_EQ(Events[3].Depth, Uint32{0});
+
+    const auto& Outer = Events[3];
+    for (size_t i = 0; i < 3; ++i)
+    {
+        EXPECT_GE(Events[i].StartTime, Outer.StartTime);
+        EXPECT_LE(Events[i].StartTime + Events[i].Duration, Outer.StartTime + Outer.Duration);
+    }
+    EXPECT_GE(Events[0].StartTime, Events[1].StartTime);
+    EXPECT_GE(Events[2].StartTime, Events[1].StartTime + Events[1].Duration);
+}
+
+TEST(Common_CPUProfiler, Disable)
+{
+    CPUProfiler::Reset();
+    CPUProfiler::SetEnabled(false);
+    {
+        CPUProfileScope Scope{"DisabledScope"};
+    }
+    CPUProfiler::SetEnabled(true);
+    {
+        CPUProfileScope Scope{"EnabledScope"};
+    }
+
+    const auto Threads = CPUProfiler::CollectEvents();
+    EXPECT_EQ(FindThread(Threads, "DisabledScope"), nullptr);
+    EXPECT_NE(FindThread(Threads, "EnabledScope"), nullptr);
+}
+
+TEST(Common_CPUProfiler, Macros)
+{
+    CPUProfiler::Reset();
+    {
+        DILIGENT_PROFILE_SCOPE("MacroScope");
+    }
+
+    const auto Threads = CPUProfiler::CollectEvents();
+#if DILIGENT_CPU_PROFILER
+    EXPECT_NE(FindThread(Threads, "MacroScope"), nullptr);
+#else
+    EXPECT_EQ(FindThread(Threads, "MacroScope"), nullptr);
+#endif
+}
+
+TEST(Common_CPUProfiler, RingBufferOverflow)
+{
+    CPUProfiler::Reset();
+
+    constexpr Uint32 NumEvents = CPUProfiler::ThreadBufferSize + 100;
+    for (Uint32 i = 0; i < NumEvents; ++i)
+    {
+        CPUProfileScope Scope{"OverflowScope"};
+    }
+
+    const auto  Threads = CPUProfiler::CollectEvents();
+    const auto* pThread = FindThread(Threads, "OverflowScope");
+    ASSERT_NE(pThread, nullptr);
+    // The slot that may be written next is conservatively discarded
+    EXPECT_LE(pThread->Events.size(), size_t{CPUProfiler::ThreadBufferSize});
+    EXPECT_GE(pThread->Events.size(), size_t{CPUProfiler::ThreadBufferSize - 1});
+    for (size_t i = 1; i < pThread->Events.size(); ++i)
+        EXPECT_GE(pThread->Events[i].StartTime, pThread->Events[i - 1].StartTime);
+}
+
+TEST(Common_CPUProfiler, ChromeTraceExport)
+{
+    CPUProfiler::Reset();
+
+    constexpr int            NumThreads        = 4;
+    constexpr int            NumEventsPerThead = 10;
+    std::vector<std::thread> Threads;
+    for (int t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back([t]() {
+            const std::string Name = "Worker \"" + std::to_string(t) + "\"";
+            CPUProfiler::SetThreadName(Name.c_str());
+            for (int i = 0; i < NumEventsPerThead; ++i)
+            {
+                CPUProfileScope Scope{"WorkerScope"};
+            }
+        });
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    std::string Json;
+    CPUProfiler::ExportChromeTrace(Json);
+    EXPECT_EQ(Json.find("{\"traceEvents\":["), size_t{0});
+    EXPECT_EQ(CountSubstrings(Json, "\"name\":\"WorkerScope\",\"cat\":\"Diligent\",\"ph\":\"X\""), size_t{NumThreads * NumEventsPerThead});
+    EXPECT_EQ(CountSubstrings(Json, "\"name\":\"thread_name\""), size_t{NumThreads});
+    for (int t = 0; t < NumThreads; ++t)
+    {
+        const std::string EscapedName = "\"Worker \\\"" + std::to_string(t) + "\\\"\"";
+        EXPECT_NE(Json.find(EscapedName), std::string::npos) << EscapedName;
+    }
+
+    // Buffers of the threads that have exited are released by Reset()
+    CPUProfiler::Reset();
+    CPUProfiler::ExportChromeTrace(Json);
+    EXPECT_EQ(CountSubstrings(Json, "WorkerScope"), size_t{0});
+    EXPECT_EQ(CountSubstrings(Json, "Worker \\\""), size_t{0});
+}
+
+TEST(Common_CPUProfiler, ConcurrentCollection)
+{
+    CPUProfiler::Reset();
+
+    std::atomic<bool> Stop{false};
+    std::thread       Writer{[&Stop]() {
+        while (!Stop.load())
+        {
+            CPUProfileScope Outer{"ConcurrentOuter"};
+            CPUProfileScope Inner{"ConcurrentInner"};
+        }
+    }};
+
+    for (int i = 0; i < 100; ++i)
+    {
+        const auto Threads = CPUProfiler::CollectEvents();
+        for (const auto& Thread : Threads)
+        {
+            EXPECT_LE(Thread.Events.size(), size_t{CPUProfiler::ThreadBufferSize});
+            for (const auto& Evt : Thread.Events)
+                EXPECT_NE(Evt.Name, nullptr);
+        }
+    }
+
+    Stop.store(true);
+    Writer.join();
+}
+
+TEST(Common_CPUProfiler, Overhead)
+{
+    CPUProfiler::Reset();
+
+    constexpr Uint32 NumScopes = 100000;
+
+    Timer T;
+    for (Uint32 i = 0; i < NumScopes; ++i)
+    {
+        CPUProfileScope Scope{"OverheadScope"};
+    }
+    const auto Time = T.GetElapsedTime();
+    CPUProfiler::Reset();
+
+    // A scope takes a few hundred nanoseconds in debug builds and much less in release builds.
+    // The bound leaves a wide margin for loaded machines, but catches a regression by an order of magnitude.
+    EXPECT_LT(Time / NumScopes, 5e-6) << "Average scope overhead: " << Time / NumScopes * 1e9 << " ns";
+}
+
+} // namespace
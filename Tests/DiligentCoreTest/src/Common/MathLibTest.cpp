@@ -25,6 +25,9 @@
  *  of the possibility of such damages.
  */
 
+#include <random>
+#include <vector>
+
 #include "BasicMath.hpp"
 #include "AdvancedMath.hpp"
 
@@ -1262,4 +1265,84 @@ TEST(Common_AdvancedMath, TraceLineThroughGrid)
     TestLineTrace(float2{3, 1}, float2{1, 3}, {int2{3, 1}, int2{2, 1}, int2{2, 2}, int2{1, 2}, int2{1, 3}});
 }
 
+// Checks that the batched results match GetBoxVisibility() for every box. This covers the SIMD
+// kernel of the target (AVX or SSE2 on x86, NEON on ARM) as well as the scalar tail processing.
+template <typename FrustumType>
+void TestBatchedBoxVisibility(const FrustumType& Frustum, const BoundBoxArrays& Boxes, size_t NumBoxes, FRUSTUM_PLANE_FLAGS PlaneFlags)
+{
+    std::vector<BoxVisibility> Visibility(NumBoxes);
+    GetBoxesVisibility(Frustum, Boxes, NumBoxes, Visibility.data(), PlaneFlags);
+
+    std::vector<Uint32> VisibilityMask((NumBoxes + 31) / 32, 0xFFFFFFFFu);
+    GetBoxesVisibilityMask(Frustum, Boxes, NumBoxes, VisibilityMask.data(), PlaneFlags);
+
+    size_t Counters[3] = {};
+    for (size_t i = 0; i < NumBoxes; ++i)
+    {
+        const BoundBox Box{
+            float3{Boxes.MinX[i], Boxes.MinY[i], Boxes.MinZ[i]},
+            float3{Boxes.MaxX[i], Boxes.MaxY[i], Boxes.MaxZ[i]} //
+        };
+
+        const auto RefVisibility = GetBoxVisibility(Frustum, Box, PlaneFlags);
+        EXPECT_EQ(Visibility[i], RefVisibility) << "Box " << i;
+
+        const auto IsVisible = (VisibilityMask[i / 32] & (1u << (i % 32))) != 0;
+        EXPECT_EQ(IsVisible, RefVisibility != BoxVisibility::Invisible) << "Box " << i;
+
+        ++Counters[static_cast<int>(RefVisibility)];
+    }
+    // Unused bits of the last mask element must be cleared
+    EXPECT_EQ(VisibilityMask.back() >> (NumBoxes % 32), 0u);
+
+    // Make sure that all cases are covered
+    EXPECT_GT(Counters[static_cast<int>(BoxVisibility::Invisible)], size_t{0});
+    EXPECT_GT(Counters[static_cast<int>(BoxVisibility::Intersecting)], size_t{0});
+    EXPECT_GT(Counters[static_cast<int>(BoxVisibility::FullyVisible)], size_t{0});
+}
+
+TEST(Common_AdvancedMath, BatchedBoxVisibility)
+{
+    const auto ViewProj = float4x4::RotationY(0.5f) * float4x4::Translation(1.f, -2.f, 3.f) * float4x4::Projection(PI_F / 4.f, 1.5f, 1.f, 50.f, false);
+
+    ViewFrustumExt Frustum;
+    ExtractViewFrustumPlanesFromMatrix(ViewProj, Frustum, false);
+
+    // Use the number of boxes that is not a multiple of the SIMD width
+    // to test the tail processing
+    constexpr size_t NumBoxes = 4099;
+
+    std::vector<float> MinX(NumBoxes), MinY(NumBoxes), MinZ(NumBoxes), MaxX(NumBoxes), MaxY(NumBoxes), MaxZ(NumBoxes);
+
+    std::mt19937                          Gen{0};
+    std::uniform_real_distribution<float> PosDistr{-60.f, 60.f};
+    std::uniform_real_distribution<float> SizeDistr{0.f, 20.f};
+    for (size_t i = 0; i < NumBoxes; ++i)
+    {
+        MinX[i] = PosDistr(Gen);
+        MinY[i] = PosDistr(Gen);
+        MinZ[i] = PosDistr(Gen);
+        MaxX[i] = MinX[i] + SizeDistr(Gen);
+        MaxY[i] = MinY[i] + SizeDistr(Gen);
+        MaxZ[i] = MinZ[i] + SizeDistr(Gen);
+    }
+
+    BoundBoxArrays Boxes;
+    Boxes.MinX = MinX.data();
+    Boxes.MinY = MinY.data();
+    Boxes.MinZ = MinZ.data();
+    Boxes.MaxX = MaxX.data();
+    Boxes.MaxY = MaxY.data();
+    Boxes.MaxZ = MaxZ.data();
+
+    TestBatchedBoxVisibility(static_cast<const ViewFrustum&>(Frustum), Boxes, NumBoxes, FRUSTUM_PLANE_FLAG_FULL_FRUSTUM);
+    TestBatchedBoxVisibility(static_cast<const ViewFrustum&>(Frustum), Boxes, NumBoxes, FRUSTUM_PLANE_FLAG_OPEN_NEAR);
+    TestBatchedBoxVisibility(Frustum, Boxes, NumBoxes, FRUSTUM_PLANE_FLAG_FULL_FRUSTUM);
+    TestBatchedBoxVisibility(Frustum, Boxes, NumBoxes, FRUSTUM_PLANE_FLAG_OPEN_NEAR);
+
+    // Empty range
+    GetBoxesVisibility(Frustum, Boxes, 0, nullptr);
+    GetBoxesVisibilityMask(Frustum, Boxes, 0, nullptr);
+}
+
 } // namespace
@@ -0,0 +1,87 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <random>
+#include <algorithm>
+
+#include "RadixSort.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+struct KeyIndex
+{
+    Uint64 Key;
+    Uint32 Index;
+};
+
+void TestRadixSort(size_t Count, Uint64 KeyMask, ThreadPool* pThreadPool)
+{
+    std::mt19937_64 Rnd{Count};
+
+    std::vector<KeyIndex> Data(Count), Scratch(Count);
+    for (size_t i = 0; i < Count; ++i)
+        Data[i] = KeyIndex{Rnd() & KeyMask, static_cast<Uint32>(i)};
+
+    auto Reference = Data;
+    std::stable_sort(Reference.begin(), Reference.end(), [](const KeyIndex& lhs, const KeyIndex& rhs) { return lhs.Key < rhs.Key; });
+
+    const auto* pSorted = RadixSort64(Data.data(), Scratch.data(), Count, pThreadPool);
+    for (size_t i = 0; i < Count; ++i)
+    {
+        ASSERT_EQ(pSorted[i].Key, Reference[i].Key) << "Count: " << Count << ", element: " << i;
+        ASSERT_EQ(pSorted[i].Index, Reference[i].Index) << "Count: " << Count << ", element: " << i;
+    }
+}
+
+TEST(Common_RadixSort, Sort)
+{
+    for (size_t Count : {size_t{0}, size_t{1}, size_t{2}, size_t{100}, size_t{5000}})
+    {
+        TestRadixSort(Count, ~Uint64{0}, nullptr);
+        // Only a few distinct low-bit keys: most passes are skipped and the order of equal keys must be preserved
+        TestRadixSort(Count, 0x7, nullptr);
+        TestRadixSort(Count, Uint64{0xFF} << 40, nullptr);
+    }
+}
+
+TEST(Common_RadixSort, ParallelSort)
+{
+    ThreadPool Pool{4};
+    for (size_t Count : {size_t{100}, size_t{10000}, size_t{100003}})
+    {
+        TestRadixSort(Count, ~Uint64{0}, &Pool);
+        TestRadixSort(Count, 0xF0F, &Pool);
+        TestRadixSort(Count, 0, &Pool);
+    }
+}
+
+} // namespace
@@ -0,0 +1,93 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <atomic>
+#include <stdexcept>
+
+#include "ThreadPool.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_ThreadPool, EnqueueAndWait)
+{
+    for (size_t NumThreads : {size_t{0}, size_t{1}, size_t{4}})
+    {
+        ThreadPool Pool{NumThreads};
+        EXPECT_EQ(Pool.GetNumThreads(), NumThreads);
+
+        constexpr int                 NumTasks = 256;
+        std::atomic<int>              Counter{0};
+        std::vector<std::future<int>> Results;
+        for (int i = 0; i < NumTasks; ++i)
+        {
+            Results.emplace_back(Pool.Enqueue([i, &Counter]() {
+                Counter.fetch_add(1);
+                return i * i;
+            }));
+        }
+
+        Pool.WaitForAllTasks();
+        EXPECT_EQ(Counter.load(), NumTasks);
+        for (int i = 0; i < NumTasks; ++i)
+            EXPECT_EQ(Results[i].get(), i * i);
+    }
+}
+
+TEST(Common_ThreadPool, Exception)
+{
+    ThreadPool Pool{2};
+
+    auto Future = Pool.Enqueue([]() -> int { throw std::runtime_error("test"); });
+    EXPECT_THROW(Future.get(), std::runtime_error);
+
+    // The pool must remain usable
+    auto Future2 = Pool.Enqueue([]() { return 10; });
+    EXPECT_EQ(Future2.get(), 10);
+}
+
+TEST(Common_ThreadPool, DestructorCompletesTasks)
+{
+    std::atomic<int> Counter{0};
+    {
+        ThreadPool Pool{3};
+        for (int i = 0; i < 100; ++i)
+        {
+            Pool.Enqueue([&Counter]() {
+                std::this_thread::yield();
+                Counter.fetch_add(1);
+            });
+        }
+    }
+    EXPECT_EQ(Counter.load(), 100);
+}
+
+} // namespace
@@ -0,0 +1,193 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <list>
+#include <vector>
+
+#include "BestFitPageIndex.hpp"
+#include "TLSFAllocationsManager.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+struct TestPage
+{
+    explicit TestPage(TLSFAllocationsManager::OffsetType Size) :
+        AllocationMgr{Size, DefaultRawMemoryAllocator::GetAllocator()}
+    {}
+
+    TLSFAllocationsManager AllocationMgr;
+
+    BestFitPageIndex<TestPage>::Handle IndexHandle;
+};
+
+class TestPagePool
+{
+public:
+    TestPage& CreatePage(TLSFAllocationsManager::OffsetType Size)
+    {
+        m_Pages.emplace_back(Size);
+        auto& Page       = m_Pages.back();
+        Page.IndexHandle = m_Index.NullHandle();
+        m_Index.Update(Page, Page.AllocationMgr.GetMaxFreeBlockSize(), Page.IndexHandle);
+        return Page;
+    }
+
+    TLSFAllocationsManager::Allocation Allocate(TestPage& Page, TLSFAllocationsManager::OffsetType Size)
+    {
+        auto Alloc = Page.AllocationMgr.Allocate(Size, 1);
+        EXPECT_TRUE(Alloc.IsValid());
+        m_Index.Update(Page, Page.AllocationMgr.GetMaxFreeBlockSize(), Page.IndexHandle);
+        return Alloc;
+    }
+
+    // Allocates from the best-fitting page, the same way VulkanMemoryManager does
+    TestPage* AllocateBestFit(TLSFAllocationsManager::OffsetType Size, TLSFAllocationsManager::Allocation& Alloc)
+    {
+        auto* pPage = m_Index.FindBestFit(Size);
+        if (pPage != nullptr)
+            Alloc = Allocate(*pPage, Size);
+        return pPage;
+    }
+
+    void Free(TestPage& Page, TLSFAllocationsManager::Allocation&& Alloc)
+    {
+        Page.AllocationMgr.Free(std::move(Alloc));
+        m_Index.Update(Page, Page.AllocationMgr.GetMaxFreeBlockSize(), Page.IndexHandle);
+    }
+
+    void RemovePage(TestPage& Page)
+    {
+        m_Index.Remove(Page.IndexHandle);
+        EXPECT_EQ(Page.IndexHandle, m_Index.NullHandle());
+    }
+
+    const BestFitPageIndex<TestPage>& GetIndex() const { return m_Index; }
+
+private:
+    BestFitPageIndex<TestPage> m_Index;
+    // Pages must not move as the index references them by pointer
+    std::list<TestPage> m_Pages;
+};
+
+TEST(GraphicsAccessories_BestFitPageIndex, FindBestFit)
+{
+    TestPagePool Pool;
+    EXPECT_EQ(Pool.GetIndex().FindBestFit(1), nullptr);
+
+    auto& Page0 = Pool.CreatePage(1024);
+    auto& Page1 = Pool.CreatePage(1024);
+    auto& Page2 = Pool.CreatePage(1024);
+    EXPECT_EQ(Pool.GetIndex().GetNumPages(), 3u);
+
+    // Leave 256 bytes in Page0 and 512 bytes in Page1
+    auto Alloc0 = Pool.Allocate(Page0, 768);
+    auto Alloc1 = Pool.Allocate(Page1, 512);
+
+    EXPECT_EQ(Pool.GetIndex().FindBestFit(1), &Page0);
+    EXPECT_EQ(Pool.GetIndex().FindBestFit(256), &Page0);
+    EXPECT_EQ(Pool.GetIndex().FindBestFit(257), &Page1);
+    EXPECT_EQ(Pool.GetIndex().FindBestFit(512), &Page1);
+    // Empty page is only used when no other page fits
+    EXPECT_EQ(Pool.GetIndex().FindBestFit(513), &Page2);
+    EXPECT_EQ(Pool.GetIndex().FindBestFit(1024), &Page2);
+    EXPECT_EQ(Pool.GetIndex().FindBestFit(1025), nullptr);
+
+    // Page0 becomes empty and ties with Page2
+    Pool.Free(Page0, std::move(Alloc0));
+    auto* pPage = Pool.GetIndex().FindBestFit(1024);
+    EXPECT_TRUE(pPage == &Page0 || pPage == &Page2);
+    EXPECT_EQ(Pool.GetIndex().FindBestFit(256), &Page1);
+
+    Pool.RemovePage(Page2);
+    Pool.RemovePage(Page0);
+    EXPECT_EQ(Pool.GetIndex().GetNumPages(), 1u);
+    EXPECT_EQ(Pool.GetIndex().FindBestFit(1024), nullptr);
+    EXPECT_EQ(Pool.GetIndex().FindBestFit(512), &Page1);
+
+    Pool.Free(Page1, std::move(Alloc1));
+    Pool.RemovePage(Page1);
+    EXPECT_EQ(Pool.GetIndex().GetNumPages(), 0u);
+}
+
+TEST(GraphicsAccessories_BestFitPageIndex, EmptyPagesAreKept)
+{
+    constexpr TLSFAllocationsManager::OffsetType PageSize = 4096;
+
+    TestPagePool Pool;
+
+    std::vector<TestPage*> Pages;
+    for (int p = 0; p < 4; ++p)
+        Pages.push_back(&Pool.CreatePage(PageSize));
+
+    struct AllocInfo
+    {
+        TestPage*                          pPage;
+        TLSFAllocationsManager::Allocation Alloc;
+    };
+    std::vector<AllocInfo> Allocs;
+
+    // Allocations that fit into a single page all go to the same page
+    for (int i = 0; i < 16; ++i)
+    {
+        AllocInfo Info;
+        Info.pPage = Pool.AllocateBestFit(128, Info.Alloc);
+        ASSERT_NE(Info.pPage, nullptr);
+        EXPECT_EQ(Info.pPage, Allocs.empty() ? Info.pPage : Allocs.front().pPage);
+        Allocs.push_back(Info);
+    }
+
+    // Release every other allocation to fragment the page. New allocations fill the holes
+    // instead of taking any of the empty pages.
+    for (size_t i = 0; i < Allocs.size(); i += 2)
+        Pool.Free(*Allocs[i].pPage, std::move(Allocs[i].Alloc));
+    for (size_t i = 0; i < Allocs.size(); i += 2)
+    {
+        auto* pPage = Pool.AllocateBestFit(128, Allocs[i].Alloc);
+        EXPECT_EQ(pPage, Allocs[i].pPage);
+    }
+
+    size_t NumEmptyPages = 0;
+    for (const auto* pPage : Pages)
+    {
+        if (pPage->AllocationMgr.IsEmpty())
+            ++NumEmptyPages;
+    }
+    EXPECT_EQ(NumEmptyPages, Pages.size() - 1);
+
+    for (auto& Info : Allocs)
+        Pool.Free(*Info.pPage, std::move(Info.Alloc));
+    for (auto* pPage : Pages)
+        Pool.RemovePage(*pPage);
+}
+
+} // namespace
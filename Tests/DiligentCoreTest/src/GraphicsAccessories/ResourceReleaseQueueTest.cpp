@@ -26,6 +26,10 @@
  */
 
 #include <memory>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <algorithm>
 
 #include "ResourceReleaseQueue.hpp"
 #include "DefaultRawMemoryAllocator.hpp"
@@ -128,4 +132,183 @@ TEST(GraphicsAccessories_ResourceReleaseQueue, GetFilterTypeLiteralName)
     }
 }
 
+TEST(GraphicsAccessories_ResourceReleaseQueue, ReleaseOrder)
+{
+    struct Resource
+    {
+        Resource(std::vector<int>& _ReleaseOrder, int _Id) :
+            ReleaseOrder{&_ReleaseOrder},
+            Id{_Id}
+        {}
+        Resource(Resource&& rhs) :
+            ReleaseOrder{rhs.ReleaseOrder},
+            Id{rhs.Id}
+        {
+            rhs.ReleaseOrder = nullptr;
+        }
+        ~Resource()
+        {
+            if (ReleaseOrder != nullptr)
+                ReleaseOrder->push_back(Id);
+        }
+        std::vector<int>* ReleaseOrder;
+        int               Id;
+    };
+
+    std::vector<int> ReleaseOrder;
+
+    ResourceReleaseQueue<DynamicStaleResourceWrapper> Queue(DefaultRawMemoryAllocator::GetAllocator());
+
+    Queue.SafeReleaseResource(Resource{ReleaseOrder, 0}, 1);
+    Queue.SafeReleaseResource(Resource{ReleaseOrder, 1}, 1);
+    Queue.SafeReleaseResource(Resource{ReleaseOrder, 2}, 2);
+    Queue.DiscardResource(Resource{ReleaseOrder, 3}, 5);
+    EXPECT_EQ(Queue.GetStaleResourceCount(), size_t{3});
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), size_t{1});
+
+    // Command list 1 has been submitted: resources 0 and 1 will be released when fence 10 is completed
+    Queue.DiscardStaleResources(1, 10);
+    EXPECT_EQ(Queue.GetStaleResourceCount(), size_t{1});
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), size_t{3});
+
+    Queue.Purge(5);
+    EXPECT_EQ(ReleaseOrder, std::vector<int>({3}));
+
+    Queue.DiscardStaleResources(2, 11);
+    EXPECT_EQ(Queue.GetStaleResourceCount(), size_t{0});
+
+    Queue.Purge(10);
+    EXPECT_EQ(ReleaseOrder, std::vector<int>({3, 0, 1}));
+
+    Queue.Purge(11);
+    EXPECT_EQ(ReleaseOrder, std::vector<int>({3, 0, 1, 2}));
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), size_t{0});
+}
+
+TEST(GraphicsAccessories_ResourceReleaseQueue, InlineResources)
+{
+    // Small resources with a single reference are kept inline in the wrapper
+    struct Resource
+    {
+        explicit Resource(int& _NumDestroyed) noexcept :
+            NumDestroyed{&_NumDestroyed}
+        {}
+        Resource(Resource&& rhs) noexcept :
+            NumDestroyed{rhs.NumDestroyed}
+        {
+            rhs.NumDestroyed = nullptr;
+        }
+        ~Resource()
+        {
+            if (NumDestroyed != nullptr)
+                ++(*NumDestroyed);
+        }
+        int* NumDestroyed;
+    };
+
+    int NumDestroyed = 0;
+    {
+        ResourceReleaseQueue<DynamicStaleResourceWrapper> Queue(DefaultRawMemoryAllocator::GetAllocator());
+
+        Queue.SafeReleaseResource(Resource{NumDestroyed}, 0);
+
+        // Copying the wrapper of a resource with a single reference transfers the resource
+        auto Wrapper1 = Queue.CreateWrapper(Resource{NumDestroyed}, 1);
+        Queue.SafeReleaseResource(Wrapper1, 0);
+        Wrapper1.GiveUpOwnership();
+
+        auto Wrapper2 = Queue.CreateWrapper(Resource{NumDestroyed}, 1);
+        auto Wrapper3 = std::move(Wrapper2);
+        Queue.DiscardResource(std::move(Wrapper3), 1);
+        EXPECT_EQ(NumDestroyed, 0);
+
+        Queue.DiscardStaleResources(0, 1);
+        EXPECT_EQ(NumDestroyed, 0);
+        Queue.Purge(1);
+        EXPECT_EQ(NumDestroyed, 3);
+
+        // A wrapper that is destroyed without being released destroys its resource
+        {
+            auto Wrapper4 = Queue.CreateWrapper(Resource{NumDestroyed}, 1);
+        }
+        EXPECT_EQ(NumDestroyed, 4);
+    }
+    EXPECT_EQ(NumDestroyed, 4);
+}
+
+// Releases objects from multiple threads while another thread keeps discarding and purging the queue
+TEST(GraphicsAccessories_ResourceReleaseQueue, Contention)
+{
+    struct Resource
+    {
+        explicit Resource(std::atomic<int>& _Counter) :
+            Counter{&_Counter}
+        {}
+        Resource(Resource&& rhs) :
+            Counter{rhs.Counter}
+        {
+            rhs.Counter = nullptr;
+        }
+        ~Resource()
+        {
+            if (Counter != nullptr)
+                Counter->fetch_add(1);
+        }
+        std::atomic<int>* Counter;
+    };
+
+    const int NumThreads          = static_cast<int>(std::max(std::thread::hardware_concurrency(), 4u));
+    const int NumObjectsPerThread = 10000;
+
+    ResourceReleaseQueue<DynamicStaleResourceWrapper> Queue(DefaultRawMemoryAllocator::GetAllocator());
+
+    std::atomic<int>    NumDestroyed{0};
+    std::atomic<Uint64> NextCmdListNumber{0};
+    std::atomic<int>    NumThreadsFinished{0};
+
+    std::vector<std::thread> Threads(NumThreads);
+    for (auto& t : Threads)
+    {
+        t = std::thread{
+            [&]() //
+            {
+                for (int i = 0; i < NumObjectsPerThread; ++i)
+                    Queue.SafeReleaseResource(Resource{NumDestroyed}, NextCmdListNumber.load());
+                NumThreadsFinished.fetch_add(1);
+            } //
+        };
+    }
+
+    // Emulate command list submission: every submitted command list gets its own fence value
+    // that is completed two submissions later
+    Uint64 FenceValue      = 0;
+    size_t MaxStaleCount   = 0;
+    size_t MaxPendingCount = 0;
+    while (NumThreadsFinished.load() < NumThreads)
+    {
+        auto CmdListNumber = NextCmdListNumber.fetch_add(1);
+        ++FenceValue;
+        Queue.DiscardStaleResources(CmdListNumber, FenceValue);
+        if (FenceValue > 2)
+            Queue.Purge(FenceValue - 2);
+
+        MaxStaleCount   = std::max(MaxStaleCount, Queue.GetStaleResourceCount());
+        MaxPendingCount = std::max(MaxPendingCount, Queue.GetPendingReleaseResourceCount());
+        std::this_thread::yield();
+    }
+
+    for (auto& t : Threads)
+        t.join();
+
+    Queue.DiscardStaleResources(NextCmdListNumber.fetch_add(1), ++FenceValue);
+    Queue.Purge(FenceValue);
+
+    EXPECT_EQ(NumDestroyed.load(), NumThreads * NumObjectsPerThread);
+    // The counters must never go below the number of resources in the queue and wrap around
+    EXPECT_LE(MaxStaleCount, static_cast<size_t>(NumThreads * NumObjectsPerThread));
+    EXPECT_LE(MaxPendingCount, static_cast<size_t>(NumThreads * NumObjectsPerThread));
+    EXPECT_EQ(Queue.GetStaleResourceCount(), size_t{0});
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), size_t{0});
+}
+
 } // namespace
@@ -0,0 +1,351 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#include "TLSFAllocationsManager.hpp"
+#include "VariableSizeAllocationsManager.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, MapSize)
+{
+    Uint32 FL = 0, SL = 0;
+
+    TLSFAllocationsManager::MapSize(1, FL, SL);
+    EXPECT_EQ(FL, 0u);
+    EXPECT_EQ(SL, 1u);
+
+    TLSFAllocationsManager::MapSize(15, FL, SL);
+    EXPECT_EQ(FL, 0u);
+    EXPECT_EQ(SL, 15u);
+
+    TLSFAllocationsManager::MapSize(16, FL, SL);
+    EXPECT_EQ(FL, 1u);
+    EXPECT_EQ(SL, 0u);
+
+    TLSFAllocationsManager::MapSize(31, FL, SL);
+    EXPECT_EQ(FL, 1u);
+    EXPECT_EQ(SL, 15u);
+
+    TLSFAllocationsManager::MapSize(1024 + 64 * 3 + 5, FL, SL);
+    EXPECT_EQ(FL, 7u);
+    EXPECT_EQ(SL, 3u);
+
+    TLSFAllocationsManager::MapSize(~TLSFAllocationsManager::OffsetType{0}, FL, SL);
+    EXPECT_EQ(FL, TLSFAllocationsManager::FLIndexCount - 1);
+    EXPECT_EQ(SL, TLSFAllocationsManager::SLIndexCount - 1);
+}
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, AllocateFree)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    TLSFAllocationsManager ListMgr(128, Allocator);
+    EXPECT_EQ(ListMgr.GetNumFreeBlocks(), 1);
+    EXPECT_EQ(ListMgr.GetMaxFreeBlockSize(), 128);
+
+    auto a1 = ListMgr.Allocate(17, 4);
+    EXPECT_EQ(a1.UnalignedOffset, 0);
+    EXPECT_EQ(a1.Size, 20);
+
+    auto a2 = ListMgr.Allocate(17, 8);
+    EXPECT_EQ(a2.UnalignedOffset, 20);
+    EXPECT_EQ(a2.Size, 28);
+
+    auto a3 = ListMgr.Allocate(9, 1);
+    EXPECT_EQ(a3.UnalignedOffset, 48);
+    EXPECT_EQ(a3.Size, 9);
+
+    auto a4 = ListMgr.Allocate(80, 1);
+    EXPECT_FALSE(a4.IsValid());
+    EXPECT_EQ(a4.Size, 0);
+
+    // The remaining block is exactly 71 bytes. It is in the class [68, 72) and is only found
+    // by the linear search as rounding the size up skips this class.
+    a4 = ListMgr.Allocate(71, 1);
+    EXPECT_EQ(a4.UnalignedOffset, 57);
+    EXPECT_EQ(a4.Size, 71);
+    EXPECT_TRUE(ListMgr.IsFull());
+    EXPECT_EQ(ListMgr.GetNumFreeBlocks(), 0);
+    EXPECT_EQ(ListMgr.GetMaxFreeBlockSize(), 0);
+
+    ListMgr.Free(std::move(a2));
+    EXPECT_EQ(ListMgr.GetNumFreeBlocks(), 1);
+    EXPECT_FALSE(a2.IsValid());
+
+    ListMgr.Free(std::move(a4));
+    EXPECT_EQ(ListMgr.GetNumFreeBlocks(), 2);
+    EXPECT_EQ(ListMgr.GetMaxFreeBlockSize(), 71);
+
+    // Merge with the previous and the next blocks
+    ListMgr.Free(std::move(a3));
+    EXPECT_EQ(ListMgr.GetNumFreeBlocks(), 1);
+    EXPECT_EQ(ListMgr.GetFreeSize(), 108);
+
+    ListMgr.Free(std::move(a1));
+    EXPECT_EQ(ListMgr.GetNumFreeBlocks(), 1);
+    EXPECT_TRUE(ListMgr.IsEmpty());
+}
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, FreeOrder)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    const auto NumAllocs = 6;
+    int        NumPerms  = 0;
+    size_t     ReleaseOrder[NumAllocs];
+    for (size_t a = 0; a < NumAllocs; ++a)
+        ReleaseOrder[a] = a;
+    do
+    {
+        ++NumPerms;
+        TLSFAllocationsManager ListMgr(NumAllocs * 4, Allocator);
+
+        TLSFAllocationsManager::Allocation allocs[NumAllocs];
+        for (size_t a = 0; a < NumAllocs; ++a)
+        {
+            allocs[a] = ListMgr.Allocate(4, 1);
+            EXPECT_EQ(allocs[a].UnalignedOffset, a * 4);
+            EXPECT_EQ(allocs[a].Size, 4);
+        }
+        EXPECT_TRUE(ListMgr.IsFull());
+        for (size_t a = 0; a < NumAllocs; ++a)
+        {
+            ListMgr.Free(std::move(allocs[ReleaseOrder[a]]));
+        }
+        EXPECT_EQ(ListMgr.GetNumFreeBlocks(), 1);
+        EXPECT_TRUE(ListMgr.IsEmpty());
+    } while (std::next_permutation(std::begin(ReleaseOrder), std::end(ReleaseOrder)));
+    EXPECT_EQ(NumPerms, 720);
+}
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, Alignment)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    TLSFAllocationsManager ListMgr(1024, Allocator);
+
+    auto a1 = ListMgr.Allocate(3, 1);
+    EXPECT_EQ(a1.UnalignedOffset, 0);
+    EXPECT_EQ(a1.Size, 3);
+
+    auto a2 = ListMgr.Allocate(100, 256);
+    EXPECT_EQ(a2.UnalignedOffset, 3);
+    EXPECT_EQ(Align(a2.UnalignedOffset, size_t{256}), 256);
+    EXPECT_EQ(a2.Size, 253 + 256);
+
+    // 512 bytes are left at offset 512, which is only sufficient if the block is properly aligned
+    auto a3 = ListMgr.Allocate(512, 512);
+    EXPECT_EQ(a3.UnalignedOffset, 512);
+    EXPECT_EQ(a3.Size, 512);
+    EXPECT_TRUE(ListMgr.IsFull());
+
+    ListMgr.Free(std::move(a1));
+    ListMgr.Free(std::move(a3));
+    ListMgr.Free(std::move(a2));
+    EXPECT_TRUE(ListMgr.IsEmpty());
+}
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, MoveConstruct)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    TLSFAllocationsManager ListMgr(256, Allocator);
+
+    auto a1 = ListMgr.Allocate(64, 1);
+
+    TLSFAllocationsManager ListMgr2{std::move(ListMgr)};
+    EXPECT_EQ(ListMgr.GetMaxSize(), 0);
+    EXPECT_EQ(ListMgr2.GetMaxSize(), 256);
+    EXPECT_EQ(ListMgr2.GetUsedSize(), 64);
+
+    auto a2 = ListMgr2.Allocate(64, 1);
+    EXPECT_EQ(a2.UnalignedOffset, 64);
+
+    ListMgr2.Free(std::move(a1));
+    ListMgr2.Free(std::move(a2));
+    EXPECT_TRUE(ListMgr2.IsEmpty());
+}
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, MoveAssign)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    TLSFAllocationsManager ListMgr(256, Allocator);
+    TLSFAllocationsManager ListMgr2(128, Allocator);
+
+    auto a1 = ListMgr.Allocate(64, 1);
+
+    ListMgr2 = std::move(ListMgr);
+    EXPECT_EQ(ListMgr.GetMaxSize(), 0);
+    EXPECT_EQ(ListMgr.GetFreeSize(), 0);
+    EXPECT_EQ(ListMgr.GetNumFreeBlocks(), 0);
+    EXPECT_EQ(ListMgr2.GetMaxSize(), 256);
+    EXPECT_EQ(ListMgr2.GetUsedSize(), 64);
+    EXPECT_EQ(ListMgr2.GetMaxFreeBlockSize(), 192);
+
+    auto a2 = ListMgr2.Allocate(64, 1);
+    EXPECT_EQ(a2.UnalignedOffset, 64);
+
+    ListMgr2.Free(std::move(a1));
+    ListMgr2.Free(std::move(a2));
+    EXPECT_TRUE(ListMgr2.IsEmpty());
+
+    // The object that has been moved from can be assigned again
+    ListMgr = std::move(ListMgr2);
+    EXPECT_EQ(ListMgr.GetMaxSize(), 256);
+    EXPECT_EQ(ListMgr2.GetMaxSize(), 0);
+    EXPECT_TRUE(ListMgr.IsEmpty());
+}
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, RandomAllocations)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    constexpr size_t PoolSize = 4096;
+
+    TLSFAllocationsManager ListMgr(PoolSize, Allocator);
+
+    std::mt19937                                    Gen{0};
+    std::vector<int>                                Owner(PoolSize, -1);
+    std::vector<TLSFAllocationsManager::Allocation> Allocs;
+    for (int i = 0; i < 20000; ++i)
+    {
+        if (Allocs.empty() || (Gen() % 3) != 0)
+        {
+            const size_t Size      = 1 + Gen() % 128;
+            const size_t Alignment = size_t{1} << (Gen() % 7);
+
+            auto Alloc = ListMgr.Allocate(Size, Alignment);
+            if (!Alloc.IsValid())
+                continue;
+
+            const auto AlignedOffset = Align(Alloc.UnalignedOffset, Alignment);
+            ASSERT_LE(AlignedOffset + Size, Alloc.UnalignedOffset + Alloc.Size);
+            ASSERT_LE(Alloc.UnalignedOffset + Alloc.Size, PoolSize);
+            for (size_t o = Alloc.UnalignedOffset; o < Alloc.UnalignedOffset + Alloc.Size; ++o)
+            {
+                ASSERT_EQ(Owner[o], -1) << "Overlapping allocations";
+                Owner[o] = i;
+            }
+            Allocs.push_back(Alloc);
+        }
+        else
+        {
+            const auto Idx   = Gen() % Allocs.size();
+            auto       Alloc = Allocs[Idx];
+            Allocs[Idx]      = Allocs.back();
+            Allocs.pop_back();
+            std::fill(Owner.begin() + Alloc.UnalignedOffset, Owner.begin() + Alloc.UnalignedOffset + Alloc.Size, -1);
+            ListMgr.Free(std::move(Alloc));
+        }
+
+        size_t UsedSize = 0;
+        for (const auto& Alloc : Allocs)
+            UsedSize += Alloc.Size;
+        ASSERT_EQ(ListMgr.GetUsedSize(), UsedSize);
+
+        size_t MaxFreeBlockSize = 0;
+        for (size_t o = 0; o < PoolSize;)
+        {
+            auto End = o;
+            while (End < PoolSize && Owner[End] == -1)
+                ++End;
+            MaxFreeBlockSize = std::max(MaxFreeBlockSize, End - o);
+            o                = End + 1;
+        }
+        ASSERT_EQ(ListMgr.GetMaxFreeBlockSize(), MaxFreeBlockSize);
+    }
+
+    for (auto& Alloc : Allocs)
+        ListMgr.Free(std::move(Alloc));
+    EXPECT_TRUE(ListMgr.IsEmpty());
+    EXPECT_EQ(ListMgr.GetNumFreeBlocks(), 1);
+}
+
+// Replays a small deterministic trace on VariableSizeAllocationsManager and TLSFAllocationsManager.
+// Large synthetic traces are replayed by Tests/AllocationsManagerBenchmark.
+template <typename AllocationsManagerType>
+void ReplaySmallTrace()
+{
+    using Allocation = typename AllocationsManagerType::Allocation;
+
+    AllocationsManagerType ListMgr(1024, DefaultRawMemoryAllocator::GetAllocator());
+
+    std::vector<Allocation> Allocs(16);
+    for (auto& Alloc : Allocs)
+    {
+        Alloc = ListMgr.Allocate(64, 16);
+        EXPECT_TRUE(Alloc.IsValid());
+    }
+    EXPECT_TRUE(ListMgr.IsFull());
+
+    // Free every other allocation: the free space is split into 64-byte blocks
+    for (size_t i = 1; i < Allocs.size(); i += 2)
+        ListMgr.Free(std::move(Allocs[i]));
+    EXPECT_EQ(ListMgr.GetNumFreeBlocks(), 8);
+    EXPECT_EQ(ListMgr.GetFreeSize(), 512);
+    EXPECT_EQ(ListMgr.GetMaxFreeBlockSize(), 64);
+
+    // There is enough free space, but no block is large enough
+    EXPECT_FALSE(ListMgr.Allocate(128, 16).IsValid());
+
+    // Freeing allocations 0 and 2 merges blocks 0..3 into one
+    ListMgr.Free(std::move(Allocs[0]));
+    ListMgr.Free(std::move(Allocs[2]));
+    EXPECT_EQ(ListMgr.GetNumFreeBlocks(), 7);
+    EXPECT_EQ(ListMgr.GetMaxFreeBlockSize(), 256);
+
+    Allocs[0] = ListMgr.Allocate(128, 16);
+    EXPECT_TRUE(Allocs[0].IsValid());
+
+    for (auto& Alloc : Allocs)
+    {
+        if (Alloc.IsValid())
+            ListMgr.Free(std::move(Alloc));
+    }
+    EXPECT_TRUE(ListMgr.IsEmpty());
+    EXPECT_EQ(ListMgr.GetNumFreeBlocks(), 1);
+    EXPECT_EQ(ListMgr.GetMaxFreeBlockSize(), 1024);
+}
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, ReplayTrace)
+{
+    ReplaySmallTrace<VariableSizeAllocationsManager>();
+    ReplaySmallTrace<TLSFAllocationsManager>();
+}
+
+} // namespace
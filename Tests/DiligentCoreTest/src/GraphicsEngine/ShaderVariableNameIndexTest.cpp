@@ -0,0 +1,96 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <string>
+#include <vector>
+
+#include "ShaderVariableNameIndex.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+Uint32 FindVariable(const ShaderVariableNameIndex& Index, const std::vector<std::string>& Names, const char* Name)
+{
+    return Index.Find(HashedShaderVariableName{Name},
+                      [&](Uint32 VarIndex) //
+                      {
+                          return Names[VarIndex].c_str();
+                      });
+}
+
+TEST(GraphicsEngine_ShaderVariableNameIndex, Hash)
+{
+    // FNV-1a reference values
+    EXPECT_EQ(ComputeShaderVariableNameHash(""), 0x811c9dc5u);
+    EXPECT_EQ(ComputeShaderVariableNameHash("a"), 0xe40c292cu);
+    EXPECT_EQ(ComputeShaderVariableNameHash("foobar"), 0xbf9cf968u);
+
+    HashedShaderVariableName Name{"g_Texture"};
+    EXPECT_STREQ(Name.Name, "g_Texture");
+    EXPECT_EQ(Name.Hash, ComputeShaderVariableNameHash("g_Texture"));
+}
+
+TEST(GraphicsEngine_ShaderVariableNameIndex, Find)
+{
+    std::vector<std::string> Names;
+    for (Uint32 i = 0; i < 300; ++i)
+        Names.emplace_back("g_Variable" + std::to_string(i));
+    // Duplicate name must resolve to the first variable
+    Names.emplace_back("g_Variable7");
+
+    ShaderVariableNameIndex Index;
+    Index.Initialize(static_cast<Uint32>(Names.size()),
+                     [&](Uint32 VarIndex) //
+                     {
+                         return Names[VarIndex].c_str();
+                     });
+
+    for (Uint32 i = 0; i < 300; ++i)
+        EXPECT_EQ(FindVariable(Index, Names, Names[i].c_str()), i);
+
+    EXPECT_EQ(FindVariable(Index, Names, "g_Variable7"), 7u);
+    EXPECT_EQ(FindVariable(Index, Names, "g_Variable"), Uint32{ShaderVariableNameIndex::InvalidIndex});
+    EXPECT_EQ(FindVariable(Index, Names, ""), Uint32{ShaderVariableNameIndex::InvalidIndex});
+    EXPECT_EQ(FindVariable(Index, Names, "g_Variable300"), Uint32{ShaderVariableNameIndex::InvalidIndex});
+}
+
+TEST(GraphicsEngine_ShaderVariableNameIndex, Empty)
+{
+    std::vector<std::string> Names;
+
+    ShaderVariableNameIndex Index;
+    EXPECT_EQ(FindVariable(Index, Names, "g_Variable"), Uint32{ShaderVariableNameIndex::InvalidIndex});
+
+    Index.Initialize(0, [&](Uint32 VarIndex) { return Names[VarIndex].c_str(); });
+    EXPECT_EQ(FindVariable(Index, Names, "g_Variable"), Uint32{ShaderVariableNameIndex::InvalidIndex});
+}
+
+} // namespace
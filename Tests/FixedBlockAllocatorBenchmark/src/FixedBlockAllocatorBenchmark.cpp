@@ -0,0 +1,129 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+// Compares the locked path of FixedBlockMemoryAllocator (mutex + page lookup)
+// with the thread-cached path for different numbers of threads.
+// Every thread repeatedly allocates a set of blocks, writes to them and releases them.
+//
+// Usage: FixedBlockAllocatorBenchmark [NumIterations]
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "FixedBlockMemoryAllocator.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "Timer.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+constexpr Uint32 BlockSize          = 64;
+constexpr Uint32 NumBlocksInPage    = 256;
+constexpr Uint32 NumLiveAllocations = 512;
+
+double Measure(bool EnableThreadCache, Uint32 NumThreads, Uint32 NumIterations)
+{
+    FixedBlockMemoryAllocator Allocator(DefaultRawMemoryAllocator::GetAllocator(), BlockSize, NumBlocksInPage, EnableThreadCache);
+
+    std::atomic<Uint32> NumReadyThreads{0};
+    std::atomic<bool>   Start{false};
+
+    auto ThreadFunc = [&]() {
+        std::vector<void*> Blocks(NumLiveAllocations);
+
+        ++NumReadyThreads;
+        while (!Start)
+            std::this_thread::yield();
+
+        for (Uint32 i = 0; i < NumIterations; ++i)
+        {
+            for (Uint32 b = 0; b < NumLiveAllocations; ++b)
+            {
+                Blocks[b] = Allocator.Allocate(BlockSize, "Benchmark block", __FILE__, __LINE__);
+                *reinterpret_cast<Uint32*>(Blocks[b]) = b;
+            }
+            // Release the blocks in the interleaved order, so that they are not returned
+            // to the allocator in the same order they were allocated
+            for (Uint32 b = 0; b < NumLiveAllocations; b += 2)
+                Allocator.Free(Blocks[b]);
+            for (Uint32 b = 1; b < NumLiveAllocations; b += 2)
+                Allocator.Free(Blocks[b]);
+        }
+    };
+
+    std::vector<std::thread> Threads;
+    for (Uint32 t = 0; t < NumThreads; ++t)
+        Threads.emplace_back(ThreadFunc);
+
+    while (NumReadyThreads < NumThreads)
+        std::this_thread::yield();
+
+    Timer T;
+    Start = true;
+    for (auto& Thread : Threads)
+        Thread.join();
+    return T.GetElapsedTime();
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const auto NumIterations = static_cast<Uint32>(argc > 1 ? std::max(atoi(argv[1]), 1) : 2000);
+    // Run at least 8 threads to show the contention even on machines with few cores
+    const auto MaxThreads = std::max(std::thread::hardware_concurrency(), 8u);
+
+    std::cout << "Block size: " << BlockSize << ", live allocations per thread: " << NumLiveAllocations
+              << ", iterations: " << NumIterations << "\n\n";
+    std::cout << std::setw(8) << "Threads"
+              << std::setw(14) << "Locked, ms" << std::setw(14) << "Mops/s"
+              << std::setw(14) << "Cached, ms" << std::setw(14) << "Mops/s"
+              << std::setw(10) << "Speedup" << '\n';
+
+    for (Uint32 NumThreads = 1; NumThreads <= MaxThreads; NumThreads *= 2)
+    {
+        // Every iteration performs one allocation and one deallocation per block
+        const auto NumOps = static_cast<double>(NumThreads) * NumIterations * NumLiveAllocations * 2;
+
+        const auto LockedTime = Measure(false, NumThreads, NumIterations);
+        const auto CachedTime = Measure(true, NumThreads, NumIterations);
+
+        std::cout << std::fixed << std::setprecision(2) << std::setw(8) << NumThreads
+                  << std::setw(14) << LockedTime * 1000.0 << std::setw(14) << NumOps / LockedTime * 1e-6
+                  << std::setw(14) << CachedTime * 1000.0 << std::setw(14) << NumOps / CachedTime * 1e-6
+                  << std::setw(9) << LockedTime / CachedTime << "x\n";
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,158 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+// Measures the throughput of the HLSL to GLSL converter.
+//
+// Usage: HLSL2GLSLConverterBenchmark [ShaderDirectory] [MinSourceSizeKB] [NumIterations]
+//
+// Every shader of the corpus is repeated until its size reaches MinSourceSizeKB to emulate
+// large shader headers, and is then tokenized and converted NumIterations times.
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+#include "HLSL2GLSLConverterImpl.hpp"
+#include "DefaultShaderSourceStreamFactory.h"
+#include "RefCntAutoPtr.hpp"
+#include "DataBlobImpl.hpp"
+#include "Timer.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+struct CorpusEntry
+{
+    const char* FileName;
+    const char* EntryPoint;
+    SHADER_TYPE ShaderType;
+};
+
+// clang-format off
+const CorpusEntry Corpus[] =
+{
+    {"VS_PS.hlsl",        "TestVS", SHADER_TYPE_VERTEX },
+    {"VS_PS.hlsl",        "TestPS", SHADER_TYPE_PIXEL  },
+    {"CS_RWTex1D.hlsl",   "TestCS", SHADER_TYPE_COMPUTE},
+    {"CS_RWTex2D_1.hlsl", "TestCS", SHADER_TYPE_COMPUTE},
+    {"CS_RWTex2D_2.hlsl", "TestCS", SHADER_TYPE_COMPUTE},
+    {"CS_RWBuff.hlsl",    "TestCS", SHADER_TYPE_COMPUTE}
+};
+// clang-format on
+
+String LoadSource(IShaderSourceInputStreamFactory* pFactory, const char* FileName, size_t MinSize)
+{
+    RefCntAutoPtr<IFileStream> pFileStream;
+    pFactory->CreateInputStream(FileName, &pFileStream);
+    if (!pFileStream)
+        return String{};
+
+    RefCntAutoPtr<IDataBlob> pFileData(MakeNewRCObj<DataBlobImpl>()(0));
+    pFileStream->ReadBlob(pFileData);
+
+    const String Text{reinterpret_cast<const char*>(pFileData->GetDataPtr()), pFileData->GetSize()};
+
+    String Source;
+    do
+    {
+        Source.append(Text);
+        Source.push_back('\n');
+    } while (Source.size() < MinSize);
+    return Source;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const char* ShadersDir    = argc > 1 ? argv[1] : HLSL2GLSL_BENCHMARK_SHADERS_DIR;
+    const auto  MinSizeKB     = argc > 2 ? std::max(atoi(argv[2]), 0) : 256;
+    const auto  NumIterations = argc > 3 ? std::max(atoi(argv[3]), 1) : 10;
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pShaderSourceFactory;
+    CreateDefaultShaderSourceStreamFactory(ShadersDir, &pShaderSourceFactory);
+    if (!pShaderSourceFactory)
+    {
+        std::cerr << "Failed to create shader source stream factory\n";
+        return EXIT_FAILURE;
+    }
+
+    const auto& Converter = HLSL2GLSLConverterImpl::GetInstance();
+
+    std::cout << "Shader directory: " << ShadersDir << "\nMin source size: " << MinSizeKB << " KB\nIterations: " << NumIterations << "\n\n";
+    std::cout << std::left << std::setw(20) << "File" << std::setw(10) << "Entry" << std::right
+              << std::setw(12) << "Size, KB" << std::setw(12) << "Time, ms" << std::setw(12) << "MB/s" << '\n';
+
+    double TotalTime = 0;
+    double TotalSize = 0;
+    for (const auto& Entry : Corpus)
+    {
+        const auto Source = LoadSource(pShaderSourceFactory, Entry.FileName, static_cast<size_t>(MinSizeKB) * 1024);
+        if (Source.empty())
+        {
+            std::cerr << "Failed to load " << Entry.FileName << '\n';
+            return EXIT_FAILURE;
+        }
+
+        Timer  T;
+        size_t GLSLSize = 0;
+        for (int i = 0; i < NumIterations; ++i)
+        {
+            HLSL2GLSLConverterImpl::ConversionAttribs Attribs;
+            Attribs.pSourceStreamFactory = pShaderSourceFactory;
+            Attribs.HLSLSource           = Source.c_str();
+            Attribs.NumSymbols           = Source.length();
+            Attribs.EntryPoint           = Entry.EntryPoint;
+            Attribs.ShaderType           = Entry.ShaderType;
+            Attribs.InputFileName        = Entry.FileName;
+
+            const auto GLSLSource = Converter.Convert(Attribs);
+            if (GLSLSource.empty())
+            {
+                std::cerr << "Failed to convert " << Entry.FileName << '\n';
+                return EXIT_FAILURE;
+            }
+            GLSLSize = GLSLSource.size();
+        }
+        const auto Time = T.GetElapsedTime() / NumIterations;
+        const auto Size = static_cast<double>(Source.size());
+
+        std::cout << std::left << std::setw(20) << Entry.FileName << std::setw(10) << Entry.EntryPoint << std::right << std::fixed
+                  << std::setprecision(1) << std::setw(12) << Size / 1024.0 << std::setw(12) << Time * 1000.0
+                  << std::setw(12) << Size / Time / (1024.0 * 1024.0) << "   (GLSL: " << GLSLSize << " bytes)\n";
+
+        TotalTime += Time;
+        TotalSize += Size;
+    }
+
+    std::cout << "\nTotal throughput: " << std::fixed << std::setprecision(1) << TotalSize / TotalTime / (1024.0 * 1024.0) << " MB/s\n";
+
+    return EXIT_SUCCESS;
+}
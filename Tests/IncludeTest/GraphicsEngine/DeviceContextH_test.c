@@ -34,11 +34,17 @@ void TestDeviceContextCInterface(struct IDeviceContext* pCtx)
     struct DrawIndexedAttribs         drawIndexedAttribs         = {0};
     struct DrawIndirectAttribs        drawIndirectAttribs        = {0};
     struct DrawIndexedIndirectAttribs drawIndexedIndirectAttribs = {0};
+    struct MultiDrawAttribs           multiDrawAttribs           = {0};
+    struct MultiDrawIndexedAttribs    multiDrawIndexedAttribs    = {0};
     struct IBuffer*                   pIndirectBuffer            = NULL;
+    struct DeviceContextStateStats    stateStats                 = {0};
 
     IDeviceContext_SetPipelineState(pCtx, pPSO);
     IDeviceContext_Draw(pCtx, &drawAttribs);
     IDeviceContext_DrawIndexed(pCtx, &drawIndexedAttribs);
     IDeviceContext_DrawIndirect(pCtx, &drawIndirectAttribs, pIndirectBuffer);
     IDeviceContext_DrawIndexedIndirect(pCtx, &drawIndexedIndirectAttribs, pIndirectBuffer);
+    IDeviceContext_MultiDraw(pCtx, &multiDrawAttribs);
+    IDeviceContext_MultiDrawIndexed(pCtx, &multiDrawIndexedAttribs);
+    IDeviceContext_GetStateStats(pCtx, &stateStats);
 }
@@ -32,6 +32,8 @@ void TestBufferVk_CInterface(IBufferVk* pView)
 {
     VkBuffer vkView = IBufferVk_GetVkBuffer(pView);
     (void)vkView;
+    VkDeviceSize Offset = IBufferVk_GetVkBufferOffset(pView);
+    (void)Offset;
     IBufferVk_SetAccessFlags(pView, VK_ACCESS_HOST_READ_BIT);
     VkAccessFlags vkAccessFlag = IBufferVk_GetAccessFlags(pView);
     (void)vkAccessFlag;
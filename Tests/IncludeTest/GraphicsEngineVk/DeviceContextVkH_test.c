@@ -37,4 +37,12 @@ void TestDeviceContextVk_CInterface(IDeviceContextVk* pCtx)
     (void)pVkCmdQueue;
 
     IDeviceContextVk_UnlockCommandQueue(pCtx);
+
+    PipelineBarrierStats BarrierStats;
+    IDeviceContextVk_GetPipelineBarrierStats(pCtx, &BarrierStats);
+
+    IDeviceContextVk_BeginSecondaryCommandList(pCtx, (IDeviceContext*)NULL);
+
+    ICommandList* pCmdLists[] = {NULL};
+    IDeviceContextVk_ExecuteCommandLists(pCtx, 1, pCmdLists);
 }
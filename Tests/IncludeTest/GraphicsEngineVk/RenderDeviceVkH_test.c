@@ -49,4 +49,28 @@ void TestRenderDeviceVkCInterface(IRenderDeviceVk* pDevice)
 
     IRenderDeviceVk_CreateTextureFromVulkanImage(pDevice, (VkImage)NULL, (TextureDesc*)NULL, RESOURCE_STATE_SHADER_RESOURCE, (ITexture**)NULL);
     IRenderDeviceVk_CreateBufferFromVulkanResource(pDevice, (VkBuffer)NULL, (BufferDesc*)NULL, RESOURCE_STATE_CONSTANT_BUFFER, (IBuffer**)NULL);
+
+    SPIRVCacheStats CacheStats;
+    IRenderDeviceVk_GetSPIRVCacheStats(pDevice, &CacheStats);
+
+    IDataBlob* pCacheData = NULL;
+    IRenderDeviceVk_GetPipelineCacheData(pDevice, &pCacheData);
+
+    Uint32 BindlessIdx = IRenderDeviceVk_AllocateBindlessDescriptor(pDevice, (IDeviceObject*)NULL);
+    IRenderDeviceVk_ReleaseBindlessDescriptor(pDevice, BINDLESS_DESCRIPTOR_RANGE_VK_TEXTURES, BindlessIdx);
+    Uint32 HeapSize = IRenderDeviceVk_GetBindlessDescriptorHeapSize(pDevice, BINDLESS_DESCRIPTOR_RANGE_VK_SAMPLERS);
+    (void)HeapSize;
+
+    DescriptorSetAllocationStats AllocStats;
+    IRenderDeviceVk_GetDescriptorSetAllocationStats(pDevice, &AllocStats);
+
+    IRenderDeviceVk_FlushResourceUploads(pDevice, (IFence*)NULL, (Uint64)0);
+
+    ResourceUploadBatchStats UploadStats;
+    IRenderDeviceVk_GetResourceUploadBatchStats(pDevice, &UploadStats);
+
+    Uint32 NumHeaps = IRenderDeviceVk_GetDeviceMemoryHeapCount(pDevice);
+
+    DeviceMemoryHeapStats HeapStats;
+    IRenderDeviceVk_GetDeviceMemoryHeapStats(pDevice, NumHeaps - 1, &HeapStats);
 }
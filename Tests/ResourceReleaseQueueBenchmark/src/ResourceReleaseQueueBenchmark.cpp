@@ -0,0 +1,224 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+// Measures the throughput of ResourceReleaseQueue when resources are released by several
+// producer threads while the main thread keeps discarding and purging the queue, and compares
+// it with the reference queue that protects two deques with mutexes as the queue used to do.
+//
+// Usage: ResourceReleaseQueueBenchmark [NumResourcesPerThread]
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ResourceReleaseQueue.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "STDAllocator.hpp"
+#include "Timer.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+// Mutex-based release queue that replicates the previous implementation of ResourceReleaseQueue
+template <typename ResourceWrapperType>
+class MutexReleaseQueue
+{
+public:
+    // clang-format off
+    MutexReleaseQueue(IMemoryAllocator& Allocator) :
+        m_ReleaseQueue  (STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for deque<ReleaseQueueElemType>")),
+        m_StaleResources(STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for deque<ReleaseQueueElemType>"))
+    {}
+    // clang-format on
+
+    template <typename ResourceType>
+    void SafeReleaseResource(ResourceType&& Resource, Uint64 NextCommandListNumber)
+    {
+        auto Wrapper = ResourceWrapperType::Create(std::move(Resource), 1);
+
+        std::lock_guard<std::mutex> LockGuard(m_StaleObjectsMutex);
+        m_StaleResources.emplace_back(NextCommandListNumber, std::move(Wrapper));
+    }
+
+    void DiscardStaleResources(Uint64 SubmittedCmdBuffNumber, Uint64 FenceValue)
+    {
+        std::lock_guard<std::mutex> StaleObjectsLock(m_StaleObjectsMutex);
+        std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
+        while (!m_StaleResources.empty())
+        {
+            auto& FirstStaleObj = m_StaleResources.front();
+            if (FirstStaleObj.first <= SubmittedCmdBuffNumber)
+            {
+                m_ReleaseQueue.emplace_back(FenceValue, std::move(FirstStaleObj.second));
+                m_StaleResources.pop_front();
+            }
+            else
+                break;
+        }
+    }
+
+    void Purge(Uint64 CompletedFenceValue)
+    {
+        std::lock_guard<std::mutex> LockGuard(m_ReleaseQueueMutex);
+        while (!m_ReleaseQueue.empty())
+        {
+            auto& FirstObj = m_ReleaseQueue.front();
+            if (FirstObj.first <= CompletedFenceValue)
+                m_ReleaseQueue.pop_front();
+            else
+                break;
+        }
+    }
+
+private:
+    std::mutex m_ReleaseQueueMutex;
+    using ReleaseQueueElemType = std::pair<Uint64, ResourceWrapperType>;
+    std::deque<ReleaseQueueElemType, STDAllocatorRawMem<ReleaseQueueElemType>> m_ReleaseQueue;
+
+    std::mutex                                                                 m_StaleObjectsMutex;
+    std::deque<ReleaseQueueElemType, STDAllocatorRawMem<ReleaseQueueElemType>> m_StaleResources;
+};
+
+struct Resource
+{
+    explicit Resource(std::atomic<int>& _Counter) :
+        Counter{&_Counter}
+    {}
+    Resource(Resource&& rhs) noexcept :
+        Counter{rhs.Counter}
+    {
+        rhs.Counter = nullptr;
+    }
+    ~Resource()
+    {
+        if (Counter != nullptr)
+            Counter->fetch_add(1, std::memory_order_relaxed);
+    }
+    std::atomic<int>* Counter;
+};
+
+// Returns the time it takes to release and destroy all resources
+template <typename QueueType>
+double Measure(Uint32 NumThreads, Uint32 NumResourcesPerThread)
+{
+    QueueType Queue(DefaultRawMemoryAllocator::GetAllocator());
+
+    std::atomic<int>    NumDestroyed{0};
+    std::atomic<Uint64> NextCmdListNumber{0};
+    std::atomic<Uint32> NumReadyThreads{0};
+    std::atomic<Uint32> NumThreadsFinished{0};
+    std::atomic<bool>   Start{false};
+
+    std::vector<std::thread> Threads;
+    for (Uint32 t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back(
+            [&]() //
+            {
+                ++NumReadyThreads;
+                while (!Start)
+                    std::this_thread::yield();
+
+                for (Uint32 i = 0; i < NumResourcesPerThread; ++i)
+                    Queue.SafeReleaseResource(Resource{NumDestroyed}, NextCmdListNumber.load(std::memory_order_relaxed));
+                ++NumThreadsFinished;
+            } //
+        );
+    }
+
+    while (NumReadyThreads < NumThreads)
+        std::this_thread::yield();
+
+    Timer T;
+    Start = true;
+
+    // Emulate command list submission: every submitted command list gets its own fence value
+    // that is completed two submissions later
+    Uint64 FenceValue = 0;
+    while (NumThreadsFinished < NumThreads)
+    {
+        const auto CmdListNumber = NextCmdListNumber.fetch_add(1);
+        ++FenceValue;
+        Queue.DiscardStaleResources(CmdListNumber, FenceValue);
+        if (FenceValue > 2)
+            Queue.Purge(FenceValue - 2);
+        std::this_thread::yield();
+    }
+
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    Queue.DiscardStaleResources(NextCmdListNumber.fetch_add(1), ++FenceValue);
+    Queue.Purge(FenceValue);
+
+    const auto Time = T.GetElapsedTime();
+    if (NumDestroyed != static_cast<int>(NumThreads * NumResourcesPerThread))
+    {
+        std::cerr << "Not all resources were destroyed\n";
+        std::exit(EXIT_FAILURE);
+    }
+    return Time;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const auto NumResourcesPerThread = static_cast<Uint32>(argc > 1 ? std::max(atoi(argv[1]), 1) : 100000);
+
+    // Run at least 8 producers to show the contention even on machines with few cores
+    const auto MaxThreads = std::max(std::thread::hardware_concurrency(), 8u);
+
+    std::cout << "Resources per thread: " << NumResourcesPerThread << "\n\n";
+    std::cout << std::setw(10) << "Producers"
+              << std::setw(14) << "Mutex, ms" << std::setw(14) << "Mres/s"
+              << std::setw(16) << "Lock-free, ms" << std::setw(14) << "Mres/s"
+              << std::setw(10) << "Speedup" << '\n';
+
+    for (Uint32 NumThreads = 1; NumThreads <= MaxThreads; NumThreads *= 2)
+    {
+        const auto NumResources = static_cast<double>(NumThreads) * NumResourcesPerThread;
+
+        const auto MutexTime    = Measure<MutexReleaseQueue<DynamicStaleResourceWrapper>>(NumThreads, NumResourcesPerThread);
+        const auto LockFreeTime = Measure<ResourceReleaseQueue<DynamicStaleResourceWrapper>>(NumThreads, NumResourcesPerThread);
+
+        std::cout << std::fixed << std::setprecision(2) << std::setw(10) << NumThreads
+                  << std::setw(14) << MutexTime * 1000.0 << std::setw(14) << NumResources / MutexTime * 1e-6
+                  << std::setw(16) << LockFreeTime * 1000.0 << std::setw(14) << NumResources / LockFreeTime * 1e-6
+                  << std::setw(9) << MutexTime / LockFreeTime << "x\n";
+    }
+
+    return EXIT_SUCCESS;
+}